@@ -2,308 +2,512 @@
 
 #include "complex/DataStructure/DataGroup.hpp"
 #include "complex/Utilities/DataArrayUtilities.hpp"
-#include "complex/Utilities/Math/StatisticsCalculations.hpp"
 #include "complex/Utilities/ParallelDataAlgorithm.hpp"
 
-#include <unordered_map>
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <type_traits>
 
 using namespace complex;
 
 namespace
 {
+// Tuples are grouped by feature in chunks of at least this many tuples, and in at most k_MaxNumChunks chunks
+constexpr usize k_MinTuplesPerChunk = 16384;
+constexpr usize k_MaxNumChunks = 64;
+
+// The statistics of the entire array are computed in parallel over chunks of at least this many values
+constexpr usize k_MinValuesPerChunk = 65536;
+
+/**
+ * @brief The selected values grouped by feature/ensemble into one flat buffer. The
+ * values of feature i are stored in tuple order in [offsets[i], offsets[i + 1]).
+ */
 template <typename T>
-class FindArrayStatisticsByIndexImpl
+struct FeatureValues
 {
-public:
-  FindArrayStatisticsByIndexImpl(std::unordered_map<int32, std::list<T>>& featureDataMap, bool length, bool min, bool max, bool mean, bool median, bool stdDeviation, bool summation,
-                                 std::vector<IDataArray*>& arrays, bool hist, float64 histmin, float64 histmax, bool histfullrange, int32 numBins)
-  : m_FeatureDataMap(featureDataMap)
-  , m_Length(length)
-  , m_Min(min)
-  , m_Max(max)
-  , m_Mean(mean)
-  , m_Median(median)
-  , m_StdDeviation(stdDeviation)
-  , m_Summation(summation)
-  , m_Histogram(hist)
-  , m_HistMin(histmin)
-  , m_HistMax(histmax)
-  , m_HistFullRange(histfullrange)
-  , m_NumBins(numBins)
-  , m_Arrays(arrays)
+  std::vector<T> values;
+  std::vector<usize> offsets;
+
+  nonstd::span<T> getValues(usize featureIndex)
   {
+    return {values.data() + offsets[featureIndex], offsets[featureIndex + 1] - offsets[featureIndex]};
   }
+};
 
-  virtual ~FindArrayStatisticsByIndexImpl() = default;
-
-  void compute(usize start, usize end) const
+// -----------------------------------------------------------------------------
+template <typename T>
+FeatureValues<T> GroupValuesByFeature(const DataArray<T>& source, const Int32Array* featureIds, const MaskCompare* mask, usize numFeatures)
+{
+  const usize numTuples = source.getNumberOfTuples();
+  const nonstd::span<const T> sourceValues = source.createSpan();
+  nonstd::span<const int32> featureIdValues;
+  if(featureIds != nullptr)
   {
-    auto* array0 = dynamic_cast<DataArray<uint64>*>(m_Arrays[0]);
-    if(m_Length && array0 == nullptr)
+    featureIdValues = featureIds->createSpan();
+  }
+
+  // Returns numFeatures for the tuples that are masked out or do not belong to a feature
+  auto findFeature = [&](usize tupleIndex) -> usize {
+    if(mask != nullptr && !mask->isTrue(tupleIndex))
     {
-      throw std::invalid_argument("FindArrayStatisticsByIndexImpl::compute() could not dynamic_cast 'Length' array to needed type. Check input array selection.");
+      return numFeatures;
     }
-    auto* array1 = dynamic_cast<DataArray<T>*>(m_Arrays[1]);
-    if(m_Min && array1 == nullptr)
+    if(featureIds == nullptr)
     {
-      throw std::invalid_argument("FindArrayStatisticsByIndexImpl::compute() could not dynamic_cast 'Min' array to needed type. Check input array selection.");
+      return 0;
     }
-    auto* array2 = dynamic_cast<DataArray<T>*>(m_Arrays[2]);
-    if(m_Max && array2 == nullptr)
+    const int32 featureId = featureIdValues[tupleIndex];
+    return (featureId < 0 || static_cast<usize>(featureId) >= numFeatures) ? numFeatures : static_cast<usize>(featureId);
+  };
+
+  // Count the values of each feature in each chunk of tuples. The number of chunks is limited so that the
+  // counts never take more memory than the values themselves. It does not depend on the number of threads,
+  // which gives every machine the same grouping passes.
+  const usize numChunks = std::clamp<usize>(numTuples / std::max(numFeatures, k_MinTuplesPerChunk), 1, k_MaxNumChunks);
+  std::vector<usize> cursors(numChunks * numFeatures, 0);
+
+  ParallelDataAlgorithm countAlg;
+  countAlg.setRange(0, numChunks);
+  countAlg.execute([&](const ComplexRange& range) {
+    for(usize chunk = range.min(); chunk < range.max(); chunk++)
     {
-      throw std::invalid_argument("FindArrayStatisticsByIndexImpl::compute() could not dynamic_cast 'Max' array to needed type. Check input array selection.");
+      usize* counts = cursors.data() + chunk * numFeatures;
+      const ComplexRange chunkRange = GetRange(numTuples, numChunks, chunk);
+      for(usize i = chunkRange.min(); i < chunkRange.max(); i++)
+      {
+        const usize feature = findFeature(i);
+        if(feature < numFeatures)
+        {
+          counts[feature]++;
+        }
+      }
     }
-    auto* array3 = dynamic_cast<Float32Array*>(m_Arrays[3]);
-    if(m_Mean && array3 == nullptr)
+  });
+
+  // Turn the counts into the position of the first value of each feature in each chunk so that
+  // the values of a feature are stored in tuple order
+  FeatureValues<T> featureValues;
+  featureValues.offsets.resize(numFeatures + 1);
+  usize total = 0;
+  for(usize feature = 0; feature < numFeatures; feature++)
+  {
+    featureValues.offsets[feature] = total;
+    for(usize chunk = 0; chunk < numChunks; chunk++)
     {
-      throw std::invalid_argument("FindArrayStatisticsByIndexImpl::compute() could not dynamic_cast 'Mean' array to needed type. Check input array selection.");
+      usize& cursor = cursors[chunk * numFeatures + feature];
+      const usize count = cursor;
+      cursor = total;
+      total += count;
     }
-    auto* array4 = dynamic_cast<Float32Array*>(m_Arrays[4]);
-    if(m_Median && array4 == nullptr)
+  }
+  featureValues.offsets[numFeatures] = total;
+  featureValues.values.resize(total);
+
+  ParallelDataAlgorithm scatterAlg;
+  scatterAlg.setRange(0, numChunks);
+  scatterAlg.execute([&](const ComplexRange& range) {
+    for(usize chunk = range.min(); chunk < range.max(); chunk++)
     {
-      throw std::invalid_argument("FindArrayStatisticsByIndexImpl::compute() could not dynamic_cast 'Median' array to needed type. Check input array selection.");
+      usize* chunkCursors = cursors.data() + chunk * numFeatures;
+      const ComplexRange chunkRange = GetRange(numTuples, numChunks, chunk);
+      for(usize i = chunkRange.min(); i < chunkRange.max(); i++)
+      {
+        const usize feature = findFeature(i);
+        if(feature < numFeatures)
+        {
+          featureValues.values[chunkCursors[feature]++] = sourceValues[i];
+        }
+      }
     }
-    auto* array5 = dynamic_cast<Float32Array*>(m_Arrays[5]);
-    if(m_StdDeviation && array5 == nullptr)
+  });
+
+  return featureValues;
+}
+
+/**
+ * @brief Streaming accumulator for the count, min, max and sum of a set of values.
+ * The sum uses the same types as StaticicsCalculations::computeSum so that the sums
+ * match exactly.
+ */
+template <typename T>
+class ValueAccumulator
+{
+public:
+  using SumType = std::conditional_t<std::is_integral_v<T>, std::conditional_t<std::is_signed_v<T>, int64, uint64>, float64>;
+
+  void add(T value)
+  {
+    if(m_Count == 0)
     {
-      throw std::invalid_argument("FindArrayStatisticsByIndexImpl::compute() could not dynamic_cast 'StdDev' array to needed type. Check input array selection.");
+      m_Min = value;
+      m_Max = value;
     }
-    auto* array6 = dynamic_cast<Float32Array*>(m_Arrays[6]);
-    if(m_Summation && array6 == nullptr)
+    else
     {
-      throw std::invalid_argument("FindArrayStatisticsByIndexImpl::compute() could not dynamic_cast 'Summation' array to needed type. Check input array selection.");
+      m_Min = std::min(m_Min, value);
+      m_Max = std::max(m_Max, value);
     }
-    auto* array7 = dynamic_cast<Float32Array*>(m_Arrays[7]);
-    if(m_Histogram && array7 == nullptr)
+    m_Count++;
+    m_Sum += static_cast<SumType>(value);
+  }
+
+  /**
+   * @brief Adds the values of an accumulator that saw the values following the values of this one.
+   * @param other
+   */
+  void merge(const ValueAccumulator& other)
+  {
+    if(other.m_Count == 0)
     {
-      throw std::invalid_argument("FindArrayStatisticsByIndexImpl::compute() could not dynamic_cast 'Histogram' array to needed type. Check input array selection.");
+      return;
     }
-
-    for(usize i = start; i < end; i++)
+    if(m_Count == 0)
     {
-      if(m_Length)
-      {
-        uint64 val = static_cast<uint64>(m_FeatureDataMap[i].size());
-        array0->initializeTuple(i, val);
-      }
-      if(m_Min)
-      {
-        T val = StaticicsCalculations::findMin(m_FeatureDataMap[i]);
-        array1->initializeTuple(i, val);
-      }
-      if(m_Max)
-      {
-        T val = StaticicsCalculations::findMax(m_FeatureDataMap[i]);
-        array2->initializeTuple(i, val);
-      }
-      if(m_Mean)
-      {
-        float32 val = StaticicsCalculations::findMean(m_FeatureDataMap[i]);
-        array3->initializeTuple(i, val);
-      }
-      if(m_Median)
-      {
-        float32 val = StaticicsCalculations::findMedian(m_FeatureDataMap[i]);
-        array4->initializeTuple(i, val);
-      }
-      if(m_StdDeviation)
-      {
-        float32 val = StaticicsCalculations::findStdDeviation(m_FeatureDataMap[i]);
-        array5->initializeTuple(i, val);
-      }
-      if(m_Summation)
-      {
-        float32 val = StaticicsCalculations::findSummation(m_FeatureDataMap[i]);
-        array6->initializeTuple(i, val);
-      }
-      if(m_Histogram)
-      {
-        auto* arr7DataStore = array7->getDataStore();
-        if(arr7DataStore != nullptr)
-        {
-          std::vector<float32> vals = StaticicsCalculations::findHistogram(m_FeatureDataMap[i], m_HistMin, m_HistMax, m_HistFullRange, m_NumBins);
-          arr7DataStore->setTuple(i, vals);
-        }
-      }
+      *this = other;
+      return;
     }
+    m_Min = std::min(m_Min, other.m_Min);
+    m_Max = std::max(m_Max, other.m_Max);
+    m_Count += other.m_Count;
+    m_Sum += other.m_Sum;
   }
 
-  void operator()(const ComplexRange& range) const
+  T getMin() const
   {
-    compute(range.min(), range.max());
+    return m_Min;
+  }
+
+  T getMax() const
+  {
+    return m_Max;
+  }
+
+  float32 getMean() const
+  {
+    return m_Count == 0 ? 0.0f : static_cast<float32>(m_Sum) / static_cast<float32>(m_Count);
+  }
+
+  float32 getSum() const
+  {
+    return static_cast<float32>(m_Sum);
   }
 
 private:
-  std::unordered_map<int32, std::list<T>>& m_FeatureDataMap;
-  bool m_Length;
-  bool m_Min;
-  bool m_Max;
-  bool m_Mean;
-  bool m_Median;
-  bool m_StdDeviation;
-  bool m_Summation;
-  bool m_Histogram;
-  float64 m_HistMin;
-  float64 m_HistMax;
-  bool m_HistFullRange;
-  int32 m_NumBins;
-  std::vector<IDataArray*>& m_Arrays;
+  usize m_Count = 0;
+  T m_Min = static_cast<T>(0);
+  T m_Max = static_cast<T>(0);
+  SumType m_Sum = 0;
 };
 
 // -----------------------------------------------------------------------------
 template <typename T>
-void findStatisticsByIndexImpl(std::unordered_map<int32, std::list<T>>& featureDataMap, std::vector<IDataArray*>& arrays, const FindArrayStatisticsInputValues* inputValues, int32 numFeatures)
+float32 SumSquaredDifferences(nonstd::span<const T> values, float32 mean)
+{
+  // The differences and their sum are float32, as in StaticicsCalculations::findStdDeviation, so the
+  // standard deviation of a single chunk of values is unchanged
+  float32 squaredSum = 0.0f;
+  for(const T value : values)
+  {
+    const float64 difference = static_cast<float32>(value) - mean;
+    squaredSum = static_cast<float32>(squaredSum + difference * difference);
+  }
+  return squaredSum;
+}
+
+/**
+ * @brief Calls chunkFunction for each of the numChunks fixed chunks of the values and returns
+ * the results in chunk order. More than one chunk is processed in parallel.
+ */
+template <typename T, typename ChunkFunction>
+auto MapChunks(nonstd::span<const T> values, usize numChunks, const ChunkFunction& chunkFunction)
 {
-  // Allow data-based parallelization
+  std::vector<decltype(chunkFunction(values))> results(numChunks);
+  if(numChunks == 1)
+  {
+    results[0] = chunkFunction(values);
+    return results;
+  }
   ParallelDataAlgorithm dataAlg;
-  dataAlg.setRange(0, numFeatures);
-  dataAlg.execute(FindArrayStatisticsByIndexImpl<T>(featureDataMap, inputValues->FindLength, inputValues->FindMin, inputValues->FindMax, inputValues->FindMean, inputValues->FindMedian,
-                                                    inputValues->FindStdDeviation, inputValues->FindSummation, arrays, inputValues->FindHistogram, inputValues->MinRange, inputValues->MaxRange,
-                                                    inputValues->UseFullRange, inputValues->NumBins));
+  dataAlg.setRange(0, numChunks);
+  dataAlg.execute([&](const ComplexRange& range) {
+    for(usize chunk = range.min(); chunk < range.max(); chunk++)
+    {
+      const ComplexRange chunkRange = GetRange(values.size(), numChunks, chunk);
+      results[chunk] = chunkFunction(values.subspan(chunkRange.min(), chunkRange.max() - chunkRange.min()));
+    }
+  });
+  return results;
 }
 
 // -----------------------------------------------------------------------------
 template <typename T>
-void findStatisticsImpl(std::vector<T>& data, std::vector<IDataArray*>& arrays, const FindArrayStatisticsInputValues* inputValues)
+float32 FindMedian(nonstd::span<T> values)
 {
-  if(inputValues->FindLength)
+  if(values.empty())
   {
-    auto* array0 = dynamic_cast<DataArray<uint64>*>(arrays[0]);
-    if(array0 == nullptr)
-    {
-      throw std::invalid_argument("findStatisticsImpl() could not dynamic_cast 'Length' array to needed type. Check input array selection.");
-    }
-    uint64 val = static_cast<uint64>(data.size());
-    array0->initializeTuple(0, val);
+    return 0.0f;
   }
-  if(inputValues->FindMin)
+  const usize idxHigh = values.size() / 2;
+  std::nth_element(values.begin(), values.begin() + idxHigh, values.end());
+  if(values.size() % 2 == 1)
   {
-    auto* array1 = dynamic_cast<DataArray<T>*>(arrays[1]);
-    if(array1 == nullptr)
-    {
-      throw std::invalid_argument("findStatisticsImpl() could not dynamic_cast 'Min' array to needed type. Check input array selection.");
-    }
-    T val = StaticicsCalculations::findMin(data);
-    array1->initializeTuple(0, val);
+    return static_cast<float32>(values[idxHigh]);
   }
-  if(inputValues->FindMax)
+  const T low = *std::max_element(values.begin(), values.begin() + idxHigh);
+  return (low + values[idxHigh]) * 0.5f;
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+std::vector<float32> FindHistogram(nonstd::span<const T> values, float32 histMin, float32 histMax, int32 numBins)
+{
+  std::vector<float32> histogram(numBins, 0.0f);
+  if(values.empty())
   {
-    auto* array2 = dynamic_cast<DataArray<T>*>(arrays[2]);
-    if(array2 == nullptr)
-    {
-      throw std::invalid_argument("findStatisticsImpl() could not dynamic_cast 'Max' array to needed type. Check input array selection.");
-    }
-    T val = StaticicsCalculations::findMax(data);
-    array2->initializeTuple(0, val);
+    return histogram;
   }
-  if(inputValues->FindMean)
+
+  const float32 increment = (histMax - histMin) / static_cast<float32>(numBins);
+  if(numBins == 1 || std::abs(increment) < 1E-10)
   {
-    auto* array3 = dynamic_cast<Float32Array*>(arrays[3]);
-    if(array3 == nullptr)
-    {
-      throw std::invalid_argument("findStatisticsImpl() could not dynamic_cast 'Mean' array to needed type. Check input array selection.");
-    }
-    float32 val = StaticicsCalculations::findMean(data);
-    array3->initializeTuple(0, val);
+    // if one bin, just set the first element to total number of points
+    histogram[0] = static_cast<float32>(values.size());
+    return histogram;
   }
-  if(inputValues->FindMedian)
+
+  for(const T value : values)
   {
-    auto* array4 = dynamic_cast<Float32Array*>(arrays[4]);
-    if(array4 == nullptr)
+    const auto floatValue = static_cast<float32>(value);
+    const auto bin = static_cast<usize>((floatValue - histMin) / increment);
+    if(bin < static_cast<usize>(numBins))
     {
-      throw std::invalid_argument("findStatisticsImpl() could not dynamic_cast 'Median' array to needed type. Check input array selection.");
+      histogram[bin]++;
     }
-    float32 val = StaticicsCalculations::findMedian(data);
-    array4->initializeTuple(0, val);
-  }
-  if(inputValues->FindStdDeviation)
-  {
-    auto* array5 = dynamic_cast<Float32Array*>(arrays[5]);
-    if(array5 == nullptr)
+    else if(floatValue == histMax)
     {
-      throw std::invalid_argument("findStatisticsImpl() could not dynamic_cast 'StdDev' array to needed type. Check input array selection.");
+      histogram[numBins - 1]++;
     }
-    float32 val = StaticicsCalculations::findStdDeviation(data);
-    array5->initializeTuple(0, val);
   }
-  if(inputValues->FindSummation)
+  return histogram;
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+class FindArrayStatisticsImpl
+{
+public:
+  FindArrayStatisticsImpl(FeatureValues<T>& featureValues, bool length, bool min, bool max, bool mean, bool median, bool stdDeviation, bool summation, std::vector<IDataArray*>& arrays, bool hist,
+                          float64 histmin, float64 histmax, bool histfullrange, int32 numBins)
+  : m_FeatureValues(featureValues)
+  , m_Length(length)
+  , m_Min(min)
+  , m_Max(max)
+  , m_Mean(mean)
+  , m_Median(median)
+  , m_StdDeviation(stdDeviation)
+  , m_Summation(summation)
+  , m_Histogram(hist)
+  , m_HistMin(histmin)
+  , m_HistMax(histmax)
+  , m_HistFullRange(histfullrange)
+  , m_NumBins(numBins)
   {
-    auto* array6 = dynamic_cast<Float32Array*>(arrays[6]);
-    if(array6 == nullptr)
+    m_LengthArray = dynamic_cast<DataArray<uint64>*>(arrays[0]);
+    if(m_Length && m_LengthArray == nullptr)
     {
-      throw std::invalid_argument("findStatisticsImpl() could not dynamic_cast 'Summation' array to needed type. Check input array selection.");
+      throw std::invalid_argument("FindArrayStatisticsImpl::compute() could not dynamic_cast 'Length' array to needed type. Check input array selection.");
     }
-    float32 val = StaticicsCalculations::findSummation(data);
-    array6->initializeTuple(0, val);
-  }
-  if(inputValues->FindHistogram)
-  {
-    auto* array7 = dynamic_cast<Float32Array*>(arrays[7]);
-    if(array7 == nullptr)
+    m_MinArray = dynamic_cast<DataArray<T>*>(arrays[1]);
+    if(m_Min && m_MinArray == nullptr)
+    {
+      throw std::invalid_argument("FindArrayStatisticsImpl::compute() could not dynamic_cast 'Min' array to needed type. Check input array selection.");
+    }
+    m_MaxArray = dynamic_cast<DataArray<T>*>(arrays[2]);
+    if(m_Max && m_MaxArray == nullptr)
+    {
+      throw std::invalid_argument("FindArrayStatisticsImpl::compute() could not dynamic_cast 'Max' array to needed type. Check input array selection.");
+    }
+    m_MeanArray = dynamic_cast<Float32Array*>(arrays[3]);
+    if(m_Mean && m_MeanArray == nullptr)
+    {
+      throw std::invalid_argument("FindArrayStatisticsImpl::compute() could not dynamic_cast 'Mean' array to needed type. Check input array selection.");
+    }
+    m_MedianArray = dynamic_cast<Float32Array*>(arrays[4]);
+    if(m_Median && m_MedianArray == nullptr)
     {
-      throw std::invalid_argument("findStatisticsImpl() could not dynamic_cast 'Histogram' array to needed type. Check input array selection.");
+      throw std::invalid_argument("FindArrayStatisticsImpl::compute() could not dynamic_cast 'Median' array to needed type. Check input array selection.");
     }
-    auto* arr7DataStore = array7->getDataStore();
-    if(arr7DataStore != nullptr)
+    m_StdDeviationArray = dynamic_cast<Float32Array*>(arrays[5]);
+    if(m_StdDeviation && m_StdDeviationArray == nullptr)
     {
-      std::vector<float32> vals = StaticicsCalculations::findHistogram(data, inputValues->MinRange, inputValues->MaxRange, inputValues->UseFullRange, inputValues->NumBins);
-      arr7DataStore->setTuple(0, vals);
+      throw std::invalid_argument("FindArrayStatisticsImpl::compute() could not dynamic_cast 'StdDev' array to needed type. Check input array selection.");
+    }
+    m_SummationArray = dynamic_cast<Float32Array*>(arrays[6]);
+    if(m_Summation && m_SummationArray == nullptr)
+    {
+      throw std::invalid_argument("FindArrayStatisticsImpl::compute() could not dynamic_cast 'Summation' array to needed type. Check input array selection.");
+    }
+    m_HistogramArray = dynamic_cast<Float32Array*>(arrays[7]);
+    if(m_Histogram && m_HistogramArray == nullptr)
+    {
+      throw std::invalid_argument("FindArrayStatisticsImpl::compute() could not dynamic_cast 'Histogram' array to needed type. Check input array selection.");
     }
   }
-}
 
-// -----------------------------------------------------------------------------
-template <typename T>
-void findStatistics(const DataArray<T>& source, const Int32Array* featureIds, const std::unique_ptr<MaskCompare>& mask, const FindArrayStatisticsInputValues* inputValues,
-                    std::vector<IDataArray*>& arrays, int32 numFeatures)
-{
-  usize numTuples = source.getNumberOfTuples();
-  if(inputValues->ComputeByIndex)
+  virtual ~FindArrayStatisticsImpl() = default;
+
+  /**
+   * @brief Computes the statistics of one feature and writes them to its tuple. The values are
+   * processed as numChunks fixed chunks, which are combined in order. A single chunk gives the
+   * same results as StaticicsCalculations; more chunks only change the rounding of the float
+   * summation and standard deviation.
+   * @param featureIndex
+   * @param numChunks
+   */
+  void computeFeature(usize featureIndex, usize numChunks) const
   {
-    std::unordered_map<int32, std::list<T>> featureValueMap;
+    nonstd::span<T> values = m_FeatureValues.getValues(featureIndex);
+    const nonstd::span<const T> constValues = values;
+
+    ValueAccumulator<T> accumulator;
+    for(const ValueAccumulator<T>& chunkAccumulator : MapChunks(constValues, numChunks, [](nonstd::span<const T> chunk) {
+          ValueAccumulator<T> chunkAccumulator;
+          for(const T value : chunk)
+          {
+            chunkAccumulator.add(value);
+          }
+          return chunkAccumulator;
+        }))
+    {
+      accumulator.merge(chunkAccumulator);
+    }
 
-    for(size_t i = 0; i < numTuples; i++)
+    if(m_Length)
     {
-      if(inputValues->UseMask)
+      m_LengthArray->initializeTuple(featureIndex, static_cast<uint64>(values.size()));
+    }
+    if(m_Min)
+    {
+      m_MinArray->initializeTuple(featureIndex, accumulator.getMin());
+    }
+    if(m_Max)
+    {
+      m_MaxArray->initializeTuple(featureIndex, accumulator.getMax());
+    }
+    if(m_Mean)
+    {
+      m_MeanArray->initializeTuple(featureIndex, accumulator.getMean());
+    }
+    if(m_StdDeviation)
+    {
+      float32 stdDeviation = 0.0f;
+      if(!values.empty())
       {
-        if(mask->isTrue(i))
+        const float32 mean = accumulator.getMean();
+        float32 squaredSum = 0.0f;
+        for(const float32 chunkSquaredSum : MapChunks(constValues, numChunks, [mean](nonstd::span<const T> chunk) { return SumSquaredDifferences(chunk, mean); }))
         {
-          featureValueMap[featureIds->at(i)].push_back(source[i]);
+          squaredSum += chunkSquaredSum;
         }
+        stdDeviation = std::sqrt(squaredSum / static_cast<float32>(values.size()));
       }
-      else
-      {
-        featureValueMap[featureIds->at(i)].push_back(source[i]);
-      }
+      m_StdDeviationArray->initializeTuple(featureIndex, stdDeviation);
     }
-
-    // compute the statistics by feature/ensemble id
-    findStatisticsByIndexImpl<T>(featureValueMap, arrays, inputValues, numFeatures);
-  }
-  else
-  {
-    std::vector<T> data;
-    data.reserve(numTuples);
-    for(size_t i = 0; i < numTuples; i++)
+    if(m_Summation)
+    {
+      m_SummationArray->initializeTuple(featureIndex, accumulator.getSum());
+    }
+    if(m_Histogram)
     {
-      if(inputValues->UseMask)
+      auto* arr7DataStore = m_HistogramArray->getDataStore();
+      if(arr7DataStore != nullptr)
       {
-        if(mask->isTrue(i))
+        float32 histMin = static_cast<float32>(m_HistMin);
+        float32 histMax = static_cast<float32>(m_HistMax);
+        if(m_HistFullRange)
         {
-          data.push_back(source[i]);
+          histMin = static_cast<float32>(accumulator.getMin());
+          histMax = static_cast<float32>(accumulator.getMax());
         }
+        std::vector<float32> vals(m_NumBins, 0.0f);
+        for(const std::vector<float32>& chunkHistogram :
+            MapChunks(constValues, numChunks, [&](nonstd::span<const T> chunk) { return FindHistogram<T>(chunk, histMin, histMax, m_NumBins); }))
+        {
+          std::transform(vals.cbegin(), vals.cend(), chunkHistogram.cbegin(), vals.begin(), std::plus<>());
+        }
+        arr7DataStore->setTuple(featureIndex, vals);
       }
-      else
-      {
-        data.push_back(source[i]);
-      }
     }
+    // Partially sorts the values so it must come last
+    if(m_Median)
+    {
+      m_MedianArray->initializeTuple(featureIndex, FindMedian(values));
+    }
+  }
 
-    data.shrink_to_fit();
+  void compute(usize start, usize end) const
+  {
+    for(usize i = start; i < end; i++)
+    {
+      computeFeature(i, 1);
+    }
+  }
 
-    // compute the statistics for the entire array
-    findStatisticsImpl<T>(data, arrays, inputValues);
+  void operator()(const ComplexRange& range) const
+  {
+    compute(range.min(), range.max());
   }
+
+private:
+  FeatureValues<T>& m_FeatureValues;
+  bool m_Length;
+  bool m_Min;
+  bool m_Max;
+  bool m_Mean;
+  bool m_Median;
+  bool m_StdDeviation;
+  bool m_Summation;
+  bool m_Histogram;
+  float64 m_HistMin;
+  float64 m_HistMax;
+  bool m_HistFullRange;
+  int32 m_NumBins;
+  DataArray<uint64>* m_LengthArray = nullptr;
+  DataArray<T>* m_MinArray = nullptr;
+  DataArray<T>* m_MaxArray = nullptr;
+  Float32Array* m_MeanArray = nullptr;
+  Float32Array* m_MedianArray = nullptr;
+  Float32Array* m_StdDeviationArray = nullptr;
+  Float32Array* m_SummationArray = nullptr;
+  Float32Array* m_HistogramArray = nullptr;
+};
+
+// -----------------------------------------------------------------------------
+template <typename T>
+void findStatistics(const DataArray<T>& source, const Int32Array* featureIds, const std::unique_ptr<MaskCompare>& mask, const FindArrayStatisticsInputValues* inputValues,
+                    std::vector<IDataArray*>& arrays, int32 numFeatures)
+{
+  // The statistics of the entire array are computed as a single feature
+  const usize numGroups = inputValues->ComputeByIndex ? static_cast<usize>(std::max(numFeatures, 0)) : 1;
+  const Int32Array* groupIds = inputValues->ComputeByIndex ? featureIds : nullptr;
+  FeatureValues<T> featureValues = GroupValuesByFeature<T>(source, groupIds, inputValues->UseMask ? mask.get() : nullptr, numGroups);
+
+  FindArrayStatisticsImpl<T> statisticsImpl(featureValues, inputValues->FindLength, inputValues->FindMin, inputValues->FindMax, inputValues->FindMean, inputValues->FindMedian,
+                                            inputValues->FindStdDeviation, inputValues->FindSummation, arrays, inputValues->FindHistogram, inputValues->MinRange, inputValues->MaxRange,
+                                            inputValues->UseFullRange, inputValues->NumBins);
+  if(!inputValues->ComputeByIndex)
+  {
+    // The single feature is split into chunks of values instead
+    statisticsImpl.computeFeature(0, std::max<usize>(featureValues.values.size() / k_MinValuesPerChunk, 1));
+    return;
+  }
+
+  // compute the statistics by feature/ensemble id
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, numGroups);
+  dataAlg.execute(statisticsImpl);
 }
 
 // -----------------------------------------------------------------------------
@@ -500,6 +704,13 @@ Result<> FindArrayStatistics::operator()()
     arrays[7] = m_DataStructure.getDataAs<IDataArray>(m_InputValues->HistogramArrayName);
   }
 
+  // The output arrays hold one tuple per feature/ensemble
+  if(m_InputValues->ComputeByIndex)
+  {
+    auto outputArray = std::find_if(arrays.cbegin(), arrays.cend(), [](const IDataArray* array) { return array != nullptr; });
+    numFeatures = static_cast<int32>((*outputArray)->getNumberOfTuples());
+  }
+
   const auto& inputArray = m_DataStructure.getDataRefAs<IDataArray>(m_InputValues->SelectedArrayPath);
   auto dataType = inputArray.getDataType();
   switch(dataType)
@@ -6,9 +6,71 @@
 #include "complex/DataStructure/Geometry/AbstractGeometry.hpp"
 #include "complex/DataStructure/Geometry/AbstractGeometry2D.hpp"
 #include "complex/DataStructure/Geometry/TriangleGeom.hpp"
+#include "complex/Utilities/CompressedRows.hpp"
+#include "complex/Utilities/ParallelDataAlgorithm.hpp"
+
+#include <algorithm>
 
 using namespace complex;
 
+namespace
+{
+using MeshIndexType = AbstractGeometry::MeshIndexType;
+
+/**
+ * @brief A compressed sparse row list of the vertices that share an edge with each
+ * vertex. The neighbors of each vertex are stored in increasing order so that every
+ * sweep sums the deltas in the same order.
+ */
+using VertexAdjacency = CompressedRows::Table<MeshIndexType>;
+
+VertexAdjacency FindVertexAdjacency(const AbstractGeometry::SharedEdgeList& edges, usize numVertices)
+{
+  return CompressedRows::Build<MeshIndexType>(edges.getNumberOfTuples(), numVertices, [&edges](usize edge, auto&& emit) {
+    const MeshIndexType vertex0 = edges[2 * edge];
+    const MeshIndexType vertex1 = edges[2 * edge + 1];
+    emit(vertex0, vertex1);
+    emit(vertex1, vertex0);
+  });
+}
+
+/**
+ * @brief Moves every vertex towards the mean of its neighbors by its lambda scaled by
+ * the factor. The new positions are written to a separate buffer, so each vertex is
+ * gathered and written by a single thread and the sweep can run in parallel.
+ */
+void SmoothVertices(const VertexAdjacency& adjacency, const std::vector<float>& lambdas, float32 factor, nonstd::span<const float32> source, nonstd::span<float32> target)
+{
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, source.size() / 3);
+  dataAlg.execute([&](const ComplexRange& range) {
+    for(usize vertex = range.min(); vertex < range.max(); vertex++)
+    {
+      const nonstd::span<const MeshIndexType> neighbors = adjacency.getRow(vertex);
+      // Vertices that are not part of any edge stay in place
+      if(neighbors.empty())
+      {
+        std::copy_n(source.begin() + 3 * vertex, 3, target.begin() + 3 * vertex);
+        continue;
+      }
+      double delta[3] = {0.0, 0.0, 0.0};
+      for(MeshIndexType neighbor : neighbors)
+      {
+        for(usize j = 0; j < 3; j++)
+        {
+          delta[j] += static_cast<double>(source[3 * neighbor + j] - source[3 * vertex + j]);
+        }
+      }
+      const float ll = lambdas[vertex] * factor;
+      for(usize j = 0; j < 3; j++)
+      {
+        target[3 * vertex + j] = source[3 * vertex + j] + ll * static_cast<float32>(delta[j] / static_cast<double>(neighbors.size()));
+      }
+    }
+  });
+}
+} // namespace
+
 LaplacianSmoothing::LaplacianSmoothing(DataStructure& dataStructure, LaplacianSmoothingInputValues* inputValues, const std::atomic_bool& shouldCancel, const IFilter::MessageHandler& mesgHandler)
 : m_DataStructure(dataStructure)
 , m_InputValues(inputValues)
@@ -30,8 +92,6 @@ Result<> LaplacianSmoothing::operator()()
 Result<> LaplacianSmoothing::edgeBasedSmoothing()
 {
   int32_t err = 0;
-  //  DataContainer::Pointer sm = getDataContainerArray()->getDataContainer(getSurfaceDataContainerName());
-  //  IGeometry2D::Pointer surfaceMesh = sm->getGeometryAs<IGeometry2D>();
 
   TriangleGeom& surfaceMesh = m_DataStructure.getDataRefAs<TriangleGeom>(m_InputValues->pTriangleGeometryDataPath);
 
@@ -40,6 +100,10 @@ Result<> LaplacianSmoothing::edgeBasedSmoothing()
 
   // Generate the Lambda Array
   std::vector<float> lambdas = generateLambdaArray();
+  if(lambdas.size() < nvert)
+  {
+    return MakeErrorResult(-561, fmt::format("The node type array has {} tuples but the triangle geometry has {} vertices", lambdas.size(), nvert));
+  }
 
   //  Generate the Unique Edges
   if(nullptr == surfaceMesh.getEdges())
@@ -51,104 +115,43 @@ Result<> LaplacianSmoothing::edgeBasedSmoothing()
     return MakeErrorResult(-560, "Error retrieving the shared edge list");
   }
 
-  AbstractGeometry::SharedEdgeList& uedges = *(surfaceMesh.getEdges());
-  AbstractGeometry::MeshIndexType nedges = uedges.getNumberOfTuples();
-
-  std::vector<int32_t> numConnections(nvert, 0);
+  // The connectivity does not change while smoothing, so the neighbors of every vertex
+  // are gathered once instead of walking the edge list in every sweep
+  m_MessageHandler(IFilter::Message::Type::Info, "Building vertex adjacency");
+  const VertexAdjacency adjacency = FindVertexAdjacency(*(surfaceMesh.getEdges()), nvert);
 
-  std::vector<double> deltaArray(nvert * 3);
-  double dlta = 0.0;
+  // Each sweep reads the positions from one buffer and writes them to the other
+  std::vector<float32> positionBuffer(nvert * 3);
+  nonstd::span<float32> source = verts.createSpan().first(nvert * 3);
+  nonstd::span<float32> target(positionBuffer.data(), positionBuffer.size());
 
   for(int32_t q = 0; q < m_InputValues->pIterationSteps; q++)
   {
+    // Stop between sweeps so that the vertices are left in a consistent state
     if(m_ShouldCancel)
     {
-      return {};
+      break;
     }
     m_MessageHandler(IFilter::Message::Type::Info, fmt::format("Iteration {} of {}", q, m_InputValues->pIterationSteps));
-    // Compute the Deltas for each point
-    for(AbstractGeometry::MeshIndexType i = 0; i < nedges; i++)
-    {
-      AbstractGeometry::MeshIndexType in1 = uedges[2 * i];     // row of the first vertex
-      AbstractGeometry::MeshIndexType in2 = uedges[2 * i + 1]; // row the second vertex
-
-      for(AbstractGeometry::MeshIndexType j = 0; j < 3; j++)
-      {
-#if 0
-        Q_ASSERT(static_cast<size_t>(3 * in1 + j) < static_cast<size_t>(nvert * 3));
-        Q_ASSERT(static_cast<size_t>(3 * in2 + j) < static_cast<size_t>(nvert * 3));
-#endif
-        dlta = static_cast<double>(verts[3 * in2 + j] - verts[3 * in1 + j]);
-        deltaArray[3 * in1 + j] += dlta;
-        deltaArray[3 * in2 + j] += -1.0 * dlta;
-      }
-      numConnections[in1] += 1;
-      numConnections[in2] += 1;
-    }
-
-    // Move each point
-    for(AbstractGeometry::MeshIndexType i = 0; i < nvert; i++)
-    {
-      for(AbstractGeometry::MeshIndexType j = 0; j < 3; j++)
-      {
-        AbstractGeometry::MeshIndexType in0 = 3 * i + j;
-        dlta = deltaArray[in0] / numConnections[i];
-
-        float ll = lambdas[i];
-        verts[3 * i + j] += ll * dlta;
-        deltaArray[in0] = 0.0; // reset for next iteration
-      }
-      numConnections[i] = 0; // reset for next iteration
-    }
+    SmoothVertices(adjacency, lambdas, 1.0f, source, target);
+    std::swap(source, target);
 
     // Now optionally apply a negative lambda based on the mu Factor value.
     // This is from Taubin's paper on smoothing without shrinkage. This effectively
     // runs a low pass filter on the data
     if(m_InputValues->pUseTaubinSmoothing)
     {
-
-      if(m_ShouldCancel)
-      {
-        return {};
-      }
-      m_MessageHandler(IFilter::Message::Type::Info, fmt::format("Iteration {} of {}", q, m_InputValues->pIterationSteps));
-      // Compute the Delta's
-      for(AbstractGeometry::MeshIndexType i = 0; i < nedges; i++)
-      {
-        AbstractGeometry::MeshIndexType in1 = uedges[2 * i];     // row of the first vertex
-        AbstractGeometry::MeshIndexType in2 = uedges[2 * i + 1]; // row the second vertex
-
-        for(int32_t j = 0; j < 3; j++)
-        {
-#if 0
-          Q_ASSERT(static_cast<size_t>(3 * in1 + j) < static_cast<size_t>(nvert * 3));
-          Q_ASSERT(static_cast<size_t>(3 * in2 + j) < static_cast<size_t>(nvert * 3));
-#endif
-          dlta = verts[3 * in2 + j] - verts[3 * in1 + j];
-          deltaArray[3 * in1 + j] += dlta;
-          deltaArray[3 * in2 + j] += -1.0 * dlta;
-        }
-        numConnections[in1] += 1;
-        numConnections[in2] += 1;
-      }
-
-      // MOve the points
-      for(AbstractGeometry::MeshIndexType i = 0; i < nvert; i++)
-      {
-        for(AbstractGeometry::MeshIndexType j = 0; j < 3; j++)
-        {
-          AbstractGeometry::MeshIndexType in0 = 3 * i + j;
-          dlta = deltaArray[in0] / numConnections[i];
-
-          float ll = lambdas[i] * m_InputValues->pMuFactor;
-          verts[3 * i + j] += ll * dlta;
-          deltaArray[in0] = 0.0; // reset for next iteration
-        }
-        numConnections[i] = 0; // reset for next iteration
-      }
+      SmoothVertices(adjacency, lambdas, m_InputValues->pMuFactor, source, target);
+      std::swap(source, target);
     }
   }
 
+  // The last sweep may have written the scratch buffer
+  if(source.data() != verts.createSpan().data())
+  {
+    std::copy(source.begin(), source.end(), verts.begin());
+  }
+
   return {};
 }
 
@@ -6,10 +6,13 @@
 #include "complex/DataStructure/Geometry/ImageGeom.hpp"
 #include "complex/DataStructure/Geometry/TriangleGeom.hpp"
 #include "complex/Utilities/DataArrayUtilities.hpp"
+#include "complex/Utilities/ParallelDataAlgorithm.hpp"
 
 #include "TupleTransfer.hpp"
 
+#include <algorithm>
 #include <array>
+#include <limits>
 #include <random>
 #include <unordered_map>
 
@@ -56,6 +59,263 @@ struct EdgeHasher
 using VertexMap = std::unordered_map<Vertex, AbstractGeometry::MeshIndexType, VertexHasher>;
 using EdgeMap = std::unordered_map<Edge, AbstractGeometry::MeshIndexType, EdgeHasher>;
 
+// -----------------------------------------------------------------------------
+using MeshIndexType = AbstractGeometry::MeshIndexType;
+
+constexpr MeshIndexType k_UnassignedNode = std::numeric_limits<MeshIndexType>::max();
+
+// Number of Z planes meshed by a single task. Each slab replays up to two planes of the slab below it,
+// and the split does not depend on the number of threads so every machine meshes the same slabs.
+constexpr usize k_SlabHeight = 16;
+
+// Grid offsets of the four nodes of each voxel face in the order the triangles reference them
+// -X, -Y, -Z, +X, +Y, +Z
+constexpr std::array<std::array<std::array<usize, 3>, 4>, 6> k_FaceNodeOffsets = {{
+    {{{0, 0, 0}, {0, 1, 0}, {0, 0, 1}, {0, 1, 1}}},
+    {{{0, 0, 0}, {1, 0, 0}, {0, 0, 1}, {1, 0, 1}}},
+    {{{0, 0, 0}, {1, 0, 0}, {0, 1, 0}, {1, 1, 0}}},
+    {{{1, 0, 0}, {1, 1, 0}, {1, 0, 1}, {1, 1, 1}}},
+    {{{1, 1, 0}, {0, 1, 0}, {1, 1, 1}, {0, 1, 1}}},
+    {{{1, 0, 1}, {0, 0, 1}, {1, 1, 1}, {0, 1, 1}}},
+}};
+
+/**
+ * @brief Walks the voxels of a grid one Z layer at a time, numbering each boundary node
+ * the first time one of its faces is found. Only the node ids of the two planes of the
+ * current layer are kept so the memory use does not depend on the number of layers.
+ */
+class SlabMesher
+{
+public:
+  struct MeshOutput
+  {
+    const AbstractGeometryGrid* grid;
+    nonstd::span<float32> vertices;
+    nonstd::span<MeshIndexType> triangles;
+    nonstd::span<int32> faceLabels;
+    nonstd::span<int8> nodeTypes;
+    const std::vector<std::shared_ptr<AbstractTupleTransfer>>& tupleTransferFunctions;
+  };
+
+  SlabMesher(nonstd::span<const int32> featureIds, const SizeVec3& dims, const MeshOutput* output = nullptr)
+  : m_FeatureIds(featureIds)
+  , m_XPoints(dims[0])
+  , m_YPoints(dims[1])
+  , m_ZPoints(dims[2])
+  , m_Output(output)
+  {
+    const usize planeSize = (m_XPoints + 1) * (m_YPoints + 1);
+    m_Planes[0].assign(planeSize, k_UnassignedNode);
+    m_Planes[1].assign(planeSize, k_UnassignedNode);
+  }
+
+  MeshIndexType getNextNodeId() const
+  {
+    return m_NextNodeId;
+  }
+
+  void setNextNodeId(MeshIndexType nodeId)
+  {
+    m_NextNodeId = nodeId;
+  }
+
+  MeshIndexType getTriangleIndex() const
+  {
+    return m_TriangleIndex;
+  }
+
+  void setTriangleIndex(MeshIndexType triangleIndex)
+  {
+    m_TriangleIndex = triangleIndex;
+  }
+
+  /**
+   * @brief Finds the faces of the voxels in layer k. If EmitMesh is false the faces
+   * are only counted, otherwise the nodes, triangles and face data are written.
+   * @param k
+   */
+  template <bool EmitMesh>
+  void walkLayer(usize k)
+  {
+    m_Layer = k;
+    for(usize j = 0; j < m_YPoints; j++)
+    {
+      for(usize i = 0; i < m_XPoints; i++)
+      {
+        const usize point = (k * m_XPoints * m_YPoints) + (j * m_XPoints) + i;
+        const int32 feature = m_FeatureIds[point];
+
+        if(i == 0)
+        {
+          addFace<EmitMesh>(0, i, j, true, -1, feature, point, point);
+        }
+        if(j == 0)
+        {
+          addFace<EmitMesh>(1, i, j, false, -1, feature, point, point);
+        }
+        if(k == 0)
+        {
+          addFace<EmitMesh>(2, i, j, true, -1, feature, point, point);
+        }
+        if(i == (m_XPoints - 1)) // Takes care of the end of a Row...
+        {
+          addFace<EmitMesh>(3, i, j, false, -1, feature, point, point);
+        }
+        else if(feature != m_FeatureIds[point + 1])
+        {
+          const usize neighbor = point + 1;
+          const int32 neighborFeature = m_FeatureIds[neighbor];
+          addFace<EmitMesh>(3, i, j, feature < neighborFeature, std::min(feature, neighborFeature), std::max(feature, neighborFeature), neighbor, point);
+        }
+        if(j == (m_YPoints - 1)) // Takes care of the end of a column
+        {
+          addFace<EmitMesh>(4, i, j, false, -1, feature, point, point);
+        }
+        else if(feature != m_FeatureIds[point + m_XPoints])
+        {
+          const usize neighbor = point + m_XPoints;
+          const int32 neighborFeature = m_FeatureIds[neighbor];
+          addFace<EmitMesh>(4, i, j, feature > neighborFeature, std::min(feature, neighborFeature), std::max(feature, neighborFeature), neighbor, point);
+        }
+        if(k == (m_ZPoints - 1)) // Takes care of the end of a Pillar
+        {
+          addFace<EmitMesh>(5, i, j, true, -1, feature, point, point);
+        }
+        else if(feature != m_FeatureIds[point + m_XPoints * m_YPoints])
+        {
+          const usize neighbor = point + m_XPoints * m_YPoints;
+          const int32 neighborFeature = m_FeatureIds[neighbor];
+          addFace<EmitMesh>(5, i, j, feature < neighborFeature, std::min(feature, neighborFeature), std::max(feature, neighborFeature), neighbor, point);
+        }
+      }
+    }
+  }
+
+  /**
+   * @brief Moves the top plane of node ids down to start the next layer.
+   */
+  void nextLayer()
+  {
+    std::swap(m_Planes[0], m_Planes[1]);
+    std::fill(m_Planes[1].begin(), m_Planes[1].end(), k_UnassignedNode);
+  }
+
+private:
+  /**
+   * @brief Returns the id of the node at (x, y) on the bottom (dz = 0) or top (dz = 1)
+   * plane of the current layer, numbering it if this is the first time it is found.
+   */
+  template <bool EmitMesh>
+  MeshIndexType getNodeId(usize x, usize y, usize dz)
+  {
+    MeshIndexType& nodeId = m_Planes[dz][y * (m_XPoints + 1) + x];
+    if(nodeId == k_UnassignedNode)
+    {
+      nodeId = m_NextNodeId++;
+      if constexpr(EmitMesh)
+      {
+        createNode(nodeId, x, y, m_Layer + dz);
+      }
+    }
+    return nodeId;
+  }
+
+  /**
+   * @brief Adds the two triangles of one face of voxel (i, j) of the current layer.
+   * The triangles are wound (n1, n3, n2), (n2, n3, n4) if flip is true and
+   * (n1, n2, n3), (n2, n4, n3) otherwise.
+   */
+  template <bool EmitMesh>
+  void addFace(usize face, usize i, usize j, bool flip, int32 label0, int32 label1, usize firstIndex, usize secondIndex)
+  {
+    std::array<MeshIndexType, 4> nodes = {};
+    for(usize n = 0; n < 4; n++)
+    {
+      const auto& offset = k_FaceNodeOffsets[face][n];
+      nodes[n] = getNodeId<EmitMesh>(i + offset[0], j + offset[1], offset[2]);
+    }
+
+    if constexpr(!EmitMesh)
+    {
+      m_TriangleIndex += 2;
+    }
+    else
+    {
+      constexpr std::array<usize, 6> k_Winding = {0, 1, 2, 1, 3, 2};
+      constexpr std::array<usize, 6> k_FlippedWinding = {0, 2, 1, 1, 2, 3};
+      const auto& winding = flip ? k_FlippedWinding : k_Winding;
+      for(usize t = 0; t < 2; t++)
+      {
+        for(usize c = 0; c < 3; c++)
+        {
+          m_Output->triangles[m_TriangleIndex * 3 + c] = nodes[winding[t * 3 + c]];
+        }
+        m_Output->faceLabels[m_TriangleIndex * 2] = label0;
+        m_Output->faceLabels[m_TriangleIndex * 2 + 1] = label1;
+        for(const auto& tupleTransfer : m_Output->tupleTransferFunctions)
+        {
+          tupleTransfer->transfer(m_TriangleIndex, firstIndex, secondIndex, true);
+        }
+        m_TriangleIndex++;
+      }
+    }
+  }
+
+  /**
+   * @brief Writes the coordinates and the node type of a node. The node type is the number
+   * of unique Feature Ids among the voxels that share the node (up to 4), counting the outside
+   * of the grid as Feature -1, plus 10 if one of those Feature Ids is -1.
+   */
+  void createNode(MeshIndexType nodeId, usize x, usize y, usize z)
+  {
+    complex::Point3D<float64> coords = m_Output->grid->getPlaneCoords(x, y, z);
+    m_Output->vertices[nodeId * 3] = static_cast<float32>(coords[0]);
+    m_Output->vertices[nodeId * 3 + 1] = static_cast<float32>(coords[1]);
+    m_Output->vertices[nodeId * 3 + 2] = static_cast<float32>(coords[2]);
+
+    std::array<int32, 9> owners = {};
+    usize numOwners = 0;
+    auto addOwner = [&owners, &numOwners](int32 feature) {
+      if(std::find(owners.begin(), owners.begin() + numOwners, feature) == owners.begin() + numOwners)
+      {
+        owners[numOwners++] = feature;
+      }
+    };
+
+    if(x == 0 || y == 0 || z == 0 || x == m_XPoints || y == m_YPoints || z == m_ZPoints)
+    {
+      addOwner(-1);
+    }
+    for(usize vz = std::max<usize>(z, 1) - 1; vz <= std::min(z, m_ZPoints - 1); vz++)
+    {
+      for(usize vy = std::max<usize>(y, 1) - 1; vy <= std::min(y, m_YPoints - 1); vy++)
+      {
+        for(usize vx = std::max<usize>(x, 1) - 1; vx <= std::min(x, m_XPoints - 1); vx++)
+        {
+          addOwner(m_FeatureIds[(vz * m_XPoints * m_YPoints) + (vy * m_XPoints) + vx]);
+        }
+      }
+    }
+
+    auto nodeType = static_cast<int8>(std::min<usize>(numOwners, 4));
+    if(std::find(owners.begin(), owners.begin() + numOwners, -1) != owners.begin() + numOwners)
+    {
+      nodeType += 10;
+    }
+    m_Output->nodeTypes[nodeId] = nodeType;
+  }
+
+  nonstd::span<const int32> m_FeatureIds;
+  usize m_XPoints = 0;
+  usize m_YPoints = 0;
+  usize m_ZPoints = 0;
+  const MeshOutput* m_Output = nullptr;
+  std::array<std::vector<MeshIndexType>, 2> m_Planes;
+  usize m_Layer = 0;
+  MeshIndexType m_NextNodeId = 0;
+  MeshIndexType m_TriangleIndex = 0;
+};
+
 } // namespace
 
 // -----------------------------------------------------------------------------
@@ -74,23 +334,11 @@ QuickSurfaceMesh::~QuickSurfaceMesh() noexcept = default;
 Result<> QuickSurfaceMesh::operator()()
 {
   DataObject::IdType parentGroupId = m_DataStructure.getId(m_Inputs->pParentDataGroupPath).value();
-  // Get the ImageGeometry
-  AbstractGeometryGrid& grid = m_DataStructure.getDataRefAs<AbstractGeometryGrid>(m_Inputs->pGridGeomDataPath);
 
   // Get the Created Triangle Geometry
   TriangleGeom& triangleGeom = m_DataStructure.getDataRefAs<TriangleGeom>(m_Inputs->pTriangleGeometryPath);
 
-  SizeVec3 udims = grid.getDimensions();
-
-  size_t xP = udims[0];
-  size_t yP = udims[1];
-  size_t zP = udims[2];
-
-  std::vector<std::set<int32_t>> ownerLists;
-
-  size_t possibleNumNodes = (xP + 1) * (yP + 1) * (zP + 1);
-  std::vector<MeshIndexType> nodeIds(possibleNumNodes, std::numeric_limits<size_t>::max());
-
+  std::vector<MeshSlab> slabs;
   MeshIndexType nodeCount = 0;
   MeshIndexType triangleCount = 0;
 
@@ -98,8 +346,16 @@ Result<> QuickSurfaceMesh::operator()()
   {
     correctProblemVoxels();
   }
+  if(m_ShouldCancel)
+  {
+    return {};
+  }
 
-  determineActiveNodes(nodeIds, nodeCount, triangleCount);
+  determineActiveNodes(slabs, nodeCount, triangleCount);
+  if(m_ShouldCancel)
+  {
+    return {};
+  }
 
   // now create node and triangle arrays knowing the number that will be needed
   triangleGeom.resizeFaceList(triangleCount);
@@ -112,7 +368,11 @@ Result<> QuickSurfaceMesh::operator()()
     Result<> result = complex::ResizeAndReplaceDataArray(m_DataStructure, dataPath, tupleShape, complex::IDataAction::Mode::Execute);
   }
 
-  createNodesAndTriangles(nodeIds, nodeCount, triangleCount);
+  createNodesAndTriangles(slabs, nodeCount, triangleCount);
+  if(m_ShouldCancel)
+  {
+    return {};
+  }
 
   if(m_Inputs->pGenerateTripleLines)
   {
@@ -465,346 +725,85 @@ void QuickSurfaceMesh::correctProblemVoxels()
 }
 
 // -----------------------------------------------------------------------------
-void QuickSurfaceMesh::determineActiveNodes(std::vector<MeshIndexType>& nodeIds, MeshIndexType& nodeCount, MeshIndexType& triangleCount)
+void QuickSurfaceMesh::determineActiveNodes(std::vector<MeshSlab>& slabs, MeshIndexType& nodeCount, MeshIndexType& triangleCount)
 {
   m_MessageHandler(IFilter::Message::Type::Info, "Determining active Nodes");
 
-  AbstractGeometryGrid* grid = m_DataStructure.getDataAs<AbstractGeometryGrid>(m_Inputs->pGridGeomDataPath);
-
-  Int32Array& featureIds = m_DataStructure.getDataRefAs<Int32Array>(m_Inputs->pFeatureIdsArrayPath);
+  const AbstractGeometryGrid* grid = m_DataStructure.getDataAs<AbstractGeometryGrid>(m_Inputs->pGridGeomDataPath);
+  const auto& featureIds = m_DataStructure.getDataRefAs<Int32Array>(m_Inputs->pFeatureIdsArrayPath);
 
   SizeVec3 udims = grid->getDimensions();
 
-  MeshIndexType xP = udims[0];
-  MeshIndexType yP = udims[1];
-  MeshIndexType zP = udims[2];
-
-  std::vector<std::set<int32_t>> ownerLists;
-
-  MeshIndexType point = 0, neigh1 = 0, neigh2 = 0, neigh3 = 0;
-
-  MeshIndexType nodeId1 = 0, nodeId2 = 0, nodeId3 = 0, nodeId4 = 0;
+  slabs.clear();
+  for(usize zStart = 0; zStart < udims[2]; zStart += k_SlabHeight)
+  {
+    slabs.push_back({zStart, std::min(zStart + k_SlabHeight, udims[2])});
+  }
 
   // first determining which nodes are actually boundary nodes and
-  // count number of nodes and triangles that will be created
-  for(MeshIndexType k = 0; k < zP; k++)
-  {
-    for(MeshIndexType j = 0; j < yP; j++)
+  // count number of nodes and triangles that will be created by each slab
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, slabs.size());
+  dataAlg.execute([&](const ComplexRange& range) {
+    for(usize slabIndex = range.min(); slabIndex < range.max(); slabIndex++)
     {
-      for(MeshIndexType i = 0; i < xP; i++)
+      MeshSlab& slab = slabs[slabIndex];
+      SlabMesher mesher(featureIds.createSpan(), udims);
+      if(slab.zStart > 0)
       {
-        point = (k * xP * yP) + (j * xP) + i;
-        neigh1 = point + 1;
-        neigh2 = point + xP;
-        neigh3 = point + (xP * yP);
+        // Nodes on the first plane that the previous slab touches are counted by that slab
+        mesher.walkLayer<false>(slab.zStart - 1);
+        mesher.nextLayer();
+      }
+      mesher.setNextNodeId(0);
+      mesher.setTriangleIndex(0);
 
-        if(i == 0)
-        {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          if(nodeIds[nodeId1] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId1] = nodeCount;
-            nodeCount++;
-          }
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          if(nodeIds[nodeId2] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId2] = nodeCount;
-            nodeCount++;
-          }
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          if(nodeIds[nodeId3] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId3] = nodeCount;
-            nodeCount++;
-          }
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          if(nodeIds[nodeId4] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId4] = nodeCount;
-            nodeCount++;
-          }
-          triangleCount++;
-          triangleCount++;
-        }
-        if(j == 0)
-        {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          if(nodeIds[nodeId1] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId1] = nodeCount;
-            nodeCount++;
-          }
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          if(nodeIds[nodeId2] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId2] = nodeCount;
-            nodeCount++;
-          }
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          if(nodeIds[nodeId3] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId3] = nodeCount;
-            nodeCount++;
-          }
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          if(nodeIds[nodeId4] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId4] = nodeCount;
-            nodeCount++;
-          }
-          triangleCount++;
-          triangleCount++;
-        }
-        if(k == 0)
-        {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          if(nodeIds[nodeId1] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId1] = nodeCount;
-            nodeCount++;
-          }
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          if(nodeIds[nodeId2] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId2] = nodeCount;
-            nodeCount++;
-          }
-          nodeId3 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          if(nodeIds[nodeId3] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId3] = nodeCount;
-            nodeCount++;
-          }
-          nodeId4 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          if(nodeIds[nodeId4] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId4] = nodeCount;
-            nodeCount++;
-          }
-          triangleCount++;
-          triangleCount++;
-        }
-        if(i == (xP - 1))
-        {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          if(nodeIds[nodeId1] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId1] = nodeCount;
-            nodeCount++;
-          }
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          if(nodeIds[nodeId2] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId2] = nodeCount;
-            nodeCount++;
-          }
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          if(nodeIds[nodeId3] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId3] = nodeCount;
-            nodeCount++;
-          }
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          if(nodeIds[nodeId4] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId4] = nodeCount;
-            nodeCount++;
-          }
-          triangleCount++;
-          triangleCount++;
-        }
-        else if(featureIds[point] != featureIds[neigh1])
-        {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          if(nodeIds[nodeId1] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId1] = nodeCount;
-            nodeCount++;
-          }
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          if(nodeIds[nodeId2] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId2] = nodeCount;
-            nodeCount++;
-          }
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          if(nodeIds[nodeId3] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId3] = nodeCount;
-            nodeCount++;
-          }
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          if(nodeIds[nodeId4] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId4] = nodeCount;
-            nodeCount++;
-          }
-          triangleCount++;
-          triangleCount++;
-        }
-        if(j == (yP - 1))
-        {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          if(nodeIds[nodeId1] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId1] = nodeCount;
-            nodeCount++;
-          }
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          if(nodeIds[nodeId2] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId2] = nodeCount;
-            nodeCount++;
-          }
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          if(nodeIds[nodeId3] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId3] = nodeCount;
-            nodeCount++;
-          }
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          if(nodeIds[nodeId4] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId4] = nodeCount;
-            nodeCount++;
-          }
-          triangleCount++;
-          triangleCount++;
-        }
-        else if(featureIds[point] != featureIds[neigh2])
-        {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          if(nodeIds[nodeId1] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId1] = nodeCount;
-            nodeCount++;
-          }
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          if(nodeIds[nodeId2] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId2] = nodeCount;
-            nodeCount++;
-          }
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          if(nodeIds[nodeId3] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId3] = nodeCount;
-            nodeCount++;
-          }
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          if(nodeIds[nodeId4] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId4] = nodeCount;
-            nodeCount++;
-          }
-          triangleCount++;
-          triangleCount++;
-        }
-        if(k == (zP - 1))
-        {
-          nodeId1 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          if(nodeIds[nodeId1] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId1] = nodeCount;
-            nodeCount++;
-          }
-          nodeId2 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          if(nodeIds[nodeId2] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId2] = nodeCount;
-            nodeCount++;
-          }
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          if(nodeIds[nodeId3] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId3] = nodeCount;
-            nodeCount++;
-          }
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          if(nodeIds[nodeId4] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId4] = nodeCount;
-            nodeCount++;
-          }
-          triangleCount++;
-          triangleCount++;
-        }
-        else if(k < zP - 1 && featureIds[point] != featureIds[neigh3])
+      MeshIndexType lastPlaneStart = 0;
+      for(usize k = slab.zStart; k < slab.zEnd; k++)
+      {
+        if(m_ShouldCancel)
         {
-          nodeId1 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          if(nodeIds[nodeId1] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId1] = nodeCount;
-            nodeCount++;
-          }
-          nodeId2 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          if(nodeIds[nodeId2] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId2] = nodeCount;
-            nodeCount++;
-          }
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          if(nodeIds[nodeId3] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId3] = nodeCount;
-            nodeCount++;
-          }
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          if(nodeIds[nodeId4] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId4] = nodeCount;
-            nodeCount++;
-          }
-          triangleCount++;
-          triangleCount++;
+          return;
         }
+        lastPlaneStart = mesher.getNextNodeId();
+        mesher.walkLayer<false>(k);
+        mesher.nextLayer();
       }
+      slab.nodeCount = mesher.getNextNodeId();
+      slab.lastPlaneNodeCount = slab.nodeCount - lastPlaneStart;
+      slab.triangleCount = mesher.getTriangleIndex();
     }
+  });
+  if(m_ShouldCancel)
+  {
+    return;
+  }
+
+  nodeCount = 0;
+  triangleCount = 0;
+  for(auto& slab : slabs)
+  {
+    slab.nodeOffset = nodeCount;
+    slab.triangleOffset = triangleCount;
+    nodeCount += slab.nodeCount;
+    triangleCount += slab.triangleCount;
   }
 }
 
 // -----------------------------------------------------------------------------
-void QuickSurfaceMesh::createNodesAndTriangles(std::vector<MeshIndexType>& m_NodeIds, MeshIndexType nodeCount, MeshIndexType triangleCount)
+void QuickSurfaceMesh::createNodesAndTriangles(const std::vector<MeshSlab>& slabs, MeshIndexType nodeCount, MeshIndexType triangleCount)
 {
   m_MessageHandler(IFilter::Message::Type::Info, "Creating mesh");
 
-  Int32Array& featureIds = m_DataStructure.getDataRefAs<Int32Array>(m_Inputs->pFeatureIdsArrayPath);
-
-  size_t numFeatures = 0;
-  size_t numTuples = featureIds.getNumberOfTuples();
-  for(size_t i = 0; i < numTuples; i++)
-  {
-    if(static_cast<size_t>(featureIds[i]) > numFeatures)
-    {
-      numFeatures = static_cast<size_t>(featureIds[i]);
-    }
-  }
+  const auto& featureIds = m_DataStructure.getDataRefAs<Int32Array>(m_Inputs->pFeatureIdsArrayPath);
 
   AbstractGeometryGrid* grid = m_DataStructure.getDataAs<AbstractGeometryGrid>(m_Inputs->pGridGeomDataPath);
 
   SizeVec3 udims = grid->getDimensions();
 
-  MeshIndexType xP = udims[0];
-  MeshIndexType yP = udims[1];
-  MeshIndexType zP = udims[2];
-
-  std::vector<std::set<int32_t>> ownerLists;
-
-  MeshIndexType point = 0;
-  MeshIndexType neigh1 = 0;
-  MeshIndexType neigh2 = 0;
-  MeshIndexType neigh3 = 0;
-
-  MeshIndexType nodeId1 = 0;
-  MeshIndexType nodeId2 = 0;
-  MeshIndexType nodeId3 = 0;
-  MeshIndexType nodeId4 = 0;
-
   TriangleGeom* triangleGeom = m_DataStructure.getDataAs<TriangleGeom>(m_Inputs->pTriangleGeometryPath);
   LinkedGeometryData& linkedGeometryData = triangleGeom->getLinkedGeometryData();
 
-  std::vector<size_t> tDims = {nodeCount};
   triangleGeom->resizeVertexList(nodeCount);
   triangleGeom->resizeFaceList(triangleCount);
 
@@ -817,14 +816,12 @@ void QuickSurfaceMesh::createNodesAndTriangles(std::vector<MeshIndexType>& m_Nod
   // Remove and then insert a properly sized int8 for the NodeTypes
   m_DataStructure.removeData(m_Inputs->pNodeTypesDataPath);
   Result<> nodeTypeResult = complex::CreateArray<int8_t>(m_DataStructure, {nodeCount}, {1}, m_Inputs->pNodeTypesDataPath, IDataAction::Mode::Execute);
-  Int32Array& nodeTypes = m_DataStructure.getDataRefAs<Int32Array>(m_Inputs->pFaceLabelsDataPath);
+  Int8Array& nodeTypes = m_DataStructure.getDataRefAs<Int8Array>(m_Inputs->pNodeTypesDataPath);
   linkedGeometryData.addVertexData(m_Inputs->pFaceLabelsDataPath);
 
   AbstractGeometry::SharedVertexList& vertex = *(triangleGeom->getVertices());
   AbstractGeometry::SharedTriList& triangle = *(triangleGeom->getFaces());
 
-  ownerLists.resize(nodeCount);
-
   // Create a vector of TupleTransferFunctions for each of the Triangle Face to Vertex Data Arrays
   std::vector<std::shared_ptr<AbstractTupleTransfer>> tupleTransferFunctions;
   for(size_t i = 0; i < m_Inputs->pSelectedDataArrayPaths.size(); i++)
@@ -834,522 +831,43 @@ void QuickSurfaceMesh::createNodesAndTriangles(std::vector<MeshIndexType>& m_Nod
     ::AddTupleTransferInstance(m_DataStructure, m_Inputs->pSelectedDataArrayPaths[i], m_Inputs->pCreatedDataArrayPaths[i], tupleTransferFunctions);
   }
 
-  // Cycle through again assigning coordinates to each node and assigning node numbers and feature labels to each triangle
-  MeshIndexType triangleIndex = 0;
-  for(MeshIndexType k = 0; k < zP; k++)
-  {
-    for(MeshIndexType j = 0; j < yP; j++)
+  SlabMesher::MeshOutput output = {grid, vertex.createSpan(), triangle.createSpan(), faceLabels.createSpan(), nodeTypes.createSpan(), tupleTransferFunctions};
+
+  // Each slab starts numbering its nodes and triangles where the previous slab stopped
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, slabs.size());
+  dataAlg.execute([&](const ComplexRange& range) {
+    for(usize slabIndex = range.min(); slabIndex < range.max(); slabIndex++)
     {
-      for(MeshIndexType i = 0; i < xP; i++)
+      const MeshSlab& slab = slabs[slabIndex];
+      SlabMesher mesher(featureIds.createSpan(), udims, &output);
+      if(slabIndex > 0)
       {
-
-        point = (k * xP * yP) + (j * xP) + i;
-        neigh1 = point + 1; // <== What happens if we are at the end of a row?
-        neigh2 = point + xP;
-        neigh3 = point + (xP * yP);
-
-        if(i == 0)
-        {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j, k, vertex, (m_NodeIds[nodeId1] * 3));
-
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j + 1, k, vertex, (m_NodeIds[nodeId2] * 3));
-
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j, k + 1, vertex, (m_NodeIds[nodeId3] * 3));
-
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          getGridCoordinates(grid, i + 1, j + 1, k + 1, vertex, (m_NodeIds[nodeId4] * 3));
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId1];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId3];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId2];
-          faceLabels[triangleIndex * 2] = -1;
-          faceLabels[triangleIndex * 2 + 1] = featureIds[point];
-
-          for(size_t dataVectorIndex = 0; dataVectorIndex < m_Inputs->pSelectedDataArrayPaths.size(); dataVectorIndex++)
-          {
-            tupleTransferFunctions[dataVectorIndex]->transfer(triangleIndex, point, point, true);
-          }
-
-          triangleIndex++;
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId3];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId4];
-          faceLabels[triangleIndex * 2] = -1;
-          faceLabels[triangleIndex * 2 + 1] = featureIds[point];
-
-          for(size_t dataVectorIndex = 0; dataVectorIndex < m_Inputs->pSelectedDataArrayPaths.size(); dataVectorIndex++)
-          {
-            tupleTransferFunctions[dataVectorIndex]->transfer(triangleIndex, point, point, true);
-          }
-
-          triangleIndex++;
-
-          ownerLists[m_NodeIds[nodeId1]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId1]].insert(-1);
-          ownerLists[m_NodeIds[nodeId2]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId2]].insert(-1);
-          ownerLists[m_NodeIds[nodeId3]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId3]].insert(-1);
-          ownerLists[m_NodeIds[nodeId4]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId4]].insert(-1);
-        }
-        if(j == 0)
-        {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j, k, vertex, (m_NodeIds[nodeId1] * 3));
-
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j, k, vertex, (m_NodeIds[nodeId2] * 3));
-
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j, k + 1, vertex, (m_NodeIds[nodeId3] * 3));
-
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j, k + 1, vertex, (m_NodeIds[nodeId4] * 3));
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId1];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId3];
-          faceLabels[triangleIndex * 2] = -1;
-          faceLabels[triangleIndex * 2 + 1] = featureIds[point];
-
-          for(size_t dataVectorIndex = 0; dataVectorIndex < m_Inputs->pSelectedDataArrayPaths.size(); dataVectorIndex++)
-          {
-            tupleTransferFunctions[dataVectorIndex]->transfer(triangleIndex, point, point, true);
-          }
-
-          triangleIndex++;
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId4];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId3];
-          faceLabels[triangleIndex * 2] = -1;
-          faceLabels[triangleIndex * 2 + 1] = featureIds[point];
-
-          for(size_t dataVectorIndex = 0; dataVectorIndex < m_Inputs->pSelectedDataArrayPaths.size(); dataVectorIndex++)
-          {
-            tupleTransferFunctions[dataVectorIndex]->transfer(triangleIndex, point, point, true);
-          }
-
-          triangleIndex++;
-
-          ownerLists[m_NodeIds[nodeId1]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId1]].insert(-1);
-          ownerLists[m_NodeIds[nodeId2]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId2]].insert(-1);
-          ownerLists[m_NodeIds[nodeId3]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId3]].insert(-1);
-          ownerLists[m_NodeIds[nodeId4]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId4]].insert(-1);
-        }
-        if(k == 0)
+        // Replay the last plane of the previous slab to recover the ids of the shared nodes
+        const MeshSlab& previousSlab = slabs[slabIndex - 1];
+        if(slab.zStart > 1)
         {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j, k, vertex, (m_NodeIds[nodeId1] * 3));
-
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j, k, vertex, (m_NodeIds[nodeId2] * 3));
-
-          nodeId3 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j + 1, k, vertex, (m_NodeIds[nodeId3] * 3));
-
-          nodeId4 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j + 1, k, vertex, (m_NodeIds[nodeId4] * 3));
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId1];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId3];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId2];
-          faceLabels[triangleIndex * 2] = -1;
-          faceLabels[triangleIndex * 2 + 1] = featureIds[point];
-
-          for(size_t dataVectorIndex = 0; dataVectorIndex < m_Inputs->pSelectedDataArrayPaths.size(); dataVectorIndex++)
-          {
-            tupleTransferFunctions[dataVectorIndex]->transfer(triangleIndex, point, point, true);
-          }
-
-          triangleIndex++;
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId3];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId4];
-          faceLabels[triangleIndex * 2] = -1;
-          faceLabels[triangleIndex * 2 + 1] = featureIds[point];
-
-          for(size_t dataVectorIndex = 0; dataVectorIndex < m_Inputs->pSelectedDataArrayPaths.size(); dataVectorIndex++)
-          {
-            tupleTransferFunctions[dataVectorIndex]->transfer(triangleIndex, point, point, true);
-          }
-
-          triangleIndex++;
-
-          ownerLists[m_NodeIds[nodeId1]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId1]].insert(-1);
-          ownerLists[m_NodeIds[nodeId2]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId2]].insert(-1);
-          ownerLists[m_NodeIds[nodeId3]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId3]].insert(-1);
-          ownerLists[m_NodeIds[nodeId4]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId4]].insert(-1);
+          mesher.walkLayer<false>(slab.zStart - 2);
+          mesher.nextLayer();
         }
-        if(i == (xP - 1)) // Takes care of the end of a Row...
-        {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j, k, vertex, (m_NodeIds[nodeId1] * 3));
-
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j + 1, k, vertex, (m_NodeIds[nodeId2] * 3));
-
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j, k + 1, vertex, (m_NodeIds[nodeId3] * 3));
-
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j + 1, k + 1, vertex, (m_NodeIds[nodeId4] * 3));
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId1];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId3];
-          faceLabels[triangleIndex * 2] = -1;
-          faceLabels[triangleIndex * 2 + 1] = featureIds[point];
-
-          for(size_t dataVectorIndex = 0; dataVectorIndex < m_Inputs->pSelectedDataArrayPaths.size(); dataVectorIndex++)
-          {
-            tupleTransferFunctions[dataVectorIndex]->transfer(triangleIndex, point, point, true);
-          }
-
-          triangleIndex++;
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId4];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId3];
-          faceLabels[triangleIndex * 2] = -1;
-          faceLabels[triangleIndex * 2 + 1] = featureIds[point];
-
-          for(size_t dataVectorIndex = 0; dataVectorIndex < m_Inputs->pSelectedDataArrayPaths.size(); dataVectorIndex++)
-          {
-            tupleTransferFunctions[dataVectorIndex]->transfer(triangleIndex, point, point, true);
-          }
-
-          triangleIndex++;
-
-          ownerLists[m_NodeIds[nodeId1]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId1]].insert(-1);
-          ownerLists[m_NodeIds[nodeId2]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId2]].insert(-1);
-          ownerLists[m_NodeIds[nodeId3]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId3]].insert(-1);
-          ownerLists[m_NodeIds[nodeId4]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId4]].insert(-1);
-        }
-        else if(featureIds[point] != featureIds[neigh1])
-        {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j, k, vertex, (m_NodeIds[nodeId1] * 3));
-
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j + 1, k, vertex, (m_NodeIds[nodeId2] * 3));
-
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j, k + 1, vertex, (m_NodeIds[nodeId3] * 3));
-
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j + 1, k + 1, vertex, (m_NodeIds[nodeId4] * 3));
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId1];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId3];
-          faceLabels[triangleIndex * 2] = featureIds[neigh1];
-          faceLabels[triangleIndex * 2 + 1] = featureIds[point];
-
-          if(featureIds[point] < featureIds[neigh1])
-          {
-            triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId3];
-            triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId2];
-            faceLabels[triangleIndex * 2] = featureIds[point];
-            faceLabels[triangleIndex * 2 + 1] = featureIds[neigh1];
-          }
-
-          for(size_t dataVectorIndex = 0; dataVectorIndex < m_Inputs->pSelectedDataArrayPaths.size(); dataVectorIndex++)
-          {
-            tupleTransferFunctions[dataVectorIndex]->transfer(triangleIndex, neigh1, point, true);
-          }
-
-          triangleIndex++;
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId4];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId3];
-          faceLabels[triangleIndex * 2] = featureIds[neigh1];
-          faceLabels[triangleIndex * 2 + 1] = featureIds[point];
-          if(featureIds[point] < featureIds[neigh1])
-          {
-            triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId3];
-            triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId4];
-            faceLabels[triangleIndex * 2] = featureIds[point];
-            faceLabels[triangleIndex * 2 + 1] = featureIds[neigh1];
-          }
-
-          for(size_t dataVectorIndex = 0; dataVectorIndex < m_Inputs->pSelectedDataArrayPaths.size(); dataVectorIndex++)
-          {
-            tupleTransferFunctions[dataVectorIndex]->transfer(triangleIndex, neigh1, point, true);
-          }
-
-          triangleIndex++;
-
-          ownerLists[m_NodeIds[nodeId1]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId1]].insert(featureIds[neigh1]);
-          ownerLists[m_NodeIds[nodeId2]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId2]].insert(featureIds[neigh1]);
-          ownerLists[m_NodeIds[nodeId3]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId3]].insert(featureIds[neigh1]);
-          ownerLists[m_NodeIds[nodeId4]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId4]].insert(featureIds[neigh1]);
-        }
-        if(j == (yP - 1)) // Takes care of the end of a column
-        {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j + 1, k, vertex, (m_NodeIds[nodeId1] * 3));
-
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j + 1, k, vertex, (m_NodeIds[nodeId2] * 3));
-
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j + 1, k + 1, vertex, (m_NodeIds[nodeId3] * 3));
-
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j + 1, k + 1, vertex, (m_NodeIds[nodeId4] * 3));
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId1];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId3];
-          faceLabels[triangleIndex * 2] = -1;
-          faceLabels[triangleIndex * 2 + 1] = featureIds[point];
-
-          for(size_t dataVectorIndex = 0; dataVectorIndex < m_Inputs->pSelectedDataArrayPaths.size(); dataVectorIndex++)
-          {
-            tupleTransferFunctions[dataVectorIndex]->transfer(triangleIndex, point, point, true);
-          }
-
-          triangleIndex++;
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId4];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId3];
-          faceLabels[triangleIndex * 2] = -1;
-          faceLabels[triangleIndex * 2 + 1] = featureIds[point];
-
-          for(size_t dataVectorIndex = 0; dataVectorIndex < m_Inputs->pSelectedDataArrayPaths.size(); dataVectorIndex++)
-          {
-            tupleTransferFunctions[dataVectorIndex]->transfer(triangleIndex, point, point, true);
-          }
-
-          triangleIndex++;
-
-          ownerLists[m_NodeIds[nodeId1]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId1]].insert(-1);
-          ownerLists[m_NodeIds[nodeId2]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId2]].insert(-1);
-          ownerLists[m_NodeIds[nodeId3]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId3]].insert(-1);
-          ownerLists[m_NodeIds[nodeId4]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId4]].insert(-1);
-        }
-        else if(featureIds[point] != featureIds[neigh2])
-        {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j + 1, k, vertex, (m_NodeIds[nodeId1] * 3));
-
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j + 1, k, vertex, (m_NodeIds[nodeId2] * 3));
-
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j + 1, k + 1, vertex, (m_NodeIds[nodeId3] * 3));
-
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j + 1, k + 1, vertex, (m_NodeIds[nodeId4] * 3));
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId1];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId3];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId2];
-          faceLabels[triangleIndex * 2] = featureIds[neigh2];
-          faceLabels[triangleIndex * 2 + 1] = featureIds[point];
-          if(featureIds[point] < featureIds[neigh2])
-          {
-            triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId2];
-            triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId3];
-            faceLabels[triangleIndex * 2] = featureIds[point];
-            faceLabels[triangleIndex * 2 + 1] = featureIds[neigh2];
-          }
-
-          for(size_t dataVectorIndex = 0; dataVectorIndex < m_Inputs->pSelectedDataArrayPaths.size(); dataVectorIndex++)
-          {
-            tupleTransferFunctions[dataVectorIndex]->transfer(triangleIndex, neigh2, point, true);
-          }
-
-          triangleIndex++;
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId3];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId4];
-          faceLabels[triangleIndex * 2] = featureIds[neigh2];
-          faceLabels[triangleIndex * 2 + 1] = featureIds[point];
-          if(featureIds[point] < featureIds[neigh2])
-          {
-            triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId4];
-            triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId3];
-            faceLabels[triangleIndex * 2] = featureIds[point];
-            faceLabels[triangleIndex * 2 + 1] = featureIds[neigh2];
-          }
-
-          for(size_t dataVectorIndex = 0; dataVectorIndex < m_Inputs->pSelectedDataArrayPaths.size(); dataVectorIndex++)
-          {
-            tupleTransferFunctions[dataVectorIndex]->transfer(triangleIndex, neigh2, point, true);
-          }
-
-          triangleIndex++;
+        mesher.setNextNodeId(previousSlab.nodeOffset + previousSlab.nodeCount - previousSlab.lastPlaneNodeCount);
+        mesher.walkLayer<false>(slab.zStart - 1);
+        mesher.nextLayer();
+      }
+      mesher.setNextNodeId(slab.nodeOffset);
+      mesher.setTriangleIndex(slab.triangleOffset);
 
-          ownerLists[m_NodeIds[nodeId1]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId1]].insert(featureIds[neigh2]);
-          ownerLists[m_NodeIds[nodeId2]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId2]].insert(featureIds[neigh2]);
-          ownerLists[m_NodeIds[nodeId3]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId3]].insert(featureIds[neigh2]);
-          ownerLists[m_NodeIds[nodeId4]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId4]].insert(featureIds[neigh2]);
-        }
-        if(k == (zP - 1)) // Takes care of the end of a Pillar
+      for(usize k = slab.zStart; k < slab.zEnd; k++)
+      {
+        if(m_ShouldCancel)
         {
-          nodeId1 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j, k + 1, vertex, (m_NodeIds[nodeId1] * 3));
-
-          nodeId2 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j, k + 1, vertex, (m_NodeIds[nodeId2] * 3));
-
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j + 1, k + 1, vertex, (m_NodeIds[nodeId3] * 3));
-
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j + 1, k + 1, vertex, (m_NodeIds[nodeId4] * 3));
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId1];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId3];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId2];
-          faceLabels[triangleIndex * 2] = -1;
-          faceLabels[triangleIndex * 2 + 1] = featureIds[point];
-
-          for(size_t dataVectorIndex = 0; dataVectorIndex < m_Inputs->pSelectedDataArrayPaths.size(); dataVectorIndex++)
-          {
-            tupleTransferFunctions[dataVectorIndex]->transfer(triangleIndex, point, point, true);
-          }
-
-          triangleIndex++;
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId3];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId4];
-          faceLabels[triangleIndex * 2] = -1;
-          faceLabels[triangleIndex * 2 + 1] = featureIds[point];
-
-          for(size_t dataVectorIndex = 0; dataVectorIndex < m_Inputs->pSelectedDataArrayPaths.size(); dataVectorIndex++)
-          {
-            tupleTransferFunctions[dataVectorIndex]->transfer(triangleIndex, point, point, true);
-          }
-
-          triangleIndex++;
-
-          ownerLists[m_NodeIds[nodeId1]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId1]].insert(-1);
-          ownerLists[m_NodeIds[nodeId2]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId2]].insert(-1);
-          ownerLists[m_NodeIds[nodeId3]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId3]].insert(-1);
-          ownerLists[m_NodeIds[nodeId4]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId4]].insert(-1);
-        }
-        else if(featureIds[point] != featureIds[neigh3])
-        {
-          nodeId1 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j, k + 1, vertex, (m_NodeIds[nodeId1] * 3));
-
-          nodeId2 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j, k + 1, vertex, (m_NodeIds[nodeId2] * 3));
-
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j + 1, k + 1, vertex, (m_NodeIds[nodeId3] * 3));
-
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j + 1, k + 1, vertex, (m_NodeIds[nodeId4] * 3));
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId1];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId3];
-          faceLabels[triangleIndex * 2] = featureIds[neigh3];
-          faceLabels[triangleIndex * 2 + 1] = featureIds[point];
-          if(featureIds[point] < featureIds[neigh3])
-          {
-            triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId3];
-            triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId2];
-            faceLabels[triangleIndex * 2] = featureIds[point];
-            faceLabels[triangleIndex * 2 + 1] = featureIds[neigh3];
-          }
-
-          for(size_t dataVectorIndex = 0; dataVectorIndex < m_Inputs->pSelectedDataArrayPaths.size(); dataVectorIndex++)
-          {
-            tupleTransferFunctions[dataVectorIndex]->transfer(triangleIndex, neigh3, point, true);
-          }
-
-          triangleIndex++;
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId4];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId3];
-          faceLabels[triangleIndex * 2] = featureIds[neigh3];
-          faceLabels[triangleIndex * 2 + 1] = featureIds[point];
-          if(featureIds[point] < featureIds[neigh3])
-          {
-            triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId3];
-            triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId4];
-            faceLabels[triangleIndex * 2] = featureIds[point];
-            faceLabels[triangleIndex * 2 + 1] = featureIds[neigh3];
-          }
-
-          for(size_t dataVectorIndex = 0; dataVectorIndex < m_Inputs->pSelectedDataArrayPaths.size(); dataVectorIndex++)
-          {
-            tupleTransferFunctions[dataVectorIndex]->transfer(triangleIndex, neigh3, point, true);
-          }
-
-          triangleIndex++;
-
-          ownerLists[m_NodeIds[nodeId1]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId1]].insert(featureIds[neigh3]);
-          ownerLists[m_NodeIds[nodeId2]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId2]].insert(featureIds[neigh3]);
-          ownerLists[m_NodeIds[nodeId3]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId3]].insert(featureIds[neigh3]);
-          ownerLists[m_NodeIds[nodeId4]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId4]].insert(featureIds[neigh3]);
+          return;
         }
+        mesher.walkLayer<true>(k);
+        mesher.nextLayer();
       }
     }
-  }
-
-  Int8Array& m_NodeTypes = m_DataStructure.getDataRefAs<Int8Array>(m_Inputs->pNodeTypesDataPath);
-
-  for(size_t i = 0; i < nodeCount; i++)
-  {
-    m_NodeTypes[i] = static_cast<int8_t>(ownerLists[i].size());
-    if(m_NodeTypes[i] > 4)
-    {
-      m_NodeTypes[i] = 4;
-    }
-    if(ownerLists[i].find(-1) != ownerLists[i].end())
-    {
-      m_NodeTypes[i] += 10;
-    }
-  }
+  });
 }
 
 // -----------------------------------------------------------------------------
@@ -10,6 +10,7 @@
 #include "complex/Parameters/MultiArraySelectionParameter.hpp"
 
 #include <string>
+#include <vector>
 
 namespace complex
 {
@@ -92,20 +93,38 @@ public:
   void correctProblemVoxels();
 
   /**
-   * @brief
-   * @param m_NodeIds
+   * @brief Range of Z planes of the grid that is meshed by a single task along with
+   * the number of nodes and triangles it creates and where they start in the mesh.
+   */
+  struct MeshSlab
+  {
+    usize zStart = 0;
+    usize zEnd = 0;
+    MeshIndexType nodeCount = 0;
+    MeshIndexType lastPlaneNodeCount = 0;
+    MeshIndexType triangleCount = 0;
+    MeshIndexType nodeOffset = 0;
+    MeshIndexType triangleOffset = 0;
+  };
+
+  /**
+   * @brief Splits the grid into Z slabs and counts the nodes and triangles that each
+   * slab creates in parallel. Nodes shared with the previous slab belong to that slab.
+   * The slabs are returned sorted by Z with their node and triangle offsets set.
+   * @param slabs
    * @param nodeCount
    * @param triangleCount
    */
-  void determineActiveNodes(std::vector<MeshIndexType>& m_NodeIds, MeshIndexType& nodeCount, MeshIndexType& triangleCount);
+  void determineActiveNodes(std::vector<MeshSlab>& slabs, MeshIndexType& nodeCount, MeshIndexType& triangleCount);
 
   /**
-   * @brief
-   * @param m_NodeIds
+   * @brief Creates the nodes, triangles, node types and face data of each slab in parallel.
+   * The nodes and triangles are numbered in the same order as a single pass over the grid.
+   * @param slabs
    * @param nodeCount
    * @param triangleCount
    */
-  void createNodesAndTriangles(std::vector<MeshIndexType>& m_NodeIds, MeshIndexType nodeCount, MeshIndexType triangleCount);
+  void createNodesAndTriangles(const std::vector<MeshSlab>& slabs, MeshIndexType nodeCount, MeshIndexType triangleCount);
 
   /**
    * @brief generateTripleLines
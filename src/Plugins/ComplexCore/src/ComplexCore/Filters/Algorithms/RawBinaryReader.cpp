@@ -38,24 +38,20 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <cstring>
 
 #include "complex/Common/Bit.hpp"
 #include "complex/Common/ComplexConstants.hpp"
 #include "complex/Common/Types.hpp"
 #include "complex/DataStructure/DataArray.hpp"
-#include "complex/DataStructure/DataStore.hpp"
+#include "complex/Utilities/MemoryMappedFile.hpp"
+#include "complex/Utilities/ParallelDataAlgorithm.hpp"
 
 namespace fs = std::filesystem;
 using namespace complex;
 
 namespace
 {
-#if defined(_MSC_VER)
-#define FSEEK64 _fseeki64
-#else
-#define FSEEK64 std::fseek
-#endif
-
 constexpr int32 k_RbrFileNotOpen = -1000;
 constexpr int32 k_RbrFileTooSmall = -1010;
 constexpr int32 k_RbrFileTooBig = -1020;
@@ -77,10 +73,34 @@ int32 SanityCheckFileSizeVersusAllocatedSize(usize allocatedBytes, usize fileSiz
 
 // -----------------------------------------------------------------------------
 template <typename T>
-Result<> ReadBinaryFile(IDataArray& dataArrayPtr, const std::string& filename, uint64 skipHeaderBytes, ChoicesParameter::ValueType endian)
+void CopyMappedValues(const std::byte* source, nonstd::span<T> destination, bool swapBytes)
 {
-  constexpr usize k_DefaultBlocksize = 1048576;
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, destination.size());
+  dataAlg.execute([&](const ComplexRange& range) {
+    const usize numValues = range.max() - range.min();
+    const std::byte* chunkSource = source + range.min() * sizeof(T);
+    T* chunkDestination = destination.data() + range.min();
+    if(!swapBytes)
+    {
+      std::memcpy(chunkDestination, chunkSource, numValues * sizeof(T));
+      return;
+    }
+    // The source is not guaranteed to be aligned for T so each value is loaded with memcpy,
+    // which compilers turn into a plain load that can be vectorized together with the swap
+    for(usize i = 0; i < numValues; i++)
+    {
+      T value;
+      std::memcpy(&value, chunkSource + i * sizeof(T), sizeof(T));
+      chunkDestination[i] = complex::byteswap(value);
+    }
+  });
+}
 
+// -----------------------------------------------------------------------------
+template <typename T>
+Result<> ReadBinaryFile(IDataArray& dataArrayPtr, const fs::path& filename, uint64 skipHeaderBytes, ChoicesParameter::ValueType endian)
+{
   DataArray<T>& dataArray = dynamic_cast<DataArray<T>&>(dataArrayPtr);
 
   const usize fileSize = fs::file_size(filename);
@@ -95,46 +115,38 @@ Result<> ReadBinaryFile(IDataArray& dataArrayPtr, const std::string& filename, u
   {
     return MakeWarningVoidResult(k_RbrFileTooBig, "The file size is larger than the allocated size");
   }
-
-  FILE* f = std::fopen(filename.c_str(), "rb");
-  if(f == nullptr)
+  if(numBytesToRead == 0)
   {
-    return MakeErrorResult(k_RbrFileNotOpen, "Unable to open the specified file");
+    return {};
   }
 
-  // Skip some header bytes if the user asked for it.
-  if(skipHeaderBytes > 0)
+  const bool swapBytes = endian != static_cast<ChoicesParameter::ValueType>(complex::endian::native);
+
+  // The values are always copied out of the mapping. Keeping the user's file mapped as the
+  // array's storage would let later changes to the file show through, and truncating the
+  // file would crash the next read of a page that was not loaded yet.
+  std::unique_ptr<MemoryMappedFile> mappedFile;
+  try
+  {
+    mappedFile = std::make_unique<MemoryMappedFile>(filename, MemoryMappedFile::Mode::ReadOnly);
+  } catch(const std::runtime_error&)
   {
-    FSEEK64(f, skipHeaderBytes, SEEK_SET);
+    return MakeErrorResult(k_RbrFileNotOpen, "Unable to open the specified file");
   }
+  mappedFile->adviseSequential();
 
-  std::byte* chunkptr = reinterpret_cast<std::byte*>(dataArray.template getIDataStoreAs<DataStore<T>>()->data());
-
-  // Now start reading the data in chunks if needed.
-  usize chunkSize = std::min(numBytesToRead, k_DefaultBlocksize);
-
-  usize master_counter = 0;
-  while(master_counter < numBytesToRead)
+  // Values are copied straight out of the page cache and byte swapped in the same pass
+  const std::byte* source = mappedFile->data() + skipHeaderBytes;
+  AbstractDataStore<T>& dataStore = dataArray.getDataStoreRef();
+  if(dataStore.isContiguous())
   {
-    usize bytes_read = std::fread(chunkptr, sizeof(std::byte), chunkSize, f);
-    chunkptr += bytes_read;
-    master_counter += bytes_read;
-
-    usize bytesLeft = numBytesToRead - master_counter;
-
-    if(bytesLeft < chunkSize)
-    {
-      chunkSize = bytesLeft;
-    }
+    CopyMappedValues<T>(source, dataStore.createSpan(), swapBytes);
   }
-
-  if(endian != static_cast<ChoicesParameter::ValueType>(complex::endian::native))
+  else
   {
-    dataArray.byteSwapElements();
+    dataStore.forEachChunk(0, [&](usize startIndex, nonstd::span<T> chunk) { CopyMappedValues<T>(source + startIndex * sizeof(T), chunk, swapBytes); });
   }
 
-  std::fclose(f);
-
   return {};
 }
 } // namespace
@@ -167,7 +179,7 @@ Result<> RawBinaryReader::execute()
     throw std::runtime_error(fmt::format("Failed to acquire DataArray from path '{}' with the correct number of components.", m_InputValues.createdAttributeArrayPathValue.toString()));
   }
 
-  const std::string inputFile = m_InputValues.inputFileValue.string();
+  const fs::path& inputFile = m_InputValues.inputFileValue;
 
   switch(m_InputValues.scalarTypeValue)
   {
@@ -1,20 +1,18 @@
 #include "ScalarSegmentFeatures.hpp"
 
+#include "complex/DataStructure/ContiguousValues.hpp"
 #include "complex/DataStructure/DataStore.hpp"
 #include "complex/DataStructure/Geometry/AbstractGeometryGrid.hpp"
 #include "complex/Filter/Actions/CreateArrayAction.hpp"
 #include "complex/Parameters/BoolParameter.hpp"
+#include "complex/Utilities/FilterUtilities.hpp"
 
 #include <chrono>
+#include <optional>
+#include <type_traits>
 
 using namespace complex;
 
-#define CX_DEFAULT_CONSTRUCTORS(className)                                                                                                                                                             \
-  className(const className&) = delete;                                                                                                                                                                \
-  className(className&&) noexcept = delete;                                                                                                                                                            \
-  className& operator=(const className&) = delete;                                                                                                                                                     \
-  className& operator=(className&&) noexcept = delete;
-
 namespace
 {
 
@@ -25,101 +23,78 @@ constexpr int64 k_MissingInputArray = -601;
 constexpr int64 k_MissingOrIncorrectGoodVoxelsArray = -602;
 
 /**
- * @brief The TSpecificCompareFunctorBool class extends @see CompareFunctor to compare boolean data
+ * @brief The TSpecificCompareFunctorBool class compares boolean data. Voxels are
+ * grouped when their values are equal.
  */
-class TSpecificCompareFunctorBool : public SegmentFeatures::CompareFunctor
+class TSpecificCompareFunctorBool
 {
 public:
-  using DataArrayType = BoolArray;
-  CX_DEFAULT_CONSTRUCTORS(TSpecificCompareFunctorBool)
-
-  TSpecificCompareFunctorBool(IDataArray* data, int64 length, bool tolerance, AbstractDataStore<int32>* featureIds)
-  : m_Length(length)
-  , m_FeatureIdsArray(featureIds)
-  , m_Data(dynamic_cast<DataArrayType*>(data))
+  TSpecificCompareFunctorBool(nonstd::span<const bool> data)
+  : m_Data(data)
   {
   }
-  ~TSpecificCompareFunctorBool() override = default;
 
-  bool operator()(int64 referencePoint, int64 neighborPoint, int32 gnum) override
+  bool operator()(int64 referencePoint, int64 neighborPoint) const
   {
-    // Sanity check the indices that are being passed in.
-    if(referencePoint >= m_Length || neighborPoint >= m_Length)
-    {
-      return false;
-    }
-
-    if((*m_Data)[neighborPoint] == (*m_Data)[referencePoint])
-    {
-      m_FeatureIdsArray->setValue(neighborPoint, gnum);
-      return true;
-    }
-    return false;
+    return m_Data[neighborPoint] == m_Data[referencePoint];
   }
 
-protected:
-  TSpecificCompareFunctorBool() = default;
-
 private:
-  int64 m_Length = 0;                                    // Length of the Data Array
-  AbstractDataStore<int32>* m_FeatureIdsArray = nullptr; // The Feature Ids
-  DataArrayType* m_Data = nullptr;                       // The data that is being compared
+  nonstd::span<const bool> m_Data; // The data that is being compared
 };
 
 /**
- * @brief The TSpecificCompareFunctor class extens @see CompareFunctor to compare templated data
+ * @brief The TSpecificCompareFunctor class compares templated data. Voxels are
+ * grouped when their values differ by no more than the tolerance.
  */
 template <class T>
-class TSpecificCompareFunctor : public SegmentFeatures::CompareFunctor
+class TSpecificCompareFunctor
 {
 public:
-  CX_DEFAULT_CONSTRUCTORS(TSpecificCompareFunctor<T>)
-
-  using DataArrayType = DataArray<T>;
-  TSpecificCompareFunctor(IDataArray* data, int64 length, T tolerance, AbstractDataStore<int32>* featureIds)
-  : m_Length(length)
-  , m_Tolerance(tolerance)
-  , m_FeatureIdsArray(featureIds)
-  , m_Data(dynamic_cast<DataArrayType*>(data))
+  TSpecificCompareFunctor(nonstd::span<const T> data, T tolerance)
+  : m_Tolerance(tolerance)
+  , m_Data(data)
   {
   }
-  ~TSpecificCompareFunctor() override = default;
 
-  bool operator()(int64 referencePoint, int64 neighborPoint, int32 gnum) override
+  bool operator()(int64 referencePoint, int64 neighborPoint) const
   {
-    // Sanity check the indices that are being passed in.
-    if(referencePoint >= m_Length || neighborPoint >= m_Length)
+    if(m_Data[referencePoint] >= m_Data[neighborPoint])
     {
-      return false;
+      return (m_Data[referencePoint] - m_Data[neighborPoint]) <= m_Tolerance;
     }
+    return (m_Data[neighborPoint] - m_Data[referencePoint]) <= m_Tolerance;
+  }
 
-    if((*m_Data)[referencePoint] >= (*m_Data)[neighborPoint])
+private:
+  T m_Tolerance = static_cast<T>(0); // The tolerance of the comparison
+  nonstd::span<const T> m_Data;      // The data that is being compared
+};
+
+/**
+ * @brief Segments the grid with the compare functor that matches the type of the input array.
+ */
+struct SegmentScalarArrayFunctor
+{
+  template <typename T>
+  Result<usize> operator()(ScalarSegmentFeatures& segmentFeatures, AbstractGeometryGrid* gridGeom, nonstd::span<int32> featureIds, nonstd::span<const bool> goodVoxels,
+                           const IDataArray& inputDataArray, int32 tolerance)
+  {
+    if(inputDataArray.getNumberOfComponents() != 1)
+    {
+      // Multi-component arrays are never grouped so every voxel becomes its own feature
+      return segmentFeatures.executeParallel(gridGeom, featureIds, goodVoxels, [](int64 referencePoint, int64 neighborPoint) { return false; });
+    }
+    const ContiguousValues<const T> inputValues(dynamic_cast<const DataArray<T>&>(inputDataArray).getDataStoreRef());
+    if constexpr(std::is_same_v<T, bool>)
     {
-      if(((*m_Data)[referencePoint] - (*m_Data)[neighborPoint]) <= m_Tolerance)
-      {
-        m_FeatureIdsArray->setValue(neighborPoint, gnum);
-        return true;
-      }
+      return segmentFeatures.executeParallel(gridGeom, featureIds, goodVoxels, TSpecificCompareFunctorBool(inputValues.span()));
     }
     else
     {
-      if(((*m_Data)[neighborPoint] - (*m_Data)[referencePoint]) <= m_Tolerance)
-      {
-        m_FeatureIdsArray->setValue(neighborPoint, gnum);
-        return true;
-      }
+      return segmentFeatures.executeParallel(gridGeom, featureIds, goodVoxels, TSpecificCompareFunctor<T>(inputValues.span(), static_cast<T>(tolerance)));
     }
-    return false;
   }
-
-protected:
-  TSpecificCompareFunctor() = default;
-
-private:
-  int64 m_Length = 0;                                    // Length of the Data Array
-  T m_Tolerance = static_cast<T>(0);                     // The tolerance of the comparison
-  AbstractDataStore<int32>* m_FeatureIdsArray = nullptr; // The Feature Ids
-  DataArrayType* m_Data = nullptr;                       // The data that is being compared
 };
 } // namespace
 
@@ -135,76 +110,21 @@ ScalarSegmentFeatures::~ScalarSegmentFeatures() noexcept = default;
 // -----------------------------------------------------------------------------
 Result<> ScalarSegmentFeatures::operator()()
 {
-  complex::AbstractDataStore<bool>* goodVoxels = nullptr;
+  // The segmentation indexes spans directly to avoid a virtual call per voxel. The values of data
+  // stores that are not contiguous are copied, and the Feature Ids are copied back afterwards.
+  std::optional<ContiguousValues<const bool>> goodVoxels;
   if(m_InputValues->pUseGoodVoxels)
   {
     m_GoodVoxelsArray = m_DataStructure.getDataAs<GoodVoxelsArrayType>(m_InputValues->pGoodVoxelsPath);
-    goodVoxels = m_GoodVoxelsArray->getDataStore();
+    goodVoxels.emplace(std::as_const(*m_GoodVoxelsArray).getDataStoreRef());
   }
 
   auto gridGeom = m_DataStructure.getDataAs<AbstractGeometryGrid>(m_InputValues->pGridGeomPath);
 
   m_FeatureIdsArray = m_DataStructure.getDataAs<Int32Array>(m_InputValues->pFeatureIdsPath);
   m_FeatureIdsArray->fill(0); // initialize the output array with zeros
-  IDataArray* inputDataArray = m_DataStructure.getDataAs<IDataArray>(m_InputValues->pInputDataPath);
-  size_t inDataPoints = inputDataArray->getNumberOfTuples();
-  complex::DataType dataType = inputDataArray->getDataType();
-
-  auto featureIds = m_FeatureIdsArray->getDataStore();
-
-  switch(dataType)
-  {
-  case complex::DataType::int8: {
-    m_CompareFunctor = std::make_shared<::TSpecificCompareFunctor<int8>>(inputDataArray, inDataPoints, static_cast<int8>(m_InputValues->pScalarTolerance), featureIds);
-    break;
-  }
-  case complex::DataType::uint8: {
-    m_CompareFunctor = std::make_shared<TSpecificCompareFunctor<uint8>>(inputDataArray, inDataPoints, static_cast<uint8>(m_InputValues->pScalarTolerance), featureIds);
-    break;
-  }
-  case complex::DataType::boolean: {
-    m_CompareFunctor = std::make_shared<TSpecificCompareFunctorBool>(inputDataArray, inDataPoints, static_cast<bool>(m_InputValues->pScalarTolerance), featureIds);
-    break;
-  }
-  case complex::DataType::int16: {
-    m_CompareFunctor = std::make_shared<TSpecificCompareFunctor<int16>>(inputDataArray, inDataPoints, static_cast<int16>(m_InputValues->pScalarTolerance), featureIds);
-    break;
-  }
-  case complex::DataType::uint16: {
-    m_CompareFunctor = std::make_shared<TSpecificCompareFunctor<uint16>>(inputDataArray, inDataPoints, static_cast<uint16>(m_InputValues->pScalarTolerance), featureIds);
-    break;
-  }
-  case complex::DataType::int32: {
-    m_CompareFunctor = std::make_shared<TSpecificCompareFunctor<int32>>(inputDataArray, inDataPoints, static_cast<int32>(m_InputValues->pScalarTolerance), featureIds);
-    break;
-  }
-  case complex::DataType::uint32: {
-    m_CompareFunctor = std::make_shared<TSpecificCompareFunctor<uint32>>(inputDataArray, inDataPoints, static_cast<uint32>(m_InputValues->pScalarTolerance), featureIds);
-    break;
-  }
-  case complex::DataType::int64: {
-    m_CompareFunctor = std::make_shared<TSpecificCompareFunctor<int64>>(inputDataArray, inDataPoints, static_cast<int64>(m_InputValues->pScalarTolerance), featureIds);
-    break;
-  }
-  case complex::DataType::uint64: {
-    m_CompareFunctor = std::make_shared<TSpecificCompareFunctor<uint64>>(inputDataArray, inDataPoints, static_cast<uint64>(m_InputValues->pScalarTolerance), featureIds);
-    break;
-  }
-  case complex::DataType::float32: {
-    m_CompareFunctor = std::make_shared<TSpecificCompareFunctor<float32>>(inputDataArray, inDataPoints, static_cast<float32>(m_InputValues->pScalarTolerance), featureIds);
-    break;
-  }
-  case complex::DataType::float64: {
-    m_CompareFunctor = std::make_shared<TSpecificCompareFunctor<float64>>(inputDataArray, inDataPoints, static_cast<float64>(m_InputValues->pScalarTolerance), featureIds);
-    break;
-  }
-  default:
-    break;
-  }
-  if(inputDataArray->getNumberOfComponents() != 1)
-  {
-    m_CompareFunctor = std::shared_ptr<SegmentFeatures::CompareFunctor>(new SegmentFeatures::CompareFunctor()); // The default CompareFunctor which ALWAYS returns false for the comparison
-  }
+  const IDataArray* inputDataArray = m_DataStructure.getDataAs<IDataArray>(m_InputValues->pInputDataPath);
+  ContiguousValues<int32> featureIds(m_FeatureIdsArray->getDataStoreRef());
 
   // Generate the random voxel indices that will be used for the seed points to start a new grain growth/agglomeration
   auto totalPoints = inputDataArray->getNumberOfTuples();
@@ -214,14 +134,23 @@ Result<> ScalarSegmentFeatures::operator()()
   Int64Distribution distribution;
   initializeVoxelSeedGenerator(distribution, rangeMin, rangeMax);
 
-  //  // Add compare function to arguments
-  //  Arguments newArgs = args;
-  //  newArgs.insert(k_CompareFunctKey, compare.get());
+  Result<usize> segmentResult = ExecuteDataFunction(SegmentScalarArrayFunctor{}, inputDataArray->getDataType(), *this, gridGeom, featureIds.span(),
+                                                    goodVoxels.has_value() ? goodVoxels->span() : nonstd::span<const bool>{}, *inputDataArray, m_InputValues->pScalarTolerance);
+  featureIds.commit();
+  if(segmentResult.invalid())
+  {
+    return ConvertResult(std::move(segmentResult));
+  }
+  if(m_ShouldCancel)
+  {
+    return {};
+  }
 
-  execute(gridGeom);
+  // The actives array holds one value per feature plus feature 0
+  UInt8Array& activeArray = m_DataStructure.getDataRefAs<UInt8Array>(m_InputValues->pActiveArrayPath);
+  activeArray.getDataStore()->reshapeTuples({segmentResult.value() + 1});
 
-  IDataArray* activeArray = m_DataStructure.getDataAs<IDataArray>(m_InputValues->pActiveArrayPath);
-  auto totalFeatures = activeArray->getNumberOfTuples();
+  auto totalFeatures = activeArray.getNumberOfTuples();
   if(totalFeatures < 2)
   {
     return {nonstd::make_unexpected(std::vector<Error>{Error{-87000, "The number of Features was 0 or 1 which means no Features were detected. A threshold value may be set too high"}})};
@@ -236,68 +165,3 @@ Result<> ScalarSegmentFeatures::operator()()
 
   return {};
 }
-
-// -----------------------------------------------------------------------------
-int64_t ScalarSegmentFeatures::getSeed(int32 gnum, int64 nextSeed) const
-{
-  complex::AbstractDataStore<bool>* goodVoxels = nullptr;
-  if(m_InputValues->pUseGoodVoxels)
-  {
-    goodVoxels = m_GoodVoxelsArray->getDataStore();
-  }
-
-  complex::DataArray<int32>::store_type* featureIds = m_FeatureIdsArray->getDataStore();
-  usize totalPoints = featureIds->getNumberOfTuples();
-
-  int64 seed = -1;
-  // start with the next voxel after the last seed
-  usize randpoint = static_cast<usize>(nextSeed);
-  while(seed == -1 && randpoint < totalPoints)
-  {
-    if(featureIds->getValue(randpoint) == 0) // If the GrainId of the voxel is ZERO then we can use this as a seed point
-    {
-      if(!m_InputValues->pUseGoodVoxels || goodVoxels->getValue(randpoint))
-      {
-        seed = randpoint;
-      }
-      else
-      {
-        randpoint += 1;
-      }
-    }
-    else
-    {
-      randpoint += 1;
-    }
-  }
-  if(seed >= 0)
-  {
-    UInt8Array& activeArray = m_DataStructure.getDataRefAs<UInt8Array>(m_InputValues->pActiveArrayPath);
-    featureIds->setValue(static_cast<usize>(seed), gnum);
-    std::vector<usize> tDims = {static_cast<usize>(gnum) + 1};
-    activeArray.getDataStore()->reshapeTuples(tDims); // This will resize the actives array
-  }
-  return seed;
-}
-
-// -----------------------------------------------------------------------------
-bool ScalarSegmentFeatures::determineGrouping(int64 referencepoint, int64 neighborpoint, int32 gnum) const
-{
-
-  auto featureIds = m_FeatureIdsArray->getDataStore();
-
-  const complex::AbstractDataStore<bool>* goodVoxels = nullptr;
-  if(m_InputValues->pUseGoodVoxels)
-  {
-    goodVoxels = m_GoodVoxelsArray->getDataStore();
-  }
-
-  if(featureIds->getValue(neighborpoint) == 0 && (!m_InputValues->pUseGoodVoxels || goodVoxels->getValue(neighborpoint)))
-  {
-    CompareFunctor* func = m_CompareFunctor.get();
-    return (*func)((usize)(referencepoint), (usize)(neighborpoint), gnum);
-    //     | Functor  ||calling the operator() method of the CompareFunctor Class |
-  }
-
-  return false;
-}
@@ -6,91 +6,225 @@
 #include "complex/DataStructure/DataArray.hpp"
 #include "complex/DataStructure/DataStore.hpp"
 #include "complex/DataStructure/Geometry/TriangleGeom.hpp"
+#include "complex/Utilities/MemoryMappedFile.hpp"
 #include "complex/Utilities/ParallelDataAlgorithm.hpp"
 
-#include <cstdio>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <limits>
+#include <numeric>
 #include <utility>
 
 using namespace complex;
 
 namespace
 {
+using MeshIndexType = AbstractGeometry::MeshIndexType;
+
+// Offset of the first triangle record: the header followed by the int32 triangle count
+constexpr usize k_TriangleDataOffset = StlConstants::k_STL_HEADER_LENGTH + sizeof(int32);
+// Normal and 3 vertices followed by the uint16 attribute byte count
+constexpr usize k_StlElementCount = 12;
+constexpr usize k_TriangleDataSize = k_StlElementCount * sizeof(float32);
+constexpr usize k_TriangleRecordSize = k_TriangleDataSize + sizeof(uint16);
+
+// Target number of vertices in each partition of the vertex welding hash tables
+constexpr usize k_VerticesPerPartition = 1ULL << 16;
+constexpr MeshIndexType k_EmptySlot = std::numeric_limits<MeshIndexType>::max();
+
+// -----------------------------------------------------------------------------
+uint16 ReadAttributeByteCount(const std::byte* record)
+{
+  uint16 attr = 0;
+  std::memcpy(&attr, record + k_TriangleDataSize, sizeof(attr));
+  return attr;
+}
 
 /**
- * @brief The FindUniqueIdsImpl class implements a threaded algorithm that determines the set of
- * unique vertices in the triangle geometry
+ * @brief Finds the start of each triangle record in the mapped file. Records are
+ * normally a fixed 50 bytes apart, in which case recordOffsets is left empty. Only
+ * files that store attribute bytes after some of the triangles (and were not written
+ * by Magics, which uses the attribute field as a color) need the offsets of every
+ * record, which have to be found with a sequential scan.
  */
-class FindUniqueIdsImpl
+Result<> FindTriangleRecords(const std::byte* fileData, usize fileSize, usize triCount, bool magicsFile, std::vector<usize>& recordOffsets)
 {
-public:
-  FindUniqueIdsImpl(AbstractGeometry::SharedVertexList& vertex, const std::vector<std::vector<size_t>>& nodesInBin, complex::Int64DataStore& uniqueIds)
-  : m_Vertex(vertex)
-  , m_NodesInBin(nodesInBin)
-  , m_UniqueIds(uniqueIds)
+  recordOffsets.clear();
+  if(k_TriangleDataOffset + triCount * k_TriangleRecordSize <= fileSize)
   {
-  }
-
-  // -----------------------------------------------------------------------------
-  void convert(size_t start, size_t end) const
-  {
-    for(size_t i = start; i < end; i++)
+    if(magicsFile)
     {
-      for(size_t j = 0; j < m_NodesInBin[i].size(); j++)
+      return {};
+    }
+    std::atomic_bool hasAttributeBytes = false;
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(0, triCount);
+    dataAlg.execute([&](const ComplexRange& range) {
+      for(usize t = range.min(); t < range.max() && !hasAttributeBytes; t++)
       {
-        size_t node1 = m_NodesInBin[i][j];
-        if(m_UniqueIds[node1] == static_cast<int64_t>(node1))
+        if(ReadAttributeByteCount(fileData + k_TriangleDataOffset + t * k_TriangleRecordSize) > 0)
         {
-          for(size_t k = j + 1; k < m_NodesInBin[i].size(); k++)
-          {
-            size_t node2 = m_NodesInBin[i][k];
-            if(m_Vertex[node1 * 3] == m_Vertex[node2 * 3] && m_Vertex[node1 * 3 + 1] == m_Vertex[node2 * 3 + 1] && m_Vertex[node1 * 3 + 2] == m_Vertex[node2 * 3 + 2])
-            {
-              m_UniqueIds[node2] = node1;
-            }
-          }
+          hasAttributeBytes = true;
         }
       }
+    });
+    if(!hasAttributeBytes)
+    {
+      return {};
     }
   }
 
-  // -----------------------------------------------------------------------------
-  void operator()(const ComplexRange& range) const
+  recordOffsets.resize(triCount);
+  usize position = k_TriangleDataOffset;
+  for(usize t = 0; t < triCount; t++)
   {
-    convert(range.min(), range.max());
+    if(position + k_TriangleDataSize > fileSize)
+    {
+      const usize objsRead = position < fileSize ? (fileSize - position) / sizeof(float32) : 0;
+      std::string msg = fmt::format("Error reading Triangle '{}'. Object Count was {} and should have been {}", t, objsRead, k_StlElementCount);
+      return MakeErrorResult(StlConstants::k_TriangleParseError, msg);
+    }
+    if(position + k_TriangleRecordSize > fileSize)
+    {
+      std::string msg = fmt::format("Error reading Number of attributes for triangle '{}'. Object Count was 0 and should have been 1", t);
+      return MakeErrorResult(StlConstants::k_AttributeParseError, msg);
+    }
+    recordOffsets[t] = position;
+    position += k_TriangleRecordSize;
+    if(!magicsFile)
+    {
+      position += ReadAttributeByteCount(fileData + recordOffsets[t]); // Skip past the Triangle Attribute data since we don't know how to read it anyways
+    }
   }
+  return {};
+}
 
-private:
-  const AbstractGeometry::SharedVertexList& m_Vertex;
-  const std::vector<std::vector<size_t>>& m_NodesInBin;
-  complex::Int64DataStore& m_UniqueIds;
-};
+/**
+ * @brief Hashes the bit patterns of a vertex. -0.0 is hashed as +0.0 so that
+ * vertices that compare equal always hash equally.
+ */
+uint64 HashVertex(const float32* xyz)
+{
+  uint64 hash = 0;
+  for(usize c = 0; c < 3; c++)
+  {
+    const float32 value = xyz[c] + 0.0F; // -0.0 + 0.0 == +0.0
+    uint32 bits = 0;
+    std::memcpy(&bits, &value, sizeof(bits));
+    hash = (hash ^ bits) * 0x9E3779B97F4A7C15ULL;
+    hash ^= hash >> 32;
+  }
+  return hash;
+}
 
-class StlFileSentinel
+// -----------------------------------------------------------------------------
+bool VerticesEqual(const float32* vertices, MeshIndexType node1, MeshIndexType node2)
 {
-public:
-  StlFileSentinel(FILE* file)
-  : m_File(file)
+  return vertices[node1 * 3] == vertices[node2 * 3] && vertices[node1 * 3 + 1] == vertices[node2 * 3 + 1] && vertices[node1 * 3 + 2] == vertices[node2 * 3 + 2];
+}
+
+/**
+ * @brief Finds the lowest index of the vertices that are equal to each vertex.
+ *
+ * The vertices are bucketed into independent partitions by the high bits of their
+ * hash with a parallel stable counting sort, so every partition holds its vertices in
+ * index order. Each partition is then resolved with its own open addressing hash
+ * table, which sees the lowest index of each distinct vertex first.
+ */
+std::vector<MeshIndexType> FindRepresentativeVertices(nonstd::span<const float32> vertices, usize numVertices)
+{
+  usize partitionBits = 0;
+  while(partitionBits < 32 && (k_VerticesPerPartition << partitionBits) < numVertices)
   {
+    partitionBits++;
   }
-  ~StlFileSentinel()
+  const usize numPartitions = 1ULL << partitionBits;
+  auto findPartition = [&](usize vertexIndex) -> usize { return partitionBits == 0 ? 0 : static_cast<usize>(HashVertex(vertices.data() + vertexIndex * 3) >> (64 - partitionBits)); };
+
+  const usize numChunks = GetNumRanges(numVertices, k_VerticesPerPartition);
+  std::vector<usize> cursors(numChunks * numPartitions, 0);
+
+  ParallelDataAlgorithm countAlg;
+  countAlg.setRange(0, numChunks);
+  countAlg.execute([&](const ComplexRange& range) {
+    for(usize chunk = range.min(); chunk < range.max(); chunk++)
+    {
+      usize* counts = cursors.data() + chunk * numPartitions;
+      const ComplexRange chunkRange = GetRange(numVertices, numChunks, chunk);
+      for(usize i = chunkRange.min(); i < chunkRange.max(); i++)
+      {
+        counts[findPartition(i)]++;
+      }
+    }
+  });
+
+  std::vector<usize> partitionOffsets(numPartitions + 1);
+  usize total = 0;
+  for(usize partition = 0; partition < numPartitions; partition++)
   {
-    std::ignore = std::fclose(m_File);
+    partitionOffsets[partition] = total;
+    for(usize chunk = 0; chunk < numChunks; chunk++)
+    {
+      usize& cursor = cursors[chunk * numPartitions + partition];
+      const usize count = cursor;
+      cursor = total;
+      total += count;
+    }
   }
-  StlFileSentinel(const StlFileSentinel&) = delete;            // Copy Constructor Not Implemented
-  StlFileSentinel(StlFileSentinel&&) = delete;                 // Move Constructor Not Implemented
-  StlFileSentinel& operator=(const StlFileSentinel&) = delete; // Copy Assignment Not Implemented
-  StlFileSentinel& operator=(StlFileSentinel&&) = delete;      // Move Assignment Not Implemented
+  partitionOffsets[numPartitions] = total;
 
-private:
-  FILE* m_File = nullptr;
-};
+  std::vector<MeshIndexType> partitionedVertices(numVertices);
+  ParallelDataAlgorithm scatterAlg;
+  scatterAlg.setRange(0, numChunks);
+  scatterAlg.execute([&](const ComplexRange& range) {
+    for(usize chunk = range.min(); chunk < range.max(); chunk++)
+    {
+      usize* chunkCursors = cursors.data() + chunk * numPartitions;
+      const ComplexRange chunkRange = GetRange(numVertices, numChunks, chunk);
+      for(usize i = chunkRange.min(); i < chunkRange.max(); i++)
+      {
+        partitionedVertices[chunkCursors[findPartition(i)]++] = i;
+      }
+    }
+  });
+
+  std::vector<MeshIndexType> representatives(numVertices);
+  ParallelDataAlgorithm weldAlg;
+  weldAlg.setRange(0, numPartitions);
+  weldAlg.execute([&](const ComplexRange& range) {
+    std::vector<MeshIndexType> table;
+    for(usize partition = range.min(); partition < range.max(); partition++)
+    {
+      const usize count = partitionOffsets[partition + 1] - partitionOffsets[partition];
+      usize tableSize = 1;
+      while(tableSize < count * 2)
+      {
+        tableSize <<= 1;
+      }
+      const usize mask = tableSize - 1;
+      table.assign(tableSize, k_EmptySlot);
 
-std::array<float, 6> CreateMinMaxCoords()
-{
-  return {std::numeric_limits<float>::max(),  -std::numeric_limits<float>::max(), std::numeric_limits<float>::max(),
-          -std::numeric_limits<float>::max(), std::numeric_limits<float>::max(),  -std::numeric_limits<float>::max()};
-}
+      for(usize p = partitionOffsets[partition]; p < partitionOffsets[partition + 1]; p++)
+      {
+        const MeshIndexType node = partitionedVertices[p];
+        usize slot = static_cast<usize>(HashVertex(vertices.data() + node * 3)) & mask;
+        while(table[slot] != k_EmptySlot && !VerticesEqual(vertices.data(), table[slot], node))
+        {
+          slot = (slot + 1) & mask;
+        }
+        if(table[slot] == k_EmptySlot)
+        {
+          table[slot] = node;
+        }
+        representatives[node] = table[slot];
+      }
+    }
+  });
 
+  return representatives;
+}
 } // End anonymous namespace
 
 StlFileReader::StlFileReader(DataStructure& data, fs::path stlFilePath, const DataPath& geometryPath, const DataPath& faceGroupPath, const DataPath& faceNormalsDataPath,
@@ -108,21 +242,21 @@ StlFileReader::~StlFileReader() noexcept = default;
 
 Result<> StlFileReader::operator()()
 {
-
-  m_MinMaxCoords = ::CreateMinMaxCoords();
-
-  // Open File
-  FILE* f = std::fopen(m_FilePath.string().c_str(), "rb");
-  if(nullptr == f)
+  // Map the file so that the triangle records can be decoded in parallel straight from the page cache
+  std::unique_ptr<MemoryMappedFile> stlFile;
+  try
+  {
+    stlFile = std::make_unique<MemoryMappedFile>(m_FilePath, MemoryMappedFile::Mode::ReadOnly);
+  } catch(const std::exception& exception)
   {
-    return MakeErrorResult(complex::StlConstants::k_ErrorOpeningFile, "Error opening STL file");
+    return MakeErrorResult(complex::StlConstants::k_ErrorOpeningFile, fmt::format("Error opening STL file: {}", exception.what()));
   }
-  StlFileSentinel fileSentinel(f); // Will ensure that the file is closed when this method returns
+  stlFile->adviseSequential();
+  const std::byte* fileData = stlFile->data();
+  const usize fileSize = stlFile->size();
 
   // Read Header
-  std::array<char, complex::StlConstants::k_STL_HEADER_LENGTH> stlHeader = {0};
-  int32_t triCount = 0;
-  if(std::fread(stlHeader.data(), complex::StlConstants::k_STL_HEADER_LENGTH, 1, f) != 1)
+  if(fileSize < complex::StlConstants::k_STL_HEADER_LENGTH)
   {
     return MakeErrorResult(complex::StlConstants::k_StlHeaderParseError, "Error reading first 8 bytes of STL header. This can't be good.");
   }
@@ -133,7 +267,7 @@ Result<> StlFileReader::operator()()
   // This NON Zero value does NOT indicate a length but is some sort of color
   // value encoded into the file. Instead of being normal like everyone else and
   // using the STL spec they went off and did their own thing.
-  std::string stlHeaderStr(stlHeader.data(), complex::StlConstants::k_STL_HEADER_LENGTH);
+  std::string stlHeaderStr(reinterpret_cast<const char*>(fileData), complex::StlConstants::k_STL_HEADER_LENGTH);
 
   bool magicsFile = false;
   static const std::string k_ColorHeader("COLOR=");
@@ -143,10 +277,12 @@ Result<> StlFileReader::operator()()
     magicsFile = true;
   }
   // Read the number of triangles in the file.
-  if(std::fread(&triCount, sizeof(int32_t), 1, f) != 1)
+  if(fileSize < k_TriangleDataOffset)
   {
     return MakeErrorResult(complex::StlConstants::k_TriangleCountParseError, "Error reading number of triangles from file. This is bad.");
   }
+  int32_t triCount = 0;
+  std::memcpy(&triCount, fileData + complex::StlConstants::k_STL_HEADER_LENGTH, sizeof(int32_t));
 
   TriangleGeom& triangleGeom = m_DataStructure.getDataRefAs<TriangleGeom>(m_GeometryDataPath);
   LinkedGeometryData& linkedGeometryData = triangleGeom.getLinkedGeometryData();
@@ -164,125 +300,42 @@ Result<> StlFileReader::operator()()
   // Associate the Face Normals with the Face Data in the Triangle Geometry
   linkedGeometryData.addFaceData(m_FaceNormalsDataPath);
 
-  // Read the triangles
-  constexpr size_t k_StlElementCount = 12;
-  std::array<float, k_StlElementCount> fileVert = {0.0F};
-  uint16_t attr = 0;
-  std::vector<uint8_t> triangleAttributeBuffer(std::numeric_limits<uint16_t>::max()); // Just allocate a buffer of max UINT16 elements
-  for(int32_t t = 0; t < triCount; ++t)
+  const usize numTriangles = triangleGeom.getNumberOfFaces();
+  std::vector<usize> recordOffsets;
+  Result<> recordsResult = FindTriangleRecords(fileData, fileSize, numTriangles, magicsFile, recordOffsets);
+  if(recordsResult.invalid())
   {
-    size_t objsRead = std::fread(fileVert.data(), sizeof(float), k_StlElementCount, f); // Read the Triangle
-    if(k_StlElementCount != objsRead)
-    {
-      std::string msg = fmt::format("Error reading Triangle '{}}'. Object Count was {} and should have been {}", t, objsRead, k_StlElementCount);
-      return MakeErrorResult(complex::StlConstants::k_TriangleParseError, msg);
-    }
+    return recordsResult;
+  }
 
-    objsRead = std::fread(&attr, sizeof(uint16_t), 1, f); // Read the Triangle Attribute Data length
-    if(objsRead != 1)
-    {
-      std::string msg = fmt::format("Error reading Number of attributes for triangle '{}'. Object Count was {} and should have been 1", t, objsRead);
-      return MakeErrorResult(complex::StlConstants::k_AttributeParseError, msg);
-    }
-    if(attr > 0 && !magicsFile)
-    {
-      std::ignore = std::fseek(f, static_cast<size_t>(attr), SEEK_CUR); // Skip past the Triangle Attribute data since we don't know how to read it anyways
-    }
-    if(fileVert[3] < m_MinMaxCoords[0])
-    {
-      m_MinMaxCoords[0] = fileVert[3];
-    }
-    if(fileVert[3] > m_MinMaxCoords[1])
-    {
-      m_MinMaxCoords[1] = fileVert[3];
-    }
-    if(fileVert[4] < m_MinMaxCoords[2])
-    {
-      m_MinMaxCoords[2] = fileVert[4];
-    }
-    if(fileVert[4] > m_MinMaxCoords[3])
-    {
-      m_MinMaxCoords[3] = fileVert[4];
-    }
-    if(fileVert[5] < m_MinMaxCoords[4])
-    {
-      m_MinMaxCoords[4] = fileVert[5];
-    }
-    if(fileVert[5] > m_MinMaxCoords[5])
-    {
-      m_MinMaxCoords[5] = fileVert[5];
-    }
-    if(fileVert[6] < m_MinMaxCoords[0])
-    {
-      m_MinMaxCoords[0] = fileVert[6];
-    }
-    if(fileVert[6] > m_MinMaxCoords[1])
-    {
-      m_MinMaxCoords[1] = fileVert[6];
-    }
-    if(fileVert[7] < m_MinMaxCoords[2])
-    {
-      m_MinMaxCoords[2] = fileVert[7];
-    }
-    if(fileVert[7] > m_MinMaxCoords[3])
-    {
-      m_MinMaxCoords[3] = fileVert[7];
-    }
-    if(fileVert[8] < m_MinMaxCoords[4])
-    {
-      m_MinMaxCoords[4] = fileVert[8];
-    }
-    if(fileVert[8] > m_MinMaxCoords[5])
-    {
-      m_MinMaxCoords[5] = fileVert[8];
-    }
-    if(fileVert[9] < m_MinMaxCoords[0])
-    {
-      m_MinMaxCoords[0] = fileVert[9];
-    }
-    if(fileVert[9] > m_MinMaxCoords[1])
-    {
-      m_MinMaxCoords[1] = fileVert[9];
-    }
-    if(fileVert[10] < m_MinMaxCoords[2])
-    {
-      m_MinMaxCoords[2] = fileVert[10];
-    }
-    if(fileVert[10] > m_MinMaxCoords[3])
-    {
-      m_MinMaxCoords[3] = fileVert[10];
-    }
-    if(fileVert[11] < m_MinMaxCoords[4])
-    {
-      m_MinMaxCoords[4] = fileVert[11];
-    }
-    if(fileVert[11] > m_MinMaxCoords[5])
-    {
-      m_MinMaxCoords[5] = fileVert[11];
-    }
-    faceNormals[3 * t + 0] = static_cast<double>(fileVert[0]);
-    faceNormals[3 * t + 1] = static_cast<double>(fileVert[1]);
-    faceNormals[3 * t + 2] = static_cast<double>(fileVert[2]);
-    nodes[3 * (3 * t + 0) + 0] = fileVert[3];
-    nodes[3 * (3 * t + 0) + 1] = fileVert[4];
-    nodes[3 * (3 * t + 0) + 2] = fileVert[5];
-    nodes[3 * (3 * t + 1) + 0] = fileVert[6];
-    nodes[3 * (3 * t + 1) + 1] = fileVert[7];
-    nodes[3 * (3 * t + 1) + 2] = fileVert[8];
-    nodes[3 * (3 * t + 2) + 0] = fileVert[9];
-    nodes[3 * (3 * t + 2) + 1] = fileVert[10];
-    nodes[3 * (3 * t + 2) + 2] = fileVert[11];
-    triangles[t * 3] = 3 * t + 0;
-    triangles[t * 3 + 1] = 3 * t + 1;
-    triangles[t * 3 + 2] = 3 * t + 2;
-    if(m_ShouldCancel)
+  // Read the triangles
+  nonstd::span<float64> faceNormalValues = faceNormals.createSpan();
+  nonstd::span<float32> nodeValues = nodes.createSpan();
+  nonstd::span<MeshIndexType> triangleValues = triangles.createSpan();
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, numTriangles);
+  dataAlg.execute([&](const ComplexRange& range) {
+    std::array<float32, k_StlElementCount> fileVert = {0.0F};
+    for(usize t = range.min(); t < range.max(); t++)
     {
-      return {};
+      const usize recordOffset = recordOffsets.empty() ? k_TriangleDataOffset + t * k_TriangleRecordSize : recordOffsets[t];
+      std::memcpy(fileVert.data(), fileData + recordOffset, k_TriangleDataSize);
+      faceNormalValues[3 * t + 0] = static_cast<float64>(fileVert[0]);
+      faceNormalValues[3 * t + 1] = static_cast<float64>(fileVert[1]);
+      faceNormalValues[3 * t + 2] = static_cast<float64>(fileVert[2]);
+      std::copy(fileVert.begin() + 3, fileVert.end(), nodeValues.begin() + 9 * t);
+      triangleValues[t * 3] = 3 * t + 0;
+      triangleValues[t * 3 + 1] = 3 * t + 1;
+      triangleValues[t * 3 + 2] = 3 * t + 2;
     }
+  });
+  if(m_ShouldCancel)
+  {
+    return {};
   }
 
   return eliminate_duplicate_nodes();
-  // The fileSentinel will ensure the FILE* is closed.
+  // The stlFile will be unmapped when this method returns.
 }
 
 Result<> StlFileReader::eliminate_duplicate_nodes()
@@ -295,90 +348,86 @@ Result<> StlFileReader::eliminate_duplicate_nodes()
   SharedTriList& triangles = *(triangleGeom.getFaces());
   SharedVertList& vertices = *(triangleGeom.getVertices());
 
-  AbstractGeometry::MeshIndexType nNodesAll = triangleGeom.getNumberOfVertices();
-  AbstractGeometry::MeshIndexType nTriangles = triangleGeom.getNumberOfFaces();
-  size_t nNodes = 0;
-  if(nNodesAll > 0)
+  const usize nNodes = triangleGeom.getNumberOfVertices();
+  const usize nTriangles = triangleGeom.getNumberOfFaces();
+
+  // Each vertex is represented by the lowest indexed vertex with the same coordinates
+  std::vector<MeshIndexType> uniqueIds = FindRepresentativeVertices(vertices.createSpan(), nNodes);
+  if(m_ShouldCancel)
   {
-    nNodes = static_cast<size_t>(nNodesAll);
+    return {};
   }
-  float stepX = (m_MinMaxCoords[1] - m_MinMaxCoords[0]) / 100.0f;
-  float stepY = (m_MinMaxCoords[3] - m_MinMaxCoords[2]) / 100.0f;
-  float stepZ = (m_MinMaxCoords[5] - m_MinMaxCoords[4]) / 100.0f;
 
-  std::vector<std::vector<size_t>> nodesInBin(100 * 100 * 100);
+  // Renumber the unique nodes in index order, counting them per chunk first so that
+  // every chunk knows the first new id it hands out
+  const usize numChunks = GetNumRanges(nNodes, k_VerticesPerPartition);
+  std::vector<MeshIndexType> chunkOffsets(numChunks + 1, 0);
 
-  // determine (xyz) bin each node falls in - used to speed up node comparison
-  int32_t bin = 0, xBin = 0, yBin = 0, zBin = 0;
-  for(size_t i = 0; i < nNodes; i++)
-  {
-    xBin = static_cast<int32_t>((vertices[i * 3] - m_MinMaxCoords[0]) / stepX);
-    yBin = static_cast<int32_t>((vertices[i * 3 + 1] - m_MinMaxCoords[2]) / stepY);
-    zBin = static_cast<int32_t>((vertices[i * 3 + 2] - m_MinMaxCoords[4]) / stepZ);
-    if(xBin == 100)
-    {
-      xBin = 99;
-    }
-    if(yBin == 100)
+  ParallelDataAlgorithm countAlg;
+  countAlg.setRange(0, numChunks);
+  countAlg.execute([&](const ComplexRange& range) {
+    for(usize chunk = range.min(); chunk < range.max(); chunk++)
     {
-      yBin = 99;
+      const ComplexRange chunkRange = GetRange(nNodes, numChunks, chunk);
+      for(usize i = chunkRange.min(); i < chunkRange.max(); i++)
+      {
+        chunkOffsets[chunk + 1] += (uniqueIds[i] == i) ? 1 : 0;
+      }
     }
-    if(zBin == 100)
+  });
+  std::partial_sum(chunkOffsets.begin(), chunkOffsets.end(), chunkOffsets.begin());
+  const usize uniqueCount = chunkOffsets[numChunks];
+
+  // Copy the unique nodes into their new positions. Duplicates only take the new id of
+  // their representative once every unique node has been numbered.
+  const nonstd::span<const float32> vertexValues = vertices.createSpan();
+  std::vector<float32> uniqueVertices(uniqueCount * 3);
+  std::vector<MeshIndexType> newIds(nNodes);
+  ParallelDataAlgorithm uniqueAlg;
+  uniqueAlg.setRange(0, numChunks);
+  uniqueAlg.execute([&](const ComplexRange& range) {
+    for(usize chunk = range.min(); chunk < range.max(); chunk++)
     {
-      zBin = 99;
+      MeshIndexType nextId = chunkOffsets[chunk];
+      const ComplexRange chunkRange = GetRange(nNodes, numChunks, chunk);
+      for(usize i = chunkRange.min(); i < chunkRange.max(); i++)
+      {
+        if(uniqueIds[i] == i)
+        {
+          std::copy_n(vertexValues.begin() + i * 3, 3, uniqueVertices.begin() + nextId * 3);
+          newIds[i] = nextId++;
+        }
+      }
     }
-    bin = (zBin * 10000) + (yBin * 100) + xBin;
-    nodesInBin[bin].push_back(i);
-  }
-
-  // Create array to hold unique node numbers
-  Int64DataStore uniqueIds(IDataStore::ShapeType{nNodes}, IDataStore::ShapeType{1}, {});
-  for(AbstractGeometry::MeshIndexType i = 0; i < nNodesAll; i++)
-  {
-    uniqueIds[i] = static_cast<int64_t>(i);
-  }
+  });
 
-  // Parallel algorithm to find duplicate nodes
-  ParallelDataAlgorithm dataAlg;
-  dataAlg.setRange(0ULL, static_cast<size_t>(100 * 100 * 100));
-  dataAlg.execute(::FindUniqueIdsImpl(vertices, nodesInBin, uniqueIds));
-
-  // renumber the unique nodes
-  int64_t uniqueCount = 0;
-  for(size_t i = 0; i < nNodes; i++)
-  {
-    if(uniqueIds[i] == static_cast<int64_t>(i))
+  ParallelDataAlgorithm duplicateAlg;
+  duplicateAlg.setRange(0, nNodes);
+  duplicateAlg.execute([&](const ComplexRange& range) {
+    for(usize i = range.min(); i < range.max(); i++)
     {
-      uniqueIds[i] = uniqueCount;
-      uniqueCount++;
-    }
-    else
-    {
-      uniqueIds[i] = uniqueIds[uniqueIds[i]];
+      if(uniqueIds[i] != i)
+      {
+        newIds[i] = newIds[uniqueIds[i]];
+      }
     }
-  }
+  });
+  uniqueIds = {};
 
   // Move nodes to unique Id and then resize nodes array
-  for(size_t i = 0; i < nNodes; i++)
-  {
-    vertices[uniqueIds[i] * 3] = vertices[i * 3];
-    vertices[uniqueIds[i] * 3 + 1] = vertices[i * 3 + 1];
-    vertices[uniqueIds[i] * 3 + 2] = vertices[i * 3 + 2];
-  }
   triangleGeom.resizeVertexList(uniqueCount);
+  std::copy(uniqueVertices.begin(), uniqueVertices.end(), triangleGeom.getVertices()->createSpan().begin());
 
   // Update the triangle nodes to reflect the unique ids
-  int64_t node1 = 0, node2 = 0, node3 = 0;
-  for(size_t i = 0; i < static_cast<size_t>(nTriangles); i++)
-  {
-    node1 = triangles[i * 3];
-    node2 = triangles[i * 3 + 1];
-    node3 = triangles[i * 3 + 2];
-
-    triangles[i * 3] = uniqueIds[node1];
-    triangles[i * 3 + 1] = uniqueIds[node2];
-    triangles[i * 3 + 2] = uniqueIds[node3];
-  }
+  nonstd::span<MeshIndexType> triangleValues = triangles.createSpan();
+  ParallelDataAlgorithm triangleAlg;
+  triangleAlg.setRange(0, nTriangles * 3);
+  triangleAlg.execute([&](const ComplexRange& range) {
+    for(usize i = range.min(); i < range.max(); i++)
+    {
+      triangleValues[i] = newIds[triangleValues[i]];
+    }
+  });
 
   return {};
 }
@@ -7,7 +7,6 @@
 #include "complex/Filter/Arguments.hpp"
 #include "complex/Filter/IFilter.hpp"
 
-#include <array>
 #include <filesystem>
 
 namespace fs = std::filesystem;
@@ -39,15 +38,12 @@ public:
 
   /**
    * @brief eliminate_duplicate_nodes Removes duplicate nodes to ensure the
-   * created vertex list is shared
+   * created vertex list is shared. Nodes are welded when their coordinates are
+   * exactly equal and the unique nodes keep their original relative order.
    */
   Result<> eliminate_duplicate_nodes();
 
 private:
-  // Holds the min/max coordinates for X, Y, Z laid out at { X_Min, X_Max, Y_Min, Y_Max, Z_Min, Z_Max}
-  std::array<float, 6> m_MinMaxCoords = {std::numeric_limits<float>::max(),  -std::numeric_limits<float>::max(), std::numeric_limits<float>::max(),
-                                         -std::numeric_limits<float>::max(), std::numeric_limits<float>::max(),  -std::numeric_limits<float>::max()};
-
   DataStructure& m_DataStructure;
   const fs::path m_FilePath;
   const DataPath& m_GeometryDataPath;
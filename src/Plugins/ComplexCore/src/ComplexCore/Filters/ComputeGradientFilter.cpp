@@ -0,0 +1,250 @@
+#include "ComputeGradientFilter.hpp"
+
+#include "complex/DataStructure/DataArray.hpp"
+#include "complex/DataStructure/DataStore.hpp"
+#include "complex/DataStructure/Geometry/AbstractGeometry2D.hpp"
+#include "complex/DataStructure/Geometry/AbstractGeometry3D.hpp"
+#include "complex/DataStructure/Geometry/EdgeGeom.hpp"
+#include "complex/Filter/Actions/CreateArrayAction.hpp"
+#include "complex/Parameters/ArrayCreationParameter.hpp"
+#include "complex/Parameters/ArraySelectionParameter.hpp"
+#include "complex/Parameters/BoolParameter.hpp"
+#include "complex/Parameters/GeometrySelectionParameter.hpp"
+#include "complex/Utilities/FilterUtilities.hpp"
+#include "complex/Utilities/ParallelDataAlgorithm.hpp"
+
+#include <cmath>
+#include <utility>
+
+using namespace complex;
+
+namespace
+{
+constexpr int32 k_MissingGeometryError = -7400;
+constexpr int32 k_UnsupportedGeometryError = -7401;
+constexpr int32 k_MissingInputArrayError = -7402;
+constexpr int32 k_InputTuplesError = -7403;
+constexpr int32 k_DerivativesError = -7404;
+
+/**
+ * @brief Returns the number of tuples of the field that the gradient is computed
+ * from: one per Cell for grid geometries and one per Vertex for mesh geometries.
+ * Returns 0 for geometries that have no elements to differentiate over.
+ */
+usize FindFieldTupleCount(const AbstractGeometry& geometry)
+{
+  switch(geometry.getGeomType())
+  {
+  case AbstractGeometry::Type::Image:
+  case AbstractGeometry::Type::RectGrid:
+    return geometry.getNumberOfElements();
+  case AbstractGeometry::Type::Edge:
+    return dynamic_cast<const EdgeGeom&>(geometry).getNumberOfVertices();
+  case AbstractGeometry::Type::Triangle:
+  case AbstractGeometry::Type::Quad:
+    return dynamic_cast<const AbstractGeometry2D&>(geometry).getNumberOfVertices();
+  case AbstractGeometry::Type::Tetrahedral:
+  case AbstractGeometry::Type::Hexahedral:
+    return dynamic_cast<const AbstractGeometry3D&>(geometry).getNumberOfVertices();
+  default:
+    return 0;
+  }
+}
+
+/**
+ * @brief Copies the input array into the float64 field in parallel.
+ */
+struct ConvertToFloat64Functor
+{
+  template <typename T>
+  void operator()(const IDataArray& input, Float64Array& field)
+  {
+    if constexpr(!std::is_same_v<T, bool>)
+    {
+      const auto values = dynamic_cast<const DataArray<T>&>(input).createSpan();
+      auto fieldValues = field.createSpan();
+      ParallelDataAlgorithm dataAlg;
+      dataAlg.setRange(0, values.size());
+      dataAlg.execute([&](const ComplexRange& range) {
+        for(usize i = range.min(); i < range.max(); i++)
+        {
+          fieldValues[i] = static_cast<float64>(values[i]);
+        }
+      });
+    }
+  }
+};
+} // namespace
+
+namespace complex
+{
+//------------------------------------------------------------------------------
+std::string ComputeGradientFilter::name() const
+{
+  return FilterTraits<ComputeGradientFilter>::name.str();
+}
+
+//------------------------------------------------------------------------------
+std::string ComputeGradientFilter::className() const
+{
+  return FilterTraits<ComputeGradientFilter>::className;
+}
+
+//------------------------------------------------------------------------------
+Uuid ComputeGradientFilter::uuid() const
+{
+  return FilterTraits<ComputeGradientFilter>::uuid;
+}
+
+//------------------------------------------------------------------------------
+std::string ComputeGradientFilter::humanName() const
+{
+  return "Compute Gradient";
+}
+
+//------------------------------------------------------------------------------
+std::vector<std::string> ComputeGradientFilter::defaultTags() const
+{
+  return {"#Statistics", "#Derivatives", "#Gradient", "#Find Derivatives"};
+}
+
+//------------------------------------------------------------------------------
+Parameters ComputeGradientFilter::parameters() const
+{
+  Parameters params;
+  // Create the parameter descriptors that are needed for this filter
+  params.insertSeparator(Parameters::Separator{"Input Parameters"});
+  params.insertLinkableParameter(std::make_unique<BoolParameter>(k_ComputeMagnitude_Key, "Compute Gradient Magnitude", "Also store the magnitude of the gradient of each component", true));
+
+  params.insertSeparator(Parameters::Separator{"Required Input Data"});
+  params.insert(std::make_unique<GeometrySelectionParameter>(
+      k_GeometryPath_Key, "Geometry", "DataPath to the geometry the gradient is computed over", DataPath(),
+      GeometrySelectionParameter::AllowedTypes{AbstractGeometry::Type::Image, AbstractGeometry::Type::RectGrid, AbstractGeometry::Type::Edge, AbstractGeometry::Type::Triangle,
+                                               AbstractGeometry::Type::Quad, AbstractGeometry::Type::Tetrahedral, AbstractGeometry::Type::Hexahedral}));
+  params.insert(std::make_unique<ArraySelectionParameter>(k_InputArrayPath_Key, "Input Array", "Cell data for grid geometries or Vertex data for mesh geometries", DataPath(),
+                                                          ArraySelectionParameter::AllowedTypes{DataType::int8, DataType::uint8, DataType::int16, DataType::uint16, DataType::int32,
+                                                                                                DataType::uint32, DataType::int64, DataType::uint64, DataType::float32, DataType::float64}));
+
+  params.insertSeparator(Parameters::Separator{"Created Element Data"});
+  params.insert(std::make_unique<ArrayCreationParameter>(k_GradientArrayPath_Key, "Gradient", "The d/dx, d/dy and d/dz derivatives of each component of the Input Array for each element",
+                                                         DataPath({"Gradient"})));
+  params.insert(std::make_unique<ArrayCreationParameter>(k_MagnitudeArrayPath_Key, "Gradient Magnitude", "The magnitude of the gradient of each component of the Input Array for each element",
+                                                         DataPath({"Gradient Magnitude"})));
+  params.linkParameters(k_ComputeMagnitude_Key, k_MagnitudeArrayPath_Key, true);
+
+  return params;
+}
+
+//------------------------------------------------------------------------------
+IFilter::UniquePointer ComputeGradientFilter::clone() const
+{
+  return std::make_unique<ComputeGradientFilter>();
+}
+
+//------------------------------------------------------------------------------
+IFilter::PreflightResult ComputeGradientFilter::preflightImpl(const DataStructure& dataStructure, const Arguments& filterArgs, const MessageHandler& messageHandler,
+                                                              const std::atomic_bool& shouldCancel) const
+{
+  auto pGeometryPathValue = filterArgs.value<DataPath>(k_GeometryPath_Key);
+  auto pInputArrayPathValue = filterArgs.value<DataPath>(k_InputArrayPath_Key);
+  auto pGradientArrayPathValue = filterArgs.value<DataPath>(k_GradientArrayPath_Key);
+  auto pComputeMagnitudeValue = filterArgs.value<bool>(k_ComputeMagnitude_Key);
+  auto pMagnitudeArrayPathValue = filterArgs.value<DataPath>(k_MagnitudeArrayPath_Key);
+
+  const auto* geometry = dataStructure.getDataAs<AbstractGeometry>(pGeometryPathValue);
+  if(geometry == nullptr)
+  {
+    return {MakeErrorResult<OutputActions>(k_MissingGeometryError, fmt::format("Could not find a geometry at path '{}'", pGeometryPathValue.toString()))};
+  }
+  const usize numFieldTuples = FindFieldTupleCount(*geometry);
+  if(numFieldTuples == 0)
+  {
+    return {MakeErrorResult<OutputActions>(k_UnsupportedGeometryError, fmt::format("The geometry at path '{}' has no elements to compute a gradient over", pGeometryPathValue.toString()))};
+  }
+
+  const auto* inputArray = dataStructure.getDataAs<IDataArray>(pInputArrayPathValue);
+  if(inputArray == nullptr)
+  {
+    return {MakeErrorResult<OutputActions>(k_MissingInputArrayError, fmt::format("Could not find the input array at path '{}'", pInputArrayPathValue.toString()))};
+  }
+  if(inputArray->getNumberOfTuples() != numFieldTuples)
+  {
+    return {MakeErrorResult<OutputActions>(
+        k_InputTuplesError, fmt::format("The input array has {} tuples but the geometry requires one tuple per {} ({})", inputArray->getNumberOfTuples(),
+                                        geometry->getGeomType() == AbstractGeometry::Type::Image || geometry->getGeomType() == AbstractGeometry::Type::RectGrid ? "Cell" : "Vertex",
+                                        numFieldTuples))};
+  }
+
+  complex::Result<OutputActions> resultOutputActions;
+
+  const usize numComps = inputArray->getNumberOfComponents();
+  const std::vector<usize> tupleShape = {geometry->getNumberOfElements()};
+  {
+    auto createGradientAction = std::make_unique<CreateArrayAction>(DataType::float64, tupleShape, std::vector<usize>{numComps * 3}, pGradientArrayPathValue);
+    resultOutputActions.value().actions.push_back(std::move(createGradientAction));
+  }
+  // The magnitude is float so that it can be passed to the Robust Automatic Threshold filter
+  if(pComputeMagnitudeValue)
+  {
+    auto createMagnitudeAction = std::make_unique<CreateArrayAction>(DataType::float32, tupleShape, std::vector<usize>{numComps}, pMagnitudeArrayPathValue);
+    resultOutputActions.value().actions.push_back(std::move(createMagnitudeAction));
+  }
+
+  std::vector<PreflightValue> preflightUpdatedValues;
+
+  return {std::move(resultOutputActions), std::move(preflightUpdatedValues)};
+}
+
+//------------------------------------------------------------------------------
+Result<> ComputeGradientFilter::executeImpl(DataStructure& dataStructure, const Arguments& filterArgs, const PipelineFilter* pipelineNode, const MessageHandler& messageHandler,
+                                            const std::atomic_bool& shouldCancel) const
+{
+  auto pGeometryPathValue = filterArgs.value<DataPath>(k_GeometryPath_Key);
+  auto pInputArrayPathValue = filterArgs.value<DataPath>(k_InputArrayPath_Key);
+  auto pGradientArrayPathValue = filterArgs.value<DataPath>(k_GradientArrayPath_Key);
+  auto pComputeMagnitudeValue = filterArgs.value<bool>(k_ComputeMagnitude_Key);
+  auto pMagnitudeArrayPathValue = filterArgs.value<DataPath>(k_MagnitudeArrayPath_Key);
+
+  const auto& geometry = dataStructure.getDataRefAs<AbstractGeometry>(pGeometryPathValue);
+  auto& inputArray = dataStructure.getDataRefAs<IDataArray>(pInputArrayPathValue);
+  auto& gradients = dataStructure.getDataRefAs<Float64Array>(pGradientArrayPathValue);
+
+  // The geometries differentiate float64 fields, so other types are converted into a temporary copy
+  DataStructure tempStructure;
+  auto* field = dynamic_cast<Float64Array*>(&inputArray);
+  if(field == nullptr)
+  {
+    field = Float64Array::CreateWithStore<Float64DataStore>(tempStructure, "Field", std::vector<usize>{inputArray.getNumberOfTuples()}, std::vector<usize>{inputArray.getNumberOfComponents()});
+    ExecuteDataFunction(ConvertToFloat64Functor{}, inputArray.getDataType(), inputArray, *field);
+  }
+
+  messageHandler(IFilter::Message::Type::Info, "Computing the gradient...");
+  try
+  {
+    geometry.findDerivatives(field, &gradients, nullptr);
+  } catch(const std::exception& exception)
+  {
+    return MakeErrorResult(k_DerivativesError, exception.what());
+  }
+
+  if(!pComputeMagnitudeValue || shouldCancel)
+  {
+    return {};
+  }
+
+  // Each component of each element has its three derivatives stored together
+  const auto gradientValues = std::as_const(gradients).createSpan();
+  auto magnitudes = dataStructure.getDataRefAs<Float32Array>(pMagnitudeArrayPathValue).createSpan();
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, magnitudes.size());
+  dataAlg.execute([&](const ComplexRange& range) {
+    for(usize i = range.min(); i < range.max(); i++)
+    {
+      const float64* gradient = gradientValues.data() + i * 3;
+      magnitudes[i] = static_cast<float32>(std::sqrt(gradient[0] * gradient[0] + gradient[1] * gradient[1] + gradient[2] * gradient[2]));
+    }
+  });
+
+  return {};
+}
+} // namespace complex
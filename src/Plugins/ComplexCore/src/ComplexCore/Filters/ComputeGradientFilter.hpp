@@ -0,0 +1,102 @@
+#pragma once
+
+#include "ComplexCore/ComplexCore_export.hpp"
+
+#include "complex/Filter/FilterTraits.hpp"
+#include "complex/Filter/IFilter.hpp"
+
+namespace complex
+{
+/**
+ * @class ComputeGradientFilter
+ * @brief This Filter computes the spatial gradient of an Attribute Array over a
+ * geometry and, optionally, the magnitude of the gradient. Grid geometries use Cell
+ * data and finite differences; mesh geometries use Vertex data and produce one
+ * gradient per element.
+ */
+class COMPLEXCORE_EXPORT ComputeGradientFilter : public IFilter
+{
+public:
+  ComputeGradientFilter() = default;
+  ~ComputeGradientFilter() noexcept override = default;
+
+  ComputeGradientFilter(const ComputeGradientFilter&) = delete;
+  ComputeGradientFilter(ComputeGradientFilter&&) noexcept = delete;
+
+  ComputeGradientFilter& operator=(const ComputeGradientFilter&) = delete;
+  ComputeGradientFilter& operator=(ComputeGradientFilter&&) noexcept = delete;
+
+  // Parameter Keys
+  static inline constexpr StringLiteral k_GeometryPath_Key = "geometry_path";
+  static inline constexpr StringLiteral k_InputArrayPath_Key = "input_array_path";
+  static inline constexpr StringLiteral k_GradientArrayPath_Key = "gradient_array_path";
+  static inline constexpr StringLiteral k_ComputeMagnitude_Key = "compute_magnitude";
+  static inline constexpr StringLiteral k_MagnitudeArrayPath_Key = "magnitude_array_path";
+
+  /**
+   * @brief Returns the name of the filter.
+   * @return
+   */
+  std::string name() const override;
+
+  /**
+   * @brief Returns the C++ classname of this filter.
+   * @return
+   */
+  std::string className() const override;
+
+  /**
+   * @brief Returns the uuid of the filter.
+   * @return
+   */
+  Uuid uuid() const override;
+
+  /**
+   * @brief Returns the human readable name of the filter.
+   * @return
+   */
+  std::string humanName() const override;
+
+  /**
+   * @brief Returns the default tags for this filter.
+   * @return
+   */
+  std::vector<std::string> defaultTags() const override;
+
+  /**
+   * @brief Returns the parameters of the filter (i.e. its inputs)
+   * @return
+   */
+  Parameters parameters() const override;
+
+  /**
+   * @brief Returns a copy of the filter.
+   * @return
+   */
+  UniquePointer clone() const override;
+
+protected:
+  /**
+   * @brief Takes in a DataStructure and checks that the filter can be run on it with the given arguments.
+   * Returns any warnings/errors. Also returns the changes that would be applied to the DataStructure.
+   * Some parts of the actions may not be completely filled out if all the required information is not available at preflight time.
+   * @param ds The input DataStructure instance
+   * @param filterArgs These are the input values for each parameter that is required for the filter
+   * @param messageHandler The MessageHandler object
+   * @return Returns a Result object with error or warning values if any of those occurred during execution of this function
+   */
+  PreflightResult preflightImpl(const DataStructure& ds, const Arguments& filterArgs, const MessageHandler& messageHandler, const std::atomic_bool& shouldCancel) const override;
+
+  /**
+   * @brief Applies the filter's algorithm to the DataStructure with the given arguments. Returns any warnings/errors.
+   * On failure, there is no guarantee that the DataStructure is in a correct state.
+   * @param ds The input DataStructure instance
+   * @param filterArgs These are the input values for each parameter that is required for the filter
+   * @param messageHandler The MessageHandler object
+   * @return Returns a Result object with error or warning values if any of those occurred during execution of this function
+   */
+  Result<> executeImpl(DataStructure& data, const Arguments& filterArgs, const PipelineFilter* pipelineNode, const MessageHandler& messageHandler, const std::atomic_bool& shouldCancel) const override;
+};
+} // namespace complex
+
+COMPLEX_DEF_FILTER_TRAITS(complex, ComputeGradientFilter, "5b1d4f2e-7c3a-4e86-9f0d-2a6b8c4e1d73");
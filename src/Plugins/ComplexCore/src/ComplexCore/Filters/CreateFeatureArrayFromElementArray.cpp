@@ -1,71 +1,16 @@
 #include "CreateFeatureArrayFromElementArray.hpp"
 
 #include "complex/Common/TypesUtility.hpp"
+#include "complex/DataStructure/ContiguousValues.hpp"
 #include "complex/DataStructure/DataArray.hpp"
 #include "complex/DataStructure/DataPath.hpp"
-#include "complex/DataStructure/DataStore.hpp"
 #include "complex/Filter/Actions/CreateArrayAction.hpp"
 #include "complex/Parameters/ArrayCreationParameter.hpp"
 #include "complex/Parameters/ArraySelectionParameter.hpp"
+#include "complex/Utilities/FeatureDataTransfer.hpp"
 
 using namespace complex;
 
-namespace
-{
-template <typename T>
-Result<> copyCellData(DataStructure& dataStructure, const DataPath& selectedCellArrayPathValue, const DataPath& featureIdsArrayPathValue, const DataPath& createdArrayNameValue,
-                      const std::atomic_bool& shouldCancel)
-{
-  const DataArray<T>& selectedCellArray = dataStructure.getDataRefAs<DataArray<T>>(selectedCellArrayPathValue);
-  const DataStore<T> selectedCellArrayStore = selectedCellArray.template getIDataStoreRefAs<DataStore<T>>();
-  const Int32Array& featureIds = dataStructure.getDataRefAs<Int32Array>(featureIdsArrayPathValue);
-  DataArray<T>& createdArray = dataStructure.getDataRefAs<DataArray<T>>(createdArrayNameValue);
-
-  // Initialize the output array with a default value
-  createdArray.fill(0);
-
-  usize totalCellArrayComponents = selectedCellArray.getNumberOfComponents();
-
-  std::map<int32, usize> featureMap;
-  Result<> result;
-
-  usize totalCellArrayTuples = selectedCellArray.getNumberOfTuples();
-  for(usize cellTupleIdx = 0; cellTupleIdx < totalCellArrayTuples; cellTupleIdx++)
-  {
-    if(shouldCancel)
-    {
-      return {};
-    }
-
-    // Get the feature id (or what ever the user has selected as their "Feature" identifier
-    int32 featureIdx = featureIds[cellTupleIdx];
-
-    // Store the index of the first tuple with this feature id in the map
-    if(featureMap.find(featureIdx) == featureMap.end())
-    {
-      featureMap[featureIdx] = totalCellArrayComponents * cellTupleIdx;
-    }
-
-    // Check that the values at the current index match the value at the first index
-    usize firstInstanceCellTupleIdx = featureMap[featureIdx];
-    for(usize cellCompIdx = 0; cellCompIdx < totalCellArrayComponents; cellCompIdx++)
-    {
-      T firstInstanceCellVal = selectedCellArray[firstInstanceCellTupleIdx + cellCompIdx];
-      T currentCellVal = selectedCellArray[totalCellArrayComponents * cellTupleIdx + cellCompIdx];
-      if(currentCellVal != firstInstanceCellVal && result.warnings().empty())
-      {
-        // The values are inconsistent with the first values for this feature id, so throw a warning
-        result.warnings().push_back(Warning{-1000, fmt::format("Elements from Feature {} do not all have the same value. The last value copied into Feature {} will be used", featureIdx, featureIdx)});
-      }
-
-      createdArray[totalCellArrayComponents * featureIdx + cellCompIdx] = selectedCellArray[totalCellArrayComponents * cellTupleIdx + cellCompIdx];
-    }
-  }
-
-  return result;
-}
-} // namespace
-
 namespace complex
 {
 //------------------------------------------------------------------------------
@@ -154,6 +99,12 @@ Result<> CreateFeatureArrayFromElementArray::executeImpl(DataStructure& dataStru
   const Int32Array& featureIds = dataStructure.getDataRefAs<Int32Array>(pFeatureIdsArrayPathValue);
   IDataArray& createdArray = dataStructure.getDataRefAs<IDataArray>(pCreatedArrayNameValue);
 
+  if(selectedCellArray.getNumberOfTuples() != featureIds.getNumberOfTuples())
+  {
+    return MakeErrorResult(-14001, fmt::format("The selected array has {} tuples but the FeatureIds array has {} tuples. The path is {}", selectedCellArray.getNumberOfTuples(),
+                                               featureIds.getNumberOfTuples(), pSelectedCellArrayPathValue.toString()));
+  }
+
   // Resize the created array to the proper size
   usize featureIdsMaxIdx = std::distance(featureIds.begin(), std::max_element(featureIds.cbegin(), featureIds.cend()));
   usize maxValue = featureIds[featureIdsMaxIdx];
@@ -161,32 +112,26 @@ Result<> CreateFeatureArrayFromElementArray::executeImpl(DataStructure& dataStru
   IDataStore& createdArrayStore = createdArray.getIDataStoreRefAs<IDataStore>();
   createdArrayStore.reshapeTuples(std::vector<usize>{maxValue + 1});
 
-  switch(selectedCellArray.getDataType())
+  // Feature ids whose data store is not contiguous are copied
+  const ContiguousValues<const int32> featureIdContiguousValues(featureIds.getDataStoreRef());
+  const nonstd::span<const int32> featureIdValues = featureIdContiguousValues.span();
+  const FeatureDataTransfer::FeatureElements featureElements = FeatureDataTransfer::FindFeatureElements(featureIdValues, maxValue + 1);
+  if(shouldCancel)
   {
-  case DataType::int8:
-    return copyCellData<int8>(dataStructure, pSelectedCellArrayPathValue, pFeatureIdsArrayPathValue, pCreatedArrayNameValue, shouldCancel);
-  case DataType::uint8:
-    return copyCellData<uint8>(dataStructure, pSelectedCellArrayPathValue, pFeatureIdsArrayPathValue, pCreatedArrayNameValue, shouldCancel);
-  case DataType::int16:
-    return copyCellData<int16>(dataStructure, pSelectedCellArrayPathValue, pFeatureIdsArrayPathValue, pCreatedArrayNameValue, shouldCancel);
-  case DataType::uint16:
-    return copyCellData<uint16>(dataStructure, pSelectedCellArrayPathValue, pFeatureIdsArrayPathValue, pCreatedArrayNameValue, shouldCancel);
-  case DataType::int32:
-    return copyCellData<int32>(dataStructure, pSelectedCellArrayPathValue, pFeatureIdsArrayPathValue, pCreatedArrayNameValue, shouldCancel);
-  case DataType::uint32:
-    return copyCellData<uint32>(dataStructure, pSelectedCellArrayPathValue, pFeatureIdsArrayPathValue, pCreatedArrayNameValue, shouldCancel);
-  case DataType::int64:
-    return copyCellData<int64>(dataStructure, pSelectedCellArrayPathValue, pFeatureIdsArrayPathValue, pCreatedArrayNameValue, shouldCancel);
-  case DataType::uint64:
-    return copyCellData<uint64>(dataStructure, pSelectedCellArrayPathValue, pFeatureIdsArrayPathValue, pCreatedArrayNameValue, shouldCancel);
-  case DataType::float32:
-    return copyCellData<float>(dataStructure, pSelectedCellArrayPathValue, pFeatureIdsArrayPathValue, pCreatedArrayNameValue, shouldCancel);
-  case DataType::float64:
-    return copyCellData<double>(dataStructure, pSelectedCellArrayPathValue, pFeatureIdsArrayPathValue, pCreatedArrayNameValue, shouldCancel);
-  case DataType::boolean:
-    return copyCellData<bool>(dataStructure, pSelectedCellArrayPathValue, pFeatureIdsArrayPathValue, pCreatedArrayNameValue, shouldCancel);
-  default:
-    return MakeErrorResult(-14000, fmt::format("The selected array was of unsupported type. The path is {}", pSelectedCellArrayPathValue.toString()));
+    return {};
   }
+
+  // The last element of each feature is copied; features without elements are set to 0
+  FeatureDataTransfer::ScatterElementTuples(featureElements.last, selectedCellArray, createdArray);
+
+  Result<> result;
+  const usize mismatchedElement = FeatureDataTransfer::FindFirstMismatchedElement(featureIdValues, featureElements.first, selectedCellArray);
+  if(mismatchedElement != FeatureDataTransfer::k_NoElement)
+  {
+    // The values are inconsistent with the first values for this feature id, so throw a warning
+    const int32 featureIdx = featureIdValues[mismatchedElement];
+    result.warnings().push_back(Warning{-1000, fmt::format("Elements from Feature {} do not all have the same value. The last value copied into Feature {} will be used", featureIdx, featureIdx)});
+  }
+  return result;
 }
 } // namespace complex
@@ -1,5 +1,6 @@
 #include "CropVertexGeometry.hpp"
 
+#include "complex/DataStructure/ContiguousValues.hpp"
 #include "complex/DataStructure/DataArray.hpp"
 #include "complex/DataStructure/Geometry/VertexGeom.hpp"
 #include "complex/Filter/Actions/CreateArrayAction.hpp"
@@ -11,37 +12,12 @@
 #include "complex/Parameters/StringParameter.hpp"
 #include "complex/Parameters/VectorParameter.hpp"
 #include "complex/Utilities/FilterUtilities.hpp"
+#include "complex/Utilities/StreamCompaction.hpp"
+
+#include <utility>
 
 namespace complex
 {
-namespace
-{
-struct CopyDataToCroppedGeometryFunctor
-{
-  template <typename T>
-  void operator()(const IDataArray& inDataRef, IDataArray& outDataRef, const std::vector<int64>& croppedPoints)
-  {
-    const DataArray<T>& inputDataArray = dynamic_cast<const DataArray<T>&>(inDataRef);
-    const auto& inputData = inputDataArray.getDataStoreRef();
-    DataArray<T>& croppedDataArray = dynamic_cast<DataArray<T>&>(outDataRef);
-    auto& croppedData = croppedDataArray.getDataStoreRef();
-    croppedData.reshapeTuples({croppedPoints.size()});
-
-    usize nComps = inDataRef.getNumberOfComponents();
-
-    for(std::vector<int64>::size_type i = 0; i < croppedPoints.size(); i++)
-    {
-      for(usize d = 0; d < nComps; d++)
-      {
-        usize tmpIndex = nComps * i + d;
-        usize ptrIndex = nComps * croppedPoints[i] + d;
-        croppedData[tmpIndex] = inputData[ptrIndex];
-      }
-    }
-  }
-};
-} // namespace
-
 std::string CropVertexGeometry::name() const
 {
   return FilterTraits<CropVertexGeometry>::name;
@@ -165,51 +141,35 @@ Result<> CropVertexGeometry::executeImpl(DataStructure& dataStructure, const Arg
   auto zMax = posMax[2];
 
   auto& vertices = dataStructure.getDataRefAs<VertexGeom>(vertexGeomPath);
-  int64 numVerts = vertices.getNumberOfVertices();
-  auto* verticesPtr = vertices.getVertices();
-  auto& allVerts = verticesPtr->getDataStoreRef();
-  std::vector<int64> croppedPoints;
-  croppedPoints.reserve(numVerts);
-
-  for(int64 i = 0; i < numVerts; i++)
+  const usize numVerts = vertices.getNumberOfVertices();
+  // Vertices whose data store is not contiguous are copied
+  const ContiguousValues<const float32> vertexValues(std::as_const(*vertices.getVertices()).getDataStoreRef());
+  const nonstd::span<const float32> allVerts = vertexValues.span();
+
+  const std::vector<usize> croppedPoints = StreamCompaction::FindKeptIndices(numVerts, [&](usize i) {
+    return allVerts[3 * i + 0] >= xMin && allVerts[3 * i + 0] <= xMax && allVerts[3 * i + 1] >= yMin && allVerts[3 * i + 1] <= yMax && allVerts[3 * i + 2] >= zMin &&
+           allVerts[3 * i + 2] <= zMax;
+  });
+  if(shouldCancel)
   {
-    if(shouldCancel)
-    {
-      return {};
-    }
-    if(allVerts[3 * i + 0] >= xMin && allVerts[3 * i + 0] <= xMax && allVerts[3 * i + 1] >= yMin && allVerts[3 * i + 1] <= yMax && allVerts[3 * i + 2] >= zMin && allVerts[3 * i + 2] <= zMax)
-    {
-      croppedPoints.push_back(i);
-    }
+    return {};
   }
 
-  croppedPoints.shrink_to_fit();
-
   auto& crop = dataStructure.getDataRefAs<VertexGeom>(croppedGeomPath);
   crop.resizeVertexList(croppedPoints.size());
+  StreamCompaction::CopyKeptTuples(*vertices.getVertices(), *crop.getVertices(), croppedPoints);
 
   DataPath croppedGroupPath = croppedGeomPath.createChildPath(croppedGroupName);
-
-  for(usize i = 0; i < croppedPoints.size(); i++)
+  for(auto&& targetArrayPath : targetArrays)
   {
     if(shouldCancel)
     {
       return {};
     }
-    auto coords = vertices.getCoords(croppedPoints[i]);
-    crop.setCoords(i, coords);
-  }
-
-  std::vector<usize> tDims = {croppedPoints.size()};
-
-  for(auto&& targetArrayPath : targetArrays)
-  {
     DataPath destArrayPath(croppedGroupPath.createChildPath(targetArrayPath.getTargetName()));
-
     const auto& srcArray = dataStructure.getDataRefAs<IDataArray>(targetArrayPath);
     auto& destArray = dataStructure.getDataRefAs<IDataArray>(destArrayPath);
-
-    ExecuteDataFunction(CopyDataToCroppedGeometryFunctor{}, srcArray.getDataType(), srcArray, destArray, croppedPoints);
+    StreamCompaction::CopyKeptTuples(srcArray, destArray, croppedPoints);
   }
 
   return {};
@@ -1,7 +1,9 @@
 #include "ExportDREAM3DFilter.hpp"
 
 #include "complex/DataStructure/DataGroup.hpp"
+#include "complex/Parameters/BoolParameter.hpp"
 #include "complex/Parameters/FileSystemPathParameter.hpp"
+#include "complex/Parameters/NumberParameter.hpp"
 #include "complex/Parameters/StringParameter.hpp"
 #include "complex/Pipeline/Pipeline.hpp"
 #include "complex/Pipeline/PipelineFilter.hpp"
@@ -14,6 +16,8 @@ constexpr complex::int32 k_NoExportPathError = -1;
 constexpr complex::int32 k_NoParentPathError = -2;
 constexpr complex::int32 k_FailedFileWriterError = -14;
 constexpr complex::int32 k_FailedFindPipelineError = -15;
+constexpr complex::int32 k_InvalidCompressionLevelError = -16;
+constexpr complex::int32 k_InvalidChunkSizeError = -17;
 } // namespace
 
 namespace complex
@@ -43,6 +47,13 @@ Parameters ExportDREAM3DFilter::parameters() const
   Parameters params;
   params.insert(std::make_unique<FileSystemPathParameter>(k_ExportFilePath, "Export File Path", "The file path the DataStructure should be written to as an HDF5 file.", "",
                                                           FileSystemPathParameter::ExtensionsType{".dream3d"}, FileSystemPathParameter::PathType::OutputFile));
+  params.insertSeparator(Parameters::Separator{"Compression"});
+  params.insert(std::make_unique<Int32Parameter>(k_CompressionLevel_Key, "Compression Level", "The gzip compression level from 1 (fastest) to 9 (smallest). 0 writes uncompressed data.", 0));
+  params.insert(std::make_unique<BoolParameter>(k_UseShuffle_Key, "Shuffle Bytes", "Reorders the bytes of each value before compressing which usually improves the compression ratio.", false));
+  params.insert(std::make_unique<BoolParameter>(k_PackIntegers_Key, "Pack Integer Arrays", "Stores integer arrays with the minimum number of bits needed for their value range. This is lossless.",
+                                                false));
+  params.insert(std::make_unique<BoolParameter>(k_UseChecksum_Key, "Add Checksums", "Adds a Fletcher32 checksum to each chunk so that corrupted data is detected on reading.", false));
+  params.insert(std::make_unique<Int32Parameter>(k_ChunkSize_Key, "Chunk Size (KiB)", "The target size of each chunk when any of the compression options are used.", 1024));
   return params;
 }
 
@@ -58,6 +69,16 @@ IFilter::PreflightResult ExportDREAM3DFilter::preflightImpl(const DataStructure&
   {
     return {nonstd::make_unexpected(std::vector<Error>{Error{k_NoExportPathError, "Export file path not provided."}})};
   }
+  auto compressionLevel = args.value<int32>(k_CompressionLevel_Key);
+  if(compressionLevel < 0 || compressionLevel > 9)
+  {
+    return {MakeErrorResult<OutputActions>(k_InvalidCompressionLevelError, fmt::format("Compression level must be between 0 and 9 but was {}.", compressionLevel))};
+  }
+  auto chunkSize = args.value<int32>(k_ChunkSize_Key);
+  if(chunkSize <= 0)
+  {
+    return {MakeErrorResult<OutputActions>(k_InvalidChunkSizeError, fmt::format("Chunk size must be greater than 0 KiB but was {}.", chunkSize))};
+  }
   return {};
 }
 
@@ -74,6 +95,14 @@ Result<> ExportDREAM3DFilter::executeImpl(DataStructure& dataStructure, const Ar
   }
   H5::FileWriter fileWriter = std::move(result.value());
 
+  H5::DatasetCreationOptions creationOptions;
+  creationOptions.deflateLevel = args.value<int32>(k_CompressionLevel_Key);
+  creationOptions.shuffle = args.value<bool>(k_UseShuffle_Key);
+  creationOptions.scaleOffset = args.value<bool>(k_PackIntegers_Key);
+  creationOptions.fletcher32 = args.value<bool>(k_UseChecksum_Key);
+  creationOptions.chunkBytes = static_cast<usize>(args.value<int32>(k_ChunkSize_Key)) * 1024;
+  fileWriter.setDatasetCreationOptions(creationOptions);
+
   auto pipelinePtr = pipelineNode->getPrecedingPipeline();
   if(pipelinePtr == nullptr)
   {
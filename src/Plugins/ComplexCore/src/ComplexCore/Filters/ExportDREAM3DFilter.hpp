@@ -28,6 +28,11 @@ public:
 
   // Parameter Keys
   static inline constexpr StringLiteral k_ExportFilePath = "Export_File_Path";
+  static inline constexpr StringLiteral k_CompressionLevel_Key = "Compression_Level";
+  static inline constexpr StringLiteral k_UseShuffle_Key = "Use_Shuffle";
+  static inline constexpr StringLiteral k_PackIntegers_Key = "Pack_Integers";
+  static inline constexpr StringLiteral k_UseChecksum_Key = "Use_Checksum";
+  static inline constexpr StringLiteral k_ChunkSize_Key = "Chunk_Size";
 
   /**
    * @brief Returns the name of the filter class.
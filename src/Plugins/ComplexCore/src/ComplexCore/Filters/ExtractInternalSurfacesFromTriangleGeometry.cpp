@@ -1,5 +1,6 @@
 #include "ExtractInternalSurfacesFromTriangleGeometry.hpp"
 
+#include "complex/DataStructure/ContiguousValues.hpp"
 #include "complex/DataStructure/Geometry/TriangleGeom.hpp"
 #include "complex/Filter/Actions/CreateArrayAction.hpp"
 #include "complex/Filter/Actions/CreateTriangleGeomAction.hpp"
@@ -8,9 +9,12 @@
 #include "complex/Parameters/GeometrySelectionParameter.hpp"
 #include "complex/Parameters/MultiArraySelectionParameter.hpp"
 #include "complex/Utilities/FilterUtilities.hpp"
+#include "complex/Utilities/ParallelDataAlgorithm.hpp"
+#include "complex/Utilities/StreamCompaction.hpp"
 
-#include <limits>
-#include <unordered_map>
+#include <algorithm>
+#include <atomic>
+#include <utility>
 
 #include "fmt/format.h"
 
@@ -24,67 +28,13 @@ constexpr complex::int32 k_NoNodeTypesArray = -353;
 constexpr complex::int32 k_MissingVertexArray = -354;
 constexpr complex::int32 k_MissingTriangleArray = -355;
 
-template <class T>
-inline void hashCombine(usize& seed, const T& obj)
+/**
+ * @brief Returns true if the node type marks a vertex that lies on an internal surface.
+ */
+inline bool IsInternalNode(int8 nodeType)
 {
-  std::hash<T> hasher;
-  seed ^= hasher(obj) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+  return nodeType >= 2 && nodeType <= 4;
 }
-
-struct CopyDataFunctor
-{
-  template <typename T>
-  void operator()(IDataArray& inDataPtr, IDataArray& outDataPtr, std::unordered_map<int64, int64>& elementMap) const
-  {
-    auto& inputDataPtr = dynamic_cast<DataArray<T>&>(inDataPtr);
-    AbstractDataStore<T>& inputData = inputDataPtr.getDataStoreRef();
-    auto croppedDataPtr = dynamic_cast<DataArray<T>&>(outDataPtr);
-    AbstractDataStore<T>& outputData = croppedDataPtr.getDataStoreRef();
-
-    usize nTuples = outDataPtr.getNumberOfTuples();
-    usize nComps = inDataPtr.getNumberOfComponents();
-    usize tmpIndex = 0;
-    usize ptrIndex = 0;
-
-    for(usize i = 0; i < nTuples; i++)
-    {
-      for(usize d = 0; d < nComps; d++)
-      {
-        tmpIndex = nComps * i + d;
-        ptrIndex = nComps * elementMap[i] + d;
-        outputData[tmpIndex] = inputData[ptrIndex];
-      }
-    }
-  }
-};
-
-struct RemoveFlaggedVerticesFunctor
-{
-  // copy data to masked geometry
-  template <class T>
-  void operator()(IDataArray& inputDataPtr, IDataArray& outputDataArray, const std::vector<complex::AbstractGeometry::MeshIndexType>& indexMapping) const
-  {
-    auto& inputData = dynamic_cast<DataArray<T>&>(inputDataPtr);
-    auto& outputData = dynamic_cast<DataArray<T>&>(outputDataArray);
-    usize nComps = inputData.getNumberOfComponents();
-    complex::AbstractGeometry::MeshIndexType notSeen = std::numeric_limits<complex::AbstractGeometry::MeshIndexType>::max();
-
-    for(usize i = 0; i < indexMapping.size(); i++)
-    {
-      complex::AbstractGeometry::MeshIndexType newIndex = indexMapping[i];
-      if(newIndex != notSeen)
-      {
-        for(usize compIdx = 0; compIdx < nComps; compIdx++)
-        {
-          usize destinationIndex = newIndex * nComps + compIdx;
-          usize sourceIndex = i * nComps + compIdx;
-          outputData[destinationIndex] = inputData[sourceIndex];
-        }
-      }
-    }
-  }
-};
-
 } // namespace
 
 namespace complex
@@ -249,120 +199,88 @@ Result<> ExtractInternalSurfacesFromTriangleGeometry::executeImpl(DataStructure&
   auto internalFacesPath = internalTrianglesPath.createChildPath(CreateTriangleGeomAction::k_DefaultFacesName);
   internalTriangleGeom.setFaces(data.getDataAs<UInt64Array>(internalFacesPath));
 
-  // int64 progIncrement = numTris / 100;
-  // int64 prog = 1;
-  // int64 progressInt = 0;
-  // int64 counter = 0;
   using MeshIndexType = complex::AbstractGeometry::MeshIndexType;
-
-  const MeshIndexType notSeen = std::numeric_limits<MeshIndexType>::max();
-
-  std::vector<MeshIndexType> vertNewIndex(numVerts, notSeen);
-  std::vector<MeshIndexType> triNewIndex(numTris, notSeen);
-  MeshIndexType currentNewTriIndex = 0;
-  MeshIndexType currentNewVertIndex = 0;
-
-  // Loop over all of the triangles mapping the triangle and the vertices to the new array locations
-  for(MeshIndexType triIndex = 0; triIndex < numTris; triIndex++)
+  // Inputs whose data stores are not contiguous are copied into a buffer
+  const ContiguousValues<const MeshIndexType> triangleValues(std::as_const(triangles).getDataStoreRef());
+  const ContiguousValues<const int8> nodeTypeContiguousValues(std::as_const(nodeTypes).getDataStoreRef());
+  const nonstd::span<const MeshIndexType> triangleVerts = triangleValues.span();
+  const nonstd::span<const int8> nodeTypeValues = nodeTypeContiguousValues.span();
+
+  // A triangle is kept if all of its nodes are of type 2, 3 or 4
+  const std::vector<usize> keptTriangles = StreamCompaction::FindKeptIndices(numTris, [&](usize triIndex) {
+    return IsInternalNode(nodeTypeValues[triangleVerts[3 * triIndex + 0]]) && IsInternalNode(nodeTypeValues[triangleVerts[3 * triIndex + 1]]) &&
+           IsInternalNode(nodeTypeValues[triangleVerts[3 * triIndex + 2]]);
+  });
+  if(shouldCancel)
   {
+    return {};
+  }
 
-    MeshIndexType v0Index = triangles[3 * triIndex + 0];
-    MeshIndexType v1Index = triangles[3 * triIndex + 1];
-    MeshIndexType v2Index = triangles[3 * triIndex + 2];
-    // Check if the NodeType is either 2, 3, 4
-    if((nodeTypes[v0Index] >= 2 && nodeTypes[v0Index] <= 4) && (nodeTypes[v1Index] >= 2 && nodeTypes[v1Index] <= 4) && (nodeTypes[v2Index] >= 2 && nodeTypes[v2Index] <= 4))
+  // Flag the vertices used by the kept triangles. Several threads may flag the same vertex.
+  std::vector<std::atomic<bool>> vertexUsed(numVerts);
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, numVerts);
+  dataAlg.execute([&](const ComplexRange& range) {
+    for(usize vertIndex = range.min(); vertIndex < range.max(); vertIndex++)
     {
-      // All Nodes are the correct type
-      triNewIndex[triIndex] = currentNewTriIndex;
-      currentNewTriIndex++; // increment the index into which this triangle would be place in the new triangle array
-      // Now figure out if we have seen each vertex
-      if(vertNewIndex[v0Index] == notSeen)
-      {
-        vertNewIndex[v0Index] = currentNewVertIndex;
-        currentNewVertIndex++;
-      }
-      if(vertNewIndex[v1Index] == notSeen)
-      {
-        vertNewIndex[v1Index] = currentNewVertIndex;
-        currentNewVertIndex++;
-      }
-      if(vertNewIndex[v2Index] == notSeen)
-      {
-        vertNewIndex[v2Index] = currentNewVertIndex;
-        currentNewVertIndex++;
-      }
+      vertexUsed[vertIndex].store(false, std::memory_order_relaxed);
     }
-
-    if(shouldCancel)
+  });
+  dataAlg.setRange(0, keptTriangles.size());
+  dataAlg.execute([&](const ComplexRange& range) {
+    for(usize i = range.min(); i < range.max(); i++)
     {
-      return {};
+      for(usize corner = 0; corner < 3; corner++)
+      {
+        vertexUsed[triangleVerts[3 * keptTriangles[i] + corner]].store(true, std::memory_order_relaxed);
+      }
     }
-  }
-
-  // Resize the vertex and triangle arrays
-  internalTriangleGeom.resizeVertexList(currentNewVertIndex);
-  internalTriangleGeom.resizeFaceList(currentNewTriIndex);
-
-  complex::AbstractGeometry::SharedVertexList* internalVerts = internalTriangleGeom.getVertices();
-  complex::AbstractGeometry::SharedFaceList* internalTriangles = internalTriangleGeom.getFaces();
-
-  // Transfer the data from the old SharedVertexList to the new VertexList
-  for(MeshIndexType vertIndex = 0; vertIndex < numVerts; vertIndex++)
+  });
+  // The kept vertices keep their relative order
+  const std::vector<usize> keptVertices = StreamCompaction::FindKeptIndices(numVerts, [&](usize vertIndex) { return vertexUsed[vertIndex].load(std::memory_order_relaxed); });
+  const std::vector<usize> vertNewIndex = StreamCompaction::CreateIndexMap(keptVertices, numVerts);
+  if(shouldCancel)
   {
-    MeshIndexType mappedIndex = vertNewIndex[vertIndex];
-    if(mappedIndex != notSeen)
-    {
-      // Get the actual XYZ coordinate
-      float x = vertices[vertIndex * 3 + 0];
-      float y = vertices[vertIndex * 3 + 1];
-      float z = vertices[vertIndex * 3 + 2];
-
-      (*internalVerts)[mappedIndex * 3 + 0] = x;
-      (*internalVerts)[mappedIndex * 3 + 1] = y;
-      (*internalVerts)[mappedIndex * 3 + 2] = z;
-    }
+    return {};
   }
 
-  // Transfer the data from the old SharedTriangleList to the new TriangleList
-  for(MeshIndexType triIndex = 0; triIndex < numTris; triIndex++)
-  {
-    MeshIndexType mappedIndex = triNewIndex[triIndex];
-    if(mappedIndex != notSeen)
+  // Resize the vertex and triangle arrays
+  internalTriangleGeom.resizeVertexList(keptVertices.size());
+  internalTriangleGeom.resizeFaceList(keptTriangles.size());
+
+  // Transfer the XYZ coordinates of the kept vertices
+  StreamCompaction::CopyKeptTuples(vertices, *internalTriangleGeom.getVertices(), keptVertices);
+
+  // Transfer the kept triangles, renumbering their vertices
+  ContiguousValues<MeshIndexType> internalTriangleValues(internalTriangleGeom.getFaces()->getDataStoreRef());
+  const nonstd::span<MeshIndexType> internalTriangleVerts = internalTriangleValues.span();
+  dataAlg.setRange(0, keptTriangles.size());
+  dataAlg.execute([&](const ComplexRange& range) {
+    for(usize i = range.min(); i < range.max(); i++)
     {
-      // Get the 3 original vertex indices for this triangle
-      MeshIndexType v0 = triangles[triIndex * 3 + 0];
-      MeshIndexType v1 = triangles[triIndex * 3 + 1];
-      MeshIndexType v2 = triangles[triIndex * 3 + 2];
-
-      MeshIndexType v0New = vertNewIndex[v0];
-      MeshIndexType v1New = vertNewIndex[v1];
-      MeshIndexType v2New = vertNewIndex[v2];
-
-      (*internalTriangles)[mappedIndex * 3 + 0] = v0New;
-      (*internalTriangles)[mappedIndex * 3 + 1] = v1New;
-      (*internalTriangles)[mappedIndex * 3 + 2] = v2New;
+      for(usize corner = 0; corner < 3; corner++)
+      {
+        internalTriangleVerts[3 * i + corner] = static_cast<MeshIndexType>(vertNewIndex[triangleVerts[3 * keptTriangles[i] + corner]]);
+      }
     }
-  }
+  });
+  internalTriangleValues.commit();
 
   // Copy any Vertex and Triangle DataArrays to extracted surface mesh
   for(const auto& targetArrayPath : copyVertexPaths)
   {
     DataPath destinationPath = internalTrianglesPath.createChildPath("VertexData").createChildPath(targetArrayPath.getTargetName());
-    auto& src = data.getDataRefAs<IDataArray>(targetArrayPath);
+    const auto& src = data.getDataRefAs<IDataArray>(targetArrayPath);
     auto& dest = data.getDataRefAs<IDataArray>(destinationPath);
-    dest.getIDataStore()->reshapeTuples({currentNewVertIndex});
-
-    ExecuteDataFunction(RemoveFlaggedVerticesFunctor{}, src.getDataType(), src, dest, vertNewIndex);
+    StreamCompaction::CopyKeptTuples(src, dest, keptVertices);
   }
 
   for(const auto& targetArrayPath : copyTrianglePaths)
   {
     DataPath destinationPath = internalTrianglesPath.createChildPath("FaceData").createChildPath(targetArrayPath.getTargetName());
-    auto& src = data.getDataRefAs<IDataArray>(targetArrayPath);
+    const auto& src = data.getDataRefAs<IDataArray>(targetArrayPath);
     auto& dest = data.getDataRefAs<IDataArray>(destinationPath);
-    dest.getIDataStore()->reshapeTuples({currentNewTriIndex});
-
-    ExecuteDataFunction(RemoveFlaggedVerticesFunctor{}, src.getDataType(), src, dest, triNewIndex);
+    StreamCompaction::CopyKeptTuples(src, dest, keptTriangles);
   }
 
   return {};
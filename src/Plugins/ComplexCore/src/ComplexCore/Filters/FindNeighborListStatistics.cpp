@@ -83,11 +83,15 @@ public:
       throw std::invalid_argument("FindNeighborListStatistics::compute() could not dynamic_cast 'Summation' array to needed type. Check input array selection.");
     }
 
-    NeighborListType& sourceList = dynamic_cast<NeighborListType&>(m_Source);
+    const NeighborListType& sourceList = dynamic_cast<const NeighborListType&>(m_Source);
 
+    // Each list is copied into a reused buffer so that lists held in flat
+    // storage are read in place instead of being expanded into separate vectors
+    std::vector<T> tmpList;
     for(usize i = start; i < end; i++)
     {
-      std::vector<T>& tmpList = sourceList[i];
+      auto list = sourceList.getListSpan(i);
+      tmpList.assign(list.begin(), list.end());
 
       if(m_Length)
       {
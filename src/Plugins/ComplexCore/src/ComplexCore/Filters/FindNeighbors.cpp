@@ -1,7 +1,13 @@
 #include "FindNeighbors.hpp"
 
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+#include <optional>
 #include <sstream>
+#include <utility>
 
+#include "complex/DataStructure/ContiguousValues.hpp"
 #include "complex/DataStructure/DataArray.hpp"
 #include "complex/DataStructure/DataGroup.hpp"
 #include "complex/DataStructure/Geometry/ImageGeom.hpp"
@@ -13,9 +19,190 @@
 #include "complex/Parameters/BoolParameter.hpp"
 #include "complex/Parameters/DataGroupSelectionParameter.hpp"
 #include "complex/Parameters/GeometrySelectionParameter.hpp"
+#include "complex/Utilities/ParallelData3DAlgorithm.hpp"
 
 namespace complex
 {
+namespace
+{
+/**
+ * @brief Number of faces shared by a pair of features. The pair is packed into
+ * a single key with the feature in the upper 32 bits and the neighbor in the
+ * lower 32 bits so that sorting orders it by feature and then by neighbor.
+ */
+using FaceCount = std::pair<uint64, int32>;
+
+uint64 PackFeaturePair(int32 feature, int32 neighbor)
+{
+  return (static_cast<uint64>(feature) << 32) | static_cast<uint64>(static_cast<uint32>(neighbor));
+}
+
+/**
+ * @brief Combines the counts of identical feature pairs in a sorted list of face counts.
+ * @param sortedCounts
+ * @return std::vector<FaceCount>
+ */
+std::vector<FaceCount> MergeFaceCounts(const std::vector<FaceCount>& sortedCounts)
+{
+  std::vector<FaceCount> mergedCounts;
+  for(const auto& faceCount : sortedCounts)
+  {
+    if(!mergedCounts.empty() && mergedCounts.back().first == faceCount.first)
+    {
+      mergedCounts.back().second += faceCount.second;
+    }
+    else
+    {
+      mergedCounts.push_back(faceCount);
+    }
+  }
+  return mergedCounts;
+}
+
+/**
+ * @brief The results gathered by all of the FindNeighborsImpl tasks. Only
+ * accessed while holding the mutex.
+ */
+struct FindNeighborsResults
+{
+  std::vector<FaceCount> faceCounts;
+  std::vector<int32> surfaceFeatureIds;
+  usize planesCompleted = 0;
+  std::chrono::steady_clock::time_point lastUpdate = std::chrono::steady_clock::now();
+  std::mutex mutex;
+};
+
+/**
+ * @brief Finds the faces shared between features and the surface features
+ * within a range of Z planes. The results are gathered in task local containers
+ * and appended to the shared results once the range is complete.
+ */
+class FindNeighborsImpl
+{
+public:
+  FindNeighborsImpl(nonstd::span<const int32> featureIds, nonstd::span<int8> boundaryCells, const SizeVec3& dims, bool storeSurfaceFeatures, FindNeighborsResults& results,
+                    const IFilter::MessageHandler& messageHandler, const std::atomic_bool& shouldCancel)
+  : m_FeatureIds(featureIds)
+  , m_BoundaryCells(boundaryCells)
+  , m_Dims(dims)
+  , m_StoreSurfaceFeatures(storeSurfaceFeatures)
+  , m_Results(results)
+  , m_MessageHandler(messageHandler)
+  , m_ShouldCancel(shouldCancel)
+  {
+  }
+
+  void operator()(const ComplexRange3D& range) const
+  {
+    const auto numX = static_cast<int64>(m_Dims[0]);
+    const auto numY = static_cast<int64>(m_Dims[1]);
+    const auto numZ = static_cast<int64>(m_Dims[2]);
+    const std::array<int64, 6> neighPoints = {-numX * numY, -numX, -1, 1, numX, numX * numY};
+
+    std::vector<uint64> featurePairs;
+    std::vector<int32> surfaceFeatureIds;
+
+    for(usize z = range[4]; z < range[5]; z++)
+    {
+      if(m_ShouldCancel)
+      {
+        return;
+      }
+      const auto plane = static_cast<int64>(z);
+      for(usize y = range[2]; y < range[3]; y++)
+      {
+        const auto row = static_cast<int64>(y);
+        for(usize x = range[0]; x < range[1]; x++)
+        {
+          const auto column = static_cast<int64>(x);
+          const int64 voxelIndex = (plane * numY + row) * numX + column;
+          const int32 feature = m_FeatureIds[voxelIndex];
+          int8 onsurf = 0;
+          if(feature > 0)
+          {
+            if(m_StoreSurfaceFeatures)
+            {
+              bool onXYBoundary = column == 0 || column == numX - 1 || row == 0 || row == numY - 1;
+              if(onXYBoundary || (numZ != 1 && (plane == 0 || plane == numZ - 1)))
+              {
+                surfaceFeatureIds.push_back(feature);
+              }
+            }
+            for(usize k = 0; k < 6; k++)
+            {
+              if((k == 0 && plane == 0) || (k == 5 && plane == numZ - 1) || (k == 1 && row == 0) || (k == 4 && row == numY - 1) || (k == 2 && column == 0) ||
+                 (k == 3 && column == numX - 1))
+              {
+                continue;
+              }
+              const int32 neighborFeature = m_FeatureIds[voxelIndex + neighPoints[k]];
+              if(neighborFeature != feature && neighborFeature > 0)
+              {
+                onsurf++;
+                featurePairs.push_back(PackFeaturePair(feature, neighborFeature));
+              }
+            }
+          }
+          if(!m_BoundaryCells.empty())
+          {
+            m_BoundaryCells[voxelIndex] = onsurf;
+          }
+        }
+      }
+    }
+
+    // Reduce the local results before taking the lock
+    std::sort(featurePairs.begin(), featurePairs.end());
+    std::vector<FaceCount> faceCounts;
+    for(uint64 featurePair : featurePairs)
+    {
+      if(!faceCounts.empty() && faceCounts.back().first == featurePair)
+      {
+        faceCounts.back().second++;
+      }
+      else
+      {
+        faceCounts.emplace_back(featurePair, 1);
+      }
+    }
+    std::sort(surfaceFeatureIds.begin(), surfaceFeatureIds.end());
+    surfaceFeatureIds.erase(std::unique(surfaceFeatureIds.begin(), surfaceFeatureIds.end()), surfaceFeatureIds.end());
+
+    std::lock_guard<std::mutex> lock(m_Results.mutex);
+    m_Results.faceCounts.insert(m_Results.faceCounts.end(), faceCounts.cbegin(), faceCounts.cend());
+    m_Results.surfaceFeatureIds.insert(m_Results.surfaceFeatureIds.end(), surfaceFeatureIds.cbegin(), surfaceFeatureIds.cend());
+    sendProgress(range[5] - range[4]);
+  }
+
+private:
+  nonstd::span<const int32> m_FeatureIds;
+  nonstd::span<int8> m_BoundaryCells;
+  SizeVec3 m_Dims;
+  bool m_StoreSurfaceFeatures = false;
+  FindNeighborsResults& m_Results;
+  const IFilter::MessageHandler& m_MessageHandler;
+  const std::atomic_bool& m_ShouldCancel;
+
+  /**
+   * @brief Reports the number of completed planes. Only called while the mutex is held.
+   * @param numPlanes
+   */
+  void sendProgress(usize numPlanes) const
+  {
+    m_Results.planesCompleted += numPlanes;
+    auto now = std::chrono::steady_clock::now();
+    // Only send updates every 1 second
+    if(std::chrono::duration_cast<std::chrono::milliseconds>(now - m_Results.lastUpdate).count() > 1000)
+    {
+      auto progInt = static_cast<float>(m_Results.planesCompleted) / static_cast<float>(m_Dims[2]) * 100.0f;
+      std::string message = fmt::format("Determining Neighbor Lists || {:2.0f}% Complete", progInt);
+      m_MessageHandler(IFilter::ProgressMessage{IFilter::Message::Type::Info, message, static_cast<int32>(progInt)});
+      m_Results.lastUpdate = now;
+    }
+  }
+};
+} // namespace
+
 std::string FindNeighbors::name() const
 {
   return FilterTraits<FindNeighbors>::name;
@@ -166,17 +353,32 @@ Result<> FindNeighbors::executeImpl(DataStructure& data, const Arguments& args,
   auto& neighborList = data.getDataRefAs<Int32NeighborListType>(neighborListPath);
   auto& sharedSurfaceAreaList = data.getDataRefAs<FloatNeighborListType>(sharedSurfaceAreaPath);
 
-  auto* boundaryCellsArray = data.getDataAs<Int32Array>(boundaryCellsPath);
-  auto* surfaceFeaturesArray = data.getDataAs<Int32Array>(surfaceFeaturesPath);
+  auto* boundaryCellsArray = data.getDataAs<Int8Array>(boundaryCellsPath);
+  auto* surfaceFeaturesArray = data.getDataAs<BoolArray>(surfaceFeaturesPath);
 
-  auto& featureIds = featureIdsArray.getDataStoreRef();
-  auto& numNeighbors = numNeighborsArray.getDataStoreRef();
+  // Spans are used in the loops below so that each voxel access does not go through a virtual call.
+  // The values of data stores that are not contiguous are copied and the outputs copied back.
+  const ContiguousValues<const int32> featureIdValues(std::as_const(featureIdsArray).getDataStoreRef());
+  ContiguousValues<int32> numNeighborValues(numNeighborsArray.getDataStoreRef());
+  std::optional<ContiguousValues<int8>> boundaryCellValues;
+  std::optional<ContiguousValues<bool>> surfaceFeatureValues;
+  if(storeBoundaryCells)
+  {
+    boundaryCellValues.emplace(boundaryCellsArray->getDataStoreRef());
+  }
+  if(storeSurfaceFeatures)
+  {
+    surfaceFeatureValues.emplace(surfaceFeaturesArray->getDataStoreRef());
+  }
+  const auto featureIds = featureIdValues.span();
+  auto numNeighbors = numNeighborValues.span();
+  auto boundaryCells = storeBoundaryCells ? boundaryCellValues->span() : nonstd::span<int8>{};
+  auto surfaceFeatures = storeSurfaceFeatures ? surfaceFeatureValues->span() : nonstd::span<bool>{};
 
-  usize totalPoints = featureIdsArray.getNumberOfTuples();
   usize totalFeatures = numNeighborsArray.getNumberOfTuples();
 
   /* Ensure that we will be able to work with the user selected featureId Array */
-  const auto [minFeatureId, maxFeatureId] = std::minmax_element(featureIdsArray.begin(), featureIdsArray.end());
+  const auto [minFeatureId, maxFeatureId] = std::minmax_element(featureIds.begin(), featureIds.end());
   if(static_cast<usize>(*maxFeatureId) >= totalFeatures)
   {
     std::stringstream out;
@@ -188,209 +390,85 @@ Result<> FindNeighbors::executeImpl(DataStructure& data, const Arguments& args,
 
   auto& imageGeom = data.getDataRefAs<ImageGeom>(imageGeomPath);
   SizeVec3 udims = imageGeom.getDimensions();
-  const auto imageGeomNumX = imageGeom.getNumXPoints();
-  const auto imageGeomNumY = imageGeom.getNumYPoints();
-  const auto imageGeomNumZ = imageGeom.getNumZPoints();
-
-  std::array<int64, 3> dims = {
-      static_cast<int64>(udims[0]),
-      static_cast<int64>(udims[1]),
-      static_cast<int64>(udims[2]),
-  };
-
-  std::array<int64, 6> neighPoints = {-dims[0] * dims[1], -dims[0], -1, 1, dims[0], dims[0] * dims[1]};
-
-  int64 column = 0;
-  int64 row = 0;
-  int64 plane = 0;
-  int32 feature = 0;
-  int32 nnum = 0;
-  uint8 onsurf = 0;
-  bool good = false;
-  int64 neighbor = 0;
-
-  std::vector<std::vector<int32>> neighborlist(totalFeatures);
-  std::vector<std::vector<float>> neighborsurfacearealist(totalFeatures);
-
-  int32 nListSize = 100;
-
-  float progInt = 0.0F;
-  auto start = std::chrono::steady_clock::now();
-  // Initialize the neighbor lists
+
   for(usize i = 1; i < totalFeatures; i++)
   {
-    auto now = std::chrono::steady_clock::now();
-    // Only send updates every 1 second
-    if(std::chrono::duration_cast<std::chrono::milliseconds>(now - start).count() > 1000)
-    {
-      progInt = static_cast<float>(i) / static_cast<float>(totalFeatures) * 100.0f;
-      std::string message = fmt::format("Initializing Neighbor Lists || {:2.0f}% Complete", progInt);
-      messageHandler(complex::IFilter::ProgressMessage{complex::IFilter::Message::Type::Info, message, static_cast<int32_t>(progInt)});
-      start = std::chrono::steady_clock::now();
-    }
-
-    if(shouldCancel)
-    {
-      return {};
-    }
-
     numNeighbors[i] = 0;
-    neighborlist[i].resize(nListSize);
-    neighborsurfacearealist[i].assign(nListSize, -1.0f);
     if(storeSurfaceFeatures)
     {
-      auto& surfaceFeatures = surfaceFeaturesArray->getDataStoreRef();
-      surfaceFeatures[i] = 0;
+      surfaceFeatures[i] = false;
     }
   }
 
-  progInt = 0.0F;
-  start = std::chrono::steady_clock::now();
-  // Loop over all points to generate the neighbor lists
-  for(usize j = 0; j < totalPoints; j++)
-  {
-    auto now = std::chrono::steady_clock::now();
-    // Only send updates every 1 second
-    if(std::chrono::duration_cast<std::chrono::milliseconds>(now - start).count() > 1000)
-    {
-      progInt = static_cast<float>(j) / static_cast<float>(totalPoints) * 100.0f;
-      std::string message = fmt::format("Determining Neighbor Lists || {:2.0f}% Complete", progInt);
-      messageHandler(complex::IFilter::ProgressMessage{complex::IFilter::Message::Type::Info, message, static_cast<int32_t>(progInt)});
-      start = std::chrono::steady_clock::now();
-    }
+  messageHandler(IFilter::Message::Type::Info, "Determining Neighbor Lists");
 
-    if(shouldCancel)
-    {
-      return {};
-    }
+  // Each task counts the faces it finds between features on its own and the
+  // counts are merged below, so the result does not depend on the partitioning.
+  FindNeighborsResults results;
 
-    onsurf = 0;
-    feature = featureIds[j];
-    if(feature > 0 && feature < neighborlist.size())
-    {
-      column = static_cast<int64>(j % imageGeomNumX);
-      row = static_cast<int64>((j / imageGeomNumX) % imageGeomNumY);
-      plane = static_cast<int64>(j / (imageGeomNumX * imageGeomNumY));
-      if(storeSurfaceFeatures)
-      {
-        auto& surfaceFeatures = surfaceFeaturesArray->getDataStoreRef();
+  // Whole XY planes keep each task reading contiguous Feature Ids
+  ParallelData3DAlgorithm dataAlg;
+  dataAlg.setRange(udims[0], udims[1], udims[2]);
+  dataAlg.setSplitIntoZSlabs(true);
+  dataAlg.execute(FindNeighborsImpl(featureIds, boundaryCells, udims, storeSurfaceFeatures, results, messageHandler, shouldCancel));
 
-        if((column == 0 || column == static_cast<int64>((imageGeomNumX - 1)) || row == 0 || row == static_cast<int64>((imageGeomNumY)-1) || plane == 0 ||
-            plane == static_cast<int64>((imageGeomNumZ - 1))) &&
-           imageGeomNumZ != 1)
-        {
-          surfaceFeatures[feature] = 1;
-        }
-        if((column == 0 || column == static_cast<int64>((imageGeomNumX - 1)) || row == 0 || row == static_cast<int64>((imageGeomNumY - 1))) && imageGeomNumZ == 1)
-        {
-          surfaceFeatures[feature] = 1;
-        }
-      }
-      for(size_t k = 0; k < 6; k++)
-      {
-        good = true;
-        neighbor = static_cast<int64>(j + neighPoints[k]);
-        if(k == 0 && plane == 0)
-        {
-          good = false;
-        }
-        if(k == 5 && plane == (imageGeomNumZ - 1))
-        {
-          good = false;
-        }
-        if(k == 1 && row == 0)
-        {
-          good = false;
-        }
-        if(k == 4 && row == (imageGeomNumY - 1))
-        {
-          good = false;
-        }
-        if(k == 2 && column == 0)
-        {
-          good = false;
-        }
-        if(k == 3 && column == (imageGeomNumX - 1))
-        {
-          good = false;
-        }
-        if(good && featureIds[neighbor] != feature && featureIds[neighbor] > 0)
-        {
-          onsurf++;
-          nnum = numNeighbors[feature];
-          neighborlist[feature].push_back(featureIds[neighbor]);
-          nnum++;
-          numNeighbors[feature] = nnum;
-        }
-      }
-    }
-    if(storeBoundaryCells)
-    {
-      auto& boundaryCells = boundaryCellsArray->getDataStoreRef();
-      boundaryCells[j] = static_cast<int32>(onsurf);
-    }
+  if(shouldCancel)
+  {
+    return {};
   }
 
-  FloatVec3 spacing = imageGeom.getSpacing();
-
-  progInt = 0;
-  start = std::chrono::steady_clock::now();
-  // We do this to create new set of NeighborList objects
-  for(usize i = 1; i < totalFeatures; i++)
+  if(storeSurfaceFeatures)
   {
-    auto now = std::chrono::steady_clock::now();
-    // Only send updates every 1 second
-    if(std::chrono::duration_cast<std::chrono::milliseconds>(now - start).count() > 1000)
-    {
-      progInt = static_cast<float>(i) / static_cast<float>(totalFeatures) * 100.0f;
-      std::string message = fmt::format("Calculating Surface Areas || {:2.0f}% Complete", progInt);
-      messageHandler(complex::IFilter::ProgressMessage{complex::IFilter::Message::Type::Info, message, static_cast<int32>(progInt)});
-      start = std::chrono::steady_clock::now();
-    }
-    if(shouldCancel)
+    for(int32 feature : results.surfaceFeatureIds)
     {
-      return {};
+      surfaceFeatures[feature] = true;
     }
+  }
 
-    std::map<int32, int32> neighToCount;
-    auto numneighs = static_cast<int32>(neighborlist[i].size());
+  // Faces between the same pair of features may have been counted by more than one task
+  std::sort(results.faceCounts.begin(), results.faceCounts.end());
+  const std::vector<FaceCount> faceCounts = MergeFaceCounts(results.faceCounts);
 
-    // this increments the voxel counts for each feature
-    for(int32 j = 0; j < numneighs; j++)
-    {
-      neighToCount[neighborlist[i][j]]++;
-    }
+  messageHandler(IFilter::Message::Type::Info, "Calculating Surface Areas");
 
-    std::map<int32, int32>::iterator neighborIter = neighToCount.find(0);
-    neighToCount.erase(neighborIter);
-    neighborIter = neighToCount.find(-1);
-    if(neighborIter != neighToCount.end())
-    {
-      neighToCount.erase(neighborIter);
-    }
-    // Resize the features neighbor list to zero
-    neighborlist[i].resize(0);
-    neighborsurfacearealist[i].resize(0);
+  // The merged counts are sorted by feature and then by neighbor, which is the
+  // order the lists are stored in. Feature 0 has no neighbors.
+  NeighborList<int32>::Builder neighborListBuilder(totalFeatures);
+  NeighborList<float32>::Builder surfaceAreaListBuilder(totalFeatures);
+  for(const auto& faceCount : faceCounts)
+  {
+    neighborListBuilder.addToListSize(faceCount.first >> 32);
+    surfaceAreaListBuilder.addToListSize(faceCount.first >> 32);
+  }
+  neighborListBuilder.allocate();
+  surfaceAreaListBuilder.allocate();
 
-    for(const auto [neigh, number] : neighToCount)
+  FloatVec3 spacing = imageGeom.getSpacing();
+  usize index = 0;
+  for(usize i = 1; i < totalFeatures; i++)
+  {
+    auto neighbors = neighborListBuilder.getList(i);
+    auto surfaceAreas = surfaceAreaListBuilder.getList(i);
+    for(usize j = 0; j < neighbors.size(); j++, index++)
     {
-      float area = static_cast<float>(number) * spacing[0] * spacing[1];
-
-      // Push the neighbor feature id back onto the list, so we stay synced up
-      neighborlist[i].push_back(neigh);
-      neighborsurfacearealist[i].push_back(area);
+      neighbors[j] = static_cast<int32>(faceCounts[index].first & 0xFFFFFFFF);
+      surfaceAreas[j] = static_cast<float32>(faceCounts[index].second) * spacing[0] * spacing[1];
     }
-    numNeighbors[i] = static_cast<int32>(neighborlist[i].size());
-
-    // Set the vector for each list into the NeighborList Object
-    NeighborList<int32>::SharedVectorType sharedNeiLst(new std::vector<int32>);
-    sharedNeiLst->assign(neighborlist[i].begin(), neighborlist[i].end());
-    neighborList.setList(static_cast<int32>(i), sharedNeiLst);
+    numNeighbors[i] = static_cast<int32>(neighbors.size());
+  }
 
-    NeighborList<float32>::SharedVectorType sharedSAL(new std::vector<float32>);
-    sharedSAL->assign(neighborsurfacearealist[i].begin(), neighborsurfacearealist[i].end());
-    sharedSurfaceAreaList.setList(static_cast<int32>(i), sharedSAL);
+  numNeighborValues.commit();
+  if(storeBoundaryCells)
+  {
+    boundaryCellValues->commit();
   }
+  if(storeSurfaceFeatures)
+  {
+    surfaceFeatureValues->commit();
+  }
+
+  neighborList.setFlatStorage(neighborListBuilder.build());
+  sharedSurfaceAreaList.setFlatStorage(surfaceAreaListBuilder.build());
 
   return {};
 }
@@ -1,16 +1,22 @@
 #include "IdentifySample.hpp"
 
+#include "complex/DataStructure/ContiguousValues.hpp"
 #include "complex/DataStructure/DataArray.hpp"
 #include "complex/DataStructure/Geometry/ImageGeom.hpp"
 #include "complex/Parameters/ArraySelectionParameter.hpp"
 #include "complex/Parameters/BoolParameter.hpp"
 #include "complex/Parameters/GeometrySelectionParameter.hpp"
+#include "complex/Utilities/ConnectedComponents.hpp"
+#include "complex/Utilities/ParallelDataAlgorithm.hpp"
 
 namespace complex
 {
 namespace
 {
 constexpr int64 k_MISSING_GEOM_ERR = -650;
+constexpr int64 k_MASK_COMPONENTS_ERR = -12002;
+constexpr int64 k_MASK_TUPLES_ERR = -12003;
+constexpr int64 k_LABELING_ERR = -12004;
 
 template <typename T>
 void _execute(DataStructure& data, const DataPath& imageGeomPath, const DataPath& goodVoxelsArrayPath, bool fillHoles)
@@ -19,209 +25,60 @@ void _execute(DataStructure& data, const DataPath& imageGeomPath, const DataPath
 
   auto* imageGeom = data.getDataAs<ImageGeom>(imageGeomPath);
 
-  std::vector<usize> cDims = {1};
   auto* goodVoxelsPtr = data.getDataAs<ArrayType>(goodVoxelsArrayPath);
-  auto& goodVoxels = goodVoxelsPtr->getDataStoreRef();
-
-  int64 totalPoints = static_cast<int64>(goodVoxelsPtr->getNumberOfTuples());
-
-  SizeVec3 udims = imageGeom->getDimensions();
-
-  int64 dims[3] = {
-      static_cast<int64>(udims[0]),
-      static_cast<int64>(udims[1]),
-      static_cast<int64>(udims[2]),
-  };
-
-  int64 neighpoints[6] = {0, 0, 0, 0, 0, 0};
-  int64 xp = dims[0];
-  int64 yp = dims[1];
-  int64 zp = dims[2];
-
-  neighpoints[0] = -(xp * yp);
-  neighpoints[1] = -xp;
-  neighpoints[2] = -1;
-  neighpoints[3] = 1;
-  neighpoints[4] = xp;
-  neighpoints[5] = (xp * yp);
-  std::vector<int64> currentvlist;
-  std::vector<bool> checked(totalPoints, false);
-  std::vector<bool> sample(totalPoints, false);
-  int64 biggestBlock = 0;
-  usize count = 0;
-  int32 good = 0;
-  int64 neighbor = 0;
-  int64 column = 0, row = 0, plane = 0;
-  int64 index = 0;
-
-  // In this loop over the data we are finding the biggest contiguous set of GoodVoxels and calling that the 'sample'  All GoodVoxels that do not touch the 'sample'
-  // are flipped to be called 'bad' voxels or 'not sample'
-  float threshold = 0.0f;
-  for(int64 i = 0; i < totalPoints; i++)
+  const usize totalPoints = goodVoxelsPtr->getNumberOfTuples();
+  // Index the mask through a span so the passes below avoid a virtual call per voxel. A mask
+  // whose data store is not contiguous is copied and the result copied back at the end.
+  ContiguousValues<T> goodVoxelValues(goodVoxelsPtr->getDataStoreRef());
+  nonstd::span<T> goodVoxels = goodVoxelValues.span().first(totalPoints);
+
+  const SizeVec3 dims = imageGeom->getDimensions();
+  std::vector<int32> labels(totalPoints, 0);
+
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, totalPoints);
+
+  // Find the biggest contiguous set of GoodVoxels and call that the 'sample'. All GoodVoxels that do not touch the 'sample'
+  // are flipped to be called 'bad' voxels or 'not sample'. Ties go to the last set in scan order.
+  std::vector<usize> sizes = ConnectedComponents::Label(dims, nonstd::span<const T>(goodVoxels), true, ConnectedComponents::Connectivity::Face, labels);
+  int32 sampleLabel = 0;
+  usize biggestBlock = 0;
+  for(usize label = 1; label < sizes.size(); label++)
   {
-    float percentIncrement = static_cast<float>(i) / static_cast<float>(totalPoints) * 100.0f;
-    if(percentIncrement > threshold)
+    if(sizes[label] >= biggestBlock)
     {
-      // std::string ss = fmt::format("{}% Scanned", static_cast<int32>(percentIncrement));
-      // filter->notifyStatusMessage(ss);
-      threshold = threshold + 5.0f;
-      if(threshold < percentIncrement)
-      {
-        threshold = percentIncrement;
-      }
+      biggestBlock = sizes[label];
+      sampleLabel = static_cast<int32>(label);
     }
-
-    if(!checked[i] && goodVoxels.getValue(i))
+  }
+  dataAlg.execute([&](const ComplexRange& range) {
+    for(usize i = range.min(); i < range.max(); i++)
     {
-      currentvlist.push_back(i);
-      count = 0;
-      while(count < currentvlist.size())
+      if(labels[i] != 0 && labels[i] != sampleLabel)
       {
-        index = currentvlist[count];
-        column = index % xp;
-        row = (index / xp) % yp;
-        plane = index / (xp * yp);
-        for(int32 j = 0; j < 6; j++)
-        {
-          good = 1;
-          neighbor = index + neighpoints[j];
-          if(j == 0 && plane == 0)
-          {
-            good = 0;
-          }
-          if(j == 5 && plane == (zp - 1))
-          {
-            good = 0;
-          }
-          if(j == 1 && row == 0)
-          {
-            good = 0;
-          }
-          if(j == 4 && row == (yp - 1))
-          {
-            good = 0;
-          }
-          if(j == 2 && column == 0)
-          {
-            good = 0;
-          }
-          if(j == 3 && column == (xp - 1))
-          {
-            good = 0;
-          }
-          if(good == 1 && !checked[neighbor] && goodVoxels.getValue(neighbor))
-          {
-            currentvlist.push_back(neighbor);
-            checked[neighbor] = true;
-          }
-        }
-        count++;
-      }
-      if(static_cast<int64>(currentvlist.size()) >= biggestBlock)
-      {
-        biggestBlock = currentvlist.size();
-        sample.assign(totalPoints, false);
-        for(int64 j = 0; j < biggestBlock; j++)
-        {
-          sample[currentvlist[j]] = true;
-        }
+        goodVoxels[i] = false;
       }
-      currentvlist.clear();
     }
-  }
-  for(int64 i = 0; i < totalPoints; i++)
-  {
-    if(!sample[i] && goodVoxels.getValue(i))
-    {
-      goodVoxels.setValue(i, false);
-    }
-  }
-  sample.clear();
-  checked.assign(totalPoints, false);
+  });
 
-  // In this loop we are going to 'close' all of the 'holes' inside of the region already identified as the 'sample' if the user chose to do so.
+  // 'Close' all of the 'holes' inside of the region already identified as the 'sample' if the user chose to do so.
   // This is done by flipping all 'bad' voxel features that do not touch the outside of the sample (i.e. they are fully contained inside of the 'sample'.
-  threshold = 0.0F;
   if(fillHoles)
   {
-    bool touchesBoundary = false;
-    for(int64 i = 0; i < totalPoints; i++)
-    {
-      float percentIncrement = static_cast<float>(i) / static_cast<float>(totalPoints) * 100.0f;
-      if(percentIncrement > threshold)
-      {
-        // std::string ss = fmt::format("{}% Filling Holes", static_cast<int32>(percentIncrement));
-        // filter->notifyStatusMessage(ss);
-        threshold = threshold + 5.0f;
-        if(threshold < percentIncrement)
-        {
-          threshold = percentIncrement;
-        }
-      }
-
-      if(!checked[i] && !goodVoxels.getValue(i))
+    sizes = ConnectedComponents::Label(dims, nonstd::span<const T>(goodVoxels), false, ConnectedComponents::Connectivity::Face, labels);
+    const std::vector<bool> touchesBoundary = ConnectedComponents::FindBoundaryLabels(dims, labels, sizes.size());
+    dataAlg.execute([&](const ComplexRange& range) {
+      for(usize i = range.min(); i < range.max(); i++)
       {
-        currentvlist.push_back(i);
-        count = 0;
-        touchesBoundary = false;
-        while(count < currentvlist.size())
-        {
-          index = currentvlist[count];
-          column = index % xp;
-          row = (index / xp) % yp;
-          plane = index / (xp * yp);
-          if(column == 0 || column == (xp - 1) || row == 0 || row == (yp - 1) || plane == 0 || plane == (zp - 1))
-          {
-            touchesBoundary = true;
-          }
-          for(int32 j = 0; j < 6; j++)
-          {
-            good = 1;
-            neighbor = index + neighpoints[j];
-            if(j == 0 && plane == 0)
-            {
-              good = 0;
-            }
-            if(j == 5 && plane == (zp - 1))
-            {
-              good = 0;
-            }
-            if(j == 1 && row == 0)
-            {
-              good = 0;
-            }
-            if(j == 4 && row == (yp - 1))
-            {
-              good = 0;
-            }
-            if(j == 2 && column == 0)
-            {
-              good = 0;
-            }
-            if(j == 3 && column == (xp - 1))
-            {
-              good = 0;
-            }
-            if(good == 1 && !checked[neighbor] && !goodVoxels.getValue(neighbor))
-            {
-              currentvlist.push_back(neighbor);
-              checked[neighbor] = true;
-            }
-          }
-          count++;
-        }
-        if(!touchesBoundary)
+        if(labels[i] != 0 && !touchesBoundary[labels[i]])
         {
-          for(usize j = 0; j < currentvlist.size(); j++)
-          {
-            goodVoxels.setValue(currentvlist[j], true);
-          }
+          goodVoxels[i] = true;
         }
-        currentvlist.clear();
       }
-    }
+    });
   }
-  checked.clear();
+
+  goodVoxelValues.commit();
 }
 
 int16 getArrayType(const IDataArray* inputData)
@@ -311,6 +168,18 @@ IFilter::PreflightResult IdentifySample::preflightImpl(const DataStructure& data
     return {MakeErrorResult<OutputActions>(-12001, ss)};
   }
 
+  // The mask is labeled as one value per cell of the geometry
+  if(inputData->getNumberOfComponents() != 1)
+  {
+    std::string ss = fmt::format("The mask array must have 1 component but has {}", inputData->getNumberOfComponents());
+    return {MakeErrorResult<OutputActions>(k_MASK_COMPONENTS_ERR, ss)};
+  }
+  if(inputData->getNumberOfTuples() != imageGeom->getNumberOfElements())
+  {
+    std::string ss = fmt::format("The mask array has {} tuples but the ImageGeom has {} cells", inputData->getNumberOfTuples(), imageGeom->getNumberOfElements());
+    return {MakeErrorResult<OutputActions>(k_MASK_TUPLES_ERR, ss)};
+  }
+
   OutputActions actions;
   return {std::move(actions)};
 }
@@ -324,13 +193,19 @@ Result<> IdentifySample::executeImpl(DataStructure& data, const Arguments& args,
   auto* inputData = data.getDataAs<IDataArray>(goodVoxelsArrayPath);
   auto arrayType = getArrayType(inputData);
 
-  if(arrayType == 1)
+  try
   {
-    _execute<bool>(data, imageGeomPath, goodVoxelsArrayPath, fillHoles);
-  }
-  if(arrayType == 2)
+    if(arrayType == 1)
+    {
+      _execute<bool>(data, imageGeomPath, goodVoxelsArrayPath, fillHoles);
+    }
+    if(arrayType == 2)
+    {
+      _execute<uint8>(data, imageGeomPath, goodVoxelsArrayPath, fillHoles);
+    }
+  } catch(const std::exception& exception)
   {
-    _execute<uint8>(data, imageGeomPath, goodVoxelsArrayPath, fillHoles);
+    return MakeErrorResult(k_LABELING_ERR, exception.what());
   }
 
   return {};
@@ -1,7 +1,5 @@
 #include "ImportCSVDataFilter.hpp"
 
-#include <fstream>
-
 #include "complex/Common/TypeTraits.hpp"
 #include "complex/Common/Types.hpp"
 #include "complex/Common/TypesUtility.hpp"
@@ -16,6 +14,7 @@
 #include "complex/Parameters/DataGroupSelectionParameter.hpp"
 #include "complex/Parameters/DynamicTableParameter.hpp"
 #include "complex/Parameters/ImportCSVDataParameter.hpp"
+#include "complex/Utilities/Parsing/Text/DelimitedTextReader.hpp"
 #include "complex/Utilities/StringUtilities.hpp"
 
 #include "ComplexCore/utils/CSVDataParser.hpp"
@@ -214,13 +213,8 @@ Result<ParsersVector> createParsers(const DataTypeVector& dataTypes, const DataP
 }
 
 // -----------------------------------------------------------------------------
-Result<> parseLine(std::fstream& inStream, const ParsersVector& dataParsers, const CharVector& delimiters, bool consecutiveDelimiters, usize lineNumber, usize beginIndex)
+Result<> parseLine(std::string_view line, nonstd::span<const std::string_view> tokens, const ParsersVector& dataParsers, usize lineNumber, usize tupleIndex)
 {
-  std::string line;
-  std::getline(inStream, line);
-
-  StringVector tokens = StringUtilities::split(line, delimiters, consecutiveDelimiters);
-
   if(dataParsers.size() != tokens.size())
   {
     return MakeErrorResult(to_underlying(IssueCodes::INCONSISTENT_COLS), fmt::format("Line {} has an inconsistent number of columns.\nExpecting {} but found {}\nInput line was:\n{}",
@@ -236,10 +230,11 @@ Result<> parseLine(std::fstream& inStream, const ParsersVector& dataParsers, con
 
     usize index = dataParser->columnIndex();
 
-    Result<> result = dataParser->parse(tokens[index], lineNumber - beginIndex);
+    Result<> result = dataParser->parse(tokens[index], tupleIndex);
     if(result.invalid())
     {
-      return result;
+      const Error& error = result.errors().front();
+      return MakeErrorResult(error.code, fmt::format("Line {}, column {} ('{}'): {}", lineNumber, index + 1, dataParser->columnName(), error.message));
     }
   }
 
@@ -261,16 +256,6 @@ void notifyProgress(const IFilter::MessageHandler& messageHandler, usize lineNum
     }
   }
 }
-
-// -----------------------------------------------------------------------------
-void skipNumberOfLines(std::fstream& inStream, usize numberOfLines)
-{
-  for(usize i = 1; i < numberOfLines; i++)
-  {
-    std::string line;
-    std::getline(inStream, line);
-  }
-}
 } // namespace
 
 namespace complex
@@ -454,31 +439,34 @@ Result<> ImportCSVDataFilter::executeImpl(DataStructure& dataStructure, const Ar
 
   ParsersVector dataParsers = std::move(parsersResult.value());
 
-  std::fstream in(inputFilePath.c_str(), std::ios_base::in);
-  if(!in.is_open())
+  DelimitedTextReader reader;
+  if(!reader.open(inputFilePath))
   {
     return MakeErrorResult(to_underlying(IssueCodes::FILE_NOT_OPEN), fmt::format("Could not open file for reading: {}", inputFilePath));
   }
 
-  // Skip to the first data line
-  skipNumberOfLines(in, beginIndex);
-
+  // The lines are parsed in parallel in batches so that progress can be reported between them
   float32 threshold = 0.0f;
   usize numTuples = numLines - beginIndex + 1;
-  for(usize lineNum = beginIndex; lineNum <= numLines; lineNum++)
+  const usize linesPerBatch = std::max<usize>(numTuples / 20, 1);
+  for(usize tupleIndex = 0; tupleIndex < numTuples; tupleIndex += linesPerBatch)
   {
     if(shouldCancel)
     {
       return {};
     }
 
-    Result<> parsingResult = parseLine(in, dataParsers, delimiters, consecutiveDelimiters, lineNum, beginIndex);
+    const usize numBatchLines = std::min(linesPerBatch, numTuples - tupleIndex);
+    Result<> parsingResult = reader.forEachRow(beginIndex - 1 + tupleIndex, numBatchLines, delimiters, consecutiveDelimiters,
+                                               [&](usize lineIndex, std::string_view line, nonstd::span<const std::string_view> tokens) {
+                                                 return parseLine(line, tokens, dataParsers, lineIndex + 1, lineIndex + 1 - beginIndex);
+                                               });
     if(parsingResult.invalid())
     {
-      return std::move(parsingResult);
+      return parsingResult;
     }
 
-    notifyProgress(messageHandler, lineNum, numTuples, threshold);
+    notifyProgress(messageHandler, tupleIndex + numBatchLines, numTuples, threshold);
   }
 
   return {};
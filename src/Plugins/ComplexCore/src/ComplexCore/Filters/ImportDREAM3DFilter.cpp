@@ -5,8 +5,10 @@
 #include "complex/Common/StringLiteral.hpp"
 #include "complex/DataStructure/DataGroup.hpp"
 #include "complex/Filter/Actions/ImportH5ObjectPathsAction.hpp"
+#include "complex/Parameters/BoolParameter.hpp"
 #include "complex/Parameters/Dream3dImportParameter.hpp"
 #include "complex/Parameters/StringParameter.hpp"
+#include "complex/Parameters/VectorParameter.hpp"
 #include "complex/Pipeline/Pipeline.hpp"
 #include "complex/Utilities/Parsing/DREAM3D/Dream3dIO.hpp"
 #include "complex/Utilities/Parsing/HDF5/H5FileReader.hpp"
@@ -17,6 +19,7 @@ constexpr complex::StringLiteral k_ImportedPipeline = "Imported Pipeline";
 constexpr complex::int32 k_NoImportPathError = -1;
 constexpr complex::int32 k_FailedOpenFileReaderError = -25;
 constexpr complex::int32 k_NoSelectedPaths = -26;
+constexpr complex::int32 k_InvalidSubvolumeError = -27;
 } // namespace
 
 namespace complex
@@ -45,6 +48,17 @@ Parameters ImportDREAM3DFilter::parameters() const
 {
   Parameters params;
   params.insert(std::make_unique<Dream3dImportParameter>(k_ImportFileData, "Import File Path", "The HDF5 file path the DataStructure should be imported from.", Dream3dImportParameter::ImportData()));
+  params.insertLinkableParameter(std::make_unique<BoolParameter>(
+      k_ImportSubvolume_Key, "Import Subvolume", "Crops every Image Geometry to the voxel bounds below while importing. Only the selected voxels are read from the file.", false));
+  params.insert(std::make_unique<VectorUInt64Parameter>(k_MinVoxel_Key, "Min Voxel", "The first voxel of the subvolume", std::vector<uint64>{0, 0, 0},
+                                                        std::vector<std::string>{"X (Column)", "Y (Row)", "Z (Plane)"}));
+  params.insert(std::make_unique<VectorUInt64Parameter>(k_MaxVoxel_Key, "Max Voxel [Inclusive]", "The last voxel of the subvolume", std::vector<uint64>{0, 0, 0},
+                                                        std::vector<std::string>{"X (Column)", "Y (Row)", "Z (Plane)"}));
+  params.linkParameters(k_ImportSubvolume_Key, k_MinVoxel_Key, true);
+  params.linkParameters(k_ImportSubvolume_Key, k_MaxVoxel_Key, true);
+  params.insert(std::make_unique<BoolParameter>(k_LazyLoad_Key, "Load Arrays On Demand",
+                                                "Only reads the values of each imported array from the file the first time a filter accesses them. The file is kept open until the arrays are deleted.",
+                                                false));
   return params;
 }
 
@@ -73,8 +87,27 @@ IFilter::PreflightResult ImportDREAM3DFilter::preflightImpl(const DataStructure&
     importData.DataPaths = std::nullopt;
   }
 
+  ImportH5ObjectPathsAction::SubvolumeType subvolume;
+  if(args.value<bool>(k_ImportSubvolume_Key))
+  {
+    auto minVoxel = args.value<std::vector<uint64>>(k_MinVoxel_Key);
+    auto maxVoxel = args.value<std::vector<uint64>>(k_MaxVoxel_Key);
+    H5::DataStructureReader::ImageSubvolume bounds;
+    for(usize i = 0; i < 3; i++)
+    {
+      if(minVoxel[i] > maxVoxel[i])
+      {
+        return {nonstd::make_unexpected(
+            std::vector<Error>{Error{k_InvalidSubvolumeError, fmt::format("The subvolume Min Voxel ({}) is greater than the Max Voxel ({}) along axis {}", minVoxel[i], maxVoxel[i], i)}})};
+      }
+      bounds.minVoxel[i] = static_cast<usize>(minVoxel[i]);
+      bounds.maxVoxel[i] = static_cast<usize>(maxVoxel[i]);
+    }
+    subvolume = bounds;
+  }
+
   OutputActions actions;
-  auto action = std::make_unique<ImportH5ObjectPathsAction>(importData.FilePath, importData.DataPaths);
+  auto action = std::make_unique<ImportH5ObjectPathsAction>(importData.FilePath, importData.DataPaths, subvolume, args.value<bool>(k_LazyLoad_Key));
   actions.actions.push_back(std::move(action));
   return {std::move(actions)};
 }
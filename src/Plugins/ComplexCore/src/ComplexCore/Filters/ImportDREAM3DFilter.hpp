@@ -28,6 +28,10 @@ public:
 
   // Parameter Keys
   static inline constexpr StringLiteral k_ImportFileData = "Import_File_Data";
+  static inline constexpr StringLiteral k_ImportSubvolume_Key = "Import_Subvolume";
+  static inline constexpr StringLiteral k_MinVoxel_Key = "Min_Voxel";
+  static inline constexpr StringLiteral k_MaxVoxel_Key = "Max_Voxel";
+  static inline constexpr StringLiteral k_LazyLoad_Key = "Lazy_Load";
 
   /**
    * @brief Returns the name of the filter class.
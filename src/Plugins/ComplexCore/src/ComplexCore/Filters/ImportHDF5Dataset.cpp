@@ -1,7 +1,9 @@
 #include "ImportHDF5Dataset.hpp"
 
+#include <optional>
 #include <set>
 
+#include <fmt/ranges.h>
 #include <nonstd/span.hpp>
 
 #include "complex/DataStructure/DataGroup.hpp"
@@ -45,13 +47,47 @@ std::vector<size_t> createDimensionVector(const std::string& cDimsStr)
   return cDims;
 }
 
+struct HyperslabSelection
+{
+  std::vector<hsize_t> start;
+  std::vector<hsize_t> count;
+  std::vector<hsize_t> stride;
+};
+
+// -----------------------------------------------------------------------------
+Result<std::optional<HyperslabSelection>> parseHyperslab(const ImportHDF5DatasetParameter::DatasetImportInfo& datasetImportInfo)
+{
+  if(!datasetImportInfo.hasHyperslab())
+  {
+    return {std::optional<HyperslabSelection>{}};
+  }
+
+  HyperslabSelection selection;
+  for(const auto& [dimsStr, dims] : {std::make_pair(datasetImportInfo.hyperslabStart, &selection.start), std::make_pair(datasetImportInfo.hyperslabCount, &selection.count),
+                                     std::make_pair(datasetImportInfo.hyperslabStride, &selection.stride)})
+  {
+    if(StringUtilities::trimmed(dimsStr).empty())
+    {
+      continue;
+    }
+    std::vector<size_t> values = createDimensionVector(dimsStr);
+    if(values.empty())
+    {
+      return MakeErrorResult<std::optional<HyperslabSelection>>(
+          -20016, fmt::format("The hyperslab value '{}' for dataset with path '{}' is not in the right format. Use comma-separated values (ex: '0, 10, 10').", dimsStr, datasetImportInfo.dataSetPath));
+    }
+    dims->assign(values.cbegin(), values.cend());
+  }
+  return {std::optional<HyperslabSelection>{std::move(selection)}};
+}
+
 template <typename T>
-Result<> fillDataArray(DataStructure& dataStructure, const DataPath& dataArrayPath, const H5::DatasetReader& datasetReader)
+Result<> fillDataArray(DataStructure& dataStructure, const DataPath& dataArrayPath, const H5::DatasetReader& datasetReader, const std::optional<HyperslabSelection>& hyperslab)
 {
   auto& dataArray = dataStructure.getDataRefAs<DataArray<T>>(dataArrayPath);
-  auto& absDataStore = dataArray.getDataStoreRef();
-  auto& dataStore = dynamic_cast<DataStore<T>&>(absDataStore);
-  if(!datasetReader.readIntoSpan<T>(dataStore.createSpan()))
+  bool success = hyperslab.has_value() ? datasetReader.readIntoSpan<T>(dataArray.createSpan(), hyperslab->start, hyperslab->count, hyperslab->stride)
+                                       : datasetReader.readIntoSpan<T>(dataArray.createSpan());
+  if(!success)
   {
     return {MakeErrorResult(-21002, fmt::format("Error reading dataset '{}' with '{}' total elements into data store for data array '{}' with '{}' total elements ('{}' tuples and '{}' components)",
                                                 dataArrayPath.getTargetName(), datasetReader.getNumElements(), dataArrayPath.toString(), dataArray.getSize(), dataArray.getNumberOfTuples(),
@@ -203,6 +239,23 @@ IFilter::PreflightResult ImportHDF5Dataset::preflightImpl(const DataStructure& d
           Error{-20012, fmt::format("Tuple Dimensions are not in the right format for dataset with path '{}'. Use comma-separated values (ex: 4x2 would be '4, 2').", datasetPath)}})};
     }
 
+    auto hyperslabResult = parseHyperslab(datasetImportInfo);
+    if(hyperslabResult.invalid())
+    {
+      return {nonstd::make_unexpected(std::move(hyperslabResult.errors()))};
+    }
+    const std::optional<HyperslabSelection>& hyperslab = hyperslabResult.value();
+    std::vector<hsize_t> selectedDims = dims;
+    if(hyperslab.has_value())
+    {
+      auto hyperslabDimsResult = datasetReader.getHyperslabDimensions(hyperslab->start, hyperslab->count, hyperslab->stride);
+      if(hyperslabDimsResult.invalid())
+      {
+        return {nonstd::make_unexpected(std::move(hyperslabDimsResult.errors()))};
+      }
+      selectedDims = std::move(hyperslabDimsResult.value());
+    }
+
     // Calculate the product of the dataset dimensions and the product of the component dimensions.
     // Since we're already looping over both of these sets of dimensions, let's also create our error message
     // in case the equation does not work and we have to bail.
@@ -218,16 +271,21 @@ IFilter::PreflightResult ImportHDF5Dataset::preflightImpl(const DataStructure& d
     for(int i = 0; i < dims.size(); i++)
     {
       stream << StringUtilities::number(dims[i]);
-      hdf5TotalElements = hdf5TotalElements * dims[i];
+      hdf5TotalElements = hdf5TotalElements * selectedDims[i];
       if(i != dims.size() - 1)
       {
         stream << " x ";
       }
     }
+    if(hyperslab.has_value())
+    {
+      stream << "\n";
+      stream << fmt::format("    Hyperslab Size(s): {}", fmt::join(selectedDims, " x "));
+    }
 
     // NOTE: When complex implements the AttributeMatrix, the user entered tuple dimensions should be optional in lieu of an attribute matrix as the selected data path/parent.
     stream << "\n";
-    stream << "    Total HDF5 Dataset Element Count: " << hdf5TotalElements << "\n";
+    stream << (hyperslab.has_value() ? "    Total HDF5 Hyperslab Element Count: " : "    Total HDF5 Dataset Element Count: ") << hdf5TotalElements << "\n";
     stream << "-------------------------------------------\n";
     stream << "No. of Tuple Dimension(s): " << StringUtilities::number(static_cast<uint64>(tDims.size())) << "\n";
     stream << "Tuple Dimension(s): ";
@@ -325,6 +383,13 @@ Result<> ImportHDF5Dataset::executeImpl(DataStructure& dataStructure, const Argu
     H5::DatasetReader datasetReader = h5FileReader.openDataset(datasetPath);
     std::string objectName = datasetReader.getName();
 
+    auto hyperslabResult = parseHyperslab(datasetImportInfo);
+    if(hyperslabResult.invalid())
+    {
+      return ConvertResult(std::move(hyperslabResult));
+    }
+    const std::optional<HyperslabSelection>& hyperslab = hyperslabResult.value();
+
     // Read dataset into DREAM.3D structure
     DataPath dataArrayPath = pSelectedAttributeMatrixValue.has_value() ? pSelectedAttributeMatrixValue.value().createChildPath(objectName) : DataPath::FromString(objectName).value();
     Result<> fillArrayResults;
@@ -332,43 +397,43 @@ Result<> ImportHDF5Dataset::executeImpl(DataStructure& dataStructure, const Argu
     switch(type)
     {
     case H5::Type::float32: {
-      fillArrayResults = fillDataArray<float32>(dataStructure, dataArrayPath, datasetReader);
+      fillArrayResults = fillDataArray<float32>(dataStructure, dataArrayPath, datasetReader, hyperslab);
       break;
     }
     case H5::Type::float64: {
-      fillArrayResults = fillDataArray<float64>(dataStructure, dataArrayPath, datasetReader);
+      fillArrayResults = fillDataArray<float64>(dataStructure, dataArrayPath, datasetReader, hyperslab);
       break;
     }
     case H5::Type::int8: {
-      fillArrayResults = fillDataArray<int8>(dataStructure, dataArrayPath, datasetReader);
+      fillArrayResults = fillDataArray<int8>(dataStructure, dataArrayPath, datasetReader, hyperslab);
       break;
     }
     case H5::Type::int16: {
-      fillArrayResults = fillDataArray<int16>(dataStructure, dataArrayPath, datasetReader);
+      fillArrayResults = fillDataArray<int16>(dataStructure, dataArrayPath, datasetReader, hyperslab);
       break;
     }
     case H5::Type::int32: {
-      fillArrayResults = fillDataArray<int32>(dataStructure, dataArrayPath, datasetReader);
+      fillArrayResults = fillDataArray<int32>(dataStructure, dataArrayPath, datasetReader, hyperslab);
       break;
     }
     case H5::Type::int64: {
-      fillArrayResults = fillDataArray<int64>(dataStructure, dataArrayPath, datasetReader);
+      fillArrayResults = fillDataArray<int64>(dataStructure, dataArrayPath, datasetReader, hyperslab);
       break;
     }
     case H5::Type::uint8: {
-      fillArrayResults = fillDataArray<uint8>(dataStructure, dataArrayPath, datasetReader);
+      fillArrayResults = fillDataArray<uint8>(dataStructure, dataArrayPath, datasetReader, hyperslab);
       break;
     }
     case H5::Type::uint16: {
-      fillArrayResults = fillDataArray<uint16>(dataStructure, dataArrayPath, datasetReader);
+      fillArrayResults = fillDataArray<uint16>(dataStructure, dataArrayPath, datasetReader, hyperslab);
       break;
     }
     case H5::Type::uint32: {
-      fillArrayResults = fillDataArray<uint32>(dataStructure, dataArrayPath, datasetReader);
+      fillArrayResults = fillDataArray<uint32>(dataStructure, dataArrayPath, datasetReader, hyperslab);
       break;
     }
     case H5::Type::uint64: {
-      fillArrayResults = fillDataArray<uint64>(dataStructure, dataArrayPath, datasetReader);
+      fillArrayResults = fillDataArray<uint64>(dataStructure, dataArrayPath, datasetReader, hyperslab);
       break;
     }
     default: {
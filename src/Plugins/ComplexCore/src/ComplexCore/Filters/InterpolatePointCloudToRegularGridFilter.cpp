@@ -1,7 +1,5 @@
 #include "InterpolatePointCloudToRegularGridFilter.hpp"
 
-#include <cmath>
-
 #include "complex/DataStructure/DataArray.hpp"
 #include "complex/DataStructure/Geometry/ImageGeom.hpp"
 #include "complex/DataStructure/Geometry/VertexGeom.hpp"
@@ -20,6 +18,13 @@
 #include "complex/Parameters/NumberParameter.hpp"
 #include "complex/Parameters/NumericTypeParameter.hpp"
 #include "complex/Parameters/VectorParameter.hpp"
+#include "complex/Utilities/CompressedRows.hpp"
+#include "complex/Utilities/FilterUtilities.hpp"
+#include "complex/Utilities/ParallelDataAlgorithm.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
 
 namespace complex
 {
@@ -27,156 +32,186 @@ namespace
 {
 constexpr int64 k_MissingVertexGeom = -24500;
 constexpr int64 k_MissingImageGeom = -24501;
-
-template <typename T>
-void mapPointCloudDataByKernel(IDataArray* source, INeighborList* dynamic, std::vector<float>& kernelVals, int64 kernel[3], usize dims[3], usize curX, usize curY, usize curZ, usize vertIdx)
+constexpr int64 k_MissingVoxelIndices = -24502;
+constexpr int64 k_MissingMask = -24503;
+constexpr int64 k_VoxelIndicesSizeMismatch = -24504;
+constexpr int64 k_VoxelIndexOutOfBounds = -24505;
+
+constexpr uint64 k_NeighborListOutput = 0;
+constexpr uint64 k_WeightedMeanOutput = 1;
+
+/**
+ * @brief A voxel covered by the kernel relative to the voxel that contains a point.
+ */
+struct KernelOffset
 {
-  auto* inputDataArray = dynamic_cast<DataArray<T>*>(source);
-  auto& inputData = inputDataArray->getDataStoreRef();
-  auto* interpolatedDataPtr = dynamic_cast<NeighborList<T>*>(dynamic);
-
-  usize index = 0;
-  int64 startKernel[3] = {0, 0, 0};
-  int64 endKernel[3] = {0, 0, 0};
-  usize counter = 0;
-
-  kernel[0] > int64(curX) ? startKernel[0] = 0 : startKernel[0] = curX - kernel[0];
-  kernel[1] > int64(curY) ? startKernel[1] = 0 : startKernel[1] = curY - kernel[1];
-  kernel[2] > int64(curZ) ? startKernel[2] = 0 : startKernel[2] = curZ - kernel[2];
-
-  int64(curX) + kernel[0] >= int64(dims[0]) ? endKernel[0] = dims[0] - 1 : endKernel[0] = curX + kernel[0];
-  int64(curY) + kernel[1] >= int64(dims[1]) ? endKernel[1] = dims[1] - 1 : endKernel[1] = curY + kernel[1];
-  endKernel[2] = int64(curZ);
-
-  for(int64 z = startKernel[2]; z <= endKernel[2]; z++)
+  int64 x = 0;
+  int64 y = 0;
+  int64 z = 0;
+  float32 weight = 0.0f;
+  float32 distance = 0.0f;
+};
+
+// -----------------------------------------------------------------------------
+std::vector<KernelOffset> CreateKernelOffsets(uint64 interpolationTechnique, const std::vector<float32>& sigmas, const int64 kernelNumVoxels[3], const FloatVec3& res)
+{
+  std::vector<KernelOffset> offsets;
+  for(int64 z = -kernelNumVoxels[2]; z <= kernelNumVoxels[2]; z++)
   {
-    for(int64 y = startKernel[1]; y <= endKernel[1]; y++)
+    for(int64 y = -kernelNumVoxels[1]; y <= kernelNumVoxels[1]; y++)
     {
-      for(int64 x = startKernel[0]; x <= endKernel[0]; x++)
+      for(int64 x = -kernelNumVoxels[0]; x <= kernelNumVoxels[0]; x++)
       {
-        if(kernelVals[counter] == 0.0f)
+        float32 weight = 1.0f;
+        if(interpolationTechnique == 1)
+        {
+          weight = static_cast<float32>(std::exp(-((x * x) / (2 * sigmas[0] * sigmas[0]) + (y * y) / (2 * sigmas[1] * sigmas[1]) + (z * z) / (2 * sigmas[2] * sigmas[2]))));
+        }
+        // Voxels where the kernel vanishes receive no contribution from the point
+        if(weight == 0.0f)
         {
           continue;
         }
-        index = (z * dims[1] * dims[0]) + (y * dims[0]) + x;
-        interpolatedDataPtr->addEntry(index, kernelVals[counter] * inputData[vertIdx]);
-        counter++;
+        const float32 distance = std::sqrt((x * x * res[0] * res[0]) + (y * y * res[1] * res[1]) + (z * z * res[2] * res[2]));
+        offsets.push_back({x, y, z, weight, distance});
       }
     }
   }
+  return offsets;
 }
 
-void mapPointCloudDataByKernel(IDataArray* source, INeighborList* dynamic, std::vector<float>& kernelVals, int64 kernel[3], usize dims[3], usize curX, usize curY, usize curZ, usize vertIdx)
+/**
+ * @brief A compressed sparse row index of the points that fall inside each voxel of
+ * the image geometry. The points of each voxel are stored in increasing order.
+ */
+using VoxelPointIndex = CompressedRows::Table<usize>;
+
+VoxelPointIndex FindVoxelPoints(nonstd::span<const usize> voxelIndices, nonstd::span<const bool> mask, usize numVoxels)
 {
-  switch(source->getDataType())
-  {
-  case DataType::int8:
-    mapPointCloudDataByKernel<int8>(source, dynamic, kernelVals, kernel, dims, curX, curY, curZ, vertIdx);
-    break;
-  case DataType::int16:
-    mapPointCloudDataByKernel<int16>(source, dynamic, kernelVals, kernel, dims, curX, curY, curZ, vertIdx);
-    break;
-  case DataType::int32:
-    mapPointCloudDataByKernel<int32>(source, dynamic, kernelVals, kernel, dims, curX, curY, curZ, vertIdx);
-    break;
-  case DataType::int64:
-    mapPointCloudDataByKernel<int64>(source, dynamic, kernelVals, kernel, dims, curX, curY, curZ, vertIdx);
-    break;
-  case DataType::uint8:
-    mapPointCloudDataByKernel<uint8>(source, dynamic, kernelVals, kernel, dims, curX, curY, curZ, vertIdx);
-    break;
-  case DataType::uint16:
-    mapPointCloudDataByKernel<uint16>(source, dynamic, kernelVals, kernel, dims, curX, curY, curZ, vertIdx);
-    break;
-  case DataType::uint32:
-    mapPointCloudDataByKernel<uint32>(source, dynamic, kernelVals, kernel, dims, curX, curY, curZ, vertIdx);
-    break;
-  case DataType::uint64:
-    mapPointCloudDataByKernel<uint64>(source, dynamic, kernelVals, kernel, dims, curX, curY, curZ, vertIdx);
-    break;
-  case DataType::float32:
-    mapPointCloudDataByKernel<float32>(source, dynamic, kernelVals, kernel, dims, curX, curY, curZ, vertIdx);
-    break;
-  case DataType::float64:
-    mapPointCloudDataByKernel<float64>(source, dynamic, kernelVals, kernel, dims, curX, curY, curZ, vertIdx);
-    break;
-  }
+  return CompressedRows::Build<usize>(voxelIndices.size(), numVoxels, [voxelIndices, mask](usize point, auto&& emit) {
+    if(mask.empty() || mask[point])
+    {
+      emit(voxelIndices[point], point);
+    }
+  });
 }
 
-void determineKernel(uint64 interpolationTechnique, const FloatVec3& sigmas, std::vector<float32>& kernel, int64 kernelNumVoxels[3])
+/**
+ * @brief Calls the function with each voxel whose kernel covers this voxel and the
+ * kernel offset from that voxel to this one.
+ */
+template <typename FunctionT>
+void ForEachSourceVoxel(const std::vector<KernelOffset>& kernel, const SizeVec3& dims, usize voxel, FunctionT&& function)
 {
-  usize counter = 0;
-
-  for(int64 z = -kernelNumVoxels[2]; z <= kernelNumVoxels[2]; z++)
+  const auto x = static_cast<int64>(voxel % dims[0]);
+  const auto y = static_cast<int64>((voxel / dims[0]) % dims[1]);
+  const auto z = static_cast<int64>(voxel / (dims[0] * dims[1]));
+  for(const KernelOffset& offset : kernel)
   {
-    for(int64 y = -kernelNumVoxels[1]; y <= kernelNumVoxels[1]; y++)
+    const int64 sourceX = x - offset.x;
+    const int64 sourceY = y - offset.y;
+    const int64 sourceZ = z - offset.z;
+    if(sourceX < 0 || sourceY < 0 || sourceZ < 0 || sourceX >= static_cast<int64>(dims[0]) || sourceY >= static_cast<int64>(dims[1]) || sourceZ >= static_cast<int64>(dims[2]))
     {
-      for(int64 x = -kernelNumVoxels[0]; x <= kernelNumVoxels[0]; x++)
-      {
-        if(interpolationTechnique == 0)
-        {
-          kernel[counter] = 1.0f;
-        }
-        else if(interpolationTechnique == 1)
-        {
-          kernel[counter] = static_cast<float32>(std::exp(-((x * x) / (2 * sigmas[0] * sigmas[0]) + (y * y) / (2 * sigmas[1] * sigmas[1]) + (z * z) / (2 * sigmas[2] * sigmas[2]))));
-        }
-        counter++;
-      }
+      continue;
     }
+    function((static_cast<usize>(sourceZ) * dims[1] + static_cast<usize>(sourceY)) * dims[0] + static_cast<usize>(sourceX), offset);
   }
 }
 
-void determineKernelDistances(std::vector<float32>& kernelValDistances, int64 kernelNumVoxels[3], FloatVec3 res)
+/**
+ * @brief Calls the function with each point whose kernel covers the voxel and the
+ * kernel offset from the voxel of that point to this voxel. Gathering the
+ * contributions per voxel lets every voxel be written by a single thread.
+ */
+template <typename FunctionT>
+void ForEachContribution(const VoxelPointIndex& pointIndex, const std::vector<KernelOffset>& kernel, const SizeVec3& dims, usize voxel, FunctionT&& function)
 {
-  usize counter = 0;
-
-  for(int64 z = -kernelNumVoxels[2]; z <= kernelNumVoxels[2]; z++)
-  {
-    for(int64 y = -kernelNumVoxels[1]; y <= kernelNumVoxels[1]; y++)
+  ForEachSourceVoxel(kernel, dims, voxel, [&](usize sourceVoxel, const KernelOffset& offset) {
+    for(usize point : pointIndex.getRow(sourceVoxel))
     {
-      for(int64 x = -kernelNumVoxels[0]; x <= kernelNumVoxels[0]; x++)
-      {
-        kernelValDistances[counter] = (x * x * res[0] * res[0]) + (y * y * res[1] * res[1]) + (z * z * res[2] * res[2]);
-        kernelValDistances[counter] = static_cast<float32>(std::sqrt(kernelValDistances[counter]));
-        counter++;
-      }
+      function(point, offset);
     }
-  }
+  });
 }
 
-void mapKernelDistances(NeighborList<float32>* kernelDistances, std::vector<float32>& kernelValDistances, int64 kernel[3], usize dims[3], usize curX, usize curY, usize curZ)
+/**
+ * @brief Fills a flat NeighborList with one list per voxel. The lists have the sizes
+ * counted beforehand and are filled in parallel.
+ */
+template <typename T, typename FunctionT>
+void BuildVoxelLists(NeighborList<T>& neighborList, const VoxelPointIndex& pointIndex, const std::vector<KernelOffset>& kernel, const SizeVec3& dims, const std::vector<usize>& listSizes,
+                     FunctionT&& valueFunction)
 {
-  usize index = 0;
-  int64 startKernel[3] = {0, 0, 0};
-  int64 endKernel[3] = {0, 0, 0};
-  usize counter = 0;
-
-  kernel[0] > int64(curX) ? startKernel[0] = 0 : startKernel[0] = curX - kernel[0];
-  kernel[1] > int64(curY) ? startKernel[1] = 0 : startKernel[1] = curY - kernel[1];
-  kernel[2] > int64(curZ) ? startKernel[2] = 0 : startKernel[2] = curZ - kernel[2];
+  const usize numVoxels = listSizes.size();
+  typename NeighborList<T>::Builder builder(numVoxels);
+  for(usize voxel = 0; voxel < numVoxels; voxel++)
+  {
+    builder.addToListSize(voxel, listSizes[voxel]);
+  }
+  builder.allocate();
 
-  int64(curX) + kernel[0] >= int64(dims[0]) ? endKernel[0] = dims[0] - 1 : endKernel[0] = curX + kernel[0];
-  int64(curY) + kernel[1] >= int64(dims[1]) ? endKernel[1] = dims[1] - 1 : endKernel[1] = curY + kernel[1];
-  endKernel[2] = int64(curZ);
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, numVoxels);
+  dataAlg.execute([&](const ComplexRange& range) {
+    for(usize voxel = range.min(); voxel < range.max(); voxel++)
+    {
+      nonstd::span<T> list = builder.getList(voxel);
+      usize entry = 0;
+      ForEachContribution(pointIndex, kernel, dims, voxel, [&](usize point, const KernelOffset& offset) { list[entry++] = valueFunction(point, offset); });
+    }
+  });
+  neighborList.setFlatStorage(builder.build());
+}
 
-  for(int64 z = startKernel[2]; z <= endKernel[2]; z++)
+/**
+ * @brief Stores the value of every point that contributes to a voxel, scaled by the
+ * kernel weight when the array is interpolated.
+ */
+struct MapToNeighborListFunctor
+{
+  template <typename T>
+  void operator()(const IDataArray& source, INeighborList& target, const VoxelPointIndex& pointIndex, const std::vector<KernelOffset>& kernel, const SizeVec3& dims,
+                  const std::vector<usize>& listSizes, bool useKernelWeights)
   {
-    for(int64 y = startKernel[1]; y <= endKernel[1]; y++)
+    if constexpr(!std::is_same_v<T, bool>)
     {
-      for(int64 x = startKernel[0]; x <= endKernel[0]; x++)
+      const auto values = dynamic_cast<const DataArray<T>&>(source).createSpan();
+      auto& neighborList = dynamic_cast<NeighborList<T>&>(target);
+      BuildVoxelLists(neighborList, pointIndex, kernel, dims, listSizes, [&](usize point, const KernelOffset& offset) {
+        return useKernelWeights ? static_cast<T>(offset.weight * static_cast<float64>(values[point])) : values[point];
+      });
+    }
+  }
+};
+
+/**
+ * @brief Reduces the points that contribute to each voxel to the mean of their values
+ * weighted by the kernel. Voxels without any contribution are set to 0.
+ */
+struct MapToWeightedMeanFunctor
+{
+  template <typename T>
+  void operator()(const IDataArray& source, Float32Array& target, const VoxelPointIndex& pointIndex, const std::vector<KernelOffset>& kernel, const SizeVec3& dims)
+  {
+    const auto values = dynamic_cast<const DataArray<T>&>(source).createSpan();
+    auto means = target.createSpan();
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(0, means.size());
+    dataAlg.execute([&](const ComplexRange& range) {
+      for(usize voxel = range.min(); voxel < range.max(); voxel++)
       {
-        if(kernel[counter] == 0.0f)
-        {
-          continue;
-        }
-        index = (z * dims[1] * dims[0]) + (y * dims[0]) + x;
-        kernelDistances->addEntry(index, kernelValDistances[counter]);
-        counter++;
+        float64 weightedSum = 0.0;
+        float64 totalWeight = 0.0;
+        ForEachContribution(pointIndex, kernel, dims, voxel, [&](usize point, const KernelOffset& offset) {
+          weightedSum += offset.weight * static_cast<float64>(values[point]);
+          totalWeight += offset.weight;
+        });
+        means[voxel] = totalWeight > 0.0 ? static_cast<float32>(weightedSum / totalWeight) : 0.0f;
       }
-    }
+    });
   }
-}
+};
 } // namespace
 
 std::string InterpolatePointCloudToRegularGridFilter::name() const
@@ -205,6 +240,8 @@ Parameters InterpolatePointCloudToRegularGridFilter::parameters() const
   params.insertLinkableParameter(std::make_unique<BoolParameter>(k_UseMask_Key, "Use Mask", "Specifies whether or not to use a mask array", true));
   params.insert(std::make_unique<BoolParameter>(k_StoreKernelDistances_Key, "Store Kernel Distances", "Specifies whether or not to store kernel distances", true));
   params.insert(std::make_unique<ChoicesParameter>(k_InterpolationTechnique_Key, "Interpolation Technique", "Selected Interpolation Technique", 0, std::vector<std::string>{"Uniform", "Gaussian"}));
+  params.insert(std::make_unique<ChoicesParameter>(k_OutputType_Key, "Interpolated Output", "Store every kernel contribution to a voxel or only their weighted mean", k_NeighborListOutput,
+                                                   std::vector<std::string>{"Neighbor Lists", "Weighted Mean"}));
 
   params.insert(std::make_unique<VectorFloat32Parameter>(k_KernelSize_Key, "Kernel Size", "Specifies the kernel size", std::vector<float32>{0, 0, 0}, std::vector<std::string>{"x", "y", "z"}));
   params.insert(
@@ -248,6 +285,7 @@ IFilter::PreflightResult InterpolatePointCloudToRegularGridFilter::preflightImpl
   auto maskArrayPath = args.value<DataPath>(k_Mask_Key);
 
   auto interpolationTechnique = args.value<uint64>(k_InterpolationTechnique_Key);
+  auto outputType = args.value<uint64>(k_OutputType_Key);
   auto kernelSize = args.value<std::vector<float32>>(k_KernelSize_Key);
   auto sigmas = args.value<std::vector<float32>>(k_GaussianSigmas_Key);
 
@@ -276,6 +314,12 @@ IFilter::PreflightResult InterpolatePointCloudToRegularGridFilter::preflightImpl
     return {nonstd::make_unexpected(std::vector<Error>{Error{-11000, ss}})};
   }
 
+  if(outputType != k_NeighborListOutput && outputType != k_WeightedMeanOutput)
+  {
+    std::string ss = fmt::format("Interpolated Output must be 0 [Neighbor Lists] or 1 [Weighted Mean]");
+    return {nonstd::make_unexpected(std::vector<Error>{Error{-11000, ss}})};
+  }
+
   if(kernelSize[0] < 0 || kernelSize[1] < 0 || kernelSize[2] < 0)
   {
     std::string ss = fmt::format("All kernel dimensions must be positive.\n "
@@ -320,7 +364,8 @@ IFilter::PreflightResult InterpolatePointCloudToRegularGridFilter::preflightImpl
   // If we are in a vertex attribute matrix, create data arrays for all in the new interpolated data attribute matrix
   // Else, we are in a feature/ensemble attribute matrix, and just deep copy it into the new data container
 
-  const usize cDims = 1;
+  const SizeVec3 dims = image->getDimensions();
+  const usize numVoxels = image->getNumberOfElements();
 
   for(const auto& interpolatePath : interpolatedDataPaths)
   {
@@ -337,10 +382,16 @@ IFilter::PreflightResult InterpolatePointCloudToRegularGridFilter::preflightImpl
       return {nonstd::make_unexpected(std::vector<Error>{Error{-11002, ss}})};
     }
     auto dataType = targetArray->getDataType();
-    if(dataType != DataType::boolean)
+    if(dataType != DataType::boolean && outputType == k_WeightedMeanOutput)
+    {
+      auto meanPath = interpolatedGroupPath.createChildPath(targetArray->getName() + " Mean");
+      auto meanAction = std::make_unique<CreateArrayAction>(DataType::float32, std::vector<usize>{dims[2], dims[1], dims[0]}, std::vector<usize>{1}, meanPath);
+      actions.actions.push_back(std::move(meanAction));
+    }
+    else if(dataType != DataType::boolean)
     {
       auto neighborPath = interpolatedGroupPath.createChildPath(targetArray->getName() + " Neighbors");
-      auto neighborAction = std::make_unique<CreateNeighborListAction>(dataType, targetArray->getNumberOfTuples(), neighborPath);
+      auto neighborAction = std::make_unique<CreateNeighborListAction>(dataType, numVoxels, neighborPath);
       actions.actions.push_back(std::move(neighborAction));
     }
   }
@@ -363,34 +414,34 @@ IFilter::PreflightResult InterpolatePointCloudToRegularGridFilter::preflightImpl
     if(dataType != DataType::boolean)
     {
       auto neighborPath = interpolatedGroupPath.createChildPath(targetArray->getName() + " Neighbors");
-      auto neighborAction = std::make_unique<CreateNeighborListAction>(dataType, targetArray->getNumberOfTuples(), neighborPath);
+      auto neighborAction = std::make_unique<CreateNeighborListAction>(dataType, numVoxels, neighborPath);
       actions.actions.push_back(std::move(neighborAction));
     }
   }
 
   auto voxelIndicesPtr = data.getDataAs<USizeArray>(voxelIndicesPath);
-  if(nullptr != voxelIndicesPtr)
+  if(nullptr == voxelIndicesPtr)
   {
-    // voxelIndices = voxelIndicesPtr->getDataStore();
-    /* Now assign the raw pointer to data from the DataArray<T> object */
-    dataArrays.push_back(voxelIndicesPtr);
+    std::string ss = fmt::format("Voxel Indices array cannot be found at path '{}'", voxelIndicesPath.toString());
+    return {nonstd::make_unexpected(std::vector<Error>{Error{k_MissingVoxelIndices, ss}})};
   }
+  dataArrays.push_back(voxelIndicesPtr);
 
   if(useMask)
   {
     auto maskPtr = data.getDataAs<BoolArray>(maskArrayPath);
-    if(nullptr != maskPtr)
+    if(nullptr == maskPtr)
     {
-      // mask = maskPtr->getDataStore();
-      /* Now assign the raw pointer to data from the DataArray<T> object */
-      dataArrays.push_back(maskPtr);
+      std::string ss = fmt::format("Mask array cannot be found at path '{}'", maskArrayPath.toString());
+      return {nonstd::make_unexpected(std::vector<Error>{Error{k_MissingMask, ss}})};
     }
+    dataArrays.push_back(maskPtr);
   }
 
   if(storeKernelDistances)
   {
     auto kernelDistancesDataPath = kernelDistancesGroupPath.createChildPath("Neighbor List");
-    auto action = std::make_unique<CreateNeighborListAction>(DataType::float32, 0, kernelDistancesDataPath);
+    auto action = std::make_unique<CreateNeighborListAction>(DataType::float32, numVoxels, kernelDistancesDataPath);
     actions.actions.push_back(std::move(action));
   }
 
@@ -416,33 +467,42 @@ Result<> InterpolatePointCloudToRegularGridFilter::executeImpl(DataStructure& da
   auto voxelIndicesPath = args.value<DataPath>(k_VoxelIndices_Key);
 
   auto interpolationTechnique = args.value<uint64>(k_InterpolationTechnique_Key);
+  auto outputType = args.value<uint64>(k_OutputType_Key);
   auto kernelSize = args.value<std::vector<float32>>(k_KernelSize_Key);
   auto sigmas = args.value<std::vector<float32>>(k_GaussianSigmas_Key);
 
-  auto interpolatedTechnique = args.value<uint64>(k_InterpolationTechnique_Key);
-
-  //
   auto vertices = data.getDataAs<VertexGeom>(vertexGeomPath);
   auto image = data.getDataAs<ImageGeom>(imageGeomPath);
   SizeVec3 dims = image->getDimensions();
   FloatVec3 res = image->getSpacing();
+  const usize numVoxels = image->getNumberOfElements();
   int64 kernelNumVoxels[3] = {0, 0, 0};
 
-  auto numVerts = vertices->getNumberOfVertices();
-  usize index = 0;
-  usize x = 0;
-  usize y = 0;
-  usize z = 0;
-
-  std::vector<float32> kernel;
+  const usize numVerts = vertices->getNumberOfVertices();
 
-  auto maskArray = data.getDataAs<BoolArray>(maskPath);
-  auto mask = maskArray->getDataStore();
+  const auto& voxelIndicesArray = data.getDataRefAs<DataArray<usize>>(voxelIndicesPath);
+  if(voxelIndicesArray.getNumberOfTuples() < numVerts)
+  {
+    std::string ss = fmt::format("The Voxel Indices array has {} tuples but the Vertex Geometry has {} vertices", voxelIndicesArray.getNumberOfTuples(), numVerts);
+    return {nonstd::make_unexpected(std::vector<Error>{Error{k_VoxelIndicesSizeMismatch, ss}})};
+  }
+  const auto voxelIndices = voxelIndicesArray.createSpan().first(numVerts);
 
-  auto voxelIndicesArray = data.getDataAs<DataArray<usize>>(voxelIndicesPath);
-  auto voxelIndices = voxelIndicesArray->getDataStore();
+  nonstd::span<const bool> mask;
+  if(useMask)
+  {
+    mask = data.getDataRefAs<BoolArray>(maskPath).createSpan().first(numVerts);
+  }
 
-  usize maxImageIndex = ((dims[2] - 1) * dims[0] * dims[1]) + ((dims[1] - 1) * dims[0]) + (dims[0] - 1);
+  for(usize i = 0; i < numVerts; i++)
+  {
+    if((mask.empty() || mask[i]) && voxelIndices[i] >= numVoxels)
+    {
+      std::string ss = fmt::format("Index present in the selected Voxel Indices array that falls outside the selected Image Geometry for interpolation.\n Index = {}\n Max Image Index = {}\n",
+                                   voxelIndices[i], numVoxels - 1);
+      return {nonstd::make_unexpected(std::vector<Error>{Error{k_VoxelIndexOutOfBounds, ss}})};
+    }
+  }
 
   kernelNumVoxels[0] = int64(std::ceil((kernelSize[0] / res[0]) * 0.5f));
   kernelNumVoxels[1] = int64(std::ceil((kernelSize[1] / res[1]) * 0.5f));
@@ -461,91 +521,76 @@ Result<> InterpolatePointCloudToRegularGridFilter::executeImpl(DataStructure& da
     kernelNumVoxels[2] = 0;
   }
 
-  int64 tmpKernelSize[3] = {1, 1, 1};
-  int64 totalKernel = 0;
+  const std::vector<KernelOffset> kernel = CreateKernelOffsets(interpolationTechnique, sigmas, kernelNumVoxels, res);
 
-  for(usize i = 0; i < 3; i++)
+  messageHandler(IFilter::Message::Type::Info, "Binning Points into Voxels");
+  const VoxelPointIndex pointIndex = FindVoxelPoints(voxelIndices, mask, numVoxels);
+  if(shouldCancel)
   {
-    tmpKernelSize[i] *= (kernelNumVoxels[i] * 2) + 1;
+    return {};
   }
 
-  totalKernel = tmpKernelSize[0] * tmpKernelSize[1] * tmpKernelSize[2];
-
-  kernel.resize(totalKernel);
-  std::fill(kernel.begin(), kernel.end(), 0.0f);
-  determineKernel(interpolatedTechnique, sigmas, kernel, kernelNumVoxels);
-
-  std::vector<float> uniformKernel(totalKernel, 1.0f);
-
-  std::vector<float32> kernelValDistances;
-  if(storeKernelDistances)
+  // Every list stores one entry per contribution, so all of them have the same sizes
+  std::vector<usize> listSizes;
+  const bool needsNeighborLists = storeKernelDistances || !copyDataPaths.empty() || (outputType == k_NeighborListOutput && !interpolatedDataPaths.empty());
+  if(needsNeighborLists)
   {
-    kernelValDistances.resize(totalKernel);
-    std::fill(kernelValDistances.begin(), kernelValDistances.end(), 0.0f);
-    determineKernelDistances(kernelValDistances, kernelNumVoxels, res);
+    listSizes.resize(numVoxels, 0);
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(0, numVoxels);
+    dataAlg.execute([&](const ComplexRange& range) {
+      for(usize voxel = range.min(); voxel < range.max(); voxel++)
+      {
+        ForEachSourceVoxel(kernel, dims, voxel, [&](usize sourceVoxel, const KernelOffset&) { listSizes[voxel] += pointIndex.getRow(sourceVoxel).size(); });
+      }
+    });
   }
 
-  usize progIncrement = numVerts / 100;
-  usize prog = 1;
-  usize progressInt = 0;
-
-  for(usize i = 0; i < numVerts; i++)
+  for(const auto& interpolatedDataPathItem : interpolatedDataPaths)
   {
-    if(useMask)
+    if(shouldCancel)
     {
-      if(!mask->getValue(i))
-      {
-        continue;
-      }
+      return {};
     }
-    index = voxelIndices->getValue(i);
-    if(index > maxImageIndex)
+    messageHandler(IFilter::Message::Type::Info, fmt::format("Interpolating {}", interpolatedDataPathItem.getTargetName()));
+    const auto& interpolatedArray = data.getDataRefAs<IDataArray>(interpolatedDataPathItem);
+    if(interpolatedArray.getDataType() == DataType::boolean)
     {
-      std::string ss = fmt::format("Index present in the selected Voxel Indices array that falls outside the selected Image Geometry for interpolation.\n Index = %1\n Max Image Index = %2\n", index,
-                                   maxImageIndex);
-      return {nonstd::make_unexpected(std::vector<Error>{Error{-1, ss}})};
+      continue;
     }
-    x = index % dims[0];
-    y = (index / dims[0]) % dims[1];
-    z = index / (dims[0] * dims[1]);
-
-    if(!interpolatedDataPaths.empty())
+    if(outputType == k_WeightedMeanOutput)
     {
-      for(const auto& interpolatedDataPathItem : interpolatedDataPaths)
-      {
-        auto parentPath = interpolatedDataPathItem.getParent();
-        auto dynamicArrayPath = parentPath.createChildPath(interpolatedDataPathItem.getTargetName() + "Neighbors");
-        auto* dynamicArrayToInterpolate = data.getDataAs<INeighborList>(dynamicArrayPath);
-        auto* interpolatedArray = data.getDataAs<IDataArray>(interpolatedDataPathItem);
-        mapPointCloudDataByKernel(interpolatedArray, dynamicArrayToInterpolate, kernel, kernelNumVoxels, dims.data(), x, y, z, i);
-      }
+      auto& meanArray = data.getDataRefAs<Float32Array>(interpolatedDataPath.createChildPath(interpolatedDataPathItem.getTargetName() + " Mean"));
+      ExecuteDataFunction(MapToWeightedMeanFunctor{}, interpolatedArray.getDataType(), interpolatedArray, meanArray, pointIndex, kernel, dims);
     }
-
-    if(copyDataPaths.size() > 0)
+    else
     {
-      for(const auto& copyDataPath : copyDataPaths)
-      {
-        auto dynamicArrayPath = interpolatedDataPath.createChildPath(copyDataPath.getTargetName() + " Neighbors");
-        auto* dynamicArrayToCopy = data.getDataAs<INeighborList>(dynamicArrayPath);
-        auto* copyArray = data.getDataAs<IDataArray>(copyDataPath);
-        mapPointCloudDataByKernel(copyArray, dynamicArrayToCopy, uniformKernel, kernelNumVoxels, dims.data(), x, y, z, i);
-      }
+      auto& dynamicArrayToInterpolate = data.getDataRefAs<INeighborList>(interpolatedDataPath.createChildPath(interpolatedDataPathItem.getTargetName() + " Neighbors"));
+      ExecuteDataFunction(MapToNeighborListFunctor{}, interpolatedArray.getDataType(), interpolatedArray, dynamicArrayToInterpolate, pointIndex, kernel, dims, listSizes, true);
     }
+  }
 
-    if(storeKernelDistances)
+  for(const auto& copyDataPath : copyDataPaths)
+  {
+    if(shouldCancel)
     {
-      auto kernelDistancesNeighborsPath = kernelDistancesDataPath.createChildPath("Neighbor List");
-      auto kernelDistances = data.getDataAs<FloatNeighborListType>(kernelDistancesNeighborsPath);
-      mapKernelDistances(kernelDistances, kernelValDistances, kernelNumVoxels, dims.data(), x, y, z);
+      return {};
     }
-
-    if(i > prog)
+    messageHandler(IFilter::Message::Type::Info, fmt::format("Copying {}", copyDataPath.getTargetName()));
+    const auto& copyArray = data.getDataRefAs<IDataArray>(copyDataPath);
+    if(copyArray.getDataType() == DataType::boolean)
     {
-      progressInt = static_cast<int64>((static_cast<float>(i) / numVerts) * 100.0f);
-      std::string ss = fmt::format("Interpolating Point Cloud || {}% Completed", progressInt);
-      // notifyStatusMessage(ss);
-      prog = prog + progIncrement;
+      continue;
     }
+    auto& dynamicArrayToCopy = data.getDataRefAs<INeighborList>(interpolatedDataPath.createChildPath(copyDataPath.getTargetName() + " Neighbors"));
+    ExecuteDataFunction(MapToNeighborListFunctor{}, copyArray.getDataType(), copyArray, dynamicArrayToCopy, pointIndex, kernel, dims, listSizes, false);
+  }
+
+  if(storeKernelDistances)
+  {
+    messageHandler(IFilter::Message::Type::Info, "Storing Kernel Distances");
+    auto& kernelDistances = data.getDataRefAs<FloatNeighborListType>(kernelDistancesDataPath.createChildPath("Neighbor List"));
+    BuildVoxelLists(kernelDistances, pointIndex, kernel, dims, listSizes, [](usize, const KernelOffset& offset) { return offset.distance; });
   }
 
   return {};
@@ -10,7 +10,10 @@ namespace complex
 {
 /**
  * @class InterpolatePointCloudToRegularGridFilter
- * @brief
+ * @brief This filter spreads the values of the points of a VertexGeom over the
+ * voxels of an ImageGeom that lie inside a uniform or Gaussian kernel centered on
+ * the voxel that contains each point. The contributions to each voxel are either
+ * stored as a list per voxel or reduced to their kernel weighted mean.
  */
 class COMPLEXCORE_EXPORT InterpolatePointCloudToRegularGridFilter : public IFilter
 {
@@ -28,6 +31,7 @@ public:
   static inline constexpr StringLiteral k_UseMask_Key = "use_mask";
   static inline constexpr StringLiteral k_StoreKernelDistances_Key = "store_kernel_distances";
   static inline constexpr StringLiteral k_InterpolationTechnique_Key = "interpolation_technique";
+  static inline constexpr StringLiteral k_OutputType_Key = "output_type";
   static inline constexpr StringLiteral k_KernelSize_Key = "kernel_size";
   static inline constexpr StringLiteral k_GaussianSigmas_Key = "guassian_sigmas";
   static inline constexpr StringLiteral k_VertexGeom_Key = "vertex_geom";
@@ -9,11 +9,21 @@
 #include "complex/Filter/Actions/CreateArrayAction.hpp"
 #include "complex/Parameters/ArrayCreationParameter.hpp"
 #include "complex/Parameters/BoolParameter.hpp"
+#include "complex/Parameters/ChoicesParameter.hpp"
 #include "complex/Parameters/DataPathSelectionParameter.hpp"
 #include "complex/Parameters/NumberParameter.hpp"
+#include "complex/Utilities/ParallelDataAlgorithm.hpp"
 
 #include "ComplexCore/utils/nanoflann.hpp"
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <utility>
+
 namespace complex
 {
 namespace
@@ -22,38 +32,36 @@ constexpr int32 k_MissingMovingVertex = -4500;
 constexpr int32 k_MissingTargetVertex = -4501;
 constexpr int32 k_BadNumIterations = -4502;
 constexpr int32 k_MissingVertices = -4503;
+constexpr int32 k_BadRmsTolerance = -4504;
+constexpr int32 k_BadSubsampling = -4505;
+
+constexpr ChoicesParameter::ValueType k_NoSubsampling = 0;
+constexpr ChoicesParameter::ValueType k_RandomSubsampling = 1;
+constexpr ChoicesParameter::ValueType k_VoxelGridSubsampling = 2;
+
+// The random subsample is seeded with a constant so that registrations can be repeated
+constexpr std::mt19937_64::result_type k_SubsampleSeed = 5489;
+constexpr usize k_MinPointsPerRange = 1 << 14;
+
+using Transform = Eigen::Matrix4d;
 
-template <typename Derived>
 struct VertexGeomAdaptor
 {
-  const Derived& obj;
-  Float32Array* verts;
-  size_t m_NumComponents = 0;
-  size_t m_NumTuples = 0;
-
-  VertexGeomAdaptor(const Derived& obj_)
-  : obj(obj_)
-  {
-    // These values never change for the life time of this object so cache them now.
-    verts = derived()->getVertices();
-    m_NumComponents = verts->getNumberOfComponents();
-    m_NumTuples = verts->getNumberOfTuples();
-  }
+  nonstd::span<const float32> verts;
 
-  inline const Derived& derived() const
+  explicit VertexGeomAdaptor(const VertexGeom& vertexGeom)
+  : verts(std::as_const(*vertexGeom.getVertices()).createSpan().first(vertexGeom.getNumberOfVertices() * 3))
   {
-    return obj;
   }
 
   inline usize kdtree_get_point_count() const
   {
-    return m_NumTuples;
+    return verts.size() / 3;
   }
 
   inline float kdtree_get_pt(const usize idx, const usize dim) const
   {
-    auto offset = idx * m_NumComponents;
-    return (*verts)[offset + dim];
+    return verts[idx * 3 + dim];
   }
 
   template <class BBOX>
@@ -62,6 +70,155 @@ struct VertexGeomAdaptor
     return false;
   }
 };
+
+using KDtree = nanoflann::KDTreeSingleIndexAdaptor<nanoflann::L2_Adaptor<float32, VertexGeomAdaptor>, VertexGeomAdaptor, 3>;
+
+/**
+ * @brief Sums the values of the function over [0, count) in parallel. The sums of a
+ * fixed set of ranges are added in order, so the result does not depend on how the
+ * ranges were scheduled.
+ */
+template <typename ValueT, typename FunctionT>
+ValueT ParallelSum(usize count, ValueT zero, FunctionT&& function)
+{
+  const usize numRanges = GetNumRanges(count, k_MinPointsPerRange);
+  std::vector<ValueT> rangeSums(numRanges, zero);
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, numRanges);
+  dataAlg.execute([&](const ComplexRange& ranges) {
+    for(usize range = ranges.min(); range < ranges.max(); range++)
+    {
+      ValueT sum = zero;
+      const ComplexRange points = GetRange(count, numRanges, range);
+      for(usize i = points.min(); i < points.max(); i++)
+      {
+        sum += function(i);
+      }
+      rangeSums[range] = sum;
+    }
+  });
+  ValueT total = zero;
+  for(const ValueT& sum : rangeSums)
+  {
+    total += sum;
+  }
+  return total;
+}
+
+/**
+ * @brief Returns the moving points that are registered during the coarse iterations.
+ */
+std::vector<usize> CreateSubsample(nonstd::span<const float32> movingVerts, ChoicesParameter::ValueType method, float32 fraction, float32 voxelSize)
+{
+  const usize numVerts = movingVerts.size() / 3;
+  std::vector<usize> subsample;
+  if(method == k_RandomSubsampling)
+  {
+    const usize numSamples = std::clamp<usize>(static_cast<usize>(std::llround(fraction * static_cast<float64>(numVerts))), 1, numVerts);
+    subsample.resize(numVerts);
+    std::iota(subsample.begin(), subsample.end(), 0);
+    std::mt19937_64 generator(k_SubsampleSeed);
+    for(usize i = 0; i < numSamples; i++)
+    {
+      std::uniform_int_distribution<usize> distribution(i, numVerts - 1);
+      std::swap(subsample[i], subsample[distribution(generator)]);
+    }
+    subsample.resize(numSamples);
+    // Visit the samples in memory order
+    std::sort(subsample.begin(), subsample.end());
+  }
+  else if(method == k_VoxelGridSubsampling)
+  {
+    // Keep the first point that falls into each cell of a grid with the given spacing. The
+    // points are sorted by cell and then by index so that each cell's first point leads its run.
+    std::vector<std::pair<std::array<int64, 3>, usize>> cellPoints(numVerts);
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(0, numVerts);
+    dataAlg.execute([&](const ComplexRange& range) {
+      for(usize i = range.min(); i < range.max(); i++)
+      {
+        const std::array<int64, 3> cell = {static_cast<int64>(std::floor(movingVerts[3 * i + 0] / voxelSize)), static_cast<int64>(std::floor(movingVerts[3 * i + 1] / voxelSize)),
+                                           static_cast<int64>(std::floor(movingVerts[3 * i + 2] / voxelSize))};
+        cellPoints[i] = {cell, i};
+      }
+    });
+    std::sort(cellPoints.begin(), cellPoints.end());
+    for(usize i = 0; i < numVerts; i++)
+    {
+      if(i == 0 || cellPoints[i].first != cellPoints[i - 1].first)
+      {
+        subsample.push_back(cellPoints[i].second);
+      }
+    }
+    std::sort(subsample.begin(), subsample.end());
+  }
+  return subsample;
+}
+
+/**
+ * @brief Moves the points by the current transform, pairs each with its closest target
+ * point and returns the rigid transform that best maps the moving points onto their
+ * pairs [Umeyama 1991]. The root mean square distance between the pairs is returned
+ * in rms.
+ */
+Transform RegisterIteration(const KDtree& index, nonstd::span<const float32> movingVerts, nonstd::span<const float32> targetVerts, const std::vector<usize>& subsample,
+                            const Transform& globalTransform, std::vector<usize>& closestPoints, float64& rms)
+{
+  const bool useSubsample = !subsample.empty();
+  const usize numPoints = useSubsample ? subsample.size() : movingVerts.size() / 3;
+  const auto movedPoint = [&](usize i) -> Eigen::Vector3d {
+    const usize vertex = useSubsample ? subsample[i] : i;
+    const Eigen::Vector4d position(movingVerts[3 * vertex + 0], movingVerts[3 * vertex + 1], movingVerts[3 * vertex + 2], 1.0);
+    return (globalTransform * position).head<3>();
+  };
+  const auto targetPoint = [&](usize i) -> Eigen::Vector3d {
+    const usize vertex = closestPoints[i];
+    return {targetVerts[3 * vertex + 0], targetVerts[3 * vertex + 1], targetVerts[3 * vertex + 2]};
+  };
+
+  // The kd-tree is only read, so the queries can run in parallel
+  closestPoints.resize(numPoints);
+  std::vector<float32> squaredDistances(numPoints);
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, numPoints);
+  dataAlg.execute([&](const ComplexRange& range) {
+    for(usize i = range.min(); i < range.max(); i++)
+    {
+      const Eigen::Vector3f query = movedPoint(i).cast<float32>();
+      usize id = 0;
+      float32 dist = 0.0f;
+      nanoflann::KNNResultSet<float32> results(1);
+      results.init(&id, &dist);
+      index.findNeighbors(results, query.data(), nanoflann::SearchParams());
+      closestPoints[i] = id;
+      squaredDistances[i] = dist;
+    }
+  });
+  rms = std::sqrt(ParallelSum(numPoints, 0.0, [&](usize i) { return static_cast<float64>(squaredDistances[i]); }) / static_cast<float64>(numPoints));
+
+  using Vector6d = Eigen::Matrix<float64, 6, 1>;
+  const Vector6d sums = ParallelSum(numPoints, Vector6d::Zero().eval(), [&](usize i) {
+    Vector6d pair;
+    pair << movedPoint(i), targetPoint(i);
+    return pair;
+  });
+  const Eigen::Vector3d movingMean = sums.head<3>() / static_cast<float64>(numPoints);
+  const Eigen::Vector3d targetMean = sums.tail<3>() / static_cast<float64>(numPoints);
+  const Eigen::Matrix3d covariance =
+      ParallelSum(numPoints, Eigen::Matrix3d::Zero().eval(), [&](usize i) { return ((targetPoint(i) - targetMean) * (movedPoint(i) - movingMean).transpose()).eval(); }) /
+      static_cast<float64>(numPoints);
+
+  Eigen::JacobiSVD<Eigen::Matrix3d> svd(covariance, Eigen::ComputeFullU | Eigen::ComputeFullV);
+  Eigen::Vector3d reflection = Eigen::Vector3d::Ones();
+  if(svd.matrixU().determinant() * svd.matrixV().determinant() < 0.0)
+  {
+    reflection(2) = -1.0;
+  }
+  Transform transform = Transform::Identity();
+  transform.topLeftCorner<3, 3>() = svd.matrixU() * reflection.asDiagonal() * svd.matrixV().transpose();
+  transform.topRightCorner<3, 1>() = targetMean - transform.topLeftCorner<3, 3>() * movingMean;
+  return transform;
+}
 } // namespace
 
 std::string IterativeClosestPointFilter::name() const
@@ -88,9 +245,21 @@ Parameters IterativeClosestPointFilter::parameters() const
 {
   Parameters params;
 
-  params.insert(std::make_unique<UInt64Parameter>(k_NumIterations_Key, "Number of Iterations", "Number of components", 1));
+  params.insert(std::make_unique<UInt64Parameter>(k_NumIterations_Key, "Number of Iterations", "Maximum number of registration iterations", 1));
+  params.insert(std::make_unique<Float64Parameter>(k_RmsTolerance_Key, "RMS Change Tolerance",
+                                                   "Registration stops once the root mean square distance changes by less than this between iterations. 0 runs every iteration", 0.0));
   params.insert(std::make_unique<BoolParameter>(k_ApplyTransformation_Key, "Apply Transformation to Moving Geometry", "Number of components", false));
 
+  params.insertSeparator(Parameters::Separator{"Coarse Registration"});
+  params.insertLinkableParameter(std::make_unique<ChoicesParameter>(k_SubsamplingMethod_Key, "Subsampling Method", "How the moving points are thinned for the coarse iterations", k_NoSubsampling,
+                                                                    ChoicesParameter::Choices{"None", "Random", "Voxel Grid"}));
+  params.insert(std::make_unique<Float32Parameter>(k_SubsampleFraction_Key, "Subsample Fraction", "Fraction of the moving points that are randomly kept", 0.1f));
+  params.insert(std::make_unique<Float32Parameter>(k_SubsampleVoxelSize_Key, "Subsample Voxel Size", "Edge length of the grid cells that each keep one moving point", 1.0f));
+  params.insert(std::make_unique<UInt64Parameter>(k_NumCoarseIterations_Key, "Number of Coarse Iterations", "Maximum number of iterations that use the subsampled moving points", 10));
+  params.linkParameters(k_SubsamplingMethod_Key, k_SubsampleFraction_Key, std::make_any<ChoicesParameter::ValueType>(k_RandomSubsampling));
+  params.linkParameters(k_SubsamplingMethod_Key, k_SubsampleVoxelSize_Key, std::make_any<ChoicesParameter::ValueType>(k_VoxelGridSubsampling));
+
+  params.insertSeparator(Parameters::Separator{"Input Geometries"});
   params.insert(std::make_unique<DataPathSelectionParameter>(k_MovingVertexPath_Key, "Moving Vertex Geometry", "Numeric Type of data to create", DataPath()));
   params.insert(std::make_unique<DataPathSelectionParameter>(k_TargetVertexPath_Key, "Target Vertex Geometry", "Number of components", DataPath()));
 
@@ -108,6 +277,10 @@ IFilter::PreflightResult IterativeClosestPointFilter::preflightImpl(const DataSt
   auto movingVertexPath = args.value<DataPath>(k_MovingVertexPath_Key);
   auto targetVertexPath = args.value<DataPath>(k_TargetVertexPath_Key);
   auto numIterations = args.value<uint64>(k_NumIterations_Key);
+  auto rmsTolerance = args.value<float64>(k_RmsTolerance_Key);
+  auto subsamplingMethod = args.value<ChoicesParameter::ValueType>(k_SubsamplingMethod_Key);
+  auto subsampleFraction = args.value<float32>(k_SubsampleFraction_Key);
+  auto subsampleVoxelSize = args.value<float32>(k_SubsampleVoxelSize_Key);
   //  auto applytransformation = args.value<bool>(k_ApplyTransformation_Key);
   auto transformArrayPath = args.value<DataPath>(k_TransformArrayPath_Key);
 
@@ -127,6 +300,27 @@ IFilter::PreflightResult IterativeClosestPointFilter::preflightImpl(const DataSt
     auto ss = fmt::format("Must perform at least 1 iterations");
     return {nonstd::make_unexpected(std::vector<Error>{Error{k_BadNumIterations, ss}})};
   }
+  if(rmsTolerance < 0.0)
+  {
+    auto ss = fmt::format("RMS change tolerance must not be negative");
+    return {nonstd::make_unexpected(std::vector<Error>{Error{k_BadRmsTolerance, ss}})};
+  }
+
+  if(subsamplingMethod > k_VoxelGridSubsampling)
+  {
+    auto ss = fmt::format("Subsampling method {} is not valid", subsamplingMethod);
+    return {nonstd::make_unexpected(std::vector<Error>{Error{k_BadSubsampling, ss}})};
+  }
+  if(subsamplingMethod == k_RandomSubsampling && (subsampleFraction <= 0.0f || subsampleFraction > 1.0f))
+  {
+    auto ss = fmt::format("Subsample fraction must be greater than 0 and at most 1");
+    return {nonstd::make_unexpected(std::vector<Error>{Error{k_BadSubsampling, ss}})};
+  }
+  if(subsamplingMethod == k_VoxelGridSubsampling && subsampleVoxelSize <= 0.0f)
+  {
+    auto ss = fmt::format("Subsample voxel size must be greater than 0");
+    return {nonstd::make_unexpected(std::vector<Error>{Error{k_BadSubsampling, ss}})};
+  }
 
   usize numTuples = 1;
   auto action = std::make_unique<CreateArrayAction>(DataType::float32, std::vector<usize>{numTuples}, std::vector<usize>{16}, transformArrayPath);
@@ -143,6 +337,11 @@ Result<> IterativeClosestPointFilter::executeImpl(DataStructure& data, const Arg
   auto movingVertexPath = args.value<DataPath>(k_MovingVertexPath_Key);
   auto targetVertexPath = args.value<DataPath>(k_TargetVertexPath_Key);
   auto numIterations = args.value<uint64>(k_NumIterations_Key);
+  auto rmsTolerance = args.value<float64>(k_RmsTolerance_Key);
+  auto subsamplingMethod = args.value<ChoicesParameter::ValueType>(k_SubsamplingMethod_Key);
+  auto subsampleFraction = args.value<float32>(k_SubsampleFraction_Key);
+  auto subsampleVoxelSize = args.value<float32>(k_SubsampleVoxelSize_Key);
+  auto maxCoarseIterations = args.value<uint64>(k_NumCoarseIterations_Key);
   auto applyTransformation = args.value<bool>(k_ApplyTransformation_Key);
   auto transformArrayPath = args.value<DataPath>(k_TransformArrayPath_Key);
 
@@ -171,103 +370,93 @@ Result<> IterativeClosestPointFilter::executeImpl(DataStructure& data, const Arg
     return {nonstd::make_unexpected(std::vector<Error>{Error{k_MissingVertices, ss}})};
   }
 
-  auto* movingPtr = movingVertexGeom->getVertices();
-  Float32Array& targetPtr = *(targetVertexGeom->getVertices());
-
-  auto* movingStore = movingPtr->getDataStore();
-  std::vector<float32> movingVector(movingStore->begin(), movingStore->end());
-  float32* movingCopyPtr = movingVector.data();
-  DataStructure tmp;
+  if(movingVertexGeom->getNumberOfVertices() == 0 || targetVertexGeom->getNumberOfVertices() == 0)
+  {
+    auto ss = fmt::format("Moving and Target Vertex Geometries must each contain at least one vertex");
+    return {nonstd::make_unexpected(std::vector<Error>{Error{k_MissingVertices, ss}})};
+  }
 
-  usize numMovingVerts = movingVertexGeom->getNumberOfVertices();
-  std::vector<float32> dynTarget(numMovingVerts * 3, 0.0F);
-  float* dynTargetPtr = dynTarget.data();
+  Float32Array& movingArray = *(movingVertexGeom->getVertices());
+  const usize numMovingVerts = movingVertexGeom->getNumberOfVertices();
+  const nonstd::span<const float32> movingVerts = std::as_const(movingArray).createSpan().first(numMovingVerts * 3);
 
-  using Adaptor = VertexGeomAdaptor<VertexGeom*>;
-  const Adaptor adaptor(targetVertexGeom);
+  const VertexGeomAdaptor adaptor(*targetVertexGeom);
 
   messageHandler("Building kd-tree index...");
 
-  using KDtree = nanoflann::KDTreeSingleIndexAdaptor<nanoflann::L2_Adaptor<float32, Adaptor>, Adaptor, 3>;
+  // The index of the target points does not change between iterations, so it is built once
   KDtree index(3, adaptor, nanoflann::KDTreeSingleIndexAdaptorParams(30));
   index.buildIndex();
 
-  usize iters = numIterations;
-  const usize nn = 1;
-
-  typedef Eigen::Matrix<float, 3, Eigen::Dynamic, Eigen::ColMajor> PointCloud;
-  typedef Eigen::Matrix<float, 4, 4, Eigen::ColMajor> UmeyamaTransform;
-
-  UmeyamaTransform globalTransform;
-  globalTransform << 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1;
+  // The moving points are left in place and moved by the accumulated transform when
+  // they are queried, which avoids rounding the points again in every iteration
+  Transform globalTransform = Transform::Identity();
+  std::vector<usize> closestPoints;
 
-  int64 progIncrement = iters / 100;
-  int64 prog = 1;
-  int64 progressInt = 0;
-  int64 counter = 0;
-
-  for(usize i = 0; i < iters; i++)
+  const std::vector<usize> subsample = CreateSubsample(movingVerts, subsamplingMethod, subsampleFraction, subsampleVoxelSize);
+  const usize numCoarseIterations = subsample.empty() ? 0 : std::min(maxCoarseIterations, numIterations);
+  if(!subsample.empty())
   {
-    if(shouldCancel)
-    {
-      return {};
-    }
+    messageHandler(fmt::format("Registering {} of {} moving points for up to {} coarse iterations", subsample.size(), numMovingVerts, numCoarseIterations));
+  }
 
-    for(usize j = 0; j < numMovingVerts; j++)
+  usize iteration = 0;
+  float64 rms = 0.0;
+  // Runs the iterations of one stage until the change of the RMS distance falls below the tolerance
+  const auto runStage = [&](const std::vector<usize>& points, usize stageEnd) {
+    float64 previousRms = std::numeric_limits<float64>::max();
+    for(; iteration < stageEnd; iteration++)
     {
-      usize id;
-      float dist;
-      nanoflann::KNNResultSet<float> results(nn);
-      results.init(&id, &dist);
-      index.findNeighbors(results, movingCopyPtr + (3 * j), nanoflann::SearchParams());
-      dynTargetPtr[3 * j + 0] = targetPtr[3 * id + 0];
-      dynTargetPtr[3 * j + 1] = targetPtr[3 * id + 1];
-      dynTargetPtr[3 * j + 2] = targetPtr[3 * id + 2];
-    }
-
-    Eigen::Map<PointCloud> moving_(movingCopyPtr, 3, numMovingVerts);
-    Eigen::Map<PointCloud> target_(dynTargetPtr, 3, numMovingVerts);
-
-    UmeyamaTransform transform = Eigen::umeyama(moving_, target_, false);
+      if(shouldCancel)
+      {
+        return;
+      }
 
-    for(usize j = 0; j < numMovingVerts; j++)
-    {
-      Eigen::Vector4f position(movingCopyPtr[3 * j + 0], movingCopyPtr[3 * j + 1], movingCopyPtr[3 * j + 2], 1);
-      Eigen::Vector4f transformedPosition = transform * position;
-      std::memcpy(movingCopyPtr + (3 * j), transformedPosition.data(), sizeof(float) * 3);
-    }
-    // Update the global transform
-    globalTransform = transform * globalTransform;
+      const Transform transform = RegisterIteration(index, movingVerts, adaptor.verts, points, globalTransform, closestPoints, rms);
+      globalTransform = transform * globalTransform;
 
-    if(counter > prog)
-    {
-      progressInt = static_cast<int64>((static_cast<float>(counter) / iters) * 100.0f);
-      std::string ss = fmt::format("Performing Registration Iterations || {}% Completed", progressInt);
-      messageHandler(ss);
-      prog = prog + progIncrement;
+      messageHandler(fmt::format("Performing Registration Iterations || Iteration {} of {} || RMS Distance {}", iteration + 1, numIterations, rms));
+      if(std::abs(previousRms - rms) < rmsTolerance)
+      {
+        iteration++;
+        return;
+      }
+      previousRms = rms;
     }
-    counter++;
+  };
+  runStage(subsample, numCoarseIterations);
+  runStage({}, numIterations);
+  if(shouldCancel)
+  {
+    return {};
   }
+  messageHandler(fmt::format("Registration finished after {} iterations with an RMS distance of {}", iteration, rms));
 
   auto* transformPtr = data.getDataAs<Float32Array>(transformArrayPath)->getDataStore();
 
   if(applyTransformation)
   {
-    for(usize j = 0; j < numMovingVerts; j++)
-    {
-      Eigen::Vector4f position((*movingPtr)[3 * j + 0], (*movingPtr)[3 * j + 1], (*movingPtr)[3 * j + 2], 1);
-      Eigen::Vector4f transformedPosition = globalTransform * position;
-      for(usize k = 0; k < 3; k++)
+    const nonstd::span<float32> vertices = movingArray.createSpan();
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(0, numMovingVerts);
+    dataAlg.execute([&](const ComplexRange& range) {
+      for(usize j = range.min(); j < range.max(); j++)
       {
-        (*movingPtr)[3 * j + k] = transformedPosition.data()[k];
+        const Eigen::Vector4d position(vertices[3 * j + 0], vertices[3 * j + 1], vertices[3 * j + 2], 1.0);
+        const Eigen::Vector4d transformedPosition = globalTransform * position;
+        for(usize k = 0; k < 3; k++)
+        {
+          vertices[3 * j + k] = static_cast<float32>(transformedPosition[k]);
+        }
       }
-    }
+    });
   }
 
-  globalTransform.transposeInPlace();
+  // The transform is written in row major order
+  const Transform transposedTransform = globalTransform.transpose();
   for(usize j = 0; j < 16; j++)
   {
-    (*transformPtr)[j] = globalTransform.data()[j];
+    (*transformPtr)[j] = static_cast<float32>(transposedTransform.data()[j]);
   }
 
   return {};
@@ -26,6 +26,11 @@ public:
   static inline constexpr StringLiteral k_NumIterations_Key = "num_iterations";
   static inline constexpr StringLiteral k_ApplyTransformation_Key = "apply_transformation";
   static inline constexpr StringLiteral k_TransformArrayPath_Key = "transform_array";
+  static inline constexpr StringLiteral k_RmsTolerance_Key = "rms_tolerance";
+  static inline constexpr StringLiteral k_SubsamplingMethod_Key = "subsampling_method";
+  static inline constexpr StringLiteral k_SubsampleFraction_Key = "subsample_fraction";
+  static inline constexpr StringLiteral k_SubsampleVoxelSize_Key = "subsample_voxel_size";
+  static inline constexpr StringLiteral k_NumCoarseIterations_Key = "num_coarse_iterations";
 
   /**
    * @brief
@@ -0,0 +1,186 @@
+#include "LabelConnectedComponentsFilter.hpp"
+
+#include "complex/DataStructure/DataArray.hpp"
+#include "complex/DataStructure/Geometry/ImageGeom.hpp"
+#include "complex/Filter/Actions/CreateArrayAction.hpp"
+#include "complex/Parameters/ArrayCreationParameter.hpp"
+#include "complex/Parameters/ArraySelectionParameter.hpp"
+#include "complex/Parameters/ChoicesParameter.hpp"
+#include "complex/Parameters/GeometrySelectionParameter.hpp"
+#include "complex/Utilities/ConnectedComponents.hpp"
+
+#include <algorithm>
+
+using namespace complex;
+
+namespace
+{
+constexpr int32 k_MissingGeometryError = -7360;
+constexpr int32 k_MissingMaskError = -7361;
+constexpr int32 k_MaskComponentsError = -7362;
+constexpr int32 k_MaskTuplesError = -7363;
+constexpr int32 k_InvalidConnectivityError = -7364;
+constexpr int32 k_LabelingError = -7365;
+
+// -----------------------------------------------------------------------------
+template <typename T>
+std::vector<usize> LabelMask(DataStructure& dataStructure, const DataPath& maskArrayPath, const SizeVec3& dims, ConnectedComponents::Connectivity connectivity, nonstd::span<int32> featureIds)
+{
+  auto& maskArray = dataStructure.getDataRefAs<DataArray<T>>(maskArrayPath);
+  return ConnectedComponents::Label(dims, nonstd::span<const T>(maskArray.createSpan()), true, connectivity, featureIds);
+}
+} // namespace
+
+namespace complex
+{
+//------------------------------------------------------------------------------
+std::string LabelConnectedComponentsFilter::name() const
+{
+  return FilterTraits<LabelConnectedComponentsFilter>::name.str();
+}
+
+//------------------------------------------------------------------------------
+std::string LabelConnectedComponentsFilter::className() const
+{
+  return FilterTraits<LabelConnectedComponentsFilter>::className;
+}
+
+//------------------------------------------------------------------------------
+Uuid LabelConnectedComponentsFilter::uuid() const
+{
+  return FilterTraits<LabelConnectedComponentsFilter>::uuid;
+}
+
+//------------------------------------------------------------------------------
+std::string LabelConnectedComponentsFilter::humanName() const
+{
+  return "Label Connected Components";
+}
+
+//------------------------------------------------------------------------------
+std::vector<std::string> LabelConnectedComponentsFilter::defaultTags() const
+{
+  return {"#Reconstruction", "#Segmentation", "#Connected Components"};
+}
+
+//------------------------------------------------------------------------------
+Parameters LabelConnectedComponentsFilter::parameters() const
+{
+  Parameters params;
+  // Create the parameter descriptors that are needed for this filter
+  params.insertSeparator(Parameters::Separator{"Input Parameters"});
+  params.insert(std::make_unique<ChoicesParameter>(k_Connectivity_Key, "Connectivity", "Which neighbors of a Cell belong to the same component as the Cell", 0,
+                                                   ChoicesParameter::Choices{"6 (Faces)", "18 (Faces and Edges)", "26 (Faces, Edges and Vertices)"}));
+
+  params.insertSeparator(Parameters::Separator{"Required Input Cell Data"});
+  params.insert(std::make_unique<GeometrySelectionParameter>(k_ImageGeom_Key, "Image Geometry", "DataPath to the target ImageGeom", DataPath(),
+                                                             GeometrySelectionParameter::AllowedTypes{AbstractGeometry::Type::Image}));
+  params.insert(std::make_unique<ArraySelectionParameter>(k_MaskArrayPath_Key, "Mask", "Cells with a true mask value are labeled", DataPath({"Mask"}),
+                                                          ArraySelectionParameter::AllowedTypes{DataType::boolean, DataType::uint8}));
+
+  params.insertSeparator(Parameters::Separator{"Created Cell Data"});
+  params.insert(std::make_unique<ArrayCreationParameter>(k_FeatureIdsArrayPath_Key, "Feature Ids", "The component that each Cell belongs to", DataPath({"FeatureIds"})));
+
+  params.insertSeparator(Parameters::Separator{"Created Feature Data"});
+  params.insert(
+      std::make_unique<ArrayCreationParameter>(k_ComponentSizesArrayPath_Key, "Component Sizes", "The number of Cells in each component", DataPath({"ComponentSizes"})));
+
+  return params;
+}
+
+//------------------------------------------------------------------------------
+IFilter::UniquePointer LabelConnectedComponentsFilter::clone() const
+{
+  return std::make_unique<LabelConnectedComponentsFilter>();
+}
+
+//------------------------------------------------------------------------------
+IFilter::PreflightResult LabelConnectedComponentsFilter::preflightImpl(const DataStructure& dataStructure, const Arguments& filterArgs, const MessageHandler& messageHandler,
+                                                                       const std::atomic_bool& shouldCancel) const
+{
+  auto pImageGeomPathValue = filterArgs.value<DataPath>(k_ImageGeom_Key);
+  auto pMaskArrayPathValue = filterArgs.value<DataPath>(k_MaskArrayPath_Key);
+  auto pConnectivityValue = filterArgs.value<ChoicesParameter::ValueType>(k_Connectivity_Key);
+  auto pFeatureIdsArrayPathValue = filterArgs.value<DataPath>(k_FeatureIdsArrayPath_Key);
+  auto pComponentSizesArrayPathValue = filterArgs.value<DataPath>(k_ComponentSizesArrayPath_Key);
+
+  const auto* imageGeom = dataStructure.getDataAs<ImageGeom>(pImageGeomPathValue);
+  if(imageGeom == nullptr)
+  {
+    return {MakeErrorResult<OutputActions>(k_MissingGeometryError, fmt::format("Could not find ImageGeom at path '{}'", pImageGeomPathValue.toString()))};
+  }
+
+  const auto* maskArray = dataStructure.getDataAs<IDataArray>(pMaskArrayPathValue);
+  if(maskArray == nullptr)
+  {
+    return {MakeErrorResult<OutputActions>(k_MissingMaskError, fmt::format("Could not find the mask array at path '{}'", pMaskArrayPathValue.toString()))};
+  }
+  if(maskArray->getNumberOfComponents() != 1)
+  {
+    return {MakeErrorResult<OutputActions>(k_MaskComponentsError, fmt::format("The mask array must have 1 component but has {}", maskArray->getNumberOfComponents()))};
+  }
+  if(maskArray->getNumberOfTuples() != imageGeom->getNumberOfElements())
+  {
+    return {MakeErrorResult<OutputActions>(k_MaskTuplesError, fmt::format("The mask array has {} tuples but the ImageGeom has {} cells", maskArray->getNumberOfTuples(),
+                                                                          imageGeom->getNumberOfElements()))};
+  }
+  if(pConnectivityValue > static_cast<ChoicesParameter::ValueType>(ConnectedComponents::Connectivity::FaceEdgeVertex))
+  {
+    return {MakeErrorResult<OutputActions>(k_InvalidConnectivityError, fmt::format("The connectivity choice {} is not valid", pConnectivityValue))};
+  }
+
+  complex::Result<OutputActions> resultOutputActions;
+
+  {
+    auto createFeatureIdsAction = std::make_unique<CreateArrayAction>(DataType::int32, maskArray->getIDataStore()->getTupleShape(), std::vector<usize>{1}, pFeatureIdsArrayPathValue);
+    resultOutputActions.value().actions.push_back(std::move(createFeatureIdsAction));
+  }
+  // The number of components is only known after execution
+  {
+    auto createComponentSizesAction = std::make_unique<CreateArrayAction>(DataType::uint64, std::vector<usize>{1}, std::vector<usize>{1}, pComponentSizesArrayPathValue);
+    resultOutputActions.value().actions.push_back(std::move(createComponentSizesAction));
+  }
+
+  std::vector<PreflightValue> preflightUpdatedValues;
+
+  return {std::move(resultOutputActions), std::move(preflightUpdatedValues)};
+}
+
+//------------------------------------------------------------------------------
+Result<> LabelConnectedComponentsFilter::executeImpl(DataStructure& dataStructure, const Arguments& filterArgs, const PipelineFilter* pipelineNode, const MessageHandler& messageHandler,
+                                                     const std::atomic_bool& shouldCancel) const
+{
+  auto pImageGeomPathValue = filterArgs.value<DataPath>(k_ImageGeom_Key);
+  auto pMaskArrayPathValue = filterArgs.value<DataPath>(k_MaskArrayPath_Key);
+  auto pConnectivityValue = filterArgs.value<ChoicesParameter::ValueType>(k_Connectivity_Key);
+  auto pFeatureIdsArrayPathValue = filterArgs.value<DataPath>(k_FeatureIdsArrayPath_Key);
+  auto pComponentSizesArrayPathValue = filterArgs.value<DataPath>(k_ComponentSizesArrayPath_Key);
+
+  const SizeVec3 dims = dataStructure.getDataRefAs<ImageGeom>(pImageGeomPathValue).getDimensions();
+  const auto connectivity = static_cast<ConnectedComponents::Connectivity>(pConnectivityValue);
+  nonstd::span<int32> featureIds = dataStructure.getDataRefAs<Int32Array>(pFeatureIdsArrayPathValue).createSpan();
+
+  std::vector<usize> sizes;
+  try
+  {
+    if(dataStructure.getDataRefAs<IDataArray>(pMaskArrayPathValue).getDataType() == DataType::boolean)
+    {
+      sizes = LabelMask<bool>(dataStructure, pMaskArrayPathValue, dims, connectivity, featureIds);
+    }
+    else
+    {
+      sizes = LabelMask<uint8>(dataStructure, pMaskArrayPathValue, dims, connectivity, featureIds);
+    }
+  } catch(const std::exception& exception)
+  {
+    return MakeErrorResult(k_LabelingError, exception.what());
+  }
+
+  // Feature 0 holds the number of Cells that are not part of any component
+  auto& componentSizes = dataStructure.getDataRefAs<UInt64Array>(pComponentSizesArrayPathValue);
+  componentSizes.getDataStore()->reshapeTuples(std::vector<usize>{sizes.size()});
+  std::copy(sizes.cbegin(), sizes.cend(), componentSizes.begin());
+
+  return {};
+}
+} // namespace complex
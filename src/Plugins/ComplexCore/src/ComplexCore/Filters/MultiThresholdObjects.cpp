@@ -4,329 +4,239 @@
 #include "complex/Filter/Actions/CreateArrayAction.hpp"
 #include "complex/Parameters/ArrayCreationParameter.hpp"
 #include "complex/Parameters/ArrayThresholdsParameter.hpp"
+#include "complex/Parameters/ChoicesParameter.hpp"
 #include "complex/Utilities/ArrayThreshold.hpp"
+#include "complex/Utilities/FilterUtilities.hpp"
+#include "complex/Utilities/ParallelDataAlgorithm.hpp"
+
+#include <algorithm>
+#include <functional>
 
 namespace complex
 {
 namespace
 {
-constexpr StringLiteral k_ArrayThresholds_Key = "array_thresholds";
-constexpr StringLiteral k_CreatedDataPath_Key = "created_data_path";
-
 constexpr int64 k_PathNotFoundError = -178;
 
-class ThresholdFilterHelper
+constexpr usize k_BoolMaskType = 0;
+constexpr usize k_UInt8MaskType = 1;
+
+/**
+ * @brief Number of tuples each instruction of a ThresholdProgram is evaluated over before
+ * moving on to the next instruction. Small enough that the intermediate results for every
+ * level of the threshold tree stay in cache.
+ */
+constexpr usize k_ThresholdBlockSize = 4096;
+
+/**
+ * @brief How a comparison result is merged into the result of the enclosing ArrayThresholdSet.
+ * The first threshold of every set replaces the result.
+ */
+enum class CombineOperator : uint8
 {
-public:
-  ThresholdFilterHelper(complex::ArrayThreshold::ComparisonType compType, complex::ArrayThreshold::ComparisonValue compValue, std::vector<bool>& output)
-  : m_ComparisonOperator(compType)
-  , m_ComparisonValue(compValue)
-  , m_Output(output)
-  {
-  }
+  Replace,
+  And,
+  Or
+};
 
-  ~ThresholdFilterHelper() = default;
+// -----------------------------------------------------------------------------
+CombineOperator ToCombineOperator(IArrayThreshold::UnionOperator unionOperator)
+{
+  return unionOperator == IArrayThreshold::UnionOperator::Or ? CombineOperator::Or : CombineOperator::And;
+}
 
-  /**
-   * @brief
-   */
-  template <typename T>
-  void filterDataLessThan(const DataArray<T>& m_Input)
+// -----------------------------------------------------------------------------
+template <typename T, typename CompareT>
+void CompareBlock(const T* input, usize count, T value, CompareT compare, CombineOperator combine, bool inverse, uint8* result)
+{
+  // Branch free loops over uint8 results so that the compiler can vectorize each combination
+  const uint8 flip = inverse ? 1 : 0;
+  switch(combine)
   {
-    size_t m_NumValues = m_Input.getNumberOfTuples();
-    T value = static_cast<T>(m_ComparisonValue);
-    for(size_t i = 0; i < m_NumValues; ++i)
+  case CombineOperator::Replace:
+    for(usize i = 0; i < count; i++)
     {
-      m_Output[i] = (m_Input[i] < value);
+      result[i] = static_cast<uint8>(compare(input[i], value)) ^ flip;
     }
-  }
-
-  /**
-   * @brief
-   */
-  template <typename T>
-  void filterDataGreaterThan(const DataArray<T>& m_Input)
-  {
-    size_t m_NumValues = m_Input.getNumberOfTuples();
-    T value = static_cast<T>(m_ComparisonValue);
-    for(size_t i = 0; i < m_NumValues; ++i)
+    break;
+  case CombineOperator::And:
+    for(usize i = 0; i < count; i++)
     {
-      m_Output[i] = (m_Input[i] > value);
+      result[i] &= static_cast<uint8>(compare(input[i], value)) ^ flip;
     }
-  }
-
-  /**
-   * @brief
-   */
-  template <typename T>
-  void filterDataEqualTo(const DataArray<T>& m_Input)
-  {
-    size_t m_NumValues = m_Input.getNumberOfTuples();
-    T value = static_cast<T>(m_ComparisonValue);
-    for(size_t i = 0; i < m_NumValues; ++i)
+    break;
+  case CombineOperator::Or:
+    for(usize i = 0; i < count; i++)
     {
-      m_Output[i] = (m_Input[i] == value);
-    }
-  }
-
-  /**
-   * @brief
-   */
-  template <typename T>
-  void filterDataNotEqualTo(const DataArray<T>& m_Input)
-  {
-    size_t m_NumValues = m_Input.getNumberOfTuples();
-    T value = static_cast<T>(m_ComparisonValue);
-    for(size_t i = 0; i < m_NumValues; ++i)
-    {
-      m_Output[i] = (m_Input[i] != value);
+      result[i] |= static_cast<uint8>(compare(input[i], value)) ^ flip;
     }
+    break;
   }
+}
 
-  template <typename Type>
-  void filterData(const DataArray<Type>& input)
+// -----------------------------------------------------------------------------
+void CombineBlock(const uint8* input, usize count, CombineOperator combine, bool inverse, uint8* result)
+{
+  const uint8 flip = inverse ? 1 : 0;
+  switch(combine)
   {
-    if(m_ComparisonOperator == ArrayThreshold::ComparisonType::LessThan)
+  case CombineOperator::Replace:
+    for(usize i = 0; i < count; i++)
     {
-      filterDataLessThan<Type>(input);
+      result[i] = input[i] ^ flip;
     }
-    else if(m_ComparisonOperator == ArrayThreshold::ComparisonType::GreaterThan)
+    break;
+  case CombineOperator::And:
+    for(usize i = 0; i < count; i++)
     {
-      filterDataGreaterThan<Type>(input);
+      result[i] &= input[i] ^ flip;
     }
-    else if(m_ComparisonOperator == ArrayThreshold::ComparisonType::Operator_Equal)
-    {
-      filterDataEqualTo<Type>(input);
-    }
-    else if(m_ComparisonOperator == ArrayThreshold::ComparisonType::Operator_NotEqual)
-    {
-      filterDataNotEqualTo<Type>(input);
-    }
-    else
-    {
-      std::string errorMessage = fmt::format("MultiThresholdObjects Comparison Operator not understood: '{}'", static_cast<int>(m_ComparisonOperator));
-      throw std::runtime_error(errorMessage);
-    }
-  }
-
-  /**
-   * @brief execute
-   * @param input
-   * @param output
-   * @return
-   */
-  void execute(DataStructure& dataStructure, DataPath& inputArrayDataPath)
-  {
-    const auto& dataArray = dataStructure.getDataRefAs<IDataArray>(inputArrayDataPath);
-
-    DataType type = dataArray.getDataType();
-
-    switch(type)
+    break;
+  case CombineOperator::Or:
+    for(usize i = 0; i < count; i++)
     {
-    case DataType::int8: {
-      filterData<int8>(dynamic_cast<const DataArray<int8>&>(dataArray));
-      break;
-    }
-    case DataType::uint8: {
-      filterData<uint8>(dynamic_cast<const DataArray<uint8>&>(dataArray));
-      break;
-    }
-    case DataType::int16: {
-      filterData<int16>(dynamic_cast<const DataArray<int16>&>(dataArray));
-      break;
-    }
-    case DataType::uint16: {
-      filterData<uint16>(dynamic_cast<const DataArray<uint16>&>(dataArray));
-      break;
-    }
-    case DataType::int32: {
-      filterData<int32>(dynamic_cast<const DataArray<int32>&>(dataArray));
-      break;
-    }
-    case DataType::uint32: {
-      filterData<uint32>(dynamic_cast<const DataArray<uint32>&>(dataArray));
-      break;
-    }
-    case DataType::int64: {
-      filterData<int64>(dynamic_cast<const DataArray<int64>&>(dataArray));
-      break;
-    }
-    case DataType::uint64: {
-      filterData<uint64>(dynamic_cast<const DataArray<uint64>&>(dataArray));
-      break;
-    }
-    case DataType::float32: {
-      filterData<float32>(dynamic_cast<const DataArray<float32>&>(dataArray));
-      break;
-    }
-    case DataType::float64: {
-      filterData<float64>(dynamic_cast<const DataArray<float64>&>(dataArray));
-      break;
-    }
-    case DataType::boolean: {
-      filterData<bool>(dynamic_cast<const DataArray<bool>&>(dataArray));
-      break;
-    }
+      result[i] |= input[i] ^ flip;
     }
+    break;
   }
-
-private:
-  complex::ArrayThreshold::ComparisonType m_ComparisonOperator;
-  complex::ArrayThreshold::ComparisonValue m_ComparisonValue;
-  std::vector<bool>& m_Output;
-
-public:
-  ThresholdFilterHelper(const ThresholdFilterHelper&) = delete;            // Copy Constructor Not Implemented
-  ThresholdFilterHelper(ThresholdFilterHelper&&) = delete;                 // Move Constructor Not Implemented
-  ThresholdFilterHelper& operator=(const ThresholdFilterHelper&) = delete; // Copy Assignment Not Implemented
-  ThresholdFilterHelper& operator=(ThresholdFilterHelper&&) = delete;      // Move Assignment Not Implemented
-};
+}
 
 /**
- * @brief InsertThreshold
- * @param numItems
- * @param currentArrayPtr
- * @param unionOperator
- * @param newArrayPtr
- * @param inverse
+ * @brief Evaluates a single ArrayThreshold over the tuples [start, start + count) into the result block.
  */
-void InsertThreshold(int64_t numItems, BoolArray& currentArray, complex::IArrayThreshold::UnionOperator unionOperator, std::vector<bool>& newArrayPtr, bool inverse)
-{
+using CompareFunction = std::function<void(usize start, usize count, CombineOperator combine, bool inverse, uint8* result)>;
 
-  for(int64_t i = 0; i < numItems; i++)
+struct CreateCompareFunctor
+{
+  template <typename T>
+  CompareFunction operator()(const IDataArray& dataArray, ArrayThreshold::ComparisonType comparisonType, ArrayThreshold::ComparisonValue comparisonValue)
   {
-    // invert the current comparison if necessary
-    if(inverse)
+    const T* input = dynamic_cast<const DataArray<T>&>(dataArray).createSpan().data();
+    const T value = static_cast<T>(comparisonValue);
+    switch(comparisonType)
     {
-      newArrayPtr[i] = !newArrayPtr[i];
-    }
-
-    if(complex::IArrayThreshold::UnionOperator::Or == unionOperator)
-    {
-      currentArray[i] = currentArray[i] || newArrayPtr[i];
-    }
-    else if(!currentArray[i] || !newArrayPtr[i])
-    {
-      currentArray[i] = false;
-    }
+    case ArrayThreshold::ComparisonType::LessThan:
+      return [input, value](usize start, usize count, CombineOperator combine, bool inverse, uint8* result) { CompareBlock(input + start, count, value, std::less<>(), combine, inverse, result); };
+    case ArrayThreshold::ComparisonType::GreaterThan:
+      return [input, value](usize start, usize count, CombineOperator combine, bool inverse, uint8* result) { CompareBlock(input + start, count, value, std::greater<>(), combine, inverse, result); };
+    case ArrayThreshold::ComparisonType::Operator_Equal:
+      return [input, value](usize start, usize count, CombineOperator combine, bool inverse, uint8* result) { CompareBlock(input + start, count, value, std::equal_to<>(), combine, inverse, result); };
+    case ArrayThreshold::ComparisonType::Operator_NotEqual:
+      return [input, value](usize start, usize count, CombineOperator combine, bool inverse, uint8* result) {
+        CompareBlock(input + start, count, value, std::not_equal_to<>(), combine, inverse, result);
+      };
+    }
+    throw std::runtime_error(fmt::format("MultiThresholdObjects Comparison Operator not understood: '{}'", static_cast<int>(comparisonType)));
   }
-}
+};
 
 /**
- * @brief thresholdValue
- * @param comparisonValue
- * @param dataStructure
- * @param outputResultArrayPath
- * @param err
- * @param replaceInput
- * @param inverse
+ * @brief The ThresholdProgram class flattens an ArrayThresholdSet tree into a list of
+ * instructions that are evaluated one block of tuples at a time. The whole tree is applied
+ * in a single parallel pass over the input arrays and writes directly into the mask without
+ * any full size intermediate results.
+ *
+ * Every level of the tree accumulates into its own block sized result. A comparison merges
+ * into the result of its own level, and the end of a nested set merges that set's result
+ * into the level above. Inverting a set inverts the combined result of the set as it is
+ * merged, and inverting the top level set inverts the final result.
  */
-void ThresholdValue(std::shared_ptr<ArrayThreshold>& comparisonValue, DataStructure& dataStructure, DataPath& outputResultArrayPath, int32_t& err, bool replaceInput, bool inverse)
+class ThresholdProgram
 {
-  if(nullptr == comparisonValue)
-  {
-    err = -1;
-    return;
-  }
-  // Traditionally we would do a check to ensure we get a valid pointer, I'm forgoing that check because it
-  // was essentially done in the preflight part.
-  BoolArray& outputResultArray = dataStructure.getDataRefAs<BoolArray>(outputResultArrayPath);
-
-  // Get the total number of tuples, create and initialize an array with FALSE to use for these results
-  size_t totalTuples = outputResultArray.getNumberOfTuples();
-  std::vector<bool> tempResultVector(totalTuples, false);
-
-  complex::ArrayThreshold::ComparisonType compOperator = comparisonValue->getComparisonType();
-  complex::ArrayThreshold::ComparisonValue compValue = comparisonValue->getComparisonValue();
-  complex::IArrayThreshold::UnionOperator unionOperator = comparisonValue->getUnionOperator();
-
-  DataPath inputDataArrayPath = comparisonValue->getArrayPath();
-
-  ThresholdFilterHelper filter(compOperator, compValue, tempResultVector);
-
-  filter.execute(dataStructure, inputDataArrayPath);
-
-  if(replaceInput)
-  {
-    if(inverse)
-    {
-      tempResultVector.flip();
-    }
-    // copy the temp uint8 vector to the final uint8 result array
-    for(size_t i = 0; i < totalTuples; i++)
-    {
-      outputResultArray[i] = tempResultVector[i];
-    }
-  }
-  else
+public:
+  ThresholdProgram(const DataStructure& dataStructure, const ArrayThresholdSet& thresholdSet)
   {
-    // insert into current threshold
-    InsertThreshold(totalTuples, outputResultArray, unionOperator, tempResultVector, inverse);
+    compileSet(dataStructure, thresholdSet, 0);
+    m_Inverse = thresholdSet.isInverted();
   }
-}
 
-void ThresholdSet(std::shared_ptr<ArrayThresholdSet>& inputComparisonSet, DataStructure& dataStructure, DataPath& outputResultArrayPath, int32_t& err, bool replaceInput, bool inverse)
-{
-  if(nullptr == inputComparisonSet)
+  /**
+   * @brief Returns true if the program does not contain any comparisons.
+   * @return bool
+   */
+  bool empty() const
   {
-    return;
+    return m_Instructions.empty();
   }
 
-  //  if(inverse)
-  //  {
-  //    inverse = !comparisonSet->getInvertComparison();
-  //  }
-  //  else
-  //  {
-  //    inverse = comparisonSet->getInvertComparison();
-  //  }
-
-  // Traditionally we would do a check to ensure we get a valid pointer, I'm forgoing that check because it
-  // was essentially done in the preflight part.
-  BoolArray& outputResultArray = dataStructure.getDataRefAs<BoolArray>(outputResultArrayPath);
-
-  // Get the total number of tuples, create and initialize an array with FALSE to use for these results
-  size_t totalTuples = outputResultArray.getNumberOfTuples();
-  std::vector<bool> tempResultVector(totalTuples, false);
-
-  bool firstValueFound = false;
-
-  ArrayThresholdSet::CollectionType thresholds = inputComparisonSet->getArrayThresholds();
-  for(const std::shared_ptr<IArrayThreshold>& threshold : thresholds)
+  /**
+   * @brief Evaluates the program for the tuples in [start, end) and passes the result of each block
+   * to the output function.
+   * @param start
+   * @param end
+   * @param output Called with the first tuple, number of tuples and results of each block
+   */
+  template <typename OutputT>
+  void execute(usize start, usize end, OutputT&& output) const
   {
-    if(std::dynamic_pointer_cast<ArrayThresholdSet>(threshold))
-    {
-      std::shared_ptr<ArrayThresholdSet> comparisonSet = std::dynamic_pointer_cast<ArrayThresholdSet>(threshold);
-      ThresholdSet(comparisonSet, dataStructure, outputResultArrayPath, err, !firstValueFound, false);
-      firstValueFound = true;
-    }
-    else if(std::dynamic_pointer_cast<ArrayThreshold>(threshold))
+    std::vector<uint8> results((m_MaxDepth + 1) * k_ThresholdBlockSize);
+    for(usize blockStart = start; blockStart < end; blockStart += k_ThresholdBlockSize)
     {
-      std::shared_ptr<ArrayThreshold> comparisonValue = std::dynamic_pointer_cast<ArrayThreshold>(threshold);
-      ThresholdValue(comparisonValue, dataStructure, outputResultArrayPath, err, !firstValueFound, false);
-      firstValueFound = true;
+      const usize count = std::min(k_ThresholdBlockSize, end - blockStart);
+      for(const Instruction& instruction : m_Instructions)
+      {
+        uint8* result = results.data() + instruction.depth * k_ThresholdBlockSize;
+        if(instruction.compare)
+        {
+          instruction.compare(blockStart, count, instruction.combine, instruction.inverse, result);
+        }
+        else
+        {
+          CombineBlock(result + k_ThresholdBlockSize, count, instruction.combine, instruction.inverse, result);
+        }
+      }
+      if(m_Inverse)
+      {
+        CombineBlock(results.data(), count, CombineOperator::Replace, true, results.data());
+      }
+      output(blockStart, count, results.data());
     }
   }
 
-  if(replaceInput)
+private:
+  struct Instruction
   {
-    if(inverse)
-    {
-      tempResultVector.flip();
-    }
-    // copy the temp uint8 vector to the final uint8 result array
-    for(size_t i = 0; i < totalTuples; i++)
-    {
-      outputResultArray[i] = tempResultVector[i];
-    }
-  }
-  else
+    CompareFunction compare;
+    usize depth = 0;
+    CombineOperator combine = CombineOperator::Replace;
+    bool inverse = false;
+  };
+
+  /**
+   * @brief Appends the instructions for each threshold in the set. Returns false if the set did
+   * not contain any comparisons.
+   */
+  bool compileSet(const DataStructure& dataStructure, const ArrayThresholdSet& thresholdSet, usize depth)
   {
-    // insert into current threshold
-    InsertThreshold(totalTuples, outputResultArray, inputComparisonSet->getUnionOperator(), tempResultVector, inverse);
+    m_MaxDepth = std::max(m_MaxDepth, depth);
+    bool firstValueFound = false;
+    for(const std::shared_ptr<IArrayThreshold>& threshold : thresholdSet.getArrayThresholds())
+    {
+      const CombineOperator combine = firstValueFound ? ToCombineOperator(threshold->getUnionOperator()) : CombineOperator::Replace;
+      if(auto comparisonSet = std::dynamic_pointer_cast<ArrayThresholdSet>(threshold); comparisonSet != nullptr)
+      {
+        if(compileSet(dataStructure, *comparisonSet, depth + 1))
+        {
+          m_Instructions.push_back({CompareFunction{}, depth, combine, comparisonSet->isInverted()});
+          firstValueFound = true;
+        }
+      }
+      else if(auto comparisonValue = std::dynamic_pointer_cast<ArrayThreshold>(threshold); comparisonValue != nullptr)
+      {
+        const auto& dataArray = dataStructure.getDataRefAs<IDataArray>(comparisonValue->getArrayPath());
+        CompareFunction compare =
+            ExecuteDataFunction(CreateCompareFunctor{}, dataArray.getDataType(), dataArray, comparisonValue->getComparisonType(), comparisonValue->getComparisonValue());
+        m_Instructions.push_back({std::move(compare), depth, combine, comparisonValue->isInverted()});
+        firstValueFound = true;
+      }
+    }
+    return firstValueFound;
   }
-}
 
+  std::vector<Instruction> m_Instructions;
+  usize m_MaxDepth = 0;
+  bool m_Inverse = false;
+};
 } // namespace
 
 // -----------------------------------------------------------------------------
@@ -355,6 +265,7 @@ Parameters MultiThresholdObjects::parameters() const
   Parameters params;
   params.insert(std::make_unique<ArrayThresholdsParameter>(k_ArrayThresholds_Key, "Data Thresholds", "DataArray thresholds to mask", ArrayThresholdSet{}));
   params.insert(std::make_unique<ArrayCreationParameter>(k_CreatedDataPath_Key, "Mask Array", "DataPath to the created Mask Array", DataPath{}));
+  params.insert(std::make_unique<ChoicesParameter>(k_CreatedMaskType_Key, "Mask Type", "Data type of the created Mask Array", k_BoolMaskType, ChoicesParameter::Choices{"bool", "uint8"}));
   return params;
 }
 
@@ -391,6 +302,7 @@ IFilter::PreflightResult MultiThresholdObjects::preflightImpl(const DataStructur
 {
   auto thresholdsObject = args.value<ArrayThresholdSet>(k_ArrayThresholds_Key);
   auto maskArrayPath = args.value<DataPath>(k_CreatedDataPath_Key);
+  auto maskType = args.value<ChoicesParameter::ValueType>(k_CreatedMaskType_Key);
 
   auto thresholdPaths = thresholdsObject.getRequiredPaths();
   // If the paths are empty just return now.
@@ -435,8 +347,9 @@ IFilter::PreflightResult MultiThresholdObjects::preflightImpl(const DataStructur
     }
   }
 
-  // Create the output boolean array
-  auto action = std::make_unique<CreateArrayAction>(DataType::boolean, dataArray->getIDataStore()->getTupleShape(), std::vector<usize>{1}, maskArrayPath);
+  // Create the output mask array
+  const DataType maskDataType = (maskType == k_UInt8MaskType) ? DataType::uint8 : DataType::boolean;
+  auto action = std::make_unique<CreateArrayAction>(maskDataType, dataArray->getIDataStore()->getTupleShape(), std::vector<usize>{1}, maskArrayPath);
 
   OutputActions actions;
   actions.actions.push_back(std::move(action));
@@ -450,28 +363,38 @@ Result<> MultiThresholdObjects::executeImpl(DataStructure& dataStructure, const
 {
   auto thresholdsObject = args.value<ArrayThresholdSet>(k_ArrayThresholds_Key);
   auto maskArrayPath = args.value<DataPath>(k_CreatedDataPath_Key);
+  auto maskType = args.value<ChoicesParameter::ValueType>(k_CreatedMaskType_Key);
 
-  bool firstValueFound = false;
-
-  int32_t err = 0;
-  ArrayThresholdSet::CollectionType thresholdSet = thresholdsObject.getArrayThresholds();
-  for(const std::shared_ptr<IArrayThreshold>& threshold : thresholdSet)
+  const ThresholdProgram program(dataStructure, thresholdsObject);
+  if(program.empty())
   {
-    if(std::dynamic_pointer_cast<ArrayThresholdSet>(threshold))
-    {
-      std::shared_ptr<ArrayThresholdSet> comparisonSet = std::dynamic_pointer_cast<ArrayThresholdSet>(threshold);
-      ThresholdSet(comparisonSet, dataStructure, maskArrayPath, err, !firstValueFound, thresholdsObject.isInverted());
-      firstValueFound = true;
-    }
-    else if(std::dynamic_pointer_cast<ArrayThreshold>(threshold))
-    {
-      std::shared_ptr<ArrayThreshold> comparisonValue = std::dynamic_pointer_cast<ArrayThreshold>(threshold);
-      ThresholdValue(comparisonValue, dataStructure, maskArrayPath, err, !firstValueFound, thresholdsObject.isInverted());
-      firstValueFound = true;
-    }
+    return {};
   }
 
-  // thresholdsObject.applyMaskValues(data, maskArrayPath);
+  auto& maskArray = dataStructure.getDataRefAs<IDataArray>(maskArrayPath);
+  const usize numTuples = maskArray.getNumberOfTuples();
+
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, numTuples);
+  if(maskType == k_UInt8MaskType)
+  {
+    uint8* mask = dynamic_cast<UInt8Array&>(maskArray).createSpan().data();
+    dataAlg.execute([&](const ComplexRange& range) {
+      program.execute(range.min(), range.max(), [mask](usize start, usize count, const uint8* result) { std::copy_n(result, count, mask + start); });
+    });
+  }
+  else
+  {
+    bool* mask = dynamic_cast<BoolArray&>(maskArray).createSpan().data();
+    dataAlg.execute([&](const ComplexRange& range) {
+      program.execute(range.min(), range.max(), [mask](usize start, usize count, const uint8* result) {
+        for(usize i = 0; i < count; i++)
+        {
+          mask[start + i] = result[i] != 0;
+        }
+      });
+    });
+  }
 
   return {};
 }
@@ -1,6 +1,7 @@
 #include "RemoveFlaggedVertices.hpp"
 
 #include "complex/Common/Types.hpp"
+#include "complex/DataStructure/ContiguousValues.hpp"
 #include "complex/DataStructure/Geometry/VertexGeom.hpp"
 #include "complex/DataStructure/IDataArray.hpp"
 #include "complex/Filter/Actions/CreateArrayAction.hpp"
@@ -10,10 +11,12 @@
 #include "complex/Parameters/GeometrySelectionParameter.hpp"
 #include "complex/Parameters/MultiArraySelectionParameter.hpp"
 #include "complex/Utilities/FilterUtilities.hpp"
+#include "complex/Utilities/StreamCompaction.hpp"
 
 #include <fmt/format.h>
 
 #include <string>
+#include <utility>
 
 using namespace complex;
 
@@ -22,29 +25,6 @@ namespace
 constexpr int32 k_VertexGeomNotFound = -277;
 constexpr int32 k_ArrayNotFound = -278;
 constexpr int32 k_TupleShapeNotOneDim = -279;
-
-struct RemoveFlaggedVerticesFunctor
-{
-  // copy data to masked geometry
-  template <class T>
-  void operator()(IDataArray& inputDataPtr, IDataArray& maskedDataPtr, const std::vector<int64>& maskPoints) const
-  {
-    auto& inputData = dynamic_cast<DataArray<T>&>(inputDataPtr);
-    auto& maskedData = dynamic_cast<DataArray<T>&>(maskedDataPtr);
-    maskedData.getDataStore()->reshapeTuples({maskPoints.size()});
-    usize nComps = inputData.getNumberOfComponents();
-
-    for(usize i = 0; i < maskPoints.size(); i++)
-    {
-      for(usize compIdx = 0; compIdx < nComps; compIdx++)
-      {
-        usize destinationIndex = nComps * i + compIdx;
-        usize sourceIndex = nComps * maskPoints[i] + compIdx;
-        maskedData[destinationIndex] = inputData[sourceIndex];
-      }
-    }
-  }
-};
 } // namespace
 
 namespace complex
@@ -175,36 +155,24 @@ Result<> RemoveFlaggedVertices::executeImpl(DataStructure& data, const Arguments
   VertexGeom& vertex = data.getDataRefAs<VertexGeom>(vertexGeomPath);
   auto& mask = data.getDataRefAs<BoolArray>(maskArrayPath);
 
-  size_t numMaskTuples = mask.getSize();
-  size_t trueCount = std::count(mask.begin(), mask.end(), true);
-  std::vector<int64> trueIndices(trueCount);
-  size_t trueIndex = 0;
-  for(int64 i = 0; i < numMaskTuples; i++)
-  {
-    if(mask[i])
-    {
-      trueIndices[trueIndex++] = i;
-    }
-  }
+  // Only the kept vertices are moved into the reduced geometry. A mask whose data store is not contiguous is copied.
+  const ContiguousValues<const bool> maskValues(std::as_const(mask).getDataStoreRef());
+  const std::vector<usize> keptVertices = StreamCompaction::FindKeptIndices(maskValues.span());
 
   VertexGeom& reducedVertex = data.getDataRefAs<VertexGeom>(reducedVertexPath);
-  reducedVertex.resizeVertexList(trueCount);
-
-  for(size_t i = 0; i < trueCount; i++)
-  {
-    Point3D<float> coords = std::move(vertex.getCoords(trueIndices[i]));
-    reducedVertex.setCoords(i, coords);
-  }
-
-  std::vector<usize> tDims = {trueIndices.size()};
+  reducedVertex.resizeVertexList(keptVertices.size());
+  StreamCompaction::CopyKeptTuples(*vertex.getVertices(), *reducedVertex.getVertices(), keptVertices);
 
   for(const auto& targetArrayPath : targetArrayPaths)
   {
+    if(shouldCancel)
+    {
+      return {};
+    }
     DataPath destinationPath = reducedVertexPath.createChildPath(targetArrayPath.getTargetName());
-    auto& src = data.getDataRefAs<IDataArray>(targetArrayPath);
+    const auto& src = data.getDataRefAs<IDataArray>(targetArrayPath);
     auto& dest = data.getDataRefAs<IDataArray>(destinationPath);
-
-    ExecuteDataFunction(RemoveFlaggedVerticesFunctor{}, src.getDataType(), src, dest, trueIndices);
+    StreamCompaction::CopyKeptTuples(src, dest, keptVertices);
   }
 
   return {};
@@ -1,8 +1,10 @@
 #include "RemoveMinimumSizeFeaturesFilter.hpp"
 
 #include <algorithm>
+#include <optional>
 #include <vector>
 
+#include "complex/DataStructure/ContiguousValues.hpp"
 #include "complex/DataStructure/DataArray.hpp"
 #include "complex/DataStructure/Geometry/ImageGeom.hpp"
 #include "complex/Filter/Actions/DeleteDataAction.hpp"
@@ -10,6 +12,7 @@
 #include "complex/Parameters/BoolParameter.hpp"
 #include "complex/Parameters/DataPathSelectionParameter.hpp"
 #include "complex/Parameters/NumberParameter.hpp"
+#include "complex/Utilities/BadVoxelFill.hpp"
 #include "complex/Utilities/DataGroupUtilities.hpp"
 
 namespace complex
@@ -26,187 +29,41 @@ constexpr int32 k_BadNumCellsPath = -5556;
 constexpr int32 k_ParentlessPathError = -5557;
 constexpr int32 k_NeighborListRemoval = -5558;
 
-void assign_badpoints(DataStructure& dataStructure, const DataPath& featureIdsPath, SizeVec3 dimensions, const NumCellsArrayType& numCellsArrayRef)
+Result<> assign_badpoints(DataStructure& dataStructure, const DataPath& featureIdsPath, SizeVec3 dimensions, const std::atomic_bool& shouldCancel)
 {
-  FeatureIdsArrayType* featureIdsPtr = dataStructure.getDataAs<FeatureIdsArrayType>(featureIdsPath);
+  auto& featureIdsArrayRef = dataStructure.getDataRefAs<FeatureIdsArrayType>(featureIdsPath);
 
-  usize totalPoints = featureIdsPtr->getNumberOfTuples();
-  FeatureIdsArrayType::store_type* featureIds = featureIdsPtr->getDataStore();
-
-  std::array<int64_t, 3> dims = {
-      static_cast<int64>(dimensions[0]),
-      static_cast<int64>(dimensions[1]),
-      static_cast<int64>(dimensions[2]),
-  };
-
-  std::vector<int32_t> neighbors(totalPoints * featureIdsPtr->getNumberOfComponents(), -1);
-
-  int32 good = 1;
-  int32 current = 0;
-  int32 most = 0;
-  int64 neighpoint = 0;
-
-  std::array<int64_t, 6> neighpoints = {-dims[0] * dims[1], -dims[0], -1, 1, dims[0], dims[0] * dims[1]};
-
-  usize counter = 1;
-  int64 count = 0;
-  int64 kstride = 0;
-  int64 jstride = 0;
-  int32 featurename = 0;
-  int32 feature = 0;
-  int32 neighbor = 0;
-  std::vector<int32> n(numCellsArrayRef.getNumberOfTuples(), 0);
-
-  while(counter != 0)
+  // Every cell array next to the Feature Ids is copied along with them
+  DataPath attrMatPath = featureIdsPath.getParent();
+  BaseGroup* parentGroup = dataStructure.getDataAs<BaseGroup>(attrMatPath);
+  std::vector<IDataArray*> voxelArrays;
+  for(const auto& [id, sharedChild] : *parentGroup)
   {
-    counter = 0;
-    for(int64 k = 0; k < dims[2]; k++)
+    if(auto* voxelArray = dynamic_cast<IDataArray*>(sharedChild.get()); voxelArray != nullptr)
     {
-      kstride = dims[0] * dims[1] * k;
-      for(int64 j = 0; j < dims[1]; j++)
-      {
-        jstride = dims[0] * j;
-        for(int64 i = 0; i < dims[0]; i++)
-        {
-          count = kstride + jstride + i;
-          featurename = featureIds->getValue(count);
-          if(featurename < 0)
-          {
-            counter++;
-            most = 0;
-            for(size_t l = 0; l < neighpoints.size(); l++)
-            {
-              good = 1;
-              neighpoint = count + neighpoints[l];
-              if(l == 0 && k == 0)
-              {
-                good = 0;
-              }
-              if(l == 5 && k == (dims[2] - 1))
-              {
-                good = 0;
-              }
-              if(l == 1 && j == 0)
-              {
-                good = 0;
-              }
-              if(l == 4 && j == (dims[1] - 1))
-              {
-                good = 0;
-              }
-              if(l == 2 && i == 0)
-              {
-                good = 0;
-              }
-              if(l == 3 && i == (dims[0] - 1))
-              {
-                good = 0;
-              }
-              if(good == 1)
-              {
-                feature = featureIds->getValue(neighpoint);
-                if(feature >= 0)
-                {
-                  n[feature]++;
-                  current = n[feature];
-                  if(current > most)
-                  {
-                    most = current;
-                    neighbors[count] = neighpoint;
-                  }
-                }
-              }
-            }
-            for(int32 l = 0; l < neighpoints.size(); l++)
-            {
-              good = 1;
-              neighpoint = count + neighpoints[l];
-              if(l == 0 && k == 0)
-              {
-                good = 0;
-              }
-              if(l == 5 && k == (dims[2] - 1))
-              {
-                good = 0;
-              }
-              if(l == 1 && j == 0)
-              {
-                good = 0;
-              }
-              if(l == 4 && j == (dims[1] - 1))
-              {
-                good = 0;
-              }
-              if(l == 2 && i == 0)
-              {
-                good = 0;
-              }
-              if(l == 3 && i == (dims[0] - 1))
-              {
-                good = 0;
-              }
-              if(good == 1)
-              {
-                feature = featureIds->getValue(neighpoint);
-                if(feature >= 0)
-                {
-                  n[feature] = 0;
-                }
-              }
-            }
-          }
-        }
-      }
-    }
-    DataPath attrMatPath = featureIdsPath.getParent();
-    BaseGroup* parentGroup = dataStructure.getDataAs<BaseGroup>(attrMatPath);
-    std::vector<std::string> voxelArrayNames;
-    for(const auto& [id, sharedChild] : *parentGroup)
-    {
-      if(std::dynamic_pointer_cast<IDataArray>(sharedChild))
-      {
-        voxelArrayNames.push_back(sharedChild->getName());
-      }
-    }
-
-    // TODO: This loop could be parallelized. Look at NeighborOrientationCorrelation filter
-    for(size_t j = 0; j < totalPoints; j++)
-    {
-      featurename = featureIds->getValue(j);
-      neighbor = neighbors[j];
-      if(neighbor >= 0)
-      {
-        if(featurename < 0 && featureIds->getValue(neighbor) >= 0)
-        {
-          for(auto& voxelArrayName : voxelArrayNames)
-          {
-            auto arrayPath = attrMatPath.createChildPath(voxelArrayName);
-            IDataArray* arr = dataStructure.getDataAs<IDataArray>(arrayPath);
-            arr->copyTuple(neighbor, j);
-          }
-        }
-      }
+      voxelArrays.push_back(voxelArray);
     }
   }
+
+  return FillBadVoxels(featureIdsArrayRef, dimensions, voxelArrays, shouldCancel);
 }
 
 // -----------------------------------------------------------------------------
 std::vector<bool> remove_smallfeatures(FeatureIdsArrayType& featureIdsArrayRef, const NumCellsArrayType& numCellsArrayRef, const PhasesArrayType* featurePhaseArrayPtr, int32_t phaseNumber,
                                        bool applyToSinglePhase, int64 minAllowedFeatureSize, Error& errorReturn)
 {
-  size_t totalPoints = featureIdsArrayRef.getNumberOfTuples();
-  FeatureIdsArrayType::store_type& featureIdsStoreRef = featureIdsArrayRef.getDataStoreRef();
-
   bool good = false;
-  int32 gnum;
 
   size_t totalFeatures = numCellsArrayRef.getNumberOfTuples();
-  const NumCellsArrayType::store_type& numCells = numCellsArrayRef.getDataStoreRef();
+  const ContiguousValues<const int32> numCellValues(numCellsArrayRef.getDataStoreRef());
+  const auto numCells = numCellValues.span();
 
-  const PhasesArrayType::store_type* featurePhases = nullptr;
+  std::optional<ContiguousValues<const int32>> featurePhaseValues;
+  nonstd::span<const int32> featurePhases;
   if(applyToSinglePhase)
   {
-    featurePhases = featurePhaseArrayPtr->getDataStore();
+    featurePhaseValues.emplace(featurePhaseArrayPtr->getDataStoreRef());
+    featurePhases = featurePhaseValues->span();
   }
 
   std::vector<bool> activeObjects(totalFeatures, true);
@@ -215,7 +72,7 @@ std::vector<bool> remove_smallfeatures(FeatureIdsArrayType& featureIdsArrayRef,
   {
     if(!applyToSinglePhase)
     {
-      if(numCells.getValue(i) >= minAllowedFeatureSize)
+      if(numCells[i] >= minAllowedFeatureSize)
       {
         good = true;
       }
@@ -226,7 +83,7 @@ std::vector<bool> remove_smallfeatures(FeatureIdsArrayType& featureIdsArrayRef,
     }
     else
     {
-      if(numCells.getValue(i) >= minAllowedFeatureSize || featurePhases->getValue(i) != phaseNumber)
+      if(numCells[i] >= minAllowedFeatureSize || featurePhases[i] != phaseNumber)
       {
         good = true;
       }
@@ -241,14 +98,15 @@ std::vector<bool> remove_smallfeatures(FeatureIdsArrayType& featureIdsArrayRef,
     errorReturn = Error{-1, "The minimum size is larger than the largest Feature.  All Features would be removed"};
     return activeObjects;
   }
-  for(size_t i = 0; i < totalPoints; i++)
-  {
-    gnum = featureIdsStoreRef.getValue(i);
-    if(!activeObjects[gnum])
+  featureIdsArrayRef.getDataStoreRef().forEachChunk(0, [&activeObjects](usize startIndex, nonstd::span<int32> featureIds) {
+    for(int32& featureId : featureIds)
     {
-      featureIdsStoreRef.setValue(i, -1);
+      if(!activeObjects[featureId])
+      {
+        featureId = -1;
+      }
     }
-  }
+  });
   return activeObjects;
 }
 } // namespace
@@ -402,7 +260,6 @@ Result<> RemoveMinimumSizeFeaturesFilter::executeImpl(DataStructure& dataStructu
   PhasesArrayType* featurePhasesArray = applyToSinglePhase ? dataStructure.getDataAs<PhasesArrayType>(featurePhasesPath) : nullptr;
 
   FeatureIdsArrayType& featureIdsArrayRef = dataStructure.getDataRefAs<FeatureIdsArrayType>(featureIdsPath);
-  FeatureIdsArrayType::store_type& featureIdsStoreRef = featureIdsArrayRef.getDataStoreRef();
 
   NumCellsArrayType& numCellsArrayRef = dataStructure.getDataRefAs<NumCellsArrayType>(numCellsPath);
   NumCellsArrayType::store_type& numCellsStoreRef = numCellsArrayRef.getDataStoreRef();
@@ -437,7 +294,11 @@ Result<> RemoveMinimumSizeFeaturesFilter::executeImpl(DataStructure& dataStructu
   }
 
   ImageGeom& imageGeom = dataStructure.getDataRefAs<ImageGeom>(imageGeomPath);
-  assign_badpoints(dataStructure, featureIdsPath, imageGeom.getDimensions(), numCellsArrayRef);
+  Result<> assignResult = assign_badpoints(dataStructure, featureIdsPath, imageGeom.getDimensions(), shouldCancel);
+  if(assignResult.invalid())
+  {
+    return assignResult;
+  }
 
   DataPath cellFeatureGroupPath = numCellsPath.getParent();
   size_t currentFeatureCount = numCellsStoreRef.getNumberOfTuples();
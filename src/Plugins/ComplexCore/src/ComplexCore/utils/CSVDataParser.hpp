@@ -32,6 +32,9 @@
 #include "complex/Common/Types.hpp"
 #include "complex/DataStructure/DataArray.hpp"
 #include "complex/Utilities/DataArrayUtilities.hpp"
+#include "complex/Utilities/Parsing/Text/DelimitedTextReader.hpp"
+
+#include <string_view>
 
 using namespace complex;
 
@@ -60,7 +63,14 @@ public:
     return m_DataArray;
   }
 
-  virtual Result<> parse(const std::string& token, size_t index) = 0;
+  /**
+   * @brief Parses the token and stores the value at the index. Different indices may
+   * be parsed concurrently.
+   * @param token
+   * @param index
+   * @return Result<>
+   */
+  virtual Result<> parse(std::string_view token, usize index) const = 0;
 
 protected:
   AbstractDataParser(IDataArray& array, const std::string& columnName, usize columnIndex)
@@ -85,7 +95,7 @@ class CSVDataParser : public AbstractDataParser
 public:
   CSVDataParser(ArrayType& array, const std::string& name, usize index)
   : AbstractDataParser(array, name, index)
-  , m_Array(array)
+  , m_Values(array.createSpan())
   {
   }
   ~CSVDataParser() override = default;
@@ -95,19 +105,19 @@ public:
   CSVDataParser& operator=(const CSVDataParser&) = delete; // Copy Assignment Not Implemented
   CSVDataParser& operator=(CSVDataParser&&) = delete;      // Move Assignment
 
-  Result<> parse(const std::string& token, size_t index) override
+  Result<> parse(std::string_view token, usize index) const override
   {
-    Result<T> parseResult = ConvertTo<T>::convert(token);
+    Result<T> parseResult = DelimitedTextReader::ParseValue<T>(token);
     if(parseResult.valid())
     {
-      m_Array[index] = parseResult.value();
+      m_Values[index] = parseResult.value();
     }
 
     return ConvertResult(std::move(parseResult));
   }
 
 private:
-  ArrayType& m_Array;
+  nonstd::span<T> m_Values;
 };
 
 using Int8Parser = CSVDataParser<Int8Array, int8>;
@@ -0,0 +1,160 @@
+#include <catch2/catch.hpp>
+
+#include "ComplexCore/Filters/ComputeGradientFilter.hpp"
+
+#include "complex/DataStructure/DataArray.hpp"
+#include "complex/DataStructure/DataStore.hpp"
+#include "complex/DataStructure/Geometry/ImageGeom.hpp"
+#include "complex/DataStructure/Geometry/TetrahedralGeom.hpp"
+#include "complex/DataStructure/Geometry/TriangleGeom.hpp"
+#include "complex/UnitTest/UnitTestCommon.hpp"
+
+#include <cmath>
+
+using namespace complex;
+
+namespace
+{
+const DataPath k_GeometryPath({"Geometry"});
+const DataPath k_InputArrayPath = k_GeometryPath.createChildPath("Input");
+const DataPath k_GradientPath = k_GeometryPath.createChildPath("Gradient");
+const DataPath k_MagnitudePath = k_GeometryPath.createChildPath("Gradient Magnitude");
+
+/**
+ * @brief Creates the vertex list of a mesh geometry from the given coordinates.
+ */
+AbstractGeometry::SharedVertexList* CreateVertices(DataStructure& dataGraph, const std::vector<float32>& coordinates, DataObject::IdType parentId)
+{
+  auto* vertices = Float32Array::CreateWithStore<Float32DataStore>(dataGraph, "Vertices", {coordinates.size() / 3}, {3}, parentId);
+  REQUIRE(vertices != nullptr);
+  std::copy(coordinates.cbegin(), coordinates.cend(), vertices->begin());
+  return vertices;
+}
+
+void RunComputeGradient(DataStructure& dataGraph)
+{
+  ComputeGradientFilter filter;
+  Arguments args;
+
+  args.insertOrAssign(ComputeGradientFilter::k_GeometryPath_Key, std::make_any<DataPath>(k_GeometryPath));
+  args.insertOrAssign(ComputeGradientFilter::k_InputArrayPath_Key, std::make_any<DataPath>(k_InputArrayPath));
+  args.insertOrAssign(ComputeGradientFilter::k_GradientArrayPath_Key, std::make_any<DataPath>(k_GradientPath));
+  args.insertOrAssign(ComputeGradientFilter::k_ComputeMagnitude_Key, std::make_any<bool>(true));
+  args.insertOrAssign(ComputeGradientFilter::k_MagnitudeArrayPath_Key, std::make_any<DataPath>(k_MagnitudePath));
+
+  // Preflight the filter and check result
+  auto preflightResult = filter.preflight(dataGraph, args);
+  REQUIRE(preflightResult.outputActions.valid());
+
+  // Execute the filter and check the result
+  auto executeResult = filter.execute(dataGraph, args);
+  REQUIRE(executeResult.result.valid());
+}
+
+/**
+ * @brief Checks that every element has the given gradient for each component.
+ */
+void CheckGradients(const DataStructure& dataGraph, usize numElements, const std::vector<float64>& expectedGradient)
+{
+  const auto& gradients = dataGraph.getDataRefAs<Float64Array>(k_GradientPath);
+  const auto& magnitudes = dataGraph.getDataRefAs<Float32Array>(k_MagnitudePath);
+  const usize numComps = expectedGradient.size() / 3;
+  REQUIRE(gradients.getNumberOfTuples() == numElements);
+  REQUIRE(gradients.getNumberOfComponents() == expectedGradient.size());
+  REQUIRE(magnitudes.getNumberOfComponents() == numComps);
+  for(usize i = 0; i < numElements; i++)
+  {
+    for(usize comp = 0; comp < numComps; comp++)
+    {
+      float64 expectedMagnitude = 0.0;
+      for(usize axis = 0; axis < 3; axis++)
+      {
+        const float64 expected = expectedGradient[comp * 3 + axis];
+        REQUIRE(gradients[(i * numComps + comp) * 3 + axis] == Approx(expected).margin(1.0e-6));
+        expectedMagnitude += expected * expected;
+      }
+      REQUIRE(magnitudes[i * numComps + comp] == Approx(std::sqrt(expectedMagnitude)).margin(1.0e-5));
+    }
+  }
+}
+} // namespace
+
+TEST_CASE("ComplexCore::ComputeGradientFilter: Image Geometry", "[ComplexCore][ComputeGradientFilter]")
+{
+  // f = 2x + 3y - z sampled at the cell centers has the same gradient at the interior and boundary cells
+  const SizeVec3 dims = {6, 5, 4};
+  DataStructure dataGraph;
+  ImageGeom* imageGeom = ImageGeom::Create(dataGraph, k_GeometryPath.getTargetName());
+  REQUIRE(imageGeom != nullptr);
+  imageGeom->setDimensions(dims);
+  imageGeom->setSpacing(0.5f, 1.0f, 2.0f);
+  imageGeom->setOrigin(1.0f, -2.0f, 0.0f);
+
+  auto* input = Float32Array::CreateWithStore<Float32DataStore>(dataGraph, k_InputArrayPath.getTargetName(), {dims[2], dims[1], dims[0]}, {1}, imageGeom->getId());
+  REQUIRE(input != nullptr);
+  for(usize z = 0; z < dims[2]; z++)
+  {
+    for(usize y = 0; y < dims[1]; y++)
+    {
+      for(usize x = 0; x < dims[0]; x++)
+      {
+        const Point3D<float64> center = imageGeom->getCoords(x, y, z);
+        (*input)[(z * dims[1] + y) * dims[0] + x] = static_cast<float32>(2.0 * center[0] + 3.0 * center[1] - center[2]);
+      }
+    }
+  }
+
+  RunComputeGradient(dataGraph);
+  CheckGradients(dataGraph, imageGeom->getNumberOfElements(), {2.0, 3.0, -1.0});
+}
+
+TEST_CASE("ComplexCore::ComputeGradientFilter: Tetrahedral Geometry", "[ComplexCore][ComputeGradientFilter]")
+{
+  DataStructure dataGraph;
+  TetrahedralGeom* tetGeom = TetrahedralGeom::Create(dataGraph, k_GeometryPath.getTargetName());
+  REQUIRE(tetGeom != nullptr);
+  tetGeom->setVertices(CreateVertices(dataGraph, {0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 1.0f, 1.0f, 1.0f}, tetGeom->getId()));
+  auto tetStore = std::make_unique<DataStore<AbstractGeometry::MeshIndexType>>(std::vector<usize>{2}, std::vector<usize>{4}, 0);
+  auto* tets = AbstractGeometry::SharedTetList::Create(dataGraph, "Tetrahedra", std::move(tetStore), tetGeom->getId());
+  REQUIRE(tets != nullptr);
+  const std::vector<AbstractGeometry::MeshIndexType> tetVertices = {0, 1, 2, 3, 1, 2, 3, 4};
+  std::copy(tetVertices.cbegin(), tetVertices.cend(), tets->begin());
+  tetGeom->setTetrahedra(tets);
+
+  // f = 2x + 3y - z at each vertex, stored as integers
+  auto* input = Int32Array::CreateWithStore<Int32DataStore>(dataGraph, k_InputArrayPath.getTargetName(), {5}, {1}, tetGeom->getId());
+  REQUIRE(input != nullptr);
+  const std::vector<int32> values = {0, 2, 3, -1, 4};
+  std::copy(values.cbegin(), values.cend(), input->begin());
+
+  RunComputeGradient(dataGraph);
+  CheckGradients(dataGraph, 2, {2.0, 3.0, -1.0});
+}
+
+TEST_CASE("ComplexCore::ComputeGradientFilter: Triangle Geometry", "[ComplexCore][ComputeGradientFilter]")
+{
+  // A tilted square split into two triangles; the gradient is the part of each field's gradient in the plane
+  DataStructure dataGraph;
+  TriangleGeom* triangleGeom = TriangleGeom::Create(dataGraph, k_GeometryPath.getTargetName());
+  REQUIRE(triangleGeom != nullptr);
+  const std::vector<float32> coordinates = {0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 1.0f, 1.0f, 1.0f, 1.0f, 0.0f, 1.0f, 0.0f};
+  triangleGeom->setVertices(CreateVertices(dataGraph, coordinates, triangleGeom->getId()));
+  auto triangleStore = std::make_unique<DataStore<AbstractGeometry::MeshIndexType>>(std::vector<usize>{2}, std::vector<usize>{3}, 0);
+  auto* triangles = AbstractGeometry::SharedTriList::Create(dataGraph, "Triangles", std::move(triangleStore), triangleGeom->getId());
+  REQUIRE(triangles != nullptr);
+  const std::vector<AbstractGeometry::MeshIndexType> triangleVertices = {0, 1, 2, 0, 2, 3};
+  std::copy(triangleVertices.cbegin(), triangleVertices.cend(), triangles->begin());
+  triangleGeom->setFaces(triangles);
+
+  // The first component is f = x + z + 2y, which changes by 2 along both edges of the square, the second is f = y
+  auto* input = Float64Array::CreateWithStore<Float64DataStore>(dataGraph, k_InputArrayPath.getTargetName(), {4}, {2}, triangleGeom->getId());
+  REQUIRE(input != nullptr);
+  for(usize i = 0; i < 4; i++)
+  {
+    (*input)[2 * i + 0] = coordinates[3 * i + 0] + coordinates[3 * i + 2] + 2.0 * coordinates[3 * i + 1];
+    (*input)[2 * i + 1] = coordinates[3 * i + 1];
+  }
+
+  RunComputeGradient(dataGraph);
+  CheckGradients(dataGraph, 2, {1.0, 2.0, 1.0, 0.0, 1.0, 0.0});
+}
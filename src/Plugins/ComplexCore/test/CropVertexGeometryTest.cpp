@@ -16,11 +16,12 @@ const DataPath k_VertexGeomPath{std::vector<std::string>{"VertexGeom"}};
 const DataPath k_CroppedGeomPath{std::vector<std::string>{"Cropped VertexGeom"}};
 const std::vector<DataPath> targetDataArrays{k_VertexGeomPath.createChildPath("DataArray")};
 
+template <typename VertexStoreType = Float32DataStore>
 DataStructure createTestData()
 {
   DataStructure dataStructure;
   auto* vertexGeom = VertexGeom::Create(dataStructure, "VertexGeom");
-  auto* vertexArray = Float32Array::CreateWithStore<Float32DataStore>(dataStructure, "Vertices", {k_TupleCount}, {3}, vertexGeom->getId());
+  auto* vertexArray = Float32Array::CreateWithStore<VertexStoreType>(dataStructure, "Vertices", {k_TupleCount}, {3}, vertexGeom->getId());
   vertexGeom->setVertices(vertexArray);
 
   auto* dataArray = Int32Array::CreateWithStore<Int32DataStore>(dataStructure, "DataArray", {k_TupleCount}, {1}, vertexGeom->getId());
@@ -95,3 +96,39 @@ TEST_CASE("ComplexCore::CropVertexGeometry(Data)", "[ComplexCore][CropVertexGeom
     REQUIRE(croppedDataStore[i] == i);
   }
 }
+
+TEST_CASE("ComplexCore::CropVertexGeometry(Non-Contiguous Vertices)", "[ComplexCore][CropVertexGeometry]")
+{
+  static const std::vector<float32> k_MinPos{2, 0, 0};
+  static const std::vector<float32> k_MaxPos{5, 6, 7};
+
+  CropVertexGeometry filter;
+  // The vertices of a data store that is not contiguous are copied before cropping
+  DataStructure ds = createTestData<UnitTest::NonContiguousDataStore<float32>>();
+  Arguments args;
+
+  args.insert(CropVertexGeometry::k_VertexGeom_Key, std::make_any<DataPath>(k_VertexGeomPath));
+  args.insert(CropVertexGeometry::k_CroppedGeom_Key, std::make_any<DataPath>(k_CroppedGeomPath));
+  args.insert(CropVertexGeometry::k_MinPos_Key, std::make_any<std::vector<float32>>(k_MinPos));
+  args.insert(CropVertexGeometry::k_MaxPos_Key, std::make_any<std::vector<float32>>(k_MaxPos));
+  args.insert(CropVertexGeometry::k_TargetArrayPaths_Key, std::make_any<std::vector<DataPath>>(targetDataArrays));
+  args.insert(CropVertexGeometry::k_CroppedGroupName_Key, std::make_any<std::string>(k_CroppedGroupName));
+
+  auto result = filter.execute(ds, args);
+  COMPLEX_RESULT_REQUIRE_VALID(result.result);
+
+  auto* croppedGeom = ds.getDataAs<VertexGeom>(k_CroppedGeomPath);
+  REQUIRE(croppedGeom != nullptr);
+  auto* croppedVertices = croppedGeom->getVertices();
+  REQUIRE(croppedVertices != nullptr);
+  auto* croppedData = ds.getDataAs<Int32Array>(k_CroppedGeomPath.createChildPath(k_CroppedGroupName).createChildPath("DataArray"));
+  REQUIRE(croppedData != nullptr);
+
+  REQUIRE(croppedVertices->getNumberOfTuples() == 4);
+  REQUIRE(croppedData->getNumberOfTuples() == 4);
+  for(usize i = 0; i < 4; ++i)
+  {
+    REQUIRE((*croppedData)[i] == i + 2);
+    REQUIRE((*croppedVertices)[i * 3] == static_cast<float32>(i + 2));
+  }
+}
@@ -1,6 +1,7 @@
 #include <catch2/catch.hpp>
 
 #include <string>
+#include <vector>
 
 #include "ComplexCore/Filters/ExtractInternalSurfacesFromTriangleGeometry.hpp"
 
@@ -20,7 +21,6 @@ constexpr StringLiteral k_NodeTypesName = "Node Types";
 DataStructure createTestData(const std::string& triangleGeomName, const std::string& nodeTypesName)
 {
   DataStructure ds = UnitTest::CreateDataStructure();
-  const DataPath vertexListPath({Constants::k_SmallIN100, Constants::k_EbsdScanData, Constants::k_ConfidenceIndex});
   auto* triangleList = UInt64Array::CreateWithStore<UInt64DataStore>(ds, "Tri List", {500}, {3});
   auto& triangles = triangleList->getDataStoreRef();
   triangles.fill(0);
@@ -34,8 +34,25 @@ DataStructure createTestData(const std::string& triangleGeomName, const std::str
   triangles[10] = 7;
   triangles[11] = 3;
 
+  // Give every vertex coordinate and triangle a distinct value so the copies can be checked
+  auto* vertexList = Float32Array::CreateWithStore<Float32DataStore>(ds, "Vertex List", {100}, {3});
+  for(usize i = 0; i < vertexList->getSize(); i++)
+  {
+    (*vertexList)[i] = static_cast<float32>(i);
+  }
+  auto& confidenceIndex = ds.getDataRefAs<Float32Array>(DataPath({Constants::k_SmallIN100, Constants::k_EbsdScanData, Constants::k_ConfidenceIndex}));
+  for(usize i = 0; i < confidenceIndex.getSize(); i++)
+  {
+    confidenceIndex[i] = static_cast<float32>(i);
+  }
+  auto& phases = ds.getDataRefAs<Int32Array>(DataPath({Constants::k_SmallIN100, Constants::k_EbsdScanData, Constants::k_Phases}));
+  for(usize i = 0; i < phases.getSize(); i++)
+  {
+    phases[i] = static_cast<int32>(i);
+  }
+
   auto* triangleGeom = TriangleGeom::Create(ds, triangleGeomName);
-  triangleGeom->setVertices(ds.getDataAs<AbstractGeometry::SharedVertexList>(vertexListPath));
+  triangleGeom->setVertices(vertexList);
   triangleGeom->setFaces(triangleList);
 
   auto* nodeArray = Int8Array::CreateWithStore<Int8DataStore>(ds, nodeTypesName, {triangleGeom->getNumberOfFaces()}, {1});
@@ -107,6 +124,12 @@ TEST_CASE("ComplexCore::ExtractInternalSurfacesFromTriangleGeometry(Data)", "[Co
     REQUIRE(oldVerticesArray != nullptr);
 
     REQUIRE(newVerticesArray->getSize() == 18);
+
+    // Vertices 2 to 7 are used by the internal triangles and keep their order
+    for(usize i = 0; i < newVerticesArray->getSize(); i++)
+    {
+      REQUIRE((*newVerticesArray)[i] == (*oldVerticesArray)[6 + i]);
+    }
   }
 
   {
@@ -117,5 +140,32 @@ TEST_CASE("ComplexCore::ExtractInternalSurfacesFromTriangleGeometry(Data)", "[Co
     REQUIRE(oldTrianglesArray != nullptr);
 
     REQUIRE(newTrianglesArray->getNumberOfTuples() == 3);
+
+    // Triangles 1 to 3 are internal and reference the renumbered vertices
+    const std::vector<uint64> expectedTriangles = {0, 1, 2, 3, 4, 5, 0, 5, 1};
+    const auto& newTriangles = dynamic_cast<const UInt64Array&>(*newTrianglesArray);
+    REQUIRE(newTriangles.getSize() == expectedTriangles.size());
+    for(usize i = 0; i < expectedTriangles.size(); i++)
+    {
+      REQUIRE(newTriangles[i] == expectedTriangles[i]);
+    }
+  }
+
+  {
+    const auto& vertexData = ds.getDataRefAs<Float32Array>(k_InternalTrianglePath.createChildPath("VertexData").createChildPath(Constants::k_ConfidenceIndex));
+    const std::vector<float32> expectedVertexData = {2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f};
+    REQUIRE(vertexData.getSize() == expectedVertexData.size());
+    for(usize i = 0; i < expectedVertexData.size(); i++)
+    {
+      REQUIRE(vertexData[i] == expectedVertexData[i]);
+    }
+
+    const auto& faceData = ds.getDataRefAs<Int32Array>(k_InternalTrianglePath.createChildPath("FaceData").createChildPath(Constants::k_Phases));
+    const std::vector<int32> expectedFaceData = {1, 2, 3};
+    REQUIRE(faceData.getSize() == expectedFaceData.size());
+    for(usize i = 0; i < expectedFaceData.size(); i++)
+    {
+      REQUIRE(faceData[i] == expectedFaceData[i]);
+    }
   }
 }
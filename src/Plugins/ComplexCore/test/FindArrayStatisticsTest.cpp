@@ -13,13 +13,177 @@ namespace fs = std::filesystem;
 #include "complex/Parameters/Dream3dImportParameter.hpp"
 #include "complex/Parameters/NumberParameter.hpp"
 
+#include "complex/Utilities/Math/StatisticsCalculations.hpp"
+
 #include "ComplexCore/ComplexCore_test_dirs.hpp"
+#include "ComplexCore/Filters/Algorithms/FindArrayStatistics.hpp"
 #include "ComplexCore/Filters/FindArrayStatisticsFilter.hpp"
 #include "ComplexCore/Filters/ImportDREAM3DFilter.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <random>
+#include <type_traits>
+#include <vector>
+
 using namespace complex;
 using namespace complex::Constants;
 
+namespace
+{
+// Enough tuples to be grouped in several chunks, and for the values of the entire array to be split into several chunks
+constexpr usize k_NumTuples = 300000;
+constexpr int32 k_NumFeatures = 37;
+constexpr int32 k_NumBins = 7;
+
+// The float sums of the entire array are added up in chunks, which only changes their rounding
+constexpr float64 k_ChunkedSumTolerance = 1.0e-4;
+
+/**
+ * @brief Returns a random value in [-500, 1500] that is clamped to the range of T.
+ */
+template <typename T>
+T RandomValue(std::mt19937& generator)
+{
+  if constexpr(std::is_integral_v<T>)
+  {
+    std::uniform_int_distribution<int64> distribution(std::max<int64>(std::numeric_limits<T>::lowest(), -500), std::min<int64>(std::numeric_limits<T>::max(), 1500));
+    return static_cast<T>(distribution(generator));
+  }
+  else
+  {
+    std::uniform_real_distribution<T> distribution(-500, 1500);
+    return distribution(generator);
+  }
+}
+
+/**
+ * @brief Runs FindArrayStatistics on random values, feature ids and a random mask and compares every
+ * statistic against StaticicsCalculations applied to the values of each feature in tuple order.
+ * Statistics by index must match exactly. The float sums and standard deviation of the entire array
+ * must match within k_ChunkedSumTolerance.
+ */
+template <typename T>
+void TestStatisticsMatchSerial(bool computeByIndex)
+{
+  const usize numGroups = computeByIndex ? k_NumFeatures : 1;
+
+  DataStructure dataStructure;
+  DataGroup* topLevelGroup = DataGroup::Create(dataStructure, "TestData");
+  DataGroup* statsGroup = DataGroup::Create(dataStructure, "Statistics", topLevelGroup->getId());
+  REQUIRE(statsGroup != nullptr);
+  auto* inputArray = DataArray<T>::template CreateWithStore<DataStore<T>>(dataStructure, "InputArray", {k_NumTuples}, {1}, topLevelGroup->getId());
+  auto* featureIdsArray = Int32Array::CreateWithStore<Int32DataStore>(dataStructure, "FeatureIds", {k_NumTuples}, {1}, topLevelGroup->getId());
+  auto* maskArray = BoolArray::CreateWithStore<BoolDataStore>(dataStructure, "Mask", {k_NumTuples}, {1}, topLevelGroup->getId());
+
+  // Some feature ids are out of range and are ignored
+  std::mt19937 generator(5489);
+  std::uniform_int_distribution<int32> featureDistribution(-2, k_NumFeatures + 1);
+  std::vector<std::vector<T>> groupValues(numGroups);
+  for(usize i = 0; i < k_NumTuples; i++)
+  {
+    (*inputArray)[i] = RandomValue<T>(generator);
+    (*featureIdsArray)[i] = featureDistribution(generator);
+    (*maskArray)[i] = generator() % 5 != 0;
+    if(!(*maskArray)[i])
+    {
+      continue;
+    }
+    if(!computeByIndex)
+    {
+      groupValues[0].push_back((*inputArray)[i]);
+    }
+    else if((*featureIdsArray)[i] >= 0 && (*featureIdsArray)[i] < k_NumFeatures)
+    {
+      groupValues[(*featureIdsArray)[i]].push_back((*inputArray)[i]);
+    }
+  }
+
+  const DataPath statsPath({"TestData", "Statistics"});
+  const DataGroup::IdType statsId = statsGroup->getId();
+  auto* lengthArray = UInt64Array::CreateWithStore<UInt64DataStore>(dataStructure, "Length", {numGroups}, {1}, statsId);
+  auto* minArray = DataArray<T>::template CreateWithStore<DataStore<T>>(dataStructure, "Minimum", {numGroups}, {1}, statsId);
+  auto* maxArray = DataArray<T>::template CreateWithStore<DataStore<T>>(dataStructure, "Maximum", {numGroups}, {1}, statsId);
+  auto* meanArray = Float32Array::CreateWithStore<Float32DataStore>(dataStructure, "Mean", {numGroups}, {1}, statsId);
+  auto* medianArray = Float32Array::CreateWithStore<Float32DataStore>(dataStructure, "Median", {numGroups}, {1}, statsId);
+  auto* stdArray = Float32Array::CreateWithStore<Float32DataStore>(dataStructure, "Standard Deviation", {numGroups}, {1}, statsId);
+  auto* sumArray = Float32Array::CreateWithStore<Float32DataStore>(dataStructure, "Summation", {numGroups}, {1}, statsId);
+  auto* histArray = Float32Array::CreateWithStore<Float32DataStore>(dataStructure, "Histogram", {numGroups}, {static_cast<usize>(k_NumBins)}, statsId);
+
+  FindArrayStatisticsInputValues inputValues = {};
+  inputValues.FindHistogram = true;
+  inputValues.UseFullRange = true;
+  inputValues.NumBins = k_NumBins;
+  inputValues.FindLength = true;
+  inputValues.FindMin = true;
+  inputValues.FindMax = true;
+  inputValues.FindMean = true;
+  inputValues.FindMedian = true;
+  inputValues.FindStdDeviation = true;
+  inputValues.FindSummation = true;
+  inputValues.UseMask = true;
+  inputValues.ComputeByIndex = computeByIndex;
+  inputValues.StandardizeData = false;
+  inputValues.SelectedArrayPath = DataPath({"TestData", "InputArray"});
+  inputValues.FeatureIdsArrayPath = DataPath({"TestData", "FeatureIds"});
+  inputValues.MaskArrayPath = DataPath({"TestData", "Mask"});
+  inputValues.DestinationAttributeMatrix = statsPath;
+  inputValues.HistogramArrayName = statsPath.createChildPath("Histogram");
+  inputValues.LengthArrayName = statsPath.createChildPath("Length");
+  inputValues.MinimumArrayName = statsPath.createChildPath("Minimum");
+  inputValues.MaximumArrayName = statsPath.createChildPath("Maximum");
+  inputValues.MeanArrayName = statsPath.createChildPath("Mean");
+  inputValues.MedianArrayName = statsPath.createChildPath("Median");
+  inputValues.StdDeviationArrayName = statsPath.createChildPath("Standard Deviation");
+  inputValues.SummationArrayName = statsPath.createChildPath("Summation");
+
+  const std::atomic_bool shouldCancel = false;
+  Result<> result = FindArrayStatistics(dataStructure, IFilter::MessageHandler{}, shouldCancel, &inputValues)();
+  COMPLEX_RESULT_REQUIRE_VALID(result);
+
+  const bool exactSums = computeByIndex || std::is_integral_v<T>;
+  for(usize group = 0; group < numGroups; group++)
+  {
+    std::vector<T>& values = groupValues[group];
+    REQUIRE(values.size() > 1000);
+    REQUIRE((*lengthArray)[group] == values.size());
+    REQUIRE((*minArray)[group] == StaticicsCalculations::findMin(values));
+    REQUIRE((*maxArray)[group] == StaticicsCalculations::findMax(values));
+    REQUIRE((*medianArray)[group] == StaticicsCalculations::findMedian(values));
+
+    const std::vector<float32> expectedHistogram = StaticicsCalculations::findHistogram(values, 0.0f, 0.0f, true, k_NumBins);
+    REQUIRE(expectedHistogram.size() == static_cast<usize>(k_NumBins));
+    for(usize bin = 0; bin < expectedHistogram.size(); bin++)
+    {
+      REQUIRE((*histArray)[group * k_NumBins + bin] == expectedHistogram[bin]);
+    }
+
+    const float32 expectedMean = StaticicsCalculations::findMean(values);
+    const auto expectedSum = static_cast<float32>(StaticicsCalculations::findSummation(values));
+    const float32 expectedStd = StaticicsCalculations::findStdDeviation(values);
+    if(exactSums)
+    {
+      REQUIRE((*meanArray)[group] == expectedMean);
+      REQUIRE((*sumArray)[group] == expectedSum);
+    }
+    else
+    {
+      REQUIRE((*meanArray)[group] == Approx(expectedMean).epsilon(k_ChunkedSumTolerance));
+      REQUIRE((*sumArray)[group] == Approx(expectedSum).epsilon(k_ChunkedSumTolerance));
+    }
+    if(computeByIndex)
+    {
+      REQUIRE((*stdArray)[group] == expectedStd);
+    }
+    else
+    {
+      REQUIRE((*stdArray)[group] == Approx(expectedStd).epsilon(k_ChunkedSumTolerance));
+    }
+  }
+}
+} // namespace
+
 TEST_CASE("ComplexCore::FindArrayStatisticsFilter: Instantiate Filter", "[ComplexCore][FindArrayStatisticsFilter]")
 {
   // Instantiate the filter, a DataStructure object and an Arguments Object
@@ -220,3 +384,17 @@ TEST_CASE("ComplexCore::FindArrayStatisticsFilter: Test Algorithm", "[ComplexCor
     REQUIRE((*histArray)[4] == 1.0f);
   }
 }
+
+TEST_CASE("ComplexCore::FindArrayStatisticsFilter: Entire Array Matches Serial", "[ComplexCore][FindArrayStatisticsFilter]")
+{
+  TestStatisticsMatchSerial<int32>(false);
+  TestStatisticsMatchSerial<float32>(false);
+  TestStatisticsMatchSerial<float64>(false);
+}
+
+TEST_CASE("ComplexCore::FindArrayStatisticsFilter: By Index Matches Serial", "[ComplexCore][FindArrayStatisticsFilter]")
+{
+  TestStatisticsMatchSerial<int32>(true);
+  TestStatisticsMatchSerial<uint8>(true);
+  TestStatisticsMatchSerial<float32>(true);
+}
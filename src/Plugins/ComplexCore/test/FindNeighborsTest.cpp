@@ -6,6 +6,11 @@
 
 #include "ComplexCore/ComplexCore_test_dirs.hpp"
 
+#include <algorithm>
+#include <map>
+#include <random>
+#include <vector>
+
 using namespace complex;
 
 namespace
@@ -19,7 +24,7 @@ const std::string k_SharedSurfaceAreaName = "Shared Surface Area";
 const std::string k_SurfaceFeaturesName = "Surface Features";
 const std::string k_CellFeatureName = "Feature Data";
 
-DataStructure createTestData()
+DataStructure createTestData(bool nonContiguousFeatureIds = false)
 {
   DataStructure data;
   auto* imageGeom = ImageGeom::Create(data, k_ImageGeomName);
@@ -31,7 +36,9 @@ DataStructure createTestData()
   IDataStore::ShapeType compDims{1};
 
   {
-    auto* featureIdsArray = Int32Array::CreateWithStore<Int32DataStore>(data, k_FeatureIdsName, tupleShape, compDims, imageGeom->getId());
+    auto* featureIdsArray = nonContiguousFeatureIds
+                                ? Int32Array::CreateWithStore<UnitTest::NonContiguousDataStore<int32>>(data, k_FeatureIdsName, tupleShape, compDims, imageGeom->getId())
+                                : Int32Array::CreateWithStore<Int32DataStore>(data, k_FeatureIdsName, tupleShape, compDims, imageGeom->getId());
     auto& featureIds = featureIdsArray->getDataStoreRef();
     for(usize i = 0; i < featureIds.getSize(); ++i)
     {
@@ -48,6 +55,82 @@ DataStructure createTestData()
 
   return data;
 }
+
+/**
+ * @brief Creates blocks of features with about one voxel in six set to a random
+ * feature or to feature 0.
+ */
+DataStructure createRandomTestData(const SizeVec3& dims, int32 numFeatures, std::vector<int32>& featureIdValues)
+{
+  DataStructure data;
+  auto* imageGeom = ImageGeom::Create(data, k_ImageGeomName);
+  imageGeom->setDimensions(dims);
+  imageGeom->setOrigin({0, 0, 0});
+  imageGeom->setSpacing({0.5f, 2.0f, 1.0f});
+
+  featureIdValues.resize(dims[0] * dims[1] * dims[2]);
+  std::mt19937 generator(5489);
+  auto* featureIdsArray = Int32Array::CreateWithStore<Int32DataStore>(data, k_FeatureIdsName, {dims[2], dims[1], dims[0]}, {1}, imageGeom->getId());
+  for(usize z = 0; z < dims[2]; z++)
+  {
+    for(usize y = 0; y < dims[1]; y++)
+    {
+      for(usize x = 0; x < dims[0]; x++)
+      {
+        const usize index = (z * dims[1] + y) * dims[0] + x;
+        const auto blockFeature = static_cast<int32>(1 + x / 4 + 3 * (y / 4) + 9 * (z / 5));
+        featureIdValues[index] = generator() % 6 == 0 ? static_cast<int32>(generator() % numFeatures) : std::min(blockFeature, numFeatures - 1);
+        (*featureIdsArray)[index] = featureIdValues[index];
+      }
+    }
+  }
+
+  DataGroup* featureGroup = DataGroup::Create(data, k_CellFeatureName, imageGeom->getId());
+  Int32Array::CreateWithStore<Int32DataStore>(data, "Actives", {static_cast<usize>(numFeatures)}, {1}, featureGroup->getId());
+  return data;
+}
+
+Arguments createArguments(bool storeBoundaryAndSurface)
+{
+  Arguments args;
+  args.insert(FindNeighbors::k_StoreBoundary_Key, std::make_any<bool>(storeBoundaryAndSurface));
+  args.insert(FindNeighbors::k_StoreSurface_Key, std::make_any<bool>(storeBoundaryAndSurface));
+  args.insert(FindNeighbors::k_ImageGeom_Key, std::make_any<DataPath>(DataPath({k_ImageGeomName})));
+  args.insert(FindNeighbors::k_FeatureIds_Key, std::make_any<DataPath>(DataPath({k_ImageGeomName, k_FeatureIdsName})));
+  args.insert(FindNeighbors::k_CellFeatures_Key, std::make_any<DataPath>(DataPath({k_ImageGeomName, k_CellFeatureName})));
+  args.insert(FindNeighbors::k_BoundaryCells_Key, std::make_any<DataPath>(DataPath({k_ImageGeomName, k_BoundaryCellsName})));
+  args.insert(FindNeighbors::k_NumNeighbors_Key, std::make_any<DataPath>(DataPath({k_ImageGeomName, k_NumNeighborsName})));
+  args.insert(FindNeighbors::k_NeighborList_Key, std::make_any<DataPath>(DataPath({k_ImageGeomName, k_NeighborListName})));
+  args.insert(FindNeighbors::k_SharedSurfaceArea_Key, std::make_any<DataPath>(DataPath({k_ImageGeomName, k_SharedSurfaceAreaName})));
+  args.insert(FindNeighbors::k_SurfaceFeatures_Key, std::make_any<DataPath>(DataPath({k_ImageGeomName, k_SurfaceFeaturesName})));
+  return args;
+}
+
+template <typename T>
+void requireEqualArrays(const DataStructure& expectedData, const DataStructure& data, const std::string& name)
+{
+  const DataPath path({k_ImageGeomName, name});
+  const auto& expected = expectedData.getDataRefAs<DataArray<T>>(path);
+  const auto& actual = data.getDataRefAs<DataArray<T>>(path);
+  REQUIRE(actual.getSize() == expected.getSize());
+  for(usize i = 0; i < expected.getSize(); i++)
+  {
+    REQUIRE(actual[i] == expected[i]);
+  }
+}
+
+template <typename T>
+void requireEqualNeighborLists(const DataStructure& expectedData, const DataStructure& data, const std::string& name)
+{
+  const DataPath path({k_ImageGeomName, name});
+  const auto& expected = expectedData.getDataRefAs<NeighborList<T>>(path);
+  const auto& actual = data.getDataRefAs<NeighborList<T>>(path);
+  REQUIRE(actual.getNumberOfTuples() == expected.getNumberOfTuples());
+  for(usize i = 0; i < expected.getNumberOfTuples(); i++)
+  {
+    REQUIRE(actual.copyOfList(static_cast<int32>(i)) == expected.copyOfList(static_cast<int32>(i)));
+  }
+}
 } // namespace
 
 TEST_CASE("ComplexCore::FindNeighbors(Instantiate)", "[ComplexCore][FindNeighbors]")
@@ -86,3 +169,120 @@ TEST_CASE("ComplexCore::FindNeighbors(Instantiate)", "[ComplexCore][FindNeighbor
   auto result = filter.execute(ds, args);
   COMPLEX_RESULT_REQUIRE_VALID(result.result);
 }
+
+TEST_CASE("ComplexCore::FindNeighbors(Non-Contiguous Feature Ids)", "[ComplexCore][FindNeighbors]")
+{
+  // Feature Ids whose data store is not contiguous are copied before the voxels are scanned
+  FindNeighbors filter;
+  const Arguments args = createArguments(true);
+
+  DataStructure expectedData = createTestData();
+  auto expectedResult = filter.execute(expectedData, args);
+  COMPLEX_RESULT_REQUIRE_VALID(expectedResult.result);
+
+  DataStructure data = createTestData(true);
+  REQUIRE_FALSE(data.getDataRefAs<Int32Array>(DataPath({k_ImageGeomName, k_FeatureIdsName})).isContiguous());
+  auto result = filter.execute(data, args);
+  COMPLEX_RESULT_REQUIRE_VALID(result.result);
+
+  requireEqualArrays<int32>(expectedData, data, k_NumNeighborsName);
+  requireEqualArrays<int8>(expectedData, data, k_BoundaryCellsName);
+  requireEqualArrays<bool>(expectedData, data, k_SurfaceFeaturesName);
+  requireEqualNeighborLists<int32>(expectedData, data, k_NeighborListName);
+  requireEqualNeighborLists<float32>(expectedData, data, k_SharedSurfaceAreaName);
+}
+
+TEST_CASE("ComplexCore::FindNeighbors(Parallel Matches Serial)", "[ComplexCore][FindNeighbors]")
+{
+  // Enough Z planes to be split into several slabs
+  const SizeVec3 dims = {13, 11, 40};
+  const int32 numFeatures = 60;
+  std::vector<int32> featureIds;
+  DataStructure data = createRandomTestData(dims, numFeatures, featureIds);
+
+  FindNeighbors filter;
+  auto result = filter.execute(data, createArguments(true));
+  COMPLEX_RESULT_REQUIRE_VALID(result.result);
+
+  // The serial scan that counts the faces between features in a map
+  std::vector<std::map<int32, usize>> faceCounts(numFeatures);
+  std::vector<int8> expectedBoundaryCells(featureIds.size(), 0);
+  std::vector<bool> expectedSurfaceFeatures(numFeatures, false);
+  for(usize z = 0; z < dims[2]; z++)
+  {
+    for(usize y = 0; y < dims[1]; y++)
+    {
+      for(usize x = 0; x < dims[0]; x++)
+      {
+        const usize index = (z * dims[1] + y) * dims[0] + x;
+        const int32 feature = featureIds[index];
+        if(feature <= 0)
+        {
+          continue;
+        }
+        if(x == 0 || y == 0 || z == 0 || x == dims[0] - 1 || y == dims[1] - 1 || z == dims[2] - 1)
+        {
+          expectedSurfaceFeatures[feature] = true;
+        }
+        std::vector<usize> neighbors;
+        if(z > 0)
+        {
+          neighbors.push_back(index - dims[0] * dims[1]);
+        }
+        if(y > 0)
+        {
+          neighbors.push_back(index - dims[0]);
+        }
+        if(x > 0)
+        {
+          neighbors.push_back(index - 1);
+        }
+        if(x < dims[0] - 1)
+        {
+          neighbors.push_back(index + 1);
+        }
+        if(y < dims[1] - 1)
+        {
+          neighbors.push_back(index + dims[0]);
+        }
+        if(z < dims[2] - 1)
+        {
+          neighbors.push_back(index + dims[0] * dims[1]);
+        }
+        for(usize neighbor : neighbors)
+        {
+          const int32 neighborFeature = featureIds[neighbor];
+          if(neighborFeature > 0 && neighborFeature != feature)
+          {
+            faceCounts[feature][neighborFeature]++;
+            expectedBoundaryCells[index]++;
+          }
+        }
+      }
+    }
+  }
+
+  const auto& numNeighbors = data.getDataRefAs<Int32Array>(DataPath({k_ImageGeomName, k_NumNeighborsName}));
+  const auto& boundaryCells = data.getDataRefAs<Int8Array>(DataPath({k_ImageGeomName, k_BoundaryCellsName}));
+  const auto& surfaceFeatures = data.getDataRefAs<BoolArray>(DataPath({k_ImageGeomName, k_SurfaceFeaturesName}));
+  const auto& neighborList = data.getDataRefAs<NeighborList<int32>>(DataPath({k_ImageGeomName, k_NeighborListName}));
+  const auto& sharedSurfaceAreaList = data.getDataRefAs<NeighborList<float32>>(DataPath({k_ImageGeomName, k_SharedSurfaceAreaName}));
+
+  REQUIRE(std::equal(expectedBoundaryCells.cbegin(), expectedBoundaryCells.cend(), boundaryCells.begin()));
+  usize numMismatches = 0;
+  for(int32 feature = 1; feature < numFeatures; feature++)
+  {
+    std::vector<int32> expectedNeighbors;
+    std::vector<float32> expectedAreas;
+    for(const auto& [neighbor, count] : faceCounts[feature])
+    {
+      expectedNeighbors.push_back(neighbor);
+      expectedAreas.push_back(static_cast<float32>(count) * 0.5f * 2.0f);
+    }
+    numMismatches += numNeighbors[feature] != static_cast<int32>(expectedNeighbors.size()) ? 1 : 0;
+    numMismatches += surfaceFeatures[feature] != expectedSurfaceFeatures[feature] ? 1 : 0;
+    numMismatches += neighborList.copyOfList(feature) != expectedNeighbors ? 1 : 0;
+    numMismatches += sharedSurfaceAreaList.copyOfList(feature) != expectedAreas ? 1 : 0;
+  }
+  REQUIRE(numMismatches == 0);
+}
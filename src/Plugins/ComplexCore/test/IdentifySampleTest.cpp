@@ -8,6 +8,58 @@
 
 using namespace complex;
 
+namespace
+{
+constexpr usize k_DimX = 8;
+constexpr usize k_DimY = 8;
+constexpr usize k_DimZ = 3;
+
+/**
+ * @brief A 5x5x3 block of good voxels around a one voxel hole plus a good voxel that
+ * does not touch the block.
+ */
+bool IsGoodVoxel(usize x, usize y, usize z)
+{
+  const bool inBlock = x >= 1 && x <= 5 && y >= 1 && y <= 5;
+  const bool isHole = x == 3 && y == 3 && z == 1;
+  const bool isIsland = x == 7 && y == 7 && z == 0;
+  return (inBlock && !isHole) || isIsland;
+}
+
+/**
+ * @brief Runs the filter on the mask and returns the resulting mask values.
+ */
+template <typename DataStoreType>
+std::vector<bool> IdentifySampleMask()
+{
+  DataStructure dataGraph;
+  auto* imageGeom = ImageGeom::Create(dataGraph, "Image Geometry");
+  imageGeom->setDimensions({k_DimX, k_DimY, k_DimZ});
+  auto* mask = BoolArray::CreateWithStore<DataStoreType>(dataGraph, "Mask", {k_DimZ, k_DimY, k_DimX}, {1}, imageGeom->getId());
+  REQUIRE(mask != nullptr);
+  for(usize z = 0; z < k_DimZ; z++)
+  {
+    for(usize y = 0; y < k_DimY; y++)
+    {
+      for(usize x = 0; x < k_DimX; x++)
+      {
+        (*mask)[(z * k_DimY + y) * k_DimX + x] = IsGoodVoxel(x, y, z);
+      }
+    }
+  }
+
+  IdentifySample filter;
+  Arguments args;
+  args.insert(IdentifySample::k_FillHoles_Key, std::make_any<bool>(true));
+  args.insert(IdentifySample::k_ImageGeom_Key, std::make_any<DataPath>(DataPath({"Image Geometry"})));
+  args.insert(IdentifySample::k_GoodVoxels_Key, std::make_any<DataPath>(DataPath({"Image Geometry", "Mask"})));
+  auto executeResult = filter.execute(dataGraph, args);
+  COMPLEX_RESULT_REQUIRE_VALID(executeResult.result);
+
+  return std::vector<bool>(mask->begin(), mask->end());
+}
+} // namespace
+
 TEST_CASE("ComplexCore::IdentifySample(Instantiate)", "[ComplexCore][IdentifySample]")
 {
   static constexpr bool k_FillHoles = true;
@@ -30,3 +82,50 @@ TEST_CASE("ComplexCore::IdentifySample(Instantiate)", "[ComplexCore][IdentifySam
   auto executeResult = filter.execute(dataGraph, args);
   REQUIRE(executeResult.result.valid());
 }
+
+TEST_CASE("ComplexCore::IdentifySample(Non-Contiguous Mask)", "[ComplexCore][IdentifySample]")
+{
+  // The island is removed and the hole inside the block is filled
+  std::vector<bool> expected(k_DimX * k_DimY * k_DimZ, false);
+  for(usize z = 0; z < k_DimZ; z++)
+  {
+    for(usize y = 1; y <= 5; y++)
+    {
+      for(usize x = 1; x <= 5; x++)
+      {
+        expected[(z * k_DimY + y) * k_DimX + x] = true;
+      }
+    }
+  }
+
+  REQUIRE(IdentifySampleMask<DataStore<bool>>() == expected);
+  // The mask of a data store that is not contiguous is copied and the result copied back
+  REQUIRE(IdentifySampleMask<UnitTest::NonContiguousDataStore<bool>>() == expected);
+}
+
+TEST_CASE("ComplexCore::IdentifySample(Mismatched Mask)", "[ComplexCore][IdentifySample]")
+{
+  DataStructure dataGraph;
+  auto* imageGeom = ImageGeom::Create(dataGraph, "Image Geometry");
+  imageGeom->setDimensions({k_DimX, k_DimY, k_DimZ});
+  REQUIRE(BoolArray::CreateWithStore<DataStore<bool>>(dataGraph, "Short Mask", {k_DimZ - 1, k_DimY, k_DimX}, {1}, imageGeom->getId()) != nullptr);
+  REQUIRE(BoolArray::CreateWithStore<DataStore<bool>>(dataGraph, "Two Component Mask", {k_DimZ, k_DimY, k_DimX}, {2}, imageGeom->getId()) != nullptr);
+
+  IdentifySample filter;
+  Arguments args;
+  args.insert(IdentifySample::k_FillHoles_Key, std::make_any<bool>(true));
+  args.insert(IdentifySample::k_ImageGeom_Key, std::make_any<DataPath>(DataPath({"Image Geometry"})));
+
+  // A mask with fewer tuples than cells is rejected instead of being labeled
+  args.insert(IdentifySample::k_GoodVoxels_Key, std::make_any<DataPath>(DataPath({"Image Geometry", "Short Mask"})));
+  auto preflightResult = filter.preflight(dataGraph, args);
+  REQUIRE(preflightResult.outputActions.invalid());
+  REQUIRE(preflightResult.outputActions.errors()[0].code == -12003);
+  auto executeResult = filter.execute(dataGraph, args);
+  REQUIRE(executeResult.result.invalid());
+
+  args.insertOrAssign(IdentifySample::k_GoodVoxels_Key, std::make_any<DataPath>(DataPath({"Image Geometry", "Two Component Mask"})));
+  preflightResult = filter.preflight(dataGraph, args);
+  REQUIRE(preflightResult.outputActions.invalid());
+  REQUIRE(preflightResult.outputActions.errors()[0].code == -12002);
+}
@@ -659,6 +659,94 @@ void testFilterExecute(ImportHDF5Dataset& filter)
   }
 }
 
+// -----------------------------------------------------------------------------
+void testFilterHyperslab(ImportHDF5Dataset& filter)
+{
+  // The 3D dataset has dimensions 10 x 8 x 36
+  const usize dim1 = 8;
+  const usize dim2 = (COMPDIMPROD * TUPLEDIMPROD) / 10 / 8;
+  std::string typeStr = H5::Support::HdfTypeForPrimitiveAsStr<int32>();
+  std::optional<DataPath> levelZeroPath = {DataPath::FromString(Constants::k_LevelZero.view()).value()};
+  DataPath arrayPath = levelZeroPath->createChildPath("Pointer3DArrayDataset<" + typeStr + ">");
+
+  ImportHDF5DatasetParameter::DatasetImportInfo importInfo;
+  importInfo.dataSetPath = "/Pointer/Pointer3DArrayDataset<" + typeStr + ">";
+
+  // Rows 2 through 4 of the slowest dimension
+  {
+    importInfo.hyperslabStart = "2";
+    importInfo.hyperslabCount = "3";
+    importInfo.tupleDimensions = "24";
+    importInfo.componentDimensions = "36";
+
+    DataStructure dataStructure;
+    DataGroup::Create(dataStructure, Constants::k_LevelZero);
+    Arguments args;
+    args.insertOrAssign(ImportHDF5Dataset::k_ImportHDF5File_Key, std::make_any<ImportHDF5DatasetParameter::ValueType>(ImportHDF5DatasetParameter::ValueType{levelZeroPath, m_FilePath, {importInfo}}));
+    auto result = filter.execute(dataStructure, args);
+    COMPLEX_RESULT_REQUIRE_VALID(result.result);
+
+    const auto& dataArray = dataStructure.getDataRefAs<Int32Array>(arrayPath);
+    REQUIRE(dataArray.getSize() == 3 * dim1 * dim2);
+    for(usize i = 0; i < dataArray.getSize(); i++)
+    {
+      REQUIRE(dataArray[i] == static_cast<int32>((2 * dim1 * dim2 + i) * 5));
+    }
+  }
+
+  // Every other element of the two slowest dimensions
+  {
+    importInfo.hyperslabStart = "0, 0";
+    importInfo.hyperslabCount = "5, 4";
+    importInfo.hyperslabStride = "2, 2";
+    importInfo.tupleDimensions = "5, 4";
+    importInfo.componentDimensions = "36";
+
+    DataStructure dataStructure;
+    DataGroup::Create(dataStructure, Constants::k_LevelZero);
+    Arguments args;
+    args.insertOrAssign(ImportHDF5Dataset::k_ImportHDF5File_Key, std::make_any<ImportHDF5DatasetParameter::ValueType>(ImportHDF5DatasetParameter::ValueType{levelZeroPath, m_FilePath, {importInfo}}));
+    auto result = filter.execute(dataStructure, args);
+    COMPLEX_RESULT_REQUIRE_VALID(result.result);
+
+    const auto& dataArray = dataStructure.getDataRefAs<Int32Array>(arrayPath);
+    REQUIRE(dataArray.getNumberOfTuples() == 20);
+    for(usize i = 0; i < 5; i++)
+    {
+      for(usize j = 0; j < 4; j++)
+      {
+        for(usize k = 0; k < dim2; k++)
+        {
+          usize sourceIndex = ((i * 2) * dim1 + (j * 2)) * dim2 + k;
+          REQUIRE(dataArray[(i * 4 + j) * dim2 + k] == static_cast<int32>(sourceIndex * 5));
+        }
+      }
+    }
+  }
+
+  // The hyperslab must lie inside the dataset and match the tuple and component dimensions
+  {
+    DataStructure dataStructure;
+    DataGroup::Create(dataStructure, Constants::k_LevelZero);
+    Arguments args;
+
+    importInfo.hyperslabStart = "10";
+    importInfo.hyperslabCount = "";
+    importInfo.hyperslabStride = "";
+    args.insertOrAssign(ImportHDF5Dataset::k_ImportHDF5File_Key, std::make_any<ImportHDF5DatasetParameter::ValueType>(ImportHDF5DatasetParameter::ValueType{levelZeroPath, m_FilePath, {importInfo}}));
+    REQUIRE(filter.preflight(dataStructure, args).outputActions.invalid());
+
+    importInfo.hyperslabStart = "abc";
+    args.insertOrAssign(ImportHDF5Dataset::k_ImportHDF5File_Key, std::make_any<ImportHDF5DatasetParameter::ValueType>(ImportHDF5DatasetParameter::ValueType{levelZeroPath, m_FilePath, {importInfo}}));
+    REQUIRE(filter.preflight(dataStructure, args).outputActions.invalid());
+
+    importInfo.hyperslabStart = "0";
+    importInfo.hyperslabCount = "2";
+    args.insertOrAssign(ImportHDF5Dataset::k_ImportHDF5File_Key, std::make_any<ImportHDF5DatasetParameter::ValueType>(ImportHDF5DatasetParameter::ValueType{levelZeroPath, m_FilePath, {importInfo}}));
+    REQUIRE(filter.preflight(dataStructure, args).outputActions.invalid());
+  }
+}
+
 // -----------------------------------------------------------------------------
 TEST_CASE("ComplexCore::ImportHDF5Dataset Filter")
 {
@@ -668,6 +756,7 @@ TEST_CASE("ComplexCore::ImportHDF5Dataset Filter")
     ImportHDF5Dataset filter;
     testFilterPreflight(filter);
     testFilterExecute(filter);
+    testFilterHyperslab(filter);
   }
 
   if(fs::exists(m_FilePath))
@@ -2,6 +2,8 @@
 
 #include "ComplexCore/Filters/InterpolatePointCloudToRegularGridFilter.hpp"
 
+#include "complex/DataStructure/DataStore.hpp"
+#include "complex/DataStructure/NeighborList.hpp"
 #include "complex/UnitTest/UnitTestCommon.hpp"
 
 #include "ComplexCore/ComplexCore_test_dirs.hpp"
@@ -9,6 +11,7 @@
 #include <filesystem>
 #include <iostream>
 #include <limits>
+#include <numeric>
 #include <string>
 
 namespace fs = std::filesystem;
@@ -126,3 +129,118 @@ TEST_CASE("ComplexCore::InterpolatePointCloudToRegularGridFilter: Test Algorithm
   auto executeResult = filter.execute(dataGraph, args);
   COMPLEX_RESULT_REQUIRE_VALID(executeResult.result);
 }
+
+TEST_CASE("ComplexCore::InterpolatePointCloudToRegularGridFilter: Gaussian Scatter", "[DREAM3DReview][InterpolatePointCloudToRegularGridFilter]")
+{
+  const SizeVec3 dims = {6, 5, 4};
+  const usize numVoxels = dims[0] * dims[1] * dims[2];
+  const usize numPoints = 500;
+
+  DataStructure dataGraph;
+  auto* imageGeom = ImageGeom::Create(dataGraph, "Image");
+  imageGeom->setDimensions(dims);
+  imageGeom->setSpacing({1.0f, 1.0f, 1.0f});
+  auto* vertices = Float32Array::CreateWithStore<Float32DataStore>(dataGraph, "Vertices", {numPoints}, {3});
+  auto* vertexGeom = VertexGeom::Create(dataGraph, "Points");
+  vertexGeom->setVertices(vertices);
+  auto* voxelIndices = USizeArray::CreateWithStore<USizeDataStore>(dataGraph, "Voxel Indices", {numPoints}, {1});
+  auto* mask = BoolArray::CreateWithStore<BoolDataStore>(dataGraph, "Mask", {numPoints}, {1});
+  auto* values = Float32Array::CreateWithStore<Float32DataStore>(dataGraph, "Values", {numPoints}, {1});
+  for(usize i = 0; i < numPoints; i++)
+  {
+    (*voxelIndices)[i] = (i * 37) % numVoxels;
+    (*mask)[i] = (i % 5) != 0;
+    (*values)[i] = static_cast<float32>(i % 11) - 3.0f;
+  }
+
+  // Scatter every point over a 5x5x5 Gaussian kernel
+  const int64 kernelNumVoxels = 2;
+  std::vector<float64> weightedSums(numVoxels, 0.0);
+  std::vector<float64> totalWeights(numVoxels, 0.0);
+  std::vector<usize> numContributions(numVoxels, 0);
+  for(usize i = 0; i < numPoints; i++)
+  {
+    if(!(*mask)[i])
+    {
+      continue;
+    }
+    const auto x = static_cast<int64>((*voxelIndices)[i] % dims[0]);
+    const auto y = static_cast<int64>(((*voxelIndices)[i] / dims[0]) % dims[1]);
+    const auto z = static_cast<int64>((*voxelIndices)[i] / (dims[0] * dims[1]));
+    for(int64 dz = -kernelNumVoxels; dz <= kernelNumVoxels; dz++)
+    {
+      for(int64 dy = -kernelNumVoxels; dy <= kernelNumVoxels; dy++)
+      {
+        for(int64 dx = -kernelNumVoxels; dx <= kernelNumVoxels; dx++)
+        {
+          if(x + dx < 0 || y + dy < 0 || z + dz < 0 || x + dx >= static_cast<int64>(dims[0]) || y + dy >= static_cast<int64>(dims[1]) || z + dz >= static_cast<int64>(dims[2]))
+          {
+            continue;
+          }
+          const usize target = ((z + dz) * dims[1] + (y + dy)) * dims[0] + (x + dx);
+          const float64 weight = static_cast<float32>(std::exp(-(dx * dx + dy * dy + dz * dz) / 2.0));
+          weightedSums[target] += weight * (*values)[i];
+          totalWeights[target] += weight;
+          numContributions[target]++;
+        }
+      }
+    }
+  }
+
+  const DataPath interpolatedGroupPath({"Interpolated"});
+  const DataPath kernelDistancesGroupPath({"Kernel Distances"});
+  for(uint64 outputType : {0, 1})
+  {
+    InterpolatePointCloudToRegularGridFilter filter;
+    DataStructure outputGraph = dataGraph;
+    Arguments args;
+    args.insertOrAssign(InterpolatePointCloudToRegularGridFilter::k_UseMask_Key, std::make_any<bool>(true));
+    args.insertOrAssign(InterpolatePointCloudToRegularGridFilter::k_StoreKernelDistances_Key, std::make_any<bool>(true));
+    args.insertOrAssign(InterpolatePointCloudToRegularGridFilter::k_InterpolationTechnique_Key, std::make_any<uint64>(1));
+    args.insertOrAssign(InterpolatePointCloudToRegularGridFilter::k_OutputType_Key, std::make_any<uint64>(outputType));
+    args.insertOrAssign(InterpolatePointCloudToRegularGridFilter::k_KernelSize_Key, std::make_any<std::vector<float32>>(std::vector<float32>{3, 3, 3}));
+    args.insertOrAssign(InterpolatePointCloudToRegularGridFilter::k_GaussianSigmas_Key, std::make_any<std::vector<float32>>(std::vector<float32>{1, 1, 1}));
+    args.insertOrAssign(InterpolatePointCloudToRegularGridFilter::k_VertexGeom_Key, std::make_any<DataPath>(DataPath({"Points"})));
+    args.insertOrAssign(InterpolatePointCloudToRegularGridFilter::k_ImageGeom_Key, std::make_any<DataPath>(DataPath({"Image"})));
+    args.insertOrAssign(InterpolatePointCloudToRegularGridFilter::k_VoxelIndices_Key, std::make_any<DataPath>(DataPath({"Voxel Indices"})));
+    args.insertOrAssign(InterpolatePointCloudToRegularGridFilter::k_Mask_Key, std::make_any<DataPath>(DataPath({"Mask"})));
+    args.insertOrAssign(InterpolatePointCloudToRegularGridFilter::k_InterpolateArrays_Key, std::make_any<std::vector<DataPath>>(std::vector<DataPath>{DataPath({"Values"})}));
+    args.insertOrAssign(InterpolatePointCloudToRegularGridFilter::k_CopyArrays_Key, std::make_any<std::vector<DataPath>>(std::vector<DataPath>()));
+    args.insertOrAssign(InterpolatePointCloudToRegularGridFilter::k_InterpolatedGroup_Key, std::make_any<DataPath>(interpolatedGroupPath));
+    args.insertOrAssign(InterpolatePointCloudToRegularGridFilter::k_KernelDistancesGroup_Key, std::make_any<DataPath>(kernelDistancesGroupPath));
+
+    auto preflightResult = filter.preflight(outputGraph, args);
+    COMPLEX_RESULT_REQUIRE_VALID(preflightResult.outputActions);
+    auto executeResult = filter.execute(outputGraph, args);
+    COMPLEX_RESULT_REQUIRE_VALID(executeResult.result);
+
+    const auto& kernelDistances = outputGraph.getDataRefAs<FloatNeighborListType>(kernelDistancesGroupPath.createChildPath("Neighbor List"));
+    REQUIRE(kernelDistances.getNumberOfTuples() == numVoxels);
+    for(usize voxel = 0; voxel < numVoxels; voxel++)
+    {
+      REQUIRE(kernelDistances.getListSpan(voxel).size() == numContributions[voxel]);
+    }
+
+    if(outputType == 0)
+    {
+      const auto& neighbors = outputGraph.getDataRefAs<FloatNeighborListType>(interpolatedGroupPath.createChildPath("Values Neighbors"));
+      REQUIRE(neighbors.getNumberOfTuples() == numVoxels);
+      for(usize voxel = 0; voxel < numVoxels; voxel++)
+      {
+        auto list = neighbors.getListSpan(voxel);
+        REQUIRE(list.size() == numContributions[voxel]);
+        REQUIRE(std::accumulate(list.begin(), list.end(), 0.0) == Approx(weightedSums[voxel]).margin(1.0e-4));
+      }
+    }
+    else
+    {
+      const auto& means = outputGraph.getDataRefAs<Float32Array>(interpolatedGroupPath.createChildPath("Values Mean"));
+      REQUIRE(means.getNumberOfTuples() == numVoxels);
+      for(usize voxel = 0; voxel < numVoxels; voxel++)
+      {
+        const float64 expectedMean = totalWeights[voxel] > 0.0 ? weightedSums[voxel] / totalWeights[voxel] : 0.0;
+        REQUIRE(means[voxel] == Approx(expectedMean).margin(1.0e-4));
+      }
+    }
+  }
+}
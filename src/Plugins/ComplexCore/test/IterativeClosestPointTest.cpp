@@ -8,6 +8,10 @@
 #include "ComplexCore/ComplexCore_test_dirs.hpp"
 #include "ComplexCore/Filters/IterativeClosestPointFilter.hpp"
 
+#include "complex/Common/Numbers.hpp"
+#include "complex/Parameters/ChoicesParameter.hpp"
+
+#include <cmath>
 #include <filesystem>
 #include <limits>
 
@@ -73,3 +77,86 @@ TEST_CASE("ComplexCore::IterativeClosestPointFilter: Test Algorithm", "[DREAM3DR
   auto executeResult = filter.execute(dataGraph, args);
   REQUIRE(executeResult.result.valid());
 }
+
+TEST_CASE("ComplexCore::IterativeClosestPointFilter: Recover Rigid Transform", "[DREAM3DReview][IterativeClosestPointFilter]")
+{
+  IterativeClosestPointFilter filter;
+  DataStructure dataGraph;
+  Arguments args;
+
+  // The target is an irregular lattice and the moving points are the target rotated by
+  // 5 degrees about z and shifted, so the registration has to undo that motion
+  const usize numVerts = 12 * 10 * 8;
+  const float32 angle = 5.0f * numbers::pi_v<float32> / 180.0f;
+  const std::array<float32, 3> shift = {0.3f, -0.2f, 0.1f};
+
+  auto* targetVertexGeom = VertexGeom::Create(dataGraph, "Target");
+  auto* targetVertices = Float32Array::CreateWithStore<DataStore<float32>>(dataGraph, "Target Vertices", {numVerts}, {3}, targetVertexGeom->getId());
+  targetVertexGeom->setVertices(targetVertices);
+  auto* movingVertexGeom = VertexGeom::Create(dataGraph, "Moving");
+  auto* movingVertices = Float32Array::CreateWithStore<DataStore<float32>>(dataGraph, "Moving Vertices", {numVerts}, {3}, movingVertexGeom->getId());
+  movingVertexGeom->setVertices(movingVertices);
+
+  usize vertex = 0;
+  for(usize z = 0; z < 8; z++)
+  {
+    for(usize y = 0; y < 10; y++)
+    {
+      for(usize x = 0; x < 12; x++)
+      {
+        const float32 px = static_cast<float32>(x) * (1.0f + 0.02f * static_cast<float32>(y));
+        const float32 py = static_cast<float32>(y) * 1.3f + 0.05f * static_cast<float32>(x * x % 7);
+        const float32 pz = static_cast<float32>(z) * 0.9f + 0.03f * static_cast<float32>(x + y);
+        (*targetVertices)[3 * vertex + 0] = px;
+        (*targetVertices)[3 * vertex + 1] = py;
+        (*targetVertices)[3 * vertex + 2] = pz;
+        (*movingVertices)[3 * vertex + 0] = std::cos(angle) * px - std::sin(angle) * py + shift[0];
+        (*movingVertices)[3 * vertex + 1] = std::sin(angle) * px + std::cos(angle) * py + shift[1];
+        (*movingVertices)[3 * vertex + 2] = pz + shift[2];
+        vertex++;
+      }
+    }
+  }
+
+  const DataPath transformArrayPath({"Transform Array"});
+  args.insertOrAssign(IterativeClosestPointFilter::k_MovingVertexPath_Key, std::make_any<DataPath>(DataPath({"Moving"})));
+  args.insertOrAssign(IterativeClosestPointFilter::k_TargetVertexPath_Key, std::make_any<DataPath>(DataPath({"Target"})));
+  args.insertOrAssign(IterativeClosestPointFilter::k_NumIterations_Key, std::make_any<uint64>(100));
+  args.insertOrAssign(IterativeClosestPointFilter::k_RmsTolerance_Key, std::make_any<float64>(1.0e-6));
+  args.insertOrAssign(IterativeClosestPointFilter::k_SubsampleFraction_Key, std::make_any<float32>(0.25f));
+  args.insertOrAssign(IterativeClosestPointFilter::k_SubsampleVoxelSize_Key, std::make_any<float32>(2.0f));
+  args.insertOrAssign(IterativeClosestPointFilter::k_NumCoarseIterations_Key, std::make_any<uint64>(20));
+  args.insertOrAssign(IterativeClosestPointFilter::k_ApplyTransformation_Key, std::make_any<bool>(true));
+  args.insertOrAssign(IterativeClosestPointFilter::k_TransformArrayPath_Key, std::make_any<DataPath>(transformArrayPath));
+
+  // The coarse iterations run on a random subsample and on one point per voxel grid cell
+  for(ChoicesParameter::ValueType method : {1, 2})
+  {
+    DYNAMIC_SECTION("Subsampling Method " << method)
+    {
+      args.insertOrAssign(IterativeClosestPointFilter::k_SubsamplingMethod_Key, std::make_any<ChoicesParameter::ValueType>(method));
+
+      // Preflight the filter and check result
+      auto preflightResult = filter.preflight(dataGraph, args);
+      REQUIRE(preflightResult.outputActions.valid());
+
+      // Execute the filter and check the result
+      auto executeResult = filter.execute(dataGraph, args);
+      REQUIRE(executeResult.result.valid());
+
+      for(usize i = 0; i < numVerts * 3; i++)
+      {
+        REQUIRE(std::abs((*movingVertices)[i] - (*targetVertices)[i]) < 1.0e-3f);
+      }
+
+      // The transform is stored in row major order and must be the inverse of the motion
+      const auto& transform = dataGraph.getDataRefAs<Float32Array>(transformArrayPath);
+      REQUIRE(std::abs(transform[0] - std::cos(angle)) < 1.0e-4f);
+      REQUIRE(std::abs(transform[1] - std::sin(angle)) < 1.0e-4f);
+      REQUIRE(std::abs(transform[4] + std::sin(angle)) < 1.0e-4f);
+      REQUIRE(std::abs(transform[10] - 1.0f) < 1.0e-4f);
+      REQUIRE(std::abs(transform[11] + shift[2]) < 1.0e-4f);
+      REQUIRE(std::abs(transform[15] - 1.0f) < 1.0e-6f);
+    }
+  }
+}
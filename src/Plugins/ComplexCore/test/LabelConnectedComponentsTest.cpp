@@ -0,0 +1,274 @@
+#include <catch2/catch.hpp>
+
+#include "ComplexCore/Filters/LabelConnectedComponentsFilter.hpp"
+
+#include "complex/DataStructure/DataArray.hpp"
+#include "complex/DataStructure/DataStore.hpp"
+#include "complex/DataStructure/Geometry/ImageGeom.hpp"
+#include "complex/Parameters/ChoicesParameter.hpp"
+#include "complex/UnitTest/UnitTestCommon.hpp"
+#include "complex/Utilities/ConnectedComponents.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <queue>
+#include <random>
+
+using namespace complex;
+
+namespace
+{
+const DataPath k_ImageGeomPath({"ImageGeom"});
+const DataPath k_MaskPath = k_ImageGeomPath.createChildPath("Mask");
+const DataPath k_FeatureIdsPath = k_ImageGeomPath.createChildPath("FeatureIds");
+const DataPath k_ComponentSizesPath({"ComponentSizes"});
+
+const SizeVec3 k_ImageDims = {10, 8, 6};
+
+// Large enough for the filter to split the voxels into several ranges
+const SizeVec3 k_LargeImageDims = {64, 48, 50};
+
+usize VoxelIndex(usize x, usize y, usize z)
+{
+  return (z * k_ImageDims[1] + y) * k_ImageDims[0] + x;
+}
+
+/**
+ * @brief Masks a 3x3x3 block in the corner of the geometry and three single voxels that
+ * share an edge and a vertex respectively.
+ */
+DataStructure CreateDataStructure()
+{
+  DataStructure dataGraph;
+  ImageGeom* imageGeom = ImageGeom::Create(dataGraph, k_ImageGeomPath.getTargetName());
+  REQUIRE(imageGeom != nullptr);
+  imageGeom->setDimensions(k_ImageDims);
+
+  auto* mask = BoolArray::CreateWithStore<BoolDataStore>(dataGraph, k_MaskPath.getTargetName(), {k_ImageDims[2], k_ImageDims[1], k_ImageDims[0]}, {1}, imageGeom->getId());
+  REQUIRE(mask != nullptr);
+  mask->fill(false);
+  for(usize z = 0; z < 3; z++)
+  {
+    for(usize y = 0; y < 3; y++)
+    {
+      for(usize x = 0; x < 3; x++)
+      {
+        (*mask)[VoxelIndex(x, y, z)] = true;
+      }
+    }
+  }
+  (*mask)[VoxelIndex(5, 4, 3)] = true;
+  (*mask)[VoxelIndex(6, 5, 3)] = true;
+  (*mask)[VoxelIndex(7, 6, 4)] = true;
+  return dataGraph;
+}
+
+void RunLabelConnectedComponents(ChoicesParameter::ValueType connectivity, const std::vector<uint64>& expectedSizes, const std::vector<int32>& expectedSingleVoxelIds)
+{
+  LabelConnectedComponentsFilter filter;
+  DataStructure dataGraph = CreateDataStructure();
+  Arguments args;
+
+  args.insertOrAssign(LabelConnectedComponentsFilter::k_ImageGeom_Key, std::make_any<DataPath>(k_ImageGeomPath));
+  args.insertOrAssign(LabelConnectedComponentsFilter::k_MaskArrayPath_Key, std::make_any<DataPath>(k_MaskPath));
+  args.insertOrAssign(LabelConnectedComponentsFilter::k_Connectivity_Key, std::make_any<ChoicesParameter::ValueType>(connectivity));
+  args.insertOrAssign(LabelConnectedComponentsFilter::k_FeatureIdsArrayPath_Key, std::make_any<DataPath>(k_FeatureIdsPath));
+  args.insertOrAssign(LabelConnectedComponentsFilter::k_ComponentSizesArrayPath_Key, std::make_any<DataPath>(k_ComponentSizesPath));
+
+  // Preflight the filter and check result
+  auto preflightResult = filter.preflight(dataGraph, args);
+  REQUIRE(preflightResult.outputActions.valid());
+
+  // Execute the filter and check the result
+  auto executeResult = filter.execute(dataGraph, args);
+  REQUIRE(executeResult.result.valid());
+
+  const auto& componentSizes = dataGraph.getDataRefAs<UInt64Array>(k_ComponentSizesPath);
+  REQUIRE(componentSizes.getNumberOfTuples() == expectedSizes.size());
+  for(usize i = 0; i < expectedSizes.size(); i++)
+  {
+    REQUIRE(componentSizes[i] == expectedSizes[i]);
+  }
+
+  const auto& featureIds = dataGraph.getDataRefAs<Int32Array>(k_FeatureIdsPath);
+  REQUIRE(featureIds[VoxelIndex(0, 0, 0)] == 1);
+  REQUIRE(featureIds[VoxelIndex(2, 2, 2)] == 1);
+  REQUIRE(featureIds[VoxelIndex(3, 0, 0)] == 0);
+  REQUIRE(featureIds[VoxelIndex(5, 4, 3)] == expectedSingleVoxelIds[0]);
+  REQUIRE(featureIds[VoxelIndex(6, 5, 3)] == expectedSingleVoxelIds[1]);
+  REQUIRE(featureIds[VoxelIndex(7, 6, 4)] == expectedSingleVoxelIds[2]);
+}
+/**
+ * @brief Masks random voxels and a column through every plane of the geometry, so that
+ * some components cross the boundaries between the ranges of the parallel labeling.
+ */
+std::vector<uint8> CreateLargeMask()
+{
+  const usize numVoxels = k_LargeImageDims[0] * k_LargeImageDims[1] * k_LargeImageDims[2];
+  std::vector<uint8> mask(numVoxels, 0);
+  std::mt19937 generator(12345);
+  for(uint8& value : mask)
+  {
+    value = generator() % 10 < 3 ? 1 : 0;
+  }
+  const usize planeSize = k_LargeImageDims[0] * k_LargeImageDims[1];
+  for(usize z = 0; z < k_LargeImageDims[2]; z++)
+  {
+    mask[z * planeSize + planeSize / 2] = 1;
+  }
+  return mask;
+}
+
+/**
+ * @brief Labels the components with a breadth first search from each unlabeled voxel in
+ * scan order. Returns the number of voxels with each label.
+ */
+std::vector<usize> LabelSerial(const SizeVec3& dims, const std::vector<uint8>& mask, bool componentValue, ConnectedComponents::Connectivity connectivity, std::vector<int32>& labels)
+{
+  const int64 maxDistance = static_cast<int64>(connectivity) + 1;
+  std::vector<std::array<int64, 3>> offsets;
+  for(int64 dz = -1; dz <= 1; dz++)
+  {
+    for(int64 dy = -1; dy <= 1; dy++)
+    {
+      for(int64 dx = -1; dx <= 1; dx++)
+      {
+        const int64 distance = std::abs(dx) + std::abs(dy) + std::abs(dz);
+        if(distance > 0 && distance <= maxDistance)
+        {
+          offsets.push_back({dx, dy, dz});
+        }
+      }
+    }
+  }
+
+  const auto isComponent = [&](usize index) { return (mask[index] != 0) == componentValue; };
+  labels.assign(mask.size(), 0);
+  std::vector<usize> sizes = {0};
+  for(usize start = 0; start < mask.size(); start++)
+  {
+    if(!isComponent(start))
+    {
+      sizes[0]++;
+      continue;
+    }
+    if(labels[start] != 0)
+    {
+      continue;
+    }
+    const auto label = static_cast<int32>(sizes.size());
+    sizes.push_back(0);
+    labels[start] = label;
+    std::queue<usize> queue;
+    queue.push(start);
+    while(!queue.empty())
+    {
+      const usize index = queue.front();
+      queue.pop();
+      sizes[label]++;
+      const std::array<int64, 3> position = {static_cast<int64>(index % dims[0]), static_cast<int64>((index / dims[0]) % dims[1]), static_cast<int64>(index / (dims[0] * dims[1]))};
+      for(const auto& offset : offsets)
+      {
+        std::array<int64, 3> neighbor = {};
+        bool isInside = true;
+        for(usize axis = 0; axis < 3; axis++)
+        {
+          neighbor[axis] = position[axis] + offset[axis];
+          isInside = isInside && neighbor[axis] >= 0 && neighbor[axis] < static_cast<int64>(dims[axis]);
+        }
+        if(!isInside)
+        {
+          continue;
+        }
+        const usize neighborIndex = (neighbor[2] * dims[1] + neighbor[1]) * dims[0] + neighbor[0];
+        if(isComponent(neighborIndex) && labels[neighborIndex] == 0)
+        {
+          labels[neighborIndex] = label;
+          queue.push(neighborIndex);
+        }
+      }
+    }
+  }
+  return sizes;
+}
+} // namespace
+
+TEST_CASE("ComplexCore::LabelConnectedComponentsFilter: 6 Connectivity", "[ComplexCore][LabelConnectedComponentsFilter]")
+{
+  RunLabelConnectedComponents(0, {450, 27, 1, 1, 1}, {2, 3, 4});
+}
+
+TEST_CASE("ComplexCore::LabelConnectedComponentsFilter: 18 Connectivity", "[ComplexCore][LabelConnectedComponentsFilter]")
+{
+  RunLabelConnectedComponents(1, {450, 27, 2, 1}, {2, 2, 3});
+}
+
+TEST_CASE("ComplexCore::LabelConnectedComponentsFilter: 26 Connectivity", "[ComplexCore][LabelConnectedComponentsFilter]")
+{
+  RunLabelConnectedComponents(2, {450, 27, 3}, {2, 2, 2});
+}
+
+TEST_CASE("ComplexCore::LabelConnectedComponentsFilter: Large Volume", "[ComplexCore][LabelConnectedComponentsFilter]")
+{
+  const std::vector<uint8> maskValues = CreateLargeMask();
+
+  for(ChoicesParameter::ValueType connectivity = 0; connectivity < 3; connectivity++)
+  {
+    DataStructure dataGraph;
+    ImageGeom* imageGeom = ImageGeom::Create(dataGraph, k_ImageGeomPath.getTargetName());
+    REQUIRE(imageGeom != nullptr);
+    imageGeom->setDimensions(k_LargeImageDims);
+    auto* mask = UInt8Array::CreateWithStore<UInt8DataStore>(dataGraph, k_MaskPath.getTargetName(), {k_LargeImageDims[2], k_LargeImageDims[1], k_LargeImageDims[0]}, {1}, imageGeom->getId());
+    REQUIRE(mask != nullptr);
+    std::copy(maskValues.cbegin(), maskValues.cend(), mask->begin());
+
+    LabelConnectedComponentsFilter filter;
+    Arguments args;
+    args.insertOrAssign(LabelConnectedComponentsFilter::k_ImageGeom_Key, std::make_any<DataPath>(k_ImageGeomPath));
+    args.insertOrAssign(LabelConnectedComponentsFilter::k_MaskArrayPath_Key, std::make_any<DataPath>(k_MaskPath));
+    args.insertOrAssign(LabelConnectedComponentsFilter::k_Connectivity_Key, std::make_any<ChoicesParameter::ValueType>(connectivity));
+    args.insertOrAssign(LabelConnectedComponentsFilter::k_FeatureIdsArrayPath_Key, std::make_any<DataPath>(k_FeatureIdsPath));
+    args.insertOrAssign(LabelConnectedComponentsFilter::k_ComponentSizesArrayPath_Key, std::make_any<DataPath>(k_ComponentSizesPath));
+
+    auto preflightResult = filter.preflight(dataGraph, args);
+    REQUIRE(preflightResult.outputActions.valid());
+    auto executeResult = filter.execute(dataGraph, args);
+    REQUIRE(executeResult.result.valid());
+
+    std::vector<int32> expectedLabels;
+    const std::vector<usize> expectedSizes = LabelSerial(k_LargeImageDims, maskValues, true, static_cast<ConnectedComponents::Connectivity>(connectivity), expectedLabels);
+
+    const auto& featureIds = dataGraph.getDataRefAs<Int32Array>(k_FeatureIdsPath);
+    REQUIRE(featureIds.getSize() == expectedLabels.size());
+    REQUIRE(std::equal(expectedLabels.cbegin(), expectedLabels.cend(), featureIds.begin()));
+
+    const auto& componentSizes = dataGraph.getDataRefAs<UInt64Array>(k_ComponentSizesPath);
+    REQUIRE(componentSizes.getNumberOfTuples() == expectedSizes.size());
+    REQUIRE(std::equal(expectedSizes.cbegin(), expectedSizes.cend(), componentSizes.begin()));
+  }
+}
+
+TEST_CASE("ComplexCore::LabelConnectedComponentsFilter: Range Boundaries", "[ComplexCore][LabelConnectedComponentsFilter]")
+{
+  const std::vector<uint8> mask = CreateLargeMask();
+
+  for(uint8 connectivity = 0; connectivity < 3; connectivity++)
+  {
+    for(bool componentValue : {true, false})
+    {
+      std::vector<int32> expectedLabels;
+      const std::vector<usize> expectedSizes = LabelSerial(k_LargeImageDims, mask, componentValue, static_cast<ConnectedComponents::Connectivity>(connectivity), expectedLabels);
+
+      // Ranges smaller than a plane, one plane and several planes long
+      for(usize numRanges : {1, 2, 3, 7, 64, 250})
+      {
+        std::vector<int32> labels(mask.size(), -1);
+        const std::vector<usize> sizes = ConnectedComponents::Label(k_LargeImageDims, nonstd::span<const uint8>(mask), componentValue, static_cast<ConnectedComponents::Connectivity>(connectivity),
+                                                                    nonstd::span<int32>(labels), numRanges);
+        REQUIRE(labels == expectedLabels);
+        REQUIRE(sizes == expectedSizes);
+      }
+    }
+  }
+}
@@ -1,6 +1,8 @@
 
 #include <catch2/catch.hpp>
 
+#include "complex/DataStructure/DataArray.hpp"
+#include "complex/DataStructure/DataStore.hpp"
 #include "complex/DataStructure/Geometry/AbstractGeometry2D.hpp"
 #include "complex/DataStructure/Geometry/TriangleGeom.hpp"
 #include "complex/Parameters/ArrayCreationParameter.hpp"
@@ -15,6 +17,8 @@
 #include "ComplexCore/Filters/LaplacianSmoothingFilter.hpp"
 #include "ComplexCore/Filters/StlFileReaderFilter.hpp"
 
+#include <algorithm>
+#include <cmath>
 #include <filesystem>
 #include <string>
 namespace fs = std::filesystem;
@@ -123,6 +127,45 @@ TEST_CASE("ComplexCore::LaplacianSmoothingFilter", "[SurfaceMeshing][LaplacianSm
   REQUIRE(err >= 0);
 }
 
+TEST_CASE("ComplexCore::LaplacianSmoothingFilter: Pyramid", "[SurfaceMeshing][LaplacianSmoothingFilter]")
+{
+  // A square pyramid without its base: the apex is vertex 0 and the corners of the base
+  // are vertices 1-4. Vertex 5 does not belong to any triangle.
+  DataStructure dataGraph;
+  auto* triangleGeom = TriangleGeom::Create(dataGraph, "Pyramid");
+  auto* vertices = Float32Array::CreateWithStore<Float32DataStore>(dataGraph, "Vertices", {6}, {3}, triangleGeom->getId());
+  const std::vector<float32> positions = {0.0f, 0.0f, 1.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, -1.0f, 0.0f, 0.0f, 0.0f, -1.0f, 0.0f, 5.0f, 5.0f, 5.0f};
+  std::copy(positions.cbegin(), positions.cend(), vertices->begin());
+  triangleGeom->setVertices(vertices);
+  auto* triangles = UInt64Array::CreateWithStore<UInt64DataStore>(dataGraph, "Triangles", {4}, {3}, triangleGeom->getId());
+  const std::vector<uint64> triangleVertices = {0, 1, 2, 0, 2, 3, 0, 3, 4, 0, 4, 1};
+  std::copy(triangleVertices.cbegin(), triangleVertices.cend(), triangles->begin());
+  triangleGeom->setFaces(triangles);
+
+  auto* nodeType = Int8Array::CreateWithStore<Int8DataStore>(dataGraph, "Node Type", {6}, {1}, triangleGeom->getId());
+  nodeType->fill(complex::NodeType::Default);
+
+  LaplacianSmoothingFilter filter;
+  Arguments args;
+  args.insertOrAssign(LaplacianSmoothingFilter::k_IterationSteps_Key, std::make_any<int32>(1));
+  args.insertOrAssign(LaplacianSmoothingFilter::k_Lambda_Key, std::make_any<float32>(0.5F));
+  args.insertOrAssign(LaplacianSmoothingFilter::k_UseTaubinSmoothing_Key, std::make_any<bool>(false));
+  args.insertOrAssign(LaplacianSmoothingFilter::k_SurfaceMeshNodeTypeArrayPath_Key, std::make_any<DataPath>(DataPath({"Pyramid", "Node Type"})));
+  args.insertOrAssign(LaplacianSmoothingFilter::k_TriangleGeometryDataPath_Key, std::make_any<DataPath>(DataPath({"Pyramid"})));
+
+  auto preflightResult = filter.preflight(dataGraph, args);
+  REQUIRE(preflightResult.outputActions.valid());
+  auto executeResult = filter.execute(dataGraph, args);
+  REQUIRE(executeResult.result.valid());
+
+  // Every vertex moves halfway towards the mean of its neighbors from before the sweep
+  const std::vector<float32> expected = {0.0f, 0.0f, 0.5f, 0.5f, 0.0f, 1.0f / 6.0f, 0.0f, 0.5f, 1.0f / 6.0f, -0.5f, 0.0f, 1.0f / 6.0f, 0.0f, -0.5f, 1.0f / 6.0f, 5.0f, 5.0f, 5.0f};
+  for(usize i = 0; i < expected.size(); i++)
+  {
+    REQUIRE(std::abs((*vertices)[i] - expected[i]) < 1.0e-6f);
+  }
+}
+
 // TEST_CASE("SurfaceMeshing::LaplacianSmoothingFilter: Valid filter execution")
 //{
 //
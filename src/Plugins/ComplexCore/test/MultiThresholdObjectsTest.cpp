@@ -0,0 +1,150 @@
+#include <catch2/catch.hpp>
+
+#include "complex/DataStructure/DataArray.hpp"
+#include "complex/DataStructure/DataStore.hpp"
+#include "complex/Parameters/ChoicesParameter.hpp"
+#include "complex/UnitTest/UnitTestCommon.hpp"
+#include "complex/Utilities/ArrayThreshold.hpp"
+
+#include "ComplexCore/Filters/MultiThresholdObjects.hpp"
+
+using namespace complex;
+
+namespace
+{
+constexpr usize k_NumTuples = 10000;
+
+const DataPath k_FloatArrayPath({"Float Array"});
+const DataPath k_IntArrayPath({"Int Array"});
+const DataPath k_MaskArrayPath({"Mask"});
+
+DataStructure CreateThresholdDataStructure()
+{
+  DataStructure dataGraph;
+  auto* floatArray = Float32Array::CreateWithStore<Float32DataStore>(dataGraph, k_FloatArrayPath.getTargetName(), {k_NumTuples}, {1});
+  auto* intArray = Int32Array::CreateWithStore<Int32DataStore>(dataGraph, k_IntArrayPath.getTargetName(), {k_NumTuples}, {1});
+  for(usize i = 0; i < k_NumTuples; i++)
+  {
+    (*floatArray)[i] = static_cast<float32>(i % 100) * 0.5f;
+    (*intArray)[i] = static_cast<int32>(i % 7);
+  }
+  return dataGraph;
+}
+
+std::shared_ptr<ArrayThreshold> CreateThreshold(const DataPath& arrayPath, ArrayThreshold::ComparisonType comparisonType, float64 value, IArrayThreshold::UnionOperator unionOperator)
+{
+  auto threshold = std::make_shared<ArrayThreshold>();
+  threshold->setArrayPath(arrayPath);
+  threshold->setComparisonType(comparisonType);
+  threshold->setComparisonValue(value);
+  threshold->setUnionOperator(unionOperator);
+  return threshold;
+}
+
+/**
+ * @brief Float > 10 AND NOT(innerSet) OR Float < 2
+ */
+ArrayThresholdSet CreateThresholdSet(std::shared_ptr<ArrayThresholdSet> innerSet)
+{
+  innerSet->setInverted(true);
+  innerSet->setUnionOperator(IArrayThreshold::UnionOperator::And);
+
+  ArrayThresholdSet thresholdSet;
+  thresholdSet.setArrayThresholds({CreateThreshold(k_FloatArrayPath, ArrayThreshold::ComparisonType::GreaterThan, 10.0, IArrayThreshold::UnionOperator::And), std::move(innerSet),
+                                   CreateThreshold(k_FloatArrayPath, ArrayThreshold::ComparisonType::LessThan, 2.0, IArrayThreshold::UnionOperator::Or)});
+  return thresholdSet;
+}
+
+/**
+ * @brief (Float > 10 AND NOT(Int == 3 OR Int == 5)) OR Float < 2
+ */
+ArrayThresholdSet CreateInvertedOrSet()
+{
+  auto innerSet = std::make_shared<ArrayThresholdSet>();
+  innerSet->setArrayThresholds({CreateThreshold(k_IntArrayPath, ArrayThreshold::ComparisonType::Operator_Equal, 3, IArrayThreshold::UnionOperator::Or),
+                                CreateThreshold(k_IntArrayPath, ArrayThreshold::ComparisonType::Operator_Equal, 5, IArrayThreshold::UnionOperator::Or)});
+  return CreateThresholdSet(std::move(innerSet));
+}
+
+/**
+ * @brief (Float > 10 AND NOT(Float < 30 AND Int != 3)) OR Float < 2
+ */
+ArrayThresholdSet CreateInvertedAndSet()
+{
+  auto innerSet = std::make_shared<ArrayThresholdSet>();
+  innerSet->setArrayThresholds({CreateThreshold(k_FloatArrayPath, ArrayThreshold::ComparisonType::LessThan, 30.0, IArrayThreshold::UnionOperator::And),
+                                CreateThreshold(k_IntArrayPath, ArrayThreshold::ComparisonType::Operator_NotEqual, 3, IArrayThreshold::UnionOperator::And)});
+  return CreateThresholdSet(std::move(innerSet));
+}
+
+float32 FloatValue(usize index)
+{
+  return static_cast<float32>(index % 100) * 0.5f;
+}
+
+int32 IntValue(usize index)
+{
+  return static_cast<int32>(index % 7);
+}
+
+bool ExpectedInvertedOr(usize index)
+{
+  return (FloatValue(index) > 10.0f && !(IntValue(index) == 3 || IntValue(index) == 5)) || FloatValue(index) < 2.0f;
+}
+
+bool ExpectedInvertedAnd(usize index)
+{
+  return (FloatValue(index) > 10.0f && !(FloatValue(index) < 30.0f && IntValue(index) != 3)) || FloatValue(index) < 2.0f;
+}
+
+template <typename T, typename ExpectedT>
+void RunMultiThreshold(ChoicesParameter::ValueType maskType, const ArrayThresholdSet& thresholdSet, ExpectedT&& expectedMaskValue)
+{
+  MultiThresholdObjects filter;
+  DataStructure dataGraph = CreateThresholdDataStructure();
+  Arguments args;
+
+  args.insertOrAssign(MultiThresholdObjects::k_ArrayThresholds_Key, std::make_any<ArrayThresholdSet>(thresholdSet));
+  args.insertOrAssign(MultiThresholdObjects::k_CreatedDataPath_Key, std::make_any<DataPath>(k_MaskArrayPath));
+  args.insertOrAssign(MultiThresholdObjects::k_CreatedMaskType_Key, std::make_any<ChoicesParameter::ValueType>(maskType));
+
+  // Preflight the filter and check result
+  auto preflightResult = filter.preflight(dataGraph, args);
+  REQUIRE(preflightResult.outputActions.valid());
+
+  // Execute the filter and check the result
+  auto executeResult = filter.execute(dataGraph, args);
+  REQUIRE(executeResult.result.valid());
+
+  const auto* maskArray = dataGraph.getDataAs<DataArray<T>>(k_MaskArrayPath);
+  REQUIRE(maskArray != nullptr);
+  REQUIRE(maskArray->getNumberOfTuples() == k_NumTuples);
+  usize numWrong = 0;
+  for(usize i = 0; i < k_NumTuples; i++)
+  {
+    numWrong += (*maskArray)[i] == static_cast<T>(expectedMaskValue(i)) ? 0 : 1;
+  }
+  REQUIRE(numWrong == 0);
+}
+} // namespace
+
+TEST_CASE("ComplexCore::MultiThresholdObjects: Bool Mask", "[ComplexCore][MultiThresholdObjects]")
+{
+  RunMultiThreshold<bool>(0, CreateInvertedOrSet(), ExpectedInvertedOr);
+}
+
+TEST_CASE("ComplexCore::MultiThresholdObjects: UInt8 Mask", "[ComplexCore][MultiThresholdObjects]")
+{
+  RunMultiThreshold<uint8>(1, CreateInvertedOrSet(), ExpectedInvertedOr);
+}
+
+TEST_CASE("ComplexCore::MultiThresholdObjects: Inverted Sets", "[ComplexCore][MultiThresholdObjects]")
+{
+  // Inverting a set inverts its combined result rather than each comparison in it
+  RunMultiThreshold<bool>(0, CreateInvertedAndSet(), ExpectedInvertedAnd);
+
+  // Inverting the top level set inverts the whole mask
+  ArrayThresholdSet thresholdSet = CreateInvertedAndSet();
+  thresholdSet.setInverted(true);
+  RunMultiThreshold<uint8>(1, thresholdSet, [](usize index) { return !ExpectedInvertedAnd(index); });
+}
@@ -11,6 +11,11 @@
 #include "ComplexCore/ComplexCore_test_dirs.hpp"
 #include "ComplexCore/Filters/QuickSurfaceMeshFilter.hpp"
 
+#include <array>
+#include <limits>
+#include <random>
+#include <vector>
+
 using namespace complex;
 using namespace complex::UnitTest;
 using namespace complex::Constants;
@@ -60,7 +65,190 @@ DataStructure CreateEbsdTestDataStructure()
 
   return dataGraph;
 }
+
+using MeshIndexType = AbstractGeometry::MeshIndexType;
+
+/**
+ * @brief The mesh of a single pass over the whole grid that numbers each node the first
+ * time one of its faces is found.
+ */
+struct ReferenceMesh
+{
+  std::vector<std::array<usize, 3>> nodes; // Grid position of each node
+  std::vector<MeshIndexType> triangles;
+  std::vector<int32> faceLabels;
+};
+
+ReferenceMesh MeshSinglePass(const std::vector<int32>& featureIds, const SizeVec3& dims)
+{
+  const usize xP = dims[0];
+  const usize yP = dims[1];
+  const usize zP = dims[2];
+  std::vector<MeshIndexType> nodeIds((xP + 1) * (yP + 1) * (zP + 1), std::numeric_limits<MeshIndexType>::max());
+  ReferenceMesh mesh;
+
+  auto addFace = [&](const std::array<std::array<usize, 3>, 4>& corners, bool flip, int32 label0, int32 label1) {
+    std::array<MeshIndexType, 4> n = {};
+    for(usize c = 0; c < 4; c++)
+    {
+      MeshIndexType& nodeId = nodeIds[(corners[c][2] * (yP + 1) + corners[c][1]) * (xP + 1) + corners[c][0]];
+      if(nodeId == std::numeric_limits<MeshIndexType>::max())
+      {
+        nodeId = mesh.nodes.size();
+        mesh.nodes.push_back(corners[c]);
+      }
+      n[c] = nodeId;
+    }
+    if(flip)
+    {
+      mesh.triangles.insert(mesh.triangles.end(), {n[0], n[2], n[1], n[1], n[2], n[3]});
+    }
+    else
+    {
+      mesh.triangles.insert(mesh.triangles.end(), {n[0], n[1], n[2], n[1], n[3], n[2]});
+    }
+    mesh.faceLabels.insert(mesh.faceLabels.end(), {label0, label1, label0, label1});
+  };
+
+  for(usize k = 0; k < zP; k++)
+  {
+    for(usize j = 0; j < yP; j++)
+    {
+      for(usize i = 0; i < xP; i++)
+      {
+        const usize point = (k * yP + j) * xP + i;
+        const int32 f = featureIds[point];
+        if(i == 0)
+        {
+          addFace({{{i, j, k}, {i, j + 1, k}, {i, j, k + 1}, {i, j + 1, k + 1}}}, true, -1, f);
+        }
+        if(j == 0)
+        {
+          addFace({{{i, j, k}, {i + 1, j, k}, {i, j, k + 1}, {i + 1, j, k + 1}}}, false, -1, f);
+        }
+        if(k == 0)
+        {
+          addFace({{{i, j, k}, {i + 1, j, k}, {i, j + 1, k}, {i + 1, j + 1, k}}}, true, -1, f);
+        }
+        const std::array<std::array<usize, 3>, 4> xFace = {{{i + 1, j, k}, {i + 1, j + 1, k}, {i + 1, j, k + 1}, {i + 1, j + 1, k + 1}}};
+        if(i == xP - 1)
+        {
+          addFace(xFace, false, -1, f);
+        }
+        else if(const int32 nf = featureIds[point + 1]; nf != f)
+        {
+          addFace(xFace, f < nf, std::min(f, nf), std::max(f, nf));
+        }
+        const std::array<std::array<usize, 3>, 4> yFace = {{{i + 1, j + 1, k}, {i, j + 1, k}, {i + 1, j + 1, k + 1}, {i, j + 1, k + 1}}};
+        if(j == yP - 1)
+        {
+          addFace(yFace, false, -1, f);
+        }
+        else if(const int32 nf = featureIds[point + xP]; nf != f)
+        {
+          addFace(yFace, f > nf, std::min(f, nf), std::max(f, nf));
+        }
+        const std::array<std::array<usize, 3>, 4> zFace = {{{i + 1, j, k + 1}, {i, j, k + 1}, {i + 1, j + 1, k + 1}, {i, j + 1, k + 1}}};
+        if(k == zP - 1)
+        {
+          addFace(zFace, true, -1, f);
+        }
+        else if(const int32 nf = featureIds[point + xP * yP]; nf != f)
+        {
+          addFace(zFace, f < nf, std::min(f, nf), std::max(f, nf));
+        }
+      }
+    }
+  }
+  return mesh;
+}
 } // namespace
+
+TEST_CASE("ComplexCore::QuickSurfaceMeshFilter: Slabs Match Single Pass", "[SurfaceMeshing][QuickSurfaceMeshFilter]")
+{
+  // Enough Z planes for the grid to be meshed as three slabs
+  const SizeVec3 dims = {5, 4, 40};
+  const std::string k_GeomName = "Image Geometry";
+  const std::string k_FeatureIdsName = "FeatureIds";
+
+  DataStructure dataGraph;
+  ImageGeom* imageGeom = ImageGeom::Create(dataGraph, k_GeomName);
+  imageGeom->setDimensions(dims);
+  imageGeom->setSpacing({0.5f, 2.0f, 0.25f});
+  imageGeom->setOrigin({-3.0f, 1.0f, 7.0f});
+
+  // Blocks of features with about one voxel in five set to a random feature
+  std::vector<int32> featureIdValues(dims[0] * dims[1] * dims[2]);
+  std::mt19937 generator(5489);
+  auto* featureIds = Int32Array::CreateWithStore<Int32DataStore>(dataGraph, k_FeatureIdsName, {dims[2], dims[1], dims[0]}, {1}, imageGeom->getId());
+  for(usize z = 0; z < dims[2]; z++)
+  {
+    for(usize y = 0; y < dims[1]; y++)
+    {
+      for(usize x = 0; x < dims[0]; x++)
+      {
+        const usize index = (z * dims[1] + y) * dims[0] + x;
+        featureIdValues[index] = generator() % 5 == 0 ? static_cast<int32>(1 + generator() % 8) : static_cast<int32>(1 + x / 3 + 2 * (y / 2) + 4 * (z / 6));
+        (*featureIds)[index] = featureIdValues[index];
+      }
+    }
+  }
+
+  DataGroup::Create(dataGraph, k_SmallIN100);
+
+  const DataPath geomPath({k_GeomName});
+  const DataPath parentGroupPath({k_SmallIN100});
+  const DataPath triangleGeometryPath = parentGroupPath.createChildPath(k_TriangleGeometryName);
+  const DataPath vertexGroupDataPath = triangleGeometryPath.createChildPath(k_VertexDataGroupName);
+  const DataPath faceGroupDataPath = triangleGeometryPath.createChildPath(k_FaceDataGroupName);
+  const DataPath faceLabelsDataPath = faceGroupDataPath.createChildPath(k_FaceLabels);
+
+  Arguments args;
+  args.insertOrAssign(QuickSurfaceMeshFilter::k_GenerateTripleLines_Key, std::make_any<bool>(false));
+  args.insertOrAssign(QuickSurfaceMeshFilter::k_FixProblemVoxels_Key, std::make_any<bool>(false));
+  args.insertOrAssign(QuickSurfaceMeshFilter::k_GridGeometryDataPath_Key, std::make_any<DataPath>(geomPath));
+  args.insertOrAssign(QuickSurfaceMeshFilter::k_FeatureIdsArrayPath_Key, std::make_any<DataPath>(geomPath.createChildPath(k_FeatureIdsName)));
+  args.insertOrAssign(QuickSurfaceMeshFilter::k_SelectedDataArrayPaths_Key, std::make_any<MultiArraySelectionParameter::ValueType>(MultiArraySelectionParameter::ValueType{}));
+  args.insertOrAssign(QuickSurfaceMeshFilter::k_ParentDataGroupPath_Key, std::make_any<DataPath>(parentGroupPath));
+  args.insertOrAssign(QuickSurfaceMeshFilter::k_TriangleGeometryName_Key, std::make_any<DataPath>(triangleGeometryPath));
+  args.insertOrAssign(QuickSurfaceMeshFilter::k_VertexDataGroupName_Key, std::make_any<DataPath>(vertexGroupDataPath));
+  args.insertOrAssign(QuickSurfaceMeshFilter::k_NodeTypesArrayName_Key, std::make_any<DataPath>(vertexGroupDataPath.createChildPath(k_NodeTypeArrayName)));
+  args.insertOrAssign(QuickSurfaceMeshFilter::k_FaceDataGroupName_Key, std::make_any<DataPath>(faceGroupDataPath));
+  args.insertOrAssign(QuickSurfaceMeshFilter::k_FaceLabelsArrayName_Key, std::make_any<DataPath>(faceLabelsDataPath));
+
+  QuickSurfaceMeshFilter filter;
+  auto preflightResult = filter.preflight(dataGraph, args);
+  COMPLEX_RESULT_REQUIRE_VALID(preflightResult.outputActions);
+  auto executeResult = filter.execute(dataGraph, args);
+  COMPLEX_RESULT_REQUIRE_VALID(executeResult.result);
+
+  const ReferenceMesh expected = MeshSinglePass(featureIdValues, dims);
+  const TriangleGeom& triangleGeom = dataGraph.getDataRefAs<TriangleGeom>(triangleGeometryPath);
+  const AbstractGeometry::SharedTriList& triangles = *triangleGeom.getFaces();
+  const AbstractGeometry::SharedVertexList& vertices = *triangleGeom.getVertices();
+  const auto& faceLabels = dataGraph.getDataRefAs<Int32Array>(faceLabelsDataPath);
+
+  // The slabs number the nodes and triangles exactly like the single pass
+  REQUIRE(triangles.getSize() == expected.triangles.size());
+  REQUIRE(std::equal(expected.triangles.cbegin(), expected.triangles.cend(), triangles.begin()));
+  REQUIRE(faceLabels.getSize() == expected.faceLabels.size());
+  REQUIRE(std::equal(expected.faceLabels.cbegin(), expected.faceLabels.cend(), faceLabels.begin()));
+
+  // Every node lies at its grid position. The original mesher wrote the fourth node of each -X
+  // face at x + 1, which was only hidden because a later face always wrote that node again.
+  REQUIRE(vertices.getNumberOfTuples() == expected.nodes.size());
+  usize numMisplacedNodes = 0;
+  for(usize node = 0; node < expected.nodes.size(); node++)
+  {
+    const auto& position = expected.nodes[node];
+    const Point3D<float64> coords = imageGeom->getPlaneCoords(position[0], position[1], position[2]);
+    for(usize c = 0; c < 3; c++)
+    {
+      numMisplacedNodes += vertices[node * 3 + c] != static_cast<float32>(coords[c]) ? 1 : 0;
+    }
+  }
+  REQUIRE(numMisplacedNodes == 0);
+}
 TEST_CASE("ComplexCore::QuickSurfaceMeshFilter", "[SurfaceMeshing][QuickSurfaceMeshFilter]")
 {
   // Instantiate the filter, a DataStructure object and an Arguments Object
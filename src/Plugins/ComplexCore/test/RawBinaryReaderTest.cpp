@@ -9,6 +9,10 @@
  *  Case4: This tests when skipHeaderBytes is non-zero, and checks to see if the data read is the same as the data written.
  *
  *  Case5: This tests when skipHeaderBytes equals the file size
+ *
+ *  Case6: This tests reading a file whose endianness differs from the computer's, after an unaligned header.
+ *
+ *  Case7: This tests that the data read is not changed when the file is overwritten or truncated afterwards.
  */
 
 /** we are going to use a fairly large array size because we want to exercise the
@@ -20,6 +24,7 @@
 
 #include "ComplexCore/Filters/RawBinaryReaderFilter.hpp"
 
+#include "complex/Common/Bit.hpp"
 #include "complex/Common/ScopeGuard.hpp"
 #include "complex/DataStructure/DataArray.hpp"
 #include "complex/DataStructure/DataStore.hpp"
@@ -29,7 +34,9 @@
 #include "complex/Parameters/NumberParameter.hpp"
 #include "complex/Parameters/NumericTypeParameter.hpp"
 #include "complex/Parameters/util/DynamicTableData.hpp"
+#include "complex/Utilities/DataArrayUtilities.hpp"
 
+#include <cstring>
 #include <filesystem>
 #include <fstream>
 
@@ -50,7 +57,7 @@ constexpr int32 k_RbrWrongType = -393;
 constexpr int32 k_RbrSkippedTooMuch = -395;
 
 // -----------------------------------------------------------------------------
-Arguments CreateFilterArguments(NumericType scalarType, usize N, usize file_size, usize skipBytes)
+Arguments CreateFilterArguments(NumericType scalarType, usize N, usize file_size, usize skipBytes, endian fileEndian = endian::little)
 {
   Arguments args;
 
@@ -62,7 +69,7 @@ Arguments CreateFilterArguments(NumericType scalarType, usize N, usize file_size
   args.insertOrAssign(RawBinaryReaderFilter::k_TupleDims_Key, std::make_any<DynamicTableData>(tableData));
 
   args.insertOrAssign(RawBinaryReaderFilter::k_NumberOfComponents_Key, std::make_any<uint64>(N));
-  args.insertOrAssign(RawBinaryReaderFilter::k_Endian_Key, std::make_any<ChoicesParameter::ValueType>(static_cast<uint64>(endian::little)));
+  args.insertOrAssign(RawBinaryReaderFilter::k_Endian_Key, std::make_any<ChoicesParameter::ValueType>(static_cast<uint64>(fileEndian)));
   args.insertOrAssign(RawBinaryReaderFilter::k_SkipHeaderBytes_Key, std::make_any<uint64>(skipBytes));
   args.insertOrAssign(RawBinaryReaderFilter::k_CreatedAttributeArrayPath_Key, k_CreatedArrayPath);
 
@@ -305,6 +312,102 @@ void TestCase5_Execute(NumericType scalarType)
   REQUIRE(errors[0].code == k_RbrSkippedTooMuch);
 }
 
+// -----------------------------------------------------------------------------
+// Case6: This tests reading a file whose endianness differs from the computer's, after an unaligned header.
+template <class T, usize N>
+void TestCase6_Execute(NumericType scalarType)
+{
+  constexpr usize tupleCount = 500000;
+  constexpr usize dataArraySize = tupleCount * N;
+  constexpr usize skipHeaderBytes = 3;
+  constexpr endian fileEndian = (endian::native == endian::little) ? endian::big : endian::little;
+
+  std::vector<T> exemplaryData(dataArraySize);
+  std::iota(exemplaryData.begin(), exemplaryData.end(), static_cast<T>(0));
+
+  // The header is followed by the values in the opposite byte order
+  std::vector<uint8> fileBytes(skipHeaderBytes + dataArraySize * sizeof(T), 0xFF);
+  for(usize i = 0; i < dataArraySize; i++)
+  {
+    const T swappedValue = complex::byteswap(exemplaryData[i]);
+    std::memcpy(fileBytes.data() + skipHeaderBytes + i * sizeof(T), &swappedValue, sizeof(T));
+  }
+
+  // Create scope guard to remove file after this test goes out of scope
+  auto fileGuard = MakeScopeGuard([]() noexcept { fs::remove(k_TestOutput); });
+  REQUIRE(CreateTestDataFile<uint8>(fileBytes));
+
+  RawBinaryReaderFilter filter;
+  Arguments args = CreateFilterArguments(scalarType, N, tupleCount, skipHeaderBytes, fileEndian);
+
+  DataStructure ds;
+  auto preflightResult = filter.preflight(ds, args);
+  COMPLEX_RESULT_REQUIRE_VALID(preflightResult.outputActions);
+  auto executeResult = filter.execute(ds, args);
+  COMPLEX_RESULT_REQUIRE_VALID(executeResult.result);
+
+  const DataArray<T>& createdArray = ds.getDataRefAs<DataArray<T>>(k_CreatedArrayPath);
+  REQUIRE(createdArray.getSize() == dataArraySize);
+  usize numMismatches = 0;
+  for(usize i = 0; i < dataArraySize; ++i)
+  {
+    if(createdArray[i] != exemplaryData[i])
+    {
+      numMismatches++;
+    }
+  }
+  REQUIRE(numMismatches == 0);
+}
+
+// -----------------------------------------------------------------------------
+// Case7: This tests that the data read is not changed when the file is overwritten or truncated afterwards.
+template <class T>
+void TestCase7_Execute(NumericType scalarType)
+{
+  constexpr usize tupleCount = 1000000;
+  constexpr usize skipHeaderBytes = 16 * sizeof(T);
+
+  std::vector<T> exemplaryData(tupleCount + skipHeaderBytes / sizeof(T));
+  std::iota(exemplaryData.begin(), exemplaryData.end(), static_cast<T>(1));
+
+  auto fileGuard = MakeScopeGuard([]() noexcept { fs::remove(k_TestOutput); });
+  REQUIRE(CreateTestDataFile<T>(exemplaryData));
+
+  RawBinaryReaderFilter filter;
+  Arguments args = CreateFilterArguments(scalarType, 1, tupleCount, skipHeaderBytes, endian::native);
+
+  DataStructure ds;
+  auto preflightResult = filter.preflight(ds, args);
+  COMPLEX_RESULT_REQUIRE_VALID(preflightResult.outputActions);
+  auto executeResult = filter.execute(ds, args);
+  COMPLEX_RESULT_REQUIRE_VALID(executeResult.result);
+
+  const DataArray<T>& createdArray = ds.getDataRefAs<DataArray<T>>(k_CreatedArrayPath);
+  auto countMismatches = [&]() {
+    usize numMismatches = 0;
+    for(usize i = 0; i < tupleCount; ++i)
+    {
+      if(createdArray[i] != exemplaryData[i + skipHeaderBytes / sizeof(T)])
+      {
+        numMismatches++;
+      }
+    }
+    return numMismatches;
+  };
+  REQUIRE(countMismatches() == 0);
+
+  // Overwrite the file in place with zeros, then truncate it
+  {
+    std::fstream file(k_TestOutput, std::ios::binary | std::ios::in | std::ios::out);
+    REQUIRE(file.is_open());
+    const std::vector<char> zeros(exemplaryData.size() * sizeof(T), 0);
+    file.write(zeros.data(), static_cast<std::streamsize>(zeros.size()));
+  }
+  REQUIRE(countMismatches() == 0);
+  fs::resize_file(k_TestOutput, 0);
+  REQUIRE(countMismatches() == 0);
+}
+
 // -----------------------------------------------------------------------------
 template <class T>
 void TestCase5_TestPrimitives(NumericType scalarType)
@@ -395,3 +498,32 @@ TEST_CASE("ComplexCore::RawBinaryReaderFilter(Case5)", "[ComplexCore][RawBinaryR
   TestCase5_TestPrimitives<float32>(NumericType::float32);
   TestCase5_TestPrimitives<float64>(NumericType::float64);
 }
+
+// Case6: This tests reading a file whose endianness differs from the computer's, after an unaligned header.
+TEST_CASE("ComplexCore::RawBinaryReaderFilter(Case6)", "[ComplexCore][RawBinaryReaderFilter]")
+{
+  // Create the parent directory path
+  fs::create_directories(k_TestOutput.parent_path());
+
+  TestCase6_Execute<int8, 3>(NumericType::int8);
+  TestCase6_Execute<uint16, 1>(NumericType::uint16);
+  TestCase6_Execute<int32, 3>(NumericType::int32);
+  TestCase6_Execute<uint64, 2>(NumericType::uint64);
+  TestCase6_Execute<float32, 3>(NumericType::float32);
+  TestCase6_Execute<float64, 1>(NumericType::float64);
+}
+
+// Case7: This tests that the data read is not changed when the file is overwritten or truncated afterwards.
+TEST_CASE("ComplexCore::RawBinaryReaderFilter(Case7)", "[ComplexCore][RawBinaryReaderFilter]")
+{
+  // Create the parent directory path
+  fs::create_directories(k_TestOutput.parent_path());
+
+  // Large arrays are created as memory mapped data stores
+  const uint64 previousThreshold = GetMemoryMappedThreshold();
+  auto thresholdGuard = MakeScopeGuard([previousThreshold]() noexcept { SetMemoryMappedThreshold(previousThreshold); });
+  SetMemoryMappedThreshold(1024);
+
+  TestCase7_Execute<int32>(NumericType::int32);
+  TestCase7_Execute<float64>(NumericType::float64);
+}
@@ -9,13 +9,101 @@
 #include "ComplexCore/ComplexCore_test_dirs.hpp"
 #include "ComplexCore/Filters/StlFileReaderFilter.hpp"
 
+#include <array>
+#include <cstring>
 #include <filesystem>
+#include <fstream>
 #include <string>
+#include <vector>
 namespace fs = std::filesystem;
 
 using namespace complex;
 using namespace complex::Constants;
 
+namespace
+{
+/**
+ * @brief The normal followed by the 3 vertices of a triangle record.
+ */
+using StlTriangle = std::array<float32, 12>;
+
+/**
+ * @brief Two triangles sharing an edge and a third sharing a vertex, one of which
+ * is written as -0.0. The welded mesh has 5 vertices in first use order.
+ */
+const std::vector<StlTriangle> k_Triangles = {
+    StlTriangle{0.0F, 0.0F, 1.0F, 0.0F, 0.0F, 0.0F, 1.0F, 0.0F, 0.0F, 0.0F, 1.0F, 0.0F},
+    StlTriangle{0.0F, 0.0F, 1.0F, 1.0F, 0.0F, 0.0F, 1.0F, 1.0F, 0.0F, 0.0F, 1.0F, 0.0F},
+    StlTriangle{0.0F, -1.0F, 0.0F, -0.0F, 0.0F, 0.0F, 0.0F, 0.0F, 1.0F, 1.0F, 0.0F, 0.0F},
+};
+const std::vector<float32> k_WeldedVertices = {0.0F, 0.0F, 0.0F, 1.0F, 0.0F, 0.0F, 0.0F, 1.0F, 0.0F, 1.0F, 1.0F, 0.0F, 0.0F, 0.0F, 1.0F};
+const std::vector<AbstractGeometry::MeshIndexType> k_WeldedTriangles = {0, 1, 2, 1, 3, 2, 0, 4, 1};
+
+/**
+ * @brief Writes a binary STL file. When writeAttributeBytes is true each triangle is
+ * followed by as many attribute bytes as its attribute byte count, otherwise the count
+ * is only stored in the record as Magics does for colors.
+ */
+void WriteStlFile(const fs::path& filePath, const std::string& header, const std::vector<uint16>& attributeByteCounts, bool writeAttributeBytes)
+{
+  std::ofstream file(filePath, std::ios::binary);
+  std::array<char, 80> headerBytes = {};
+  std::memcpy(headerBytes.data(), header.data(), std::min(header.size(), headerBytes.size()));
+  file.write(headerBytes.data(), headerBytes.size());
+  const int32 triCount = static_cast<int32>(k_Triangles.size());
+  file.write(reinterpret_cast<const char*>(&triCount), sizeof(triCount));
+  for(usize t = 0; t < k_Triangles.size(); t++)
+  {
+    file.write(reinterpret_cast<const char*>(k_Triangles[t].data()), sizeof(StlTriangle));
+    file.write(reinterpret_cast<const char*>(&attributeByteCounts[t]), sizeof(uint16));
+    if(writeAttributeBytes)
+    {
+      // Bytes that would decode as NaN if they were read as part of a triangle
+      const std::string attributeBytes(attributeByteCounts[t], '\xFF');
+      file.write(attributeBytes.data(), attributeBytes.size());
+    }
+  }
+}
+
+/**
+ * @brief Reads the file with the filter and requires the welded mesh.
+ */
+void RequireWeldedMesh(const fs::path& filePath)
+{
+  DataStructure dataGraph;
+  Arguments args;
+  StlFileReaderFilter filter;
+
+  DataPath triangleGeomDataPath({"[Triangle Geometry]"});
+  DataPath normalsDataPath({"[Triangle Geometry]", "Face Data", "Normals"});
+  args.insertOrAssign(StlFileReaderFilter::k_StlFilePath_Key, std::make_any<FileSystemPathParameter::ValueType>(filePath));
+  args.insertOrAssign(StlFileReaderFilter::k_GeometryDataPath_Key, std::make_any<DataPath>(triangleGeomDataPath));
+  args.insertOrAssign(StlFileReaderFilter::k_FaceGroupDataPath_Key, std::make_any<DataPath>(DataPath({"[Triangle Geometry]", "Face Data"})));
+  args.insertOrAssign(StlFileReaderFilter::k_FaceNormalsDataPath_Key, std::make_any<DataPath>(normalsDataPath));
+
+  auto executeResult = filter.execute(dataGraph, args);
+  COMPLEX_RESULT_REQUIRE_VALID(executeResult.result);
+
+  TriangleGeom& triangleGeom = dataGraph.getDataRefAs<TriangleGeom>(triangleGeomDataPath);
+  REQUIRE(triangleGeom.getNumberOfFaces() == k_Triangles.size());
+  REQUIRE(triangleGeom.getNumberOfVertices() == k_WeldedVertices.size() / 3);
+
+  const auto& vertices = *triangleGeom.getVertices();
+  REQUIRE(std::vector<float32>(vertices.begin(), vertices.end()) == k_WeldedVertices);
+  const auto& triangles = *triangleGeom.getFaces();
+  REQUIRE(std::vector<AbstractGeometry::MeshIndexType>(triangles.begin(), triangles.end()) == k_WeldedTriangles);
+
+  const auto& normals = dataGraph.getDataRefAs<Float64Array>(normalsDataPath);
+  for(usize t = 0; t < k_Triangles.size(); t++)
+  {
+    for(usize c = 0; c < 3; c++)
+    {
+      REQUIRE(normals[t * 3 + c] == static_cast<float64>(k_Triangles[t][c]));
+    }
+  }
+}
+} // namespace
+
 TEST_CASE("ComplexCore::StlFileReaderFilter", "[ComplexCore][StlFileReaderFilter]")
 {
   // Instantiate the filter, a DataStructure object and an Arguments Object
@@ -53,3 +141,40 @@ TEST_CASE("ComplexCore::StlFileReaderFilter", "[ComplexCore][StlFileReaderFilter
   herr_t err = dataGraph.writeHdf5(fileWriter);
   REQUIRE(err >= 0);
 }
+
+TEST_CASE("ComplexCore::StlFileReaderFilter(Attribute Bytes and Welding)", "[ComplexCore][StlFileReaderFilter]")
+{
+  SECTION("Attribute Bytes")
+  {
+    // Records are no longer 50 bytes apart once a triangle stores attribute bytes
+    const fs::path filePath = fs::path(unit_test::k_BinaryDir.view()) / "StlFileReaderTest_AttributeBytes.stl";
+    WriteStlFile(filePath, "Binary STL with attribute bytes", {2, 0, 5}, true);
+    RequireWeldedMesh(filePath);
+  }
+
+  SECTION("Magics Color")
+  {
+    // A Magics color is stored in the attribute byte count without any attribute bytes
+    const fs::path filePath = fs::path(unit_test::k_BinaryDir.view()) / "StlFileReaderTest_MagicsColor.stl";
+    WriteStlFile(filePath, "COLOR=\x80\x80\x80\xFF MATERIAL=", {0x801F, 0x7C00, 0x03E0}, false);
+    RequireWeldedMesh(filePath);
+  }
+
+  SECTION("Truncated Attribute Bytes")
+  {
+    // The attribute bytes of the last triangle push its record past the end of the file
+    const fs::path filePath = fs::path(unit_test::k_BinaryDir.view()) / "StlFileReaderTest_Truncated.stl";
+    WriteStlFile(filePath, "Binary STL with attribute bytes", {60, 0, 0}, true);
+    fs::resize_file(filePath, fs::file_size(filePath) - 70);
+
+    DataStructure dataGraph;
+    Arguments args;
+    StlFileReaderFilter filter;
+    args.insertOrAssign(StlFileReaderFilter::k_StlFilePath_Key, std::make_any<FileSystemPathParameter::ValueType>(filePath));
+    args.insertOrAssign(StlFileReaderFilter::k_GeometryDataPath_Key, std::make_any<DataPath>(DataPath({"[Triangle Geometry]"})));
+    args.insertOrAssign(StlFileReaderFilter::k_FaceGroupDataPath_Key, std::make_any<DataPath>(DataPath({"[Triangle Geometry]", "Face Data"})));
+    args.insertOrAssign(StlFileReaderFilter::k_FaceNormalsDataPath_Key, std::make_any<DataPath>(DataPath({"[Triangle Geometry]", "Face Data", "Normals"})));
+    auto executeResult = filter.execute(dataGraph, args);
+    REQUIRE(executeResult.result.invalid());
+  }
+}
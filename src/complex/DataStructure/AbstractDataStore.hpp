@@ -4,11 +4,15 @@
 #include "complex/DataStructure/IDataStore.hpp"
 #include "complex/Utilities/Parsing/HDF5/H5.hpp"
 
+#include <fmt/core.h>
+
 #include <nonstd/span.hpp>
 
 #include <algorithm>
 #include <functional>
 #include <iterator>
+#include <memory>
+#include <stdexcept>
 
 namespace complex
 {
@@ -35,6 +39,8 @@ public:
   using ShapeType = typename IDataStore::ShapeType;
   using index_type = uint64;
 
+  static constexpr usize k_DefaultTuplesPerChunk = 65536;
+
   /////////////////////////////////
   // Begin std::iterator support //
   /////////////////////////////////
@@ -441,6 +447,190 @@ public:
     std::fill(begin(), end(), value);
   }
 
+  /**
+   * @brief Returns a pointer to the first value if all of the values are held
+   * in a single contiguous buffer. Otherwise, returns nullptr.
+   *
+   * Subclasses that own a contiguous buffer should override this so that
+   * algorithms can bypass the virtual element accessors.
+   * @return value_type*
+   */
+  virtual value_type* contiguousData()
+  {
+    return nullptr;
+  }
+
+  /**
+   * @brief Returns a pointer to the first value if all of the values are held
+   * in a single contiguous buffer. Otherwise, returns nullptr.
+   * @return const value_type*
+   */
+  virtual const value_type* contiguousData() const
+  {
+    return nullptr;
+  }
+
+  /**
+   * @brief Returns true if the values can be accessed through createSpan().
+   * @return bool
+   */
+  bool isContiguous() const
+  {
+    return getSize() == 0 || contiguousData() != nullptr;
+  }
+
+  /**
+   * @brief Returns a span over all of the values in the data store. Indexing
+   * the span does not require a virtual call per value.
+   *
+   * Throws a runtime_error if the data store is not contiguous.
+   * @return nonstd::span<value_type>
+   */
+  nonstd::span<value_type> createSpan()
+  {
+    if(!isContiguous())
+    {
+      throw std::runtime_error(fmt::format("AbstractDataStore: A data store of type {} cannot be accessed as a contiguous span", static_cast<int32>(getStoreType())));
+    }
+    return {contiguousData(), getSize()};
+  }
+
+  /**
+   * @brief Returns a read-only span over all of the values in the data store.
+   *
+   * Throws a runtime_error if the data store is not contiguous.
+   * @return nonstd::span<const value_type>
+   */
+  nonstd::span<const value_type> createSpan() const
+  {
+    if(!isContiguous())
+    {
+      throw std::runtime_error(fmt::format("AbstractDataStore: A data store of type {} cannot be accessed as a contiguous span", static_cast<int32>(getStoreType())));
+    }
+    return {contiguousData(), getSize()};
+  }
+
+  /**
+   * @brief Copies buffer.size() values starting at startIndex into the
+   * provided buffer.
+   *
+   * Throws a runtime_error if the requested range is out of bounds.
+   * @param startIndex
+   * @param buffer
+   */
+  virtual void copyIntoBuffer(usize startIndex, nonstd::span<value_type> buffer) const
+  {
+    if(startIndex + buffer.size() > getSize())
+    {
+      throw std::runtime_error(fmt::format("AbstractDataStore: Range [{}, {}) is out of bounds ({})", startIndex, startIndex + buffer.size(), getSize()));
+    }
+    if(const value_type* dataPtr = contiguousData(); dataPtr != nullptr)
+    {
+      std::copy_n(dataPtr + startIndex, buffer.size(), buffer.begin());
+      return;
+    }
+    for(usize i = 0; i < buffer.size(); i++)
+    {
+      buffer[i] = getValue(startIndex + i);
+    }
+  }
+
+  /**
+   * @brief Copies the values in the provided buffer into the data store
+   * starting at startIndex.
+   *
+   * Throws a runtime_error if the requested range is out of bounds.
+   * @param startIndex
+   * @param buffer
+   */
+  virtual void copyFromBuffer(usize startIndex, nonstd::span<const value_type> buffer)
+  {
+    if(startIndex + buffer.size() > getSize())
+    {
+      throw std::runtime_error(fmt::format("AbstractDataStore: Range [{}, {}) is out of bounds ({})", startIndex, startIndex + buffer.size(), getSize()));
+    }
+    if(value_type* dataPtr = contiguousData(); dataPtr != nullptr)
+    {
+      std::copy(buffer.begin(), buffer.end(), dataPtr + startIndex);
+      return;
+    }
+    for(usize i = 0; i < buffer.size(); i++)
+    {
+      setValue(startIndex + i, buffer[i]);
+    }
+  }
+
+  /**
+   * @brief Calls func(startIndex, chunk) for consecutive chunks of whole tuples
+   * covering the data store, where startIndex is the index of the first value
+   * in the chunk. Contiguous data stores hand out spans over their own buffer.
+   * Other data stores copy each chunk into a scratch buffer and copy it back
+   * after func returns, so modifications made through the span are kept.
+   * @tparam FuncT void(usize, nonstd::span<value_type>)
+   * @param tuplesPerChunk Passing 0 uses k_DefaultTuplesPerChunk
+   * @param func
+   */
+  template <typename FuncT>
+  void forEachChunk(usize tuplesPerChunk, FuncT&& func)
+  {
+    const usize size = getSize();
+    const usize chunkSize = (tuplesPerChunk == 0 ? k_DefaultTuplesPerChunk : tuplesPerChunk) * getNumberOfComponents();
+    if(size == 0 || chunkSize == 0)
+    {
+      return;
+    }
+    if(value_type* dataPtr = contiguousData(); dataPtr != nullptr)
+    {
+      for(usize offset = 0; offset < size; offset += chunkSize)
+      {
+        func(offset, nonstd::span<value_type>(dataPtr + offset, std::min(chunkSize, size - offset)));
+      }
+      return;
+    }
+    auto buffer = std::make_unique<value_type[]>(std::min(chunkSize, size));
+    for(usize offset = 0; offset < size; offset += chunkSize)
+    {
+      nonstd::span<value_type> chunk(buffer.get(), std::min(chunkSize, size - offset));
+      copyIntoBuffer(offset, chunk);
+      func(offset, chunk);
+      copyFromBuffer(offset, chunk);
+    }
+  }
+
+  /**
+   * @brief Calls func(startIndex, chunk) for consecutive read-only chunks of
+   * whole tuples covering the data store, where startIndex is the index of the
+   * first value in the chunk.
+   * @tparam FuncT void(usize, nonstd::span<const value_type>)
+   * @param tuplesPerChunk Passing 0 uses k_DefaultTuplesPerChunk
+   * @param func
+   */
+  template <typename FuncT>
+  void forEachChunk(usize tuplesPerChunk, FuncT&& func) const
+  {
+    const usize size = getSize();
+    const usize chunkSize = (tuplesPerChunk == 0 ? k_DefaultTuplesPerChunk : tuplesPerChunk) * getNumberOfComponents();
+    if(size == 0 || chunkSize == 0)
+    {
+      return;
+    }
+    if(const value_type* dataPtr = contiguousData(); dataPtr != nullptr)
+    {
+      for(usize offset = 0; offset < size; offset += chunkSize)
+      {
+        func(offset, nonstd::span<const value_type>(dataPtr + offset, std::min(chunkSize, size - offset)));
+      }
+      return;
+    }
+    auto buffer = std::make_unique<value_type[]>(std::min(chunkSize, size));
+    for(usize offset = 0; offset < size; offset += chunkSize)
+    {
+      nonstd::span<value_type> chunk(buffer.get(), std::min(chunkSize, size - offset));
+      copyIntoBuffer(offset, chunk);
+      func(offset, nonstd::span<const value_type>(chunk.data(), chunk.size()));
+    }
+  }
+
   /**
    * @brief Returns the DataStore's DataType as an enum
    * @return DataType
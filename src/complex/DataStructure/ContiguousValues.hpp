@@ -0,0 +1,93 @@
+#pragma once
+
+#include "complex/Common/Types.hpp"
+#include "complex/DataStructure/AbstractDataStore.hpp"
+
+#include <nonstd/span.hpp>
+
+#include <algorithm>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace complex
+{
+/**
+ * @class ContiguousValues
+ * @brief Gives algorithms that index values at random a single span over all of
+ * the values of a data store. Contiguous data stores are accessed in place. The
+ * values of any other data store are copied into a buffer with forEachChunk()
+ * and, for writable values, copied back by commit().
+ * @tparam T Pass a const type for read-only access.
+ */
+template <typename T>
+class ContiguousValues
+{
+public:
+  using value_type = std::remove_const_t<T>;
+  using store_type = std::conditional_t<std::is_const_v<T>, const AbstractDataStore<value_type>, AbstractDataStore<value_type>>;
+
+  /**
+   * @brief Creates the span over the values of the data store. The data store
+   * must outlive the ContiguousValues.
+   * @param dataStore
+   */
+  explicit ContiguousValues(store_type& dataStore)
+  : m_DataStore(dataStore)
+  {
+    if(dataStore.isContiguous())
+    {
+      m_Values = dataStore.createSpan();
+      return;
+    }
+    m_Buffer = std::make_unique<value_type[]>(dataStore.getSize());
+    std::as_const(dataStore).forEachChunk(0, [this](usize startIndex, nonstd::span<const value_type> chunk) { std::copy(chunk.begin(), chunk.end(), m_Buffer.get() + startIndex); });
+    m_Values = nonstd::span<T>(m_Buffer.get(), dataStore.getSize());
+  }
+
+  ContiguousValues(const ContiguousValues&) = delete;
+  ContiguousValues(ContiguousValues&&) = delete;
+  ContiguousValues& operator=(const ContiguousValues&) = delete;
+  ContiguousValues& operator=(ContiguousValues&&) = delete;
+
+  ~ContiguousValues() = default;
+
+  /**
+   * @brief Returns the span over every value of the data store.
+   * @return nonstd::span<T>
+   */
+  nonstd::span<T> span() const
+  {
+    return m_Values;
+  }
+
+  /**
+   * @brief Returns true if the values were copied out of the data store.
+   * @return bool
+   */
+  bool isCopy() const
+  {
+    return m_Buffer != nullptr;
+  }
+
+  /**
+   * @brief Copies the values back into the data store if they were copied out
+   * of it. Changes made through the span are not visible in a data store that
+   * is not contiguous until this is called.
+   */
+  void commit()
+  {
+    static_assert(!std::is_const_v<T>, "ContiguousValues: Read-only values cannot be committed");
+    if(m_Buffer == nullptr)
+    {
+      return;
+    }
+    m_DataStore.forEachChunk(0, [this](usize startIndex, nonstd::span<value_type> chunk) { std::copy_n(m_Buffer.get() + startIndex, chunk.size(), chunk.begin()); });
+  }
+
+private:
+  store_type& m_DataStore;
+  std::unique_ptr<value_type[]> m_Buffer;
+  nonstd::span<T> m_Values;
+};
+} // namespace complex
@@ -368,6 +368,27 @@ public:
     return m_DataStore.get();
   }
 
+  /**
+   * @brief Replaces the DataStore with a copy-on-write copy if it is shared
+   * with another DataArray. Returns false if the DataStore cannot be copied
+   * without duplicating its values, in which case it remains shared.
+   * @return bool
+   */
+  bool detachDataStore() override
+  {
+    if(m_DataStore == nullptr || m_DataStore.use_count() == 1)
+    {
+      return true;
+    }
+    if(!m_DataStore->isCopyOnWrite())
+    {
+      return false;
+    }
+    std::shared_ptr<IDataStore> sharedStore = m_DataStore->deepCopy();
+    m_DataStore = std::dynamic_pointer_cast<store_type>(sharedStore);
+    return true;
+  }
+
   /**
    * @brief Returns a reference to the DataStore.
    * @return DataStore<T>&
@@ -394,6 +415,38 @@ public:
     return *m_DataStore;
   }
 
+  /**
+   * @brief Returns true if the DataStore values can be accessed through createSpan().
+   * @return bool
+   */
+  bool isContiguous() const
+  {
+    return getDataStoreRef().isContiguous();
+  }
+
+  /**
+   * @brief Returns a span over the DataStore values. Prefer this over operator[]
+   * in tight loops because indexing the span does not require a virtual call.
+   *
+   * Throws an exception if the DataStore is not contiguous.
+   * @return nonstd::span<T>
+   */
+  nonstd::span<T> createSpan()
+  {
+    return getDataStoreRef().createSpan();
+  }
+
+  /**
+   * @brief Returns a read-only span over the DataStore values.
+   *
+   * Throws an exception if the DataStore is not contiguous.
+   * @return nonstd::span<const T>
+   */
+  nonstd::span<const T> createSpan() const
+  {
+    return getDataStoreRef().createSpan();
+  }
+
   /**
    * @brief Returns a std::weak_ptr for the stored DataStore.
    * @return std::weak_ptr<DataStore<T>>
@@ -308,6 +308,10 @@ H5::ErrorType DataMap::readH5Group(H5::DataStructureReader& dataStructureReader,
   for(const auto& childName : childrenNames)
   {
     auto errorCode = dataStructureReader.readObjectFromGroup(h5Group, childName, dsParentId, preflight);
+    if(errorCode < 0)
+    {
+      return errorCode;
+    }
   }
   return 0;
 }
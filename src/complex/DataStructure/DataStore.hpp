@@ -11,10 +11,13 @@
 #include <nonstd/span.hpp>
 
 #include <algorithm>
+#include <atomic>
 #include <iostream>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <stdexcept>
+#include <utility>
 #include <vector>
 
 #include <cstring>
@@ -25,6 +28,13 @@ namespace complex
  * @class DataStore
  * @brief The DataStore class handles the storing and retrieval of data for
  * use in DataArrays.
+ *
+ * Copies share the same buffer until one of them is written to, at which point
+ * the written store takes a private copy of the values. Reads never copy. The
+ * non-const accessors are the write paths, so a mutable pointer or span must be
+ * obtained after the DataStore was copied. Const pointers and spans obtained
+ * before the first write of a shared store keep the values from before the
+ * write for as long as a copy holds them.
  * @tparam T
  */
 template <typename T>
@@ -82,27 +92,29 @@ public:
   , m_Data(std::move(buffer))
   , m_NumComponents(std::accumulate(m_ComponentShape.cbegin(), m_ComponentShape.cend(), static_cast<size_t>(1), std::multiplies<>()))
   , m_NumTuples(std::accumulate(m_TupleShape.cbegin(), m_TupleShape.cend(), static_cast<size_t>(1), std::multiplies<>()))
+  , m_Values(m_Data.get())
   {
   }
 
   /**
-   * @brief Copy constructor
+   * @brief Copy constructor. The copy shares the values of the original until
+   * either of them is written to.
    * @param other
    */
   DataStore(const DataStore& other)
   : m_ComponentShape(other.m_ComponentShape)
   , m_TupleShape(other.m_TupleShape)
+  , m_Data(other.m_Data)
   , m_NumComponents(other.m_NumComponents)
   , m_NumTuples(other.m_NumTuples)
+  , m_Values(m_Data.get())
+  , m_MaybeShared(true)
   {
-    const usize count = other.getSize();
-    auto data = new value_type[count];
-    std::memcpy(data, other.m_Data.get(), count * sizeof(T));
-    m_Data.reset(data);
+    other.m_MaybeShared.store(true, std::memory_order_release);
   }
 
   /**
-   * @brief Move constructor
+   * @brief Move constructor. The moved-from DataStore is left without any tuples.
    * @param other
    */
   DataStore(DataStore&& other) noexcept
@@ -110,7 +122,9 @@ public:
   , m_TupleShape(std::move(other.m_TupleShape))
   , m_Data(std::move(other.m_Data))
   , m_NumComponents(std::move(other.m_NumComponents))
-  , m_NumTuples(std::move(other.m_NumTuples))
+  , m_NumTuples(std::exchange(other.m_NumTuples, 0))
+  , m_Values(other.m_Values.exchange(nullptr))
+  , m_MaybeShared(other.m_MaybeShared.exchange(false))
   {
   }
 
@@ -122,11 +136,21 @@ public:
   DataStore& operator=(const DataStore& rhs) = delete;
 
   /**
-   * @brief Move assignment.
+   * @brief Move assignment. The moved-from DataStore is left without any tuples.
    * @param rhs
    * @return
    */
-  DataStore& operator=(DataStore&& rhs) = default;
+  DataStore& operator=(DataStore&& rhs) noexcept
+  {
+    m_ComponentShape = std::move(rhs.m_ComponentShape);
+    m_TupleShape = std::move(rhs.m_TupleShape);
+    m_Data = std::move(rhs.m_Data);
+    m_NumComponents = rhs.m_NumComponents;
+    m_NumTuples = std::exchange(rhs.m_NumTuples, 0);
+    m_Values.store(rhs.m_Values.exchange(nullptr));
+    m_MaybeShared.store(rhs.m_MaybeShared.exchange(false));
+    return *this;
+  }
 
   ~DataStore() override = default;
 
@@ -145,16 +169,28 @@ public:
    */
   const T* data() const
   {
-    return m_Data.get();
+    return m_Values.load(std::memory_order_acquire);
   }
 
   /**
-   * @brief Returns the pointer to the allocated data. Non-const version
+   * @brief Returns the pointer to the allocated data. Non-const version.
+   * Takes a private copy of the values first if they are shared.
    * @return
    */
   T* data()
   {
-    return m_Data.get();
+    detach(true);
+    return m_Values.load(std::memory_order_acquire);
+  }
+
+  /**
+   * @brief Returns true if the values are currently shared with a copy of
+   * this DataStore.
+   * @return bool
+   */
+  bool isSharingData() const
+  {
+    return m_Data != nullptr && m_Data.use_count() > 1;
   }
 
   /**
@@ -208,8 +244,7 @@ public:
 
     if(m_Data.get() == nullptr) // Data was never allocated
     {
-      auto data = new value_type[newSize];
-      m_Data.reset(data);
+      setData(std::shared_ptr<value_type[]>(new value_type[newSize]));
       return;
     }
 
@@ -223,12 +258,10 @@ public:
     // We have now figured out that the old array and the new array are different sizes so
     // copy the old data into the newly allocated data array or as much or as little
     // as possible
-    auto data = new value_type[newSize];
-    for(usize i = 0; i < newSize && i < oldSize; i++)
-    {
-      data[i] = m_Data[i];
-    }
-    m_Data.reset(data);
+    // The new buffer is not shared with any copies of this DataStore
+    std::shared_ptr<value_type[]> data(new value_type[newSize]);
+    std::copy_n(m_Data.get(), std::min(newSize, oldSize), data.get());
+    setData(std::move(data));
   }
 
   /**
@@ -239,7 +272,7 @@ public:
    */
   value_type getValue(usize index) const override
   {
-    return m_Data[index];
+    return data()[index];
   }
 
   /**
@@ -249,7 +282,7 @@ public:
    */
   void setValue(usize index, value_type value) override
   {
-    m_Data[index] = value;
+    data()[index] = value;
   }
 
   /**
@@ -260,7 +293,7 @@ public:
    */
   const_reference operator[](usize index) const override
   {
-    return m_Data.get()[index];
+    return data()[index];
   }
 
   /**
@@ -271,7 +304,7 @@ public:
    */
   reference operator[](usize index) override
   {
-    return m_Data.get()[index];
+    return data()[index];
   }
 
   /**
@@ -286,11 +319,23 @@ public:
     {
       throw std::runtime_error("");
     }
-    return m_Data[index];
+    return data()[index];
   }
 
   /**
-   * @brief Returns a deep copy of the data store and all its data.
+   * @brief Fills the DataStore with the specified value. Shared values are
+   * replaced rather than copied since every value is overwritten.
+   * @param value
+   */
+  void fill(value_type value) override
+  {
+    detach(false);
+    std::fill_n(m_Values.load(std::memory_order_acquire), this->getSize(), value);
+  }
+
+  /**
+   * @brief Returns a deep copy of the data store and all its data. The values
+   * are shared with the copy until either store is written to.
    * @return std::unique_ptr<IDataStore>
    */
   std::unique_ptr<IDataStore> deepCopy() const override
@@ -298,6 +343,15 @@ public:
     return std::make_unique<DataStore<T>>(*this);
   }
 
+  /**
+   * @brief Returns true since copies share their values until written to.
+   * @return bool
+   */
+  bool isCopyOnWrite() const override
+  {
+    return true;
+  }
+
   /**
    * @brief Returns a data store of the same type as this but with default initialized data.
    * @return std::unique_ptr<IDataStore>
@@ -307,14 +361,22 @@ public:
     return std::make_unique<DataStore<T>>(this->getTupleShape(), this->getComponentShape(), static_cast<T>(0));
   }
 
-  nonstd::span<T> createSpan()
+  /**
+   * @brief Returns the pointer to the allocated data. Non-const version
+   * @return value_type*
+   */
+  value_type* contiguousData() override
   {
-    return {data(), this->getSize()};
+    return data();
   }
 
-  nonstd::span<const T> createSpan() const
+  /**
+   * @brief Returns the pointer to the allocated data. Const version
+   * @return const value_type*
+   */
+  const value_type* contiguousData() const override
   {
-    return {data(), this->getSize()};
+    return data();
   }
 
   /**
@@ -380,11 +442,59 @@ public:
   }
 
 private:
+  /**
+   * @brief Gives this DataStore a private buffer if its values are shared with
+   * a copy. The values are only copied into the new buffer if copyValues is
+   * true. Every write path calls this first. Safe to call from multiple threads
+   * reading and writing the same DataStore: readers keep using the shared
+   * buffer, which the copy holds on to, until they load the new one.
+   * @param copyValues
+   */
+  void detach(bool copyValues)
+  {
+    if(!m_MaybeShared.load(std::memory_order_acquire))
+    {
+      return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_DetachMutex);
+    if(!m_MaybeShared.load(std::memory_order_relaxed))
+    {
+      return;
+    }
+    if(m_Data.use_count() > 1)
+    {
+      const usize count = this->getSize();
+      std::shared_ptr<value_type[]> data(new value_type[count]);
+      if(copyValues)
+      {
+        std::copy_n(m_Data.get(), count, data.get());
+      }
+      setData(std::move(data));
+    }
+    m_MaybeShared.store(false, std::memory_order_release);
+  }
+
+  /**
+   * @brief Replaces the buffer and publishes it to the accessors.
+   * @param data
+   */
+  void setData(std::shared_ptr<value_type[]> data)
+  {
+    m_Data = std::move(data);
+    m_Values.store(m_Data.get(), std::memory_order_release);
+  }
+
   ShapeType m_ComponentShape;
   ShapeType m_TupleShape;
-  std::unique_ptr<value_type[]> m_Data = nullptr;
+  std::shared_ptr<value_type[]> m_Data = nullptr;
   size_t m_NumComponents = {0};
   size_t m_NumTuples = {0};
+  // The accessors read through this pointer rather than m_Data, which a writer may replace while they read
+  std::atomic<value_type*> m_Values = {nullptr};
+  // Set by the copy constructor on the DataStore being copied as well
+  mutable std::atomic_bool m_MaybeShared = {false};
+  std::mutex m_DetachMutex;
 };
 
 // Declare aliases
@@ -3,6 +3,7 @@
 #include "complex/DataStructure/BaseGroup.hpp"
 #include "complex/DataStructure/DataGroup.hpp"
 #include "complex/DataStructure/IDataArray.hpp"
+#include "complex/DataStructure/INeighborList.hpp"
 #include "complex/DataStructure/LinkedPath.hpp"
 #include "complex/DataStructure/Messaging/DataAddedMessage.hpp"
 #include "complex/DataStructure/Messaging/DataRemovedMessage.hpp"
@@ -222,6 +223,24 @@ std::vector<DataObject::IdType> DataStructure::getAllDataObjectIds() const
   return dataIds;
 }
 
+bool DataStructure::detachDataStores()
+{
+  bool detached = true;
+  for(auto& [id, weakPtr] : m_DataObjects)
+  {
+    auto dataObject = weakPtr.lock();
+    if(auto dataArray = std::dynamic_pointer_cast<IDataArray>(dataObject); dataArray != nullptr)
+    {
+      detached = dataArray->detachDataStore() && detached;
+    }
+    else if(auto neighborList = std::dynamic_pointer_cast<INeighborList>(dataObject); neighborList != nullptr)
+    {
+      neighborList->detachLists();
+    }
+  }
+  return detached;
+}
+
 DataObject* DataStructure::getData(DataObject::IdType id)
 {
   auto iter = m_DataObjects.find(id);
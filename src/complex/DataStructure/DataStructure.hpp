@@ -470,6 +470,18 @@ public:
    */
   const DataMap& getDataMap() const;
 
+  /**
+   * @brief Gives every DataArray its own copy-on-write DataStore and every
+   * NeighborList its own lists. Copies of a DataStructure share the DataStores
+   * of their DataArrays and the lists of their NeighborLists, so writes through
+   * one copy are otherwise visible in the other. StringArrays copy their strings
+   * and DynamicListArrays cannot be shallow copied, so neither is ever shared.
+   * Returns false if any DataStore cannot be copied on
+   * write and is still shared.
+   * @return bool
+   */
+  bool detachDataStores();
+
   /**
    * @brief Inserts a new DataObject into the DataStructure nested under the given
    * DataPath. If the DataPath is empty, the DataObject is added directly to
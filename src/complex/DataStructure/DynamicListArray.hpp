@@ -1,14 +1,28 @@
 #pragma once
 
+#include <algorithm>
 #include <cstring>
 #include <iostream>
 #include <stdexcept>
 #include <string>
+#include <vector>
+
+#include <nonstd/span.hpp>
 
 #include "complex/DataStructure/DataObject.hpp"
 
 namespace complex
 {
+/**
+ * @class DynamicListArray
+ * @brief Stores a list of K values, such as the elements that use a vertex, for
+ * each point. The lists are held in compressed sparse row (CSR) storage: the
+ * values of list i are m_Elements[m_Offsets[i]] through m_Elements[m_Offsets[i + 1] - 1].
+ * Once allocateLists() has been called, different lists can be filled from
+ * different threads through getElementListPointer().
+ * @tparam T Type reported for the number of values in a list
+ * @tparam K Type of the values
+ */
 template <typename T, typename K>
 class DynamicListArray : public DataObject
 {
@@ -17,10 +31,14 @@ public:
 
   using Self = DynamicListArray<T, K>;
 
+  /**
+   * @brief A view of one list. The pointer is invalidated when the storage is
+   * reallocated.
+   */
   struct ElementList
   {
     T numCells;
-    K* cells;
+    const K* cells;
   };
 
   /**
@@ -78,8 +96,8 @@ public:
    */
   DynamicListArray(const DynamicListArray& other)
   : DataObject(other)
-  , m_Array(other.m_Array)
-  , m_Size(other.m_Size)
+  , m_Offsets(other.m_Offsets)
+  , m_Elements(other.m_Elements)
   {
   }
 
@@ -90,30 +108,12 @@ public:
    */
   DynamicListArray(DynamicListArray&& other)
   : DataObject(std::move(other))
-  , m_Array(std::move(other.m_Array))
-  , m_Size(std::move(other.m_Size))
+  , m_Offsets(std::move(other.m_Offsets))
+  , m_Elements(std::move(other.m_Elements))
   {
   }
 
-  // -----------------------------------------------------------------------------
-  //
-  // -----------------------------------------------------------------------------
-  ~DynamicListArray() override
-  {
-    // This makes sure we deallocate any lists that have been created
-    for(usize i = 0; i < this->m_Size; i++)
-    {
-      if(this->m_Array[i].cells != nullptr)
-      {
-        delete[] this->m_Array[i].cells;
-      }
-    }
-    // Now delete all the "ElementList" structures
-    if(this->m_Array != nullptr)
-    {
-      delete[] this->m_Array;
-    }
-  }
+  ~DynamicListArray() override = default;
 
   DataObject::Type getDataObjectType() const override
   {
@@ -135,7 +135,7 @@ public:
    */
   usize size() const
   {
-    return m_Size;
+    return m_Offsets.size() - 1;
   }
 
   /**
@@ -145,23 +145,7 @@ public:
    */
   DataObject* deepCopy() override
   {
-    DynamicListArray* copy = new DynamicListArray(*this);
-    std::vector<T> linkCounts(m_Size, 0);
-
-    // Figure out how many entries, and for each entry, how many cells
-    for(usize pointId = 0; pointId < m_Size; pointId++)
-    {
-      linkCounts[pointId] = this->m_Array[pointId].numCells;
-    }
-    // Allocate all that in the copy
-    copy->allocateLists(linkCounts);
-    // Copy the data from the original to the new
-    for(usize ptId = 0; ptId < m_Size; ptId++)
-    {
-      ElementList& elementList = getElementList(ptId);
-      copy->setElementList(ptId, elementList);
-    }
-    return copy;
+    return new DynamicListArray(*this);
   }
 
   /**
@@ -181,42 +165,51 @@ public:
    */
   inline void insertCellReference(usize pointId, usize pos, usize cellId)
   {
-    this->m_Array[pointId].cells[pos] = cellId;
+    m_Elements[m_Offsets[pointId] + pos] = cellId;
   }
 
   /**
-   * @brief Get a link structure given a point id.
+   * @brief Get a view of the list of the given point id.
    * @param pointId
-   * @return ElementList&
+   * @return ElementList
    */
-  ElementList& getElementList(usize pointId) const
+  ElementList getElementList(usize pointId) const
   {
-    return this->m_Array[pointId];
+    return {getNumberOfElements(pointId), getElementListPointer(pointId)};
   }
 
   /**
-   * @brief setElementList
+   * @brief Replaces the list of the given point id with a copy of the data. Lists
+   * whose size changes move all of the following lists.
    * @param pointId
    * @param numCells
    * @param data
    * @return bool
    */
-  bool setElementList(usize pointId, T numCells, K* data)
+  bool setElementList(usize pointId, T numCells, const K* data)
   {
-    if(pointId >= m_Size)
+    if(pointId >= size())
     {
       return false;
     }
-    if(m_Array[pointId].cells != nullptr && m_Array[pointId].numCells > 0)
+    const usize oldSize = m_Offsets[pointId + 1] - m_Offsets[pointId];
+    const usize newSize = static_cast<usize>(numCells);
+    if(newSize > oldSize)
+    {
+      m_Elements.insert(m_Elements.begin() + m_Offsets[pointId + 1], newSize - oldSize, K{});
+    }
+    else if(newSize < oldSize)
+    {
+      m_Elements.erase(m_Elements.begin() + m_Offsets[pointId] + newSize, m_Elements.begin() + m_Offsets[pointId + 1]);
+    }
+    if(newSize != oldSize)
     {
-      delete[] this->m_Array[pointId].cells;
-      m_Array[pointId].cells = nullptr;
-      m_Array[pointId].numCells = 0;
+      for(usize i = pointId + 1; i < m_Offsets.size(); i++)
+      {
+        m_Offsets[i] = m_Offsets[i] + newSize - oldSize;
+      }
     }
-    m_Array[pointId].numCells = numCells;
-    // If numCells is huge then there could be problems with this
-    this->m_Array[pointId].cells = new K[numCells];
-    std::memcpy(m_Array[pointId].cells, data, sizeof(K) * numCells);
+    std::copy(data, data + newSize, m_Elements.begin() + m_Offsets[pointId]);
     return true;
   }
 
@@ -226,25 +219,9 @@ public:
    * @param list
    * @return bool
    */
-  bool setElementList(usize pointId, ElementList& list)
+  bool setElementList(usize pointId, const ElementList& list)
   {
-    T nCells = list.numCells;
-    K* data = list.cells;
-    if(pointId >= m_Size)
-    {
-      return false;
-    }
-    if(m_Array[pointId].cells != nullptr && m_Array[pointId].numCells > 0)
-    {
-      delete[] this->m_Array[pointId].cells;
-      m_Array[pointId].cells = nullptr;
-      m_Array[pointId].numCells = 0;
-    }
-    m_Array[pointId].numCells = nCells;
-    // If numCells is huge then there could be problems with this
-    this->m_Array[pointId].cells = new K[nCells];
-    std::memcpy(m_Array[pointId].cells, data, sizeof(K) * nCells);
-    return true;
+    return setElementList(pointId, list.numCells, list.cells);
   }
 
   /**
@@ -254,7 +231,7 @@ public:
    */
   T getNumberOfElements(usize pointId) const
   {
-    return this->m_Array[pointId].numCells;
+    return static_cast<T>(m_Offsets[pointId + 1] - m_Offsets[pointId]);
   }
 
   /**
@@ -262,52 +239,73 @@ public:
    * @param pointId
    * @return K*
    */
-  K* getElementListPointer(usize pointId) const
+  K* getElementListPointer(usize pointId)
   {
-    return this->m_Array[pointId].cells;
+    return m_Elements.data() + m_Offsets[pointId];
   }
 
   /**
-   * @brief deserializeLinks
+   * @brief Return a list of cell ids using the point.
+   * @param pointId
+   * @return const K*
+   */
+  const K* getElementListPointer(usize pointId) const
+  {
+    return m_Elements.data() + m_Offsets[pointId];
+  }
+
+  /**
+   * @brief Returns the cell ids using the point.
+   * @param pointId
+   * @return nonstd::span<const K>
+   */
+  nonstd::span<const K> getElementListSpan(usize pointId) const
+  {
+    return {m_Elements.data() + m_Offsets[pointId], m_Offsets[pointId + 1] - m_Offsets[pointId]};
+  }
+
+  /**
+   * @brief Reads the lists from a buffer that holds the size of each list
+   * followed by its values.
    * @param buffer
    * @param numElements
    */
   void deserializeLinks(std::vector<uint8>& buffer, usize numElements)
   {
+    const uint8* bufPtr = buffer.data();
+    std::vector<T> linkCounts(numElements, 0);
     usize offset = 0;
-    allocate(numElements); // Allocate all the links with 0 and nullptr;
-    uint8* bufPtr = &(buffer.front());
+    for(usize i = 0; i < numElements; ++i)
+    {
+      std::memcpy(&linkCounts[i], bufPtr + offset, sizeof(T));
+      offset += sizeof(T) + static_cast<usize>(linkCounts[i]) * sizeof(K);
+    }
+    allocateLists(linkCounts);
 
-    // Walk the array and allocate all the array links to Zero and nullptr
-    T* numCells = nullptr;
-    // int32* cells = nullptr;
+    offset = 0;
     for(usize i = 0; i < numElements; ++i)
     {
-      numCells = reinterpret_cast<T*>(bufPtr + offset);
-      this->m_Array[i].numCells = *numCells; // Set the number of cells in this link
-      offset += 2;
-      this->m_Array[i].cells = new K[(*numCells)];                                   // Allocate a new chunk of memory to store the list
-      std::memcpy(this->m_Array[i].cells, bufPtr + offset, (*numCells) * sizeof(K)); // Copy from the buffer into the new list memory
-      offset += (*numCells) * sizeof(K);                                             // Increment the offset
+      offset += sizeof(T);
+      const usize numBytes = static_cast<usize>(linkCounts[i]) * sizeof(K);
+      std::memcpy(getElementListPointer(i), bufPtr + offset, numBytes); // Copy from the buffer into the list
+      offset += numBytes;
     }
   }
 
   /**
-   * @brief
+   * @brief Allocates one list per entry of linkCounts with that many values. The
+   * values of every list are set to 0.
    * @param linkCounts
    */
   template <typename Container>
   void allocateLists(const Container& linkCounts)
   {
     allocate(linkCounts.size());
-    for(typename std::vector<T>::size_type i = 0; i < linkCounts.size(); i++)
+    for(usize i = 0; i < linkCounts.size(); i++)
     {
-      this->m_Array[i].numCells = linkCounts[i];
-      if(linkCounts[i] > 0)
-      {
-        this->m_Array[i].cells = new K[this->m_Array[i].numCells];
-      }
+      m_Offsets[i + 1] = m_Offsets[i] + static_cast<usize>(linkCounts[i]);
     }
+    m_Elements.assign(m_Offsets.back(), K{});
   }
 
 protected:
@@ -332,36 +330,14 @@ protected:
   {
   }
 
-  //----------------------------------------------------------------------------
-  // This will allocate memory to hold all the NeighborList structures where each
-  // structure is initialized to Zero Entries and a nullptr Pointer
+  /**
+   * @brief Resizes the array to the given number of empty lists.
+   * @param size
+   */
   void allocate(usize size)
   {
-    static typename DynamicListArray<T, K>::ElementList linkInit = {0, nullptr};
-
-    // This makes sure we deallocate any lists that have been created
-    for(usize i = 0; i < this->m_Size; i++)
-    {
-      if(this->m_Array[i].cells != nullptr)
-      {
-        delete[] this->m_Array[i].cells;
-      }
-    }
-    // Now delete all the "ElementList" structures
-    if(this->m_Array != nullptr)
-    {
-      delete[] this->m_Array;
-    }
-
-    this->m_Size = size;
-    // Allocate a whole new set of structures
-    this->m_Array = new typename DynamicListArray<T, K>::ElementList[size];
-
-    // Initialize each structure to have 0 entries and nullptr pointer.
-    for(usize i = 0; i < size; i++)
-    {
-      this->m_Array[i] = linkInit;
-    }
+    m_Offsets.assign(size + 1, 0);
+    m_Elements.clear();
   }
 
   /**
@@ -376,8 +352,8 @@ protected:
   }
 
 private:
-  ElementList* m_Array = nullptr; // pointer to data
-  usize m_Size = 0;
+  std::vector<usize> m_Offsets = {0};
+  std::vector<K> m_Elements;
 };
 
 using Int32Int32DynamicListArray = DynamicListArray<int32, int32>;
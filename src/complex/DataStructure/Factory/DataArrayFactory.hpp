@@ -4,11 +4,16 @@
 #include "complex/DataStructure/DataArray.hpp"
 #include "complex/DataStructure/DataStore.hpp"
 #include "complex/DataStructure/DataStructure.hpp"
+#include "complex/DataStructure/LazyDataStore.hpp"
+#include "complex/Utilities/DataArrayUtilities.hpp"
 #include "complex/Utilities/Parsing/HDF5/H5.hpp"
 #include "complex/Utilities/Parsing/HDF5/H5DataStructureReader.hpp"
+#include "complex/Utilities/Parsing/HDF5/H5FileReader.hpp"
 #include "complex/Utilities/Parsing/HDF5/H5GroupReader.hpp"
 #include "complex/Utilities/Parsing/HDF5/H5IDataFactory.hpp"
+#include "complex/Utilities/Parsing/HDF5/H5Support.hpp"
 
+#include <filesystem>
 #include <memory>
 #include <numeric>
 #include <optional>
@@ -39,7 +44,7 @@ public:
 
   /**
    * @brief Creates and imports a DataArray based on the provided DatasetReader
-   * @param dataStructure
+   * @param dataStructureReader
    * @param datasetReader
    * @param dataArrayName
    * @param importId
@@ -48,15 +53,110 @@ public:
    * @param preflight
    */
   template <typename K>
-  void importDataArray(DataStructure& dataStructure, const H5::DatasetReader& datasetReader, const std::string dataArrayName, DataObject::IdType importId, H5::ErrorType& err,
+  void importDataArray(H5::DataStructureReader& dataStructureReader, const H5::DatasetReader& datasetReader, const std::string dataArrayName, DataObject::IdType importId, H5::ErrorType& err,
                        const std::optional<DataObject::IdType>& parentId, bool preflight)
   {
-    std::unique_ptr<AbstractDataStore<K>> dataStore =
-        preflight ? std::unique_ptr<AbstractDataStore<K>>(EmptyDataStore<K>::ReadHdf5(datasetReader)) : std::unique_ptr<AbstractDataStore<K>>(DataStore<K>::ReadHdf5(datasetReader));
-    DataArray<K>* data = DataArray<K>::Import(dataStructure, dataArrayName, importId, std::move(dataStore), parentId);
+    const auto& hyperslab = dataStructureReader.getTupleHyperslab();
+    const bool useHyperslab = hyperslab.has_value() && IDataStore::ReadTupleShape(datasetReader) == hyperslab->sourceTupleShape;
+
+    std::unique_ptr<AbstractDataStore<K>> dataStore;
+    if(!preflight && dataStructureReader.isLazyImport())
+    {
+      std::optional<H5::DataStructureReader::TupleHyperslab> lazyHyperslab;
+      if(useHyperslab)
+      {
+        lazyHyperslab = hyperslab;
+      }
+      dataStore = createLazyDataStore<K>(datasetReader, dataStructureReader.getLazyFileReader(), lazyHyperslab);
+    }
+    else if(useHyperslab)
+    {
+      dataStore = readTupleHyperslab<K>(datasetReader, *hyperslab, preflight);
+      if(dataStore == nullptr)
+      {
+        err = -401;
+        return;
+      }
+    }
+    else if(preflight)
+    {
+      dataStore = EmptyDataStore<K>::ReadHdf5(datasetReader);
+    }
+    else if(UseMemoryMappedStore(datasetReader.getNumElements() * sizeof(K)))
+    {
+      dataStore = MemoryMappedDataStore<K>::ReadHdf5(datasetReader, GetMemoryMappedDirectory());
+    }
+    else
+    {
+      dataStore = DataStore<K>::ReadHdf5(datasetReader);
+    }
+    DataArray<K>* data = DataArray<K>::Import(dataStructureReader.getDataStructure(), dataArrayName, importId, std::move(dataStore), parentId);
     err = (data == nullptr) ? -400 : 0;
   }
 
+  /**
+   * @brief Creates a LazyDataStore that reads the provided dataset from the
+   * open file the first time its values are accessed. If a hyperslab is
+   * provided, only the selected tuples are read.
+   * @param datasetReader
+   * @param fileReader
+   * @param hyperslab
+   * @return std::unique_ptr<AbstractDataStore<K>>
+   */
+  template <typename K>
+  std::unique_ptr<AbstractDataStore<K>> createLazyDataStore(const H5::DatasetReader& datasetReader, std::shared_ptr<H5::FileReader> fileReader,
+                                                            const std::optional<H5::DataStructureReader::TupleHyperslab>& hyperslab) const
+  {
+    auto tupleShape = hyperslab.has_value() ? hyperslab->count : IDataStore::ReadTupleShape(datasetReader);
+    auto componentShape = IDataStore::ReadComponentShape(datasetReader);
+    std::vector<usize> start;
+    std::vector<usize> count;
+    if(hyperslab.has_value())
+    {
+      start = hyperslab->start;
+      count = hyperslab->count;
+    }
+
+    usize numValues = std::accumulate(tupleShape.cbegin(), tupleShape.cend(), static_cast<usize>(1), std::multiplies<>()) *
+                      std::accumulate(componentShape.cbegin(), componentShape.cend(), static_cast<usize>(1), std::multiplies<>());
+    std::optional<std::filesystem::path> memoryMappedDirectory;
+    if(UseMemoryMappedStore(numValues * sizeof(K)))
+    {
+      memoryMappedDirectory = GetMemoryMappedDirectory();
+    }
+
+    std::string datasetPath = H5::Support::GetObjectPath(datasetReader.getId());
+    return std::make_unique<LazyDataStore<K>>(tupleShape, componentShape, std::move(fileReader), datasetPath, start, count, memoryMappedDirectory);
+  }
+
+  /**
+   * @brief Creates a DataStore holding only the selected tuples of the
+   * provided dataset. The components of each selected tuple are read in full.
+   * Returns nullptr if the hyperslab could not be read.
+   * @param datasetReader
+   * @param hyperslab
+   * @param preflight
+   * @return std::unique_ptr<AbstractDataStore<K>>
+   */
+  template <typename K>
+  std::unique_ptr<AbstractDataStore<K>> readTupleHyperslab(const H5::DatasetReader& datasetReader, const H5::DataStructureReader::TupleHyperslab& hyperslab, bool preflight) const
+  {
+    auto componentShape = IDataStore::ReadComponentShape(datasetReader);
+    auto dataStore = CreateDataStore<K>(hyperslab.count, componentShape, preflight ? IDataAction::Mode::Preflight : IDataAction::Mode::Execute);
+    if(preflight)
+    {
+      return dataStore;
+    }
+
+    std::vector<hsize_t> start(hyperslab.start.cbegin(), hyperslab.start.cend());
+    std::vector<hsize_t> count(hyperslab.count.cbegin(), hyperslab.count.cend());
+    if(!datasetReader.readIntoSpan<K>(dataStore->createSpan(), start, count))
+    {
+      return nullptr;
+    }
+    return dataStore;
+  }
+
   /**
    * @brief Creates and adds an HexahedralGeom to the provided DataStructure from
    * the target HDF5 ID.
@@ -107,41 +207,41 @@ public:
     switch(type)
     {
     case H5::Type::float32:
-      importDataArray<float32>(dataStructureReader.getDataStructure(), datasetReader, dataArrayName, importId, err, parentId, preflight);
+      importDataArray<float32>(dataStructureReader, datasetReader, dataArrayName, importId, err, parentId, preflight);
       break;
     case H5::Type::float64:
-      importDataArray<float64>(dataStructureReader.getDataStructure(), datasetReader, dataArrayName, importId, err, parentId, preflight);
+      importDataArray<float64>(dataStructureReader, datasetReader, dataArrayName, importId, err, parentId, preflight);
       break;
     case H5::Type::int8:
-      importDataArray<int8>(dataStructureReader.getDataStructure(), datasetReader, dataArrayName, importId, err, parentId, preflight);
+      importDataArray<int8>(dataStructureReader, datasetReader, dataArrayName, importId, err, parentId, preflight);
       break;
     case H5::Type::int16:
-      importDataArray<int16>(dataStructureReader.getDataStructure(), datasetReader, dataArrayName, importId, err, parentId, preflight);
+      importDataArray<int16>(dataStructureReader, datasetReader, dataArrayName, importId, err, parentId, preflight);
       break;
     case H5::Type::int32:
-      importDataArray<int32>(dataStructureReader.getDataStructure(), datasetReader, dataArrayName, importId, err, parentId, preflight);
+      importDataArray<int32>(dataStructureReader, datasetReader, dataArrayName, importId, err, parentId, preflight);
       break;
     case H5::Type::int64:
-      importDataArray<int64>(dataStructureReader.getDataStructure(), datasetReader, dataArrayName, importId, err, parentId, preflight);
+      importDataArray<int64>(dataStructureReader, datasetReader, dataArrayName, importId, err, parentId, preflight);
       break;
     case H5::Type::uint8:
       if(isBoolArray)
       {
-        importDataArray<bool>(dataStructureReader.getDataStructure(), datasetReader, dataArrayName, importId, err, parentId, preflight);
+        importDataArray<bool>(dataStructureReader, datasetReader, dataArrayName, importId, err, parentId, preflight);
       }
       else
       {
-        importDataArray<uint8>(dataStructureReader.getDataStructure(), datasetReader, dataArrayName, importId, err, parentId, preflight);
+        importDataArray<uint8>(dataStructureReader, datasetReader, dataArrayName, importId, err, parentId, preflight);
       }
       break;
     case H5::Type::uint16:
-      importDataArray<uint16>(dataStructureReader.getDataStructure(), datasetReader, dataArrayName, importId, err, parentId, preflight);
+      importDataArray<uint16>(dataStructureReader, datasetReader, dataArrayName, importId, err, parentId, preflight);
       break;
     case H5::Type::uint32:
-      importDataArray<uint32>(dataStructureReader.getDataStructure(), datasetReader, dataArrayName, importId, err, parentId, preflight);
+      importDataArray<uint32>(dataStructureReader, datasetReader, dataArrayName, importId, err, parentId, preflight);
       break;
     case H5::Type::uint64:
-      importDataArray<uint64>(dataStructureReader.getDataStructure(), datasetReader, dataArrayName, importId, err, parentId, preflight);
+      importDataArray<uint64>(dataStructureReader, datasetReader, dataArrayName, importId, err, parentId, preflight);
       break;
     default:
       err = -777;
@@ -36,8 +36,8 @@ inline void importNeighborList(DataStructure& dataStructure, const H5::GroupRead
                                const std::optional<DataObject::IdType>& parentId, bool preflight)
 {
   using NeighborListType = NeighborList<T>;
-  auto dataVector = NeighborListType::ReadHdf5Data(parentReader, datasetReader);
-  NeighborListType::Import(dataStructure, dataArrayName, importId, dataVector, parentId);
+  auto flatStorage = NeighborListType::ReadHdf5FlatData(parentReader, datasetReader);
+  NeighborListType::Import(dataStructure, dataArrayName, importId, std::move(flatStorage), parentId);
 }
 
 H5::ErrorType NeighborListFactory::readH5Dataset(H5::DataStructureReader& dataStructureReader, const H5::GroupReader& parentReader, const H5::DatasetReader& datasetReader,
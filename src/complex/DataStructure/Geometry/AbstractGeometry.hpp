@@ -141,7 +141,7 @@ public:
   using SharedQuadList = MeshIndexArrayType;
   using SharedTetList = MeshIndexArrayType;
   using SharedHexList = MeshIndexArrayType;
-  using ElementDynamicList = DynamicListArray<uint16, MeshIndexType>;
+  using ElementDynamicList = DynamicListArray<MeshIndexType, MeshIndexType>;
 
   /**
    * @brief
@@ -300,7 +300,11 @@ public:
   virtual void getShapeFunctions(const complex::Point3D<float64>& pCoords, double* shape) const = 0;
 
   /**
-   * @brief
+   * @brief Computes the spatial gradient of the field. Grid geometries take a cell
+   * field and use finite differences; mesh geometries take a vertex field and
+   * return one gradient per element. The derivatives array must hold one tuple per
+   * element with three components (d/dx, d/dy, d/dz) per field component.
+   * Throws a std::runtime_error if the arrays do not match the geometry.
    * @param field
    * @param derivatives
    * @param observable
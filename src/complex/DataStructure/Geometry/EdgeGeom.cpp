@@ -345,8 +345,8 @@ void EdgeGeom::deleteElementSizes()
 
 AbstractGeometry::StatusCode EdgeGeom::findElementsContainingVert()
 {
-  auto containsVert = DynamicListArray<uint16, MeshIndexType>::Create(*getDataStructure(), "Edges Containing Vert", getId());
-  GeometryHelpers::Connectivity::FindElementsContainingVert<uint16, MeshIndexType>(getEdges(), containsVert, getNumberOfVertices());
+  auto containsVert = ElementDynamicList::Create(*getDataStructure(), "Edges Containing Vert", getId());
+  GeometryHelpers::Connectivity::FindElementsContainingVert<MeshIndexType, MeshIndexType>(getEdges(), containsVert, getNumberOfVertices());
   if(getElementsContainingVert() == nullptr)
   {
     return -1;
@@ -380,14 +380,14 @@ AbstractGeometry::StatusCode EdgeGeom::findElementNeighbors()
       return err;
     }
   }
-  auto edgeNeighbors = DynamicListArray<uint16, MeshIndexType>::Create(*getDataStructure(), "Edge Neighbors", getId());
+  auto edgeNeighbors = ElementDynamicList::Create(*getDataStructure(), "Edge Neighbors", getId());
   if(edgeNeighbors == nullptr)
   {
     err = -1;
     return err;
   }
   m_EdgeNeighborsId = edgeNeighbors->getId();
-  err = GeometryHelpers::Connectivity::FindElementNeighbors<uint16, MeshIndexType>(getEdges(), getElementsContainingVert(), edgeNeighbors, AbstractGeometry::Type::Edge);
+  err = GeometryHelpers::Connectivity::FindElementNeighbors<MeshIndexType, MeshIndexType>(getEdges(), getElementsContainingVert(), edgeNeighbors, AbstractGeometry::Type::Edge);
   if(getElementNeighbors() == nullptr)
   {
     m_EdgeNeighborsId.reset();
@@ -457,7 +457,9 @@ void EdgeGeom::getShapeFunctions(const complex::Point3D<float64>& pCoords, doubl
 
 void EdgeGeom::findDerivatives(Float64Array* field, Float64Array* derivatives, Observable* observable) const
 {
-  throw std::runtime_error("");
+  std::vector<float64> shapeDerivatives(2);
+  getShapeFunctions(getParametricCenter(), shapeDerivatives.data());
+  GeometryHelpers::Topology::FindElementDerivatives<1>(getEdges(), getVertices(), shapeDerivatives, field, derivatives);
 }
 
 complex::TooltipGenerator EdgeGeom::getTooltipGenerator() const
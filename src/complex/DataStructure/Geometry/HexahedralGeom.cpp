@@ -241,9 +241,9 @@ void HexahedralGeom::deleteElementSizes()
 
 AbstractGeometry::StatusCode HexahedralGeom::findElementsContainingVert()
 {
-  auto* hexasControllingVert = DynamicListArray<uint16_t, MeshIndexType>::Create(*getDataStructure(), "Hex Containing Vertices", getId());
+  auto* hexasControllingVert = ElementDynamicList::Create(*getDataStructure(), "Hex Containing Vertices", getId());
   m_HexasContainingVertId = hexasControllingVert->getId();
-  GeometryHelpers::Connectivity::FindElementsContainingVert<uint16, MeshIndexType>(getHexahedrals(), hexasControllingVert, getNumberOfVertices());
+  GeometryHelpers::Connectivity::FindElementsContainingVert<MeshIndexType, MeshIndexType>(getHexahedrals(), hexasControllingVert, getNumberOfVertices());
   if(getElementsContainingVert() == nullptr)
   {
     m_HexasContainingVertId.reset();
@@ -274,9 +274,9 @@ AbstractGeometry::StatusCode HexahedralGeom::findElementNeighbors()
       return err;
     }
   }
-  auto* hexNeighbors = DynamicListArray<uint16_t, MeshIndexType>::Create(*getDataStructure(), "Hex Neighbors", getId());
+  auto* hexNeighbors = ElementDynamicList::Create(*getDataStructure(), "Hex Neighbors", getId());
   m_HexNeighborsId = hexNeighbors->getId();
-  err = GeometryHelpers::Connectivity::FindElementNeighbors<uint16, MeshIndexType>(getHexahedrals(), getElementsContainingVert(), hexNeighbors, AbstractGeometry::Type::Hexahedral);
+  err = GeometryHelpers::Connectivity::FindElementNeighbors<MeshIndexType, MeshIndexType>(getHexahedrals(), getElementsContainingVert(), hexNeighbors, AbstractGeometry::Type::Hexahedral);
   if(getElementNeighbors() == nullptr)
   {
     m_HexNeighborsId.reset();
@@ -365,7 +365,9 @@ void HexahedralGeom::getShapeFunctions(const complex::Point3D<float64>& pCoords,
 
 void HexahedralGeom::findDerivatives(Float64Array* field, Float64Array* derivatives, Observable* observable) const
 {
-  throw std::runtime_error("");
+  std::vector<float64> shapeDerivatives(24);
+  getShapeFunctions(getParametricCenter(), shapeDerivatives.data());
+  GeometryHelpers::Topology::FindElementDerivatives<3>(getHexahedrals(), getVertices(), shapeDerivatives, field, derivatives);
 }
 
 complex::TooltipGenerator HexahedralGeom::getTooltipGenerator() const
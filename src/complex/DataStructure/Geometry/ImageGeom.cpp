@@ -6,6 +6,7 @@
 #include "complex/DataStructure/DataStructure.hpp"
 #include "complex/Utilities/GeometryHelpers.hpp"
 #include "complex/Utilities/Parsing/HDF5/H5Constants.hpp"
+#include "complex/Utilities/Parsing/HDF5/H5DataStructureReader.hpp"
 #include "complex/Utilities/Parsing/HDF5/H5GroupReader.hpp"
 #include "complex/Utilities/Parsing/HDF5/H5GroupWriter.hpp"
 
@@ -266,7 +267,19 @@ void ImageGeom::getShapeFunctions(const complex::Point3D<float64>& pCoords, doub
 
 void ImageGeom::findDerivatives(Float64Array* field, Float64Array* derivatives, Observable* observable) const
 {
-  throw std::runtime_error("");
+  const SizeVec3 dims = getDimensions();
+  const FloatVec3 spacing = getSpacing();
+  const FloatVec3 origin = getOrigin();
+  std::array<std::vector<float64>, 3> cellCenters;
+  for(usize axis = 0; axis < 3; axis++)
+  {
+    cellCenters[axis].resize(dims[axis]);
+    for(usize i = 0; i < dims[axis]; i++)
+    {
+      cellCenters[axis][i] = origin[axis] + (static_cast<float64>(i) + 0.5) * spacing[axis];
+    }
+  }
+  GeometryHelpers::Topology::FindGridDerivatives(dims, cellCenters, field, derivatives);
 }
 
 usize ImageGeom::getDimensionality() const
@@ -563,14 +576,43 @@ H5::ErrorType ImageGeom::readHdf5(H5::DataStructureReader& dataStructureReader,
   std::vector<float> spacing = spacingAttribute.readAsVector<float>();
   std::vector<float> origin = originAttribute.readAsVector<float>();
 
-  setDimensions(volDims);
+  // Read DataObject ID
+  m_VoxelSizesId = ReadH5DataId(groupReader, H5Constants::k_VoxelSizesTag);
+
+  const auto& subvolume = dataStructureReader.getImageSubvolume();
+  if(!subvolume.has_value())
+  {
+    setDimensions(volDims);
+    setSpacing(spacing);
+    setOrigin(origin);
+    return BaseGroup::readHdf5(dataStructureReader, groupReader, preflight);
+  }
+
+  // Crop the geometry and only read the selected voxels of the cell arrays
+  std::vector<usize> subvolumeDims(3);
+  for(usize i = 0; i < 3; i++)
+  {
+    if(subvolume->minVoxel[i] > subvolume->maxVoxel[i] || subvolume->maxVoxel[i] >= volDims[i])
+    {
+      return -3;
+    }
+    subvolumeDims[i] = subvolume->maxVoxel[i] - subvolume->minVoxel[i] + 1;
+    origin[i] += static_cast<float>(subvolume->minVoxel[i]) * spacing[i];
+  }
+  setDimensions(subvolumeDims);
   setSpacing(spacing);
   setOrigin(origin);
 
-  // Read DataObject ID
-  m_VoxelSizesId = ReadH5DataId(groupReader, H5Constants::k_VoxelSizesTag);
+  H5::DataStructureReader::TupleHyperslab hyperslab;
+  hyperslab.sourceTupleShape = {volDims[2], volDims[1], volDims[0]};
+  hyperslab.start = {subvolume->minVoxel[2], subvolume->minVoxel[1], subvolume->minVoxel[0]};
+  hyperslab.count = {subvolumeDims[2], subvolumeDims[1], subvolumeDims[0]};
 
-  return BaseGroup::readHdf5(dataStructureReader, groupReader, preflight);
+  auto previousHyperslab = dataStructureReader.getTupleHyperslab();
+  dataStructureReader.setTupleHyperslab(hyperslab);
+  auto errorCode = BaseGroup::readHdf5(dataStructureReader, groupReader, preflight);
+  dataStructureReader.setTupleHyperslab(previousHyperslab);
+  return errorCode;
 }
 
 H5::ErrorType ImageGeom::writeHdf5(H5::DataStructureWriter& dataStructureWriter, H5::GroupWriter& parentGroupWriter, bool importable) const
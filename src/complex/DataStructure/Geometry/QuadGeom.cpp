@@ -235,8 +235,8 @@ void QuadGeom::deleteElementSizes()
 
 AbstractGeometry::StatusCode QuadGeom::findElementsContainingVert()
 {
-  auto quadsContainingVert = DynamicListArray<uint16, MeshIndexType>::Create(*getDataStructure(), "Quads Containing Vert", getId());
-  GeometryHelpers::Connectivity::FindElementsContainingVert<uint16, MeshIndexType>(getFaces(), quadsContainingVert, getNumberOfVertices());
+  auto quadsContainingVert = ElementDynamicList::Create(*getDataStructure(), "Quads Containing Vert", getId());
+  GeometryHelpers::Connectivity::FindElementsContainingVert<MeshIndexType, MeshIndexType>(getFaces(), quadsContainingVert, getNumberOfVertices());
   if(quadsContainingVert == nullptr)
   {
     m_QuadsContainingVertId.reset();
@@ -268,8 +268,8 @@ AbstractGeometry::StatusCode QuadGeom::findElementNeighbors()
       return err;
     }
   }
-  auto quadNeighbors = DynamicListArray<uint16, MeshIndexType>::Create(*getDataStructure(), "Quad Neighbors", getId());
-  err = GeometryHelpers::Connectivity::FindElementNeighbors<uint16, MeshIndexType>(getFaces(), getElementsContainingVert(), quadNeighbors, AbstractGeometry::Type::Quad);
+  auto quadNeighbors = ElementDynamicList::Create(*getDataStructure(), "Quad Neighbors", getId());
+  err = GeometryHelpers::Connectivity::FindElementNeighbors<MeshIndexType, MeshIndexType>(getFaces(), getElementsContainingVert(), quadNeighbors, AbstractGeometry::Type::Quad);
   if(quadNeighbors == nullptr)
   {
     m_QuadNeighborsId.reset();
@@ -340,7 +340,9 @@ void QuadGeom::getShapeFunctions(const complex::Point3D<float64>& pCoords, doubl
 
 void QuadGeom::findDerivatives(Float64Array* field, Float64Array* derivatives, Observable* observable) const
 {
-  throw std::runtime_error("");
+  std::vector<float64> shapeDerivatives(8);
+  getShapeFunctions(getParametricCenter(), shapeDerivatives.data());
+  GeometryHelpers::Topology::FindElementDerivatives<2>(getFaces(), getVertices(), shapeDerivatives, field, derivatives);
 }
 
 complex::TooltipGenerator QuadGeom::getTooltipGenerator() const
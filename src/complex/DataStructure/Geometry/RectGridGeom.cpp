@@ -310,7 +310,22 @@ void RectGridGeom::getShapeFunctions(const complex::Point3D<float64>& pCoords, d
 
 void RectGridGeom::findDerivatives(Float64Array* field, Float64Array* derivatives, Observable* observable) const
 {
-  throw std::runtime_error("");
+  const SizeVec3 dims = getDimensions();
+  const std::array<const Float32Array*, 3> bounds = {getXBounds(), getYBounds(), getZBounds()};
+  std::array<std::vector<float64>, 3> cellCenters;
+  for(usize axis = 0; axis < 3; axis++)
+  {
+    if(bounds[axis] == nullptr || bounds[axis]->getNumberOfTuples() < dims[axis] + 1)
+    {
+      throw std::runtime_error("RectGridGeom::findDerivatives: The bounds do not match the dimensions of the grid");
+    }
+    cellCenters[axis].resize(dims[axis]);
+    for(usize i = 0; i < dims[axis]; i++)
+    {
+      cellCenters[axis][i] = 0.5 * (static_cast<float64>((*bounds[axis])[i]) + static_cast<float64>((*bounds[axis])[i + 1]));
+    }
+  }
+  GeometryHelpers::Topology::FindGridDerivatives(dims, cellCenters, field, derivatives);
 }
 
 std::string RectGridGeom::getInfoString(complex::InfoStringFormat format) const
@@ -290,8 +290,8 @@ void TetrahedralGeom::deleteElementSizes()
 
 AbstractGeometry::StatusCode TetrahedralGeom::findElementsContainingVert()
 {
-  auto* tetsContainingVert = DynamicListArray<uint16, MeshIndexType>::Create(*getDataStructure(), "Elements Containing Vert", getId());
-  GeometryHelpers::Connectivity::FindElementsContainingVert<uint16, MeshIndexType>(getTetrahedra(), tetsContainingVert, getNumberOfVertices());
+  auto* tetsContainingVert = ElementDynamicList::Create(*getDataStructure(), "Elements Containing Vert", getId());
+  GeometryHelpers::Connectivity::FindElementsContainingVert<MeshIndexType, MeshIndexType>(getTetrahedra(), tetsContainingVert, getNumberOfVertices());
   if(tetsContainingVert == nullptr)
   {
     m_TetsContainingVertId.reset();
@@ -323,8 +323,8 @@ AbstractGeometry::StatusCode TetrahedralGeom::findElementNeighbors()
       return err;
     }
   }
-  auto* tetNeighbors = DynamicListArray<uint16, MeshIndexType>::Create(*getDataStructure(), "Tet Neighbors", getId());
-  err = GeometryHelpers::Connectivity::FindElementNeighbors<uint16, MeshIndexType>(getTetrahedra(), getElementsContainingVert(), tetNeighbors, AbstractGeometry::Type::Tetrahedral);
+  auto* tetNeighbors = ElementDynamicList::Create(*getDataStructure(), "Tet Neighbors", getId());
+  err = GeometryHelpers::Connectivity::FindElementNeighbors<MeshIndexType, MeshIndexType>(getTetrahedra(), getElementsContainingVert(), tetNeighbors, AbstractGeometry::Type::Tetrahedral);
   if(tetNeighbors == nullptr)
   {
     m_TetNeighborsId.reset();
@@ -400,7 +400,9 @@ void TetrahedralGeom::getShapeFunctions(const complex::Point3D<float64>& pCoords
 
 void TetrahedralGeom::findDerivatives(Float64Array* field, Float64Array* derivatives, Observable* observable) const
 {
-  throw std::runtime_error("");
+  std::vector<float64> shapeDerivatives(12);
+  getShapeFunctions(getParametricCenter(), shapeDerivatives.data());
+  GeometryHelpers::Topology::FindElementDerivatives<3>(getTetrahedra(), getVertices(), shapeDerivatives, field, derivatives);
 }
 
 complex::TooltipGenerator TetrahedralGeom::getTooltipGenerator() const
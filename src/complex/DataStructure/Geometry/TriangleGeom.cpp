@@ -236,8 +236,8 @@ void TriangleGeom::deleteElementSizes()
 
 AbstractGeometry::StatusCode TriangleGeom::findElementsContainingVert()
 {
-  auto trianglesContainingVert = DynamicListArray<uint16, MeshIndexType>::Create(*getDataStructure(), "Triangles Containing Vert", getId());
-  GeometryHelpers::Connectivity::FindElementsContainingVert<uint16, MeshIndexType>(getFaces(), trianglesContainingVert, getNumberOfVertices());
+  auto trianglesContainingVert = ElementDynamicList::Create(*getDataStructure(), "Triangles Containing Vert", getId());
+  GeometryHelpers::Connectivity::FindElementsContainingVert<MeshIndexType, MeshIndexType>(getFaces(), trianglesContainingVert, getNumberOfVertices());
   if(trianglesContainingVert == nullptr)
   {
     m_TrianglesContainingVertId.reset();
@@ -269,8 +269,8 @@ AbstractGeometry::StatusCode TriangleGeom::findElementNeighbors()
       return err;
     }
   }
-  auto triangleNeighbors = DynamicListArray<uint16, MeshIndexType>::Create(*getDataStructure(), "Triangle Neighbors", getId());
-  err = GeometryHelpers::Connectivity::FindElementNeighbors<uint16, MeshIndexType>(getFaces(), getElementsContainingVert(), triangleNeighbors, AbstractGeometry::Type::Triangle);
+  auto triangleNeighbors = ElementDynamicList::Create(*getDataStructure(), "Triangle Neighbors", getId());
+  err = GeometryHelpers::Connectivity::FindElementNeighbors<MeshIndexType, MeshIndexType>(getFaces(), getElementsContainingVert(), triangleNeighbors, AbstractGeometry::Type::Triangle);
   if(triangleNeighbors == nullptr)
   {
     m_TriangleNeighborsId.reset();
@@ -338,7 +338,9 @@ void TriangleGeom::getShapeFunctions(const complex::Point3D<float64>& pCoords, d
 
 void TriangleGeom::findDerivatives(Float64Array* field, Float64Array* derivatives, Observable* observable) const
 {
-  throw std::runtime_error("");
+  std::vector<float64> shapeDerivatives(6);
+  getShapeFunctions(getParametricCenter(), shapeDerivatives.data());
+  GeometryHelpers::Topology::FindElementDerivatives<2>(getFaces(), getVertices(), shapeDerivatives, field, derivatives);
 }
 
 complex::TooltipGenerator TriangleGeom::getTooltipGenerator() const
@@ -60,6 +60,15 @@ public:
    */
   virtual const IDataStore* getIDataStore() const = 0;
 
+  /**
+   * @brief Replaces a data store that is shared with other DataArrays by a
+   * copy-on-write copy, so that writes through either array are no longer
+   * visible to the other. Returns false if the data store cannot be copied
+   * without duplicating its values, in which case it remains shared.
+   * @return bool
+   */
+  virtual bool detachDataStore() = 0;
+
   /**
    * @brief Returns a reference to the array's IDataStore.
    * @return IDataStore&
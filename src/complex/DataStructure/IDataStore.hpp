@@ -34,6 +34,8 @@ public:
     Unknown = -1,
     InMemory = 0,
     Empty,
+    MemoryMapped,
+    Lazy,
   };
 
   virtual ~IDataStore() = default;
@@ -100,6 +102,16 @@ public:
    */
   virtual std::unique_ptr<IDataStore> deepCopy() const = 0;
 
+  /**
+   * @brief Returns true if deepCopy() shares the values with the copy until
+   * either store is written to, making copies inexpensive.
+   * @return bool
+   */
+  virtual bool isCopyOnWrite() const
+  {
+    return false;
+  }
+
   /**
    * @brief Returns a data store of the same type as this but with default initialized data.
    * @return std::unique_ptr<IDataStore>
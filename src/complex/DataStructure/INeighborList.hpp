@@ -56,6 +56,12 @@ public:
    */
   virtual DataType getDataType() const = 0;
 
+  /**
+   * @brief Gives this INeighborList its own copy of every list. Shallow copies
+   * share the vectors holding the lists.
+   */
+  virtual void detachLists() = 0;
+
   /**
    * @brief Returns an enumeration of the class or subclass. Used for quick comparison or type deduction
    * @return
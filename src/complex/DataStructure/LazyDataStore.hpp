@@ -0,0 +1,410 @@
+#pragma once
+
+#include "complex/DataStructure/AbstractDataStore.hpp"
+#include "complex/DataStructure/DataStore.hpp"
+#include "complex/DataStructure/MemoryMappedDataStore.hpp"
+#include "complex/Utilities/Parsing/HDF5/H5.hpp"
+#include "complex/Utilities/Parsing/HDF5/H5DatasetReader.hpp"
+#include "complex/Utilities/Parsing/HDF5/H5FileReader.hpp"
+
+#include <fmt/core.h>
+
+#include <atomic>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace complex
+{
+/**
+ * @class LazyDataStore
+ * @brief The LazyDataStore class is created when importing a .dream3d file in
+ * lazy mode. It only holds the array metadata and a reference to the still
+ * open HDF5 file until the values are first accessed. At that point the
+ * dataset is read into an in-memory DataStore, or a MemoryMappedDataStore if a
+ * scratch directory was provided, and every call is forwarded to that store.
+ *
+ * Arrays that are never touched by a pipeline are never read from disk.
+ * Loading is thread safe so that parallel algorithms can access the store.
+ *
+ * The source file stays open until every store that reads from it has been
+ * destroyed, so a DataStructure holding unloaded stores cannot be written back
+ * to the file it was imported from. H5::FileWriter::CreateFile() reports an
+ * error in that case.
+ * @tparam T
+ */
+template <typename T>
+class LazyDataStore : public AbstractDataStore<T>
+{
+public:
+  using value_type = typename AbstractDataStore<T>::value_type;
+  using reference = typename AbstractDataStore<T>::reference;
+  using const_reference = typename AbstractDataStore<T>::const_reference;
+  using ShapeType = typename IDataStore::ShapeType;
+
+  /**
+   * @brief Constructs a LazyDataStore that will read the dataset at the
+   * specified path of the provided file when its values are first accessed.
+   *
+   * If hyperslabStart and hyperslabCount are provided, only the selected tuples
+   * are read. The tuple shape must match hyperslabCount in that case.
+   * @param tupleShape The dimensions of the tuples
+   * @param componentShape The dimensions of the component at each tuple
+   * @param fileReader The open HDF5 file the dataset is read from
+   * @param datasetPath The path of the dataset from the file root
+   * @param hyperslabStart Optional first tuple index along each tuple dimension
+   * @param hyperslabCount Optional number of tuples along each tuple dimension
+   * @param memoryMappedDirectory Optional scratch directory used to back the loaded values
+   */
+  LazyDataStore(const ShapeType& tupleShape, const ShapeType& componentShape, std::shared_ptr<H5::FileReader> fileReader, const std::string& datasetPath,
+                const std::vector<usize>& hyperslabStart = {}, const std::vector<usize>& hyperslabCount = {}, const std::optional<std::filesystem::path>& memoryMappedDirectory = std::nullopt)
+  : m_ComponentShape(componentShape)
+  , m_TupleShape(tupleShape)
+  , m_NumComponents(std::accumulate(m_ComponentShape.cbegin(), m_ComponentShape.cend(), static_cast<size_t>(1), std::multiplies<>()))
+  , m_NumTuples(std::accumulate(m_TupleShape.cbegin(), m_TupleShape.cend(), static_cast<size_t>(1), std::multiplies<>()))
+  , m_FileReader(std::move(fileReader))
+  , m_DatasetPath(datasetPath)
+  , m_HyperslabStart(hyperslabStart)
+  , m_HyperslabCount(hyperslabCount)
+  , m_MemoryMappedDirectory(memoryMappedDirectory)
+  , m_LoadFlag(std::make_unique<std::once_flag>())
+  {
+  }
+
+  /**
+   * @brief Copy constructor. Unloaded stores share the source file so the copy
+   * is also loaded on demand. Loaded stores copy their values.
+   * @param other
+   */
+  LazyDataStore(const LazyDataStore& other)
+  : m_ComponentShape(other.m_ComponentShape)
+  , m_TupleShape(other.m_TupleShape)
+  , m_NumComponents(other.m_NumComponents)
+  , m_NumTuples(other.m_NumTuples)
+  , m_FileReader(other.m_FileReader)
+  , m_DatasetPath(other.m_DatasetPath)
+  , m_HyperslabStart(other.m_HyperslabStart)
+  , m_HyperslabCount(other.m_HyperslabCount)
+  , m_MemoryMappedDirectory(other.m_MemoryMappedDirectory)
+  , m_LoadFlag(std::make_unique<std::once_flag>())
+  {
+    if(other.isLoaded())
+    {
+      std::call_once(*m_LoadFlag, [this, &other]() {
+        m_DataStore.reset(dynamic_cast<AbstractDataStore<T>*>(other.m_DataStore->deepCopy().release()));
+        m_Loaded.store(true, std::memory_order_release);
+      });
+    }
+  }
+
+  LazyDataStore(LazyDataStore&& other) = delete;
+  LazyDataStore& operator=(const LazyDataStore& rhs) = delete;
+  LazyDataStore& operator=(LazyDataStore&& rhs) = delete;
+
+  ~LazyDataStore() override = default;
+
+  /**
+   * @brief Returns the number of tuples in the DataStore.
+   * @return usize
+   */
+  usize getNumberOfTuples() const override
+  {
+    return m_NumTuples;
+  }
+
+  /**
+   * @brief Returns the number of elements in each Tuple.
+   * @return usize
+   */
+  usize getNumberOfComponents() const override
+  {
+    return m_NumComponents;
+  }
+
+  /**
+   * @brief Returns the dimensions of the Tuples
+   * @return
+   */
+  const ShapeType& getTupleShape() const override
+  {
+    return m_TupleShape;
+  }
+
+  /**
+   * @brief Returns the dimensions of the Components
+   * @return
+   */
+  const ShapeType& getComponentShape() const override
+  {
+    return m_ComponentShape;
+  }
+
+  /**
+   * @brief Returns the store type e.g. in memory, out of core, etc.
+   * @return StoreType
+   */
+  IDataStore::StoreType getStoreType() const override
+  {
+    return IDataStore::StoreType::Lazy;
+  }
+
+  /**
+   * @brief Returns true if the values have been read from the file.
+   * @return bool
+   */
+  bool isLoaded() const
+  {
+    return m_Loaded.load(std::memory_order_acquire);
+  }
+
+  /**
+   * @brief Returns the path of the source dataset from the file root.
+   * @return const std::string&
+   */
+  const std::string& getDatasetPath() const
+  {
+    return m_DatasetPath;
+  }
+
+  /**
+   * @brief Reads the values from the file if they have not been read yet.
+   * Throws a runtime_error if the dataset cannot be read.
+   */
+  void load() const
+  {
+    std::call_once(*m_LoadFlag, [this]() {
+      m_DataStore = readStore();
+      m_Loaded.store(true, std::memory_order_release);
+    });
+  }
+
+  /**
+   * @brief Resizes the store to the new tuple shape. The values are loaded
+   * first so that existing values are preserved.
+   * @param tupleShape
+   */
+  void reshapeTuples(const ShapeType& tupleShape) override
+  {
+    load();
+    m_DataStore->reshapeTuples(tupleShape);
+    m_TupleShape = tupleShape;
+    m_NumTuples = m_DataStore->getNumberOfTuples();
+  }
+
+  /**
+   * @brief Returns the value found at the specified index of the DataStore.
+   * This cannot be used to edit the value found at the specified index.
+   * @param index
+   * @return value_type
+   */
+  value_type getValue(usize index) const override
+  {
+    load();
+    return m_DataStore->getValue(index);
+  }
+
+  /**
+   * @brief Sets the value stored at the specified index.
+   * @param index
+   * @param value
+   */
+  void setValue(usize index, value_type value) override
+  {
+    load();
+    m_DataStore->setValue(index, value);
+  }
+
+  /**
+   * @brief Returns the value found at the specified index of the DataStore.
+   * This cannot be used to edit the value found at the specified index.
+   * @param  index
+   * @return const_reference
+   */
+  const_reference operator[](usize index) const override
+  {
+    load();
+    return std::as_const(*m_DataStore)[index];
+  }
+
+  /**
+   * @brief Returns the value found at the specified index of the DataStore.
+   * This can be used to edit the value found at the specified index.
+   * @param  index
+   * @return reference
+   */
+  reference operator[](usize index) override
+  {
+    load();
+    return (*m_DataStore)[index];
+  }
+
+  /**
+   * @brief Returns the value found at the specified index of the DataStore.
+   * This cannot be used to edit the value found at the specified index.
+   * @param index
+   * @return const_reference
+   */
+  const_reference at(usize index) const override
+  {
+    load();
+    return m_DataStore->at(index);
+  }
+
+  /**
+   * @brief Fills the store with the specified value. The file is not read
+   * since every value is overwritten.
+   * @param value
+   */
+  void fill(value_type value) override
+  {
+    std::call_once(*m_LoadFlag, [this]() {
+      m_DataStore = allocateStore();
+      m_Loaded.store(true, std::memory_order_release);
+    });
+    m_DataStore->fill(value);
+  }
+
+  /**
+   * @brief Returns a deep copy of the data store. If the values have not been
+   * loaded yet, the copy is another LazyDataStore reading the same dataset.
+   * @return std::unique_ptr<IDataStore>
+   */
+  std::unique_ptr<IDataStore> deepCopy() const override
+  {
+    return std::make_unique<LazyDataStore<T>>(*this);
+  }
+
+  /**
+   * @brief Returns true if copies do not duplicate the values until written
+   * to. Unloaded copies read the values from the file separately.
+   * @return bool
+   */
+  bool isCopyOnWrite() const override
+  {
+    return !isLoaded() || m_DataStore->isCopyOnWrite();
+  }
+
+  /**
+   * @brief Returns a data store of the same shape with default initialized
+   * data. The new store is held in memory or memory-mapped like the values of
+   * this store would be once loaded.
+   * @return std::unique_ptr<IDataStore>
+   */
+  std::unique_ptr<IDataStore> createNewInstance() const override
+  {
+    if(m_MemoryMappedDirectory.has_value())
+    {
+      return std::make_unique<MemoryMappedDataStore<T>>(m_TupleShape, m_ComponentShape, static_cast<T>(0), *m_MemoryMappedDirectory);
+    }
+    return std::make_unique<DataStore<T>>(m_TupleShape, m_ComponentShape, static_cast<T>(0));
+  }
+
+  /**
+   * @brief Returns the pointer to the loaded values. Non-const version
+   * @return value_type*
+   */
+  value_type* contiguousData() override
+  {
+    load();
+    return m_DataStore->contiguousData();
+  }
+
+  /**
+   * @brief Returns the pointer to the loaded values. Const version
+   * @return const value_type*
+   */
+  const value_type* contiguousData() const override
+  {
+    load();
+    return std::as_const(*m_DataStore).contiguousData();
+  }
+
+  /**
+   * @brief Writes the data store to HDF5. Returns the HDF5 error code should
+   * one be encountered. Otherwise, returns 0.
+   *
+   * Unloaded values are read into a temporary store that is released once it
+   * has been written so that saving does not keep every array in memory.
+   * @param datasetWriter
+   * @return H5::ErrorType
+   */
+  H5::ErrorType writeHdf5(H5::DatasetWriter& datasetWriter) const override
+  {
+    if(isLoaded())
+    {
+      return m_DataStore->writeHdf5(datasetWriter);
+    }
+    auto dataStore = readStore();
+    return dataStore->writeHdf5(datasetWriter);
+  }
+
+protected:
+  /**
+   * @brief Allocates an uninitialized store for the values.
+   * @return std::unique_ptr<AbstractDataStore<T>>
+   */
+  std::unique_ptr<AbstractDataStore<T>> allocateStore() const
+  {
+    if(m_MemoryMappedDirectory.has_value())
+    {
+      return std::make_unique<MemoryMappedDataStore<T>>(m_TupleShape, m_ComponentShape, std::nullopt, *m_MemoryMappedDirectory);
+    }
+    return std::make_unique<DataStore<T>>(m_TupleShape, m_ComponentShape, std::nullopt);
+  }
+
+  /**
+   * @brief Allocates a store and reads the values from the file into it.
+   * Throws a runtime_error if the dataset cannot be read.
+   * @return std::unique_ptr<AbstractDataStore<T>>
+   */
+  std::unique_ptr<AbstractDataStore<T>> readStore() const
+  {
+    auto dataStore = allocateStore();
+
+    std::lock_guard<std::recursive_mutex> lock(H5::GetLibraryMutex());
+    H5::DatasetReader datasetReader(m_FileReader->getId(), m_DatasetPath);
+    if(!datasetReader.isValid())
+    {
+      throw std::runtime_error(fmt::format("LazyDataStore: Unable to open dataset '{}' in '{}'", m_DatasetPath, m_FileReader->getName()));
+    }
+
+    bool success = false;
+    if(m_HyperslabCount.empty())
+    {
+      success = datasetReader.readIntoSpan<T>(dataStore->createSpan());
+    }
+    else
+    {
+      std::vector<hsize_t> start(m_HyperslabStart.cbegin(), m_HyperslabStart.cend());
+      std::vector<hsize_t> count(m_HyperslabCount.cbegin(), m_HyperslabCount.cend());
+      success = datasetReader.readIntoSpan<T>(dataStore->createSpan(), start, count);
+    }
+    if(!success)
+    {
+      throw std::runtime_error(fmt::format("LazyDataStore: Error reading dataset '{}' from '{}'", m_DatasetPath, m_FileReader->getName()));
+    }
+    return dataStore;
+  }
+
+private:
+  ShapeType m_ComponentShape;
+  ShapeType m_TupleShape;
+  size_t m_NumComponents = {0};
+  size_t m_NumTuples = {0};
+  std::shared_ptr<H5::FileReader> m_FileReader;
+  std::string m_DatasetPath;
+  std::vector<usize> m_HyperslabStart;
+  std::vector<usize> m_HyperslabCount;
+  std::optional<std::filesystem::path> m_MemoryMappedDirectory;
+  mutable std::unique_ptr<AbstractDataStore<T>> m_DataStore = nullptr;
+  mutable std::unique_ptr<std::once_flag> m_LoadFlag;
+  // Set once m_DataStore has been assigned so isLoaded() can be called while another thread loads
+  mutable std::atomic_bool m_Loaded = {false};
+};
+} // namespace complex
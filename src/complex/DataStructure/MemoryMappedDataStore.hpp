@@ -0,0 +1,428 @@
+#pragma once
+
+#include "complex/DataStructure/AbstractDataStore.hpp"
+#include "complex/Utilities/MemoryMappedFile.hpp"
+#include "complex/Utilities/Parsing/HDF5/H5DatasetReader.hpp"
+#include "complex/Utilities/Parsing/HDF5/H5DatasetWriter.hpp"
+#include "complex/Utilities/Parsing/HDF5/H5Support.hpp"
+
+#include <fmt/core.h>
+
+#include <nonstd/span.hpp>
+
+#include <algorithm>
+#include <filesystem>
+#include <memory>
+#include <numeric>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+#include <cstring>
+
+namespace complex
+{
+/**
+ * @class MemoryMappedDataStore
+ * @brief The MemoryMappedDataStore class stores its values in a scratch file
+ * that is memory-mapped into the process. Pages are brought into physical
+ * memory by the operating system as they are accessed and written back to
+ * disk under memory pressure, which allows arrays larger than the available
+ * RAM to be used by filters exactly like an in-memory DataStore.
+ *
+ * The scratch file is deleted when the data store is destroyed. A data store
+ * can also adopt an existing copy-on-write mapping, in which case the file on
+ * disk is never modified but must not be changed by anyone else while the data
+ * store exists.
+ * @tparam T
+ */
+template <typename T>
+class MemoryMappedDataStore : public AbstractDataStore<T>
+{
+public:
+  using value_type = typename AbstractDataStore<T>::value_type;
+  using reference = typename AbstractDataStore<T>::reference;
+  using const_reference = typename AbstractDataStore<T>::const_reference;
+  using ShapeType = typename IDataStore::ShapeType;
+
+  static_assert(std::is_trivially_copyable_v<T>, "MemoryMappedDataStore requires a trivially copyable value type");
+
+  /**
+   * @brief Constructs a MemoryMappedDataStore with the specified tuple and
+   * component shapes backed by a new scratch file in the specified directory.
+   *
+   * Scratch files are zero filled when created, so the values are only written
+   * if a non-zero initValue is provided.
+   * @param tupleShape The dimensions of the tuples
+   * @param componentShape The dimensions of the component at each tuple
+   * @param initValue
+   * @param directory The directory to create the scratch file in
+   */
+  MemoryMappedDataStore(const ShapeType& tupleShape, const ShapeType& componentShape, std::optional<T> initValue, const std::filesystem::path& directory)
+  : m_ComponentShape(componentShape)
+  , m_TupleShape(tupleShape)
+  , m_NumComponents(std::accumulate(m_ComponentShape.cbegin(), m_ComponentShape.cend(), static_cast<size_t>(1), std::multiplies<>()))
+  , m_NumTuples(std::accumulate(m_TupleShape.cbegin(), m_TupleShape.cend(), static_cast<size_t>(1), std::multiplies<>()))
+  , m_Directory(directory)
+  {
+    m_File = MemoryMappedFile::CreateScratchFile(directory, m_NumComponents * m_NumTuples * sizeof(T));
+    if(initValue.has_value() && *initValue != static_cast<T>(0))
+    {
+      std::fill_n(data(), this->getSize(), *initValue);
+    }
+  }
+
+  /**
+   * @brief Constructs a MemoryMappedDataStore whose values are read from an
+   * existing mapping starting at byteOffset. The mapping should be opened in
+   * CopyOnWrite mode so that the values can be modified without changing the
+   * file. Copies of the data store and resized data stores are backed by
+   * scratch files in the specified directory.
+   *
+   * Values that were not modified are read from the file on demand, so only
+   * adopt files that nothing else will write to or truncate while the data
+   * store exists. User input files should be copied instead.
+   *
+   * Throws a runtime_error if the mapping is too small or the offset is not
+   * aligned for T.
+   * @param tupleShape The dimensions of the tuples
+   * @param componentShape The dimensions of the component at each tuple
+   * @param file The mapping to adopt
+   * @param byteOffset The offset of the first value within the mapping
+   * @param directory The directory to create scratch files in
+   */
+  MemoryMappedDataStore(const ShapeType& tupleShape, const ShapeType& componentShape, std::unique_ptr<MemoryMappedFile> file, usize byteOffset, const std::filesystem::path& directory)
+  : m_ComponentShape(componentShape)
+  , m_TupleShape(tupleShape)
+  , m_File(std::move(file))
+  , m_ByteOffset(byteOffset)
+  , m_NumComponents(std::accumulate(m_ComponentShape.cbegin(), m_ComponentShape.cend(), static_cast<size_t>(1), std::multiplies<>()))
+  , m_NumTuples(std::accumulate(m_TupleShape.cbegin(), m_TupleShape.cend(), static_cast<size_t>(1), std::multiplies<>()))
+  , m_Directory(directory)
+  {
+    if(m_File == nullptr || m_File->size() < m_ByteOffset || (m_File->size() - m_ByteOffset) / sizeof(T) < this->getSize())
+    {
+      throw std::runtime_error("MemoryMappedDataStore: The mapped file is smaller than the data store");
+    }
+    if(m_ByteOffset % alignof(T) != 0)
+    {
+      throw std::runtime_error(fmt::format("MemoryMappedDataStore: The byte offset ({}) is not aligned to {} bytes", m_ByteOffset, alignof(T)));
+    }
+  }
+
+  /**
+   * @brief Copy constructor. The copy is backed by a new scratch file in the
+   * same directory as the original.
+   * @param other
+   */
+  MemoryMappedDataStore(const MemoryMappedDataStore& other)
+  : m_ComponentShape(other.m_ComponentShape)
+  , m_TupleShape(other.m_TupleShape)
+  , m_NumComponents(other.m_NumComponents)
+  , m_NumTuples(other.m_NumTuples)
+  , m_Directory(other.m_Directory)
+  {
+    const usize numBytes = other.getSize() * sizeof(T);
+    m_File = MemoryMappedFile::CreateScratchFile(m_Directory, numBytes);
+    if(numBytes > 0)
+    {
+      std::memcpy(m_File->data(), other.data(), numBytes);
+    }
+  }
+
+  /**
+   * @brief Move constructor
+   * @param other
+   */
+  MemoryMappedDataStore(MemoryMappedDataStore&& other) noexcept
+  : m_ComponentShape(std::move(other.m_ComponentShape))
+  , m_TupleShape(std::move(other.m_TupleShape))
+  , m_File(std::move(other.m_File))
+  , m_ByteOffset(other.m_ByteOffset)
+  , m_NumComponents(other.m_NumComponents)
+  , m_NumTuples(other.m_NumTuples)
+  , m_Directory(std::move(other.m_Directory))
+  {
+  }
+
+  MemoryMappedDataStore& operator=(const MemoryMappedDataStore& rhs) = delete;
+  MemoryMappedDataStore& operator=(MemoryMappedDataStore&& rhs) = default;
+
+  ~MemoryMappedDataStore() override = default;
+
+  /**
+   * @brief Returns the number of tuples in the DataStore.
+   * @return usize
+   */
+  usize getNumberOfTuples() const override
+  {
+    return m_NumTuples;
+  }
+
+  /**
+   * @brief Returns the number of elements in each Tuple.
+   * @return usize
+   */
+  usize getNumberOfComponents() const override
+  {
+    return m_NumComponents;
+  }
+
+  /**
+   * @brief Returns the dimensions of the Tuples
+   * @return
+   */
+  const ShapeType& getTupleShape() const override
+  {
+    return m_TupleShape;
+  }
+
+  /**
+   * @brief Returns the dimensions of the Components
+   * @return
+   */
+  const ShapeType& getComponentShape() const override
+  {
+    return m_ComponentShape;
+  }
+
+  /**
+   * @brief Returns the store type e.g. in memory, out of core, etc.
+   * @return StoreType
+   */
+  IDataStore::StoreType getStoreType() const override
+  {
+    return IDataStore::StoreType::MemoryMapped;
+  }
+
+  /**
+   * @brief Returns the directory that scratch files are created in.
+   * @return std::filesystem::path
+   */
+  std::filesystem::path getDirectory() const
+  {
+    return m_Directory;
+  }
+
+  /**
+   * @brief Returns the pointer to the mapped data. Const version
+   * @return
+   */
+  const T* data() const
+  {
+    return reinterpret_cast<const T*>(m_File->data() + m_ByteOffset);
+  }
+
+  /**
+   * @brief Returns the pointer to the mapped data. Non-const version
+   * @return
+   */
+  T* data()
+  {
+    return reinterpret_cast<T*>(m_File->data() + m_ByteOffset);
+  }
+
+  /**
+   * @brief Resizes the backing file to hold the new number of tuples. Existing
+   * values are preserved by the file system and any new values are zero.
+   * Adopted mappings are first moved to a new scratch file so that the
+   * original file is never resized.
+   * @param tupleShape
+   */
+  void reshapeTuples(const ShapeType& tupleShape) override
+  {
+    const usize oldNumBytes = this->getSize() * sizeof(T);
+    m_TupleShape = tupleShape;
+    m_NumTuples = std::accumulate(m_TupleShape.cbegin(), m_TupleShape.cend(), static_cast<size_t>(1), std::multiplies<>());
+    const usize numBytes = m_NumComponents * m_NumTuples * sizeof(T);
+    if(!m_File->isScratchFile())
+    {
+      auto scratchFile = MemoryMappedFile::CreateScratchFile(m_Directory, numBytes);
+      const usize numBytesToCopy = std::min(oldNumBytes, numBytes);
+      if(numBytesToCopy > 0)
+      {
+        std::memcpy(scratchFile->data(), data(), numBytesToCopy);
+      }
+      m_File = std::move(scratchFile);
+      m_ByteOffset = 0;
+      return;
+    }
+    m_File->resize(numBytes);
+  }
+
+  /**
+   * @brief Returns the value found at the specified index of the DataStore.
+   * This cannot be used to edit the value found at the specified index.
+   * @param index
+   * @return value_type
+   */
+  value_type getValue(usize index) const override
+  {
+    return data()[index];
+  }
+
+  /**
+   * @brief Sets the value stored at the specified index.
+   * @param index
+   * @param value
+   */
+  void setValue(usize index, value_type value) override
+  {
+    data()[index] = value;
+  }
+
+  /**
+   * @brief Returns the value found at the specified index of the DataStore.
+   * This cannot be used to edit the value found at the specified index.
+   * @param  index
+   * @return const_reference
+   */
+  const_reference operator[](usize index) const override
+  {
+    return data()[index];
+  }
+
+  /**
+   * @brief Returns the value found at the specified index of the DataStore.
+   * This can be used to edit the value found at the specified index.
+   * @param  index
+   * @return reference
+   */
+  reference operator[](usize index) override
+  {
+    return data()[index];
+  }
+
+  /**
+   * @brief Returns the value found at the specified index of the DataStore.
+   * This cannot be used to edit the value found at the specified index.
+   * @param index
+   * @return const_reference
+   */
+  const_reference at(usize index) const override
+  {
+    if(index >= this->getSize())
+    {
+      throw std::runtime_error(fmt::format("MemoryMappedDataStore: Index ({}) is out of range ({})", index, this->getSize()));
+    }
+    return data()[index];
+  }
+
+  /**
+   * @brief Fills the mapped file with the specified value.
+   * @param value
+   */
+  void fill(value_type value) override
+  {
+    std::fill_n(data(), this->getSize(), value);
+  }
+
+  /**
+   * @brief Returns a deep copy of the data store and all its data.
+   * @return std::unique_ptr<IDataStore>
+   */
+  std::unique_ptr<IDataStore> deepCopy() const override
+  {
+    return std::make_unique<MemoryMappedDataStore<T>>(*this);
+  }
+
+  /**
+   * @brief Returns a data store of the same type as this but with default initialized data.
+   * @return std::unique_ptr<IDataStore>
+   */
+  std::unique_ptr<IDataStore> createNewInstance() const override
+  {
+    return std::make_unique<MemoryMappedDataStore<T>>(this->getTupleShape(), this->getComponentShape(), static_cast<T>(0), getDirectory());
+  }
+
+  /**
+   * @brief Returns the pointer to the mapped data. Non-const version
+   * @return value_type*
+   */
+  value_type* contiguousData() override
+  {
+    return data();
+  }
+
+  /**
+   * @brief Returns the pointer to the mapped data. Const version
+   * @return const value_type*
+   */
+  const value_type* contiguousData() const override
+  {
+    return data();
+  }
+
+  /**
+   * @brief Writes the data store to HDF5. Returns the HDF5 error code should
+   * one be encountered. Otherwise, returns 0.
+   * @param datasetWriter
+   * @return H5::ErrorType
+   */
+  H5::ErrorType writeHdf5(H5::DatasetWriter& datasetWriter) const override
+  {
+    if(!datasetWriter.isValid())
+    {
+      return -1;
+    }
+
+    std::vector<hsize_t> h5dims;
+    for(const auto& value : m_TupleShape)
+    {
+      h5dims.push_back(static_cast<hsize_t>(value));
+    }
+    for(const auto& value : m_ComponentShape)
+    {
+      h5dims.push_back(static_cast<hsize_t>(value));
+    }
+
+    herr_t err = datasetWriter.writeSpan(h5dims, this->createSpan());
+    if(err < 0)
+    {
+      return err;
+    }
+
+    auto tupleAttribute = datasetWriter.createAttribute(complex::H5::k_TupleShapeTag);
+    err = tupleAttribute.writeVector({m_TupleShape.size()}, m_TupleShape);
+    if(err < 0)
+    {
+      return err;
+    }
+
+    auto componentAttribute = datasetWriter.createAttribute(complex::H5::k_ComponentShapeTag);
+    err = componentAttribute.writeVector({m_ComponentShape.size()}, m_ComponentShape);
+
+    return err;
+  }
+
+  /**
+   * @brief Creates a MemoryMappedDataStore in the specified directory and reads
+   * the contents of the provided dataset directly into the mapped file.
+   * @param datasetReader
+   * @param directory
+   * @return std::unique_ptr<MemoryMappedDataStore>
+   */
+  static std::unique_ptr<MemoryMappedDataStore> ReadHdf5(const H5::DatasetReader& datasetReader, const std::filesystem::path& directory)
+  {
+    auto tupleShape = IDataStore::ReadTupleShape(datasetReader);
+    auto componentShape = IDataStore::ReadComponentShape(datasetReader);
+
+    auto dataStore = std::make_unique<MemoryMappedDataStore<T>>(tupleShape, componentShape, std::nullopt, directory);
+    if(!datasetReader.readIntoSpan(dataStore->createSpan()))
+    {
+      throw std::runtime_error(fmt::format("Error reading data array into MemoryMappedDataStore from HDF5 at {}/{}", H5::Support::GetObjectPath(datasetReader.getParentId()), datasetReader.getName()));
+    }
+
+    return dataStore;
+  }
+
+private:
+  ShapeType m_ComponentShape;
+  ShapeType m_TupleShape;
+  std::unique_ptr<MemoryMappedFile> m_File = nullptr;
+  usize m_ByteOffset = 0;
+  size_t m_NumComponents = {0};
+  size_t m_NumTuples = {0};
+  std::filesystem::path m_Directory;
+};
+} // namespace complex
@@ -7,6 +7,10 @@
 #include "complex/Utilities/Parsing/HDF5/H5GroupReader.hpp"
 #include "complex/Utilities/Parsing/HDF5/H5GroupWriter.hpp"
 
+#include <algorithm>
+#include <mutex>
+#include <numeric>
+
 namespace complex
 {
 template <typename T>
@@ -26,6 +30,32 @@ NeighborList<T>::NeighborList(DataStructure& dataStructure, const std::string& n
 {
 }
 
+template <typename T>
+NeighborList<T>::NeighborList(DataStructure& dataStructure, const std::string& name, FlatStorage storage, IdType importId)
+: INeighborList(dataStructure, name, storage.offsets.empty() ? 0 : storage.offsets.size() - 1, importId)
+, m_IsAllocated(true)
+, m_InitValue(static_cast<T>(0.0))
+{
+  setFlatStorage(std::move(storage));
+}
+
+template <typename T>
+NeighborList<T>::NeighborList(const NeighborList& other)
+: INeighborList(other)
+, m_IsAllocated(other.m_IsAllocated)
+, m_InitValue(other.m_InitValue)
+{
+  if(other.hasFlatStorage())
+  {
+    m_FlatStorage = other.m_FlatStorage;
+    m_IsFlat = true;
+  }
+  else
+  {
+    m_Array = other.m_Array;
+  }
+}
+
 template <typename T>
 NeighborList<T>* NeighborList<T>::Create(DataStructure& ds, const std::string& name, usize numTuples, const std::optional<IdType>& parentId)
 {
@@ -49,6 +79,17 @@ NeighborList<T>* NeighborList<T>::Import(DataStructure& ds, const std::string& n
   return data.get();
 }
 
+template <typename T>
+NeighborList<T>* NeighborList<T>::Import(DataStructure& ds, const std::string& name, IdType importId, FlatStorage storage, const std::optional<IdType>& parentId)
+{
+  auto data = std::shared_ptr<NeighborList>(new NeighborList(ds, name, std::move(storage), importId));
+  if(!AttemptToAddObject(ds, data, parentId))
+  {
+    return nullptr;
+  }
+  return data.get();
+}
+
 template <typename T>
 DataObject* NeighborList<T>::shallowCopy()
 {
@@ -60,7 +101,6 @@ DataObject* NeighborList<T>::deepCopy()
 {
   auto copy = new NeighborList(*this);
   copy->setNumNeighborsArrayName(getNumNeighborsArrayName());
-  copy->m_Array = m_Array;
   return copy;
 }
 
@@ -80,6 +120,7 @@ int32 NeighborList<T>::eraseTuples(const std::vector<usize>& idxs)
     return 0;
   }
 
+  expandFlatStorage();
   usize idxsSize = static_cast<usize>(idxs.size());
   if(idxsSize >= getNumberOfTuples())
   {
@@ -126,12 +167,17 @@ int32 NeighborList<T>::eraseTuples(const std::vector<usize>& idxs)
 template <typename T>
 void NeighborList<T>::copyTuple(usize currentPos, usize newPos)
 {
+  expandFlatStorage();
   m_Array[newPos] = m_Array[currentPos];
 }
 
 template <typename T>
 usize NeighborList<T>::getSize() const
 {
+  if(hasFlatStorage())
+  {
+    return m_FlatStorage.values.size();
+  }
   usize total = 0;
   for(usize dIdx = 0; dIdx < m_Array.size(); ++dIdx)
   {
@@ -154,6 +200,8 @@ usize NeighborList<T>::getTypeSize() const
 template <typename T>
 void NeighborList<T>::initializeWithZeros()
 {
+  m_FlatStorage = FlatStorage();
+  m_IsFlat = false;
   m_Array.clear();
   m_IsAllocated = false;
 }
@@ -162,6 +210,7 @@ template <typename T>
 int32 NeighborList<T>::resizeTotalElements(usize size)
 {
   // std::cout << "NeighborList::resizeTotalElements(" << size << ")" << std::endl;
+  expandFlatStorage();
   usize old = m_Array.size();
   m_Array.resize(size);
   setNumberOfTuples(size);
@@ -190,6 +239,7 @@ void NeighborList<T>::resizeTuples(usize numTuples)
 template <typename T>
 void NeighborList<T>::addEntry(int32 grainId, value_type value)
 {
+  expandFlatStorage();
   if(grainId >= static_cast<int32>(m_Array.size()))
   {
     usize old = m_Array.size();
@@ -208,6 +258,8 @@ void NeighborList<T>::addEntry(int32 grainId, value_type value)
 template <typename T>
 void NeighborList<T>::clearAllLists()
 {
+  m_FlatStorage = FlatStorage();
+  m_IsFlat = false;
   m_Array.clear();
   m_IsAllocated = false;
 }
@@ -215,6 +267,7 @@ void NeighborList<T>::clearAllLists()
 template <typename T>
 void NeighborList<T>::setList(int32 grainId, const SharedVectorType& neighborList)
 {
+  expandFlatStorage();
   if(grainId >= static_cast<int32>(m_Array.size()))
   {
     usize old = m_Array.size();
@@ -232,58 +285,163 @@ void NeighborList<T>::setList(int32 grainId, const SharedVectorType& neighborLis
 template <typename T>
 T NeighborList<T>::getValue(int32 grainId, int32 index, bool& ok) const
 {
-  SharedVectorType vec = m_Array[grainId];
-  if(index < 0 || static_cast<usize>(index) >= vec->size())
+  auto list = getListSpan(grainId);
+  if(index < 0 || static_cast<usize>(index) >= list.size())
   {
     ok = false;
     return static_cast<T>(-1);
   }
-  return (*vec)[index];
+  return list[index];
 }
 
 template <typename T>
 int32 NeighborList<T>::getNumberOfLists() const
 {
+  if(hasFlatStorage())
+  {
+    return static_cast<int32>(m_FlatStorage.offsets.size() - 1);
+  }
   return static_cast<int32>(m_Array.size());
 }
 
 template <typename T>
 int32 NeighborList<T>::getListSize(int32 grainId) const
 {
-  return static_cast<int32>(m_Array[grainId]->size());
+  return static_cast<int32>(getListSpan(grainId).size());
 }
 
 template <typename T>
 typename NeighborList<T>::VectorType& NeighborList<T>::getListReference(int32 grainId) const
 {
+  expandFlatStorage();
   return *(m_Array[grainId]);
 }
 
 template <typename T>
 typename NeighborList<T>::SharedVectorType NeighborList<T>::getList(int32 grainId) const
 {
+  expandFlatStorage();
   return m_Array[grainId];
 }
 
 template <typename T>
 typename NeighborList<T>::VectorType NeighborList<T>::copyOfList(int32 grainId) const
 {
-  VectorType copy(*(m_Array[grainId]));
+  auto list = getListSpan(grainId);
+  VectorType copy(list.begin(), list.end());
   return copy;
 }
 
 template <typename T>
 typename NeighborList<T>::VectorType& NeighborList<T>::operator[](int32 grainId)
 {
+  expandFlatStorage();
   return *(m_Array[grainId]);
 }
 
 template <typename T>
 typename NeighborList<T>::VectorType& NeighborList<T>::operator[](usize grainId)
 {
+  expandFlatStorage();
   return *(m_Array[grainId]);
 }
 
+template <typename T>
+nonstd::span<const T> NeighborList<T>::getListSpan(usize listIndex) const
+{
+  if(hasFlatStorage())
+  {
+    const usize begin = m_FlatStorage.offsets[listIndex];
+    return {m_FlatStorage.values.data() + begin, m_FlatStorage.offsets[listIndex + 1] - begin};
+  }
+  const VectorType& list = *(m_Array[listIndex]);
+  return {list.data(), list.size()};
+}
+
+template <typename T>
+bool NeighborList<T>::hasFlatStorage() const
+{
+  return m_IsFlat.load(std::memory_order_acquire);
+}
+
+template <typename T>
+void NeighborList<T>::setFlatStorage(FlatStorage storage)
+{
+  if(storage.offsets.empty() || storage.offsets.front() != 0 || storage.offsets.back() != storage.values.size() ||
+     !std::is_sorted(storage.offsets.cbegin(), storage.offsets.cend()))
+  {
+    throw std::runtime_error(fmt::format("NeighborList: The offsets of '{}' do not describe its {} values", getName(), storage.values.size()));
+  }
+  m_Array.clear();
+  m_FlatStorage = std::move(storage);
+  m_IsFlat = true;
+  m_IsAllocated = true;
+  setNumberOfTuples(m_FlatStorage.offsets.size() - 1);
+}
+
+template <typename T>
+void NeighborList<T>::flatten()
+{
+  if(hasFlatStorage())
+  {
+    return;
+  }
+  FlatStorage storage;
+  storage.offsets.resize(m_Array.size() + 1);
+  for(usize i = 0; i < m_Array.size(); i++)
+  {
+    storage.offsets[i + 1] = storage.offsets[i] + m_Array[i]->size();
+  }
+  storage.values.reserve(storage.offsets.back());
+  for(const auto& list : m_Array)
+  {
+    storage.values.insert(storage.values.end(), list->cbegin(), list->cend());
+  }
+  setFlatStorage(std::move(storage));
+}
+
+template <typename T>
+void NeighborList<T>::detachLists()
+{
+  if(hasFlatStorage())
+  {
+    return;
+  }
+  for(auto& list : m_Array)
+  {
+    if(list != nullptr && list.use_count() > 1)
+    {
+      list = std::make_shared<VectorType>(*list);
+    }
+  }
+}
+
+template <typename T>
+void NeighborList<T>::expandFlatStorage() const
+{
+  if(!hasFlatStorage())
+  {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(m_ExpandMutex);
+  if(!m_IsFlat.load(std::memory_order_relaxed))
+  {
+    return;
+  }
+
+  const usize numLists = m_FlatStorage.offsets.size() - 1;
+  m_Array.resize(numLists);
+  for(usize i = 0; i < numLists; i++)
+  {
+    auto begin = m_FlatStorage.values.cbegin() + m_FlatStorage.offsets[i];
+    auto end = m_FlatStorage.values.cbegin() + m_FlatStorage.offsets[i + 1];
+    m_Array[i] = std::make_shared<VectorType>(begin, end);
+  }
+  m_IsFlat.store(false, std::memory_order_release);
+  m_FlatStorage = FlatStorage();
+}
+
 template <typename T>
 DataObject::Type NeighborList<T>::getDataObjectType() const
 {
@@ -364,15 +522,15 @@ H5::ErrorType NeighborList<T>::writeHdf5(H5::DataStructureWriter& dataStructureW
   DataStructure tmp;
 
   // Create NumNeighbors DataStore
-  const usize arraySize = m_Array.size();
+  const usize arraySize = static_cast<usize>(getNumberOfLists());
   auto* numNeighborsArray = Int32Array::CreateWithStore<Int32DataStore>(tmp, getNumNeighborsArrayName(), {arraySize}, {1});
-  auto& numNeighborsStore = numNeighborsArray->getDataStoreRef();
+  auto numNeighbors = numNeighborsArray->getDataStoreRef().createSpan();
   usize totalItems = 0;
   for(usize i = 0; i < arraySize; i++)
   {
-    const auto numNeighbors = m_Array[i]->size();
-    numNeighborsStore[i] = static_cast<int32>(numNeighbors);
-    totalItems += numNeighbors;
+    const usize listSize = getListSpan(i).size();
+    numNeighbors[i] = static_cast<int32>(listSize);
+    totalItems += listSize;
   }
 
   // Write NumNeighbors data
@@ -382,27 +540,41 @@ H5::ErrorType NeighborList<T>::writeHdf5(H5::DataStructureWriter& dataStructureW
     return error;
   }
 
-  // Create flattened neighbor DataStore
-  DataStore<T> flattenedData(totalItems, static_cast<T>(0));
-  usize offset = 0;
-  for(const auto& segment : m_Array)
+  // Flat storage is written directly. Otherwise the lists are gathered into a
+  // single buffer first.
+  std::vector<T> flattenedData;
+  nonstd::span<const T> values;
+  if(hasFlatStorage())
   {
-    usize numElements = segment->size();
-    if(numElements == 0)
-    {
-      continue;
-    }
-    T* start = segment->data();
-    for(usize i = 0; i < numElements; i++)
+    values = nonstd::span<const T>(m_FlatStorage.values.data(), m_FlatStorage.values.size());
+  }
+  else
+  {
+    flattenedData.reserve(totalItems);
+    for(const auto& segment : m_Array)
     {
-      flattenedData[offset + i] = start[i];
+      flattenedData.insert(flattenedData.end(), segment->cbegin(), segment->cend());
     }
-    offset += numElements;
+    values = nonstd::span<const T>(flattenedData.data(), flattenedData.size());
   }
 
   // Write flattened array to HDF5 as a separate array
   auto datasetWriter = parentGroupWriter.createDatasetWriter(getName());
-  H5::ErrorType err = flattenedData.writeHdf5(datasetWriter);
+  H5::ErrorType err = datasetWriter.writeSpan({static_cast<hsize_t>(totalItems), 1}, values);
+  if(err < 0)
+  {
+    return err;
+  }
+  const IDataStore::ShapeType tupleShape = {totalItems};
+  const IDataStore::ShapeType componentShape = {1};
+  auto tupleAttribute = datasetWriter.createAttribute(complex::H5::k_TupleShapeTag);
+  err = tupleAttribute.writeVector({tupleShape.size()}, tupleShape);
+  if(err < 0)
+  {
+    return err;
+  }
+  auto componentAttribute = datasetWriter.createAttribute(complex::H5::k_ComponentShapeTag);
+  err = componentAttribute.writeVector({componentShape.size()}, componentShape);
   if(err < 0)
   {
     return err;
@@ -417,38 +589,46 @@ H5::ErrorType NeighborList<T>::writeHdf5(H5::DataStructureWriter& dataStructureW
 }
 
 template <typename T>
-std::vector<typename NeighborList<T>::SharedVectorType> NeighborList<T>::ReadHdf5Data(const H5::GroupReader& parentGroup, const H5::DatasetReader& dataReader)
+typename NeighborList<T>::FlatStorage NeighborList<T>::ReadHdf5FlatData(const H5::GroupReader& parentGroup, const H5::DatasetReader& dataReader)
 {
   auto numNeighborsAttributeName = dataReader.getAttribute("Linked NumNeighbors Dataset");
   auto numNeighborsName = numNeighborsAttributeName.readAsString();
 
   auto numNeighborsReader = parentGroup.openDataset(numNeighborsName);
+  std::vector<int32> numNeighbors = numNeighborsReader.template readAsVector<int32>();
 
-  auto numNeighborsPtr = Int32DataStore::ReadHdf5(numNeighborsReader);
-  auto& numNeighborsStore = *numNeighborsPtr.get();
+  FlatStorage storage;
+  storage.offsets.resize(numNeighbors.size() + 1);
+  for(usize i = 0; i < numNeighbors.size(); i++)
+  {
+    storage.offsets[i + 1] = storage.offsets[i] + static_cast<usize>(numNeighbors[i]);
+  }
 
-  std::vector<T> flatDataStore = dataReader.template readAsVector<T>();
-  if(flatDataStore.empty())
+  const usize totalItems = storage.offsets.back();
+  if(totalItems != dataReader.getNumElements())
+  {
+    throw std::runtime_error(fmt::format("Error reading neighbor list from HDF5 at {}/{}: '{}' describes {} values but {} were found", H5::Support::GetObjectPath(dataReader.getParentId()),
+                                         dataReader.getName(), numNeighborsName, totalItems, dataReader.getNumElements()));
+  }
+  storage.values.resize(totalItems);
+  if(totalItems > 0 && !dataReader.readIntoSpan(nonstd::span<T>(storage.values.data(), storage.values.size())))
   {
     throw std::runtime_error(fmt::format("Error reading neighbor list from DataStore from HDF5 at {}/{}", H5::Support::GetObjectPath(dataReader.getParentId()), dataReader.getName()));
   }
+  return storage;
+}
 
-  std::vector<SharedVectorType> dataVector;
-  usize offset = 0;
-  const auto numTuples = numNeighborsStore.getNumberOfTuples();
-  for(usize i = 0; i < numTuples; i++)
-  {
-    const auto numNeighbors = numNeighborsStore[i];
-    auto sharedVector = std::make_shared<std::vector<T>>(numNeighbors);
-    std::vector<T>& vector = *sharedVector.get();
+template <typename T>
+std::vector<typename NeighborList<T>::SharedVectorType> NeighborList<T>::ReadHdf5Data(const H5::GroupReader& parentGroup, const H5::DatasetReader& dataReader)
+{
+  FlatStorage storage = ReadHdf5FlatData(parentGroup, dataReader);
 
-    size_t neighborListStart = offset;
-    size_t neighborListEnd = offset + numNeighbors;
-    sharedVector->assign(flatDataStore.begin() + neighborListStart, flatDataStore.begin() + neighborListEnd);
-    offset += numNeighbors;
-    dataVector.push_back(sharedVector);
+  const usize numLists = storage.offsets.size() - 1;
+  std::vector<SharedVectorType> dataVector(numLists);
+  for(usize i = 0; i < numLists; i++)
+  {
+    dataVector[i] = std::make_shared<VectorType>(storage.values.cbegin() + storage.offsets[i], storage.values.cbegin() + storage.offsets[i + 1]);
   }
-
   return dataVector;
 }
 
@@ -2,6 +2,15 @@
 
 #include "complex/DataStructure/INeighborList.hpp"
 
+#include <nonstd/span.hpp>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
 namespace complex
 {
 namespace H5
@@ -19,6 +28,13 @@ constexpr StringLiteral NumNeighborsTag = "_NumNeighbors";
 /**
  * @class NeighborList
  * @brief
+ *
+ * A NeighborList stores its lists either as one vector per list or in flat,
+ * compressed sparse row (CSR) storage made of an offsets array and a single
+ * values array. Lists built with a NeighborList::Builder or read from HDF5 use
+ * flat storage. Accessing a list through a method that returns a vector
+ * reference converts the storage to one vector per list and frees the flat
+ * values.
  * @tparam T
  */
 template <typename T>
@@ -31,6 +47,109 @@ public:
   using VectorType = std::vector<T>;
   using SharedVectorType = std::shared_ptr<VectorType>;
 
+  /**
+   * @brief Flat, compressed sparse row storage. The values of list i are
+   * values[offsets[i]] through values[offsets[i + 1] - 1], so offsets holds one
+   * more element than there are lists.
+   */
+  struct FlatStorage
+  {
+    std::vector<usize> offsets = {0};
+    std::vector<T> values;
+  };
+
+  /**
+   * @class Builder
+   * @brief Builds the flat storage of a NeighborList in bulk.
+   *
+   * Lists can either be appended in order with appendList(), or sized first
+   * with addToListSize() and then filled in any order, including in parallel,
+   * through the spans returned by getList() once allocate() has been called.
+   */
+  class Builder
+  {
+  public:
+    /**
+     * @brief Constructs a Builder for appending lists in order.
+     */
+    Builder() = default;
+
+    /**
+     * @brief Constructs a Builder for the specified number of lists, which are
+     * sized with addToListSize() before calling allocate().
+     * @param numLists
+     */
+    explicit Builder(usize numLists)
+    : m_Sizes(numLists, 0)
+    {
+    }
+
+    /**
+     * @brief Appends a list after the previously appended lists.
+     * @param list
+     */
+    void appendList(nonstd::span<const T> list)
+    {
+      if(!m_Sizes.empty())
+      {
+        throw std::runtime_error("NeighborList::Builder: Lists cannot be appended to a Builder constructed with a number of lists");
+      }
+      m_Storage.values.insert(m_Storage.values.end(), list.begin(), list.end());
+      m_Storage.offsets.push_back(m_Storage.values.size());
+    }
+
+    /**
+     * @brief Increases the size of the specified list before allocation.
+     * @param listIndex
+     * @param count = 1
+     */
+    void addToListSize(usize listIndex, usize count = 1)
+    {
+      m_Sizes.at(listIndex) += count;
+    }
+
+    /**
+     * @brief Allocates the values of every sized list. The values are
+     * initialized to zero.
+     */
+    void allocate()
+    {
+      m_Storage.offsets.resize(m_Sizes.size() + 1);
+      m_Storage.offsets[0] = 0;
+      for(usize i = 0; i < m_Sizes.size(); i++)
+      {
+        m_Storage.offsets[i + 1] = m_Storage.offsets[i] + m_Sizes[i];
+      }
+      m_Storage.values.assign(m_Storage.offsets.back(), static_cast<T>(0));
+    }
+
+    /**
+     * @brief Returns the allocated values of the specified list. Different
+     * lists can safely be written to from different threads.
+     * @param listIndex
+     * @return nonstd::span<T>
+     */
+    nonstd::span<T> getList(usize listIndex)
+    {
+      const usize begin = m_Storage.offsets.at(listIndex);
+      return {m_Storage.values.data() + begin, m_Storage.offsets.at(listIndex + 1) - begin};
+    }
+
+    /**
+     * @brief Returns the built storage. The Builder is left empty.
+     * @return FlatStorage
+     */
+    FlatStorage build()
+    {
+      m_Sizes.clear();
+      return std::exchange(m_Storage, FlatStorage());
+    }
+
+  private:
+    std::vector<usize> m_Sizes;
+    FlatStorage m_Storage;
+  };
+
   NeighborList() = default;
 
   /**
@@ -55,6 +174,27 @@ public:
    */
   static NeighborList* Import(DataStructure& ds, const std::string& name, IdType importId, const std::vector<SharedVectorType>& data, const std::optional<IdType>& parentId = {});
 
+  /**
+   * @brief Imports a NeighborList that uses the provided flat storage.
+   * @param ds
+   * @param name
+   * @param importId
+   * @param storage
+   * @param parentId
+   * @return NeighborList<T>*
+   */
+  static NeighborList* Import(DataStructure& ds, const std::string& name, IdType importId, FlatStorage storage, const std::optional<IdType>& parentId = {});
+
+  /**
+   * @brief Copy constructor
+   * @param other
+   */
+  NeighborList(const NeighborList& other);
+
+  NeighborList(NeighborList&&) = delete;
+  NeighborList& operator=(const NeighborList&) = delete;
+  NeighborList& operator=(NeighborList&&) = delete;
+
   ~NeighborList() override = default;
 
   /**
@@ -207,6 +347,41 @@ public:
    */
   VectorType& operator[](usize grainId);
 
+  /**
+   * @brief Returns a read-only view of the target list. Unlike the methods
+   * returning vectors, this does not convert flat storage. The view is
+   * invalidated when the NeighborList is modified or its flat storage is
+   * converted, including through the const getList() and getListReference().
+   * @param listIndex
+   * @return nonstd::span<const T>
+   */
+  nonstd::span<const T> getListSpan(usize listIndex) const;
+
+  /**
+   * @brief Returns true if the lists are held in flat storage.
+   * @return bool
+   */
+  bool hasFlatStorage() const;
+
+  /**
+   * @brief Replaces every list with the provided flat storage. Throws a
+   * runtime_error if the offsets are not valid for the values.
+   * @param storage
+   */
+  void setFlatStorage(FlatStorage storage);
+
+  /**
+   * @brief Converts the lists to flat storage if they are held as one vector
+   * per list.
+   */
+  void flatten();
+
+  /**
+   * @brief Gives this NeighborList its own copy of every list. Flat storage is
+   * never shared, but shallow copies share the vectors holding the lists.
+   */
+  void detachLists() override;
+
   /**
    * @brief Returns the DataArray's value type as an enum
    * @return DataType
@@ -238,6 +413,14 @@ public:
    */
   static std::vector<SharedVectorType> ReadHdf5Data(const H5::GroupReader& parentGroup, const H5::DatasetReader& dataReader);
 
+  /**
+   * @brief Reads the lists from HDF5 directly into flat storage.
+   * @param parentGroup
+   * @param dataReader
+   * @return FlatStorage
+   */
+  static FlatStorage ReadHdf5FlatData(const H5::GroupReader& parentGroup, const H5::DatasetReader& dataReader);
+
 protected:
   /**
    * @brief NeighborList
@@ -249,8 +432,23 @@ protected:
    */
   NeighborList(DataStructure& dataStructure, const std::string& name, const std::vector<SharedVectorType>& dataVector, IdType importId);
 
+  /**
+   * @brief NeighborList
+   */
+  NeighborList(DataStructure& dataStructure, const std::string& name, FlatStorage storage, IdType importId);
+
 private:
-  std::vector<SharedVectorType> m_Array;
+  /**
+   * @brief Converts flat storage to one vector per list and frees the flat
+   * values. Several threads may expand at once, but not while other threads
+   * read through getListSpan().
+   */
+  void expandFlatStorage() const;
+
+  mutable std::vector<SharedVectorType> m_Array;
+  mutable FlatStorage m_FlatStorage;
+  mutable std::atomic_bool m_IsFlat = {false};
+  mutable std::mutex m_ExpandMutex;
   bool m_IsAllocated;
   value_type m_InitValue;
 };
@@ -31,9 +31,11 @@ std::vector<DataPath> getImportPaths(const DataStructure& importStructure, const
 
 namespace complex
 {
-ImportH5ObjectPathsAction::ImportH5ObjectPathsAction(const std::filesystem::path& importFile, const PathsType& paths)
+ImportH5ObjectPathsAction::ImportH5ObjectPathsAction(const std::filesystem::path& importFile, const PathsType& paths, const SubvolumeType& subvolume, bool lazyLoad)
 : m_H5FilePath(importFile)
 , m_Paths(paths)
+, m_Subvolume(subvolume)
+, m_LazyLoad(lazyLoad)
 {
   if(m_Paths.has_value())
   {
@@ -48,7 +50,19 @@ Result<> ImportH5ObjectPathsAction::apply(DataStructure& dataStructure, Mode mod
   bool preflighting = (mode == Mode::Preflight);
 
   H5::FileReader fileReader(m_H5FilePath);
-  Result<DataStructure> dataStructureResult = DREAM3D::ImportDataStructureFromFile(fileReader, preflighting);
+  Result<DataStructure> dataStructureResult;
+  if(m_LazyLoad && !preflighting)
+  {
+    dataStructureResult = DREAM3D::ImportLazyDataStructureFromFile(fileReader, m_Subvolume);
+  }
+  else if(m_Subvolume.has_value())
+  {
+    dataStructureResult = DREAM3D::ImportDataStructureFromFile(fileReader, *m_Subvolume, preflighting);
+  }
+  else
+  {
+    dataStructureResult = DREAM3D::ImportDataStructureFromFile(fileReader, preflighting);
+  }
   if(dataStructureResult.invalid())
   {
     return ConvertResult(std::move(dataStructureResult));
@@ -5,6 +5,7 @@
 
 #include "complex/DataStructure/DataPath.hpp"
 #include "complex/Filter/Output.hpp"
+#include "complex/Utilities/Parsing/HDF5/H5DataStructureReader.hpp"
 #include "complex/Utilities/Parsing/HDF5/H5FileReader.hpp"
 
 namespace complex
@@ -16,10 +17,21 @@ class COMPLEX_EXPORT ImportH5ObjectPathsAction : public IDataAction
 {
 public:
   using PathsType = std::optional<std::vector<DataPath>>;
+  using SubvolumeType = std::optional<H5::DataStructureReader::ImageSubvolume>;
 
   ImportH5ObjectPathsAction() = delete;
 
-  ImportH5ObjectPathsAction(const std::filesystem::path& importFile, const PathsType& paths);
+  /**
+   * @brief Constructs an action that imports the specified paths from the
+   * target file. If a subvolume is provided, every ImageGeom is cropped to it
+   * and only the selected voxels of its cell arrays are read. If lazyLoad is
+   * true, DataArray values are only read from the file when first accessed.
+   * @param importFile
+   * @param paths
+   * @param subvolume = std::nullopt
+   * @param lazyLoad = false
+   */
+  ImportH5ObjectPathsAction(const std::filesystem::path& importFile, const PathsType& paths, const SubvolumeType& subvolume = std::nullopt, bool lazyLoad = false);
 
   ~ImportH5ObjectPathsAction() noexcept override;
 
@@ -40,5 +52,7 @@ public:
 private:
   std::filesystem::path m_H5FilePath;
   PathsType m_Paths;
+  SubvolumeType m_Subvolume;
+  bool m_LazyLoad = false;
 };
 } // namespace complex
@@ -51,10 +51,26 @@ public:
     std::string dataSetPath;
     std::string componentDimensions;
     std::string tupleDimensions;
+    // Optional comma-separated hyperslab selection in dataset dimension order. Empty values read the full dataset.
+    std::string hyperslabStart;
+    std::string hyperslabCount;
+    std::string hyperslabStride;
 
     static inline constexpr StringLiteral k_DatasetPath_Key = "Dataset Path";
     static inline constexpr StringLiteral k_ComponentDimensions_Key = "Component Dimensions";
     static inline constexpr StringLiteral k_TupleDimensions_Key = "Tuple Dimensions";
+    static inline constexpr StringLiteral k_HyperslabStart_Key = "Hyperslab Start";
+    static inline constexpr StringLiteral k_HyperslabCount_Key = "Hyperslab Count";
+    static inline constexpr StringLiteral k_HyperslabStride_Key = "Hyperslab Stride";
+
+    /**
+     * @brief Returns true if any part of the hyperslab selection has been set.
+     * @return bool
+     */
+    bool hasHyperslab() const
+    {
+      return !hyperslabStart.empty() || !hyperslabCount.empty() || !hyperslabStride.empty();
+    }
 
     static Result<DatasetImportInfo> ReadJson(const nlohmann::json& json)
     {
@@ -92,6 +108,21 @@ public:
       }
       data.tupleDimensions = json[k_TupleDimensions_Key.str()];
 
+      // The hyperslab keys are optional so that older pipelines remain valid
+      for(const auto& [key, value] : {std::make_pair(k_HyperslabStart_Key, &data.hyperslabStart), std::make_pair(k_HyperslabCount_Key, &data.hyperslabCount),
+                                       std::make_pair(k_HyperslabStride_Key, &data.hyperslabStride)})
+      {
+        if(!json.contains(key.view()))
+        {
+          continue;
+        }
+        if(!json[key.str()].is_string())
+        {
+          return MakeErrorResult<DatasetImportInfo>(-504, fmt::format("ImportHDF5DatasetParameter ValueType: '{}' value is of type {} and is not a string.", key, json[key.str()].type_name()));
+        }
+        *value = json[key.str()];
+      }
+
       return {data};
     }
 
@@ -101,6 +132,9 @@ public:
       json[k_DatasetPath_Key.str()] = dataSetPath;
       json[k_ComponentDimensions_Key.str()] = componentDimensions;
       json[k_TupleDimensions_Key.str()] = tupleDimensions;
+      json[k_HyperslabStart_Key.str()] = hyperslabStart;
+      json[k_HyperslabCount_Key.str()] = hyperslabCount;
+      json[k_HyperslabStride_Key.str()] = hyperslabStride;
       return json;
     }
   };
@@ -64,6 +64,9 @@ const DataStructure& AbstractPipelineNode::getDataStructure() const
 void AbstractPipelineNode::setDataStructure(const DataStructure& ds)
 {
   m_DataStructure = ds;
+  // Keep the stored DataStructure from changing as later nodes write to the
+  // DataArrays it shares with ds. Values are only copied once written to.
+  m_DataStructure.detachDataStores();
 }
 
 const DataStructure& AbstractPipelineNode::getPreflightStructure() const
@@ -333,6 +333,8 @@ bool Pipeline::executeFrom(index_type index, const std::atomic_bool& shouldCance
 
   auto* node = at(index - 1);
   DataStructure ds = node->getDataStructure();
+  // Writes during execution must not change the previous node's DataStructure
+  ds.detachDataStores();
   return executeFrom(index, ds, shouldCancel);
 }
 
@@ -0,0 +1,214 @@
+#include "BadVoxelFill.hpp"
+
+#include "complex/Utilities/ParallelData3DAlgorithm.hpp"
+#include "complex/Utilities/ParallelDataAlgorithm.hpp"
+
+#include <algorithm>
+#include <array>
+#include <iterator>
+#include <mutex>
+
+using namespace complex;
+
+namespace
+{
+constexpr int32 k_FillCancelledError = -6850;
+
+/**
+ * @brief Face neighbor offsets and bounds checks of a voxel in an image geometry.
+ */
+class VoxelNeighbors
+{
+public:
+  explicit VoxelNeighbors(const SizeVec3& dims)
+  : m_Dims({static_cast<int64>(dims[0]), static_cast<int64>(dims[1]), static_cast<int64>(dims[2])})
+  , m_Offsets({-m_Dims[0] * m_Dims[1], -m_Dims[0], -1, 1, m_Dims[0], m_Dims[0] * m_Dims[1]})
+  {
+  }
+
+  /**
+   * @brief Writes the indices of the neighbors of the voxel to neighbors, using -1
+   * for the neighbors that are outside of the geometry.
+   * @param voxelIndex
+   * @param neighbors
+   */
+  void getNeighbors(int64 voxelIndex, std::array<int64, 6>& neighbors) const
+  {
+    const int64 column = voxelIndex % m_Dims[0];
+    const int64 row = (voxelIndex / m_Dims[0]) % m_Dims[1];
+    const int64 plane = voxelIndex / (m_Dims[0] * m_Dims[1]);
+    const std::array<bool, 6> isValid = {plane > 0, row > 0, column > 0, column < m_Dims[0] - 1, row < m_Dims[1] - 1, plane < m_Dims[2] - 1};
+    for(usize i = 0; i < 6; i++)
+    {
+      neighbors[i] = isValid[i] ? voxelIndex + m_Offsets[i] : -1;
+    }
+  }
+
+private:
+  std::array<int64, 3> m_Dims;
+  std::array<int64, 6> m_Offsets;
+};
+
+/**
+ * @brief Returns the neighbor of a bad voxel whose Feature Id is the most common
+ * among the good neighbors. Returns -1 if there are no good neighbors.
+ */
+int64 FindSourceVoxel(nonstd::span<const int32> featureIds, const VoxelNeighbors& voxelNeighbors, int64 voxelIndex)
+{
+  std::array<int64, 6> neighbors = {};
+  voxelNeighbors.getNeighbors(voxelIndex, neighbors);
+
+  int64 source = -1;
+  int32 most = 0;
+  for(usize i = 0; i < 6; i++)
+  {
+    if(neighbors[i] < 0 || featureIds[neighbors[i]] < 0)
+    {
+      continue;
+    }
+    // Count the occurrences of this feature up to and including this neighbor
+    int32 current = 0;
+    for(usize j = 0; j <= i; j++)
+    {
+      if(neighbors[j] >= 0 && featureIds[neighbors[j]] == featureIds[neighbors[i]])
+      {
+        current++;
+      }
+    }
+    if(current > most)
+    {
+      most = current;
+      source = neighbors[i];
+    }
+  }
+  return source;
+}
+
+/**
+ * @brief Appends the bad voxels in a range of the grid that have at least one
+ * good neighbor to the shared frontier.
+ */
+class FindInitialFrontierImpl
+{
+public:
+  FindInitialFrontierImpl(nonstd::span<const int32> featureIds, const SizeVec3& dims, const VoxelNeighbors& voxelNeighbors, std::vector<int64>& frontier, std::mutex& mutex)
+  : m_FeatureIds(featureIds)
+  , m_Dims(dims)
+  , m_VoxelNeighbors(voxelNeighbors)
+  , m_Frontier(frontier)
+  , m_Mutex(mutex)
+  {
+  }
+
+  void operator()(const ComplexRange3D& range) const
+  {
+    std::vector<int64> frontier;
+    for(usize z = range[4]; z < range[5]; z++)
+    {
+      for(usize y = range[2]; y < range[3]; y++)
+      {
+        for(usize x = range[0]; x < range[1]; x++)
+        {
+          const auto voxelIndex = static_cast<int64>((z * m_Dims[1] + y) * m_Dims[0] + x);
+          if(m_FeatureIds[voxelIndex] < 0 && FindSourceVoxel(m_FeatureIds, m_VoxelNeighbors, voxelIndex) >= 0)
+          {
+            frontier.push_back(voxelIndex);
+          }
+        }
+      }
+    }
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Frontier.insert(m_Frontier.end(), frontier.cbegin(), frontier.cend());
+  }
+
+private:
+  nonstd::span<const int32> m_FeatureIds;
+  SizeVec3 m_Dims;
+  const VoxelNeighbors& m_VoxelNeighbors;
+  std::vector<int64>& m_Frontier;
+  std::mutex& m_Mutex;
+};
+} // namespace
+
+// -----------------------------------------------------------------------------
+Result<> complex::FillBadVoxels(Int32Array& featureIdsArray, const SizeVec3& dims, const std::vector<IDataArray*>& voxelArrays, const std::atomic_bool& shouldCancel)
+{
+  auto featureIds = featureIdsArray.createSpan();
+  const VoxelNeighbors voxelNeighbors(dims);
+
+  // The Feature Ids are assigned directly and must not be copied a second time
+  std::vector<IDataArray*> copiedArrays;
+  std::copy_if(voxelArrays.cbegin(), voxelArrays.cend(), std::back_inserter(copiedArrays), [&featureIdsArray](const IDataArray* voxelArray) { return voxelArray != &featureIdsArray; });
+
+  std::vector<int64> frontier;
+  std::mutex mutex;
+  ParallelData3DAlgorithm frontierAlg;
+  frontierAlg.setRange(dims[0], dims[1], dims[2]);
+  frontierAlg.execute(FindInitialFrontierImpl(featureIds, dims, voxelNeighbors, frontier, mutex));
+  std::sort(frontier.begin(), frontier.end());
+
+  std::vector<int64> sources;
+  std::vector<int64> nextFrontier;
+  while(!frontier.empty())
+  {
+    if(shouldCancel)
+    {
+      return MakeErrorResult(k_FillCancelledError, "Filling the bad voxels was cancelled");
+    }
+
+    // All sources are chosen before any voxel changes so that each pass only sees the previous passes
+    sources.resize(frontier.size());
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(0, frontier.size());
+    dataAlg.execute([&](const ComplexRange& range) {
+      for(usize i = range.min(); i < range.max(); i++)
+      {
+        sources[i] = FindSourceVoxel(featureIds, voxelNeighbors, frontier[i]);
+      }
+    });
+
+    // The sources are good voxels, so no voxel is read and written in the same pass
+    dataAlg.execute([&](const ComplexRange& range) {
+      for(usize i = range.min(); i < range.max(); i++)
+      {
+        if(sources[i] < 0)
+        {
+          continue;
+        }
+        featureIds[frontier[i]] = featureIds[sources[i]];
+        for(IDataArray* voxelArray : copiedArrays)
+        {
+          voxelArray->copyTuple(sources[i], frontier[i]);
+        }
+      }
+    });
+
+    // Only the bad neighbors of the voxels that were just filled can be filled in the next pass
+    nextFrontier.clear();
+    dataAlg.execute([&](const ComplexRange& range) {
+      std::vector<int64> localFrontier;
+      std::array<int64, 6> neighbors = {};
+      for(usize i = range.min(); i < range.max(); i++)
+      {
+        if(sources[i] < 0)
+        {
+          continue;
+        }
+        voxelNeighbors.getNeighbors(frontier[i], neighbors);
+        for(int64 neighbor : neighbors)
+        {
+          if(neighbor >= 0 && featureIds[neighbor] < 0)
+          {
+            localFrontier.push_back(neighbor);
+          }
+        }
+      }
+      std::lock_guard<std::mutex> lock(mutex);
+      nextFrontier.insert(nextFrontier.end(), localFrontier.cbegin(), localFrontier.cend());
+    });
+    std::sort(nextFrontier.begin(), nextFrontier.end());
+    nextFrontier.erase(std::unique(nextFrontier.begin(), nextFrontier.end()), nextFrontier.end());
+    frontier.swap(nextFrontier);
+  }
+  return {};
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "complex/Common/Array.hpp"
+#include "complex/Common/Result.hpp"
+#include "complex/DataStructure/DataArray.hpp"
+#include "complex/DataStructure/IDataArray.hpp"
+#include "complex/complex_export.hpp"
+
+#include <atomic>
+#include <vector>
+
+namespace complex
+{
+/**
+ * @brief Assigns every voxel with a negative Feature Id to the most common
+ * non-negative feature among its six face neighbors and copies the tuple of that
+ * neighbor into each of the voxel arrays. Voxels are filled from the outside of
+ * each bad region inwards, one layer per pass, and ties go to the first neighbor
+ * in -Z, -Y, -X, +X, +Y, +Z order that reached the highest count.
+ *
+ * Only the bad voxels next to the voxels filled by the previous pass are visited
+ * again, so each pass costs time proportional to the voxels it changes rather than
+ * to the whole volume. Each pass is processed in parallel. Bad regions that do not
+ * touch any good voxel are left unchanged.
+ * @param featureIdsArray The Feature Ids, which are updated along with the voxel arrays
+ * @param dims The dimensions of the image geometry
+ * @param voxelArrays The cell arrays to copy the tuples of. May contain the Feature Ids.
+ * @param shouldCancel Checked before each pass
+ * @return An error if the fill was cancelled before every pass ran. The voxels filled
+ * by the completed passes keep their new values.
+ */
+COMPLEX_EXPORT Result<> FillBadVoxels(Int32Array& featureIdsArray, const SizeVec3& dims, const std::vector<IDataArray*>& voxelArrays, const std::atomic_bool& shouldCancel);
+} // namespace complex
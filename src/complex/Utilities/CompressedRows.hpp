@@ -0,0 +1,160 @@
+#pragma once
+
+#include "complex/Common/Types.hpp"
+#include "complex/Utilities/ParallelDataAlgorithm.hpp"
+
+#include <nonstd/span.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <utility>
+#include <vector>
+
+namespace complex
+{
+namespace CompressedRows
+{
+/**
+ * @brief Counts the entries of every row in parallel. forEachEntry(source, emit) is
+ * called once for each source in [0, numSources) and calls emit(row, value) for each
+ * entry the source adds to a row. It is called from several threads.
+ * @tparam ForEachEntryT void(usize, EmitT&&)
+ * @param numSources
+ * @param numRows
+ * @param forEachEntry
+ * @return std::vector<usize> The number of entries of each row
+ */
+template <typename ForEachEntryT>
+std::vector<usize> CountRowSizes(usize numSources, usize numRows, ForEachEntryT&& forEachEntry)
+{
+  std::vector<std::atomic<usize>> counts(numRows);
+  for(auto& count : counts)
+  {
+    count.store(0, std::memory_order_relaxed);
+  }
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, numSources);
+  dataAlg.execute([&](const ComplexRange& range) {
+    for(usize source = range.min(); source < range.max(); source++)
+    {
+      forEachEntry(source, [&counts](usize row, const auto&) { counts[row].fetch_add(1, std::memory_order_relaxed); });
+    }
+  });
+
+  std::vector<usize> rowSizes(numRows);
+  for(usize row = 0; row < numRows; row++)
+  {
+    rowSizes[row] = counts[row].load(std::memory_order_relaxed);
+  }
+  return rowSizes;
+}
+
+/**
+ * @brief Writes the entries of every row into the storage of that row in parallel and
+ * then sorts each row, so the result does not depend on the order the threads placed
+ * the entries in. forEachEntry must emit the same entries as it did for CountRowSizes().
+ * @tparam T
+ * @tparam RowPointerT T*(usize) Returns the storage of a row, which holds rowSizes[row] values
+ * @tparam ForEachEntryT void(usize, EmitT&&)
+ * @param numSources
+ * @param rowSizes
+ * @param rowPointer
+ * @param forEachEntry
+ */
+template <typename T, typename RowPointerT, typename ForEachEntryT>
+void FillRows(usize numSources, const std::vector<usize>& rowSizes, RowPointerT&& rowPointer, ForEachEntryT&& forEachEntry)
+{
+  const usize numRows = rowSizes.size();
+  std::vector<std::atomic<usize>> cursors(numRows);
+  for(auto& cursor : cursors)
+  {
+    cursor.store(0, std::memory_order_relaxed);
+  }
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, numSources);
+  dataAlg.execute([&](const ComplexRange& range) {
+    for(usize source = range.min(); source < range.max(); source++)
+    {
+      forEachEntry(source, [&](usize row, const auto& value) { rowPointer(row)[cursors[row].fetch_add(1, std::memory_order_relaxed)] = static_cast<T>(value); });
+    }
+  });
+
+  dataAlg.setRange(0, numRows);
+  dataAlg.execute([&](const ComplexRange& range) {
+    for(usize row = range.min(); row < range.max(); row++)
+    {
+      T* values = rowPointer(row);
+      std::sort(values, values + rowSizes[row]);
+    }
+  });
+}
+
+/**
+ * @class Table
+ * @brief Rows of values stored one after the other in a single buffer, with the
+ * offset of each row into the buffer.
+ */
+template <typename T>
+class Table
+{
+public:
+  Table() = default;
+
+  Table(std::vector<usize> offsets, std::vector<T> values)
+  : m_Offsets(std::move(offsets))
+  , m_Values(std::move(values))
+  {
+  }
+
+  /**
+   * @brief Returns the number of rows.
+   * @return usize
+   */
+  usize getNumberOfRows() const
+  {
+    return m_Offsets.empty() ? 0 : m_Offsets.size() - 1;
+  }
+
+  /**
+   * @brief Returns the values of the row in increasing order.
+   * @param row
+   * @return nonstd::span<const T>
+   */
+  nonstd::span<const T> getRow(usize row) const
+  {
+    return {m_Values.data() + m_Offsets[row], m_Offsets[row + 1] - m_Offsets[row]};
+  }
+
+private:
+  std::vector<usize> m_Offsets;
+  std::vector<T> m_Values;
+};
+
+/**
+ * @brief Groups the entries emitted by every source into rows: the entries of each
+ * row are counted, the counts are prefix summed into row offsets and the entries are
+ * then scattered into their rows and sorted, all in parallel.
+ * @tparam T
+ * @tparam ForEachEntryT void(usize, EmitT&&) See CountRowSizes()
+ * @param numSources
+ * @param numRows
+ * @param forEachEntry Called twice for every source and must emit the same entries both times
+ * @return Table<T>
+ */
+template <typename T, typename ForEachEntryT>
+Table<T> Build(usize numSources, usize numRows, ForEachEntryT&& forEachEntry)
+{
+  const std::vector<usize> rowSizes = CountRowSizes(numSources, numRows, forEachEntry);
+  std::vector<usize> offsets(numRows + 1, 0);
+  for(usize row = 0; row < numRows; row++)
+  {
+    offsets[row + 1] = offsets[row] + rowSizes[row];
+  }
+
+  std::vector<T> values(offsets.back());
+  auto rowPointer = [&values, &offsets](usize row) { return values.data() + offsets[row]; };
+  FillRows<T>(numSources, rowSizes, rowPointer, forEachEntry);
+  return Table<T>(std::move(offsets), std::move(values));
+}
+} // namespace CompressedRows
+} // namespace complex
@@ -0,0 +1,341 @@
+#include "ConnectedComponents.hpp"
+
+#include "complex/Utilities/ParallelDataAlgorithm.hpp"
+
+#include <fmt/core.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <limits>
+#include <stdexcept>
+
+using namespace complex;
+
+namespace
+{
+constexpr usize k_MinVoxelsPerRange = 1 << 16;
+
+/**
+ * @brief The offset of a neighbor that comes before a voxel in scan order.
+ */
+struct BackwardNeighbor
+{
+  int64 dx = 0;
+  int64 dy = 0;
+  int64 dz = 0;
+  int64 offset = 0;
+};
+
+// -----------------------------------------------------------------------------
+std::vector<BackwardNeighbor> CreateBackwardNeighbors(const SizeVec3& dims, ConnectedComponents::Connectivity connectivity)
+{
+  int64 maxNonZero = 1;
+  if(connectivity == ConnectedComponents::Connectivity::FaceEdge)
+  {
+    maxNonZero = 2;
+  }
+  else if(connectivity == ConnectedComponents::Connectivity::FaceEdgeVertex)
+  {
+    maxNonZero = 3;
+  }
+
+  const int64 xDim = static_cast<int64>(dims[0]);
+  const int64 yDim = static_cast<int64>(dims[1]);
+  std::vector<BackwardNeighbor> neighbors;
+  for(int64 dz = -1; dz <= 0; dz++)
+  {
+    for(int64 dy = -1; dy <= 1; dy++)
+    {
+      for(int64 dx = -1; dx <= 1; dx++)
+      {
+        const bool isBackward = dz < 0 || (dz == 0 && (dy < 0 || (dy == 0 && dx < 0)));
+        const int64 numNonZero = std::abs(dx) + std::abs(dy) + std::abs(dz);
+        if(isBackward && numNonZero <= maxNonZero)
+        {
+          neighbors.push_back({dx, dy, dz, dz * xDim * yDim + dy * xDim + dx});
+        }
+      }
+    }
+  }
+  return neighbors;
+}
+
+/**
+ * @brief Returns the root of the voxel's tree, halving the path to it along the way.
+ */
+template <typename IndexT>
+IndexT FindRoot(std::vector<IndexT>& parents, IndexT index)
+{
+  while(parents[index] != index)
+  {
+    parents[index] = parents[parents[index]];
+    index = parents[index];
+  }
+  return index;
+}
+
+/**
+ * @brief Returns the root of the voxel's tree without modifying it so that it can be
+ * used from several threads at once.
+ */
+template <typename IndexT>
+IndexT FindRootConst(const std::vector<IndexT>& parents, IndexT index)
+{
+  while(parents[index] != index)
+  {
+    index = parents[index];
+  }
+  return index;
+}
+
+/**
+ * @brief Joins the trees of two voxels. The larger root is linked to the smaller one so
+ * the root of every tree is the first voxel of its component in scan order.
+ */
+template <typename IndexT>
+void Union(std::vector<IndexT>& parents, IndexT first, IndexT second)
+{
+  first = FindRoot(parents, first);
+  second = FindRoot(parents, second);
+  if(first < second)
+  {
+    parents[second] = first;
+  }
+  else if(second < first)
+  {
+    parents[first] = second;
+  }
+}
+
+/**
+ * @brief Visits the backward neighbors of each voxel in [begin, end) that are inside of
+ * the geometry.
+ */
+template <typename FunctionT>
+void ForEachBackwardNeighbor(const SizeVec3& dims, const std::vector<BackwardNeighbor>& neighbors, usize begin, usize end, FunctionT&& function)
+{
+  const int64 xDim = static_cast<int64>(dims[0]);
+  const int64 yDim = static_cast<int64>(dims[1]);
+  int64 x = static_cast<int64>(begin % dims[0]);
+  int64 y = static_cast<int64>((begin / dims[0]) % dims[1]);
+  int64 z = static_cast<int64>(begin / (dims[0] * dims[1]));
+  for(usize index = begin; index < end; index++)
+  {
+    for(const BackwardNeighbor& neighbor : neighbors)
+    {
+      const int64 neighborX = x + neighbor.dx;
+      const int64 neighborY = y + neighbor.dy;
+      if(neighborX >= 0 && neighborX < xDim && neighborY >= 0 && neighborY < yDim && z + neighbor.dz >= 0)
+      {
+        function(index, static_cast<usize>(static_cast<int64>(index) + neighbor.offset));
+      }
+    }
+    if(++x == xDim)
+    {
+      x = 0;
+      if(++y == yDim)
+      {
+        y = 0;
+        z++;
+      }
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+template <typename IndexT, typename MaskT>
+std::vector<usize> LabelImpl(const SizeVec3& dims, nonstd::span<const MaskT> mask, bool componentValue, ConnectedComponents::Connectivity connectivity, nonstd::span<int32> labels, usize numRanges)
+{
+  const usize numVoxels = mask.size();
+  if(labels.size() != numVoxels || dims[0] * dims[1] * dims[2] != numVoxels)
+  {
+    throw std::runtime_error(fmt::format("ConnectedComponents: The mask ({}) and labels ({}) do not match the dimensions of the geometry", numVoxels, labels.size()));
+  }
+  if(numVoxels == 0)
+  {
+    return {0};
+  }
+
+  const auto isComponent = [mask, componentValue](usize index) { return (mask[index] != 0) == componentValue; };
+  const std::vector<BackwardNeighbor> neighbors = CreateBackwardNeighbors(dims, connectivity);
+
+  // Voxels further than this from the start of a range can only have neighbors in the same range
+  const usize reach = dims[0] * dims[1] + dims[0] + 1;
+  if(numRanges == 0)
+  {
+    numRanges = GetNumRanges(numVoxels, std::max(reach, k_MinVoxelsPerRange));
+  }
+
+  // Each range builds its own union-find forest and then points every voxel directly at its root
+  std::vector<IndexT> parents(numVoxels);
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, numRanges);
+  dataAlg.execute([&](const ComplexRange& ranges) {
+    for(usize range = ranges.min(); range < ranges.max(); range++)
+    {
+      const ComplexRange voxels = GetRange(numVoxels, numRanges, range);
+      const usize begin = voxels.min();
+      const usize end = voxels.max();
+      for(usize index = begin; index < end; index++)
+      {
+        parents[index] = static_cast<IndexT>(index);
+      }
+      ForEachBackwardNeighbor(dims, neighbors, begin, end, [&](usize index, usize neighbor) {
+        if(neighbor >= begin && isComponent(index) && isComponent(neighbor))
+        {
+          Union<IndexT>(parents, static_cast<IndexT>(index), static_cast<IndexT>(neighbor));
+        }
+      });
+      for(usize index = begin; index < end; index++)
+      {
+        parents[index] = parents[parents[index]];
+      }
+    }
+  });
+
+  // Join the components that cross the start of each range. Only the roots of the trees
+  // are relinked, so the forest stays shallow.
+  for(usize range = 1; range < numRanges; range++)
+  {
+    const ComplexRange voxels = GetRange(numVoxels, numRanges, range);
+    const usize begin = voxels.min();
+    const usize end = std::min(begin + reach, voxels.max());
+    ForEachBackwardNeighbor(dims, neighbors, begin, end, [&](usize index, usize neighbor) {
+      if(neighbor < begin && isComponent(index) && isComponent(neighbor))
+      {
+        Union<IndexT>(parents, static_cast<IndexT>(index), static_cast<IndexT>(neighbor));
+      }
+    });
+  }
+
+  // Number the roots in scan order
+  std::vector<usize> rangeLabels(numRanges + 1, 0);
+  dataAlg.execute([&](const ComplexRange& ranges) {
+    for(usize range = ranges.min(); range < ranges.max(); range++)
+    {
+      usize numRoots = 0;
+      const ComplexRange voxels = GetRange(numVoxels, numRanges, range);
+      for(usize index = voxels.min(); index < voxels.max(); index++)
+      {
+        numRoots += (parents[index] == index && isComponent(index)) ? 1 : 0;
+      }
+      rangeLabels[range + 1] = numRoots;
+    }
+  });
+  for(usize range = 0; range < numRanges; range++)
+  {
+    rangeLabels[range + 1] += rangeLabels[range];
+  }
+  const usize numLabels = rangeLabels.back() + 1;
+  if(numLabels - 1 > static_cast<usize>(std::numeric_limits<int32>::max()))
+  {
+    throw std::runtime_error(fmt::format("ConnectedComponents: The number of components ({}) is too large to be labeled", numLabels - 1));
+  }
+
+  dataAlg.execute([&](const ComplexRange& ranges) {
+    for(usize range = ranges.min(); range < ranges.max(); range++)
+    {
+      auto label = static_cast<int32>(rangeLabels[range]);
+      const ComplexRange voxels = GetRange(numVoxels, numRanges, range);
+      for(usize index = voxels.min(); index < voxels.max(); index++)
+      {
+        const bool isRoot = parents[index] == index && isComponent(index);
+        labels[index] = isRoot ? ++label : 0;
+      }
+    }
+  });
+
+  // Every other voxel takes the label of its root. Component sizes are accumulated one run
+  // of equal labels at a time to keep the atomic updates to large components rare.
+  std::vector<std::atomic<usize>> atomicSizes(numLabels);
+  for(auto& size : atomicSizes)
+  {
+    size.store(0, std::memory_order_relaxed);
+  }
+  dataAlg.execute([&](const ComplexRange& ranges) {
+    for(usize range = ranges.min(); range < ranges.max(); range++)
+    {
+      int32 runLabel = 0;
+      usize runLength = 0;
+      const ComplexRange voxels = GetRange(numVoxels, numRanges, range);
+      for(usize index = voxels.min(); index < voxels.max(); index++)
+      {
+        if(isComponent(index) && parents[index] != index)
+        {
+          labels[index] = labels[FindRootConst<IndexT>(parents, static_cast<IndexT>(index))];
+        }
+        if(labels[index] != runLabel)
+        {
+          atomicSizes[runLabel].fetch_add(runLength, std::memory_order_relaxed);
+          runLabel = labels[index];
+          runLength = 0;
+        }
+        runLength++;
+      }
+      atomicSizes[runLabel].fetch_add(runLength, std::memory_order_relaxed);
+    }
+  });
+
+  std::vector<usize> sizes(numLabels);
+  std::transform(atomicSizes.cbegin(), atomicSizes.cend(), sizes.begin(), [](const std::atomic<usize>& size) { return size.load(std::memory_order_relaxed); });
+  return sizes;
+}
+
+// -----------------------------------------------------------------------------
+template <typename MaskT>
+std::vector<usize> LabelMask(const SizeVec3& dims, nonstd::span<const MaskT> mask, bool componentValue, ConnectedComponents::Connectivity connectivity, nonstd::span<int32> labels, usize numRanges)
+{
+  if(mask.size() < static_cast<usize>(std::numeric_limits<uint32>::max()))
+  {
+    return LabelImpl<uint32>(dims, mask, componentValue, connectivity, labels, numRanges);
+  }
+  return LabelImpl<uint64>(dims, mask, componentValue, connectivity, labels, numRanges);
+}
+} // namespace
+
+// -----------------------------------------------------------------------------
+std::vector<usize> ConnectedComponents::Label(const SizeVec3& dims, nonstd::span<const bool> mask, bool componentValue, Connectivity connectivity, nonstd::span<int32> labels, usize numRanges)
+{
+  return LabelMask(dims, mask, componentValue, connectivity, labels, numRanges);
+}
+
+// -----------------------------------------------------------------------------
+std::vector<usize> ConnectedComponents::Label(const SizeVec3& dims, nonstd::span<const uint8> mask, bool componentValue, Connectivity connectivity, nonstd::span<int32> labels, usize numRanges)
+{
+  return LabelMask(dims, mask, componentValue, connectivity, labels, numRanges);
+}
+
+// -----------------------------------------------------------------------------
+std::vector<bool> ConnectedComponents::FindBoundaryLabels(const SizeVec3& dims, nonstd::span<const int32> labels, usize numLabels)
+{
+  std::vector<bool> isBoundary(numLabels, false);
+  if(labels.empty())
+  {
+    return isBoundary;
+  }
+  const usize xDim = dims[0];
+  const usize yDim = dims[1];
+  const usize zDim = dims[2];
+  for(usize z = 0; z < zDim; z++)
+  {
+    const bool isBoundaryPlane = (z == 0 || z == zDim - 1);
+    for(usize y = 0; y < yDim; y++)
+    {
+      const usize rowStart = (z * yDim + y) * xDim;
+      if(isBoundaryPlane || y == 0 || y == yDim - 1)
+      {
+        for(usize x = 0; x < xDim; x++)
+        {
+          isBoundary[labels[rowStart + x]] = true;
+        }
+      }
+      else
+      {
+        isBoundary[labels[rowStart]] = true;
+        isBoundary[labels[rowStart + xDim - 1]] = true;
+      }
+    }
+  }
+  return isBoundary;
+}
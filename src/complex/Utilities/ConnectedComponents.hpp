@@ -0,0 +1,72 @@
+#pragma once
+
+#include "complex/Common/Array.hpp"
+#include "complex/Common/Types.hpp"
+#include "complex/complex_export.hpp"
+
+#include <nonstd/span.hpp>
+
+#include <vector>
+
+namespace complex
+{
+namespace ConnectedComponents
+{
+/**
+ * @brief Which neighbors of a voxel belong to the same component as the voxel.
+ */
+enum class Connectivity : uint8
+{
+  Face = 0,      // 6 neighbors
+  FaceEdge,      // 18 neighbors
+  FaceEdgeVertex // 26 neighbors
+};
+
+/**
+ * @brief Labels the connected components of the voxels of an image geometry whose
+ * mask value equals componentValue. The voxels of each component are given the same
+ * label starting at 1, and components are numbered in the order of their first voxel
+ * so the labels match those of a serial scan. All other voxels are labeled 0.
+ *
+ * The volume is split into contiguous ranges of voxels that are labeled in parallel
+ * with a union-find, and the ranges are then joined along their shared boundaries.
+ *
+ * Throws a runtime_error if there are more components than fit in an int32.
+ * @param dims The dimensions of the image geometry
+ * @param mask One value per voxel
+ * @param componentValue The mask value of the voxels to label
+ * @param connectivity
+ * @param labels Receives the label of each voxel
+ * @param numRanges The number of ranges to split the voxels into, or 0 to choose it from
+ * the number of voxels and hardware threads. The labels do not depend on it.
+ * @return The number of voxels in each component indexed by label. The first value is
+ * the number of voxels that are not part of any component.
+ */
+COMPLEX_EXPORT std::vector<usize> Label(const SizeVec3& dims, nonstd::span<const bool> mask, bool componentValue, Connectivity connectivity, nonstd::span<int32> labels, usize numRanges = 0);
+
+/**
+ * @brief Labels the connected components of the voxels of an image geometry whose
+ * mask value, interpreted as a bool, equals componentValue.
+ * @param dims The dimensions of the image geometry
+ * @param mask One value per voxel
+ * @param componentValue The mask value of the voxels to label
+ * @param connectivity
+ * @param labels Receives the label of each voxel
+ * @param numRanges The number of ranges to split the voxels into, or 0 to choose it from
+ * the number of voxels and hardware threads. The labels do not depend on it.
+ * @return The number of voxels in each component indexed by label. The first value is
+ * the number of voxels that are not part of any component.
+ */
+COMPLEX_EXPORT std::vector<usize> Label(const SizeVec3& dims, nonstd::span<const uint8> mask, bool componentValue, Connectivity connectivity, nonstd::span<int32> labels, usize numRanges = 0);
+
+/**
+ * @brief Returns a flag for each label that is true if any voxel with that label lies
+ * on the outer boundary of the image geometry.
+ * @param dims The dimensions of the image geometry
+ * @param labels The labels returned by Label()
+ * @param numLabels The number of labels including the unlabeled 0
+ * @return std::vector<bool>
+ */
+COMPLEX_EXPORT std::vector<bool> FindBoundaryLabels(const SizeVec3& dims, nonstd::span<const int32> labels, usize numLabels);
+} // namespace ConnectedComponents
+} // namespace complex
@@ -2,10 +2,17 @@
 
 #include "complex/Common/TypesUtility.hpp"
 
+#include <atomic>
+#include <mutex>
+
 using namespace complex;
 
 namespace
 {
+std::atomic<uint64> s_MemoryMappedThreshold = 0;
+std::mutex s_MemoryMappedDirectoryMutex;
+fs::path s_MemoryMappedDirectory;
+
 template <class T>
 Result<> ReplaceArray(DataStructure& dataStructure, const DataPath& dataPath, const std::vector<usize>& tupleShape, IDataAction::Mode mode, const IDataArray& inputDataArray)
 {
@@ -18,6 +25,43 @@ Result<> ReplaceArray(DataStructure& dataStructure, const DataPath& dataPath, co
 
 namespace complex
 {
+//-----------------------------------------------------------------------------
+void SetMemoryMappedThreshold(uint64 numBytes)
+{
+  s_MemoryMappedThreshold = numBytes;
+}
+
+//-----------------------------------------------------------------------------
+uint64 GetMemoryMappedThreshold()
+{
+  return s_MemoryMappedThreshold;
+}
+
+//-----------------------------------------------------------------------------
+void SetMemoryMappedDirectory(const fs::path& directory)
+{
+  std::lock_guard<std::mutex> lock(s_MemoryMappedDirectoryMutex);
+  s_MemoryMappedDirectory = directory;
+}
+
+//-----------------------------------------------------------------------------
+fs::path GetMemoryMappedDirectory()
+{
+  std::lock_guard<std::mutex> lock(s_MemoryMappedDirectoryMutex);
+  if(s_MemoryMappedDirectory.empty())
+  {
+    return fs::temp_directory_path();
+  }
+  return s_MemoryMappedDirectory;
+}
+
+//-----------------------------------------------------------------------------
+bool UseMemoryMappedStore(uint64 numBytes)
+{
+  uint64 threshold = s_MemoryMappedThreshold;
+  return threshold != 0 && numBytes > threshold;
+}
+
 //-----------------------------------------------------------------------------
 Result<> CheckValueConverts(const std::string& value, NumericType numericType)
 {
@@ -5,6 +5,7 @@
 #include "complex/DataStructure/DataStore.hpp"
 #include "complex/DataStructure/EmptyDataStore.hpp"
 #include "complex/DataStructure/IDataStore.hpp"
+#include "complex/DataStructure/MemoryMappedDataStore.hpp"
 #include "complex/DataStructure/NeighborList.hpp"
 #include "complex/Filter/Output.hpp"
 #include "complex/Utilities/TemplateHelpers.hpp"
@@ -273,8 +274,49 @@ Result<> ConditionalReplaceValueInArrayFromString(const std::string& valueAsStr,
  */
 COMPLEX_EXPORT Result<> ConditionalReplaceValueInArray(const std::string& valueAsStr, DataObject& inputDataObject, const IDataArray& conditionalDataArray);
 
+/**
+ * @brief Sets the allocation size in bytes above which CreateDataStore will back
+ * new arrays with a MemoryMappedDataStore instead of an in-memory DataStore.
+ * A value of 0 disables memory-mapped allocations, which is the default.
+ * @param numBytes
+ */
+COMPLEX_EXPORT void SetMemoryMappedThreshold(uint64 numBytes);
+
+/**
+ * @brief Returns the allocation size in bytes above which CreateDataStore will
+ * use a MemoryMappedDataStore. A value of 0 means memory-mapped allocations are disabled.
+ * @return uint64
+ */
+COMPLEX_EXPORT uint64 GetMemoryMappedThreshold();
+
+/**
+ * @brief Sets the directory that MemoryMappedDataStore scratch files are created in.
+ * An empty path resets it to the system temporary directory.
+ * @param directory
+ */
+COMPLEX_EXPORT void SetMemoryMappedDirectory(const fs::path& directory);
+
+/**
+ * @brief Returns the directory that MemoryMappedDataStore scratch files are created in.
+ * Defaults to the system temporary directory.
+ * @return fs::path
+ */
+COMPLEX_EXPORT fs::path GetMemoryMappedDirectory();
+
+/**
+ * @brief Returns true if an allocation of the given number of bytes should be
+ * backed by a MemoryMappedDataStore based on the current threshold.
+ * @param numBytes
+ * @return bool
+ */
+COMPLEX_EXPORT bool UseMemoryMappedStore(uint64 numBytes);
+
 /**
  * @brief Creates a DataStore with the given properties
+ *
+ * In EXECUTE mode, allocations larger than GetMemoryMappedThreshold() are backed
+ * by a MemoryMappedDataStore so that they are paged through the OS page cache
+ * instead of requiring physical memory.
  * @tparam T Primitive Type (int, float, ...)
  * @param tupleShape The Tuple Dimensions
  * @param componentShape The component dimensions
@@ -290,6 +332,12 @@ std::unique_ptr<AbstractDataStore<T>> CreateDataStore(const typename IDataStore:
     return std::make_unique<EmptyDataStore<T>>(tupleShape, componentShape);
   }
   case IDataAction::Mode::Execute: {
+    uint64 numValues = std::accumulate(tupleShape.cbegin(), tupleShape.cend(), static_cast<uint64>(1), std::multiplies<>()) *
+                       std::accumulate(componentShape.cbegin(), componentShape.cend(), static_cast<uint64>(1), std::multiplies<>());
+    if(UseMemoryMappedStore(numValues * sizeof(T)))
+    {
+      return std::make_unique<MemoryMappedDataStore<T>>(tupleShape, componentShape, static_cast<T>(0), GetMemoryMappedDirectory());
+    }
     return std::make_unique<DataStore<T>>(tupleShape, componentShape, static_cast<T>(0));
   }
   default: {
@@ -0,0 +1,409 @@
+#include "FeatureDataTransfer.hpp"
+
+#include "complex/DataStructure/DataArray.hpp"
+#include "complex/Utilities/FilterUtilities.hpp"
+#include "complex/Utilities/ParallelDataAlgorithm.hpp"
+
+#include <fmt/core.h>
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+using namespace complex;
+using namespace complex::FeatureDataTransfer;
+
+namespace
+{
+/**
+ * @brief Copies a tuple. A NumComps of 0 copies numComps values, otherwise the
+ * loop has a fixed length and is unrolled by the compiler.
+ */
+template <usize NumComps, typename T>
+void CopyTuple(const T* source, T* destination, usize numComps)
+{
+  if constexpr(NumComps == 0)
+  {
+    std::copy_n(source, numComps, destination);
+  }
+  else
+  {
+    for(usize comp = 0; comp < NumComps; comp++)
+    {
+      destination[comp] = source[comp];
+    }
+  }
+}
+
+/**
+ * @brief Compares two tuples with the same component count rules as CopyTuple.
+ */
+template <usize NumComps, typename T>
+bool TuplesEqual(const T* lhs, const T* rhs, usize numComps)
+{
+  if constexpr(NumComps == 0)
+  {
+    return std::equal(lhs, lhs + numComps, rhs);
+  }
+  else
+  {
+    for(usize comp = 0; comp < NumComps; comp++)
+    {
+      if(lhs[comp] != rhs[comp])
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+}
+
+/**
+ * @brief Calls func with the component count as a compile time constant for the
+ * common tuple sizes and with 0 for every other size.
+ */
+template <typename FuncT>
+decltype(auto) DispatchNumComps(usize numComps, FuncT&& func)
+{
+  switch(numComps)
+  {
+  case 1:
+    return func(std::integral_constant<usize, 1>{});
+  case 3:
+    return func(std::integral_constant<usize, 3>{});
+  case 4:
+    return func(std::integral_constant<usize, 4>{});
+  case 6:
+    return func(std::integral_constant<usize, 6>{});
+  default:
+    return func(std::integral_constant<usize, 0>{});
+  }
+}
+
+void AtomicMin(std::atomic<usize>& value, usize index)
+{
+  usize current = value.load(std::memory_order_relaxed);
+  while(index < current && !value.compare_exchange_weak(current, index, std::memory_order_relaxed))
+  {
+  }
+}
+
+void AtomicMax(std::atomic<usize>& value, usize index)
+{
+  usize current = value.load(std::memory_order_relaxed);
+  while((current == k_NoElement || index > current) && !value.compare_exchange_weak(current, index, std::memory_order_relaxed))
+  {
+  }
+}
+
+void ValidateArrays(const IDataArray& source, const IDataArray& destination, usize numTuples, const std::string& function)
+{
+  if(source.getDataType() != destination.getDataType() || source.getNumberOfComponents() != destination.getNumberOfComponents())
+  {
+    throw std::runtime_error(fmt::format("{}: The array '{}' does not have the type and number of components of the array '{}'", function, destination.getName(), source.getName()));
+  }
+  if(destination.getNumberOfTuples() != numTuples)
+  {
+    throw std::runtime_error(fmt::format("{}: The array '{}' has {} tuples but {} are required", function, destination.getName(), destination.getNumberOfTuples(), numTuples));
+  }
+}
+
+/**
+ * @brief Throws if any feature id is not a tuple index of a feature array with
+ * numFeatures tuples. The ids are checked once up front so that the gather kernels
+ * can index the feature arrays without a check per element.
+ */
+void ValidateFeatureIds(nonstd::span<const int32> featureIds, usize numFeatures, const std::string& function)
+{
+  std::atomic<usize> firstInvalid = k_NoElement;
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, featureIds.size());
+  dataAlg.execute([&](const ComplexRange& range) {
+    for(usize i = range.min(); i < range.max() && i < firstInvalid.load(std::memory_order_relaxed); i++)
+    {
+      if(featureIds[i] < 0 || static_cast<usize>(featureIds[i]) >= numFeatures)
+      {
+        AtomicMin(firstInvalid, i);
+        return;
+      }
+    }
+  });
+  const usize element = firstInvalid.load();
+  if(element != k_NoElement)
+  {
+    throw std::runtime_error(fmt::format("{}: The feature id {} of element {} is not a tuple index of the feature arrays, which have {} tuples", function, featureIds[element], element, numFeatures));
+  }
+}
+
+/**
+ * @brief Copies the feature tuples of one array for a block of elements. Kernels
+ * over data stores that cannot be accessed as spans must not run in parallel.
+ */
+struct GatherKernel
+{
+  std::function<void(usize, usize)> gather;
+  bool isContiguous = true;
+};
+
+struct CreateGatherKernelFunctor
+{
+  template <typename T>
+  GatherKernel operator()(nonstd::span<const int32> featureIds, const IDataArray& featureArray, IDataArray& elementArray)
+  {
+    const auto& featureStore = dynamic_cast<const DataArray<T>&>(featureArray).getDataStoreRef();
+    auto& elementStore = dynamic_cast<DataArray<T>&>(elementArray).getDataStoreRef();
+    const usize numComps = featureStore.getNumberOfComponents();
+
+    if(!featureStore.isContiguous() || !elementStore.isContiguous())
+    {
+      auto gather = [featureIds, &featureStore, &elementStore, numComps](usize begin, usize end) {
+        for(usize i = begin; i < end; i++)
+        {
+          const usize featureOffset = static_cast<usize>(featureIds[i]) * numComps;
+          for(usize comp = 0; comp < numComps; comp++)
+          {
+            elementStore[i * numComps + comp] = featureStore[featureOffset + comp];
+          }
+        }
+      };
+      return {gather, false};
+    }
+
+    const T* featureValues = featureStore.createSpan().data();
+    T* elementValues = elementStore.createSpan().data();
+    return DispatchNumComps(numComps, [=](auto numCompsConstant) {
+      constexpr usize k_NumComps = decltype(numCompsConstant)::value;
+      const usize stride = k_NumComps == 0 ? numComps : k_NumComps;
+      auto gather = [featureIds, featureValues, elementValues, stride](usize begin, usize end) {
+        for(usize i = begin; i < end; i++)
+        {
+          CopyTuple<k_NumComps>(featureValues + static_cast<usize>(featureIds[i]) * stride, elementValues + i * stride, stride);
+        }
+      };
+      return GatherKernel{gather, true};
+    });
+  }
+};
+
+struct ScatterElementTuplesFunctor
+{
+  template <typename T>
+  void operator()(nonstd::span<const usize> elementIndices, const IDataArray& elementArray, IDataArray& featureArray)
+  {
+    const auto& elementStore = dynamic_cast<const DataArray<T>&>(elementArray).getDataStoreRef();
+    auto& featureStore = dynamic_cast<DataArray<T>&>(featureArray).getDataStoreRef();
+    const usize numComps = elementStore.getNumberOfComponents();
+
+    if(!elementStore.isContiguous() || !featureStore.isContiguous())
+    {
+      for(usize feature = 0; feature < elementIndices.size(); feature++)
+      {
+        const usize elementIndex = elementIndices[feature];
+        for(usize comp = 0; comp < numComps; comp++)
+        {
+          featureStore[feature * numComps + comp] = elementIndex == k_NoElement ? static_cast<T>(0) : elementStore[elementIndex * numComps + comp];
+        }
+      }
+      return;
+    }
+
+    const T* elementValues = elementStore.createSpan().data();
+    T* featureValues = featureStore.createSpan().data();
+    DispatchNumComps(numComps, [&](auto numCompsConstant) {
+      constexpr usize k_NumComps = decltype(numCompsConstant)::value;
+      const usize stride = k_NumComps == 0 ? numComps : k_NumComps;
+      ParallelDataAlgorithm dataAlg;
+      dataAlg.setRange(0, elementIndices.size());
+      dataAlg.execute([&](const ComplexRange& range) {
+        for(usize feature = range.min(); feature < range.max(); feature++)
+        {
+          const usize elementIndex = elementIndices[feature];
+          if(elementIndex == k_NoElement)
+          {
+            std::fill_n(featureValues + feature * stride, stride, static_cast<T>(0));
+          }
+          else
+          {
+            CopyTuple<k_NumComps>(elementValues + elementIndex * stride, featureValues + feature * stride, stride);
+          }
+        }
+      });
+    });
+  }
+};
+
+/**
+ * @brief Each range stops at its first mismatched element, or as soon as another
+ * range has found an earlier one.
+ */
+struct FindFirstMismatchedElementFunctor
+{
+  template <typename T>
+  usize operator()(nonstd::span<const int32> featureIds, nonstd::span<const usize> firstElements, const IDataArray& elementArray)
+  {
+    const auto& elementStore = dynamic_cast<const DataArray<T>&>(elementArray).getDataStoreRef();
+    const usize numComps = elementStore.getNumberOfComponents();
+    const auto findFirstElement = [featureIds, firstElements](usize i) {
+      const int32 featureId = featureIds[i];
+      return featureId < 0 || static_cast<usize>(featureId) >= firstElements.size() ? k_NoElement : firstElements[featureId];
+    };
+
+    if(!elementStore.isContiguous())
+    {
+      for(usize i = 0; i < featureIds.size(); i++)
+      {
+        const usize firstElement = findFirstElement(i);
+        for(usize comp = 0; firstElement != k_NoElement && comp < numComps; comp++)
+        {
+          if(elementStore[i * numComps + comp] != elementStore[firstElement * numComps + comp])
+          {
+            return i;
+          }
+        }
+      }
+      return k_NoElement;
+    }
+
+    const T* elementValues = elementStore.createSpan().data();
+    std::atomic<usize> firstMismatch = k_NoElement;
+    DispatchNumComps(numComps, [&](auto numCompsConstant) {
+      constexpr usize k_NumComps = decltype(numCompsConstant)::value;
+      const usize stride = k_NumComps == 0 ? numComps : k_NumComps;
+      ParallelDataAlgorithm dataAlg;
+      dataAlg.setRange(0, featureIds.size());
+      dataAlg.execute([&](const ComplexRange& range) {
+        for(usize i = range.min(); i < range.max() && i < firstMismatch.load(std::memory_order_relaxed); i++)
+        {
+          const usize firstElement = findFirstElement(i);
+          if(firstElement != k_NoElement && !TuplesEqual<k_NumComps>(elementValues + i * stride, elementValues + firstElement * stride, stride))
+          {
+            AtomicMin(firstMismatch, i);
+            return;
+          }
+        }
+      });
+    });
+    return firstMismatch.load();
+  }
+};
+} // namespace
+
+namespace complex
+{
+namespace FeatureDataTransfer
+{
+// -----------------------------------------------------------------------------
+void GatherFeatureTuples(nonstd::span<const int32> featureIds, const IDataArray& featureArray, IDataArray& elementArray)
+{
+  GatherFeatureTuples(featureIds, std::vector<const IDataArray*>{&featureArray}, std::vector<IDataArray*>{&elementArray});
+}
+
+// -----------------------------------------------------------------------------
+void GatherFeatureTuples(nonstd::span<const int32> featureIds, const std::vector<const IDataArray*>& featureArrays, const std::vector<IDataArray*>& elementArrays)
+{
+  if(featureArrays.size() != elementArrays.size())
+  {
+    throw std::runtime_error(fmt::format("GatherFeatureTuples: {} Feature arrays were given for {} Element arrays", featureArrays.size(), elementArrays.size()));
+  }
+
+  if(featureArrays.empty())
+  {
+    return;
+  }
+
+  usize numFeatures = std::numeric_limits<usize>::max();
+  for(usize i = 0; i < featureArrays.size(); i++)
+  {
+    ValidateArrays(*featureArrays[i], *elementArrays[i], featureIds.size(), "GatherFeatureTuples");
+    numFeatures = std::min(numFeatures, featureArrays[i]->getNumberOfTuples());
+  }
+  ValidateFeatureIds(featureIds, numFeatures, "GatherFeatureTuples");
+
+  std::vector<GatherKernel> kernels;
+  kernels.reserve(featureArrays.size());
+  bool isContiguous = true;
+  for(usize i = 0; i < featureArrays.size(); i++)
+  {
+    kernels.push_back(ExecuteDataFunction(CreateGatherKernelFunctor{}, featureArrays[i]->getDataType(), featureIds, *featureArrays[i], *elementArrays[i]));
+    isContiguous = isContiguous && kernels.back().isContiguous;
+  }
+
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, featureIds.size());
+  dataAlg.setParallelizationEnabled(isContiguous);
+  dataAlg.execute([&](const ComplexRange& range) {
+    for(usize blockBegin = range.min(); blockBegin < range.max(); blockBegin += k_ElementsPerBlock)
+    {
+      const usize blockEnd = std::min(blockBegin + k_ElementsPerBlock, range.max());
+      for(const auto& kernel : kernels)
+      {
+        kernel.gather(blockBegin, blockEnd);
+      }
+    }
+  });
+}
+
+// -----------------------------------------------------------------------------
+FeatureElements FindFeatureElements(nonstd::span<const int32> featureIds, usize numFeatures)
+{
+  std::vector<std::atomic<usize>> firstElements(numFeatures);
+  std::vector<std::atomic<usize>> lastElements(numFeatures);
+  for(usize feature = 0; feature < numFeatures; feature++)
+  {
+    firstElements[feature].store(k_NoElement, std::memory_order_relaxed);
+    lastElements[feature].store(k_NoElement, std::memory_order_relaxed);
+  }
+
+  // Elements of a feature usually come in runs, so the bounds are only updated once per run
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, featureIds.size());
+  dataAlg.execute([&](const ComplexRange& range) {
+    usize runBegin = range.min();
+    for(usize i = range.min(); i < range.max(); i++)
+    {
+      if(i + 1 < range.max() && featureIds[i + 1] == featureIds[i])
+      {
+        continue;
+      }
+      const int32 featureId = featureIds[i];
+      if(featureId >= 0 && static_cast<usize>(featureId) < numFeatures)
+      {
+        AtomicMin(firstElements[featureId], runBegin);
+        AtomicMax(lastElements[featureId], i);
+      }
+      runBegin = i + 1;
+    }
+  });
+
+  FeatureElements featureElements;
+  featureElements.first.resize(numFeatures);
+  featureElements.last.resize(numFeatures);
+  for(usize feature = 0; feature < numFeatures; feature++)
+  {
+    featureElements.first[feature] = firstElements[feature].load(std::memory_order_relaxed);
+    featureElements.last[feature] = lastElements[feature].load(std::memory_order_relaxed);
+  }
+  return featureElements;
+}
+
+// -----------------------------------------------------------------------------
+void ScatterElementTuples(nonstd::span<const usize> elementIndices, const IDataArray& elementArray, IDataArray& featureArray)
+{
+  ValidateArrays(elementArray, featureArray, elementIndices.size(), "ScatterElementTuples");
+  ExecuteDataFunction(ScatterElementTuplesFunctor{}, elementArray.getDataType(), elementIndices, elementArray, featureArray);
+}
+
+// -----------------------------------------------------------------------------
+usize FindFirstMismatchedElement(nonstd::span<const int32> featureIds, nonstd::span<const usize> firstElements, const IDataArray& elementArray)
+{
+  if(elementArray.getNumberOfTuples() != featureIds.size())
+  {
+    throw std::runtime_error(fmt::format("FindFirstMismatchedElement: The array '{}' has {} tuples but {} are required", elementArray.getName(), elementArray.getNumberOfTuples(), featureIds.size()));
+  }
+  return ExecuteDataFunction(FindFirstMismatchedElementFunctor{}, elementArray.getDataType(), featureIds, firstElements, elementArray);
+}
+} // namespace FeatureDataTransfer
+} // namespace complex
@@ -0,0 +1,96 @@
+#pragma once
+
+#include "complex/Common/Types.hpp"
+#include "complex/complex_export.hpp"
+
+#include <nonstd/span.hpp>
+
+#include <limits>
+#include <vector>
+
+namespace complex
+{
+class IDataArray;
+
+namespace FeatureDataTransfer
+{
+/**
+ * @brief The element index of a feature that no element belongs to.
+ */
+inline constexpr usize k_NoElement = std::numeric_limits<usize>::max();
+
+/**
+ * @brief The batched gather walks the feature ids in blocks of this many elements
+ * and copies every array for a block before moving on, so each block of feature ids
+ * is read from memory once.
+ */
+inline constexpr usize k_ElementsPerBlock = 4096;
+
+/**
+ * @brief The first and last element of every feature.
+ */
+struct FeatureElements
+{
+  std::vector<usize> first;
+  std::vector<usize> last;
+};
+
+/**
+ * @brief Copies the tuple of each element's feature into the element array in
+ * parallel. Tuples of 1, 3, 4 and 6 components are copied with a component count
+ * known at compile time.
+ *
+ * Throws a runtime_error if the arrays do not have the same type and number of
+ * components, the element array does not have a tuple per feature id or a feature
+ * id is not a tuple index of the feature array. Nothing is copied in that case.
+ * @param featureIds
+ * @param featureArray
+ * @param elementArray
+ */
+COMPLEX_EXPORT void GatherFeatureTuples(nonstd::span<const int32> featureIds, const IDataArray& featureArray, IDataArray& elementArray);
+
+/**
+ * @brief Copies the feature tuples of each feature array into the element array at
+ * the same position in a single pass over the feature ids.
+ *
+ * Throws a runtime_error if the lists differ in size or any pair of arrays does not
+ * match as described for the single array overload.
+ * @param featureIds
+ * @param featureArrays
+ * @param elementArrays
+ */
+COMPLEX_EXPORT void GatherFeatureTuples(nonstd::span<const int32> featureIds, const std::vector<const IDataArray*>& featureArrays, const std::vector<IDataArray*>& elementArrays);
+
+/**
+ * @brief Finds the first and last element of each of the numFeatures features in
+ * parallel. Features without elements are set to k_NoElement and feature ids
+ * outside of [0, numFeatures) are ignored.
+ * @param featureIds
+ * @param numFeatures
+ * @return FeatureElements
+ */
+COMPLEX_EXPORT FeatureElements FindFeatureElements(nonstd::span<const int32> featureIds, usize numFeatures);
+
+/**
+ * @brief Copies the element tuple at elementIndices[feature] into each feature tuple
+ * of the feature array in parallel. Features whose index is k_NoElement are set to 0.
+ *
+ * Throws a runtime_error if the arrays do not have the same type and number of
+ * components or the feature array does not have a tuple per element index.
+ * @param elementIndices
+ * @param elementArray
+ * @param featureArray
+ */
+COMPLEX_EXPORT void ScatterElementTuples(nonstd::span<const usize> elementIndices, const IDataArray& elementArray, IDataArray& featureArray);
+
+/**
+ * @brief Returns the first element whose tuple differs from the tuple of the first
+ * element of its feature, or k_NoElement if every feature has a single value.
+ * @param featureIds
+ * @param firstElements
+ * @param elementArray
+ * @return usize
+ */
+COMPLEX_EXPORT usize FindFirstMismatchedElement(nonstd::span<const int32> featureIds, nonstd::span<const usize> firstElements, const IDataArray& elementArray);
+} // namespace FeatureDataTransfer
+} // namespace complex
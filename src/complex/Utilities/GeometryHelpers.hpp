@@ -2,10 +2,23 @@
 
 #include "Eigen/Dense"
 
+#include <fmt/core.h>
+
 #include "complex/Common/Array.hpp"
 #include "complex/DataStructure/DataArray.hpp"
 #include "complex/DataStructure/DataStore.hpp"
+#include "complex/DataStructure/DynamicListArray.hpp"
+#include "complex/DataStructure/Geometry/AbstractGeometry.hpp"
+#include "complex/Utilities/CompressedRows.hpp"
 #include "complex/Utilities/Math/GeometryMath.hpp"
+#include "complex/Utilities/ParallelDataAlgorithm.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
 
 namespace complex
 {
@@ -16,7 +29,10 @@ using ErrorCode = int32;
 namespace Connectivity
 {
 /**
- * @brief
+ * @brief Fills the dynamic list with the elements that use each vertex. The uses of
+ * every vertex are counted in parallel, the lists are allocated from the counts and
+ * the element ids are then placed in parallel with CompressedRows. The elements of
+ * each list are stored in increasing order.
  * @tparam T
  * @tparam K
  * @param elemList
@@ -26,48 +42,30 @@ namespace Connectivity
 template <typename T, typename K>
 void FindElementsContainingVert(const DataArray<K>* elemList, DynamicListArray<T, K>* dynamicList, usize numVerts)
 {
-  DataStructure* dataStructure = dynamicList->getDataStructure();
-  auto parentId = dynamicList->getParentIds().front();
-
-  auto& elems = *elemList;
   const usize numElems = elemList->getNumberOfTuples();
   const usize numVertsPerElem = elemList->getNumberOfComponents();
+  const nonstd::span<const K> elems = elemList->createSpan().first(numElems * numVertsPerElem);
 
-  // Allocate the basic structures
-  std::vector<T> linkCount(numVerts, 0);
-
-  // Fill out lists with number of references to cells
-  auto dataStore = std::make_unique<DataStore<K>>(numVerts, static_cast<K>(0));
-  DataArray<K>* linkLocPtr = DataArray<K>::Create(*dataStructure, "_INTERNAL_USE_ONLY_Vertices", std::move(dataStore), parentId);
-  auto linkLoc = *linkLocPtr;
-  K* verts = nullptr;
-
-  // vtkPolyData *pdata = static_cast<vtkPolyData *>(data);
-  // Traverse data to determine number of uses of each point
-  for(usize elemId = 0; elemId < numElems; elemId++)
-  {
-    usize offset = elemId * numVertsPerElem;
+  auto forEachUse = [elems, numVertsPerElem](usize elemId, auto&& emit) {
     for(usize j = 0; j < numVertsPerElem; j++)
     {
-      linkCount[elems[offset + j]]++;
+      emit(elems[elemId * numVertsPerElem + j], elemId);
     }
-  }
+  };
 
-  // Now allocate storage for the links
+  // Count the uses of each point, allocate the links and place the element ids
+  const std::vector<usize> linkCount = CompressedRows::CountRowSizes(numElems, numVerts, forEachUse);
   dynamicList->allocateLists(linkCount);
-
-  for(usize elemId = 0; elemId < numElems; elemId++)
-  {
-    usize offset = elemId * numVertsPerElem;
-    for(usize j = 0; j < numVertsPerElem; j++)
-    {
-      dynamicList->insertCellReference(elems[offset + j], (linkLoc[elems[offset + j]])++, elemId);
-    }
-  }
+  CompressedRows::FillRows<K>(numElems, linkCount, [dynamicList](usize vertId) { return dynamicList->getElementListPointer(vertId); }, forEachUse);
 }
 
 /**
- * @brief
+ * @brief Fills the dynamic list with the neighbors of each element, which are the
+ * elements that share exactly as many vertices with it as two neighbors of this
+ * geometry type share across a face (or an edge or vertex for lower dimensional
+ * elements). The neighbors of every element are counted in one parallel pass and
+ * written in a second one once the lists have been allocated. The neighbors of each
+ * element are stored in increasing order.
  * @tparam T
  * @tparam K
  * @param elemList
@@ -79,13 +77,10 @@ void FindElementsContainingVert(const DataArray<K>* elemList, DynamicListArray<T
 template <typename T, typename K>
 ErrorCode FindElementNeighbors(const DataArray<K>* elemList, const DynamicListArray<T, K>* elemsContainingVert, DynamicListArray<T, K>* dynamicList, AbstractGeometry::Type geometryType)
 {
-  DataStructure* dataStructure = dynamicList->getDataStructure();
-  auto parentId = dynamicList->getParentIds().front();
-  auto& elems = *elemList;
   const usize numElems = elemList->getNumberOfTuples();
   const usize numVertsPerElem = elemList->getNumberOfComponents();
+  const nonstd::span<const K> elems = elemList->createSpan().first(numElems * numVertsPerElem);
   usize numSharedVerts = 0;
-  std::vector<T> linkCount(numElems, 0);
   ErrorCode err = 0;
 
   switch(geometryType)
@@ -125,235 +120,334 @@ ErrorCode FindElementNeighbors(const DataArray<K>* elemList, const DynamicListAr
     return -1;
   }
 
-  dynamicList->allocateLists(linkCount);
-
-  // Allocate an array of bools that we use each iteration so that we don't put duplicates into the array
-  auto visitedDataStore = std::make_unique<DataStore<uint8>>(numElems, 0);
-  DataArray<uint8>* visitedPtr = DataArray<uint8>::Create(*dataStructure, "_INTERNAL_USE_ONLY_Visited", std::move(visitedDataStore), parentId);
-  auto& visited = *visitedPtr;
-
-  // Reuse this vector for each loop. Avoids re-allocating the memory each time through the loop
-  std::vector<K> loop_neighbors(32, 0);
-
-  // Build up the element adjacency list now that we have the element links
-  for(usize t = 0; t < numElems; ++t)
-  {
-    //   qDebug() << "Analyzing Cell " << t << "\n";
-    const usize offset = t * numVertsPerElem;
+  // Calls the function with each neighbor of the element in increasing order. An
+  // element that shares n vertices with the source appears n times in the lists of
+  // the vertices of the source, so sorting the candidates gives the shared counts.
+  const auto forEachNeighbor = [&](usize elemId, std::vector<K>& candidates, auto&& function) {
+    candidates.clear();
     for(usize v = 0; v < numVertsPerElem; ++v)
     {
-      //   qDebug() << " vert " << v << "\n";
-      T nEs = elemsContainingVert->getNumberOfElements(elems[offset + v]);
-      K* vertIdxs = elemsContainingVert->getElementListPointer(elems[offset + v]);
-
-      for(T vt = 0; vt < nEs; ++vt)
+      for(K candidate : elemsContainingVert->getElementListSpan(elems[elemId * numVertsPerElem + v]))
       {
-        if(vertIdxs[vt] == static_cast<K>(t))
-        {
-          continue;
-        } // This is the same element as our "source"
-        if(visited[vertIdxs[vt]])
-        {
-          continue;
-        } // We already added this element so loop again
-        //      qDebug() << "   Comparing Element " << vertIdxs[vt] << "\n";
-        usize vCount = 0;
-        // Loop over all the vertex indices of this element and try to match numSharedVerts of them to the current loop element
-        // If there is numSharedVerts match then that element is a neighbor of the source. If there are more than numVertsPerElem
-        // matches then there is a real problem with the mesh and the program is going to return an error.
-        for(usize i = 0; i < numVertsPerElem; i++)
+        // This is the same element as our "source"
+        if(candidate != static_cast<K>(elemId))
         {
-          for(usize j = 0; j < numVertsPerElem; j++)
-          {
-            if(elems[offset + i] == elems[offset + j])
-            {
-              vCount++;
-            }
-          }
-        }
-
-        // So if our vertex match count is numSharedVerts and we have not visited the element in question then add this element index
-        // into the list of vertex indices as neighbors for the source element.
-        if(vCount == numSharedVerts)
-        {
-          // qDebug() << "       Neighbor: " << vertIdxs[vt] << "\n";
-          // Use the current count of neighbors as the index
-          // into the loop_neighbors vector and place the value of the vertex element at that index
-          loop_neighbors[linkCount[t]] = vertIdxs[vt];
-          linkCount[t]++; // Increment the count for the next time through
-          if(linkCount[t] >= loop_neighbors.size())
-          {
-            loop_neighbors.resize(loop_neighbors.size() + 10);
-          }
-          visited[vertIdxs[vt]] = true; // Set this element as visited so we do NOT add it again
+          candidates.push_back(candidate);
         }
       }
     }
-    // Reset all the visited cell indexs back to false (zero)
-    for(int64 k = 0; k < linkCount[t]; ++k)
+    std::sort(candidates.begin(), candidates.end());
+    for(auto first = candidates.cbegin(); first != candidates.cend();)
     {
-      visited[loop_neighbors[k]] = false;
+      const auto last = std::upper_bound(first, candidates.cend(), *first);
+      if(static_cast<usize>(last - first) == numSharedVerts)
+      {
+        function(*first);
+      }
+      first = last;
     }
-    // Allocate the array storage for the current edge to hold its vertex list
-    dynamicList->setElementList(t, linkCount[t], &(loop_neighbors[0]));
-  }
+  };
+
+  std::vector<usize> linkCount(numElems, 0);
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, numElems);
+  dataAlg.execute([&](const ComplexRange& range) {
+    // Reuse this vector for each element. Avoids re-allocating the memory each time through the loop
+    std::vector<K> candidates;
+    for(usize elemId = range.min(); elemId < range.max(); elemId++)
+    {
+      forEachNeighbor(elemId, candidates, [&](K) { linkCount[elemId]++; });
+    }
+  });
+
+  dynamicList->allocateLists(linkCount);
+
+  dataAlg.execute([&](const ComplexRange& range) {
+    std::vector<K> candidates;
+    for(usize elemId = range.min(); elemId < range.max(); elemId++)
+    {
+      K* neighbors = dynamicList->getElementListPointer(elemId);
+      forEachNeighbor(elemId, candidates, [&](K neighbor) { *neighbors++ = neighbor; });
+    }
+  });
 
   return err;
 }
 
+namespace detail
+{
 /**
- * @brief
- * @tparam T
- * @param tetList
- * @param edgeList
+ * @brief The vertices of an edge or face in increasing order. Keys compare
+ * lexicographically, so sorting them puts equal edges or faces next to each other.
  */
-template <typename T>
-void FindTetEdges(const DataArray<T>* tetList, DataArray<T>* edgeList)
-{
-  const usize numElems = tetList->getNumberOfTuples();
-  const usize numVertsPerTet = tetList->getNumberOfComponents();
-  auto& tets = *tetList;
+template <typename T, usize N>
+using ElementKey = std::array<T, N>;
 
-  std::set<std::pair<T, T>> edgeSet;
+inline constexpr usize k_MinKeysPerRange = 1 << 16;
 
-  for(usize i = 0; i < numElems; i++)
-  {
-    const usize offset = i * numVertsPerTet;
+inline constexpr std::array<std::array<usize, 2>, 6> k_TetEdges = {{{0, 1}, {0, 2}, {1, 2}, {0, 3}, {1, 3}, {2, 3}}};
+inline constexpr std::array<std::array<usize, 2>, 12> k_HexEdges = {{{0, 1}, {1, 2}, {2, 3}, {3, 0}, {0, 4}, {1, 5}, {2, 6}, {3, 7}, {4, 5}, {5, 6}, {6, 7}, {7, 4}}};
+inline constexpr std::array<std::array<usize, 3>, 4> k_TetFaces = {{{0, 1, 2}, {1, 2, 3}, {0, 2, 3}, {0, 1, 3}}};
+inline constexpr std::array<std::array<usize, 4>, 6> k_HexFaces = {{{0, 1, 5, 4}, {1, 2, 6, 5}, {2, 3, 7, 6}, {3, 0, 4, 7}, {0, 1, 2, 3}, {4, 5, 6, 7}}};
 
-    std::vector<T> edge0 = {tets[offset + 0], tets[offset + 1]};
-    std::vector<T> edge1 = {tets[offset + 0], tets[offset + 2]};
-    std::vector<T> edge2 = {tets[offset + 1], tets[offset + 2]};
-    std::vector<T> edge3 = {tets[offset + 0], tets[offset + 3]};
-    std::vector<T> edge4 = {tets[offset + 1], tets[offset + 3]};
-    std::vector<T> edge5 = {tets[offset + 2], tets[offset + 3]};
-    std::list<std::vector<T>> edgeVecList = {edge0, edge1, edge2, edge3, edge4, edge5};
+/**
+ * @brief Fills a flat buffer with keysPerElem keys for every element in parallel.
+ * @param elemList
+ * @param keysPerElem
+ * @param makeKey Returns the unsorted vertices of the given key of an element
+ * @return std::vector<ElementKey<T, N>>
+ */
+template <typename T, usize N, typename FunctionT>
+std::vector<ElementKey<T, N>> CollectKeys(const DataArray<T>* elemList, usize keysPerElem, FunctionT&& makeKey)
+{
+  const usize numElems = elemList->getNumberOfTuples();
+  const usize numVertsPerElem = elemList->getNumberOfComponents();
+  const nonstd::span<const T> elems = elemList->createSpan().first(numElems * numVertsPerElem);
 
-    for(auto&& uEdge : edgeVecList)
+  std::vector<ElementKey<T, N>> keys(numElems * keysPerElem);
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, numElems);
+  dataAlg.execute([&](const ComplexRange& range) {
+    for(usize elemId = range.min(); elemId < range.max(); elemId++)
     {
-      std::sort(uEdge.begin(), uEdge.end());
-      std::pair<T, T> edge = std::make_pair(uEdge[0], uEdge[1]);
-      edgeSet.insert(edge);
+      const T* elem = elems.data() + elemId * numVertsPerElem;
+      for(usize k = 0; k < keysPerElem; k++)
+      {
+        ElementKey<T, N> key = makeKey(elem, k);
+        std::sort(key.begin(), key.end());
+        keys[elemId * keysPerElem + k] = key;
+      }
     }
-  }
-
-  edgeList->getDataStore()->reshapeTuples({edgeSet.size()});
-  auto& uEdges = *edgeList;
-  T index = 0;
+  });
+  return keys;
+}
 
-  for(auto& edge : edgeSet)
-  {
-    uEdges[2 * index] = edge.first;
-    uEdges[2 * index + 1] = edge.second;
-    ++index;
-  }
+/**
+ * @brief Collects the keys whose vertices are listed in the table for every element.
+ */
+template <typename T, usize N, usize M>
+std::vector<ElementKey<T, N>> CollectKeys(const DataArray<T>* elemList, const std::array<std::array<usize, N>, M>& localKeys)
+{
+  return CollectKeys<T, N>(elemList, M, [&localKeys](const T* elem, usize k) {
+    ElementKey<T, N> key;
+    for(usize n = 0; n < N; n++)
+    {
+      key[n] = elem[localKeys[k][n]];
+    }
+    return key;
+  });
 }
 
 /**
- * @brief
- * @tparam T
- * @param hexList
- * @param edge_List
+ * @brief Sorts the keys with a parallel least significant digit radix sort. Only the
+ * bytes needed to hold the largest vertex id are sorted on, so a key costs a
+ * fixed number of linear passes no matter how many keys there are.
+ * @param keys
  */
-template <typename T>
-void FindHexEdges(const DataArray<T>* hexList, DataArray<T>* edge_List)
+template <typename T, usize N>
+void RadixSortKeys(std::vector<ElementKey<T, N>>& keys)
 {
-  const usize numElems = hexList->getNumberOfTuples();
-  const usize numVertsPerHex = hexList->getNumberOfComponents();
+  static_assert(std::is_unsigned_v<T>, "Vertex ids must be unsigned to be radix sorted");
+  using Histogram = std::array<usize, 256>;
 
-  auto& hexas = *hexList;
+  const usize numKeys = keys.size();
+  const usize numRanges = GetNumRanges(numKeys, k_MinKeysPerRange);
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, numRanges);
 
-  std::set<std::pair<T, T>> edgeSet;
+  std::vector<T> rangeMax(numRanges, 0);
+  dataAlg.execute([&](const ComplexRange& ranges) {
+    for(usize range = ranges.min(); range < ranges.max(); range++)
+    {
+      const ComplexRange keyRange = GetRange(numKeys, numRanges, range);
+      for(usize i = keyRange.min(); i < keyRange.max(); i++)
+      {
+        // The vertices of a key are sorted, so the last one is the largest
+        rangeMax[range] = std::max(rangeMax[range], keys[i][N - 1]);
+      }
+    }
+  });
+  usize numBytes = 1;
+  for(T maxValue = *std::max_element(rangeMax.cbegin(), rangeMax.cend()); maxValue > 0xFF; maxValue >>= 8)
+  {
+    numBytes++;
+  }
 
-  for(usize i = 0; i < numElems; i++)
+  std::vector<ElementKey<T, N>> buffer(numKeys);
+  std::vector<Histogram> histograms(numRanges);
+  for(usize component = N; component-- > 0;)
   {
-    const usize offset = i * numVertsPerHex;
+    for(usize byte = 0; byte < numBytes; byte++)
+    {
+      const usize shift = 8 * byte;
+      const auto digit = [component, shift](const ElementKey<T, N>& key) { return static_cast<usize>((key[component] >> shift) & 0xFF); };
 
-    std::vector<T> edge0 = {hexas[offset + 0], hexas[offset + 1]};
-    std::vector<T> edge1 = {hexas[offset + 1], hexas[offset + 2]};
-    std::vector<T> edge2 = {hexas[offset + 2], hexas[offset + 3]};
-    std::vector<T> edge3 = {hexas[offset + 3], hexas[offset + 0]};
+      dataAlg.execute([&](const ComplexRange& ranges) {
+        for(usize range = ranges.min(); range < ranges.max(); range++)
+        {
+          histograms[range].fill(0);
+          const ComplexRange keyRange = GetRange(numKeys, numRanges, range);
+          for(usize i = keyRange.min(); i < keyRange.max(); i++)
+          {
+            histograms[range][digit(keys[i])]++;
+          }
+        }
+      });
 
-    std::vector<T> edge4 = {hexas[offset + 0], hexas[offset + 4]};
-    std::vector<T> edge5 = {hexas[offset + 1], hexas[offset + 5]};
-    std::vector<T> edge6 = {hexas[offset + 2], hexas[offset + 6]};
-    std::vector<T> edge7 = {hexas[offset + 3], hexas[offset + 7]};
+      // Turn the counts into the position where each range writes each digit. A pass
+      // where every key has the same digit would not move anything
+      usize position = 0;
+      bool allSameDigit = false;
+      for(usize value = 0; value < 256; value++)
+      {
+        usize digitCount = 0;
+        for(Histogram& histogram : histograms)
+        {
+          const usize count = histogram[value];
+          histogram[value] = position;
+          position += count;
+          digitCount += count;
+        }
+        allSameDigit = allSameDigit || digitCount == numKeys;
+      }
+      if(allSameDigit)
+      {
+        continue;
+      }
 
-    std::vector<T> edge8 = {hexas[offset + 4], hexas[offset + 5]};
-    std::vector<T> edge9 = {hexas[offset + 5], hexas[offset + 6]};
-    std::vector<T> edge10 = {hexas[offset + 6], hexas[offset + 7]};
-    std::vector<T> edge11 = {hexas[offset + 7], hexas[offset + 4]};
+      dataAlg.execute([&](const ComplexRange& ranges) {
+        for(usize range = ranges.min(); range < ranges.max(); range++)
+        {
+          const ComplexRange keyRange = GetRange(numKeys, numRanges, range);
+          for(usize i = keyRange.min(); i < keyRange.max(); i++)
+          {
+            buffer[histograms[range][digit(keys[i])]++] = keys[i];
+          }
+        }
+      });
+      keys.swap(buffer);
+    }
+  }
+}
 
-    std::list<std::vector<T>> edgeList = {edge0, edge1, edge2, edge3, edge4, edge5, edge6, edge7, edge8, edge9, edge10, edge11};
+/**
+ * @brief Sorts the keys and writes each distinct key once to the output list. When
+ * unsharedOnly is set, only the keys that appear exactly once are written. The keys
+ * are written in increasing order.
+ * @param keys
+ * @param unsharedOnly
+ * @param outputList
+ */
+template <typename T, usize N>
+void WriteUniqueKeys(std::vector<ElementKey<T, N>>& keys, bool unsharedOnly, DataArray<T>* outputList)
+{
+  RadixSortKeys(keys);
 
-    for(auto&& uEdge : edgeList)
+  const usize numKeys = keys.size();
+  const auto isWritten = [&](usize i) {
+    if(i > 0 && keys[i] == keys[i - 1])
     {
-      std::sort(uEdge.begin(), uEdge.end());
-      std::pair<T, T> edge = std::make_pair(uEdge[0], uEdge[1]);
-      edgeSet.insert(edge);
+      return false;
+    }
+    return !unsharedOnly || i + 1 == numKeys || keys[i] != keys[i + 1];
+  };
+
+  // Count the keys each range writes, then write them from the prefix sum of the counts
+  const usize numRanges = GetNumRanges(numKeys, k_MinKeysPerRange);
+  std::vector<usize> rangeOffsets(numRanges + 1, 0);
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, numRanges);
+  dataAlg.execute([&](const ComplexRange& ranges) {
+    for(usize range = ranges.min(); range < ranges.max(); range++)
+    {
+      const ComplexRange keyRange = GetRange(numKeys, numRanges, range);
+      for(usize i = keyRange.min(); i < keyRange.max(); i++)
+      {
+        rangeOffsets[range + 1] += isWritten(i) ? 1 : 0;
+      }
     }
+  });
+  for(usize range = 0; range < numRanges; range++)
+  {
+    rangeOffsets[range + 1] += rangeOffsets[range];
   }
 
-  typename std::set<std::pair<T, T>>::iterator setIter;
-  edge_List->getDataStore()->reshapeTuples({edgeSet.size()});
-  auto& uEdges = *edge_List;
-  T index = 0;
+  outputList->getDataStore()->reshapeTuples({rangeOffsets.back()});
+  const nonstd::span<T> output = outputList->createSpan();
+  dataAlg.execute([&](const ComplexRange& ranges) {
+    for(usize range = ranges.min(); range < ranges.max(); range++)
+    {
+      usize index = rangeOffsets[range];
+      const ComplexRange keyRange = GetRange(numKeys, numRanges, range);
+      for(usize i = keyRange.min(); i < keyRange.max(); i++)
+      {
+        if(isWritten(i))
+        {
+          std::copy(keys[i].cbegin(), keys[i].cend(), output.begin() + N * index);
+          index++;
+        }
+      }
+    }
+  });
+}
 
-  for(auto edge : edgeSet)
-  {
-    uEdges[2 * index] = edge.first;
-    uEdges[2 * index + 1] = edge.second;
-    ++index;
-  }
+/**
+ * @brief Collects the edges of the 2D elements, which connect each vertex to the next
+ * one and the last vertex to the first.
+ */
+template <typename T>
+std::vector<ElementKey<T, 2>> Collect2DElementEdges(const DataArray<T>* elemList)
+{
+  const usize numVertsPerElem = elemList->getNumberOfComponents();
+  return CollectKeys<T, 2>(elemList, numVertsPerElem, [numVertsPerElem](const T* elem, usize j) { return ElementKey<T, 2>{elem[j], elem[(j + 1) % numVertsPerElem]}; });
 }
+} // namespace detail
 
 /**
- * @brief
+ * @brief Finds the unique edges of the tetrahedra. The vertices of every edge are
+ * written in increasing order and the edges are sorted.
  * @tparam T
  * @param tetList
- * @param faceList
+ * @param edgeList
  */
 template <typename T>
-void FindTetFaces(const DataArray<T>* tetList, DataArray<T>* faceList)
+void FindTetEdges(const DataArray<T>* tetList, DataArray<T>* edgeList)
 {
-  auto& tets = *tetList;
-  const usize numElems = tetList->getNumberOfTuples();
-  const usize numVertsPerTet = tetList->getNumberOfComponents();
-
-  std::set<std::tuple<T, T, T>> faceSet;
-
-  for(usize i = 0; i < numElems; i++)
-  {
-    const usize offset = i * numVertsPerTet;
-
-    std::vector<T> tri0 = {tets[offset + 0], tets[offset + 1], tets[offset + 2]};
-    std::vector<T> tri1 = {tets[offset + 1], tets[offset + 2], tets[offset + 3]};
-    std::vector<T> tri2 = {tets[offset + 0], tets[offset + 2], tets[offset + 3]};
-    std::vector<T> tri3 = {tets[offset + 0], tets[offset + 1], tets[offset + 3]};
-    std::list<std::vector<T>> triList = {tri0, tri1, tri2, tri3};
-
-    for(auto&& tri : triList)
-    {
-      std::sort(tri.begin(), tri.end());
-      std::tuple<T, T, T> face = std::make_tuple(tri[0], tri[1], tri[2]);
-      faceSet.insert(face);
-    }
-  }
+  auto keys = detail::CollectKeys<T>(tetList, detail::k_TetEdges);
+  detail::WriteUniqueKeys(keys, false, edgeList);
+}
 
-  faceList->getDataStore()->reshapeTuples({faceSet.size()});
-  auto& uFaces = *faceList;
-  T index = 0;
+/**
+ * @brief Finds the unique edges of the hexahedra. The vertices of every edge are
+ * written in increasing order and the edges are sorted.
+ * @tparam T
+ * @param hexList
+ * @param edge_List
+ */
+template <typename T>
+void FindHexEdges(const DataArray<T>* hexList, DataArray<T>* edge_List)
+{
+  auto keys = detail::CollectKeys<T>(hexList, detail::k_HexEdges);
+  detail::WriteUniqueKeys(keys, false, edge_List);
+}
 
-  for(auto& face : faceSet)
-  {
-    uFaces[3 * index] = std::get<0>(face);
-    uFaces[3 * index + 1] = std::get<1>(face);
-    uFaces[3 * index + 2] = std::get<2>(face);
-    ++index;
-  }
+/**
+ * @brief Finds the unique triangular faces of the tetrahedra. The vertices of every
+ * face are written in increasing order and the faces are sorted.
+ * @tparam T
+ * @param tetList
+ * @param faceList
+ */
+template <typename T>
+void FindTetFaces(const DataArray<T>* tetList, DataArray<T>* faceList)
+{
+  auto keys = detail::CollectKeys<T>(tetList, detail::k_TetFaces);
+  detail::WriteUniqueKeys(keys, false, faceList);
 }
 
 /**
- * @brief
+ * @brief Finds the unique quadrilateral faces of the hexahedra. The vertices of every
+ * face are written in increasing order and the faces are sorted.
  * @tparam T
  * @param hexList
  * @param faceList
@@ -361,49 +455,12 @@ void FindTetFaces(const DataArray<T>* tetList, DataArray<T>* faceList)
 template <typename T>
 void FindHexFaces(const DataArray<T>* hexList, DataArray<T>* faceList)
 {
-  auto& hexas = *hexList;
-  const usize numElems = hexList->getNumberOfTuples();
-  const usize numVertsPerHex = hexList->getNumberOfComponents();
-
-  std::set<std::tuple<T, T, T, T>> faceSet;
-
-  for(usize i = 0; i < numElems; i++)
-  {
-    const usize offset = i * numVertsPerHex;
-
-    std::vector<T> quad0 = {hexas[offset + 0], hexas[offset + 1], hexas[offset + 5], hexas[offset + 4]};
-    std::vector<T> quad1 = {hexas[offset + 1], hexas[offset + 2], hexas[offset + 6], hexas[offset + 5]};
-    std::vector<T> quad2 = {hexas[offset + 2], hexas[offset + 3], hexas[offset + 7], hexas[offset + 6]};
-    std::vector<T> quad3 = {hexas[offset + 3], hexas[offset + 0], hexas[offset + 4], hexas[offset + 7]};
-    std::vector<T> quad4 = {hexas[offset + 0], hexas[offset + 1], hexas[offset + 2], hexas[offset + 3]};
-    std::vector<T> quad5 = {hexas[offset + 4], hexas[offset + 5], hexas[offset + 6], hexas[offset + 7]};
-
-    std::list<std::vector<T>> quadList = {quad0, quad1, quad2, quad3, quad4, quad5};
-
-    for(auto&& quad : quadList)
-    {
-      std::sort(quad.begin(), quad.end());
-      std::tuple<T, T, T, T> face = std::make_tuple(quad[0], quad[1], quad[2], quad[3]);
-      faceSet.insert(face);
-    }
-  }
-
-  faceList->getDataStore()->reshapeTuples({faceSet.size()});
-  auto& uFaces = *faceList;
-  T index = 0;
-
-  for(auto& face : faceSet)
-  {
-    uFaces[4 * index] = std::get<0>(face);
-    uFaces[4 * index + 1] = std::get<1>(face);
-    uFaces[4 * index + 2] = std::get<2>(face);
-    uFaces[4 * index + 3] = std::get<3>(face);
-    ++index;
-  }
+  auto keys = detail::CollectKeys<T>(hexList, detail::k_HexFaces);
+  detail::WriteUniqueKeys(keys, false, faceList);
 }
 
 /**
- * @brief
+ * @brief Finds the edges that belong to exactly one tetrahedron.
  * @tparam T
  * @param tetList
  * @param edgeList
@@ -411,60 +468,12 @@ void FindHexFaces(const DataArray<T>* hexList, DataArray<T>* faceList)
 template <typename T>
 void FindUnsharedTetEdges(const DataArray<T>* tetList, DataArray<T>* edgeList)
 {
-  auto& tets = *tetList;
-  const usize numElems = tetList->getNumberOfTuples();
-  const usize numVertsPerTet = tetList->getNumberOfComponents();
-
-  std::map<std::pair<T, T>, T> edgeMap;
-
-  for(usize i = 0; i < numElems; i++)
-  {
-    const usize offset = i * numVertsPerTet;
-
-    std::vector<T> edge0 = {tets[offset + 0], tets[offset + 1]};
-    std::vector<T> edge1 = {tets[offset + 0], tets[offset + 2]};
-    std::vector<T> edge2 = {tets[offset + 1], tets[offset + 2]};
-    std::vector<T> edge3 = {tets[offset + 0], tets[offset + 3]};
-    std::vector<T> edge4 = {tets[offset + 1], tets[offset + 3]};
-    std::vector<T> edge5 = {tets[offset + 2], tets[offset + 3]};
-    std::list<std::vector<T>> edgeVecList = {edge0, edge1, edge2, edge3, edge4, edge5};
-
-    for(auto&& uEdge : edgeVecList)
-    {
-      std::sort(uEdge.begin(), uEdge.end());
-      std::pair<T, T> edge = std::make_pair(uEdge[0], uEdge[1]);
-      edgeMap[edge]++;
-    }
-  }
-
-  typename std::map<std::pair<T, T>, T>::iterator mapIter = edgeMap.begin();
-
-  while(mapIter != edgeMap.end())
-  {
-    if((*mapIter).second > 1)
-    {
-      edgeMap.erase(mapIter++);
-    }
-    else
-    {
-      ++mapIter;
-    }
-  }
-
-  edgeList->getDataStore()->reshapeTuples({edgeMap.size()});
-  auto& bEdges = *edgeList;
-  T index = 0;
-
-  for(auto& pair : edgeMap)
-  {
-    bEdges[2 * index] = pair.first.first;
-    bEdges[2 * index + 1] = pair.first.second;
-    ++index;
-  }
+  auto keys = detail::CollectKeys<T>(tetList, detail::k_TetEdges);
+  detail::WriteUniqueKeys(keys, true, edgeList);
 }
 
 /**
- * @brief
+ * @brief Finds the edges that belong to exactly one hexahedron.
  * @tparam T
  * @param hexList
  * @param edge_List
@@ -472,70 +481,12 @@ void FindUnsharedTetEdges(const DataArray<T>* tetList, DataArray<T>* edgeList)
 template <typename T>
 void FindUnsharedHexEdges(const DataArray<T>* hexList, DataArray<T>* edge_List)
 {
-  const usize numElems = hexList->getNumberOfTuples();
-  const usize numVertsPerHex = hexList->getNumberOfComponents();
-  auto& hexas = *hexList;
-
-  std::pair<T, T> edge;
-  std::map<std::pair<T, T>, T> edgeMap;
-
-  for(usize i = 0; i < numElems; i++)
-  {
-    const usize offset = i * numVertsPerHex;
-
-    std::vector<T> edge0 = {hexas[offset + 0], hexas[offset + 1]};
-    std::vector<T> edge1 = {hexas[offset + 1], hexas[offset + 2]};
-    std::vector<T> edge2 = {hexas[offset + 2], hexas[offset + 3]};
-    std::vector<T> edge3 = {hexas[offset + 3], hexas[offset + 0]};
-
-    std::vector<T> edge4 = {hexas[offset + 0], hexas[offset + 4]};
-    std::vector<T> edge5 = {hexas[offset + 1], hexas[offset + 5]};
-    std::vector<T> edge6 = {hexas[offset + 2], hexas[offset + 6]};
-    std::vector<T> edge7 = {hexas[offset + 3], hexas[offset + 7]};
-
-    std::vector<T> edge8 = {hexas[offset + 4], hexas[offset + 5]};
-    std::vector<T> edge9 = {hexas[offset + 5], hexas[offset + 6]};
-    std::vector<T> edge10 = {hexas[offset + 6], hexas[offset + 7]};
-    std::vector<T> edge11 = {hexas[offset + 7], hexas[offset + 4]};
-
-    std::list<std::vector<T>> edgeList = {edge0, edge1, edge2, edge3, edge4, edge5, edge6, edge7, edge8, edge9, edge10, edge11};
-
-    for(auto&& uEdge : edgeList)
-    {
-      std::sort(uEdge.begin(), uEdge.end());
-      edge = std::make_pair(uEdge[0], uEdge[1]);
-      edgeMap[edge]++;
-    }
-  }
-
-  typename std::map<std::pair<T, T>, T>::iterator mapIter = edgeMap.begin();
-
-  while(mapIter != edgeMap.end())
-  {
-    if((*mapIter).second > 1)
-    {
-      edgeMap.erase(mapIter++);
-    }
-    else
-    {
-      ++mapIter;
-    }
-  }
-
-  edge_List->getDataStore()->reshapeTuples({edgeMap.size()});
-  auto& bEdges = *edge_List;
-  T index = 0;
-
-  for(auto& pair : edgeMap)
-  {
-    bEdges[2 * index] = pair.first.first;
-    bEdges[2 * index + 1] = pair.first.second;
-    ++index;
-  }
+  auto keys = detail::CollectKeys<T>(hexList, detail::k_HexEdges);
+  detail::WriteUniqueKeys(keys, true, edge_List);
 }
 
 /**
- * @brief
+ * @brief Finds the faces that belong to exactly one tetrahedron.
  * @tparam T
  * @param tetList
  * @param faceList
@@ -543,60 +494,12 @@ void FindUnsharedHexEdges(const DataArray<T>* hexList, DataArray<T>* edge_List)
 template <typename T>
 void FindUnsharedTetFaces(const DataArray<T>* tetList, DataArray<T>* faceList)
 {
-  const usize numElems = tetList->getNumberOfTuples();
-  const usize numVertsPerTet = tetList->getNumberOfComponents();
-  auto& tets = *tetList;
-
-  std::tuple<T, T, T> face;
-  std::map<std::tuple<T, T, T>, T> faceMap;
-
-  for(usize i = 0; i < numElems; i++)
-  {
-    const usize offset = i * numVertsPerTet;
-
-    std::vector<T> tri0 = {tets[offset + 0], tets[offset + 1], tets[offset + 2]};
-    std::vector<T> tri1 = {tets[offset + 1], tets[offset + 2], tets[offset + 3]};
-    std::vector<T> tri2 = {tets[offset + 0], tets[offset + 2], tets[offset + 3]};
-    std::vector<T> tri3 = {tets[offset + 0], tets[offset + 1], tets[offset + 3]};
-    std::list<std::vector<T>> triList = {tri0, tri1, tri2, tri3};
-
-    for(auto&& tri : triList)
-    {
-      std::sort(tri.begin(), tri.end());
-      face = std::make_tuple(tri[0], tri[1], tri[2]);
-      faceMap[face]++;
-    }
-  }
-
-  typename std::map<std::tuple<T, T, T>, T>::iterator mapIter = faceMap.begin();
-
-  while(mapIter != faceMap.end())
-  {
-    if((*mapIter).second > 1)
-    {
-      faceMap.erase(mapIter++);
-    }
-    else
-    {
-      ++mapIter;
-    }
-  }
-
-  faceList->getDataStore()->reshapeTuples({faceMap.size()});
-  auto& uFaces = *faceList;
-  T index = 0;
-
-  for(auto& pair : faceMap)
-  {
-    uFaces[3 * index] = std::get<0>(pair.first);
-    uFaces[3 * index + 1] = std::get<1>(pair.first);
-    uFaces[3 * index + 2] = std::get<2>(pair.first);
-    ++index;
-  }
+  auto keys = detail::CollectKeys<T>(tetList, detail::k_TetFaces);
+  detail::WriteUniqueKeys(keys, true, faceList);
 }
 
 /**
- * @brief
+ * @brief Finds the faces that belong to exactly one hexahedron.
  * @tparam T
  * @param hexList
  * @param faceList
@@ -604,64 +507,13 @@ void FindUnsharedTetFaces(const DataArray<T>* tetList, DataArray<T>* faceList)
 template <typename T>
 void FindUnsharedHexFaces(const DataArray<T>* hexList, DataArray<T>* faceList)
 {
-  auto& hexas = *hexList;
-  const usize numElems = hexList->getNumberOfTuples();
-  const usize numVertsPerHex = hexList->getNumberOfComponents();
-
-  std::tuple<T, T, T, T> face;
-  std::map<std::tuple<T, T, T, T>, T> faceMap;
-
-  for(usize i = 0; i < numElems; i++)
-  {
-    const usize offset = i * numVertsPerHex;
-
-    std::vector<T> quad0 = {hexas[offset + 0], hexas[offset + 1], hexas[offset + 5], hexas[offset + 4]};
-    std::vector<T> quad1 = {hexas[offset + 1], hexas[offset + 2], hexas[offset + 6], hexas[offset + 5]};
-    std::vector<T> quad2 = {hexas[offset + 2], hexas[offset + 3], hexas[offset + 7], hexas[offset + 6]};
-    std::vector<T> quad3 = {hexas[offset + 3], hexas[offset + 0], hexas[offset + 4], hexas[offset + 7]};
-    std::vector<T> quad4 = {hexas[offset + 0], hexas[offset + 1], hexas[offset + 2], hexas[offset + 3]};
-    std::vector<T> quad5 = {hexas[offset + 4], hexas[offset + 5], hexas[offset + 6], hexas[offset + 7]};
-
-    std::list<std::vector<T>> quadList = {quad0, quad1, quad2, quad3, quad4, quad5};
-
-    for(auto&& quad : quadList)
-    {
-      std::sort(quad.begin(), quad.end());
-      face = std::make_tuple(quad[0], quad[1], quad[2], quad[3]);
-      faceMap[face]++;
-    }
-  }
-
-  typename std::map<std::tuple<T, T, T, T>, T>::iterator mapIter = faceMap.begin();
-
-  while(mapIter != faceMap.end())
-  {
-    if((*mapIter).second > 1)
-    {
-      faceMap.erase(mapIter++);
-    }
-    else
-    {
-      ++mapIter;
-    }
-  }
-
-  faceList->getDataStore()->reshapeTuples({faceMap.size()});
-  auto& uFaces = *faceList;
-  T index = 0;
-
-  for(auto& pair : faceMap)
-  {
-    uFaces[4 * index] = std::get<0>(pair.first);
-    uFaces[4 * index + 1] = std::get<1>(pair.first);
-    uFaces[4 * index + 2] = std::get<2>(pair.first);
-    uFaces[4 * index + 3] = std::get<3>(pair.first);
-    ++index;
-  }
+  auto keys = detail::CollectKeys<T>(hexList, detail::k_HexFaces);
+  detail::WriteUniqueKeys(keys, true, faceList);
 }
 
 /**
- * @brief
+ * @brief Finds the unique edges of the triangles or quadrilaterals. The vertices of
+ * every edge are written in increasing order and the edges are sorted.
  * @tparam T
  * @param elemList
  * @param edgeList
@@ -669,66 +521,12 @@ void FindUnsharedHexFaces(const DataArray<T>* hexList, DataArray<T>* faceList)
 template <typename T>
 void Find2DElementEdges(const DataArray<T>* elemList, DataArray<T>* edgeList)
 {
-  const usize numElems = elemList->getNumberOfTuples();
-  const usize numVertsPerElem = elemList->getNumberOfComponents();
-  auto& elems = *elemList;
-  T v0 = 0;
-  T v1 = 0;
-
-  std::set<std::pair<T, T>> edgeSet;
-
-  for(usize i = 0; i < numElems; i++)
-  {
-    const usize offset = i * numVertsPerElem;
-
-    for(usize j = 0; j < numVertsPerElem; j++)
-    {
-      if(j == (numVertsPerElem - 1))
-      {
-        if(elems[offset + j] > elems[offset + 0])
-        {
-          v0 = elems[offset + 0];
-          v1 = elems[offset + j];
-        }
-        else
-        {
-          v0 = elems[offset + j];
-          v1 = elems[offset + 0];
-        }
-      }
-      else
-      {
-        if(elems[offset + j] > elems[offset + j + 1])
-        {
-          v0 = elems[offset + j + 1];
-          v1 = elems[offset + j];
-        }
-        else
-        {
-          v0 = elems[offset + j];
-          v1 = elems[offset + j + 1];
-        }
-      }
-      std::pair<T, T> edge = std::make_pair(v0, v1);
-      edgeSet.insert(edge);
-    }
-  }
-
-  typename std::set<std::pair<T, T>>::iterator setIter;
-  edgeList->getDataStore()->reshapeTuples({edgeSet.size()});
-  auto& uEdges = *edgeList;
-  T index = 0;
-
-  for(auto& edge : edgeSet)
-  {
-    uEdges[2 * index] = edge.first;
-    uEdges[2 * index + 1] = edge.second;
-    ++index;
-  }
+  auto keys = detail::Collect2DElementEdges(elemList);
+  detail::WriteUniqueKeys(keys, false, edgeList);
 }
 
 /**
- * @brief
+ * @brief Finds the edges that belong to exactly one triangle or quadrilateral.
  * @tparam T
  * @param elemList
  * @param edgeList
@@ -736,75 +534,8 @@ void Find2DElementEdges(const DataArray<T>* elemList, DataArray<T>* edgeList)
 template <typename T>
 void Find2DUnsharedEdges(const DataArray<T>* elemList, DataArray<T>* edgeList)
 {
-  auto& elems = *elemList;
-  const usize numElems = elemList->getNumberOfTuples();
-  const usize numVertsPerElem = elemList->getNumberOfComponents();
-  T v0 = 0;
-  T v1 = 0;
-
-  std::map<std::pair<T, T>, T> edgeMap;
-
-  for(usize i = 0; i < numElems; i++)
-  {
-    const usize offset = i * numVertsPerElem;
-
-    for(usize j = 0; j < numVertsPerElem; j++)
-    {
-      if(j == (numVertsPerElem - 1))
-      {
-        if(elems[offset + j] > elems[offset + 0])
-        {
-          v0 = elems[offset + 0];
-          v1 = elems[offset + j];
-        }
-        else
-        {
-          v0 = elems[offset + j];
-          v1 = elems[offset + 0];
-        }
-      }
-      else
-      {
-        if(elems[offset + j] > elems[offset + j + 1])
-        {
-          v0 = elems[offset + j + 1];
-          v1 = elems[offset + j];
-        }
-        else
-        {
-          v0 = elems[offset + j];
-          v1 = elems[offset + j + 1];
-        }
-      }
-      std::pair<T, T> edge = std::make_pair(v0, v1);
-      edgeMap[edge]++;
-    }
-  }
-
-  typename std::map<std::pair<T, T>, T>::iterator mapIter = edgeMap.begin();
-
-  while(mapIter != edgeMap.end())
-  {
-    if((*mapIter).second > 1)
-    {
-      edgeMap.erase(mapIter++);
-    }
-    else
-    {
-      ++mapIter;
-    }
-  }
-
-  edgeList->getDataStore()->reshapeTuples({edgeMap.size()});
-  auto& bEdges = *edgeList;
-  T index = 0;
-
-  for(auto& edge : edgeMap)
-  {
-    bEdges[2 * index] = edge.first.first;
-    bEdges[2 * index + 1] = edge.first.second;
-    ++index;
-  }
+  auto keys = detail::Collect2DElementEdges(elemList);
+  detail::WriteUniqueKeys(keys, true, edgeList);
 }
 } // namespace Connectivity
 
@@ -1032,6 +763,157 @@ void Find2DElementAreas(const DataArray<T>* elemList, const Float32Array* vertic
     elemAreas[i] = fabsf(area);
   }
 }
+/**
+ * @brief Checks that the derivatives array holds the three spatial derivatives of every
+ * component of the field for each of the numElems elements. Throws a std::runtime_error otherwise.
+ * @param field
+ * @param derivatives
+ * @param numFieldTuples
+ * @param numElems
+ */
+inline void ValidateDerivativeArrays(const Float64Array* field, const Float64Array* derivatives, usize numFieldTuples, usize numElems)
+{
+  if(field == nullptr || derivatives == nullptr)
+  {
+    throw std::runtime_error("findDerivatives: The field and derivatives arrays must both be valid");
+  }
+  if(field->getNumberOfTuples() != numFieldTuples)
+  {
+    throw std::runtime_error(fmt::format("findDerivatives: The field has {} tuples but the geometry requires {}", field->getNumberOfTuples(), numFieldTuples));
+  }
+  if(derivatives->getNumberOfTuples() != numElems || derivatives->getNumberOfComponents() != 3 * field->getNumberOfComponents())
+  {
+    throw std::runtime_error(fmt::format("findDerivatives: The derivatives array must have {} tuples with {} components", numElems, 3 * field->getNumberOfComponents()));
+  }
+}
+
+/**
+ * @brief Computes the gradient of a cell field on a structured grid by finite
+ * differences. Interior cells use central differences over the neighboring cell
+ * centers, boundary cells use one-sided differences and axes that are one cell
+ * thick have a derivative of 0. The derivatives of component c are stored at
+ * 3 * c + {0, 1, 2} of each tuple. The cells are processed in parallel.
+ * @param dims Number of cells along each axis
+ * @param cellCenters Coordinates of the cell centers along each axis
+ * @param field
+ * @param derivatives
+ */
+inline void FindGridDerivatives(const SizeVec3& dims, const std::array<std::vector<float64>, 3>& cellCenters, const Float64Array* field, Float64Array* derivatives)
+{
+  const usize numCells = dims[0] * dims[1] * dims[2];
+  ValidateDerivativeArrays(field, derivatives, numCells, numCells);
+
+  const usize numComps = field->getNumberOfComponents();
+  const auto values = field->createSpan();
+  auto gradients = derivatives->createSpan();
+  const std::array<usize, 3> strides = {1, dims[0], dims[0] * dims[1]};
+
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, numCells);
+  dataAlg.execute([&](const ComplexRange& range) {
+    for(usize cell = range.min(); cell < range.max(); cell++)
+    {
+      const std::array<usize, 3> index = {cell % dims[0], (cell / dims[0]) % dims[1], cell / strides[2]};
+      for(usize axis = 0; axis < 3; axis++)
+      {
+        const usize lower = index[axis] > 0 ? index[axis] - 1 : 0;
+        const usize upper = std::min(index[axis] + 1, dims[axis] - 1);
+        const usize lowerCell = cell - (index[axis] - lower) * strides[axis];
+        const usize upperCell = cell + (upper - index[axis]) * strides[axis];
+        const float64 distance = cellCenters[axis][upper] - cellCenters[axis][lower];
+        for(usize comp = 0; comp < numComps; comp++)
+        {
+          float64 derivative = 0.0;
+          if(upper != lower && distance != 0.0)
+          {
+            derivative = (values[upperCell * numComps + comp] - values[lowerCell * numComps + comp]) / distance;
+          }
+          gradients[(cell * numComps + comp) * 3 + axis] = derivative;
+        }
+      }
+    }
+  });
+}
+
+/**
+ * @brief Computes the gradient of a vertex field over every element of an unstructured
+ * mesh from the derivatives of the element shape functions at the parametric center.
+ * The Jacobian J of the element maps the Dim parametric directions into space; the
+ * gradient is the least squares solution J (J^T J)^-1 dF/dr, which lies in the span of the
+ * element for edges and surface meshes. Degenerate elements have a gradient of 0. The
+ * derivatives of component c are stored at 3 * c + {0, 1, 2} of each tuple. The elements
+ * are processed in parallel.
+ * @tparam Dim Parametric dimension of the elements
+ * @tparam T
+ * @param elemList
+ * @param vertices
+ * @param shapeDerivatives The Dim x numVertsPerElem shape function derivatives, one row per parametric direction
+ * @param field
+ * @param derivatives
+ */
+template <usize Dim, typename T>
+void FindElementDerivatives(const DataArray<T>* elemList, const Float32Array* vertices, const std::vector<float64>& shapeDerivatives, const Float64Array* field, Float64Array* derivatives)
+{
+  if(elemList == nullptr || vertices == nullptr)
+  {
+    throw std::runtime_error("findDerivatives: The geometry does not have any elements");
+  }
+  const usize numElems = elemList->getNumberOfTuples();
+  const usize numVertsPerElem = elemList->getNumberOfComponents();
+  ValidateDerivativeArrays(field, derivatives, vertices->getNumberOfTuples(), numElems);
+
+  using JacobianType = Eigen::Matrix<float64, 3, Dim>;
+  using ParametricType = Eigen::Matrix<float64, Dim, 1>;
+  const usize numComps = field->getNumberOfComponents();
+  const auto elems = elemList->createSpan();
+  const auto verts = vertices->createSpan();
+  const auto values = field->createSpan();
+  auto gradients = derivatives->createSpan();
+
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, numElems);
+  dataAlg.execute([&](const ComplexRange& range) {
+    for(usize elem = range.min(); elem < range.max(); elem++)
+    {
+      const T* elemVerts = elems.data() + elem * numVertsPerElem;
+      JacobianType jacobian = JacobianType::Zero();
+      for(usize i = 0; i < numVertsPerElem; i++)
+      {
+        const usize vert = static_cast<usize>(elemVerts[i]);
+        const Eigen::Vector3d position(verts[3 * vert + 0], verts[3 * vert + 1], verts[3 * vert + 2]);
+        for(usize dir = 0; dir < Dim; dir++)
+        {
+          jacobian.col(dir) += position * shapeDerivatives[dir * numVertsPerElem + i];
+        }
+      }
+
+      const Eigen::Matrix<float64, Dim, Dim> metric = jacobian.transpose() * jacobian;
+      const float64 scale = metric.trace() / static_cast<float64>(Dim);
+      float64* elemGradients = gradients.data() + elem * numComps * 3;
+      if(!(metric.determinant() > 1.0e-12 * std::pow(scale, static_cast<float64>(Dim))))
+      {
+        std::fill(elemGradients, elemGradients + numComps * 3, 0.0);
+        continue;
+      }
+      const JacobianType inverse = jacobian * metric.inverse();
+
+      for(usize comp = 0; comp < numComps; comp++)
+      {
+        ParametricType parametricDerivatives = ParametricType::Zero();
+        for(usize i = 0; i < numVertsPerElem; i++)
+        {
+          const float64 value = values[static_cast<usize>(elemVerts[i]) * numComps + comp];
+          for(usize dir = 0; dir < Dim; dir++)
+          {
+            parametricDerivatives(dir) += value * shapeDerivatives[dir * numVertsPerElem + i];
+          }
+        }
+        const Eigen::Vector3d gradient = inverse * parametricDerivatives;
+        std::copy(gradient.data(), gradient.data() + 3, elemGradients + comp * 3);
+      }
+    }
+  });
+}
 } // namespace Topology
 } // namespace GeometryHelpers
 } // namespace complex
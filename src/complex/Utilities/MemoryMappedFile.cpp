@@ -0,0 +1,299 @@
+#include "MemoryMappedFile.hpp"
+
+#include <fmt/core.h>
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <Windows.h>
+#else
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace complex;
+
+namespace
+{
+#if defined(_WIN32)
+std::string lastErrorString()
+{
+  return fmt::format("Windows error code {}", static_cast<uint32>(GetLastError()));
+}
+#else
+std::string lastErrorString()
+{
+  return std::strerror(errno);
+}
+#endif
+} // namespace
+
+// -----------------------------------------------------------------------------
+MemoryMappedFile::MemoryMappedFile(const std::filesystem::path& path, Mode mode)
+: m_Path(path)
+, m_Mode(mode)
+{
+  // Copy-on-write mappings never modify the file so it is only opened for reading
+  const bool writable = (m_Mode == Mode::ReadWrite);
+#if defined(_WIN32)
+  DWORD access = writable ? (GENERIC_READ | GENERIC_WRITE) : GENERIC_READ;
+  HANDLE fileHandle = CreateFileW(m_Path.wstring().c_str(), access, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if(fileHandle == INVALID_HANDLE_VALUE)
+  {
+    throw std::runtime_error(fmt::format("MemoryMappedFile: Unable to open '{}': {}", m_Path.string(), lastErrorString()));
+  }
+  m_FileHandle = fileHandle;
+  LARGE_INTEGER fileSize;
+  if(GetFileSizeEx(fileHandle, &fileSize) == 0)
+  {
+    std::string message = fmt::format("MemoryMappedFile: Unable to query the size of '{}': {}", m_Path.string(), lastErrorString());
+    close();
+    throw std::runtime_error(message);
+  }
+  usize numBytes = static_cast<usize>(fileSize.QuadPart);
+#else
+  m_FileDescriptor = ::open(m_Path.c_str(), writable ? O_RDWR : O_RDONLY);
+  if(m_FileDescriptor < 0)
+  {
+    throw std::runtime_error(fmt::format("MemoryMappedFile: Unable to open '{}': {}", m_Path.string(), lastErrorString()));
+  }
+  struct stat fileStat = {};
+  if(::fstat(m_FileDescriptor, &fileStat) != 0)
+  {
+    std::string message = fmt::format("MemoryMappedFile: Unable to query the size of '{}': {}", m_Path.string(), lastErrorString());
+    close();
+    throw std::runtime_error(message);
+  }
+  usize numBytes = static_cast<usize>(fileStat.st_size);
+#endif
+
+  try
+  {
+    map(numBytes);
+  } catch(const std::runtime_error&)
+  {
+    close();
+    throw;
+  }
+}
+
+// -----------------------------------------------------------------------------
+std::unique_ptr<MemoryMappedFile> MemoryMappedFile::CreateScratchFile(const std::filesystem::path& directory, usize numBytes)
+{
+  std::unique_ptr<MemoryMappedFile> mappedFile(new MemoryMappedFile());
+  mappedFile->m_Mode = Mode::ReadWrite;
+  mappedFile->m_IsScratchFile = true;
+
+#if defined(_WIN32)
+  std::vector<WCHAR> buffer(MAX_PATH + 1);
+  if(GetTempFileNameW(directory.wstring().c_str(), L"cx", 0, buffer.data()) == 0)
+  {
+    throw std::runtime_error(fmt::format("MemoryMappedFile: Unable to create a scratch file in '{}': {}", directory.string(), lastErrorString()));
+  }
+  mappedFile->m_Path = std::filesystem::path(buffer.data());
+  // The scratch file is removed by the OS once the last handle to it is closed
+  HANDLE fileHandle = CreateFileW(mappedFile->m_Path.wstring().c_str(), GENERIC_READ | GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS,
+                                  FILE_ATTRIBUTE_TEMPORARY | FILE_ATTRIBUTE_NOT_CONTENT_INDEXED | FILE_FLAG_DELETE_ON_CLOSE, nullptr);
+  if(fileHandle == INVALID_HANDLE_VALUE)
+  {
+    std::string message = fmt::format("MemoryMappedFile: Unable to open scratch file '{}': {}", mappedFile->m_Path.string(), lastErrorString());
+    DeleteFileW(mappedFile->m_Path.wstring().c_str());
+    throw std::runtime_error(message);
+  }
+  mappedFile->m_FileHandle = fileHandle;
+#else
+  std::string pathTemplate = (directory / "complex_XXXXXX").string();
+  std::vector<char> buffer(pathTemplate.cbegin(), pathTemplate.cend());
+  buffer.push_back('\0');
+  mappedFile->m_FileDescriptor = ::mkstemp(buffer.data());
+  if(mappedFile->m_FileDescriptor < 0)
+  {
+    throw std::runtime_error(fmt::format("MemoryMappedFile: Unable to create a scratch file in '{}': {}", directory.string(), lastErrorString()));
+  }
+  mappedFile->m_Path = std::filesystem::path(buffer.data());
+  // Unlink immediately so the scratch file never outlives the process, even if it is killed
+  ::unlink(buffer.data());
+#endif
+
+  mappedFile->resize(numBytes);
+  return mappedFile;
+}
+
+// -----------------------------------------------------------------------------
+MemoryMappedFile::~MemoryMappedFile() noexcept
+{
+  close();
+}
+
+// -----------------------------------------------------------------------------
+std::byte* MemoryMappedFile::data()
+{
+  return m_Data;
+}
+
+// -----------------------------------------------------------------------------
+const std::byte* MemoryMappedFile::data() const
+{
+  return m_Data;
+}
+
+// -----------------------------------------------------------------------------
+usize MemoryMappedFile::size() const
+{
+  return m_Size;
+}
+
+// -----------------------------------------------------------------------------
+const std::filesystem::path& MemoryMappedFile::getPath() const
+{
+  return m_Path;
+}
+
+// -----------------------------------------------------------------------------
+MemoryMappedFile::Mode MemoryMappedFile::getMode() const
+{
+  return m_Mode;
+}
+
+// -----------------------------------------------------------------------------
+bool MemoryMappedFile::isScratchFile() const
+{
+  return m_IsScratchFile;
+}
+
+// -----------------------------------------------------------------------------
+void MemoryMappedFile::resize(usize numBytes)
+{
+  if(m_Mode != Mode::ReadWrite)
+  {
+    throw std::runtime_error(fmt::format("MemoryMappedFile: Cannot resize read-only file '{}'", m_Path.string()));
+  }
+  if(numBytes == m_Size && m_Data != nullptr)
+  {
+    return;
+  }
+
+  unmap();
+#if defined(_WIN32)
+  LARGE_INTEGER newSize;
+  newSize.QuadPart = static_cast<LONGLONG>(numBytes);
+  if(SetFilePointerEx(m_FileHandle, newSize, nullptr, FILE_BEGIN) == 0 || SetEndOfFile(m_FileHandle) == 0)
+  {
+    throw std::runtime_error(fmt::format("MemoryMappedFile: Unable to resize '{}' to {} bytes: {}", m_Path.string(), numBytes, lastErrorString()));
+  }
+#else
+  if(::ftruncate(m_FileDescriptor, static_cast<off_t>(numBytes)) != 0)
+  {
+    throw std::runtime_error(fmt::format("MemoryMappedFile: Unable to resize '{}' to {} bytes: {}", m_Path.string(), numBytes, lastErrorString()));
+  }
+#endif
+  map(numBytes);
+}
+
+// -----------------------------------------------------------------------------
+void MemoryMappedFile::adviseSequential() const
+{
+#if !defined(_WIN32)
+  if(m_Data != nullptr)
+  {
+    ::madvise(m_Data, m_Size, MADV_SEQUENTIAL);
+  }
+#endif
+}
+
+// -----------------------------------------------------------------------------
+void MemoryMappedFile::map(usize numBytes)
+{
+  m_Size = numBytes;
+  // Zero length mappings are not allowed by either platform
+  if(numBytes == 0)
+  {
+    m_Data = nullptr;
+    return;
+  }
+
+  const bool writable = (m_Mode == Mode::ReadWrite);
+  const bool copyOnWrite = (m_Mode == Mode::CopyOnWrite);
+#if defined(_WIN32)
+  const uint64 size64 = static_cast<uint64>(numBytes);
+  DWORD pageProtection = writable ? PAGE_READWRITE : (copyOnWrite ? PAGE_WRITECOPY : PAGE_READONLY);
+  HANDLE mappingHandle = CreateFileMappingW(m_FileHandle, nullptr, pageProtection, static_cast<DWORD>(size64 >> 32), static_cast<DWORD>(size64 & 0xFFFFFFFF), nullptr);
+  if(mappingHandle == nullptr)
+  {
+    m_Size = 0;
+    throw std::runtime_error(fmt::format("MemoryMappedFile: Unable to map '{}': {}", m_Path.string(), lastErrorString()));
+  }
+  m_MappingHandle = mappingHandle;
+  DWORD viewAccess = writable ? FILE_MAP_WRITE : (copyOnWrite ? FILE_MAP_COPY : FILE_MAP_READ);
+  void* view = MapViewOfFile(mappingHandle, viewAccess, 0, 0, numBytes);
+  if(view == nullptr)
+  {
+    std::string message = fmt::format("MemoryMappedFile: Unable to map '{}': {}", m_Path.string(), lastErrorString());
+    CloseHandle(mappingHandle);
+    m_MappingHandle = nullptr;
+    m_Size = 0;
+    throw std::runtime_error(message);
+  }
+  m_Data = static_cast<std::byte*>(view);
+#else
+  int protection = (writable || copyOnWrite) ? (PROT_READ | PROT_WRITE) : PROT_READ;
+  void* view = ::mmap(nullptr, numBytes, protection, copyOnWrite ? MAP_PRIVATE : MAP_SHARED, m_FileDescriptor, 0);
+  if(view == MAP_FAILED)
+  {
+    m_Size = 0;
+    throw std::runtime_error(fmt::format("MemoryMappedFile: Unable to map '{}': {}", m_Path.string(), lastErrorString()));
+  }
+  m_Data = static_cast<std::byte*>(view);
+#endif
+}
+
+// -----------------------------------------------------------------------------
+void MemoryMappedFile::unmap() noexcept
+{
+#if defined(_WIN32)
+  if(m_Data != nullptr)
+  {
+    UnmapViewOfFile(m_Data);
+  }
+  if(m_MappingHandle != nullptr)
+  {
+    CloseHandle(m_MappingHandle);
+    m_MappingHandle = nullptr;
+  }
+#else
+  if(m_Data != nullptr)
+  {
+    ::munmap(m_Data, m_Size);
+  }
+#endif
+  m_Data = nullptr;
+  m_Size = 0;
+}
+
+// -----------------------------------------------------------------------------
+void MemoryMappedFile::close() noexcept
+{
+  unmap();
+#if defined(_WIN32)
+  if(m_FileHandle != nullptr)
+  {
+    CloseHandle(m_FileHandle);
+    m_FileHandle = nullptr;
+  }
+#else
+  if(m_FileDescriptor >= 0)
+  {
+    ::close(m_FileDescriptor);
+    m_FileDescriptor = -1;
+  }
+#endif
+}
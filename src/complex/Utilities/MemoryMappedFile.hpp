@@ -0,0 +1,142 @@
+#pragma once
+
+#include "complex/Common/Types.hpp"
+#include "complex/complex_export.hpp"
+
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+
+namespace complex
+{
+/**
+ * @class MemoryMappedFile
+ * @brief The MemoryMappedFile class maps a file on disk into the address space
+ * of the process so that its contents can be paged in and out by the operating
+ * system instead of being held in physical memory.
+ *
+ * A MemoryMappedFile is either opened on an existing file or created as a
+ * temporary scratch file. Scratch files are removed from disk when the
+ * MemoryMappedFile is destroyed.
+ */
+class COMPLEX_EXPORT MemoryMappedFile
+{
+public:
+  /**
+   * @brief ReadOnly and ReadWrite mappings share their pages with the file on disk.
+   * CopyOnWrite mappings open the file read-only but allow the mapped pages to be
+   * modified; modified pages become private to the process and are never written
+   * back to the file. Pages that were not modified are still read from the file, so
+   * the file must not be changed while it is mapped: a later write shows through and
+   * truncating the file crashes the next access to a page past its new end.
+   */
+  enum class Mode : uint8
+  {
+    ReadOnly = 0,
+    ReadWrite,
+    CopyOnWrite
+  };
+
+  /**
+   * @brief Maps the existing file at the specified path. Throws a runtime_error
+   * if the file cannot be opened or mapped.
+   * @param path
+   * @param mode
+   */
+  MemoryMappedFile(const std::filesystem::path& path, Mode mode);
+
+  /**
+   * @brief Creates and maps a new read/write scratch file of the requested size in
+   * the specified directory. The file is deleted when the returned object is
+   * destroyed. Throws a runtime_error if the file cannot be created or mapped.
+   * @param directory
+   * @param numBytes
+   * @return std::unique_ptr<MemoryMappedFile>
+   */
+  static std::unique_ptr<MemoryMappedFile> CreateScratchFile(const std::filesystem::path& directory, usize numBytes);
+
+  MemoryMappedFile(const MemoryMappedFile&) = delete;
+  MemoryMappedFile(MemoryMappedFile&&) = delete;
+
+  MemoryMappedFile& operator=(const MemoryMappedFile&) = delete;
+  MemoryMappedFile& operator=(MemoryMappedFile&&) = delete;
+
+  /**
+   * @brief Unmaps the file and closes the underlying handle. Scratch files are
+   * removed from disk.
+   */
+  ~MemoryMappedFile() noexcept;
+
+  /**
+   * @brief Returns a pointer to the start of the mapped region. Returns nullptr
+   * if the mapped file is empty.
+   * @return std::byte*
+   */
+  std::byte* data();
+
+  /**
+   * @brief Returns a pointer to the start of the mapped region. Returns nullptr
+   * if the mapped file is empty.
+   * @return const std::byte*
+   */
+  const std::byte* data() const;
+
+  /**
+   * @brief Returns the number of mapped bytes.
+   * @return usize
+   */
+  usize size() const;
+
+  /**
+   * @brief Returns the path of the mapped file.
+   * @return const std::filesystem::path&
+   */
+  const std::filesystem::path& getPath() const;
+
+  /**
+   * @brief Returns the mode the file was mapped with.
+   * @return Mode
+   */
+  Mode getMode() const;
+
+  /**
+   * @brief Returns true if the file will be removed from disk on destruction.
+   * @return bool
+   */
+  bool isScratchFile() const;
+
+  /**
+   * @brief Changes the size of the file on disk and remaps it. Existing contents
+   * are preserved up to the smaller of the old and new sizes. Any pointers
+   * previously returned by data() are invalidated. Throws a runtime_error if the
+   * file was not mapped in ReadWrite mode or cannot be resized.
+   * @param numBytes
+   */
+  void resize(usize numBytes);
+
+  /**
+   * @brief Hints to the operating system that the mapped region will be read
+   * sequentially so that pages can be read ahead aggressively.
+   */
+  void adviseSequential() const;
+
+private:
+  MemoryMappedFile() = default;
+
+  void map(usize numBytes);
+  void unmap() noexcept;
+  void close() noexcept;
+
+  std::filesystem::path m_Path;
+  Mode m_Mode = Mode::ReadOnly;
+  bool m_IsScratchFile = false;
+  std::byte* m_Data = nullptr;
+  usize m_Size = 0;
+#if defined(_WIN32)
+  void* m_FileHandle = nullptr;
+  void* m_MappingHandle = nullptr;
+#else
+  int m_FileDescriptor = -1;
+#endif
+};
+} // namespace complex
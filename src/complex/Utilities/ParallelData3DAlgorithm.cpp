@@ -108,6 +108,22 @@ void ParallelData3DAlgorithm::setGrain(size_t grain)
   m_Grain = grain;
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool ParallelData3DAlgorithm::getSplitIntoZSlabs() const
+{
+  return m_SplitIntoZSlabs;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ParallelData3DAlgorithm::setSplitIntoZSlabs(bool splitIntoZSlabs)
+{
+  m_SplitIntoZSlabs = splitIntoZSlabs;
+}
+
 #ifdef COMPLEX_ENABLE_MULTICORE
 // -----------------------------------------------------------------------------
 //
@@ -46,6 +46,7 @@
 #include <tbb/partitioner.h>
 #endif
 
+#include <algorithm>
 #include <array>
 #include <cstddef>
 
@@ -105,6 +106,20 @@ public:
    */
   void setGrain(size_t grain);
 
+  /**
+   * @brief Returns true if the range is split into Z slabs.
+   * @return
+   */
+  bool getSplitIntoZSlabs() const;
+
+  /**
+   * @brief Sets whether the range is only split along Z so that each task receives
+   * whole XY planes that are contiguous in memory. The grain size is then the minimum
+   * number of planes per task. Otherwise the range is split along X.
+   * @param splitIntoZSlabs
+   */
+  void setSplitIntoZSlabs(bool splitIntoZSlabs);
+
 #ifdef COMPLEX_ENABLE_MULTICORE
   /**
    * @brief Sets the partitioner for parallelization.
@@ -123,7 +138,14 @@ public:
     bool doParallel = false;
 #ifdef COMPLEX_ENABLE_MULTICORE
     doParallel = m_RunParallel;
-    if(doParallel)
+    if(doParallel && m_SplitIntoZSlabs)
+    {
+      const size_t xGrain = std::max<size_t>(m_Range[1] - m_Range[0], 1);
+      const size_t yGrain = std::max<size_t>(m_Range[3] - m_Range[2], 1);
+      tbb::blocked_range3d<size_t, size_t, size_t> tbbRange(m_Range[0], m_Range[1], xGrain, m_Range[2], m_Range[3], yGrain, m_Range[4], m_Range[5], m_Grain);
+      tbb::parallel_for(tbbRange, body, m_Partitioner);
+    }
+    else if(doParallel)
     {
       tbb::blocked_range3d<size_t, size_t, size_t> tbbRange(m_Range[0], m_Range[1], m_Grain, m_Range[2], m_Range[3], m_Range[3], m_Range[4], m_Range[5], m_Range[5]);
       tbb::parallel_for(tbbRange, body, m_Partitioner);
@@ -141,6 +163,7 @@ private:
   ComplexRange3D m_Range;
   size_t m_Grain = 1;
   bool m_RunParallel = false;
+  bool m_SplitIntoZSlabs = false;
 #ifdef COMPLEX_ENABLE_MULTICORE
   tbb::auto_partitioner m_Partitioner;
 #endif
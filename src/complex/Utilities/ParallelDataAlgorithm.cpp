@@ -34,6 +34,9 @@
 
 #include "ParallelDataAlgorithm.hpp"
 
+#include <algorithm>
+#include <thread>
+
 using namespace complex;
 
 // -----------------------------------------------------------------------------
@@ -102,3 +105,21 @@ void ParallelDataAlgorithm::setPartitioner(const tbb::auto_partitioner& partitio
   m_Partitioner = partitioner;
 }
 #endif
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+usize complex::GetNumRanges(usize count, usize minPerRange)
+{
+  return std::clamp<usize>(count / std::max<usize>(minPerRange, 1), 1, std::max(std::thread::hardware_concurrency(), 1u));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ComplexRange complex::GetRange(usize count, usize numRanges, usize range)
+{
+  const usize base = count / numRanges;
+  const usize remainder = count % numRanges;
+  return {base * range + std::min(range, remainder), base * (range + 1) + std::min(range + 1, remainder)};
+}
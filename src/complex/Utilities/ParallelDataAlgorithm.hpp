@@ -35,6 +35,7 @@
 #pragma once
 
 #include "complex/Common/ComplexRange.hpp"
+#include "complex/Common/Types.hpp"
 #include "complex/complex_export.hpp"
 
 // SIMPLib.h MUST be included before this or the guard will block the include but not its uses below.
@@ -133,4 +134,23 @@ private:
   tbb::auto_partitioner m_Partitioner;
 #endif
 };
+
+/**
+ * @brief Returns the number of fixed ranges to split count items into. Each range holds
+ * at least minPerRange items and there are no more ranges than hardware threads. Algorithms
+ * that process each range in one task get results that do not depend on task scheduling.
+ * @param count
+ * @param minPerRange
+ * @return usize
+ */
+COMPLEX_EXPORT usize GetNumRanges(usize count, usize minPerRange);
+
+/**
+ * @brief Returns one of numRanges parts of [0, count). The part sizes differ by at most one.
+ * @param count
+ * @param numRanges
+ * @param range
+ * @return ComplexRange
+ */
+COMPLEX_EXPORT ComplexRange GetRange(usize count, usize numRanges, usize range);
 } // namespace complex
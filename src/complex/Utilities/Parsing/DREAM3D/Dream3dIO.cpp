@@ -94,13 +94,22 @@ complex::DREAM3D::PipelineVersionType complex::DREAM3D::GetPipelineVersion(const
   return pipelineVersionAttribute.readAsValue<PipelineVersionType>();
 }
 
-Result<DataStructure> ImportDataStructureV8(const H5::FileReader& fileReader, bool preflight)
+Result<DataStructure> ImportDataStructureV8(const H5::FileReader& fileReader, bool preflight, const std::optional<H5::DataStructureReader::ImageSubvolume>& subvolume = std::nullopt,
+                                            bool lazy = false)
 {
   H5::ErrorType errorCode = 0;
   H5::DataStructureReader dataStructureReader;
+  dataStructureReader.setImageSubvolume(subvolume);
+  dataStructureReader.setLazyImport(lazy);
   auto dataStructure = dataStructureReader.readH5Group(fileReader, errorCode, preflight);
   if(errorCode < 0)
   {
+    if(subvolume.has_value())
+    {
+      return MakeErrorResult<DataStructure>(errorCode, fmt::format("Failed to import DataStructure. Check that the subvolume X [{}, {}], Y [{}, {}], Z [{}, {}] lies inside every Image Geometry",
+                                                                   subvolume->minVoxel[0], subvolume->maxVoxel[0], subvolume->minVoxel[1], subvolume->maxVoxel[1], subvolume->minVoxel[2],
+                                                                   subvolume->maxVoxel[2]));
+    }
     return MakeErrorResult<DataStructure>(errorCode, fmt::format("Failed to import DataStructure"));
   }
   return {std::move(dataStructure)};
@@ -612,6 +621,42 @@ Result<complex::DataStructure> complex::DREAM3D::ImportDataStructureFromFile(con
                                         fmt::format("Could not parse DataStructure version {}. Expected versions: {} or {}", fileVersion, k_CurrentFileVersion, Legacy::FileVersion));
 }
 
+Result<complex::DataStructure> complex::DREAM3D::ImportDataStructureFromFile(const H5::FileReader& fileReader, const H5::DataStructureReader::ImageSubvolume& subvolume, bool preflight)
+{
+  const auto fileVersion = GetFileVersion(fileReader);
+  if(fileVersion == k_CurrentFileVersion)
+  {
+    return ImportDataStructureV8(fileReader, preflight, subvolume);
+  }
+  else if(fileVersion == Legacy::FileVersion)
+  {
+    return MakeErrorResult<DataStructure>(k_LegacySubvolumeUnsupported, fmt::format("Importing a subvolume is not supported for legacy DataStructure version {}", fileVersion));
+  }
+  // Unsupported file version
+  return MakeErrorResult<DataStructure>(k_InvalidDataStructureVersion,
+                                        fmt::format("Could not parse DataStructure version {}. Expected versions: {} or {}", fileVersion, k_CurrentFileVersion, Legacy::FileVersion));
+}
+
+Result<complex::DataStructure> complex::DREAM3D::ImportLazyDataStructureFromFile(const H5::FileReader& fileReader, const std::optional<H5::DataStructureReader::ImageSubvolume>& subvolume)
+{
+  const auto fileVersion = GetFileVersion(fileReader);
+  if(fileVersion == k_CurrentFileVersion)
+  {
+    return ImportDataStructureV8(fileReader, false, subvolume, true);
+  }
+  else if(fileVersion == Legacy::FileVersion)
+  {
+    if(subvolume.has_value())
+    {
+      return MakeErrorResult<DataStructure>(k_LegacySubvolumeUnsupported, fmt::format("Importing a subvolume is not supported for legacy DataStructure version {}", fileVersion));
+    }
+    return ImportLegacyDataStructure(fileReader, false);
+  }
+  // Unsupported file version
+  return MakeErrorResult<DataStructure>(k_InvalidDataStructureVersion,
+                                        fmt::format("Could not parse DataStructure version {}. Expected versions: {} or {}", fileVersion, k_CurrentFileVersion, Legacy::FileVersion));
+}
+
 Result<complex::DataStructure> complex::DREAM3D::ImportDataStructureFromFile(const std::filesystem::path& filePath)
 {
   H5::FileReader fileReader(filePath);
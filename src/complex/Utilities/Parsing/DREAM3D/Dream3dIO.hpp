@@ -7,6 +7,7 @@
 
 #include "complex/Pipeline/Pipeline.hpp"
 #include "complex/Utilities/Parsing/HDF5/H5.hpp"
+#include "complex/Utilities/Parsing/HDF5/H5DataStructureReader.hpp"
 #include "complex/complex_export.hpp"
 
 namespace complex
@@ -28,6 +29,7 @@ using PipelineVersionType = int32;
 inline constexpr int32 k_InvalidPipelineVersion = -404;
 inline constexpr int32 k_InvalidDataStructureVersion = -405;
 inline constexpr int32 k_PipelineGroupUnavailable = -406;
+inline constexpr int32 k_LegacySubvolumeUnsupported = -407;
 
 /**
  * @brief Returns the DREAM3D file version.
@@ -100,6 +102,34 @@ COMPLEX_EXPORT Result<> WriteFile(const std::filesystem::path& path, const DataS
  */
 COMPLEX_EXPORT Result<complex::DataStructure> ImportDataStructureFromFile(const H5::FileReader& fileReader, bool preflight = false);
 
+/**
+ * @brief Imports and returns the DataStructure from the target .dream3d file
+ * with every ImageGeom cropped to the specified voxel bounds. Only the voxels
+ * inside the bounds are read from the cell arrays of each ImageGeom.
+ *
+ * Legacy DataStructures cannot be imported with a subvolume.
+ * @param fileReader
+ * @param subvolume
+ * @param preflight = false
+ * @return complex::DataStructure
+ */
+COMPLEX_EXPORT Result<complex::DataStructure> ImportDataStructureFromFile(const H5::FileReader& fileReader, const H5::DataStructureReader::ImageSubvolume& subvolume, bool preflight = false);
+
+/**
+ * @brief Imports and returns the DataStructure from the target .dream3d file
+ * without reading the values of its DataArrays. Each DataArray reads its
+ * values from the file the first time they are accessed. The file is kept open
+ * until every lazily imported DataArray has been destroyed.
+ *
+ * If a subvolume is provided, every ImageGeom is cropped to it as in
+ * ImportDataStructureFromFile. Legacy DataStructures are imported in full.
+ * @param fileReader
+ * @param subvolume = std::nullopt
+ * @return complex::DataStructure
+ */
+COMPLEX_EXPORT Result<complex::DataStructure> ImportLazyDataStructureFromFile(const H5::FileReader& fileReader,
+                                                                              const std::optional<H5::DataStructureReader::ImageSubvolume>& subvolume = std::nullopt);
+
 /**
  * @brief Imports and returns the DataStructure from the target .dream3d file.
  * This method imports both current and legacy DataStructures.
@@ -120,3 +120,9 @@ std::string GetParentPath(const std::string& objectPath)
 {
   return StringUtilities::chop(objectPath, "/");
 }
+
+std::recursive_mutex& H5::GetLibraryMutex()
+{
+  static std::recursive_mutex s_LibraryMutex;
+  return s_LibraryMutex;
+}
@@ -4,6 +4,7 @@
 #include "complex/Common/Types.hpp"
 
 #include <cstdint>
+#include <mutex>
 #include <string>
 #include <string_view>
 
@@ -80,6 +81,20 @@ std::string COMPLEX_EXPORT GetNameFromId(IdType id);
  */
 std::string COMPLEX_EXPORT GetParentPath(const std::string& objectPath);
 
+/**
+ * @brief Returns the mutex used to serialize HDF5 calls that may be made from
+ * worker threads, such as lazily loaded arrays being read the first time a
+ * parallel algorithm touches them. The HDF5 library is not thread safe unless
+ * it was built with thread safety enabled.
+ *
+ * The mutex is taken while files are opened, created and closed and while
+ * datasets are opened, read, written and closed. It is recursive so that these
+ * calls can be made while it is already held. Other HDF5 calls, such as those
+ * on groups and attributes, do not take it and must not be made from worker threads.
+ * @return std::recursive_mutex&
+ */
+std::recursive_mutex& COMPLEX_EXPORT GetLibraryMutex();
+
 inline constexpr StringLiteral k_DataTypeTag = "DataType";
 
 inline constexpr StringLiteral k_DataStoreTag = "DataStore";
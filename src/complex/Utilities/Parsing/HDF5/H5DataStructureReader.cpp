@@ -1,7 +1,10 @@
 #include "H5DataStructureReader.hpp"
 
+#include <H5Ipublic.h>
+
 #include "complex/Core/Application.hpp"
 #include "complex/DataStructure/DataMap.hpp"
+#include "complex/Utilities/Parsing/HDF5/H5FileReader.hpp"
 #include "complex/Utilities/Parsing/HDF5/H5GroupReader.hpp"
 #include "complex/Utilities/Parsing/HDF5/H5IDataFactory.hpp"
 
@@ -32,9 +35,17 @@ complex::DataStructure H5::DataStructureReader::readH5Group(const H5::GroupReade
     return {};
   }
 
+  // Lazily imported arrays share ownership of a new file ID so that the file
+  // stays open after the caller's reader is closed.
+  if(m_LazyImport && !preflight)
+  {
+    m_LazyFileReader = std::make_shared<H5::FileReader>(H5Iget_file_id(groupReader.getId()));
+  }
+
   m_CurrentStructure = DataStructure();
   m_CurrentStructure.setNextId(idAttribute.readAsValue<DataObject::IdType>());
   errorCode = m_CurrentStructure.getRootGroup().readH5Group(*this, rootGroupReader, {}, preflight);
+  m_LazyFileReader = nullptr;
   return std::move(m_CurrentStructure);
 }
 
@@ -117,6 +128,42 @@ DataStructure& H5::DataStructureReader::getDataStructure()
 void H5::DataStructureReader::clearDataStructure()
 {
   m_CurrentStructure = DataStructure();
+  m_TupleHyperslab = std::nullopt;
+}
+
+const std::optional<H5::DataStructureReader::ImageSubvolume>& H5::DataStructureReader::getImageSubvolume() const
+{
+  return m_ImageSubvolume;
+}
+
+void H5::DataStructureReader::setImageSubvolume(const std::optional<ImageSubvolume>& subvolume)
+{
+  m_ImageSubvolume = subvolume;
+}
+
+const std::optional<H5::DataStructureReader::TupleHyperslab>& H5::DataStructureReader::getTupleHyperslab() const
+{
+  return m_TupleHyperslab;
+}
+
+void H5::DataStructureReader::setTupleHyperslab(const std::optional<TupleHyperslab>& hyperslab)
+{
+  m_TupleHyperslab = hyperslab;
+}
+
+bool H5::DataStructureReader::isLazyImport() const
+{
+  return m_LazyImport;
+}
+
+void H5::DataStructureReader::setLazyImport(bool lazy)
+{
+  m_LazyImport = lazy;
+}
+
+std::shared_ptr<H5::FileReader> H5::DataStructureReader::getLazyFileReader() const
+{
+  return m_LazyFileReader;
 }
 
 H5::DataFactoryManager* H5::DataStructureReader::getDataReader() const
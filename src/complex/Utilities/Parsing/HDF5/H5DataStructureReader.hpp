@@ -1,7 +1,10 @@
 #pragma once
 
+#include <memory>
 #include <optional>
+#include <vector>
 
+#include "complex/Common/Array.hpp"
 #include "complex/DataStructure/DataObject.hpp"
 #include "complex/DataStructure/DataStructure.hpp"
 #include "complex/Utilities/Parsing/HDF5/H5DataFactoryManager.hpp"
@@ -12,6 +15,7 @@ class DataFactoryManager;
 
 namespace H5
 {
+class FileReader;
 class GroupReader;
 class IDataFactory;
 
@@ -24,6 +28,28 @@ class IDataFactory;
 class COMPLEX_EXPORT DataStructureReader
 {
 public:
+  /**
+   * @brief Inclusive voxel bounds, in XYZ order, that every imported ImageGeom
+   * is cropped to.
+   */
+  struct ImageSubvolume
+  {
+    SizeVec3 minVoxel;
+    SizeVec3 maxVoxel;
+  };
+
+  /**
+   * @brief Describes the part of the tuple dimensions that should be read for
+   * DataArrays whose stored tuple shape matches sourceTupleShape. All vectors
+   * are in tuple shape order (slowest first).
+   */
+  struct TupleHyperslab
+  {
+    std::vector<usize> sourceTupleShape;
+    std::vector<usize> start;
+    std::vector<usize> count;
+  };
+
   /**
    * @brief Constructs a DataStructureReader with a sppecific DataFactoryManager.
    * If no DataFactoryManager is provided, the Application instance's is used
@@ -71,6 +97,57 @@ public:
    */
   void clearDataStructure();
 
+  /**
+   * @brief Returns the voxel bounds ImageGeoms are cropped to while importing.
+   * Returns std::nullopt if ImageGeoms are imported in full.
+   * @return const std::optional<ImageSubvolume>&
+   */
+  const std::optional<ImageSubvolume>& getImageSubvolume() const;
+
+  /**
+   * @brief Sets the voxel bounds ImageGeoms are cropped to while importing.
+   * Only the selected region of each cell array is read from the file.
+   * @param subvolume
+   */
+  void setImageSubvolume(const std::optional<ImageSubvolume>& subvolume);
+
+  /**
+   * @brief Returns the tuple hyperslab applied to DataArrays that are
+   * currently being imported. Returns std::nullopt if arrays are read in full.
+   * @return const std::optional<TupleHyperslab>&
+   */
+  const std::optional<TupleHyperslab>& getTupleHyperslab() const;
+
+  /**
+   * @brief Sets the tuple hyperslab applied to DataArrays that are imported
+   * from this point on. Geometries set this while their children are read.
+   * @param hyperslab
+   */
+  void setTupleHyperslab(const std::optional<TupleHyperslab>& hyperslab);
+
+  /**
+   * @brief Returns true if DataArrays are imported lazily.
+   * @return bool
+   */
+  bool isLazyImport() const;
+
+  /**
+   * @brief Sets whether DataArrays are imported lazily. Lazily imported arrays
+   * only read their metadata while the DataStructure is built and keep the file
+   * open to read their values the first time they are accessed.
+   *
+   * Has no effect on preflight imports.
+   * @param lazy
+   */
+  void setLazyImport(bool lazy);
+
+  /**
+   * @brief Returns the file being imported from that lazily imported arrays
+   * read their values from. Returns nullptr unless a lazy import is running.
+   * @return std::shared_ptr<H5::FileReader>
+   */
+  std::shared_ptr<H5::FileReader> getLazyFileReader() const;
+
 protected:
   /**
    * @brief Returns a pointer to the H5::DataFactoryManager used for finding the
@@ -90,6 +167,10 @@ protected:
 private:
   H5::DataFactoryManager* m_FactoryManager = nullptr;
   DataStructure m_CurrentStructure;
+  std::optional<ImageSubvolume> m_ImageSubvolume;
+  std::optional<TupleHyperslab> m_TupleHyperslab;
+  bool m_LazyImport = false;
+  std::shared_ptr<H5::FileReader> m_LazyFileReader = nullptr;
 };
 } // namespace H5
 } // namespace complex
@@ -1,8 +1,12 @@
 #include "H5DatasetReader.hpp"
 
+#include <algorithm>
 #include <iostream>
+#include <mutex>
 #include <numeric>
 
+#include <fmt/core.h>
+
 #include <H5Apublic.h>
 
 #include "complex/Utilities/Parsing/HDF5/H5.hpp"
@@ -10,12 +14,21 @@
 
 using namespace complex;
 
+namespace
+{
+H5::IdType OpenDataset(H5::IdType parentId, const std::string& dataName)
+{
+  std::lock_guard<std::recursive_mutex> lock(H5::GetLibraryMutex());
+  return H5Dopen(parentId, dataName.c_str(), H5P_DEFAULT);
+}
+} // namespace
+
 H5::DatasetReader::DatasetReader()
 {
 }
 
 H5::DatasetReader::DatasetReader(H5::IdType parentId, const std::string& dataName)
-: ObjectReader(parentId, H5Dopen(parentId, dataName.c_str(), H5P_DEFAULT))
+: ObjectReader(parentId, OpenDataset(parentId, dataName))
 {
 }
 
@@ -28,6 +41,7 @@ void H5::DatasetReader::closeHdf5()
 {
   if(isValid())
   {
+    std::lock_guard<std::recursive_mutex> lock(H5::GetLibraryMutex());
     H5Dclose(getId());
     setId(0);
   }
@@ -105,6 +119,8 @@ std::string H5::DatasetReader::readAsString() const
     return "";
   }
 
+  std::lock_guard<std::recursive_mutex> lock(H5::GetLibraryMutex());
+
   std::string data;
 
   // Test if the string is variable length
@@ -151,6 +167,8 @@ std::vector<std::string> H5::DatasetReader::readAsVectorOfStrings() const
     return {};
   }
 
+  std::lock_guard<std::recursive_mutex> lock(H5::GetLibraryMutex());
+
   std::vector<std::string> strings;
 
   hid_t typeID = getTypeId();
@@ -243,6 +261,8 @@ bool H5::DatasetReader::readIntoSpan(nonstd::span<T> data) const
     return false;
   }
 
+  std::lock_guard<std::recursive_mutex> lock(H5::GetLibraryMutex());
+
   hid_t dataType = H5::Support::HdfTypeForPrimitive<T>();
   if(dataType == -1)
   {
@@ -281,6 +301,118 @@ bool H5::DatasetReader::readIntoSpan(nonstd::span<T> data) const
   return true;
 }
 
+template <class T>
+bool H5::DatasetReader::readIntoSpan(nonstd::span<T> data, const std::vector<hsize_t>& start, const std::vector<hsize_t>& count, const std::vector<hsize_t>& stride) const
+{
+  if(!isValid())
+  {
+    return false;
+  }
+
+  std::lock_guard<std::recursive_mutex> lock(H5::GetLibraryMutex());
+
+  hid_t dataType = H5::Support::HdfTypeForPrimitive<T>();
+  if(dataType == -1)
+  {
+    return false;
+  }
+
+  auto hyperslabDimsResult = getHyperslabDimensions(start, count, stride);
+  if(hyperslabDimsResult.invalid())
+  {
+    return false;
+  }
+  const std::vector<hsize_t>& hyperslabDims = hyperslabDimsResult.value();
+  const hsize_t numElements = std::accumulate(hyperslabDims.cbegin(), hyperslabDims.cend(), static_cast<hsize_t>(1), std::multiplies<>());
+  if(numElements != data.size())
+  {
+    return false;
+  }
+  if(numElements == 0)
+  {
+    return true;
+  }
+
+  const usize rank = hyperslabDims.size();
+  std::vector<hsize_t> fileStart(rank, 0);
+  std::vector<hsize_t> fileStride(rank, 1);
+  std::copy(start.cbegin(), start.cend(), fileStart.begin());
+  std::copy(stride.cbegin(), stride.cend(), fileStride.begin());
+
+  hid_t fileSpaceId = getDataspaceId();
+  if(fileSpaceId < 0)
+  {
+    std::cout << "Error Opening SpaceID" << std::endl;
+    return false;
+  }
+  herr_t error = H5Sselect_hyperslab(fileSpaceId, H5S_SELECT_SET, fileStart.data(), fileStride.data(), hyperslabDims.data(), nullptr);
+  if(error < 0)
+  {
+    H5Sclose(fileSpaceId);
+    std::cout << "Error Selecting Hyperslab.'" << getName() << "'" << std::endl;
+    return false;
+  }
+
+  // The selection is read into a contiguous memory space of the same shape
+  hid_t memorySpaceId = H5Screate_simple(static_cast<int>(rank), hyperslabDims.data(), nullptr);
+  error = H5Dread(getId(), dataType, memorySpaceId, fileSpaceId, H5P_DEFAULT, data.data());
+  H5Sclose(memorySpaceId);
+  H5Sclose(fileSpaceId);
+  if(error < 0)
+  {
+    std::cout << "Error Reading Data.'" << getName() << "'" << std::endl;
+    return false;
+  }
+
+  return true;
+}
+
+template <class T>
+bool H5::DatasetReader::readTupleRangeIntoSpan(nonstd::span<T> data, usize tupleOffset, usize numTuples) const
+{
+  return readIntoSpan<T>(data, {static_cast<hsize_t>(tupleOffset)}, {static_cast<hsize_t>(numTuples)});
+}
+
+Result<std::vector<hsize_t>> H5::DatasetReader::getHyperslabDimensions(const std::vector<hsize_t>& start, const std::vector<hsize_t>& count, const std::vector<hsize_t>& stride) const
+{
+  std::vector<hsize_t> dims = getDimensions();
+  if(dims.empty())
+  {
+    return MakeErrorResult<std::vector<hsize_t>>(-20020, fmt::format("Unable to read the dimensions of dataset '{}'", getName()));
+  }
+  if(start.size() > dims.size() || count.size() > dims.size() || stride.size() > dims.size())
+  {
+    return MakeErrorResult<std::vector<hsize_t>>(
+        -20021, fmt::format("The hyperslab for dataset '{}' has more dimensions ({}, {}, {}) than the dataset ({})", getName(), start.size(), count.size(), stride.size(), dims.size()));
+  }
+
+  std::vector<hsize_t> hyperslabDims(dims.size());
+  for(usize i = 0; i < dims.size(); i++)
+  {
+    const hsize_t offset = (i < start.size()) ? start[i] : 0;
+    const hsize_t step = (i < stride.size()) ? stride[i] : 1;
+    if(step == 0)
+    {
+      return MakeErrorResult<std::vector<hsize_t>>(-20022, fmt::format("The hyperslab stride for dimension {} of dataset '{}' must be greater than 0", i, getName()));
+    }
+    if(offset >= dims[i])
+    {
+      return MakeErrorResult<std::vector<hsize_t>>(-20023, fmt::format("The hyperslab start ({}) for dimension {} of dataset '{}' is outside the dimension size ({})", offset, i, getName(), dims[i]));
+    }
+
+    // Missing counts select every remaining element along the dimension
+    const hsize_t available = (dims[i] - offset + step - 1) / step;
+    const hsize_t numElements = (i < count.size()) ? count[i] : available;
+    if(numElements == 0 || numElements > available)
+    {
+      return MakeErrorResult<std::vector<hsize_t>>(-20024, fmt::format("The hyperslab count ({}) for dimension {} of dataset '{}' must be between 1 and {}", numElements, i, getName(), available));
+    }
+    hyperslabDims[i] = numElements;
+  }
+
+  return {std::move(hyperslabDims)};
+}
+
 std::vector<hsize_t> H5::DatasetReader::getDimensions() const
 {
   std::vector<hsize_t> dims;
@@ -342,3 +474,33 @@ template COMPLEX_EXPORT bool H5::DatasetReader::readIntoSpan<usize>(nonstd::span
 #endif
 template COMPLEX_EXPORT bool H5::DatasetReader::readIntoSpan<float32>(nonstd::span<float32>) const;
 template COMPLEX_EXPORT bool H5::DatasetReader::readIntoSpan<float64>(nonstd::span<float64>) const;
+
+template COMPLEX_EXPORT bool H5::DatasetReader::readIntoSpan<int8>(nonstd::span<int8>, const std::vector<hsize_t>&, const std::vector<hsize_t>&, const std::vector<hsize_t>&) const;
+template COMPLEX_EXPORT bool H5::DatasetReader::readIntoSpan<int16>(nonstd::span<int16>, const std::vector<hsize_t>&, const std::vector<hsize_t>&, const std::vector<hsize_t>&) const;
+template COMPLEX_EXPORT bool H5::DatasetReader::readIntoSpan<int32>(nonstd::span<int32>, const std::vector<hsize_t>&, const std::vector<hsize_t>&, const std::vector<hsize_t>&) const;
+template COMPLEX_EXPORT bool H5::DatasetReader::readIntoSpan<int64>(nonstd::span<int64>, const std::vector<hsize_t>&, const std::vector<hsize_t>&, const std::vector<hsize_t>&) const;
+template COMPLEX_EXPORT bool H5::DatasetReader::readIntoSpan<uint8>(nonstd::span<uint8>, const std::vector<hsize_t>&, const std::vector<hsize_t>&, const std::vector<hsize_t>&) const;
+template COMPLEX_EXPORT bool H5::DatasetReader::readIntoSpan<uint16>(nonstd::span<uint16>, const std::vector<hsize_t>&, const std::vector<hsize_t>&, const std::vector<hsize_t>&) const;
+template COMPLEX_EXPORT bool H5::DatasetReader::readIntoSpan<uint32>(nonstd::span<uint32>, const std::vector<hsize_t>&, const std::vector<hsize_t>&, const std::vector<hsize_t>&) const;
+template COMPLEX_EXPORT bool H5::DatasetReader::readIntoSpan<uint64>(nonstd::span<uint64>, const std::vector<hsize_t>&, const std::vector<hsize_t>&, const std::vector<hsize_t>&) const;
+template COMPLEX_EXPORT bool H5::DatasetReader::readIntoSpan<bool>(nonstd::span<bool>, const std::vector<hsize_t>&, const std::vector<hsize_t>&, const std::vector<hsize_t>&) const;
+#ifdef __APPLE__
+template COMPLEX_EXPORT bool H5::DatasetReader::readIntoSpan<usize>(nonstd::span<usize>, const std::vector<hsize_t>&, const std::vector<hsize_t>&, const std::vector<hsize_t>&) const;
+#endif
+template COMPLEX_EXPORT bool H5::DatasetReader::readIntoSpan<float32>(nonstd::span<float32>, const std::vector<hsize_t>&, const std::vector<hsize_t>&, const std::vector<hsize_t>&) const;
+template COMPLEX_EXPORT bool H5::DatasetReader::readIntoSpan<float64>(nonstd::span<float64>, const std::vector<hsize_t>&, const std::vector<hsize_t>&, const std::vector<hsize_t>&) const;
+
+template COMPLEX_EXPORT bool H5::DatasetReader::readTupleRangeIntoSpan<int8>(nonstd::span<int8>, usize, usize) const;
+template COMPLEX_EXPORT bool H5::DatasetReader::readTupleRangeIntoSpan<int16>(nonstd::span<int16>, usize, usize) const;
+template COMPLEX_EXPORT bool H5::DatasetReader::readTupleRangeIntoSpan<int32>(nonstd::span<int32>, usize, usize) const;
+template COMPLEX_EXPORT bool H5::DatasetReader::readTupleRangeIntoSpan<int64>(nonstd::span<int64>, usize, usize) const;
+template COMPLEX_EXPORT bool H5::DatasetReader::readTupleRangeIntoSpan<uint8>(nonstd::span<uint8>, usize, usize) const;
+template COMPLEX_EXPORT bool H5::DatasetReader::readTupleRangeIntoSpan<uint16>(nonstd::span<uint16>, usize, usize) const;
+template COMPLEX_EXPORT bool H5::DatasetReader::readTupleRangeIntoSpan<uint32>(nonstd::span<uint32>, usize, usize) const;
+template COMPLEX_EXPORT bool H5::DatasetReader::readTupleRangeIntoSpan<uint64>(nonstd::span<uint64>, usize, usize) const;
+template COMPLEX_EXPORT bool H5::DatasetReader::readTupleRangeIntoSpan<bool>(nonstd::span<bool>, usize, usize) const;
+#ifdef __APPLE__
+template COMPLEX_EXPORT bool H5::DatasetReader::readTupleRangeIntoSpan<usize>(nonstd::span<usize>, usize, usize) const;
+#endif
+template COMPLEX_EXPORT bool H5::DatasetReader::readTupleRangeIntoSpan<float32>(nonstd::span<float32>, usize, usize) const;
+template COMPLEX_EXPORT bool H5::DatasetReader::readTupleRangeIntoSpan<float64>(nonstd::span<float64>, usize, usize) const;
@@ -112,6 +112,46 @@ public:
   template <class T>
   bool readIntoSpan(nonstd::span<T> data) const;
 
+  /**
+   * @brief Reads a hyperslab of the dataset into the given span. The start,
+   * count, and stride vectors are given in dataset dimension order (slowest
+   * first) and may be shorter than the dataset rank, in which case the
+   * remaining dimensions are read in full. An empty stride reads every element.
+   * Requires the span to be the size of the selection returned by
+   * getHyperslabDimensions. Returns false if unable to read.
+   * @tparam T
+   * @param data
+   * @param start
+   * @param count
+   * @param stride
+   */
+  template <class T>
+  bool readIntoSpan(nonstd::span<T> data, const std::vector<hsize_t>& start, const std::vector<hsize_t>& count, const std::vector<hsize_t>& stride = {}) const;
+
+  /**
+   * @brief Reads the rows [tupleOffset, tupleOffset + numTuples) of the
+   * dataset's slowest dimension into the given span. For a dataset with a
+   * multi-dimensional tuple shape, each row is a full slice of the remaining
+   * dimensions (i.e. a Z slice of a ZYX volume). Returns false if unable to read.
+   * @tparam T
+   * @param data
+   * @param tupleOffset
+   * @param numTuples
+   */
+  template <class T>
+  bool readTupleRangeIntoSpan(nonstd::span<T> data, usize tupleOffset, usize numTuples) const;
+
+  /**
+   * @brief Returns the dimensions of the selection described by the given
+   * hyperslab parameters or an error if the hyperslab does not fit inside
+   * the dataset. See readIntoSpan for the meaning of the parameters.
+   * @param start
+   * @param count
+   * @param stride
+   * @return Result<std::vector<hsize_t>>
+   */
+  Result<std::vector<hsize_t>> getHyperslabDimensions(const std::vector<hsize_t>& start, const std::vector<hsize_t>& count, const std::vector<hsize_t>& stride = {}) const;
+
   /**
    * @brief Returns a vector of the sizes of the dimensions for the dataset
    * Returns empty vector if unable to read.
@@ -135,5 +175,27 @@ extern template bool DatasetReader::readIntoSpan<uint32>(nonstd::span<uint32>) c
 extern template bool DatasetReader::readIntoSpan<uint64>(nonstd::span<uint64>) const;
 extern template bool DatasetReader::readIntoSpan<float32>(nonstd::span<float32>) const;
 extern template bool DatasetReader::readIntoSpan<float64>(nonstd::span<float64>) const;
+extern template bool DatasetReader::readIntoSpan<bool>(nonstd::span<bool>, const std::vector<hsize_t>&, const std::vector<hsize_t>&, const std::vector<hsize_t>&) const;
+extern template bool DatasetReader::readIntoSpan<int8>(nonstd::span<int8>, const std::vector<hsize_t>&, const std::vector<hsize_t>&, const std::vector<hsize_t>&) const;
+extern template bool DatasetReader::readIntoSpan<int16>(nonstd::span<int16>, const std::vector<hsize_t>&, const std::vector<hsize_t>&, const std::vector<hsize_t>&) const;
+extern template bool DatasetReader::readIntoSpan<int32>(nonstd::span<int32>, const std::vector<hsize_t>&, const std::vector<hsize_t>&, const std::vector<hsize_t>&) const;
+extern template bool DatasetReader::readIntoSpan<int64>(nonstd::span<int64>, const std::vector<hsize_t>&, const std::vector<hsize_t>&, const std::vector<hsize_t>&) const;
+extern template bool DatasetReader::readIntoSpan<uint8>(nonstd::span<uint8>, const std::vector<hsize_t>&, const std::vector<hsize_t>&, const std::vector<hsize_t>&) const;
+extern template bool DatasetReader::readIntoSpan<uint16>(nonstd::span<uint16>, const std::vector<hsize_t>&, const std::vector<hsize_t>&, const std::vector<hsize_t>&) const;
+extern template bool DatasetReader::readIntoSpan<uint32>(nonstd::span<uint32>, const std::vector<hsize_t>&, const std::vector<hsize_t>&, const std::vector<hsize_t>&) const;
+extern template bool DatasetReader::readIntoSpan<uint64>(nonstd::span<uint64>, const std::vector<hsize_t>&, const std::vector<hsize_t>&, const std::vector<hsize_t>&) const;
+extern template bool DatasetReader::readIntoSpan<float32>(nonstd::span<float32>, const std::vector<hsize_t>&, const std::vector<hsize_t>&, const std::vector<hsize_t>&) const;
+extern template bool DatasetReader::readIntoSpan<float64>(nonstd::span<float64>, const std::vector<hsize_t>&, const std::vector<hsize_t>&, const std::vector<hsize_t>&) const;
+extern template bool DatasetReader::readTupleRangeIntoSpan<bool>(nonstd::span<bool>, usize, usize) const;
+extern template bool DatasetReader::readTupleRangeIntoSpan<int8>(nonstd::span<int8>, usize, usize) const;
+extern template bool DatasetReader::readTupleRangeIntoSpan<int16>(nonstd::span<int16>, usize, usize) const;
+extern template bool DatasetReader::readTupleRangeIntoSpan<int32>(nonstd::span<int32>, usize, usize) const;
+extern template bool DatasetReader::readTupleRangeIntoSpan<int64>(nonstd::span<int64>, usize, usize) const;
+extern template bool DatasetReader::readTupleRangeIntoSpan<uint8>(nonstd::span<uint8>, usize, usize) const;
+extern template bool DatasetReader::readTupleRangeIntoSpan<uint16>(nonstd::span<uint16>, usize, usize) const;
+extern template bool DatasetReader::readTupleRangeIntoSpan<uint32>(nonstd::span<uint32>, usize, usize) const;
+extern template bool DatasetReader::readTupleRangeIntoSpan<uint64>(nonstd::span<uint64>, usize, usize) const;
+extern template bool DatasetReader::readTupleRangeIntoSpan<float32>(nonstd::span<float32>, usize, usize) const;
+extern template bool DatasetReader::readTupleRangeIntoSpan<float64>(nonstd::span<float64>, usize, usize) const;
 } // namespace H5
 } // namespace complex
@@ -1,9 +1,14 @@
 #include "H5DatasetWriter.hpp"
 
+#include <algorithm>
 #include <iostream>
+#include <mutex>
 
 #include <H5Apublic.h>
+#include <H5Ppublic.h>
+#include <H5Zpublic.h>
 
+#include "complex/Utilities/Parsing/HDF5/H5.hpp"
 #include "complex/Utilities/Parsing/HDF5/H5Support.hpp"
 
 using namespace complex;
@@ -13,9 +18,10 @@ H5::DatasetWriter::DatasetWriter()
 {
 }
 
-H5::DatasetWriter::DatasetWriter(H5::IdType parentId, const std::string& datasetName)
+H5::DatasetWriter::DatasetWriter(H5::IdType parentId, const std::string& datasetName, const DatasetCreationOptions& creationOptions)
 : ObjectWriter(parentId)
 , m_DatasetName(datasetName)
+, m_CreationOptions(creationOptions)
 {
 #if 0
   if(!tryOpeningDataset(datasetName, dataType))
@@ -91,6 +97,7 @@ void H5::DatasetWriter::closeHdf5()
 {
   if(getId() > 0)
   {
+    std::lock_guard<std::recursive_mutex> lock(H5::GetLibraryMutex());
     H5Dclose(getId());
     setId(0);
   }
@@ -114,17 +121,92 @@ H5::ErrorType H5::DatasetWriter::findAndDeleteAttribute()
   return 0;
 }
 
-void H5::DatasetWriter::createOrOpenDataset(H5::IdType typeId, H5::IdType dataspaceId)
+void H5::DatasetWriter::createOrOpenDataset(H5::IdType typeId, H5::IdType dataspaceId, H5::IdType propertyListId)
 {
   HDF_ERROR_HANDLER_OFF
   setId(H5Dopen(getParentId(), getName().c_str(), H5P_DEFAULT));
   HDF_ERROR_HANDLER_ON
   if(getId() < 0) // dataset does not exist so create it
   {
-    setId(H5Dcreate(getParentId(), getName().c_str(), typeId, dataspaceId, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT));
+    setId(H5Dcreate(getParentId(), getName().c_str(), typeId, dataspaceId, H5P_DEFAULT, propertyListId, H5P_DEFAULT));
   }
 }
 
+H5::DatasetWriter::DimsType H5::DatasetWriter::ComputeChunkShape(const DimsType& dims, usize typeSize, usize targetChunkBytes)
+{
+  DimsType chunkShape(dims.size(), 1);
+  // Fill the chunk from the fastest changing dimension until the target size is reached
+  usize chunkBytes = std::max<usize>(typeSize, 1);
+  for(usize i = dims.size(); i > 0; i--)
+  {
+    const usize dimIndex = i - 1;
+    const usize dim = std::max<usize>(static_cast<usize>(dims[dimIndex]), 1);
+    const usize maxExtent = std::max<usize>(targetChunkBytes / chunkBytes, 1);
+    chunkShape[dimIndex] = static_cast<H5::SizeType>(std::min(dim, maxExtent));
+    chunkBytes *= static_cast<usize>(chunkShape[dimIndex]);
+    if(chunkShape[dimIndex] < dim)
+    {
+      break;
+    }
+  }
+  return chunkShape;
+}
+
+H5::IdType H5::DatasetWriter::createDatasetCreationPropertyList(H5::IdType typeId, const DimsType& dims) const
+{
+  if(!m_CreationOptions.isChunked() || dims.empty())
+  {
+    return H5P_DEFAULT;
+  }
+  // Chunks may not be larger than a fixed size dataset so empty datasets stay contiguous
+  if(std::find(dims.cbegin(), dims.cend(), 0) != dims.cend())
+  {
+    return H5P_DEFAULT;
+  }
+
+  DimsType chunkShape = m_CreationOptions.chunkShape;
+  if(chunkShape.size() != dims.size())
+  {
+    chunkShape = ComputeChunkShape(dims, H5Tget_size(typeId), m_CreationOptions.chunkBytes);
+  }
+  for(usize i = 0; i < dims.size(); i++)
+  {
+    chunkShape[i] = std::clamp<H5::SizeType>(chunkShape[i], 1, dims[i]);
+  }
+
+  hid_t propertyListId = H5Pcreate(H5P_DATASET_CREATE);
+  if(propertyListId < 0)
+  {
+    std::cout << "Error Creating Dataset Creation Property List" << std::endl;
+    return H5P_DEFAULT;
+  }
+  if(H5Pset_chunk(propertyListId, static_cast<int>(chunkShape.size()), chunkShape.data()) < 0)
+  {
+    std::cout << "Error Setting Dataset Chunk Shape" << std::endl;
+    H5Pclose(propertyListId);
+    return H5P_DEFAULT;
+  }
+
+  // Filters are applied in the order they are added to the pipeline
+  if(m_CreationOptions.scaleOffset && H5Tget_class(typeId) == H5T_INTEGER)
+  {
+    H5Pset_scaleoffset(propertyListId, H5Z_SO_INT, H5Z_SO_INT_MINBITS_DEFAULT);
+  }
+  if(m_CreationOptions.shuffle)
+  {
+    H5Pset_shuffle(propertyListId);
+  }
+  if(m_CreationOptions.deflateLevel > 0 && H5Zfilter_avail(H5Z_FILTER_DEFLATE) > 0)
+  {
+    H5Pset_deflate(propertyListId, static_cast<unsigned>(std::min(m_CreationOptions.deflateLevel, 9)));
+  }
+  if(m_CreationOptions.fletcher32)
+  {
+    H5Pset_fletcher32(propertyListId);
+  }
+  return propertyListId;
+}
+
 bool H5::DatasetWriter::isValid() const
 {
   return (getParentId() > 0) && (m_DatasetName.empty() == false);
@@ -140,6 +222,16 @@ std::string H5::DatasetWriter::getName() const
   return m_DatasetName;
 }
 
+const H5::DatasetCreationOptions& H5::DatasetWriter::getCreationOptions() const
+{
+  return m_CreationOptions;
+}
+
+void H5::DatasetWriter::setCreationOptions(const DatasetCreationOptions& creationOptions)
+{
+  m_CreationOptions = creationOptions;
+}
+
 H5::ErrorType H5::DatasetWriter::writeString(const std::string& text)
 {
   if(!isValid())
@@ -147,6 +239,8 @@ H5::ErrorType H5::DatasetWriter::writeString(const std::string& text)
     return -1;
   }
 
+  std::lock_guard<std::recursive_mutex> lock(H5::GetLibraryMutex());
+
   closeHdf5();
 
   herr_t error = 0;
@@ -200,6 +294,8 @@ H5::ErrorType H5::DatasetWriter::writeVectorOfStrings(std::vector<std::string>&
     return -1;
   }
 
+  std::lock_guard<std::recursive_mutex> lock(H5::GetLibraryMutex());
+
   hid_t dataspaceID = -1;
   hid_t memSpace = -1;
   hid_t datatype = -1;
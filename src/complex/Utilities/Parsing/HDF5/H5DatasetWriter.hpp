@@ -1,7 +1,9 @@
 #pragma once
 
+#include <mutex>
 #include <vector>
 
+#include "complex/Utilities/Parsing/HDF5/H5.hpp"
 #include "complex/Utilities/Parsing/HDF5/H5ObjectWriter.hpp"
 #include "complex/Utilities/Parsing/HDF5/H5Support.hpp"
 
@@ -11,11 +13,48 @@ namespace complex
 {
 namespace H5
 {
+/**
+ * @brief The DatasetCreationOptions struct describes the storage layout and
+ * the built-in HDF5 filters used when a DatasetWriter creates a new dataset.
+ * Datasets are created contiguous and unfiltered unless an option is set.
+ */
+struct COMPLEX_EXPORT DatasetCreationOptions
+{
+  static inline constexpr usize k_DefaultChunkBytes = 1024 * 1024;
+
+  std::vector<H5::SizeType> chunkShape;   // Explicit chunk shape. Must match the rank of the dataset or a shape is computed from chunkBytes.
+  usize chunkBytes = k_DefaultChunkBytes; // Target chunk size in bytes when chunkShape is not used
+  int32 deflateLevel = 0;                 // gzip compression level from 1 to 9. 0 disables compression.
+  bool shuffle = false;                   // Reorders the bytes of each value before compressing
+  bool scaleOffset = false;               // Lossless bit packing of integer datasets
+  bool fletcher32 = false;                // Adds a checksum to each chunk
+
+  /**
+   * @brief Returns true if datasets must be created with a chunked layout.
+   * @return bool
+   */
+  bool isChunked() const
+  {
+    return !chunkShape.empty() || deflateLevel > 0 || shuffle || scaleOffset || fletcher32;
+  }
+};
+
 class COMPLEX_EXPORT DatasetWriter : public ObjectWriter
 {
 public:
   using DimsType = std::vector<H5::SizeType>;
 
+  /**
+   * @brief Returns a chunk shape for a dataset of the given dimensions that
+   * holds at most targetChunkBytes. The fastest changing dimensions are kept
+   * whole wherever possible so that each chunk covers contiguous tuples.
+   * @param dims
+   * @param typeSize
+   * @param targetChunkBytes
+   * @return DimsType
+   */
+  static DimsType ComputeChunkShape(const DimsType& dims, usize typeSize, usize targetChunkBytes);
+
   /**
    * @brief Constructs an invalid DatasetWriter.
    */
@@ -27,8 +66,9 @@ public:
    * or the datasetName is empty.
    * @param parentId
    * @param datasetName
+   * @param creationOptions
    */
-  DatasetWriter(H5::IdType parentId, const std::string& datasetName);
+  DatasetWriter(H5::IdType parentId, const std::string& datasetName, const DatasetCreationOptions& creationOptions = {});
 
   /**
    * @brief Default destructor
@@ -49,6 +89,19 @@ public:
    */
   std::string getName() const override;
 
+  /**
+   * @brief Returns the options used when creating the dataset.
+   * @return const DatasetCreationOptions&
+   */
+  const DatasetCreationOptions& getCreationOptions() const;
+
+  /**
+   * @brief Sets the options used when creating the dataset. This has no effect
+   * on a dataset that already exists.
+   * @param creationOptions
+   */
+  void setCreationOptions(const DatasetCreationOptions& creationOptions);
+
   /**
    * @brief Writes a given string to the dataset. Returns the HDF5 error,
    * should one occur.
@@ -109,6 +162,7 @@ public:
     //  return -1;
     //}
 
+    std::lock_guard<std::recursive_mutex> lock(H5::GetLibraryMutex());
     hid_t dataspaceId = H5Screate_simple(rank, dims.data(), nullptr);
     if(dataspaceId >= 0)
     {
@@ -122,7 +176,12 @@ public:
       {
         /* Create the attribute. */
         // hid_t attributeId = H5Acreate(getId(), getName().c_str(), dataType, dataspaceId, H5P_DEFAULT, H5P_DEFAULT);
-        createOrOpenDataset(dataType, dataspaceId);
+        hid_t propertyListId = createDatasetCreationPropertyList(dataType, dims);
+        createOrOpenDataset(dataType, dataspaceId, propertyListId);
+        if(propertyListId != H5P_DEFAULT)
+        {
+          H5Pclose(propertyListId);
+        }
         if(getId() >= 0)
         {
           /* Write the attribute data. */
@@ -172,11 +231,23 @@ protected:
 
   /**
    * @brief Opens the target HDF5 dataset or creates a new one using the given
-   * datatype and dataspace IDs.
+   * datatype, dataspace and dataset creation property list IDs.
    * @param typeId
    * @param dataspaceId
+   * @param propertyListId
+   */
+  void createOrOpenDataset(H5::IdType typeId, H5::IdType dataspaceId, H5::IdType propertyListId = H5P_DEFAULT);
+
+  /**
+   * @brief Creates the dataset creation property list described by the
+   * creation options for a dataset with the given datatype and dimensions.
+   * Returns H5P_DEFAULT if the dataset should be stored contiguous. Otherwise,
+   * the caller is responsible for closing the returned property list.
+   * @param typeId
+   * @param dims
+   * @return H5::IdType
    */
-  void createOrOpenDataset(H5::IdType typeId, H5::IdType dataspaceId);
+  H5::IdType createDatasetCreationPropertyList(H5::IdType typeId, const DimsType& dims) const;
 
   /**
    * @brief Closes the HDF5 dataset and resets the ID to 0.
@@ -190,6 +261,7 @@ private:
 #endif
 
   const std::string m_DatasetName;
+  DatasetCreationOptions m_CreationOptions;
 };
 } // namespace H5
 } // namespace complex
@@ -2,12 +2,24 @@
 
 #include <H5Apublic.h>
 
+#include "complex/Utilities/Parsing/HDF5/H5.hpp"
 #include "complex/Utilities/Parsing/HDF5/H5Support.hpp"
 
+#include <mutex>
+
 using namespace complex;
 
+namespace
+{
+H5::IdType OpenFile(const std::filesystem::path& filepath)
+{
+  std::lock_guard<std::recursive_mutex> lock(H5::GetLibraryMutex());
+  return H5Fopen(filepath.string().c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+}
+} // namespace
+
 H5::FileReader::FileReader(const std::filesystem::path& filepath)
-: GroupReader(0, H5Fopen(filepath.string().c_str(), H5F_ACC_RDONLY, H5P_DEFAULT))
+: GroupReader(0, OpenFile(filepath))
 {
 }
 
@@ -25,6 +37,7 @@ void H5::FileReader::closeHdf5()
 {
   if(isValid())
   {
+    std::lock_guard<std::recursive_mutex> lock(H5::GetLibraryMutex());
     H5Fclose(getId());
     setId(0);
   }
@@ -1,11 +1,67 @@
 #include "H5FileWriter.hpp"
 
+#include "complex/Utilities/Parsing/HDF5/H5.hpp"
+
 #include <fmt/format.h>
 
+#include <H5Fpublic.h>
+
+#include <mutex>
 #include <stdexcept>
+#include <string>
+#include <vector>
 
 using namespace complex;
 
+namespace
+{
+H5::IdType CreateHdf5File(const std::filesystem::path& filepath)
+{
+  std::lock_guard<std::recursive_mutex> lock(H5::GetLibraryMutex());
+  return H5Fcreate(filepath.string().c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
+}
+
+/**
+ * @brief Returns true if this process still has the file open, for example
+ * through arrays that were imported lazily from it. HDF5 cannot truncate a file
+ * that is open.
+ * @param filepath
+ * @return bool
+ */
+bool IsFileOpen(const std::filesystem::path& filepath)
+{
+  std::error_code errorCode;
+  if(!std::filesystem::exists(filepath, errorCode))
+  {
+    return false;
+  }
+
+  std::lock_guard<std::recursive_mutex> lock(H5::GetLibraryMutex());
+  const ssize_t numFiles = H5Fget_obj_count(H5F_OBJ_ALL, H5F_OBJ_FILE);
+  if(numFiles <= 0)
+  {
+    return false;
+  }
+  std::vector<hid_t> fileIds(static_cast<usize>(numFiles));
+  const ssize_t numIds = H5Fget_obj_ids(H5F_OBJ_ALL, H5F_OBJ_FILE, fileIds.size(), fileIds.data());
+  for(ssize_t i = 0; i < numIds; i++)
+  {
+    const ssize_t nameSize = H5Fget_name(fileIds[i], nullptr, 0);
+    if(nameSize <= 0)
+    {
+      continue;
+    }
+    std::string name(static_cast<usize>(nameSize), '\0');
+    H5Fget_name(fileIds[i], name.data(), name.size() + 1);
+    if(std::filesystem::equivalent(name, filepath, errorCode))
+    {
+      return true;
+    }
+  }
+  return false;
+}
+} // namespace
+
 Result<H5::FileWriter> H5::FileWriter::CreateFile(const std::filesystem::path& filepath)
 {
   Result<H5::FileWriter> result;
@@ -19,6 +75,14 @@ Result<H5::FileWriter> H5::FileWriter::CreateFile(const std::filesystem::path& f
     }
   }
 
+  if(IsFileOpen(filepath))
+  {
+    return MakeErrorResult<H5::FileWriter>(
+        -303, fmt::format("Error creating Output HDF5 file at path '{}'. The file is still open for reading, which happens when arrays were imported lazily from it and have not been loaded. "
+                          "Write to a different path.",
+                          filepath.string()));
+  }
+
   try
   {
     return {FileWriter(filepath)};
@@ -45,11 +109,12 @@ H5::FileWriter::FileWriter(FileWriter&& rhs) noexcept
 {
   auto rhsId = rhs.getId();
   setId(rhsId);
+  setDatasetCreationOptions(rhs.getDatasetCreationOptions());
   rhs.setId(-1);
 }
 
 H5::FileWriter::FileWriter(const std::filesystem::path& filepath)
-: GroupWriter(0, H5Fcreate(filepath.string().c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT))
+: GroupWriter(0, CreateHdf5File(filepath))
 {
   if(getId() < 0)
   {
@@ -71,6 +136,7 @@ void H5::FileWriter::closeHdf5()
 {
   if(isValid())
   {
+    std::lock_guard<std::recursive_mutex> lock(H5::GetLibraryMutex());
     H5Fclose(getId());
     setId(0);
   }
@@ -23,8 +23,9 @@ public:
    * HDF5 group fails, this writer is invalid.
    * @param parentId
    * @param objectName
+   * @param datasetCreationOptions
    */
-  GroupWriter(H5::IdType parentId, const std::string& objectName);
+  GroupWriter(H5::IdType parentId, const std::string& objectName, const DatasetCreationOptions& datasetCreationOptions = {});
 
   /**
    * @brief Closes the HDF5 group.
@@ -37,6 +38,21 @@ public:
    */
   bool isValid() const override;
 
+  /**
+   * @brief Returns the options used to create datasets in this group and in
+   * any child groups created through this writer.
+   * @return const DatasetCreationOptions&
+   */
+  const DatasetCreationOptions& getDatasetCreationOptions() const;
+
+  /**
+   * @brief Sets the options used to create datasets in this group. The options
+   * are passed on to every GroupWriter and DatasetWriter created afterwards
+   * through this writer.
+   * @param datasetCreationOptions
+   */
+  void setDatasetCreationOptions(const DatasetCreationOptions& datasetCreationOptions);
+
   /**
    * @brief Creates a GroupWriter for writing to a child group with the
    * target name. Returns an invalid GroupWriter if the group cannot be
@@ -78,6 +94,9 @@ protected:
    * @param objectId
    */
   GroupWriter(H5::IdType parentId, H5::IdType objectId);
+
+private:
+  DatasetCreationOptions m_DatasetCreationOptions;
 };
 } // namespace H5
 } // namespace complex
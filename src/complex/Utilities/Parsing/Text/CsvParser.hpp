@@ -3,11 +3,13 @@
 #include "complex/Common/Result.hpp"
 #include "complex/DataStructure/DataArray.hpp"
 #include "complex/DataStructure/DataStructure.hpp"
+#include "complex/Utilities/Parsing/Text/DelimitedTextReader.hpp"
 #include "complex/Utilities/StringUtilities.hpp"
 #include "complex/complex_export.hpp"
 
 #include <fmt/core.h>
 
+#include <cstring>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
@@ -79,6 +81,10 @@ COMPLEX_EXPORT int32_t ReadLine(std::istream& in, char* buffer, size_t length);
 
 /**
  * @brief Reads a Text file that contains numeric values into a single DataArray<T>.
+ *
+ * Values are separated by the delimiter and/or white space and are read in order
+ * regardless of how they are spread over the lines. The file is parsed in parallel
+ * through a DelimitedTextReader.
  * @tparam T Final Target type of the value being read
  * @tparam K Intermediate type to be used to initially read the value from the file
  * @param filename The input path to the text file
@@ -91,83 +97,56 @@ COMPLEX_EXPORT int32_t ReadLine(std::istream& in, char* buffer, size_t length);
 template <typename T, typename K>
 Result<> ReadFile(const fs::path& filename, DataArray<T>& data, uint64_t skipHeaderLines, char delimiter, bool inputIsBool = false)
 {
-  int32_t err = k_RBR_NO_ERROR;
   if(!fs::exists(filename))
   {
     return MakeErrorResult(k_RBR_FILE_NOT_EXIST, fmt::format("Input file does not exist: {}", filename.string()));
   }
 
-  std::ifstream in(filename.c_str(), std::ios_base::in | std::ios_base::binary);
-  if(!in.is_open())
+  DelimitedTextReader reader;
+  if(!reader.open(filename))
   {
     return MakeErrorResult(k_RBR_FILE_NOT_OPEN, fmt::format("Could not open file for reading: {}", filename.string()));
   }
 
-  in.imbue(std::locale(std::locale(), new complex::CsvParser::DelimiterType(delimiter)));
+  const usize totalSize = data.getSize();
+  nonstd::span<T> values = data.createSpan();
 
-  std::array<char, k_BufferSize> buf = {};
-  char* buffer = buf.data();
-
-  // Skip some header bytes by just reading those bytes into the pointer knowing that the next
-  // thing we are going to do it over write those bytes with the real data that we are after.
-  for(int i = 0; i < skipHeaderLines; i++)
-  {
-    buf.fill(0x00);                                               // Splat Null Chars across the line
-    err = complex::CsvParser::ReadLine(in, buffer, k_BufferSize); // Read Line 1 - VTK Version Info
-    if(err < 0)
-    {
-      return MakeErrorResult(k_RBR_READ_ERROR, fmt::format("Could not read data from file while skipping header lines: {}", filename.string()));
-    }
-  }
-
-  size_t numTuples = data.getNumberOfTuples();
-  int scalarNumComp = data.getNumberOfComponents();
-
-  size_t totalSize = numTuples * static_cast<size_t>(scalarNumComp);
-
-  if(inputIsBool)
-  {
-    double value = 0.0;
-    int64_t* si64Ptr = reinterpret_cast<int64_t*>(&value);
-    for(size_t i = 0; i < totalSize; ++i)
+  Result<usize> readResult = reader.forEachValue(skipHeaderLines, delimiter, totalSize, [&](usize index, std::string_view token) -> Result<> {
+    Result<> parseResult;
+    if(inputIsBool)
     {
-      in >> value;
-      if(*si64Ptr == 0)
-      {
-        data[i] = false;
-      }
-      else
-      {
-        data[i] = true;
-      }
-      err = CheckErrorBits(&in);
-      if(err == k_RBR_READ_EOF && i < totalSize - 1)
-      {
-        return MakeErrorResult(k_RBR_READ_EOF, fmt::format("Read past End Of File (EOF) while parsing file: {}", filename.string()));
-      }
-      if(err == k_RBR_READ_ERROR)
+      // Any value whose bits are not all zero is true
+      Result<float64> valueResult = DelimitedTextReader::ParseValue<float64>(token);
+      if(valueResult.valid())
       {
-        return MakeErrorResult(k_RBR_READ_ERROR, fmt::format("Read error while parsing file: {}", filename.string()));
+        int64 bits = 0;
+        std::memcpy(&bits, &valueResult.value(), sizeof(bits));
+        values[index] = static_cast<T>(bits != 0);
       }
+      parseResult = ConvertResult(std::move(valueResult));
     }
-  }
-  else
-  {
-    K value = static_cast<T>(0.0);
-    for(size_t i = 0; i < totalSize; ++i)
+    else
     {
-      in >> value;
-      data[i] = static_cast<T>(value);
-      err = CheckErrorBits(&in);
-      if(err == k_RBR_READ_EOF && i < totalSize - 1)
-      {
-        return MakeErrorResult(k_RBR_READ_EOF, fmt::format("Read past End Of File (EOF) while parsing file: {}", filename.string()));
-      }
-      if(err == k_RBR_READ_ERROR)
+      Result<K> valueResult = DelimitedTextReader::ParseValue<K>(token);
+      if(valueResult.valid())
       {
-        return MakeErrorResult(k_RBR_READ_ERROR, fmt::format("Read error while parsing file: {}", filename.string()));
+        values[index] = static_cast<T>(valueResult.value());
       }
+      parseResult = ConvertResult(std::move(valueResult));
+    }
+    if(parseResult.invalid())
+    {
+      return MakeErrorResult(k_RBR_READ_FAIL, fmt::format("Error parsing value {} on line {} of file {}: {}", index, reader.findLineIndex(token.data()) + 1, filename.string(), parseResult.errors()[0].message));
     }
+    return {};
+  });
+  if(readResult.invalid())
+  {
+    return ConvertResult(std::move(readResult));
+  }
+  if(readResult.value() < totalSize)
+  {
+    return MakeErrorResult(k_RBR_READ_EOF, fmt::format("Read past End Of File (EOF) while parsing file: {}. Expected {} values but only found {}", filename.string(), totalSize, readResult.value()));
   }
 
   return {};
@@ -0,0 +1,240 @@
+#include "DelimitedTextReader.hpp"
+
+#include "complex/Utilities/StringUtilities.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <system_error>
+
+using namespace complex;
+
+namespace
+{
+// -----------------------------------------------------------------------------
+std::string_view TrimmedView(std::string_view str)
+{
+  const usize front = str.find_first_not_of(StringUtilities::k_Whitespaces.view());
+  if(front == std::string_view::npos)
+  {
+    return {};
+  }
+  const usize back = str.find_last_not_of(StringUtilities::k_Whitespaces.view());
+  return str.substr(front, back - front + 1);
+}
+
+#if !defined(__cpp_lib_to_chars)
+/**
+ * @brief Fallback for standard libraries that only implement the integer overloads of
+ * std::from_chars. The token is copied so that strtod does not read past its end.
+ */
+template <typename T, typename FunctionT>
+std::from_chars_result StrToFloatingPoint(const char* first, const char* last, T& value, FunctionT strtoFunction)
+{
+  if(first == last || std::isspace(static_cast<unsigned char>(*first)) != 0)
+  {
+    return {first, std::errc::invalid_argument};
+  }
+  const std::string buffer(first, last);
+  char* end = nullptr;
+  errno = 0;
+  const T parsedValue = strtoFunction(buffer.c_str(), &end);
+  if(end == buffer.c_str())
+  {
+    return {first, std::errc::invalid_argument};
+  }
+  const char* ptr = first + (end - buffer.c_str());
+  if(errno == ERANGE)
+  {
+    return {ptr, std::errc::result_out_of_range};
+  }
+  value = parsedValue;
+  return {ptr, std::errc()};
+}
+#endif
+} // namespace
+
+// -----------------------------------------------------------------------------
+DelimitedTextReader::DelimitedTextReader() = default;
+
+// -----------------------------------------------------------------------------
+DelimitedTextReader::~DelimitedTextReader() noexcept = default;
+
+// -----------------------------------------------------------------------------
+DelimitedTextReader::DelimitedTextReader(DelimitedTextReader&&) noexcept = default;
+
+// -----------------------------------------------------------------------------
+DelimitedTextReader& DelimitedTextReader::operator=(DelimitedTextReader&&) noexcept = default;
+
+// -----------------------------------------------------------------------------
+bool DelimitedTextReader::open(const std::filesystem::path& filePath, usize blockSize)
+{
+  m_FirstLineOfBlock = {0};
+  m_BlockSize = std::max<usize>(blockSize, 1);
+
+  // An empty file cannot be mapped and has no lines
+  std::error_code errorCode;
+  if(std::filesystem::file_size(filePath, errorCode) == 0 && !errorCode)
+  {
+    m_File.reset();
+    return true;
+  }
+
+  try
+  {
+    m_File = std::make_unique<MemoryMappedFile>(filePath, MemoryMappedFile::Mode::ReadOnly);
+  } catch(const std::exception&)
+  {
+    m_File.reset();
+    return false;
+  }
+  m_File->adviseSequential();
+
+  // A line starts at the beginning of the file and after every line feed that is not the last character
+  const char* fileData = data();
+  const usize fileSize = size();
+  const usize numBlocks = (fileSize + m_BlockSize - 1) / m_BlockSize;
+  m_FirstLineOfBlock.assign(numBlocks + 1, 0);
+
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, numBlocks);
+  dataAlg.execute([&](const ComplexRange& range) {
+    for(usize block = range.min(); block < range.max(); block++)
+    {
+      const usize blockBegin = block * m_BlockSize;
+      const usize blockEnd = std::min(blockBegin + m_BlockSize, fileSize);
+      usize count = (block == 0) ? 1 : 0;
+      const usize searchBegin = (block == 0) ? 0 : blockBegin - 1;
+      count += static_cast<usize>(std::count(fileData + searchBegin, fileData + blockEnd - 1, '\n'));
+      m_FirstLineOfBlock[block + 1] = count;
+    }
+  });
+  for(usize block = 1; block <= numBlocks; block++)
+  {
+    m_FirstLineOfBlock[block] += m_FirstLineOfBlock[block - 1];
+  }
+
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+usize DelimitedTextReader::getNumberOfLines() const
+{
+  return m_FirstLineOfBlock.back();
+}
+
+// -----------------------------------------------------------------------------
+const char* DelimitedTextReader::data() const
+{
+  return m_File == nullptr ? nullptr : reinterpret_cast<const char*>(m_File->data());
+}
+
+// -----------------------------------------------------------------------------
+usize DelimitedTextReader::size() const
+{
+  return m_File == nullptr ? 0 : m_File->size();
+}
+
+// -----------------------------------------------------------------------------
+usize DelimitedTextReader::findBlock(usize lineIndex) const
+{
+  // The last block whose first line is not after the line. Blocks that do not contain a
+  // line start share their first line with the following block, so they are skipped.
+  auto iter = std::upper_bound(m_FirstLineOfBlock.cbegin(), m_FirstLineOfBlock.cend() - 1, lineIndex);
+  return static_cast<usize>(std::distance(m_FirstLineOfBlock.cbegin(), iter)) - 1;
+}
+
+// -----------------------------------------------------------------------------
+usize DelimitedTextReader::findFirstLineStart(usize block) const
+{
+  const usize blockBegin = block * m_BlockSize;
+  const usize blockEnd = std::min(blockBegin + m_BlockSize, size());
+  if(block == 0)
+  {
+    return 0;
+  }
+  const char* fileData = data();
+  const void* lineFeed = std::memchr(fileData + blockBegin - 1, '\n', blockEnd - blockBegin);
+  return lineFeed == nullptr ? blockEnd : static_cast<usize>(static_cast<const char*>(lineFeed) - fileData) + 1;
+}
+
+// -----------------------------------------------------------------------------
+usize DelimitedTextReader::findLineOffset(usize lineIndex) const
+{
+  if(lineIndex >= getNumberOfLines())
+  {
+    return size();
+  }
+  usize offset = size();
+  forEachLineInBlock(findBlock(lineIndex), [&](usize index, std::string_view line) {
+    if(index < lineIndex)
+    {
+      return true;
+    }
+    offset = static_cast<usize>(line.data() - data());
+    return false;
+  });
+  return offset;
+}
+
+// -----------------------------------------------------------------------------
+usize DelimitedTextReader::findLineIndex(const char* position) const
+{
+  const char* fileData = data();
+  const usize offset = static_cast<usize>(position - fileData);
+  const usize block = offset / m_BlockSize;
+  usize lineIndex = m_FirstLineOfBlock[block];
+  const usize firstLineStart = findFirstLineStart(block);
+  if(offset < firstLineStart)
+  {
+    // The character is on the last line of a previous block
+    return lineIndex - 1;
+  }
+  return lineIndex + static_cast<usize>(std::count(fileData + firstLineStart, fileData + offset, '\n'));
+}
+
+// -----------------------------------------------------------------------------
+void DelimitedTextReader::SplitLine(std::string_view line, nonstd::span<const char> delimiters, bool consecutiveDelimiters, std::vector<std::string_view>& tokens)
+{
+  tokens.clear();
+  const std::string_view delimiterSet(delimiters.data(), delimiters.size());
+  usize first = 0;
+  while(true)
+  {
+    const usize pos = std::min(line.find_first_of(delimiterSet, first), line.size());
+    if(first != pos)
+    {
+      std::string_view token = TrimmedView(line.substr(first, pos - first));
+      if(!token.empty() || !consecutiveDelimiters)
+      {
+        tokens.push_back(token);
+      }
+    }
+    if(pos == line.size())
+    {
+      break;
+    }
+    first = pos + 1;
+  }
+}
+
+// -----------------------------------------------------------------------------
+std::from_chars_result DelimitedTextReader::FromChars(const char* first, const char* last, float32& value)
+{
+#if defined(__cpp_lib_to_chars)
+  return std::from_chars(first, last, value);
+#else
+  return StrToFloatingPoint(first, last, value, [](const char* str, char** end) { return std::strtof(str, end); });
+#endif
+}
+
+// -----------------------------------------------------------------------------
+std::from_chars_result DelimitedTextReader::FromChars(const char* first, const char* last, float64& value)
+{
+#if defined(__cpp_lib_to_chars)
+  return std::from_chars(first, last, value);
+#else
+  return StrToFloatingPoint(first, last, value, [](const char* str, char** end) { return std::strtod(str, end); });
+#endif
+}
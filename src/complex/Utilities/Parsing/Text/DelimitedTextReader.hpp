@@ -0,0 +1,398 @@
+#pragma once
+
+#include "complex/Common/Result.hpp"
+#include "complex/Common/Types.hpp"
+#include "complex/Utilities/MemoryMappedFile.hpp"
+#include "complex/Utilities/ParallelDataAlgorithm.hpp"
+#include "complex/complex_export.hpp"
+
+#include <fmt/core.h>
+
+#include <nonstd/span.hpp>
+
+#include <atomic>
+#include <charconv>
+#include <filesystem>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace complex
+{
+/**
+ * @class DelimitedTextReader
+ * @brief The DelimitedTextReader class memory maps a text file and hands its lines, or
+ * its individual values, to a callback from multiple threads.
+ *
+ * The file is split into fixed size blocks. Each block owns the lines (and values)
+ * that start inside of it, so the index of the first line of every block is found by
+ * counting the line feeds of the blocks in parallel when the file is opened. Tokens
+ * are string_views into the mapped file and numbers are parsed in place with
+ * std::from_chars, so no per line or per token strings are allocated.
+ */
+class COMPLEX_EXPORT DelimitedTextReader
+{
+public:
+  static constexpr int32 k_InvalidValueError = -100;
+  static constexpr int32 k_ValueOutOfRangeError = -101;
+  static constexpr usize k_DefaultBlockSize = 1ULL << 20;
+
+  DelimitedTextReader();
+  ~DelimitedTextReader() noexcept;
+
+  DelimitedTextReader(const DelimitedTextReader&) = delete;
+  DelimitedTextReader(DelimitedTextReader&&) noexcept;
+  DelimitedTextReader& operator=(const DelimitedTextReader&) = delete;
+  DelimitedTextReader& operator=(DelimitedTextReader&&) noexcept;
+
+  /**
+   * @brief Maps the file and indexes the lines of each block. Returns false if the
+   * file could not be opened. An empty file is opened without being mapped and has
+   * no lines.
+   * @param filePath
+   * @param blockSize Number of bytes in each block that is processed by a single task
+   * @return bool
+   */
+  bool open(const std::filesystem::path& filePath, usize blockSize = k_DefaultBlockSize);
+
+  /**
+   * @brief Returns the number of lines in the file. A final line that is not
+   * terminated by a line feed is counted; an empty line after the last line feed is not.
+   * @return usize
+   */
+  usize getNumberOfLines() const;
+
+  /**
+   * @brief Returns the byte offset of the start of the line. Returns the size of the
+   * file if the line does not exist.
+   * @param lineIndex Zero based line index
+   * @return usize
+   */
+  usize findLineOffset(usize lineIndex) const;
+
+  /**
+   * @brief Returns the zero based index of the line containing the character.
+   * @param position Pointer into the mapped file, such as the data of a token
+   * @return usize
+   */
+  usize findLineIndex(const char* position) const;
+
+  /**
+   * @brief Splits the line into tokens exactly like StringUtilities::split: empty tokens
+   * between two delimiters are dropped, every token is trimmed of white space and tokens
+   * that trim down to nothing are only kept when consecutiveDelimiters is false.
+   * @param line
+   * @param delimiters
+   * @param consecutiveDelimiters
+   * @param tokens Cleared and filled with views into the line
+   */
+  static void SplitLine(std::string_view line, nonstd::span<const char> delimiters, bool consecutiveDelimiters, std::vector<std::string_view>& tokens);
+
+  /**
+   * @brief Parses the whole token as a value of type T. A single leading '+' is accepted.
+   * Returns k_InvalidValueError if the token is not a number and k_ValueOutOfRangeError
+   * if the number does not fit in T, which includes negative numbers for unsigned types.
+   * @tparam T
+   * @param token
+   * @return Result<T>
+   */
+  template <typename T>
+  static Result<T> ParseValue(std::string_view token)
+  {
+    static_assert(std::is_arithmetic_v<T> && !std::is_same_v<T, bool>, "DelimitedTextReader::ParseValue: Unsupported type");
+
+    const char* first = token.data();
+    const char* last = token.data() + token.size();
+    if(first != last && *first == '+' && (last - first) > 1 && first[1] != '-')
+    {
+      first++;
+    }
+    if constexpr(std::is_unsigned_v<T>)
+    {
+      if(first != last && *first == '-')
+      {
+        return MakeErrorResult<T>(k_ValueOutOfRangeError, fmt::format("Overflow error trying to convert '{}' to type '{}'", token, ValueTypeName<T>()));
+      }
+    }
+
+    T value = {};
+    std::from_chars_result result = {};
+    if constexpr(std::is_floating_point_v<T>)
+    {
+      result = FromChars(first, last, value);
+    }
+    else
+    {
+      result = std::from_chars(first, last, value);
+    }
+
+    if(result.ec == std::errc::result_out_of_range)
+    {
+      return MakeErrorResult<T>(k_ValueOutOfRangeError, fmt::format("Overflow error trying to convert '{}' to type '{}'", token, ValueTypeName<T>()));
+    }
+    if(result.ec != std::errc() || result.ptr != last)
+    {
+      return MakeErrorResult<T>(k_InvalidValueError, fmt::format("Error trying to convert '{}' to type '{}'", token, ValueTypeName<T>()));
+    }
+    return {value};
+  }
+
+  /**
+   * @brief Splits each line in [firstLine, firstLine + numLines) into tokens and calls
+   * rowFunction(lineIndex, line, tokens) for it. Lines are processed concurrently, so the
+   * function must be safe to call from multiple threads. Requested lines that are past
+   * the end of the file are passed as empty lines. Returns the error of the first line
+   * (in file order) that failed.
+   * @tparam RowFunction Result<>(usize, std::string_view, nonstd::span<const std::string_view>)
+   * @param firstLine Zero based index of the first line
+   * @param numLines
+   * @param delimiters
+   * @param consecutiveDelimiters
+   * @param rowFunction
+   * @return Result<>
+   */
+  template <typename RowFunction>
+  Result<> forEachRow(usize firstLine, usize numLines, nonstd::span<const char> delimiters, bool consecutiveDelimiters, const RowFunction& rowFunction) const
+  {
+    const usize endLine = firstLine + numLines;
+    const usize endFileLine = std::min(endLine, getNumberOfLines());
+    FirstError firstError;
+    std::vector<std::string_view> tokens;
+
+    if(firstLine < endFileLine)
+    {
+      ParallelDataAlgorithm dataAlg;
+      dataAlg.setRange(findBlock(firstLine), findBlock(endFileLine - 1) + 1);
+      dataAlg.execute([&](const ComplexRange& range) {
+        std::vector<std::string_view> rowTokens;
+        for(usize block = range.min(); block < range.max(); block++)
+        {
+          forEachLineInBlock(block, [&](usize lineIndex, std::string_view line) {
+            if(lineIndex < firstLine)
+            {
+              return true;
+            }
+            if(lineIndex >= endFileLine || lineIndex > firstError.index())
+            {
+              return false;
+            }
+            SplitLine(line, delimiters, consecutiveDelimiters, rowTokens);
+            Result<> result = rowFunction(lineIndex, line, nonstd::span<const std::string_view>(rowTokens.data(), rowTokens.size()));
+            if(result.invalid())
+            {
+              firstError.set(lineIndex, std::move(result));
+              return false;
+            }
+            return true;
+          });
+        }
+      });
+    }
+
+    for(usize lineIndex = std::max(firstLine, endFileLine); lineIndex < endLine && firstError.index() == k_NoError; lineIndex++)
+    {
+      tokens.clear();
+      Result<> result = rowFunction(lineIndex, std::string_view(), nonstd::span<const std::string_view>(tokens.data(), tokens.size()));
+      if(result.invalid())
+      {
+        firstError.set(lineIndex, std::move(result));
+      }
+    }
+
+    return firstError.take();
+  }
+
+  /**
+   * @brief Calls valueFunction(valueIndex, token) for each of the first maxValues tokens
+   * that start on or after firstLine. Tokens are separated by the delimiter and by white
+   * space, regardless of line breaks, like reading values with operator>> from a stream
+   * whose locale treats the delimiter as white space. Tokens are processed concurrently.
+   * Returns the total number of tokens after firstLine, or the error of the first token
+   * (in file order) that failed.
+   * @tparam ValueFunction Result<>(usize, std::string_view)
+   * @param firstLine Zero based index of the first line
+   * @param delimiter
+   * @param maxValues
+   * @param valueFunction
+   * @return Result<usize>
+   */
+  template <typename ValueFunction>
+  Result<usize> forEachValue(usize firstLine, char delimiter, usize maxValues, const ValueFunction& valueFunction) const
+  {
+    const char* fileData = data();
+    const usize fileSize = size();
+    const usize start = findLineOffset(firstLine);
+    if(start >= fileSize)
+    {
+      return {0};
+    }
+
+    auto isSeparator = [delimiter](char character) { return character == delimiter || character == ' ' || (character >= '\t' && character <= '\r'); };
+    auto isTokenStart = [&](usize position) { return !isSeparator(fileData[position]) && (position == start || isSeparator(fileData[position - 1])); };
+
+    const usize firstBlock = start / m_BlockSize;
+    const usize numBlocks = m_FirstLineOfBlock.size() - 1 - firstBlock;
+    auto blockBegin = [&](usize block) { return std::max(block * m_BlockSize, start); };
+    auto blockEnd = [&](usize block) { return std::min((block + 1) * m_BlockSize, fileSize); };
+
+    // Count the tokens that start in each block to find the index of the first token of each block
+    std::vector<usize> firstValueOfBlock(numBlocks + 1, 0);
+    ParallelDataAlgorithm countAlg;
+    countAlg.setRange(firstBlock, firstBlock + numBlocks);
+    countAlg.execute([&](const ComplexRange& range) {
+      for(usize block = range.min(); block < range.max(); block++)
+      {
+        usize count = 0;
+        for(usize position = blockBegin(block); position < blockEnd(block); position++)
+        {
+          count += isTokenStart(position) ? 1 : 0;
+        }
+        firstValueOfBlock[block - firstBlock + 1] = count;
+      }
+    });
+    for(usize i = 1; i <= numBlocks; i++)
+    {
+      firstValueOfBlock[i] += firstValueOfBlock[i - 1];
+    }
+
+    FirstError firstError;
+    ParallelDataAlgorithm parseAlg;
+    parseAlg.setRange(firstBlock, firstBlock + numBlocks);
+    parseAlg.execute([&](const ComplexRange& range) {
+      for(usize block = range.min(); block < range.max(); block++)
+      {
+        usize valueIndex = firstValueOfBlock[block - firstBlock];
+        for(usize position = blockBegin(block); position < blockEnd(block) && valueIndex < maxValues && valueIndex <= firstError.index(); position++)
+        {
+          if(!isTokenStart(position))
+          {
+            continue;
+          }
+          usize tokenEnd = position + 1;
+          while(tokenEnd < fileSize && !isSeparator(fileData[tokenEnd]))
+          {
+            tokenEnd++;
+          }
+          Result<> result = valueFunction(valueIndex, std::string_view(fileData + position, tokenEnd - position));
+          if(result.invalid())
+          {
+            firstError.set(valueIndex, std::move(result));
+            break;
+          }
+          valueIndex++;
+          position = tokenEnd - 1;
+        }
+      }
+    });
+
+    Result<> errorResult = firstError.take();
+    if(errorResult.invalid())
+    {
+      return ConvertResultTo<usize>(std::move(errorResult), {});
+    }
+    return {firstValueOfBlock[numBlocks]};
+  }
+
+private:
+  static constexpr usize k_NoError = std::numeric_limits<usize>::max();
+
+  /**
+   * @brief Keeps the error with the lowest index reported by any thread.
+   */
+  class FirstError
+  {
+  public:
+    usize index() const
+    {
+      return m_Index.load(std::memory_order_relaxed);
+    }
+
+    void set(usize index, Result<>&& result)
+    {
+      std::lock_guard<std::mutex> lock(m_Mutex);
+      if(index < m_Index.load(std::memory_order_relaxed))
+      {
+        m_Index = index;
+        m_Result = std::move(result);
+      }
+    }
+
+    Result<> take()
+    {
+      return std::move(m_Result);
+    }
+
+  private:
+    std::atomic<usize> m_Index = k_NoError;
+    std::mutex m_Mutex;
+    Result<> m_Result;
+  };
+
+  template <typename T>
+  static std::string ValueTypeName()
+  {
+    if constexpr(std::is_floating_point_v<T>)
+    {
+      return fmt::format("float{}", sizeof(T) * 8);
+    }
+    else
+    {
+      return fmt::format("{}int{}", std::is_unsigned_v<T> ? "u" : "", sizeof(T) * 8);
+    }
+  }
+
+  static std::from_chars_result FromChars(const char* first, const char* last, float32& value);
+  static std::from_chars_result FromChars(const char* first, const char* last, float64& value);
+
+  const char* data() const;
+  usize size() const;
+
+  /**
+   * @brief Returns the block that owns the line.
+   * @param lineIndex
+   * @return usize
+   */
+  usize findBlock(usize lineIndex) const;
+
+  /**
+   * @brief Returns the offset of the first line that starts inside of the block or the
+   * end of the block if no line starts inside of it.
+   * @param block
+   * @return usize
+   */
+  usize findFirstLineStart(usize block) const;
+
+  /**
+   * @brief Calls lineFunction(lineIndex, line) for the lines that start in the block until
+   * it returns false. The line does not include its line feed.
+   * @param block
+   * @param lineFunction
+   */
+  template <typename LineFunction>
+  void forEachLineInBlock(usize block, const LineFunction& lineFunction) const
+  {
+    const char* fileData = data();
+    const usize fileSize = size();
+    const usize blockEnd = std::min((block + 1) * m_BlockSize, fileSize);
+    usize lineIndex = m_FirstLineOfBlock[block];
+    for(usize position = findFirstLineStart(block); position < blockEnd; lineIndex++)
+    {
+      std::string_view remaining(fileData + position, fileSize - position);
+      const usize lineLength = std::min(remaining.find('\n'), remaining.size());
+      if(!lineFunction(lineIndex, remaining.substr(0, lineLength)))
+      {
+        return;
+      }
+      position += lineLength + 1;
+    }
+  }
+
+  std::unique_ptr<MemoryMappedFile> m_File;
+  usize m_BlockSize = k_DefaultBlockSize;
+  std::vector<usize> m_FirstLineOfBlock = {0};
+};
+} // namespace complex
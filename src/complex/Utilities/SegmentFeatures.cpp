@@ -2,6 +2,10 @@
 
 #include "complex/DataStructure/Geometry/AbstractGeometryGrid.hpp"
 
+#include <algorithm>
+#include <numeric>
+#include <string>
+
 using namespace complex;
 
 // -----------------------------------------------------------------------------
@@ -126,6 +130,88 @@ Result<> SegmentFeatures::execute(AbstractGeometryGrid* gridGeom)
   return {};
 }
 
+// -----------------------------------------------------------------------------
+SizeVec3 SegmentFeatures::GetGridDimensions(const AbstractGeometryGrid* gridGeom)
+{
+  return gridGeom->getDimensions();
+}
+
+// -----------------------------------------------------------------------------
+Result<usize> SegmentFeatures::mergeSlabLabels(nonstd::span<int32> featureIds, const SizeVec3& dims, const std::vector<SlabLabels>& slabs,
+                                               const std::vector<std::pair<usize, usize>>& equivalentLabels) const
+{
+  usize numLabels = slabs.empty() ? 0 : slabs.back().labelOffset + slabs.back().numLabels;
+
+  // Union-find over the labels of all slabs. The root of each set is always its
+  // lowest label, which is also the label of the lowest voxel in the feature.
+  std::vector<usize> parents(numLabels + 1);
+  std::iota(parents.begin(), parents.end(), 0);
+  auto findRoot = [&parents](usize label) {
+    while(parents[label] != label)
+    {
+      parents[label] = parents[parents[label]];
+      label = parents[label];
+    }
+    return label;
+  };
+  for(const auto& [label1, label2] : equivalentLabels)
+  {
+    usize root1 = findRoot(label1);
+    usize root2 = findRoot(label2);
+    if(root1 < root2)
+    {
+      parents[root2] = root1;
+    }
+    else if(root2 < root1)
+    {
+      parents[root1] = root2;
+    }
+  }
+
+  // Number the features in the order of their lowest label
+  std::vector<int32> featureNumbers(numLabels + 1, 0);
+  usize numFeatures = 0;
+  for(usize label = 1; label <= numLabels; label++)
+  {
+    usize root = findRoot(label);
+    if(root == label)
+    {
+      numFeatures++;
+      if(numFeatures > static_cast<usize>(std::numeric_limits<int32>::max()))
+      {
+        return MakeErrorResult<usize>(-87001, fmt::format("The number of Features exceeds the maximum Feature Id of {}", std::numeric_limits<int32>::max()));
+      }
+      featureNumbers[label] = static_cast<int32>(numFeatures);
+    }
+    else
+    {
+      featureNumbers[label] = featureNumbers[root];
+    }
+  }
+
+  const usize planeSize = dims[0] * dims[1];
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, slabs.size());
+  dataAlg.execute([&](const ComplexRange& range) {
+    for(usize slabIndex = range.min(); slabIndex < range.max(); slabIndex++)
+    {
+      const SlabLabels& slab = slabs[slabIndex];
+      for(usize point = slab.zStart * planeSize; point < slab.zEnd * planeSize; point++)
+      {
+        if(featureIds[point] > 0)
+        {
+          featureIds[point] = featureNumbers[slab.labelOffset + featureIds[point]];
+        }
+      }
+    }
+  });
+
+  m_MessageHandler({IFilter::Message::Type::Info, fmt::format("Total Features Found: {}", numFeatures)});
+
+  return {numFeatures};
+}
+
+// -----------------------------------------------------------------------------
 int64 SegmentFeatures::getSeed(int32 gnum, int64 nextSeed) const
 {
   return -1;
@@ -156,14 +242,8 @@ void SegmentFeatures::randomizeFeatureIds(complex::Int32Array* featureIds, uint6
   const int64 rangeMax = totalFeatures - 1;
   auto generator = initializeVoxelSeedGenerator(distribution, rangeMin, rangeMax);
 
-  DataStructure tmpStructure;
-  auto rndNumbers = Int64Array::CreateWithStore<DataStore<int64>>(tmpStructure, std::string("_INTERNAL_USE_ONLY_NewFeatureIds"), std::vector<usize>{totalFeatures}, std::vector<usize>{1});
-  auto rndStore = rndNumbers->getDataStore();
-
-  for(int64 i = 0; i < totalFeatures; ++i)
-  {
-    rndStore->setValue(i, i);
-  }
+  std::vector<int64> rndNumbers(totalFeatures);
+  std::iota(rndNumbers.begin(), rndNumbers.end(), 0);
 
   int64 r = 0;
   int64 temp = 0;
@@ -176,15 +256,17 @@ void SegmentFeatures::randomizeFeatureIds(complex::Int32Array* featureIds, uint6
     {
       continue;
     }
-    temp = rndStore->getValue(i);
-    rndStore->setValue(i, rndStore->getValue(r));
-    rndStore->setValue(r, temp);
+    temp = rndNumbers[i];
+    rndNumbers[i] = rndNumbers[r];
+    rndNumbers[r] = temp;
   }
 
   // Now adjust all the Grain Id values for each Voxel
-  auto featureIdsStore = featureIds->getDataStore();
-  for(int64 i = 0; i < totalPoints; ++i)
-  {
-    featureIdsStore->setValue(i, rndStore->getValue(featureIdsStore->getValue(i)));
-  }
+  featureIds->getDataStoreRef().forEachChunk(0, [&rndNumbers, totalPoints](usize startIndex, nonstd::span<int32> featureIdsChunk) {
+    const usize count = startIndex < totalPoints ? std::min<usize>(featureIdsChunk.size(), totalPoints - startIndex) : 0;
+    for(usize i = 0; i < count; i++)
+    {
+      featureIdsChunk[i] = static_cast<int32>(rndNumbers[featureIdsChunk[i]]);
+    }
+  });
 }
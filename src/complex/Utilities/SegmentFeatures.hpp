@@ -7,8 +7,16 @@
 #include "complex/DataStructure/IDataArray.hpp"
 #include "complex/Filter/Arguments.hpp"
 #include "complex/Filter/IFilter.hpp"
+#include "complex/Utilities/ParallelData3DAlgorithm.hpp"
+#include "complex/Utilities/ParallelDataAlgorithm.hpp"
 
+#include <nonstd/span.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <mutex>
 #include <random>
+#include <utility>
 #include <vector>
 
 namespace complex
@@ -39,6 +47,23 @@ public:
    */
   Result<> execute(complex::AbstractGeometryGrid* gridGeom);
 
+  /**
+   * @brief Segments the grid in parallel. Each range of Z planes is flood filled
+   * on its own, the labels that touch across the plane boundaries are merged with
+   * a union-find and the features are numbered in the order of their lowest voxel
+   * index. This is the same numbering the serial seed search in execute() gives.
+   *
+   * The comparison is called from multiple threads and must not modify any data.
+   * @tparam CompareT Callable with the signature bool(int64 referencePoint, int64 neighborPoint)
+   * @param gridGeom
+   * @param featureIds Zero initialized Feature Ids that receive the segmentation
+   * @param goodVoxels Mask of the voxels that may be segmented. All voxels are used if empty.
+   * @param compare
+   * @return Result<usize> The number of features found, not counting feature 0
+   */
+  template <typename CompareT>
+  Result<usize> executeParallel(AbstractGeometryGrid* gridGeom, nonstd::span<int32> featureIds, nonstd::span<const bool> goodVoxels, const CompareT& compare);
+
   /**
    * @brief Returns the seed for the specified values.
    * @param data
@@ -95,6 +120,35 @@ public:
   };
 
 protected:
+  /**
+   * @brief The range of Z planes labeled by one task of executeParallel().
+   */
+  struct SlabLabels
+  {
+    usize zStart = 0;
+    usize zEnd = 0;
+    usize numLabels = 0;
+    usize labelOffset = 0;
+  };
+
+  /**
+   * @brief Returns the dimensions of the grid geometry.
+   * @param gridGeom
+   * @return SizeVec3
+   */
+  static SizeVec3 GetGridDimensions(const AbstractGeometryGrid* gridGeom);
+
+  /**
+   * @brief Merges the labels of each slab that were found to belong to the same
+   * feature and rewrites the Feature Ids with the final, ordered feature numbers.
+   * @param featureIds
+   * @param dims
+   * @param slabs The slabs sorted by Z with their label offsets set
+   * @param equivalentLabels Pairs of global labels that belong to the same feature
+   * @return Result<usize> The number of features found
+   */
+  Result<usize> mergeSlabLabels(nonstd::span<int32> featureIds, const SizeVec3& dims, const std::vector<SlabLabels>& slabs, const std::vector<std::pair<usize, usize>>& equivalentLabels) const;
+
   DataStructure& m_DataStructure;
   const std::atomic_bool& m_ShouldCancel;
   const IFilter::MessageHandler& m_MessageHandler;
@@ -102,4 +156,104 @@ protected:
 private:
 };
 
+// -----------------------------------------------------------------------------
+template <typename CompareT>
+Result<usize> SegmentFeatures::executeParallel(AbstractGeometryGrid* gridGeom, nonstd::span<int32> featureIds, nonstd::span<const bool> goodVoxels, const CompareT& compare)
+{
+  const SizeVec3 dims = GetGridDimensions(gridGeom);
+  const auto numX = static_cast<int64>(dims[0]);
+  const auto numY = static_cast<int64>(dims[1]);
+  const int64 planeSize = numX * numY;
+
+  std::vector<SlabLabels> slabs;
+  std::mutex mutex;
+
+  // Flood fill each slab, numbering its features from 1 in the order of their first voxel
+  ParallelData3DAlgorithm slabAlg;
+  slabAlg.setRange(dims[0], dims[1], dims[2]);
+  slabAlg.execute([&](const ComplexRange3D& range) {
+    const auto zStart = static_cast<int64>(range[4]);
+    const auto zEnd = static_cast<int64>(range[5]);
+    std::vector<int64> voxelsList;
+    int32 label = 0;
+    for(int64 seed = zStart * planeSize; seed < zEnd * planeSize; seed++)
+    {
+      if(m_ShouldCancel)
+      {
+        return;
+      }
+      if(featureIds[seed] != 0 || (!goodVoxels.empty() && !goodVoxels[seed]))
+      {
+        continue;
+      }
+      label++;
+      featureIds[seed] = label;
+      voxelsList.push_back(seed);
+      while(!voxelsList.empty())
+      {
+        const int64 currentPoint = voxelsList.back();
+        voxelsList.pop_back();
+        const int64 col = currentPoint % numX;
+        const int64 row = (currentPoint / numX) % numY;
+        const int64 plane = currentPoint / planeSize;
+        const std::array<bool, 6> isValid = {plane > zStart, row > 0, col > 0, col < numX - 1, row < numY - 1, plane < zEnd - 1};
+        const std::array<int64, 6> neighPoints = {-planeSize, -numX, -1, 1, numX, planeSize};
+        for(usize i = 0; i < 6; i++)
+        {
+          const int64 neighbor = currentPoint + neighPoints[i];
+          if(isValid[i] && featureIds[neighbor] == 0 && (goodVoxels.empty() || goodVoxels[neighbor]) && compare(currentPoint, neighbor))
+          {
+            featureIds[neighbor] = label;
+            voxelsList.push_back(neighbor);
+          }
+        }
+      }
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    slabs.push_back({static_cast<usize>(zStart), static_cast<usize>(zEnd), static_cast<usize>(label), 0});
+  });
+  if(m_ShouldCancel)
+  {
+    return {0};
+  }
+
+  std::sort(slabs.begin(), slabs.end(), [](const SlabLabels& lhs, const SlabLabels& rhs) { return lhs.zStart < rhs.zStart; });
+  usize numLabels = 0;
+  for(auto& slab : slabs)
+  {
+    slab.labelOffset = numLabels;
+    numLabels += slab.numLabels;
+  }
+
+  // Find the labels that are connected across the first plane of each slab
+  std::vector<std::pair<usize, usize>> equivalentLabels;
+  ParallelDataAlgorithm boundaryAlg;
+  boundaryAlg.setRange(1, std::max<usize>(slabs.size(), 1));
+  boundaryAlg.execute([&](const ComplexRange& range) {
+    std::vector<std::pair<usize, usize>> localLabels;
+    for(usize slabIndex = range.min(); slabIndex < range.max(); slabIndex++)
+    {
+      const SlabLabels& slab = slabs[slabIndex];
+      const SlabLabels& previousSlab = slabs[slabIndex - 1];
+      const auto planeStart = static_cast<int64>(slab.zStart) * planeSize;
+      for(int64 point = planeStart; point < planeStart + planeSize; point++)
+      {
+        const int64 neighbor = point - planeSize;
+        if(featureIds[point] == 0 || featureIds[neighbor] == 0 || !compare(point, neighbor))
+        {
+          continue;
+        }
+        std::pair<usize, usize> labels = {slab.labelOffset + featureIds[point], previousSlab.labelOffset + featureIds[neighbor]};
+        if(localLabels.empty() || localLabels.back() != labels)
+        {
+          localLabels.push_back(labels);
+        }
+      }
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    equivalentLabels.insert(equivalentLabels.end(), localLabels.cbegin(), localLabels.cend());
+  });
+
+  return mergeSlabLabels(featureIds, dims, slabs, equivalentLabels);
+}
 } // namespace complex
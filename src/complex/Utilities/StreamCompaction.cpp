@@ -0,0 +1,90 @@
+#include "StreamCompaction.hpp"
+
+#include "complex/DataStructure/DataArray.hpp"
+#include "complex/Utilities/FilterUtilities.hpp"
+
+#include <fmt/core.h>
+
+#include <stdexcept>
+
+using namespace complex;
+
+namespace
+{
+/**
+ * @brief Gathers the kept tuples into the destination. Each destination tuple is
+ * written by a single thread, so the copy runs in parallel when both data stores can
+ * be accessed as spans.
+ */
+struct CopyKeptTuplesFunctor
+{
+  template <typename T>
+  void operator()(const IDataArray& source, IDataArray& destination, nonstd::span<const usize> keptIndices)
+  {
+    const auto& sourceStore = dynamic_cast<const DataArray<T>&>(source).getDataStoreRef();
+    auto& destinationStore = dynamic_cast<DataArray<T>&>(destination).getDataStoreRef();
+    const usize numComps = sourceStore.getNumberOfComponents();
+
+    if(!sourceStore.isContiguous() || !destinationStore.isContiguous())
+    {
+      for(usize i = 0; i < keptIndices.size(); i++)
+      {
+        for(usize comp = 0; comp < numComps; comp++)
+        {
+          destinationStore[i * numComps + comp] = sourceStore[keptIndices[i] * numComps + comp];
+        }
+      }
+      return;
+    }
+
+    const auto sourceValues = sourceStore.createSpan();
+    auto destinationValues = destinationStore.createSpan();
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(0, keptIndices.size());
+    dataAlg.execute([&](const ComplexRange& range) {
+      for(usize i = range.min(); i < range.max(); i++)
+      {
+        std::copy_n(sourceValues.begin() + keptIndices[i] * numComps, numComps, destinationValues.begin() + i * numComps);
+      }
+    });
+  }
+};
+} // namespace
+
+namespace complex
+{
+namespace StreamCompaction
+{
+// -----------------------------------------------------------------------------
+std::vector<usize> FindKeptIndices(nonstd::span<const bool> mask)
+{
+  return FindKeptIndices(mask.size(), [mask](usize i) { return mask[i]; });
+}
+
+// -----------------------------------------------------------------------------
+std::vector<usize> CreateIndexMap(nonstd::span<const usize> keptIndices, usize count)
+{
+  std::vector<usize> indexMap(count, k_Removed);
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, keptIndices.size());
+  dataAlg.execute([&](const ComplexRange& range) {
+    for(usize i = range.min(); i < range.max(); i++)
+    {
+      indexMap[keptIndices[i]] = i;
+    }
+  });
+  return indexMap;
+}
+
+// -----------------------------------------------------------------------------
+void CopyKeptTuples(const IDataArray& source, IDataArray& destination, nonstd::span<const usize> keptIndices)
+{
+  if(source.getDataType() != destination.getDataType() || source.getNumberOfComponents() != destination.getNumberOfComponents())
+  {
+    throw std::runtime_error(fmt::format("CopyKeptTuples: The array '{}' does not have the type and number of components of the array '{}'", destination.getName(), source.getName()));
+  }
+  destination.getIDataStore()->reshapeTuples({keptIndices.size()});
+  ExecuteDataFunction(CopyKeptTuplesFunctor{}, source.getDataType(), source, destination, keptIndices);
+}
+} // namespace StreamCompaction
+} // namespace complex
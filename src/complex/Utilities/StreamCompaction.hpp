@@ -0,0 +1,112 @@
+#pragma once
+
+#include "complex/Common/Types.hpp"
+#include "complex/Utilities/ParallelDataAlgorithm.hpp"
+#include "complex/complex_export.hpp"
+
+#include <nonstd/span.hpp>
+
+#include <limits>
+#include <vector>
+
+namespace complex
+{
+class IDataArray;
+
+namespace StreamCompaction
+{
+/**
+ * @brief The value of an index map entry whose index was removed.
+ */
+inline constexpr usize k_Removed = std::numeric_limits<usize>::max();
+
+/**
+ * @brief Each range of the compaction holds at least this many indices.
+ */
+inline constexpr usize k_MinIndicesPerRange = 1 << 16;
+
+/**
+ * @brief Returns the indices in [0, count) for which keep(index) is true in
+ * increasing order. The indices are split into a fixed set of ranges; the number
+ * of kept indices of every range is counted in parallel, the counts are prefix
+ * summed and each range then writes its kept indices at its own offset. The
+ * predicate is evaluated twice per index and must be safe to call from several
+ * threads.
+ * @tparam PredicateT bool(usize)
+ * @param count
+ * @param keep
+ * @return std::vector<usize>
+ */
+template <typename PredicateT>
+std::vector<usize> FindKeptIndices(usize count, PredicateT&& keep)
+{
+  const usize numRanges = GetNumRanges(count, k_MinIndicesPerRange);
+
+  std::vector<usize> rangeOffsets(numRanges + 1, 0);
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, numRanges);
+  dataAlg.execute([&](const ComplexRange& ranges) {
+    for(usize range = ranges.min(); range < ranges.max(); range++)
+    {
+      usize numKept = 0;
+      const ComplexRange indices = GetRange(count, numRanges, range);
+      for(usize i = indices.min(); i < indices.max(); i++)
+      {
+        numKept += keep(i) ? 1 : 0;
+      }
+      rangeOffsets[range + 1] = numKept;
+    }
+  });
+  for(usize range = 0; range < numRanges; range++)
+  {
+    rangeOffsets[range + 1] += rangeOffsets[range];
+  }
+
+  std::vector<usize> keptIndices(rangeOffsets.back());
+  dataAlg.execute([&](const ComplexRange& ranges) {
+    for(usize range = ranges.min(); range < ranges.max(); range++)
+    {
+      usize position = rangeOffsets[range];
+      const ComplexRange indices = GetRange(count, numRanges, range);
+      for(usize i = indices.min(); i < indices.max(); i++)
+      {
+        if(keep(i))
+        {
+          keptIndices[position++] = i;
+        }
+      }
+    }
+  });
+  return keptIndices;
+}
+
+/**
+ * @brief Returns the indices of the true values of the mask in increasing order.
+ * @param mask
+ * @return std::vector<usize>
+ */
+COMPLEX_EXPORT std::vector<usize> FindKeptIndices(nonstd::span<const bool> mask);
+
+/**
+ * @brief Returns the new index of each of the count old indices, where keptIndices
+ * lists the old index of every new index. Old indices that were not kept map to
+ * k_Removed.
+ * @param keptIndices
+ * @param count
+ * @return std::vector<usize>
+ */
+COMPLEX_EXPORT std::vector<usize> CreateIndexMap(nonstd::span<const usize> keptIndices, usize count);
+
+/**
+ * @brief Resizes the destination to one tuple per kept index and copies the kept
+ * tuples of the source into it in parallel. Both arrays must have the same type and
+ * number of components.
+ *
+ * Throws a runtime_error if the arrays do not match.
+ * @param source
+ * @param destination
+ * @param keptIndices
+ */
+COMPLEX_EXPORT void CopyKeptTuples(const IDataArray& source, IDataArray& destination, nonstd::span<const usize> keptIndices);
+} // namespace StreamCompaction
+} // namespace complex
@@ -0,0 +1,262 @@
+#include <catch2/catch.hpp>
+
+#include "complex/Common/Array.hpp"
+#include "complex/Common/Result.hpp"
+#include "complex/Common/Types.hpp"
+#include "complex/DataStructure/DataArray.hpp"
+#include "complex/DataStructure/DataStore.hpp"
+#include "complex/DataStructure/DataStructure.hpp"
+#include "complex/Utilities/BadVoxelFill.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace complex;
+
+namespace
+{
+/**
+ * @brief The Feature Ids and two multi-component cell arrays of one image geometry.
+ */
+struct VoxelArrays
+{
+  Int32Array* featureIds = nullptr;
+  Float32Array* vectors = nullptr;
+  UInt8Array* colors = nullptr;
+};
+
+/**
+ * @brief Creates the arrays with the given Feature Ids. Every tuple of the cell arrays
+ * holds values derived from its voxel index, so the copied tuples can be told apart.
+ */
+VoxelArrays CreateVoxelArrays(DataStructure& dataGraph, const std::string& prefix, const SizeVec3& dims, const std::vector<int32>& featureIdValues)
+{
+  const std::vector<usize> tupleShape = {dims[2], dims[1], dims[0]};
+  VoxelArrays arrays;
+  arrays.featureIds = Int32Array::CreateWithStore<Int32DataStore>(dataGraph, prefix + "FeatureIds", tupleShape, {1});
+  arrays.vectors = Float32Array::CreateWithStore<Float32DataStore>(dataGraph, prefix + "Vectors", tupleShape, {3});
+  arrays.colors = UInt8Array::CreateWithStore<UInt8DataStore>(dataGraph, prefix + "Colors", tupleShape, {4});
+  REQUIRE(arrays.featureIds != nullptr);
+  REQUIRE(arrays.vectors != nullptr);
+  REQUIRE(arrays.colors != nullptr);
+
+  for(usize i = 0; i < featureIdValues.size(); i++)
+  {
+    (*arrays.featureIds)[i] = featureIdValues[i];
+    for(usize component = 0; component < 3; component++)
+    {
+      (*arrays.vectors)[i * 3 + component] = static_cast<float32>(i) + 0.25f * static_cast<float32>(component);
+    }
+    for(usize component = 0; component < 4; component++)
+    {
+      (*arrays.colors)[i * 4 + component] = static_cast<uint8>((i * 7 + component * 31) % 256);
+    }
+  }
+  return arrays;
+}
+
+/**
+ * @brief The repeated full-volume sweep that FillBadVoxels replaced. A pass picks the
+ * neighbor with the most common Feature Id for every bad voxel and then copies the
+ * tuples. Unlike the original it stops once a pass fills nothing instead of looping
+ * forever on bad regions without good neighbors.
+ */
+void SweepBadVoxels(Int32Array& featureIds, const SizeVec3& udims, const std::vector<IDataArray*>& voxelArrays)
+{
+  const std::array<int64, 3> dims = {static_cast<int64>(udims[0]), static_cast<int64>(udims[1]), static_cast<int64>(udims[2])};
+  const std::array<int64, 6> neighpoints = {-dims[0] * dims[1], -dims[0], -1, 1, dims[0], dims[0] * dims[1]};
+  const usize totalPoints = featureIds.getNumberOfTuples();
+
+  int32 maxFeatureId = 0;
+  for(usize i = 0; i < totalPoints; i++)
+  {
+    maxFeatureId = std::max(maxFeatureId, featureIds[i]);
+  }
+  std::vector<int32> n(maxFeatureId + 1, 0);
+  std::vector<int64> neighbors(totalPoints, -1);
+
+  usize numFilled = 1;
+  while(numFilled != 0)
+  {
+    for(int64 k = 0; k < dims[2]; k++)
+    {
+      for(int64 j = 0; j < dims[1]; j++)
+      {
+        for(int64 i = 0; i < dims[0]; i++)
+        {
+          const int64 count = (k * dims[1] + j) * dims[0] + i;
+          if(featureIds[count] >= 0)
+          {
+            continue;
+          }
+          const std::array<bool, 6> isValid = {k > 0, j > 0, i > 0, i < dims[0] - 1, j < dims[1] - 1, k < dims[2] - 1};
+          int32 most = 0;
+          for(usize l = 0; l < 6; l++)
+          {
+            const int32 feature = isValid[l] ? featureIds[count + neighpoints[l]] : -1;
+            if(feature >= 0)
+            {
+              n[feature]++;
+              if(n[feature] > most)
+              {
+                most = n[feature];
+                neighbors[count] = count + neighpoints[l];
+              }
+            }
+          }
+          for(usize l = 0; l < 6; l++)
+          {
+            const int32 feature = isValid[l] ? featureIds[count + neighpoints[l]] : -1;
+            if(feature >= 0)
+            {
+              n[feature] = 0;
+            }
+          }
+        }
+      }
+    }
+
+    numFilled = 0;
+    for(usize j = 0; j < totalPoints; j++)
+    {
+      const int64 neighbor = neighbors[j];
+      if(featureIds[j] < 0 && neighbor >= 0 && featureIds[neighbor] >= 0)
+      {
+        for(IDataArray* voxelArray : voxelArrays)
+        {
+          voxelArray->copyTuple(neighbor, j);
+        }
+        numFilled++;
+      }
+    }
+  }
+}
+
+/**
+ * @brief Fills the bad voxels with FillBadVoxels and with the sweep and checks that the
+ * Feature Ids and every cell array end up the same.
+ */
+void CompareWithSweep(const SizeVec3& dims, const std::vector<int32>& featureIdValues, bool includeFeatureIds)
+{
+  DataStructure dataGraph;
+  VoxelArrays filled = CreateVoxelArrays(dataGraph, "Filled", dims, featureIdValues);
+  VoxelArrays swept = CreateVoxelArrays(dataGraph, "Swept", dims, featureIdValues);
+
+  std::vector<IDataArray*> filledArrays = {filled.vectors, filled.colors};
+  if(includeFeatureIds)
+  {
+    filledArrays.push_back(filled.featureIds);
+  }
+  const std::atomic_bool shouldCancel = false;
+  REQUIRE(FillBadVoxels(*filled.featureIds, dims, filledArrays, shouldCancel).valid());
+
+  // The sweep only updated the Feature Ids when they were among the voxel arrays
+  SweepBadVoxels(*swept.featureIds, dims, {swept.featureIds, swept.vectors, swept.colors});
+
+  REQUIRE(std::equal(filled.featureIds->begin(), filled.featureIds->end(), swept.featureIds->begin()));
+  REQUIRE(std::equal(filled.vectors->begin(), filled.vectors->end(), swept.vectors->begin()));
+  REQUIRE(std::equal(filled.colors->begin(), filled.colors->end(), swept.colors->begin()));
+}
+} // namespace
+
+TEST_CASE("complex::FillBadVoxels Matches Sweep", "[complex][BadVoxelFill]")
+{
+  // Blocks of 12 features with about a third of the voxels marked bad. Voxels on the
+  // boundary between blocks often see two features equally often.
+  const SizeVec3 dims = {24, 20, 16};
+  std::vector<int32> featureIdValues(dims[0] * dims[1] * dims[2]);
+  std::mt19937 generator(5489);
+  for(usize z = 0; z < dims[2]; z++)
+  {
+    for(usize y = 0; y < dims[1]; y++)
+    {
+      for(usize x = 0; x < dims[0]; x++)
+      {
+        const usize index = (z * dims[1] + y) * dims[0] + x;
+        const bool isBad = generator() % 3 == 0;
+        featureIdValues[index] = isBad ? -1 : static_cast<int32>(1 + x / 8 + 3 * (y / 10) + 6 * (z / 8));
+      }
+    }
+  }
+  // A bad slab several voxels thick that is filled over several passes
+  for(usize z = 6; z < 11; z++)
+  {
+    for(usize i = z * dims[0] * dims[1]; i < (z + 1) * dims[0] * dims[1]; i++)
+    {
+      featureIdValues[i] = -1;
+    }
+  }
+
+  SECTION("Feature Ids Selected")
+  {
+    CompareWithSweep(dims, featureIdValues, true);
+  }
+  SECTION("Feature Ids Not Selected")
+  {
+    CompareWithSweep(dims, featureIdValues, false);
+  }
+}
+
+TEST_CASE("complex::FillBadVoxels Ties", "[complex][BadVoxelFill]")
+{
+  const std::atomic_bool shouldCancel = false;
+
+  // Each bad voxel has two good neighbors of different features. The first neighbor in
+  // -Z, -Y, -X, +X, +Y, +Z order wins.
+  for(usize axis = 0; axis < 3; axis++)
+  {
+    SizeVec3 dims = {1, 1, 1};
+    dims[axis] = 3;
+    DataStructure dataGraph;
+    VoxelArrays arrays = CreateVoxelArrays(dataGraph, "", dims, {5, -1, 7});
+    REQUIRE(FillBadVoxels(*arrays.featureIds, dims, {arrays.vectors, arrays.colors}, shouldCancel).valid());
+
+    REQUIRE((*arrays.featureIds)[1] == 5);
+    REQUIRE((*arrays.vectors)[3] == (*arrays.vectors)[0]);
+    REQUIRE((*arrays.colors)[4 + 3] == (*arrays.colors)[3]);
+  }
+
+  // Two neighbors of feature 7 outnumber the first neighbor of feature 5
+  const SizeVec3 dims = {3, 3, 1};
+  DataStructure dataGraph;
+  VoxelArrays arrays = CreateVoxelArrays(dataGraph, "", dims, {0, 5, 0, 0, -1, 7, 0, 7, 0});
+  REQUIRE(FillBadVoxels(*arrays.featureIds, dims, {arrays.vectors, arrays.colors}, shouldCancel).valid());
+  REQUIRE((*arrays.featureIds)[4] == 7);
+  REQUIRE((*arrays.vectors)[4 * 3] == (*arrays.vectors)[7 * 3]);
+}
+
+TEST_CASE("complex::FillBadVoxels Isolated Region", "[complex][BadVoxelFill]")
+{
+  // Without any good voxel there is nothing to fill from, so nothing may change
+  const SizeVec3 dims = {6, 5, 4};
+  const std::vector<int32> featureIdValues(dims[0] * dims[1] * dims[2], -1);
+  DataStructure dataGraph;
+  VoxelArrays filled = CreateVoxelArrays(dataGraph, "Filled", dims, featureIdValues);
+  VoxelArrays original = CreateVoxelArrays(dataGraph, "Original", dims, featureIdValues);
+
+  const std::atomic_bool shouldCancel = false;
+  REQUIRE(FillBadVoxels(*filled.featureIds, dims, {filled.featureIds, filled.vectors, filled.colors}, shouldCancel).valid());
+
+  REQUIRE(std::equal(filled.featureIds->begin(), filled.featureIds->end(), original.featureIds->begin()));
+  REQUIRE(std::equal(filled.vectors->begin(), filled.vectors->end(), original.vectors->begin()));
+  REQUIRE(std::equal(filled.colors->begin(), filled.colors->end(), original.colors->begin()));
+}
+
+TEST_CASE("complex::FillBadVoxels Cancel", "[complex][BadVoxelFill]")
+{
+  // A cancelled fill reports an error and leaves the bad voxels it did not reach
+  const SizeVec3 dims = {5, 4, 3};
+  std::vector<int32> featureIdValues(dims[0] * dims[1] * dims[2], -1);
+  featureIdValues[0] = 3;
+  DataStructure dataGraph;
+  VoxelArrays filled = CreateVoxelArrays(dataGraph, "Filled", dims, featureIdValues);
+
+  const std::atomic_bool shouldCancel = true;
+  Result<> result = FillBadVoxels(*filled.featureIds, dims, {filled.featureIds, filled.vectors, filled.colors}, shouldCancel);
+  REQUIRE(result.invalid());
+  REQUIRE(std::equal(featureIdValues.cbegin(), featureIdValues.cend(), filled.featureIds->begin()));
+}
@@ -0,0 +1,81 @@
+#include <catch2/catch.hpp>
+
+#include "complex/Common/Types.hpp"
+#include "complex/Utilities/CompressedRows.hpp"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace complex;
+
+namespace
+{
+constexpr usize k_NumRows = 1000;
+constexpr usize k_NumSources = 50000;
+
+/**
+ * @brief Random pairs of rows for every source. A source may add itself to the same
+ * row twice and some rows are never used.
+ */
+std::vector<usize> CreateSourceRows()
+{
+  std::vector<usize> sourceRows(k_NumSources * 2);
+  std::mt19937 generator(5489);
+  std::uniform_int_distribution<usize> rowDistribution(0, k_NumRows - 101);
+  for(usize& row : sourceRows)
+  {
+    row = rowDistribution(generator);
+  }
+  return sourceRows;
+}
+
+/**
+ * @brief Groups the sources by row with a serial loop.
+ */
+std::vector<std::vector<int32>> GroupSerial(const std::vector<usize>& sourceRows)
+{
+  std::vector<std::vector<int32>> rows(k_NumRows);
+  for(usize i = 0; i < sourceRows.size(); i++)
+  {
+    rows[sourceRows[i]].push_back(static_cast<int32>(i / 2));
+  }
+  return rows;
+}
+} // namespace
+
+TEST_CASE("complex::CompressedRows Build", "[complex][CompressedRows]")
+{
+  const std::vector<usize> sourceRows = CreateSourceRows();
+  const std::vector<std::vector<int32>> expected = GroupSerial(sourceRows);
+  auto forEachEntry = [&sourceRows](usize source, auto&& emit) {
+    emit(sourceRows[2 * source], source);
+    emit(sourceRows[2 * source + 1], source);
+  };
+
+  const CompressedRows::Table<int32> table = CompressedRows::Build<int32>(k_NumSources, k_NumRows, forEachEntry);
+  REQUIRE(table.getNumberOfRows() == k_NumRows);
+  usize numMismatches = 0;
+  for(usize row = 0; row < k_NumRows; row++)
+  {
+    const auto values = table.getRow(row);
+    numMismatches += std::equal(values.begin(), values.end(), expected[row].cbegin(), expected[row].cend()) ? 0 : 1;
+  }
+  REQUIRE(numMismatches == 0);
+
+  // The rows can be filled into storage owned by the caller
+  const std::vector<usize> rowSizes = CompressedRows::CountRowSizes(k_NumSources, k_NumRows, forEachEntry);
+  std::vector<std::vector<int32>> rows(k_NumRows);
+  for(usize row = 0; row < k_NumRows; row++)
+  {
+    REQUIRE(rowSizes[row] == expected[row].size());
+    rows[row].resize(rowSizes[row]);
+  }
+  CompressedRows::FillRows<int32>(k_NumSources, rowSizes, [&rows](usize row) { return rows[row].data(); }, forEachEntry);
+  REQUIRE(rows == expected);
+
+  // Nothing to group
+  const CompressedRows::Table<int32> emptyTable = CompressedRows::Build<int32>(0, 3, forEachEntry);
+  REQUIRE(emptyTable.getNumberOfRows() == 3);
+  REQUIRE(emptyTable.getRow(2).empty());
+}
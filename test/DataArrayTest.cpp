@@ -1,13 +1,19 @@
+#include <fstream>
 #include <memory>
+#include <thread>
+#include <utility>
 #include <vector>
 
 #include <catch2/catch.hpp>
 
 #include "complex/Common/Types.hpp"
+#include "complex/DataStructure/ContiguousValues.hpp"
 #include "complex/DataStructure/DataArray.hpp"
 #include "complex/DataStructure/DataGroup.hpp"
 #include "complex/DataStructure/DataStore.hpp"
 #include "complex/DataStructure/DataStructure.hpp"
+#include "complex/DataStructure/MemoryMappedDataStore.hpp"
+#include "complex/DataStructure/NeighborList.hpp"
 #include "complex/UnitTest/UnitTestCommon.hpp"
 #include "complex/Utilities/DataArrayUtilities.hpp"
 
@@ -97,3 +103,324 @@ TEST_CASE("DataStore Test")
   REQUIRE(dataStore[8] == 99);
   REQUIRE(dataStore.getComponentValue(2, 2) == 99);
 }
+
+TEST_CASE("MemoryMappedDataStore Test", "[complex][DataArray]")
+{
+  IDataStore::ShapeType tupleShape{5};
+  IDataStore::ShapeType componentShape{3};
+  MemoryMappedDataStore<int32> dataStore(tupleShape, componentShape, 5, fs::temp_directory_path());
+
+  REQUIRE(dataStore.getStoreType() == IDataStore::StoreType::MemoryMapped);
+  REQUIRE(dataStore.getSize() == 15);
+  for(usize i = 0; i < dataStore.getSize(); i++)
+  {
+    REQUIRE(dataStore[i] == 5);
+  }
+
+  std::vector<int32> newValues{1, 2, 3};
+  dataStore.setTuple(1, newValues);
+  REQUIRE(dataStore.getComponentValue(1, 2) == 3);
+
+  // Growing the store preserves existing values and zero fills new tuples
+  dataStore.reshapeTuples({10});
+  REQUIRE(dataStore.getNumberOfTuples() == 10);
+  REQUIRE(dataStore.getComponentValue(1, 0) == 1);
+  REQUIRE(dataStore.getComponentValue(4, 2) == 5);
+  REQUIRE(dataStore.getComponentValue(9, 2) == 0);
+
+  auto copy = dataStore.deepCopy();
+  auto* copiedStore = dynamic_cast<MemoryMappedDataStore<int32>*>(copy.get());
+  REQUIRE(copiedStore != nullptr);
+  (*copiedStore)[0] = 42;
+  REQUIRE(dataStore[0] == 5);
+  REQUIRE(copiedStore->getComponentValue(1, 1) == 2);
+}
+
+TEST_CASE("MemoryMappedDataStore Adopt Copy-On-Write File", "[complex][DataArray]")
+{
+  const fs::path filePath = fs::temp_directory_path() / "complex_adopt_test.raw";
+  const std::vector<int32> values{1, 2, 3, 4, 5, 6};
+  {
+    std::ofstream file(filePath, std::ios::binary);
+    const int32 header = -1;
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(int32));
+  }
+
+  {
+    auto mappedFile = std::make_unique<MemoryMappedFile>(filePath, MemoryMappedFile::Mode::CopyOnWrite);
+    MemoryMappedDataStore<int32> dataStore({3}, {2}, std::move(mappedFile), sizeof(int32), fs::temp_directory_path());
+    REQUIRE(dataStore.getComponentValue(2, 1) == 6);
+
+    // Modifying or growing the store must never change the file
+    dataStore[0] = 42;
+    dataStore.reshapeTuples({4});
+    REQUIRE(dataStore[0] == 42);
+    REQUIRE(dataStore.getComponentValue(2, 0) == 5);
+    REQUIRE(dataStore.getComponentValue(3, 1) == 0);
+
+    REQUIRE_THROWS(MemoryMappedDataStore<int32>({4}, {2}, std::make_unique<MemoryMappedFile>(filePath, MemoryMappedFile::Mode::CopyOnWrite), sizeof(int32), fs::temp_directory_path()));
+    REQUIRE_THROWS(MemoryMappedDataStore<int32>({1}, {1}, std::make_unique<MemoryMappedFile>(filePath, MemoryMappedFile::Mode::CopyOnWrite), 1, fs::temp_directory_path()));
+  }
+
+  MemoryMappedFile file(filePath, MemoryMappedFile::Mode::ReadOnly);
+  REQUIRE(file.size() == sizeof(int32) * 7);
+  REQUIRE(reinterpret_cast<const int32*>(file.data())[1] == 1);
+  fs::remove(filePath);
+}
+
+TEST_CASE("CreateDataStore MemoryMapped Threshold", "[complex][DataArray]")
+{
+  const uint64 previousThreshold = GetMemoryMappedThreshold();
+
+  SetMemoryMappedThreshold(100);
+  auto smallStore = CreateDataStore<float32>({10}, {1}, IDataAction::Mode::Execute);
+  REQUIRE(smallStore->getStoreType() == IDataStore::StoreType::InMemory);
+  auto largeStore = CreateDataStore<float32>({100}, {3}, IDataAction::Mode::Execute);
+  REQUIRE(largeStore->getStoreType() == IDataStore::StoreType::MemoryMapped);
+  auto preflightStore = CreateDataStore<float32>({100}, {3}, IDataAction::Mode::Preflight);
+  REQUIRE(preflightStore->getStoreType() == IDataStore::StoreType::Empty);
+
+  SetMemoryMappedThreshold(0);
+  auto disabledStore = CreateDataStore<float32>({100}, {3}, IDataAction::Mode::Execute);
+  REQUIRE(disabledStore->getStoreType() == IDataStore::StoreType::InMemory);
+
+  SetMemoryMappedThreshold(previousThreshold);
+}
+
+TEST_CASE("DataStore Span and Chunk Access", "[complex][DataArray]")
+{
+  DataStore<int32> dataStore({10}, {3}, 0);
+  REQUIRE(dataStore.isContiguous());
+
+  auto span = dataStore.createSpan();
+  REQUIRE(span.size() == 30);
+  REQUIRE(span.data() == dataStore.data());
+  for(usize i = 0; i < span.size(); i++)
+  {
+    span[i] = static_cast<int32>(i);
+  }
+  REQUIRE(dataStore.getComponentValue(9, 2) == 29);
+
+  // Chunks always hold whole tuples and cover the store exactly once
+  usize numValues = 0;
+  dataStore.forEachChunk(4, [&numValues](usize startIndex, nonstd::span<int32> chunk) {
+    REQUIRE(startIndex == numValues);
+    REQUIRE(chunk.size() % 3 == 0);
+    for(auto& value : chunk)
+    {
+      value *= 2;
+    }
+    numValues += chunk.size();
+  });
+  REQUIRE(numValues == 30);
+  REQUIRE(dataStore[15] == 30);
+
+  std::vector<int32> buffer(3);
+  dataStore.copyIntoBuffer(3, buffer);
+  REQUIRE(buffer == std::vector<int32>{6, 8, 10});
+  REQUIRE_THROWS(dataStore.copyIntoBuffer(29, buffer));
+
+  EmptyDataStore<int32> emptyStore({10}, {3});
+  REQUIRE_FALSE(emptyStore.isContiguous());
+  REQUIRE_THROWS(emptyStore.createSpan());
+}
+
+TEST_CASE("ContiguousValues", "[complex][DataArray]")
+{
+  SECTION("Contiguous")
+  {
+    DataStore<int32> dataStore({10}, {3}, 4);
+    ContiguousValues<int32> values(dataStore);
+    REQUIRE_FALSE(values.isCopy());
+    REQUIRE(values.span().data() == dataStore.data());
+    REQUIRE(values.span().size() == 30);
+  }
+
+  SECTION("Not Contiguous")
+  {
+    // More values than one chunk so the copies go through several chunks
+    const usize numTuples = AbstractDataStore<int32>::k_DefaultTuplesPerChunk + 100;
+    UnitTest::NonContiguousDataStore<int32> dataStore({numTuples}, {2});
+    REQUIRE_FALSE(dataStore.isContiguous());
+    for(usize i = 0; i < dataStore.getSize(); i++)
+    {
+      dataStore[i] = static_cast<int32>(i);
+    }
+
+    {
+      const ContiguousValues<const int32> values(std::as_const(dataStore));
+      REQUIRE(values.isCopy());
+      REQUIRE(values.span().size() == numTuples * 2);
+      REQUIRE(values.span()[numTuples * 2 - 1] == static_cast<int32>(numTuples * 2 - 1));
+    }
+
+    ContiguousValues<int32> values(dataStore);
+    REQUIRE(values.isCopy());
+    for(auto& value : values.span())
+    {
+      value = -value;
+    }
+    // Writes only reach the data store on commit
+    REQUIRE(dataStore[5] == 5);
+    values.commit();
+    usize numMismatches = 0;
+    for(usize i = 0; i < dataStore.getSize(); i++)
+    {
+      numMismatches += dataStore[i] != -static_cast<int32>(i) ? 1 : 0;
+    }
+    REQUIRE(numMismatches == 0);
+  }
+}
+
+TEST_CASE("DataStore Copy On Write", "[complex][DataArray]")
+{
+  DataStore<int32> dataStore({10}, {3}, 5);
+  const int32* originalBuffer = std::as_const(dataStore).data();
+  REQUIRE(dataStore.isCopyOnWrite());
+  REQUIRE_FALSE(dataStore.isSharingData());
+
+  auto copy = dataStore.deepCopy();
+  auto* copiedStore = dynamic_cast<DataStore<int32>*>(copy.get());
+  REQUIRE(copiedStore != nullptr);
+  REQUIRE(dataStore.isSharingData());
+  REQUIRE(copiedStore->isSharingData());
+
+  // Reading does not copy
+  REQUIRE(std::as_const(*copiedStore)[4] == 5);
+  REQUIRE(copiedStore->getValue(4) == 5);
+  REQUIRE(std::as_const(*copiedStore).data() == originalBuffer);
+  REQUIRE(copiedStore->isSharingData());
+
+  // The first write gives the copy a private buffer
+  (*copiedStore)[0] = 42;
+  REQUIRE_FALSE(copiedStore->isSharingData());
+  REQUIRE_FALSE(dataStore.isSharingData());
+  const int32* copiedBuffer = std::as_const(*copiedStore).data();
+  REQUIRE(copiedBuffer != originalBuffer);
+  REQUIRE(std::as_const(dataStore).data() == originalBuffer);
+  REQUIRE(originalBuffer[0] == 5);
+  REQUIRE(copiedStore->getValue(0) == 42);
+  REQUIRE(copiedStore->getValue(1) == 5);
+
+  // Writing to the detached copy does not copy again
+  copiedStore->setValue(2, 43);
+  REQUIRE(std::as_const(*copiedStore).data() == copiedBuffer);
+
+  // Writing to the original after the copy was detached does not copy again
+  dataStore.setValue(1, 7);
+  REQUIRE(std::as_const(dataStore).data() == originalBuffer);
+  REQUIRE(copiedStore->getValue(1) == 5);
+
+  // Filling a shared store does not affect the copy
+  auto filledCopy = dataStore.deepCopy();
+  dataStore.fill(3);
+  REQUIRE(dataStore[1] == 3);
+  REQUIRE(dynamic_cast<DataStore<int32>*>(filledCopy.get())->getValue(1) == 7);
+}
+
+TEST_CASE("DataStore Copy On Write Parallel Access", "[complex][DataArray]")
+{
+  const usize numValues = 1 << 20;
+  DataStore<int32> dataStore({numValues}, {1}, 0);
+  auto snapshot = dataStore.deepCopy();
+  REQUIRE(dataStore.isSharingData());
+
+  // One thread reads the first half while another writes the second half of
+  // the shared store. The reader must see the unchanged values and the
+  // snapshot must keep its values.
+  const usize halfSize = numValues / 2;
+  int64 readerSum = 0;
+  std::thread reader([&]() {
+    const auto& constStore = std::as_const(dataStore);
+    for(usize i = 0; i < halfSize; i++)
+    {
+      readerSum += constStore[i];
+    }
+  });
+  std::thread writer([&]() {
+    for(usize i = halfSize; i < numValues; i++)
+    {
+      dataStore[i] = 1;
+    }
+  });
+  reader.join();
+  writer.join();
+
+  REQUIRE(readerSum == 0);
+  REQUIRE_FALSE(dataStore.isSharingData());
+  const auto& snapshotStore = dynamic_cast<const DataStore<int32>&>(*snapshot);
+  usize numChanged = 0;
+  usize numSnapshotChanged = 0;
+  for(usize i = 0; i < numValues; i++)
+  {
+    numChanged += dataStore[i] == (i < halfSize ? 0 : 1) ? 0 : 1;
+    numSnapshotChanged += snapshotStore[i] == 0 ? 0 : 1;
+  }
+  REQUIRE(numChanged == 0);
+  REQUIRE(numSnapshotChanged == 0);
+}
+
+TEST_CASE("DataStore Moved From", "[complex][DataArray]")
+{
+  DataStore<int32> dataStore({10}, {3}, 5);
+  auto copy = dataStore.deepCopy();
+
+  DataStore<int32> movedStore(std::move(dataStore));
+  REQUIRE(movedStore.getNumberOfTuples() == 10);
+  REQUIRE(movedStore.isSharingData());
+  movedStore[0] = 1;
+  REQUIRE_FALSE(movedStore.isSharingData());
+  REQUIRE(dynamic_cast<DataStore<int32>&>(*copy)[0] == 5);
+
+  // The moved-from store is empty and can still be used
+  REQUIRE(dataStore.getNumberOfTuples() == 0);
+  REQUIRE(dataStore.getSize() == 0);
+  REQUIRE_FALSE(dataStore.isSharingData());
+  dataStore.fill(3);
+  dataStore.reshapeTuples({4});
+  dataStore.fill(3);
+  REQUIRE(dataStore[3] == 3);
+
+  DataStore<int32> assignedStore({2}, {1}, 0);
+  assignedStore = std::move(movedStore);
+  REQUIRE(assignedStore.getNumberOfTuples() == 10);
+  REQUIRE(assignedStore[0] == 1);
+  REQUIRE(movedStore.getNumberOfTuples() == 0);
+  movedStore.fill(3);
+}
+
+TEST_CASE("DataStructure Copy Detaches DataStores", "[complex][DataArray]")
+{
+  DataStructure dataStructure;
+  auto* dataArray = Int32Array::CreateWithStore<Int32DataStore>(dataStructure, "Data", {10}, {1});
+  REQUIRE(dataArray != nullptr);
+  dataArray->fill(1);
+  auto* mappedArray = Int32Array::Create(dataStructure, "Mapped", std::make_shared<MemoryMappedDataStore<int32>>(IDataStore::ShapeType{10}, IDataStore::ShapeType{1}, 1, fs::temp_directory_path()));
+  REQUIRE(mappedArray != nullptr);
+  auto* neighborList = NeighborList<int32>::Create(dataStructure, "Neighbors", 2);
+  REQUIRE(neighborList != nullptr);
+  neighborList->setList(0, std::make_shared<std::vector<int32>>(std::vector<int32>{1, 2}));
+  neighborList->setList(1, std::make_shared<std::vector<int32>>(std::vector<int32>{3}));
+
+  DataStructure snapshot = dataStructure;
+  REQUIRE_FALSE(snapshot.detachDataStores());
+
+  (*dataArray)[0] = 2;
+  auto* snapshotArray = snapshot.getDataAs<Int32Array>(DataPath({"Data"}));
+  REQUIRE(snapshotArray != nullptr);
+  REQUIRE((*snapshotArray)[0] == 1);
+  REQUIRE(snapshotArray->getDataStore() != dataArray->getDataStore());
+
+  // NeighborLists get their own lists
+  (*neighborList)[0].push_back(4);
+  auto* snapshotList = snapshot.getDataAs<NeighborList<int32>>(DataPath({"Neighbors"}));
+  REQUIRE(snapshotList != nullptr);
+  REQUIRE(snapshotList->copyOfList(0) == std::vector<int32>{1, 2});
+  REQUIRE(snapshotList->copyOfList(1) == std::vector<int32>{3});
+
+  // Memory-mapped stores cannot be copied on write and remain shared
+  auto* snapshotMappedArray = snapshot.getDataAs<Int32Array>(DataPath({"Mapped"}));
+  REQUIRE(snapshotMappedArray != nullptr);
+  REQUIRE(snapshotMappedArray->getDataStore() == mappedArray->getDataStore());
+}
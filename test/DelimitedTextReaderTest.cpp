@@ -0,0 +1,295 @@
+#include <catch2/catch.hpp>
+
+#include "complex/Common/Result.hpp"
+#include "complex/Common/Types.hpp"
+#include "complex/Utilities/Parsing/Text/DelimitedTextReader.hpp"
+
+#include <algorithm>
+#include <array>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace fs = std::filesystem;
+using namespace complex;
+
+namespace
+{
+constexpr std::array<char, 1> k_Comma = {','};
+
+/**
+ * @brief Writes the contents to a file in the temp directory and removes it when destroyed.
+ */
+class TempTextFile
+{
+public:
+  TempTextFile(const std::string& name, std::string_view contents)
+  : m_Path(fs::temp_directory_path() / name)
+  {
+    std::ofstream file(m_Path, std::ios::binary);
+    file.write(contents.data(), static_cast<std::streamsize>(contents.size()));
+  }
+
+  ~TempTextFile()
+  {
+    std::error_code errorCode;
+    fs::remove(m_Path, errorCode);
+  }
+
+  TempTextFile(const TempTextFile&) = delete;
+  TempTextFile& operator=(const TempTextFile&) = delete;
+
+  const fs::path& path() const
+  {
+    return m_Path;
+  }
+
+private:
+  fs::path m_Path;
+};
+
+/**
+ * @brief Reads every line of the file through forEachRow.
+ */
+std::vector<std::string> ReadLines(const DelimitedTextReader& reader)
+{
+  std::vector<std::string> lines(reader.getNumberOfLines());
+  Result<> result = reader.forEachRow(0, lines.size(), k_Comma, false, [&lines](usize lineIndex, std::string_view line, nonstd::span<const std::string_view>) -> Result<> {
+    lines[lineIndex] = std::string(line);
+    return {};
+  });
+  REQUIRE(result.valid());
+  return lines;
+}
+
+/**
+ * @brief Reads every value of the file through forEachValue.
+ */
+std::vector<std::string> ReadValues(const DelimitedTextReader& reader, usize maxValues)
+{
+  std::vector<std::string> values(maxValues);
+  Result<usize> result = reader.forEachValue(0, ',', maxValues, [&values](usize valueIndex, std::string_view token) -> Result<> {
+    values[valueIndex] = std::string(token);
+    return {};
+  });
+  REQUIRE(result.valid());
+  values.resize(std::min(result.value(), maxValues));
+  return values;
+}
+} // namespace
+
+TEST_CASE("complex::DelimitedTextReader Lines Straddling Blocks", "[complex][DelimitedTextReader]")
+{
+  // Lines that are longer and shorter than a block, an empty line and a line feed on a block boundary
+  const std::vector<std::string> expectedLines = {"0,1,2", "", "33,44", "5", "abcdefghijklmnop,q", "r", "", "6,7,8,9"};
+  std::string contents;
+  for(const std::string& line : expectedLines)
+  {
+    contents += line + "\n";
+  }
+  const TempTextFile file("complex_delimited_straddle_test.txt", contents);
+
+  for(usize blockSize : {1, 2, 3, 4, 7, 16, 1024})
+  {
+    DYNAMIC_SECTION("Block Size " << blockSize)
+    {
+      DelimitedTextReader reader;
+      REQUIRE(reader.open(file.path(), blockSize));
+      REQUIRE(reader.getNumberOfLines() == expectedLines.size());
+      REQUIRE(ReadLines(reader) == expectedLines);
+
+      usize offset = 0;
+      for(usize lineIndex = 0; lineIndex < expectedLines.size(); lineIndex++)
+      {
+        REQUIRE(reader.findLineOffset(lineIndex) == offset);
+        offset += expectedLines[lineIndex].size() + 1;
+      }
+      REQUIRE(reader.findLineOffset(expectedLines.size()) == contents.size());
+
+      const std::vector<std::string> expectedValues = {"0", "1", "2", "33", "44", "5", "abcdefghijklmnop", "q", "r", "6", "7", "8", "9"};
+      REQUIRE(ReadValues(reader, 100) == expectedValues);
+      REQUIRE(ReadValues(reader, 4) == std::vector<std::string>(expectedValues.cbegin(), expectedValues.cbegin() + 4));
+
+      // Values after the skipped lines only
+      std::vector<std::string> values(20);
+      Result<usize> countResult = reader.forEachValue(4, ',', values.size(), [&values](usize valueIndex, std::string_view token) -> Result<> {
+        values[valueIndex] = std::string(token);
+        return {};
+      });
+      REQUIRE(countResult.valid());
+      REQUIRE(countResult.value() == 7);
+      REQUIRE(values[0] == "abcdefghijklmnop");
+      REQUIRE(values[6] == "9");
+    }
+  }
+}
+
+TEST_CASE("complex::DelimitedTextReader CRLF", "[complex][DelimitedTextReader]")
+{
+  const TempTextFile file("complex_delimited_crlf_test.txt", "1,2\r\n-3, 4\r\n\r\n5.5,6\r\n");
+
+  for(usize blockSize : {1, 3, 1024})
+  {
+    DYNAMIC_SECTION("Block Size " << blockSize)
+    {
+      DelimitedTextReader reader;
+      REQUIRE(reader.open(file.path(), blockSize));
+      REQUIRE(reader.getNumberOfLines() == 4);
+
+      // The carriage return stays on the line but is trimmed from the tokens
+      REQUIRE(ReadLines(reader) == std::vector<std::string>{"1,2\r", "-3, 4\r", "\r", "5.5,6\r"});
+
+      std::vector<std::vector<std::string>> rows(4);
+      Result<> result = reader.forEachRow(0, 4, k_Comma, true, [&rows](usize lineIndex, std::string_view, nonstd::span<const std::string_view> tokens) -> Result<> {
+        for(std::string_view token : tokens)
+        {
+          rows[lineIndex].emplace_back(token);
+          Result<float64> valueResult = DelimitedTextReader::ParseValue<float64>(token);
+          if(valueResult.invalid())
+          {
+            return ConvertResult(std::move(valueResult));
+          }
+        }
+        return {};
+      });
+      REQUIRE(result.valid());
+      REQUIRE(rows[0] == std::vector<std::string>{"1", "2"});
+      REQUIRE(rows[1] == std::vector<std::string>{"-3", "4"});
+      REQUIRE(rows[2].empty());
+      REQUIRE(rows[3] == std::vector<std::string>{"5.5", "6"});
+
+      REQUIRE(ReadValues(reader, 100) == std::vector<std::string>{"1", "2", "-3", "4", "5.5", "6"});
+    }
+  }
+}
+
+TEST_CASE("complex::DelimitedTextReader Missing Trailing Newline", "[complex][DelimitedTextReader]")
+{
+  const TempTextFile withoutNewline("complex_delimited_no_newline_test.txt", "1,2\n3,4\n5,6");
+  const TempTextFile withNewline("complex_delimited_newline_test.txt", "1,2\n3,4\n5,6\n");
+
+  for(usize blockSize : {1, 2, 5, 1024})
+  {
+    DYNAMIC_SECTION("Block Size " << blockSize)
+    {
+      DelimitedTextReader reader;
+      REQUIRE(reader.open(withoutNewline.path(), blockSize));
+      REQUIRE(reader.getNumberOfLines() == 3);
+      REQUIRE(ReadLines(reader) == std::vector<std::string>{"1,2", "3,4", "5,6"});
+      REQUIRE(ReadValues(reader, 100) == std::vector<std::string>{"1", "2", "3", "4", "5", "6"});
+
+      // Two values on each line, including the last value that ends at the end of the file
+      std::vector<usize> valueLines(6);
+      Result<usize> result = reader.forEachValue(0, ',', valueLines.size(), [&reader, &valueLines](usize valueIndex, std::string_view token) -> Result<> {
+        valueLines[valueIndex] = reader.findLineIndex(token.data());
+        return {};
+      });
+      REQUIRE(result.valid());
+      REQUIRE(valueLines == std::vector<usize>{0, 0, 1, 1, 2, 2});
+
+      // An empty line after the last line feed is not counted
+      DelimitedTextReader newlineReader;
+      REQUIRE(newlineReader.open(withNewline.path(), blockSize));
+      REQUIRE(newlineReader.getNumberOfLines() == 3);
+      REQUIRE(ReadLines(newlineReader) == std::vector<std::string>{"1,2", "3,4", "5,6"});
+    }
+  }
+}
+
+TEST_CASE("complex::DelimitedTextReader First Error Across Blocks", "[complex][DelimitedTextReader]")
+{
+  // Several lines in several blocks cannot be parsed
+  constexpr usize k_NumLines = 200;
+  const std::vector<usize> badLines = {37, 38, 90, 151, 199};
+  std::string contents;
+  for(usize lineIndex = 0; lineIndex < k_NumLines; lineIndex++)
+  {
+    const bool isBad = std::find(badLines.cbegin(), badLines.cend(), lineIndex) != badLines.cend();
+    contents += isBad ? "x," + std::to_string(lineIndex) + "\n" : std::to_string(lineIndex) + "," + std::to_string(lineIndex * 2) + "\n";
+  }
+  const TempTextFile file("complex_delimited_first_error_test.txt", contents);
+
+  for(usize blockSize : {3, 16, 64, 1024 * 1024})
+  {
+    DYNAMIC_SECTION("Block Size " << blockSize)
+    {
+      DelimitedTextReader reader;
+      REQUIRE(reader.open(file.path(), blockSize));
+      REQUIRE(reader.getNumberOfLines() == k_NumLines);
+
+      auto parseRow = [](usize lineIndex, std::string_view, nonstd::span<const std::string_view> tokens) -> Result<> {
+        for(std::string_view token : tokens)
+        {
+          Result<int32> valueResult = DelimitedTextReader::ParseValue<int32>(token);
+          if(valueResult.invalid())
+          {
+            return MakeErrorResult(-1000 - static_cast<int32>(lineIndex), "Bad line");
+          }
+        }
+        return {};
+      };
+
+      Result<> result = reader.forEachRow(0, k_NumLines, k_Comma, false, parseRow);
+      REQUIRE(result.invalid());
+      REQUIRE(result.errors().size() == 1);
+      REQUIRE(result.errors()[0].code == -1037);
+
+      // Starting after the first bad lines
+      result = reader.forEachRow(39, k_NumLines - 39, k_Comma, false, parseRow);
+      REQUIRE(result.invalid());
+      REQUIRE(result.errors()[0].code == -1090);
+
+      // Requested lines past the end of the file are passed as empty lines after the lines of the file
+      result = reader.forEachRow(160, 50, k_Comma, false, [](usize lineIndex, std::string_view line, nonstd::span<const std::string_view> tokens) -> Result<> {
+        if(line.empty() && tokens.empty())
+        {
+          return MakeErrorResult(-2000 - static_cast<int32>(lineIndex), "Missing line");
+        }
+        return {};
+      });
+      REQUIRE(result.invalid());
+      REQUIRE(result.errors()[0].code == -2000 - static_cast<int32>(k_NumLines));
+
+      // The first value in file order that cannot be parsed, and the line it is on
+      Result<usize> valueResult = reader.forEachValue(0, ',', 2 * k_NumLines, [&reader](usize valueIndex, std::string_view token) -> Result<> {
+        if(DelimitedTextReader::ParseValue<int32>(token).invalid())
+        {
+          return MakeErrorResult(-3000 - static_cast<int32>(reader.findLineIndex(token.data())), "Bad value");
+        }
+        return {};
+      });
+      REQUIRE(valueResult.invalid());
+      REQUIRE(valueResult.errors()[0].code == -3037);
+    }
+  }
+}
+
+TEST_CASE("complex::DelimitedTextReader Empty File", "[complex][DelimitedTextReader]")
+{
+  const TempTextFile file("complex_delimited_empty_test.txt", "");
+
+  DelimitedTextReader reader;
+  REQUIRE(reader.open(file.path(), 4));
+  REQUIRE(reader.getNumberOfLines() == 0);
+  REQUIRE(reader.findLineOffset(0) == 0);
+
+  usize numRows = 0;
+  Result<> result = reader.forEachRow(0, 2, k_Comma, false, [&numRows](usize, std::string_view line, nonstd::span<const std::string_view> tokens) -> Result<> {
+    REQUIRE(line.empty());
+    REQUIRE(tokens.empty());
+    numRows++;
+    return {};
+  });
+  REQUIRE(result.valid());
+  REQUIRE(numRows == 2);
+
+  Result<usize> valueResult = reader.forEachValue(0, ',', 10, [](usize, std::string_view) -> Result<> { return MakeErrorResult(-1, "No values expected"); });
+  REQUIRE(valueResult.valid());
+  REQUIRE(valueResult.value() == 0);
+
+  // A file that does not exist still fails to open
+  DelimitedTextReader missingReader;
+  REQUIRE_FALSE(missingReader.open(fs::temp_directory_path() / "complex_delimited_missing_test.txt"));
+}
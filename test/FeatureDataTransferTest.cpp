@@ -0,0 +1,186 @@
+#include <catch2/catch.hpp>
+
+#include "complex/Common/Types.hpp"
+#include "complex/DataStructure/DataArray.hpp"
+#include "complex/DataStructure/DataStore.hpp"
+#include "complex/DataStructure/DataStructure.hpp"
+#include "complex/Utilities/FeatureDataTransfer.hpp"
+
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace complex;
+
+namespace
+{
+constexpr usize k_NumFeatures = 50;
+
+// Several blocks of the batched gather with a partial block at the end
+constexpr usize k_NumElements = 3 * FeatureDataTransfer::k_ElementsPerBlock + 123;
+
+/**
+ * @brief A feature array and the element arrays filled by the batched and the single
+ * array gather.
+ */
+template <typename T>
+struct GatherArrays
+{
+  DataArray<T>* feature = nullptr;
+  DataArray<T>* batched = nullptr;
+  DataArray<T>* single = nullptr;
+};
+
+template <typename T>
+GatherArrays<T> CreateGatherArrays(DataStructure& dataGraph, const std::string& name, usize numComps)
+{
+  GatherArrays<T> arrays;
+  arrays.feature = DataArray<T>::template CreateWithStore<DataStore<T>>(dataGraph, name + " Feature", {k_NumFeatures}, {numComps});
+  arrays.batched = DataArray<T>::template CreateWithStore<DataStore<T>>(dataGraph, name + " Batched", {k_NumElements}, {numComps});
+  arrays.single = DataArray<T>::template CreateWithStore<DataStore<T>>(dataGraph, name + " Single", {k_NumElements}, {numComps});
+  REQUIRE(arrays.feature != nullptr);
+  REQUIRE(arrays.batched != nullptr);
+  REQUIRE(arrays.single != nullptr);
+  for(usize i = 0; i < arrays.feature->getSize(); i++)
+  {
+    (*arrays.feature)[i] = static_cast<T>((i * 7 + 3) % 113);
+  }
+  return arrays;
+}
+
+/**
+ * @brief Requires that both element arrays hold the tuple of each element's feature.
+ */
+template <typename T>
+void RequireGathered(const std::vector<int32>& featureIds, const GatherArrays<T>& arrays)
+{
+  const usize numComps = arrays.feature->getNumberOfComponents();
+  std::vector<T> expected(featureIds.size() * numComps);
+  for(usize i = 0; i < featureIds.size(); i++)
+  {
+    for(usize comp = 0; comp < numComps; comp++)
+    {
+      expected[i * numComps + comp] = (*arrays.feature)[featureIds[i] * numComps + comp];
+    }
+  }
+  REQUIRE(arrays.batched->getSize() == expected.size());
+  REQUIRE(std::equal(expected.cbegin(), expected.cend(), arrays.batched->begin()));
+  REQUIRE(std::equal(expected.cbegin(), expected.cend(), arrays.single->begin()));
+}
+
+/**
+ * @brief Returns runs of equal feature ids in random order, as found in segmented
+ * volumes, mixed with isolated random ids.
+ */
+std::vector<int32> CreateFeatureIds(usize count, int32 minId, int32 maxId)
+{
+  std::vector<int32> featureIds;
+  featureIds.reserve(count);
+  std::mt19937 generator(5489);
+  std::uniform_int_distribution<int32> idDistribution(minId, maxId);
+  while(featureIds.size() < count)
+  {
+    const usize runLength = std::min<usize>(generator() % 40 + 1, count - featureIds.size());
+    featureIds.insert(featureIds.end(), runLength, idDistribution(generator));
+    if(featureIds.size() < count)
+    {
+      featureIds.push_back(idDistribution(generator));
+    }
+  }
+  return featureIds;
+}
+
+/**
+ * @brief Finds the first and last element of each feature with a serial loop.
+ */
+FeatureDataTransfer::FeatureElements FindFeatureElementsSerial(const std::vector<int32>& featureIds, usize numFeatures)
+{
+  FeatureDataTransfer::FeatureElements featureElements;
+  featureElements.first.assign(numFeatures, FeatureDataTransfer::k_NoElement);
+  featureElements.last.assign(numFeatures, FeatureDataTransfer::k_NoElement);
+  for(usize i = 0; i < featureIds.size(); i++)
+  {
+    if(featureIds[i] < 0 || static_cast<usize>(featureIds[i]) >= numFeatures)
+    {
+      continue;
+    }
+    if(featureElements.first[featureIds[i]] == FeatureDataTransfer::k_NoElement)
+    {
+      featureElements.first[featureIds[i]] = i;
+    }
+    featureElements.last[featureIds[i]] = i;
+  }
+  return featureElements;
+}
+} // namespace
+
+TEST_CASE("complex::FeatureDataTransfer GatherFeatureTuples", "[complex][FeatureDataTransfer]")
+{
+  const std::vector<int32> featureIds = CreateFeatureIds(k_NumElements, 0, static_cast<int32>(k_NumFeatures) - 1);
+
+  // Component counts with a compile time copy (1, 3, 4, 6) and without (2, 5)
+  DataStructure dataGraph;
+  const GatherArrays<int32> int32Arrays = CreateGatherArrays<int32>(dataGraph, "Int32", 1);
+  const GatherArrays<uint64> uint64Arrays = CreateGatherArrays<uint64>(dataGraph, "UInt64", 2);
+  const GatherArrays<float32> float32Arrays = CreateGatherArrays<float32>(dataGraph, "Float32", 3);
+  const GatherArrays<uint8> uint8Arrays = CreateGatherArrays<uint8>(dataGraph, "UInt8", 4);
+  const GatherArrays<int16> int16Arrays = CreateGatherArrays<int16>(dataGraph, "Int16", 5);
+  const GatherArrays<float64> float64Arrays = CreateGatherArrays<float64>(dataGraph, "Float64", 6);
+
+  FeatureDataTransfer::GatherFeatureTuples(featureIds, {int32Arrays.feature, uint64Arrays.feature, float32Arrays.feature, uint8Arrays.feature, int16Arrays.feature, float64Arrays.feature},
+                                           {int32Arrays.batched, uint64Arrays.batched, float32Arrays.batched, uint8Arrays.batched, int16Arrays.batched, float64Arrays.batched});
+  FeatureDataTransfer::GatherFeatureTuples(featureIds, *int32Arrays.feature, *int32Arrays.single);
+  FeatureDataTransfer::GatherFeatureTuples(featureIds, *uint64Arrays.feature, *uint64Arrays.single);
+  FeatureDataTransfer::GatherFeatureTuples(featureIds, *float32Arrays.feature, *float32Arrays.single);
+  FeatureDataTransfer::GatherFeatureTuples(featureIds, *uint8Arrays.feature, *uint8Arrays.single);
+  FeatureDataTransfer::GatherFeatureTuples(featureIds, *int16Arrays.feature, *int16Arrays.single);
+  FeatureDataTransfer::GatherFeatureTuples(featureIds, *float64Arrays.feature, *float64Arrays.single);
+
+  RequireGathered(featureIds, int32Arrays);
+  RequireGathered(featureIds, uint64Arrays);
+  RequireGathered(featureIds, float32Arrays);
+  RequireGathered(featureIds, uint8Arrays);
+  RequireGathered(featureIds, int16Arrays);
+  RequireGathered(featureIds, float64Arrays);
+
+  // Every feature array must match its element array
+  REQUIRE_THROWS_AS(FeatureDataTransfer::GatherFeatureTuples(featureIds, {int32Arrays.feature, uint64Arrays.feature}, {int32Arrays.batched}), std::runtime_error);
+  REQUIRE_THROWS_AS(FeatureDataTransfer::GatherFeatureTuples(featureIds, {int32Arrays.feature, uint64Arrays.feature}, {int32Arrays.batched, float32Arrays.batched}), std::runtime_error);
+  REQUIRE_THROWS_AS(FeatureDataTransfer::GatherFeatureTuples(featureIds, *float32Arrays.feature, *int16Arrays.batched), std::runtime_error);
+
+  // Every feature id must be a tuple of the feature arrays, and nothing is copied otherwise
+  for(int32 badId : {-1, static_cast<int32>(k_NumFeatures)})
+  {
+    std::vector<int32> badFeatureIds = featureIds;
+    badFeatureIds[k_NumElements / 2] = badId;
+    std::fill(int32Arrays.single->begin(), int32Arrays.single->end(), -7);
+    REQUIRE_THROWS_AS(FeatureDataTransfer::GatherFeatureTuples(badFeatureIds, *int32Arrays.feature, *int32Arrays.single), std::runtime_error);
+    REQUIRE(std::all_of(int32Arrays.single->begin(), int32Arrays.single->end(), [](int32 value) { return value == -7; }));
+  }
+}
+
+TEST_CASE("complex::FeatureDataTransfer FindFeatureElements", "[complex][FeatureDataTransfer]")
+{
+  SECTION("Unsorted Ids")
+  {
+    // Features 4 and 5 have no elements; -1, -5 and 99 are ignored
+    const std::vector<int32> featureIds = {3, -1, 0, 3, 3, 7, 1, 0, -5, 3, 2, 2, 99, 1};
+    const FeatureDataTransfer::FeatureElements featureElements = FeatureDataTransfer::FindFeatureElements(featureIds, 8);
+
+    const usize none = FeatureDataTransfer::k_NoElement;
+    REQUIRE(featureElements.first == std::vector<usize>{2, 6, 10, 0, none, none, none, 5});
+    REQUIRE(featureElements.last == std::vector<usize>{7, 13, 11, 9, none, none, none, 5});
+  }
+
+  SECTION("Large Volume")
+  {
+    const std::vector<int32> featureIds = CreateFeatureIds(k_NumElements, -3, static_cast<int32>(k_NumFeatures) + 3);
+    const FeatureDataTransfer::FeatureElements expected = FindFeatureElementsSerial(featureIds, k_NumFeatures);
+    const FeatureDataTransfer::FeatureElements featureElements = FeatureDataTransfer::FindFeatureElements(featureIds, k_NumFeatures);
+
+    REQUIRE(featureElements.first == expected.first);
+    REQUIRE(featureElements.last == expected.last);
+  }
+}
@@ -13,6 +13,8 @@
 
 #include "GeometryTestUtilities.hpp"
 
+#include <type_traits>
+
 using namespace complex;
 
 ////////////////////////////////////
@@ -273,3 +275,79 @@ TEST_CASE("VertexGeomTest")
     REQUIRE(geom->getGeometryTypeAsString() == "VertexGeom");
   }
 }
+
+TEST_CASE("TriangleGeomConnectivityTest")
+{
+  DataStructure ds;
+  auto geom = createGeom<TriangleGeom>(ds);
+
+  // A strip of three triangles where each triangle shares an edge with the next one
+  auto vertexStore = std::make_unique<DataStore<float32>>(std::vector<usize>{5}, std::vector<usize>{3}, 0.0f);
+  auto vertices = AbstractGeometry::SharedVertexList::Create(ds, "Vertices", std::move(vertexStore), geom->getId());
+  REQUIRE(vertices != nullptr);
+  geom->setVertices(vertices);
+  auto triangleStore = std::make_unique<DataStore<AbstractGeometry::MeshIndexType>>(std::vector<usize>{3}, std::vector<usize>{3}, 0);
+  auto triangles = AbstractGeometry::SharedTriList::Create(ds, "Triangles", std::move(triangleStore), geom->getId());
+  REQUIRE(triangles != nullptr);
+  const std::vector<AbstractGeometry::MeshIndexType> triangleVertices = {0, 1, 2, 1, 3, 2, 2, 3, 4};
+  std::copy(triangleVertices.cbegin(), triangleVertices.cend(), triangles->begin());
+  geom->setFaces(triangles);
+
+  REQUIRE(geom->findElementNeighbors() >= 0);
+
+  const AbstractGeometry::ElementDynamicList* elementsContainingVert = geom->getElementsContainingVert();
+  REQUIRE(elementsContainingVert != nullptr);
+  REQUIRE(elementsContainingVert->size() == 5);
+  const std::vector<std::vector<AbstractGeometry::MeshIndexType>> expectedElements = {{0}, {0, 1}, {0, 1, 2}, {1, 2}, {2}};
+  for(usize vertex = 0; vertex < expectedElements.size(); vertex++)
+  {
+    const auto elements = elementsContainingVert->getElementListSpan(vertex);
+    REQUIRE(std::vector<AbstractGeometry::MeshIndexType>(elements.begin(), elements.end()) == expectedElements[vertex]);
+  }
+
+  const AbstractGeometry::ElementDynamicList* elementNeighbors = geom->getElementNeighbors();
+  REQUIRE(elementNeighbors != nullptr);
+  REQUIRE(elementNeighbors->size() == 3);
+  const std::vector<std::vector<AbstractGeometry::MeshIndexType>> expectedNeighbors = {{1}, {0, 2}, {1}};
+  for(usize triangle = 0; triangle < expectedNeighbors.size(); triangle++)
+  {
+    REQUIRE(elementNeighbors->getNumberOfElements(triangle) == expectedNeighbors[triangle].size());
+    const auto neighbors = elementNeighbors->getElementListSpan(triangle);
+    REQUIRE(std::vector<AbstractGeometry::MeshIndexType>(neighbors.begin(), neighbors.end()) == expectedNeighbors[triangle]);
+  }
+  // Lists reached through a const pointer are read-only
+  static_assert(std::is_same_v<decltype(elementNeighbors->getElementListPointer(0)), const AbstractGeometry::MeshIndexType*>);
+  const auto elementList = elementNeighbors->getElementList(1);
+  REQUIRE(elementList.numCells == 2);
+  REQUIRE(elementList.cells == elementNeighbors->getElementListSpan(1).data());
+}
+
+TEST_CASE("TetrahedralGeomUniqueFacesTest")
+{
+  DataStructure ds;
+  auto geom = createGeom<TetrahedralGeom>(ds);
+
+  // Two tetrahedra that share the face {1, 2, 3}
+  auto tetStore = std::make_unique<DataStore<AbstractGeometry::MeshIndexType>>(std::vector<usize>{2}, std::vector<usize>{4}, 0);
+  auto tets = AbstractGeometry::SharedTetList::Create(ds, "Tetrahedra", std::move(tetStore), geom->getId());
+  REQUIRE(tets != nullptr);
+  const std::vector<AbstractGeometry::MeshIndexType> tetVertices = {0, 1, 2, 3, 4, 3, 2, 1};
+  std::copy(tetVertices.cbegin(), tetVertices.cend(), tets->begin());
+  geom->setTetrahedra(tets);
+
+  REQUIRE(geom->findEdges() >= 0);
+  REQUIRE(geom->getEdges()->getNumberOfTuples() == 9);
+
+  REQUIRE(geom->findFaces() >= 0);
+  const std::vector<AbstractGeometry::MeshIndexType> expectedFaces = {0, 1, 2, 0, 1, 3, 0, 2, 3, 1, 2, 3, 1, 2, 4, 1, 3, 4, 2, 3, 4};
+  const AbstractGeometry::SharedTriList* faces = geom->getTriangles();
+  REQUIRE(faces->getSize() == expectedFaces.size());
+  REQUIRE(std::equal(expectedFaces.cbegin(), expectedFaces.cend(), faces->begin()));
+
+  REQUIRE(geom->findUnsharedFaces() >= 0);
+  const std::vector<AbstractGeometry::MeshIndexType> expectedUnsharedFaces = {0, 1, 2, 0, 1, 3, 0, 2, 3, 1, 2, 4, 1, 3, 4, 2, 3, 4};
+  const auto* unsharedFaces = ds.getDataAs<AbstractGeometry::SharedTriList>(DataPath({"Geom", "Unshared Face List"}));
+  REQUIRE(unsharedFaces != nullptr);
+  REQUIRE(unsharedFaces->getSize() == expectedUnsharedFaces.size());
+  REQUIRE(std::equal(expectedUnsharedFaces.cbegin(), expectedUnsharedFaces.cend(), unsharedFaces->begin()));
+}
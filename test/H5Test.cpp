@@ -12,6 +12,7 @@
 #include "complex/DataStructure/Geometry/QuadGeom.hpp"
 #include "complex/DataStructure/Geometry/TriangleGeom.hpp"
 #include "complex/DataStructure/Geometry/VertexGeom.hpp"
+#include "complex/DataStructure/LazyDataStore.hpp"
 #include "complex/DataStructure/Montage/GridMontage.hpp"
 #include "complex/DataStructure/ScalarData.hpp"
 #include "complex/DataStructure/StringArray.hpp"
@@ -31,7 +32,9 @@
 
 #include <iostream>
 #include <string>
+#include <thread>
 #include <type_traits>
+#include <utility>
 
 #define TEST_LEGACY 1
 
@@ -671,6 +674,124 @@ TEST_CASE("NeighborList IO")
   }
 }
 
+TEST_CASE("Flat NeighborList IO")
+{
+  Application app;
+
+  fs::path dataDir = GetDataDir(app);
+
+  if(!fs::exists(dataDir))
+  {
+    REQUIRE(fs::create_directories(dataDir));
+  }
+
+  fs::path filePath = GetDataDir(app) / "FlatNeighborListTest.dream3d";
+
+  // Lists are sized first and then filled in any order
+  const usize numLists = 6;
+  NeighborList<float32>::Builder builder(numLists);
+  for(usize i = 0; i < numLists; i++)
+  {
+    builder.addToListSize(i, i % 3);
+  }
+  builder.allocate();
+  for(usize i = numLists; i-- > 0;)
+  {
+    auto list = builder.getList(i);
+    REQUIRE(list.size() == i % 3);
+    for(usize j = 0; j < list.size(); j++)
+    {
+      list[j] = static_cast<float32>(i * 10 + j);
+    }
+  }
+
+  {
+    DataStructure ds;
+    auto* neighborList = NeighborList<float32>::Create(ds, "Flat", numLists);
+    REQUIRE(neighborList != nullptr);
+    neighborList->setFlatStorage(builder.build());
+    REQUIRE(neighborList->hasFlatStorage());
+    REQUIRE(neighborList->getNumberOfLists() == numLists);
+    REQUIRE(neighborList->getSize() == 6);
+    REQUIRE(neighborList->getListSize(5) == 2);
+    REQUIRE(neighborList->getListSpan(4)[0] == 40.0f);
+
+    // Lists appended in order are stored the same way
+    NeighborList<int32>::Builder appendBuilder;
+    appendBuilder.appendList(std::vector<int32>{1, 2, 3});
+    appendBuilder.appendList({});
+    appendBuilder.appendList(std::vector<int32>{4});
+    auto* appendedList = NeighborList<int32>::Create(ds, "Appended", 3);
+    REQUIRE(appendedList != nullptr);
+    appendedList->setFlatStorage(appendBuilder.build());
+
+    // Accessing a list as a vector converts the storage
+    (*appendedList)[1].push_back(7);
+    REQUIRE_FALSE(appendedList->hasFlatStorage());
+    REQUIRE(appendedList->getListSize(0) == 3);
+    REQUIRE(appendedList->getListSpan(1)[0] == 7);
+    appendedList->flatten();
+    REQUIRE(appendedList->hasFlatStorage());
+    REQUIRE(appendedList->getSize() == 5);
+
+    // Converting flat storage through a const method from another thread frees
+    // the flat values and later spans read the expanded lists
+    NeighborList<int32>::Builder sharedBuilder;
+    sharedBuilder.appendList(std::vector<int32>{5, 6});
+    sharedBuilder.appendList(std::vector<int32>{8});
+    auto* sharedList = NeighborList<int32>::Create(ds, "Shared", 2);
+    REQUIRE(sharedList != nullptr);
+    sharedList->setFlatStorage(sharedBuilder.build());
+    REQUIRE(sharedList->getListSpan(0)[1] == 6);
+    int32 expandedValue = 0;
+    std::thread expander([sharedList, &expandedValue]() { expandedValue = std::as_const(*sharedList).getList(1)->at(0); });
+    expander.join();
+    REQUIRE(expandedValue == 8);
+    REQUIRE_FALSE(sharedList->hasFlatStorage());
+    REQUIRE(sharedList->getSize() == 3);
+    const auto expandedSpan = sharedList->getListSpan(0);
+    REQUIRE(expandedSpan.data() == std::as_const(*sharedList).getListReference(0).data());
+    REQUIRE(expandedSpan[0] == 5);
+    REQUIRE(expandedSpan[1] == 6);
+
+    NeighborList<int32>::FlatStorage invalidStorage;
+    invalidStorage.offsets = {0, 2};
+    invalidStorage.values = {1};
+    REQUIRE_THROWS(appendedList->setFlatStorage(invalidStorage));
+
+    Result<H5::FileWriter> result = H5::FileWriter::CreateFile(filePath);
+    REQUIRE(result.valid());
+    H5::FileWriter fileWriter = std::move(result.value());
+    REQUIRE(ds.writeHdf5(fileWriter) >= 0);
+  }
+
+  H5::FileReader fileReader(filePath);
+  REQUIRE(fileReader.isValid());
+  herr_t err;
+  auto ds = DataStructure::readFromHdf5(fileReader, err);
+  REQUIRE(err >= 0);
+
+  auto* neighborList = ds.getDataAs<NeighborList<float32>>(DataPath({"Flat"}));
+  REQUIRE(neighborList != nullptr);
+  REQUIRE(neighborList->hasFlatStorage());
+  REQUIRE(neighborList->getNumberOfLists() == numLists);
+  for(usize i = 0; i < numLists; i++)
+  {
+    auto list = neighborList->getListSpan(i);
+    REQUIRE(list.size() == i % 3);
+    for(usize j = 0; j < list.size(); j++)
+    {
+      REQUIRE(list[j] == static_cast<float32>(i * 10 + j));
+    }
+  }
+
+  auto* appendedList = ds.getDataAs<NeighborList<int32>>(DataPath({"Appended"}));
+  REQUIRE(appendedList != nullptr);
+  REQUIRE(appendedList->copyOfList(0) == std::vector<int32>{1, 2, 3});
+  REQUIRE(appendedList->copyOfList(1) == std::vector<int32>{7});
+  REQUIRE(appendedList->copyOfList(2) == std::vector<int32>{4});
+}
+
 TEST_CASE("DataArray<bool> IO")
 {
   Application app;
@@ -741,3 +862,338 @@ TEST_CASE("DataArray<bool> IO")
     FAIL(e.what());
   }
 }
+
+TEST_CASE("Compressed DataArray IO")
+{
+  Application app;
+
+  fs::path dataDir = GetDataDir(app);
+
+  if(!fs::exists(dataDir))
+  {
+    REQUIRE(fs::create_directories(dataDir));
+  }
+
+  fs::path filePath = GetDataDir(app) / "CompressedArrayTest.dream3d";
+
+  std::string filePathString = filePath.string();
+
+  const std::vector<usize> tupleShape = {100, 100};
+  const usize numValues = 100 * 100;
+
+  REQUIRE(H5::DatasetWriter::ComputeChunkShape({1000, 1000, 3}, 4, 1024 * 1024) == H5::DatasetWriter::DimsType{87, 1000, 3});
+  REQUIRE(H5::DatasetWriter::ComputeChunkShape({10, 3}, 4, 1024 * 1024) == H5::DatasetWriter::DimsType{10, 3});
+
+  // Write HDF5 file
+  try
+  {
+    DataStructure ds;
+    auto* featureIds = DataArray<int32>::CreateWithStore<DataStore<int32>>(ds, "FeatureIds", tupleShape, {1});
+    for(usize i = 0; i < numValues; i++)
+    {
+      (*featureIds)[i] = static_cast<int32>(i / 1000);
+    }
+    Result<H5::FileWriter> result = H5::FileWriter::CreateFile(filePathString);
+    REQUIRE(result.valid());
+
+    H5::FileWriter fileWriter = std::move(result.value());
+    REQUIRE(fileWriter.isValid());
+
+    H5::DatasetCreationOptions creationOptions;
+    creationOptions.deflateLevel = 6;
+    creationOptions.shuffle = true;
+    creationOptions.chunkBytes = 4096;
+    fileWriter.setDatasetCreationOptions(creationOptions);
+
+    herr_t err;
+    err = ds.writeHdf5(fileWriter);
+    REQUIRE(err >= 0);
+  } catch(const std::exception& e)
+  {
+    FAIL(e.what());
+  }
+
+  // Read HDF5 file
+  try
+  {
+    H5::FileReader fileReader(filePathString);
+    REQUIRE(fileReader.isValid());
+
+    H5::GroupReader dataStructureReader = fileReader.openGroup(H5::k_DataStructureTag);
+    H5::DatasetReader datasetReader = dataStructureReader.openDataset("FeatureIds");
+    REQUIRE(datasetReader.isValid());
+    hid_t propertyListId = H5Dget_create_plist(datasetReader.getId());
+    REQUIRE(H5Pget_layout(propertyListId) == H5D_CHUNKED);
+    REQUIRE(H5Pget_nfilters(propertyListId) == 2);
+    H5Pclose(propertyListId);
+    REQUIRE(H5Dget_storage_size(datasetReader.getId()) < numValues * sizeof(int32));
+
+    herr_t err;
+    auto ds = DataStructure::readFromHdf5(fileReader, err);
+    REQUIRE(err >= 0);
+
+    auto* featureIds = ds.getDataAs<Int32Array>(DataPath({"FeatureIds"}));
+    REQUIRE(featureIds != nullptr);
+    for(usize i = 0; i < numValues; i++)
+    {
+      REQUIRE((*featureIds)[i] == static_cast<int32>(i / 1000));
+    }
+  } catch(const std::exception& e)
+  {
+    FAIL(e.what());
+  }
+}
+
+TEST_CASE("Hyperslab DataArray IO")
+{
+  Application app;
+
+  fs::path dataDir = GetDataDir(app);
+
+  if(!fs::exists(dataDir))
+  {
+    REQUIRE(fs::create_directories(dataDir));
+  }
+
+  fs::path filePath = GetDataDir(app) / "HyperslabArrayTest.dream3d";
+
+  // X, Y, Z
+  const SizeVec3 imageDims = {10, 8, 6};
+  const std::vector<usize> tupleShape = {imageDims[2], imageDims[1], imageDims[0]};
+  const usize numComponents = 2;
+  const usize numValues = imageDims[0] * imageDims[1] * imageDims[2] * numComponents;
+
+  // Write DREAM3D file
+  {
+    DataStructure ds;
+    ImageGeom* imageGeom = ImageGeom::Create(ds, "Image");
+    imageGeom->setDimensions(imageDims);
+    imageGeom->setSpacing({0.5f, 0.5f, 0.5f});
+    imageGeom->setOrigin({1.0f, 2.0f, 3.0f});
+
+    auto* data = DataArray<int32>::CreateWithStore<DataStore<int32>>(ds, "Data", tupleShape, {numComponents}, imageGeom->getId());
+    for(usize i = 0; i < numValues; i++)
+    {
+      (*data)[i] = static_cast<int32>(i);
+    }
+    auto* featureData = DataArray<float32>::CreateWithStore<DataStore<float32>>(ds, "Feature Data", {5}, {1}, imageGeom->getId());
+    featureData->fill(1.5f);
+
+    auto result = DREAM3D::WriteFile(filePath, ds);
+    REQUIRE(result.valid());
+  }
+
+  H5::FileReader fileReader(filePath);
+  REQUIRE(fileReader.isValid());
+
+  // Read parts of the dataset directly
+  {
+    H5::GroupReader imageReader = fileReader.openGroup(H5::k_DataStructureTag).openGroup("Image");
+    H5::DatasetReader datasetReader = imageReader.openDataset("Data");
+    REQUIRE(datasetReader.isValid());
+
+    // Z slices 2 and 3
+    const usize sliceSize = imageDims[0] * imageDims[1] * numComponents;
+    std::vector<int32> slices(sliceSize * 2);
+    REQUIRE(datasetReader.readTupleRangeIntoSpan<int32>(slices, 2, 2));
+    for(usize i = 0; i < slices.size(); i++)
+    {
+      REQUIRE(slices[i] == static_cast<int32>(2 * sliceSize + i));
+    }
+
+    // Every other voxel in Y and X of the first Z slice
+    auto stridedDims = datasetReader.getHyperslabDimensions({0, 0, 0}, {1}, {1, 2, 2});
+    REQUIRE(stridedDims.valid());
+    REQUIRE(stridedDims.value() == std::vector<hsize_t>{1, 4, 5, 2});
+    std::vector<int32> strided(4 * 5 * 2);
+    REQUIRE(datasetReader.readIntoSpan<int32>(strided, {0, 0, 0}, {1}, {1, 2, 2}));
+    for(usize y = 0; y < 4; y++)
+    {
+      for(usize x = 0; x < 5; x++)
+      {
+        usize sourceIndex = ((y * 2) * imageDims[0] + (x * 2)) * numComponents;
+        REQUIRE(strided[(y * 5 + x) * numComponents] == static_cast<int32>(sourceIndex));
+        REQUIRE(strided[(y * 5 + x) * numComponents + 1] == static_cast<int32>(sourceIndex + 1));
+      }
+    }
+
+    REQUIRE(datasetReader.getHyperslabDimensions({6}, {1}).invalid());
+    REQUIRE(datasetReader.getHyperslabDimensions({0}, {7}).invalid());
+    REQUIRE(datasetReader.getHyperslabDimensions({0, 0, 0, 0, 0}, {}).invalid());
+    std::vector<int32> wrongSize(3);
+    REQUIRE_FALSE(datasetReader.readIntoSpan<int32>(wrongSize, {0}, {1}));
+  }
+
+  // Import a subvolume of the ImageGeom
+  {
+    H5::DataStructureReader::ImageSubvolume subvolume;
+    subvolume.minVoxel = {3, 1, 2};
+    subvolume.maxVoxel = {6, 4, 3};
+    auto result = DREAM3D::ImportDataStructureFromFile(fileReader, subvolume);
+    REQUIRE(result.valid());
+    DataStructure ds = std::move(result.value());
+
+    auto* imageGeom = ds.getDataAs<ImageGeom>(DataPath({"Image"}));
+    REQUIRE(imageGeom != nullptr);
+    REQUIRE(imageGeom->getDimensions() == SizeVec3(4, 4, 2));
+    REQUIRE(imageGeom->getOrigin() == FloatVec3(2.5f, 2.5f, 4.0f));
+
+    auto* data = ds.getDataAs<Int32Array>(DataPath({"Image", "Data"}));
+    REQUIRE(data != nullptr);
+    REQUIRE(data->getNumberOfTuples() == 4 * 4 * 2);
+    REQUIRE(data->getNumberOfComponents() == numComponents);
+    usize index = 0;
+    for(usize z = 2; z <= 3; z++)
+    {
+      for(usize y = 1; y <= 4; y++)
+      {
+        for(usize x = 3; x <= 6; x++)
+        {
+          usize sourceTuple = (z * imageDims[1] + y) * imageDims[0] + x;
+          REQUIRE((*data)[index++] == static_cast<int32>(sourceTuple * numComponents));
+          REQUIRE((*data)[index++] == static_cast<int32>(sourceTuple * numComponents + 1));
+        }
+      }
+    }
+
+    // Arrays that are not cell data are read in full
+    auto* featureData = ds.getDataAs<Float32Array>(DataPath({"Image", "Feature Data"}));
+    REQUIRE(featureData != nullptr);
+    REQUIRE(featureData->getNumberOfTuples() == 5);
+
+    subvolume.maxVoxel = {10, 4, 3};
+    REQUIRE(DREAM3D::ImportDataStructureFromFile(fileReader, subvolume).invalid());
+  }
+}
+
+TEST_CASE("Lazy DataArray IO")
+{
+  Application app;
+
+  fs::path dataDir = GetDataDir(app);
+
+  if(!fs::exists(dataDir))
+  {
+    REQUIRE(fs::create_directories(dataDir));
+  }
+
+  fs::path filePath = GetDataDir(app) / "LazyArrayTest.dream3d";
+  fs::path resavedFilePath = GetDataDir(app) / "LazyArrayTest_Resaved.dream3d";
+
+  // X, Y, Z
+  const SizeVec3 imageDims = {10, 8, 6};
+  const std::vector<usize> tupleShape = {imageDims[2], imageDims[1], imageDims[0]};
+  const usize numValues = imageDims[0] * imageDims[1] * imageDims[2];
+
+  // Write DREAM3D file
+  {
+    DataStructure ds;
+    ImageGeom* imageGeom = ImageGeom::Create(ds, "Image");
+    imageGeom->setDimensions(imageDims);
+    imageGeom->setSpacing({1.0f, 1.0f, 1.0f});
+    imageGeom->setOrigin({0.0f, 0.0f, 0.0f});
+
+    auto* data = DataArray<int32>::CreateWithStore<DataStore<int32>>(ds, "Data", tupleShape, {1}, imageGeom->getId());
+    auto* mask = DataArray<bool>::CreateWithStore<DataStore<bool>>(ds, "Mask", tupleShape, {1}, imageGeom->getId());
+    for(usize i = 0; i < numValues; i++)
+    {
+      (*data)[i] = static_cast<int32>(i);
+      (*mask)[i] = (i % 3 == 0);
+    }
+
+    auto result = DREAM3D::WriteFile(filePath, ds);
+    REQUIRE(result.valid());
+  }
+
+  DataStructure ds;
+  {
+    // The arrays must remain readable after the caller's reader is closed
+    H5::FileReader fileReader(filePath);
+    REQUIRE(fileReader.isValid());
+    auto result = DREAM3D::ImportLazyDataStructureFromFile(fileReader);
+    REQUIRE(result.valid());
+    ds = std::move(result.value());
+  }
+
+  auto* data = ds.getDataAs<Int32Array>(DataPath({"Image", "Data"}));
+  REQUIRE(data != nullptr);
+  auto* lazyStore = dynamic_cast<LazyDataStore<int32>*>(data->getDataStore());
+  REQUIRE(lazyStore != nullptr);
+  REQUIRE(lazyStore->getStoreType() == IDataStore::StoreType::Lazy);
+  REQUIRE(data->getNumberOfTuples() == numValues);
+  REQUIRE_FALSE(lazyStore->isLoaded());
+
+  // Copies of unloaded arrays are loaded separately
+  std::unique_ptr<IDataStore> storeCopy = lazyStore->deepCopy();
+  auto* lazyCopy = dynamic_cast<LazyDataStore<int32>*>(storeCopy.get());
+  REQUIRE(lazyCopy != nullptr);
+  REQUIRE_FALSE(lazyCopy->isLoaded());
+
+  REQUIRE((*data)[17] == 17);
+  REQUIRE(lazyStore->isLoaded());
+  REQUIRE_FALSE(lazyCopy->isLoaded());
+  auto values = data->getDataStoreRef().createSpan();
+  for(usize i = 0; i < numValues; i++)
+  {
+    REQUIRE(values[i] == static_cast<int32>(i));
+  }
+  (*data)[0] = -1;
+  REQUIRE(lazyCopy->getValue(0) == 0);
+
+  // Saving an unloaded array reads it without keeping it loaded
+  auto* mask = ds.getDataAs<BoolArray>(DataPath({"Image", "Mask"}));
+  REQUIRE(mask != nullptr);
+  auto* lazyMask = dynamic_cast<LazyDataStore<bool>*>(mask->getDataStore());
+  REQUIRE(lazyMask != nullptr);
+  REQUIRE(DREAM3D::WriteFile(resavedFilePath, ds).valid());
+  REQUIRE_FALSE(lazyMask->isLoaded());
+
+  auto resavedResult = DREAM3D::ImportDataStructureFromFile(resavedFilePath);
+  REQUIRE(resavedResult.valid());
+  DataStructure resaved = std::move(resavedResult.value());
+  auto* resavedData = resaved.getDataAs<Int32Array>(DataPath({"Image", "Data"}));
+  auto* resavedMask = resaved.getDataAs<BoolArray>(DataPath({"Image", "Mask"}));
+  REQUIRE(resavedData != nullptr);
+  REQUIRE(resavedMask != nullptr);
+  REQUIRE((*resavedData)[0] == -1);
+  for(usize i = 1; i < numValues; i++)
+  {
+    REQUIRE((*resavedData)[i] == static_cast<int32>(i));
+    REQUIRE((*resavedMask)[i] == (i % 3 == 0));
+  }
+
+  // The source file cannot be overwritten while unloaded arrays still read from it
+  auto overwriteResult = DREAM3D::WriteFile(filePath, ds);
+  REQUIRE(overwriteResult.invalid());
+  REQUIRE(overwriteResult.errors()[0].code == -303);
+  REQUIRE_FALSE(lazyMask->isLoaded());
+  REQUIRE((*mask)[3]);
+
+  // Filling an unloaded array does not read it
+  mask->fill(true);
+  REQUIRE(lazyMask->isLoaded());
+  REQUIRE((*mask)[1]);
+
+  // Lazy subvolume import
+  {
+    H5::FileReader fileReader(filePath);
+    H5::DataStructureReader::ImageSubvolume subvolume;
+    subvolume.minVoxel = {2, 2, 1};
+    subvolume.maxVoxel = {5, 3, 1};
+    auto result = DREAM3D::ImportLazyDataStructureFromFile(fileReader, subvolume);
+    REQUIRE(result.valid());
+    DataStructure subvolumeDs = std::move(result.value());
+    auto* subvolumeData = subvolumeDs.getDataAs<Int32Array>(DataPath({"Image", "Data"}));
+    REQUIRE(subvolumeData != nullptr);
+    REQUIRE(subvolumeData->getDataStoreRef().getStoreType() == IDataStore::StoreType::Lazy);
+    REQUIRE(subvolumeData->getNumberOfTuples() == 4 * 2);
+    usize index = 0;
+    for(usize y = 2; y <= 3; y++)
+    {
+      for(usize x = 2; x <= 5; x++)
+      {
+        REQUIRE((*subvolumeData)[index++] == static_cast<int32>((imageDims[1] + y) * imageDims[0] + x));
+      }
+    }
+  }
+}
@@ -0,0 +1,78 @@
+#include <catch2/catch.hpp>
+
+#include "complex/Common/Array.hpp"
+#include "complex/Common/ComplexRange3D.hpp"
+#include "complex/Common/Types.hpp"
+#include "complex/Utilities/ParallelData3DAlgorithm.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+using namespace complex;
+
+namespace
+{
+/**
+ * @brief Runs the algorithm over the range and returns how often each voxel was
+ * visited along with the ranges the body received.
+ */
+std::vector<usize> VisitRange(ParallelData3DAlgorithm& dataAlg, const SizeVec3& dims, std::vector<ComplexRange3D>& ranges)
+{
+  std::vector<std::atomic<usize>> visits(dims[0] * dims[1] * dims[2]);
+  std::mutex mutex;
+  dataAlg.setRange(dims[0], dims[1], dims[2]);
+  dataAlg.execute([&](const ComplexRange3D& range) {
+    for(usize z = range[4]; z < range[5]; z++)
+    {
+      for(usize y = range[2]; y < range[3]; y++)
+      {
+        for(usize x = range[0]; x < range[1]; x++)
+        {
+          visits[(z * dims[1] + y) * dims[0] + x]++;
+        }
+      }
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    ranges.push_back(range);
+  });
+  std::vector<usize> counts(visits.size());
+  std::transform(visits.cbegin(), visits.cend(), counts.begin(), [](const std::atomic<usize>& count) { return count.load(); });
+  return counts;
+}
+} // namespace
+
+TEST_CASE("complex::ParallelData3DAlgorithm Split", "[complex][ParallelData3DAlgorithm]")
+{
+  SECTION("Default")
+  {
+    // A single plane must still be split for 2D images
+    const SizeVec3 dims = {300, 7, 1};
+    ParallelData3DAlgorithm dataAlg;
+    std::vector<ComplexRange3D> ranges;
+    const std::vector<usize> visits = VisitRange(dataAlg, dims, ranges);
+    REQUIRE(std::all_of(visits.cbegin(), visits.cend(), [](usize count) { return count == 1; }));
+  }
+
+  SECTION("Z Slabs")
+  {
+    const SizeVec3 dims = {9, 7, 50};
+    ParallelData3DAlgorithm dataAlg;
+    dataAlg.setSplitIntoZSlabs(true);
+    dataAlg.setGrain(4);
+    REQUIRE(dataAlg.getSplitIntoZSlabs());
+    std::vector<ComplexRange3D> ranges;
+    const std::vector<usize> visits = VisitRange(dataAlg, dims, ranges);
+    REQUIRE(std::all_of(visits.cbegin(), visits.cend(), [](usize count) { return count == 1; }));
+
+    // Every task receives whole XY planes
+    for(const auto& range : ranges)
+    {
+      REQUIRE(range[0] == 0);
+      REQUIRE(range[1] == dims[0]);
+      REQUIRE(range[2] == 0);
+      REQUIRE(range[3] == dims[1]);
+    }
+  }
+}
@@ -0,0 +1,133 @@
+#include <catch2/catch.hpp>
+
+#include "complex/Common/Types.hpp"
+#include "complex/DataStructure/DataArray.hpp"
+#include "complex/DataStructure/DataStore.hpp"
+#include "complex/DataStructure/DataStructure.hpp"
+#include "complex/Utilities/StreamCompaction.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using namespace complex;
+
+namespace
+{
+// Enough indices to be split into several ranges when there are several hardware threads
+constexpr usize k_NumIndices = 2 * StreamCompaction::k_MinIndicesPerRange + 12345;
+
+/**
+ * @brief Returns a random mask where about one value in three is true.
+ */
+std::unique_ptr<bool[]> CreateMask(usize count)
+{
+  auto mask = std::make_unique<bool[]>(count);
+  std::mt19937 generator(5489);
+  for(usize i = 0; i < count; i++)
+  {
+    mask[i] = generator() % 3 == 0;
+  }
+  return mask;
+}
+
+/**
+ * @brief Returns the indices of the true values of the mask with a serial loop.
+ */
+std::vector<usize> FindKeptIndicesSerial(const bool* mask, usize count)
+{
+  std::vector<usize> keptIndices;
+  for(usize i = 0; i < count; i++)
+  {
+    if(mask[i])
+    {
+      keptIndices.push_back(i);
+    }
+  }
+  return keptIndices;
+}
+} // namespace
+
+TEST_CASE("complex::StreamCompaction FindKeptIndices", "[complex][StreamCompaction]")
+{
+  const std::unique_ptr<bool[]> mask = CreateMask(k_NumIndices);
+  const std::vector<usize> expectedIndices = FindKeptIndicesSerial(mask.get(), k_NumIndices);
+
+  REQUIRE(StreamCompaction::FindKeptIndices(nonstd::span<const bool>(mask.get(), k_NumIndices)) == expectedIndices);
+  REQUIRE(StreamCompaction::FindKeptIndices(k_NumIndices, [&mask](usize i) { return mask[i]; }) == expectedIndices);
+
+  REQUIRE(StreamCompaction::FindKeptIndices(0, [](usize) { return true; }).empty());
+  REQUIRE(StreamCompaction::FindKeptIndices(k_NumIndices, [](usize) { return false; }).empty());
+  std::vector<usize> allIndices(k_NumIndices);
+  std::iota(allIndices.begin(), allIndices.end(), 0);
+  REQUIRE(StreamCompaction::FindKeptIndices(k_NumIndices, [](usize) { return true; }) == allIndices);
+}
+
+TEST_CASE("complex::StreamCompaction CreateIndexMap", "[complex][StreamCompaction]")
+{
+  const std::unique_ptr<bool[]> mask = CreateMask(k_NumIndices);
+  const std::vector<usize> keptIndices = FindKeptIndicesSerial(mask.get(), k_NumIndices);
+
+  std::vector<usize> expectedMap(k_NumIndices, StreamCompaction::k_Removed);
+  usize newIndex = 0;
+  for(usize i = 0; i < k_NumIndices; i++)
+  {
+    if(mask[i])
+    {
+      expectedMap[i] = newIndex++;
+    }
+  }
+  REQUIRE(StreamCompaction::CreateIndexMap(keptIndices, k_NumIndices) == expectedMap);
+}
+
+TEST_CASE("complex::StreamCompaction CopyKeptTuples", "[complex][StreamCompaction]")
+{
+  const std::unique_ptr<bool[]> mask = CreateMask(k_NumIndices);
+  const std::vector<usize> keptIndices = FindKeptIndicesSerial(mask.get(), k_NumIndices);
+
+  DataStructure dataGraph;
+  auto* source = Float32Array::CreateWithStore<Float32DataStore>(dataGraph, "Source", {k_NumIndices}, {3});
+  auto* destination = Float32Array::CreateWithStore<Float32DataStore>(dataGraph, "Destination", {10}, {3});
+  auto* sourceIds = Int32Array::CreateWithStore<Int32DataStore>(dataGraph, "Source Ids", {k_NumIndices}, {1});
+  auto* destinationIds = Int32Array::CreateWithStore<Int32DataStore>(dataGraph, "Destination Ids", {k_NumIndices}, {1});
+  REQUIRE(source != nullptr);
+  REQUIRE(destination != nullptr);
+  REQUIRE(sourceIds != nullptr);
+  REQUIRE(destinationIds != nullptr);
+  for(usize i = 0; i < k_NumIndices; i++)
+  {
+    for(usize comp = 0; comp < 3; comp++)
+    {
+      (*source)[i * 3 + comp] = static_cast<float32>(i) + 0.5f * static_cast<float32>(comp);
+    }
+    (*sourceIds)[i] = static_cast<int32>(i);
+  }
+
+  StreamCompaction::CopyKeptTuples(*source, *destination, keptIndices);
+  StreamCompaction::CopyKeptTuples(*sourceIds, *destinationIds, keptIndices);
+
+  std::vector<float32> expectedValues;
+  std::vector<int32> expectedIds;
+  for(usize index : keptIndices)
+  {
+    for(usize comp = 0; comp < 3; comp++)
+    {
+      expectedValues.push_back((*source)[index * 3 + comp]);
+    }
+    expectedIds.push_back(static_cast<int32>(index));
+  }
+  REQUIRE(destination->getNumberOfTuples() == keptIndices.size());
+  REQUIRE(destinationIds->getNumberOfTuples() == keptIndices.size());
+  REQUIRE(std::equal(expectedValues.cbegin(), expectedValues.cend(), destination->begin()));
+  REQUIRE(std::equal(expectedIds.cbegin(), expectedIds.cend(), destinationIds->begin()));
+
+  // The arrays must have the same type and number of components
+  auto* wrongComponents = Float32Array::CreateWithStore<Float32DataStore>(dataGraph, "Wrong Components", {10}, {2});
+  REQUIRE(wrongComponents != nullptr);
+  REQUIRE_THROWS_AS(StreamCompaction::CopyKeptTuples(*source, *wrongComponents, keptIndices), std::runtime_error);
+  REQUIRE_THROWS_AS(StreamCompaction::CopyKeptTuples(*sourceIds, *destination, keptIndices), std::runtime_error);
+  REQUIRE(wrongComponents->getNumberOfTuples() == 10);
+}
@@ -118,6 +118,37 @@ DataArray<T>* CreateTestDataArray(DataStructure& dataGraph, const std::string& n
   return dataArray;
 }
 
+/**
+ * @class NonContiguousDataStore
+ * @brief An in memory DataStore that does not expose its values as one block, like
+ * a data store that is read from disk in pieces. Tests use it to run the code paths
+ * for data stores that are not contiguous.
+ */
+template <typename T>
+class NonContiguousDataStore : public DataStore<T>
+{
+public:
+  using value_type = typename DataStore<T>::value_type;
+  using ShapeType = typename DataStore<T>::ShapeType;
+
+  NonContiguousDataStore(const ShapeType& tupleShape, const ShapeType& componentShape)
+  : DataStore<T>(tupleShape, componentShape, static_cast<T>(0))
+  {
+  }
+
+  ~NonContiguousDataStore() override = default;
+
+  value_type* contiguousData() override
+  {
+    return nullptr;
+  }
+
+  const value_type* contiguousData() const override
+  {
+    return nullptr;
+  }
+};
+
 template <typename T>
 NeighborList<T>* CreateTestNeighborList(DataStructure& dataGraph, const std::string& name, usize numTuples, DataObject::IdType parentId)
 {